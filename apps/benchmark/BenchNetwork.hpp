@@ -0,0 +1,57 @@
+#pragma ident "$Id$"
+
+/**
+ * @file BenchNetwork.hpp
+ * Stations of the synthetic networks of the benchmarks.
+ */
+
+#ifndef GPSTK_BENCHNETWORK_HPP
+#define GPSTK_BENCHNETWORK_HPP
+
+//============================================================================
+//
+//  This file is part of GPSTk, the GPS Toolkit.
+//
+//  The GPSTk is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU Lesser General Public License as published
+//  by the Free Software Foundation; either version 2.1 of the License, or
+//  any later version.
+//
+//  The GPSTk is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU Lesser General Public License for more details.
+//
+//  You should have received a copy of the GNU Lesser General Public
+//  License along with GPSTk; if not, write to the Free Software Foundation,
+//  Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110, USA
+//
+//============================================================================
+
+
+#include <vector>
+#include <cstdio>
+
+#include "SourceID.hpp"
+
+
+   /** Returns the GPS stations of a synthetic network, named "S000",
+    *  "S001" and so on.
+    *
+    * @param nsta    Number of stations.
+    */
+inline std::vector<gpstk::SourceID> benchStations(int nsta)
+{
+   std::vector<gpstk::SourceID> stations;
+   for(int s=0; s<nsta; s++)
+   {
+      char name[16];
+      snprintf(name, sizeof(name), "S%03d", s);
+      stations.push_back( gpstk::SourceID(gpstk::SourceID::GPS, name) );
+   }
+
+   return stations;
+
+}  // End of function 'benchStations()'
+
+#endif   // GPSTK_BENCHNETWORK_HPP
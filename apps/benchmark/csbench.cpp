@@ -0,0 +1,194 @@
+#pragma ident "$Id$"
+
+//============================================================================
+//
+//  This file is part of GPSTk, the GPS Toolkit.
+//
+//  The GPSTk is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU Lesser General Public License as published
+//  by the Free Software Foundation; either version 2.1 of the License, or
+//  any later version.
+//
+//  The GPSTk is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU Lesser General Public License for more details.
+//
+//  You should have received a copy of the GNU Lesser General Public
+//  License along with GPSTk; if not, write to the Free Software Foundation,
+//  Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110, USA
+//
+//============================================================================
+
+/**
+ * @file csbench.cpp
+ * Benchmark of the cycle slip detection part of the 'ProcessingList' of
+ * apps/dev/ppp.cpp: required observables, the detection combinations,
+ * LICSDetector, MWCSDetector2, SatArcMarker2, the code combinations and
+ * the alignment of L1 and L2 with PhaseCodeAlignment. The stages of each
+ * file share one SatStateTable, as in ppp.cpp. The observation files are
+ * read into memory first, and only the processing is timed. Prints the
+ * cost of one epoch and a checksum of the flags, arcs and aligned phases,
+ * so that builds of the library may be compared.
+ *
+ * Usage: csbench [-r repeat] obsfile [obsfile ...]
+ *
+ * For example workplace/ppp/brus28[2-7]0.11o gives six days of data at
+ * 30 seconds; each file is processed 'repeat' times, 1 by default.
+ */
+
+#include <iostream>
+#include <iomanip>
+#include <string>
+#include <vector>
+#include <cstdlib>
+#include <ctime>
+
+#include "RinexObsStream.hpp"
+#include "RinexObsHeader.hpp"
+#include "DataStructures.hpp"
+#include "ProcessingList.hpp"
+#include "RequireObservables.hpp"
+#include "LinearCombinations.hpp"
+#include "ComputeLinear.hpp"
+#include "LICSDetector.hpp"
+#include "MWCSDetector2.hpp"
+#include "SatArcMarker2.hpp"
+#include "PhaseCodeAlignment.hpp"
+#include "SatStateTable.hpp"
+
+using namespace std;
+using namespace gpstk;
+
+int main(int argc, char *argv[])
+{
+
+   int repeat(1);
+   vector<string> files;
+   for(int i=1; i<argc; i++)
+   {
+      string arg(argv[i]);
+      if(arg == "-r" && i+1 < argc) repeat = atoi(argv[++i]);
+      else files.push_back(arg);
+   }
+
+   if(files.empty() || repeat < 1)
+   {
+      cout << "Usage: csbench [-r repeat] obsfile [obsfile ...]" << endl;
+      return 1;
+   }
+
+   try
+   {
+      double seconds(0.0), sum(0.0);
+      long nepochs(0), nsats(0);
+
+      for(size_t f=0; f<files.size(); f++)
+      {
+            // read the whole file
+         vector<gnssRinex> data;
+         RinexObsStream rin(files[f].c_str());
+         rin.exceptions(ios::failbit);
+         RinexObsHeader roh;
+         rin >> roh;
+         gnssRinex gRin;
+         while(rin >> gRin)
+         {
+            data.push_back(gRin);
+         }
+
+         for(int r=0; r<repeat; r++)
+         {
+            vector<gnssRinex> epochs(data);
+
+            SatStateTable satStates;
+            LinearCombinations comb;
+
+            RequireObservables requireObs;
+            requireObs.addRequiredType(TypeID::P1);
+            requireObs.addRequiredType(TypeID::P2);
+            requireObs.addRequiredType(TypeID::L1);
+            requireObs.addRequiredType(TypeID::L2);
+
+            ComputeLinear linear1;
+            linear1.addLinear(comb.pdeltaCombination);
+            linear1.addLinear(comb.mwubbenaCombination);
+            linear1.addLinear(comb.ldeltaCombination);
+            linear1.addLinear(comb.liCombination);
+
+            LICSDetector markCSLI;
+            markCSLI.setStateTable(satStates);
+            MWCSDetector2 markCSMW;
+            markCSMW.setStateTable(satStates);
+
+            SatArcMarker2 markArc;
+            markArc.setDeleteUnstableSats(false);
+            markArc.setUnstablePeriod(151.0);
+            markArc.setStateTable(satStates);
+
+            ComputeLinear linear2;
+            linear2.addLinear(comb.q1Combination);
+            linear2.addLinear(comb.q2Combination);
+
+            PhaseCodeAlignment phaseAlignL1;
+            phaseAlignL1.setCodeType(TypeID::Q1);
+            phaseAlignL1.setPhaseType(TypeID::L1);
+            phaseAlignL1.setPhaseWavelength(0.190293672798);
+            phaseAlignL1.setStateTable(satStates);
+
+            PhaseCodeAlignment phaseAlignL2;
+            phaseAlignL2.setCodeType(TypeID::Q2);
+            phaseAlignL2.setPhaseType(TypeID::L2);
+            phaseAlignL2.setPhaseWavelength(0.244210213425);
+            phaseAlignL2.setStateTable(satStates);
+
+            ProcessingList pList;
+            pList.push_back(requireObs);
+            pList.push_back(linear1);
+            pList.push_back(markCSLI);
+            pList.push_back(markCSMW);
+            pList.push_back(markArc);
+            pList.push_back(linear2);
+            pList.push_back(phaseAlignL1);
+            pList.push_back(phaseAlignL2);
+
+            clock_t start( clock() );
+            for(size_t e=0; e<epochs.size(); e++)
+            {
+               epochs[e] >> pList;
+            }
+            seconds += double(clock()-start)/CLOCKS_PER_SEC;
+
+            for(size_t e=0; e<epochs.size(); e++)
+            {
+               satTypeValueMap& body(epochs[e].body);
+               for(satTypeValueMap::iterator it = body.begin();
+                   it != body.end();
+                   ++it)
+               {
+                  sum += (*it).second[TypeID::CSL1]
+                       + (*it).second[TypeID::satArc]
+                       + 1.0e-6*( (*it).second[TypeID::L1]
+                                - (*it).second[TypeID::L2] );
+                  nsats++;
+               }
+            }
+            nepochs += epochs.size();
+         }
+      }
+
+      cout << "files " << files.size() << ", repeat " << repeat << ", "
+           << nepochs << " epochs, " << nsats << " satellite epochs" << endl
+           << "per epoch : " << fixed << setw(10) << setprecision(3)
+           << 1.0e6*seconds/nepochs << " us" << endl
+           << "checksum " << scientific << setprecision(17) << sum << endl;
+   }
+   catch(Exception& e)
+   {
+      cerr << e << endl;
+      return 1;
+   }
+
+   return 0;
+
+}  // End of 'main()'
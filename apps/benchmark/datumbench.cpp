@@ -0,0 +1,256 @@
+#pragma ident "$Id$"
+
+//============================================================================
+//
+//  This file is part of GPSTk, the GPS Toolkit.
+//
+//  The GPSTk is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU Lesser General Public License as published
+//  by the Free Software Foundation; either version 2.1 of the License, or
+//  any later version.
+//
+//  The GPSTk is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU Lesser General Public License for more details.
+//
+//  You should have received a copy of the GNU Lesser General Public
+//  License along with GPSTk; if not, write to the Free Software Foundation,
+//  Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110, USA
+//
+//============================================================================
+
+/**
+ * @file datumbench.cpp
+ * Benchmark of the network datum of AmbiDatum on a synthetic network, in
+ * which satellites rise and set at each station and arcs are broken by
+ * random cycle slips. The same epochs are processed by a datum updated
+ * incrementally and by the minimum spanning tree built from scratch at
+ * every epoch. Both trees are expected to differ, since the incremental
+ * one keeps its surviving edges. For each mode, the cost of Prepare(), the
+ * edges entering the tree per epoch and the mean variance of the tree are
+ * printed, with the epochs where both trees differ, those where they have
+ * a different number of edges, which should never happen, and a checksum
+ * of the incremental datum, so that builds of the library may be compared.
+ *
+ * Usage: datumbench [-s stations] [-n satellites] [-e epochs]
+ *
+ * There are 50 stations, 32 satellites and 500 epochs by default.
+ */
+
+#include <iostream>
+#include <iomanip>
+#include <string>
+#include <vector>
+#include <map>
+#include <cstdlib>
+#include <cmath>
+#include <ctime>
+
+#include "DataStructures.hpp"
+#include "AmbiDatum.hpp"
+#include "BenchNetwork.hpp"
+
+using namespace std;
+using namespace gpstk;
+
+   // Repeatable uniform numbers in [-1,1)
+static unsigned long seed(20161018UL);
+static double uniform(void)
+{
+   seed = (seed * 1103515245UL + 12345UL) & 0x7fffffffUL;
+   return 2.0*double(seed)/2147483648.0 - 1.0;
+}
+
+int main(int argc, char *argv[])
+{
+
+   int nsta(50), nsat(32), epochs(500);
+   for(int i=1; i<argc; i++)
+   {
+      string arg(argv[i]);
+      if(arg == "-s" && i+1 < argc) nsta = atoi(argv[++i]);
+      else if(arg == "-n" && i+1 < argc) nsat = atoi(argv[++i]);
+      else if(arg == "-e" && i+1 < argc) epochs = atoi(argv[++i]);
+      else
+      {
+         cout << "Usage: datumbench [-s stations] [-n satellites] "
+              << "[-e epochs]" << endl;
+         return 1;
+      }
+   }
+
+   if(nsta < 1 || nsat < 1 || epochs < 1)
+   {
+      cout << "Usage: datumbench [-s stations] [-n satellites] "
+           << "[-e epochs]" << endl;
+      return 1;
+   }
+
+   try
+   {
+      vector<SourceID> stations( benchStations(nsta) );
+
+         // Each satellite is seen by a station along a sine of the time,
+         // with an arc number, the epoch the arc began and an ambiguity
+      vector< vector<double> > phase( nsta, vector<double>(nsat) );
+      vector< vector<double> > arc( nsta, vector<double>(nsat, 1.0) );
+      vector< vector<int> > start( nsta, vector<int>(nsat, 0) );
+      vector< vector<double> > amb( nsta, vector<double>(nsat) );
+      for(int s=0; s<nsta; s++)
+      {
+         for(int j=0; j<nsat; j++)
+         {
+            phase[s][j] = 3.2*uniform();
+            amb[s][j] = 20.0*uniform();
+         }
+      }
+
+      AmbiDatum incDatum, fullDatum;
+      fullDatum.setIncremental(false);
+
+      double incSeconds(0.0), fullSeconds(0.0), checksum(0.0);
+      double incVariance(0.0), fullVariance(0.0);
+      long edges(0), incChanges(0), fullChanges(0);
+      int differ(0), sizeDiffer(0);
+      ArcSet incPrevious, fullPrevious;
+
+      for(int e=0; e<epochs; e++)
+      {
+         sourceDataMap gData;
+         std::map<SourceID, satValueMap> ambNetMap, varNetMap;
+
+         for(int s=0; s<nsta; s++)
+         {
+            for(int j=0; j<nsat; j++)
+            {
+               double elev( 90.0*std::sin( phase[s][j] + 0.005*e ) );
+               if(elev < 10.0)
+               {
+                     // The next pass is a new arc
+                  if(start[s][j] >= 0)
+                  {
+                     arc[s][j] += 1.0;
+                     start[s][j] = -1;
+                  }
+                  continue;
+               }
+
+                  // Cycle slips
+               if( start[s][j] < 0 || uniform() > 0.998 )
+               {
+                  if(start[s][j] >= 0) arc[s][j] += 1.0;
+                  start[s][j] = e;
+                  amb[s][j] = 20.0*uniform();
+               }
+
+               SatID sat(j+1, SatID::systemGPS);
+               gData[stations[s]][sat][TypeID::satArc] = arc[s][j];
+               gData[stations[s]][sat][TypeID::elevation] = elev;
+
+               const int age( e - start[s][j] );
+               ambNetMap[stations[s]][sat] = amb[s][j] + 0.1*uniform();
+               varNetMap[stations[s]][sat] = ( 1.0 + 0.01*uniform() )
+                                             / (1.0 + age);
+            }
+         }
+
+         incDatum.Reset(ambNetMap, varNetMap);
+         fullDatum.Reset(ambNetMap, varNetMap);
+
+         clock_t begin( clock() );
+         incDatum.Prepare(gData);
+         incSeconds += double(clock()-begin)/CLOCKS_PER_SEC;
+
+         begin = clock();
+         fullDatum.Prepare(gData);
+         fullSeconds += double(clock()-begin)/CLOCKS_PER_SEC;
+
+         EdgeSet incEdges( incDatum.getDatumEdges() );
+         EdgeSet fullEdges( fullDatum.getDatumEdges() );
+
+         ArcSet incArcs( incEdges.begin(), incEdges.end() );
+         ArcSet fullArcs( fullEdges.begin(), fullEdges.end() );
+         if( incArcs != fullArcs ) differ++;
+         if( incArcs.size() != fullArcs.size() ) sizeDiffer++;
+
+            // Edges entering each tree, i.e., changes of the datum
+         for( ArcSet::iterator it = incArcs.begin();
+              it != incArcs.end();
+              ++it )
+         {
+            if( incPrevious.find(*it) == incPrevious.end() ) incChanges++;
+         }
+         for( ArcSet::iterator it = fullArcs.begin();
+              it != fullArcs.end();
+              ++it )
+         {
+            if( fullPrevious.find(*it) == fullPrevious.end() ) fullChanges++;
+         }
+         incPrevious = incArcs;
+         fullPrevious = fullArcs;
+
+            // Mean variance of the edges of each tree
+         double sum(0.0);
+         for( EdgeSet::iterator it = incEdges.begin();
+              it != incEdges.end();
+              ++it )
+         {
+            sum += (*it).getApriVariance();
+         }
+         if( !incEdges.empty() ) incVariance += sum/incEdges.size();
+
+         sum = 0.0;
+         for( EdgeSet::iterator it = fullEdges.begin();
+              it != fullEdges.end();
+              ++it )
+         {
+            sum += (*it).getApriVariance();
+         }
+         if( !fullEdges.empty() ) fullVariance += sum/fullEdges.size();
+
+         std::map<SourceID, satValueMap> fixedMap(
+                                          incDatum.getNetAmbFixedMap() );
+         for( std::map<SourceID, satValueMap>::iterator it =
+                                                            fixedMap.begin();
+              it != fixedMap.end();
+              ++it )
+         {
+            for( satValueMap::iterator its = (*it).second.begin();
+                 its != (*it).second.end();
+                 ++its )
+            {
+               checksum += (*its).second * (*its).first.id;
+            }
+         }
+
+         edges += incEdges.size();
+      }
+
+      cout << "stations " << nsta << ", satellites " << nsat
+           << ", datum edges per epoch " << fixed << setprecision(1)
+           << double(edges)/epochs << endl
+           << "incremental per epoch : " << setw(10) << setprecision(3)
+           << 1.0e6*incSeconds/epochs << " us, "
+           << setprecision(2) << double(incChanges)/epochs
+           << " new edges, mean variance " << setprecision(5)
+           << incVariance/epochs << endl
+           << "from scratch per epoch: " << setw(10) << setprecision(3)
+           << 1.0e6*fullSeconds/epochs << " us, "
+           << setprecision(2) << double(fullChanges)/epochs
+           << " new edges, mean variance " << setprecision(5)
+           << fullVariance/epochs << endl
+           << "epochs where the trees differ " << differ
+           << ", with a different number of edges " << sizeDiffer << endl
+           << "checksum " << scientific << setprecision(17) << checksum
+           << endl;
+   }
+   catch(Exception& e)
+   {
+      cerr << e << endl;
+      return 1;
+   }
+
+   return 0;
+
+}  // End of 'main()'
@@ -0,0 +1,150 @@
+#pragma ident "$Id$"
+
+//============================================================================
+//
+//  This file is part of GPSTk, the GPS Toolkit.
+//
+//  The GPSTk is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU Lesser General Public License as published
+//  by the Free Software Foundation; either version 2.1 of the License, or
+//  any later version.
+//
+//  The GPSTk is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU Lesser General Public License for more details.
+//
+//  You should have received a copy of the GNU Lesser General Public
+//  License along with GPSTk; if not, write to the Free Software Foundation,
+//  Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110, USA
+//
+//============================================================================
+
+/**
+ * @file eopbench.cpp
+ * Benchmark of the EpochDataStore tables: a daily EOPDataStore of ten
+ * years, queried as the IERSConventions helpers do, once per field and once
+ * for all of them, and a PvtStore of one day of 5 minute positions,
+ * interpolated with 10 points. Every 30 s epoch of a day is processed.
+ * Prints the cost of one epoch and a checksum of the values, so that
+ * builds of the library may be compared.
+ *
+ * Usage: eopbench [-d days] [-u]
+ *
+ * 'days' is the number of days processed, 10 by default. With '-u' the
+ * PvtStore epochs are not equally spaced.
+ */
+
+#include <iostream>
+#include <iomanip>
+#include <string>
+#include <cstdlib>
+#include <cmath>
+#include <ctime>
+
+#include "EOPDataStore.hpp"
+#include "PvtStore.hpp"
+#include "MJD.hpp"
+
+using namespace std;
+using namespace gpstk;
+
+int main(int argc, char *argv[])
+{
+
+   int days(10);
+   bool irregular(false);
+   for(int i=1; i<argc; i++)
+   {
+      string arg(argv[i]);
+      if(arg == "-d" && i+1 < argc) days = atoi(argv[++i]);
+      else if(arg == "-u") irregular = true;
+      else
+      {
+         cout << "Usage: eopbench [-d days] [-u]" << endl;
+         return 1;
+      }
+   }
+
+   if(days < 1)
+   {
+      cout << "Usage: eopbench [-d days] [-u]" << endl;
+      return 1;
+   }
+
+   try
+   {
+      const double mjd0(55000.0);
+
+         // Ten years of daily EOP
+      EOPDataStore eopStore;
+      for(int d=-1830; d<=1830+days; d++)
+      {
+         double t( d/365.25 );
+         eopStore.addEOPData( MJD(mjd0+d, TimeSystem::UTC),
+                              EOPDataStore::EOPData(
+                                 0.1 + 0.2*std::cos(6.0*t),
+                                 0.3 + 0.2*std::sin(6.0*t),
+                                 -0.2 - 0.001*d,
+                                 1.0e-4*std::sin(t),
+                                 1.0e-4*std::cos(t) ) );
+      }
+
+         // Positions of a satellite every 5 minutes
+      PvtStore pvtStore;
+      for(int k=-20; k<=288*days+20; k++)
+      {
+         double s( 300.0*k );
+         if(irregular && k%7 == 3) s += 0.5;
+         PvtStore::Pvt pvt;
+         pvt.position = Triple( 2.6e7*std::cos(s*1.458e-4),
+                                2.6e7*std::sin(s*1.458e-4),
+                                1.0e6*std::sin(s*7.0e-5) );
+         pvt.velocity = Triple( -3.8e3*std::sin(s*1.458e-4),
+                                3.8e3*std::cos(s*1.458e-4),
+                                70.0*std::cos(s*7.0e-5) );
+         pvt.dtime = 1.0e-4 + 1.0e-11*s;
+         pvt.ddtime = 1.0e-11;
+         pvtStore.addPvt( MJD(mjd0+s/86400.0, TimeSystem::UTC), pvt );
+      }
+
+      double checksum(0.0);
+      long epochs(0);
+
+      clock_t start( clock() );
+      for(int d=0; d<days; d++)
+      {
+         for(int e=0; e<2880; e++)
+         {
+            CommonTime utc( MJD(mjd0 + d + e*30.0/86400.0, TimeSystem::UTC) );
+
+            double xp( eopStore.getXPole(utc) );
+            double yp( eopStore.getYPole(utc) );
+            double ut1( eopStore.getUT1mUTC(utc) );
+            EOPDataStore::EOPData eop( eopStore.getEOPData(utc) );
+
+            PvtStore::Pvt pvt( pvtStore.getPvt(utc) );
+
+            checksum += xp + yp + ut1 + eop.dPsi + eop.dEps
+                        + 1.0e-7*pvt.position[0] + 1.0e-4*pvt.velocity[1]
+                        + pvt.dtime;
+            epochs++;
+         }
+      }
+      double seconds( double(clock()-start)/CLOCKS_PER_SEC );
+
+      cout << "epochs " << epochs << endl
+           << "per epoch : " << fixed << setw(10) << setprecision(3)
+           << 1.0e6*seconds/epochs << " us" << endl
+           << "checksum " << scientific << setprecision(17) << checksum
+           << endl;
+   }
+   catch(Exception& e)
+   {
+      cerr << e << endl;
+      return 1;
+   }
+
+   return 0;
+
+}  // End of 'main()'
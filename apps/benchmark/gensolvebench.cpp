@@ -0,0 +1,320 @@
+#pragma ident "$Id$"
+
+//============================================================================
+//
+//  This file is part of GPSTk, the GPS Toolkit.
+//
+//  The GPSTk is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU Lesser General Public License as published
+//  by the Free Software Foundation; either version 2.1 of the License, or
+//  any later version.
+//
+//  The GPSTk is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU Lesser General Public License for more details.
+//
+//  You should have received a copy of the GNU Lesser General Public
+//  License along with GPSTk; if not, write to the Free Software Foundation,
+//  Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110, USA
+//
+//============================================================================
+
+/**
+ * @file gensolvebench.cpp
+ * Benchmark of SolverGeneral on a synthetic network, set up as in
+ * example14: a master station, whose clock is the reference, and reference
+ * stations with their own clock, all with a zenith wet delay and phase
+ * ambiguities, and satellite clocks common to the network. The same data
+ * are processed by the dense filter and in network mode, and the largest
+ * differences between both solutions and covariances are printed with the
+ * wall time of the first epoch and of one of the following epochs in each
+ * mode, and a checksum of the network solution, so that builds of the
+ * library may be compared.
+ *
+ * Usage: gensolvebench [-s stations] [-n satellites] [-e epochs] [-w window]
+ *
+ * There are 8 stations, 8 satellites and 100 epochs by default. With '-w'
+ * the data are also processed in batch mode, with a window of 'window'
+ * epochs, and compared to the network mode.
+ */
+
+#include <iostream>
+#include <iomanip>
+#include <string>
+#include <vector>
+#include <cstdlib>
+#include <cmath>
+#include <ctime>
+
+#include "DataStructures.hpp"
+#include "StochasticModel.hpp"
+#include "SolverGeneral.hpp"
+#include "BenchNetwork.hpp"
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+using namespace std;
+using namespace gpstk;
+
+   // Repeatable uniform numbers in [-1,1)
+static unsigned long seed(20161018UL);
+static double uniform(void)
+{
+   seed = (seed * 1103515245UL + 12345UL) & 0x7fffffffUL;
+   return 2.0*double(seed)/2147483648.0 - 1.0;
+}
+
+   // Wall clock, as the solvers may run on several threads
+static double wallClock(void)
+{
+#ifdef _OPENMP
+   return omp_get_wtime();
+#else
+   return double(clock())/CLOCKS_PER_SEC;
+#endif
+}
+
+   // Time of the first epoch, and of one of the following ones
+static void printCost( const char *mode,
+                       const double seconds[2],
+                       int epochs )
+{
+   cout << mode << " first epoch : " << fixed << setw(12) << setprecision(3)
+        << 1.0e6*seconds[0] << " us";
+   if(epochs > 1)
+   {
+      cout << ", per epoch after : " << setw(12)
+           << 1.0e6*seconds[1]/(epochs-1) << " us";
+   }
+   cout << endl;
+}
+
+int main(int argc, char *argv[])
+{
+
+   int nsta(8), nsat(8), epochs(100), window(0);
+   for(int i=1; i<argc; i++)
+   {
+      string arg(argv[i]);
+      if(arg == "-s" && i+1 < argc) nsta = atoi(argv[++i]);
+      else if(arg == "-n" && i+1 < argc) nsat = atoi(argv[++i]);
+      else if(arg == "-e" && i+1 < argc) epochs = atoi(argv[++i]);
+      else if(arg == "-w" && i+1 < argc) window = atoi(argv[++i]);
+      else
+      {
+         cout << "Usage: gensolvebench [-s stations] [-n satellites] "
+              << "[-e epochs] [-w window]" << endl;
+         return 1;
+      }
+   }
+
+   if(nsta < 2 || nsat < 4 || epochs < 1 || window < 0)
+   {
+      cout << "Usage: gensolvebench [-s stations] [-n satellites] "
+           << "[-e epochs] [-w window]" << endl;
+      return 1;
+   }
+
+   try
+   {
+         // Stations, the first one being the master
+      vector<SourceID> stations( benchStations(nsta) );
+
+         // Variables and equations, as in example14
+      TropoRandomWalkModel tropoModel;
+      PhaseAmbiguityModel ambiModel;
+
+      Variable cdt( TypeID::cdt );
+      cdt.setDefaultForced(true);
+
+      Variable tropo( TypeID::wetMap, &tropoModel, true, false, 10.0 );
+
+      Variable ambi( TypeID::BLC, &ambiModel, true, true );
+      ambi.setDefaultForced(true);
+
+      Variable satClock( TypeID::dtSat );
+      satClock.setSourceIndexed(false);
+      satClock.setSatIndexed(true);
+      satClock.setDefaultForced(true);
+
+      Variable prefitC( TypeID::prefitC );
+      Variable prefitL( TypeID::prefitL );
+
+      Equation equPCRef( prefitC );
+      equPCRef.addVariable(cdt, true, 1.0);
+      equPCRef.addVariable(tropo);
+      equPCRef.addVariable(satClock, true, 1.0);
+      equPCRef.header.equationSource = Variable::someSources;
+
+      Equation equLCRef( prefitL );
+      equLCRef.addVariable(cdt, true, 1.0);
+      equLCRef.addVariable(tropo);
+      equLCRef.addVariable(ambi, true, 1.0);
+      equLCRef.addVariable(satClock, true, 1.0);
+      equLCRef.setWeight(10000.0);
+      equLCRef.header.equationSource = Variable::someSources;
+
+      for(int s=1; s<nsta; s++)
+      {
+         equPCRef.addSource2Set( stations[s] );
+         equLCRef.addSource2Set( stations[s] );
+      }
+
+      Equation equPCMaster( prefitC );
+      equPCMaster.addVariable(tropo);
+      equPCMaster.addVariable(satClock, true, 1.0);
+      equPCMaster.header.equationSource = stations[0];
+
+      Equation equLCMaster( prefitL );
+      equLCMaster.addVariable(tropo);
+      equLCMaster.addVariable(ambi, true, 1.0);
+      equLCMaster.addVariable(satClock, true, 1.0);
+      equLCMaster.setWeight(10000.0);
+      equLCMaster.header.equationSource = stations[0];
+
+      EquationSystem system;
+      system.addEquation(equPCRef);
+      system.addEquation(equLCRef);
+      system.addEquation(equPCMaster);
+      system.addEquation(equLCMaster);
+
+      SolverGeneral dense(system);
+      SolverGeneral network(system);
+      network.setNetworkMode(true);
+
+      SolverGeneral batch(system);
+      batch.setBatchWindow(window);
+
+         // Truth: zenith wet delays, receiver clocks and ambiguities
+      vector<double> ztd(nsta), clk(nsta);
+      vector< vector<double> > amb( nsta, vector<double>(nsat) );
+      vector< vector<double> > map0( nsta, vector<double>(nsat) );
+      for(int s=0; s<nsta; s++)
+      {
+         ztd[s] = 0.1 + 0.05*uniform();
+         clk[s] = (s==0) ? 0.0 : 100.0*uniform();
+         for(int j=0; j<nsat; j++)
+         {
+            amb[s][j] = 10.0*uniform();
+            map0[s][j] = 2.0 + uniform();
+         }
+      }
+
+         // Wall time of the first epoch, and of all the following ones
+      double denseSeconds[2] = { 0.0, 0.0 };
+      double networkSeconds[2] = { 0.0, 0.0 };
+      double batchSeconds[2] = { 0.0, 0.0 };
+      double maxDiff(0.0), maxCovDiff(0.0), checksum(0.0);
+      double maxBatchDiff(0.0), maxBatchCovDiff(0.0);
+
+      CommonTime epoch( CommonTime::BEGINNING_OF_TIME );
+      epoch.setTimeSystem(TimeSystem::Any);
+
+      for(int e=0; e<epochs; e++)
+      {
+         epoch += 30.0;
+
+         vector<double> satClk(nsat);
+         for(int j=0; j<nsat; j++) satClk[j] = 1000.0*uniform();
+
+         gnssDataMap gds;
+         for(int s=0; s<nsta; s++)
+         {
+            gnssRinex gRin;
+            gRin.header.source = stations[s];
+            gRin.header.epoch = epoch;
+            gRin.header.epochFlag = 0;
+
+            for(int j=0; j<nsat; j++)
+            {
+               SatID sat(j+1, SatID::systemGPS);
+               const double wet( map0[s][j] + 0.01*e );
+               const double range( ztd[s]*wet + clk[s] + satClk[j] );
+               gRin.body[sat][TypeID::wetMap] = wet;
+               gRin.body[sat][TypeID::prefitC] = range + 0.3*uniform();
+               gRin.body[sat][TypeID::prefitL] = range + amb[s][j]
+                                                 + 0.003*uniform();
+               gRin.body[sat][TypeID::CSL1] = 0.0;
+               gRin.body[sat][TypeID::satArc] = 1.0;
+            }
+
+            gds.addGnssRinex(gRin);
+         }
+
+         gnssDataMap gdsNet(gds);
+         gnssDataMap gdsBatch(gds);
+
+         const int k( e == 0 ? 0 : 1 );
+
+         double start( wallClock() );
+         dense.Process(gds);
+         denseSeconds[k] += wallClock() - start;
+
+         start = wallClock();
+         network.Process(gdsNet);
+         networkSeconds[k] += wallClock() - start;
+
+         const Vector<double>& xd( dense.solution );
+
+         if(window > 0)
+         {
+            start = wallClock();
+            batch.Process(gdsBatch);
+            batchSeconds[k] += wallClock() - start;
+
+            const Vector<double>& xb( batch.solution );
+            for(size_t i=0; i<xb.size(); i++)
+            {
+               maxBatchDiff = std::max( maxBatchDiff,
+                                        std::fabs(xb(i)-network.solution(i)) );
+               for(size_t j=0; j<xb.size(); j++)
+               {
+                  maxBatchCovDiff = std::max( maxBatchCovDiff,
+                       std::fabs(batch.covMatrix(i,j)-network.covMatrix(i,j)) );
+               }
+            }
+         }
+
+         const Vector<double>& xn( network.solution );
+         for(size_t i=0; i<xn.size(); i++)
+         {
+            maxDiff = std::max( maxDiff, std::fabs(xn(i)-xd(i)) );
+            checksum += xn(i);
+            for(size_t j=0; j<xn.size(); j++)
+            {
+               maxCovDiff = std::max( maxCovDiff,
+                     std::fabs(network.covMatrix(i,j)-dense.covMatrix(i,j)) );
+            }
+         }
+      }
+
+      cout << "stations " << nsta << ", satellites " << nsat
+           << ", unknowns " << network.solution.size()
+           << ", epochs " << epochs << endl;
+      printCost("dense  ", denseSeconds, epochs);
+      printCost("network", networkSeconds, epochs);
+      cout << "max difference " << scientific << setprecision(3) << maxDiff
+           << ", covariance " << maxCovDiff << endl;
+
+      if(window > 0)
+      {
+         printCost("batch  ", batchSeconds, epochs);
+         cout << "batch max difference " << scientific << setprecision(3)
+              << maxBatchDiff << ", covariance " << maxBatchCovDiff << endl;
+      }
+
+      cout << "checksum " << scientific << setprecision(17) << checksum
+           << endl;
+   }
+   catch(Exception& e)
+   {
+      cerr << e << endl;
+      return 1;
+   }
+
+   return 0;
+
+}  // End of 'main()'
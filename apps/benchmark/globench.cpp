@@ -0,0 +1,123 @@
+#pragma ident "$Id$"
+
+//============================================================================
+//
+//  This file is part of GPSTk, the GPS Toolkit.
+//
+//  The GPSTk is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU Lesser General Public License as published
+//  by the Free Software Foundation; either version 2.1 of the License, or
+//  any later version.
+//
+//  The GPSTk is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU Lesser General Public License for more details.
+//
+//  You should have received a copy of the GNU Lesser General Public
+//  License along with GPSTk; if not, write to the Free Software Foundation,
+//  Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110, USA
+//
+//============================================================================
+
+/**
+ * @file globench.cpp
+ * Benchmark of GloEphemerisStore::getXvt(): positions of every GLONASS
+ * satellite in a broadcast navigation file, at a fixed interval over the
+ * whole span of the file. Prints the cost of one call and a checksum of
+ * the positions, so that builds of the library may be compared.
+ *
+ * Usage: globench navfile [interval]
+ *
+ * The interval is in seconds, 1 by default; for example
+ * workplace/pppgnss/brdc0370.16g gives a day of data at 1 Hz.
+ */
+
+#include <iostream>
+#include <iomanip>
+#include <vector>
+#include <cstdlib>
+#include <ctime>
+
+#include "Rinex3NavStream.hpp"
+#include "Rinex3NavHeader.hpp"
+#include "Rinex3NavData.hpp"
+#include "GloEphemerisStore.hpp"
+
+using namespace std;
+using namespace gpstk;
+
+int main(int argc, char *argv[])
+{
+
+   if(argc < 2)
+   {
+      cout << "Usage: globench navfile [interval]" << endl;
+      return 1;
+   }
+
+   double interval( argc > 2 ? atof(argv[2]) : 1.0 );
+
+   try
+   {
+      GloEphemerisStore store;
+
+      Rinex3NavStream navStream(argv[1]);
+      Rinex3NavHeader navHeader;
+      Rinex3NavData navData;
+      navStream >> navHeader;
+      while(navStream >> navData)
+      {
+         if(navData.sat.system == SatID::systemGlonass)
+            store.addEphemeris(navData);
+      }
+
+         // The satellites in the store
+      vector<SatID> sats;
+      for(int prn=1; prn<=32; prn++)
+      {
+         SatID sat(prn, SatID::systemGlonass);
+         if(store.isPresent(sat)) sats.push_back(sat);
+      }
+
+      CommonTime first( store.getInitialTime() );
+      CommonTime last( store.getFinalTime() );
+
+      long calls(0), failed(0);
+      double sum(0.0);
+
+      clock_t start( clock() );
+      for(CommonTime t = first; t < last; t += interval)
+      {
+         for(size_t i=0; i<sats.size(); i++)
+         {
+            try
+            {
+               Xvt xvt( store.getXvt(sats[i], t) );
+               sum += xvt.x[0] + xvt.x[1] + xvt.x[2];
+               calls++;
+            }
+            catch(InvalidRequest& e)
+            {
+               failed++;
+            }
+         }
+      }
+      double seconds( double(clock()-start)/CLOCKS_PER_SEC );
+
+      cout << "satellites " << sats.size() << ", interval " << fixed
+           << setprecision(1) << interval << " s, " << calls
+           << " positions, " << failed << " failed" << endl
+           << "per call : " << setw(10) << setprecision(3)
+           << 1.0e6*seconds/(calls+failed) << " us" << endl
+           << "checksum " << scientific << setprecision(17) << sum << endl;
+   }
+   catch(Exception& e)
+   {
+      cerr << e << endl;
+      return 1;
+   }
+
+   return 0;
+
+}  // End of 'main()'
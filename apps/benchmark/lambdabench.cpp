@@ -0,0 +1,236 @@
+#pragma ident "$Id$"
+
+//============================================================================
+//
+//  This file is part of GPSTk, the GPS Toolkit.
+//
+//  The GPSTk is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU Lesser General Public License as published
+//  by the Free Software Foundation; either version 2.1 of the License, or
+//  any later version.
+//
+//  The GPSTk is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU Lesser General Public License for more details.
+//
+//  You should have received a copy of the GNU Lesser General Public
+//  License along with GPSTk; if not, write to the Free Software Foundation,
+//  Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110, USA
+//
+//============================================================================
+
+/**
+ * @file lambdabench.cpp
+ * Benchmark of ARMLambda::resolve() on random float ambiguities of
+ * dimension 10 to 100. For each dimension there is a well conditioned
+ * case, with mostly independent ambiguities, and an ill conditioned one,
+ * in which the ambiguities are strongly correlated through a slowly
+ * changing four-parameter geometry, as after a short period of phase
+ * observations. Each case is a sequence of epochs solved one after the
+ * other. Prints the cost of one resolution per case and a checksum of the
+ * fixed ambiguities and ratios, so that builds of the library may be
+ * compared.
+ *
+ * Usage: lambdabench [-r epochs] [-w] [-p]
+ *
+ * 'epochs' is the number of epochs of each case, 20 by default. With '-w'
+ * each resolution starts from the Z-transform of the previous epoch, and
+ * with '-p' the ambiguities are resolved with ARLambda::resolvePartial(),
+ * dropping those of largest variance first until the ratio exceeds 3.
+ */
+
+#include <iostream>
+#include <iomanip>
+#include <vector>
+#include <algorithm>
+#include <cstdlib>
+#include <cmath>
+#include <ctime>
+
+#include "ARMLambda.hpp"
+
+using namespace std;
+using namespace gpstk;
+
+   // Repeatable uniform numbers in [-1,1)
+static unsigned long seed(20161018UL);
+static double uniform(void)
+{
+   seed = (seed * 1103515245UL + 12345UL) & 0x7fffffffUL;
+   return 2.0*double(seed)/2147483648.0 - 1.0;
+}
+
+   // Covariance of the float ambiguities: a diagonal part plus the
+   // correlation given by a geometry 'G' (n x 4) at time 't'
+static Matrix<double> covariance( const Matrix<double>& G,
+                                  const Matrix<double>& dG,
+                                  const Vector<double>& diag,
+                                  double t,
+                                  double sd,
+                                  double sg )
+{
+   const size_t n( G.rows() );
+   Matrix<double> Q(n, n, 0.0);
+   for(size_t i=0; i<n; i++)
+   {
+      for(size_t j=0; j<=i; j++)
+      {
+         double sum(0.0);
+         for(size_t k=0; k<G.cols(); k++)
+         {
+            sum += (G(i,k)+t*dG(i,k)) * (G(j,k)+t*dG(j,k));
+         }
+         Q(i,j) = Q(j,i) = sg*sum;
+      }
+      Q(i,i) += sd*diag(i);
+   }
+   return Q;
+}
+
+   // Indexes sorted by decreasing variance
+struct ByVariance
+{
+   ByVariance(const Matrix<double>& Q) : cov(Q) {}
+   bool operator()(int i, int j) const { return cov(i,i) > cov(j,j); }
+   const Matrix<double>& cov;
+};
+
+   // Float ambiguities around 'truth', with noise of covariance 'Q'
+static Vector<double> floatAmbiguities( const Vector<double>& truth,
+                                        const Matrix<double>& Q )
+{
+   const size_t n( truth.size() );
+   Matrix<double> C(n, n, 0.0);
+   for(size_t j=0; j<n; j++)
+   {
+      double d( Q(j,j) );
+      for(size_t k=0; k<j; k++) d -= C(j,k)*C(j,k);
+      C(j,j) = std::sqrt(d);
+      for(size_t i=j+1; i<n; i++)
+      {
+         double s( Q(i,j) );
+         for(size_t k=0; k<j; k++) s -= C(i,k)*C(j,k);
+         C(i,j) = s/C(j,j);
+      }
+   }
+
+   Vector<double> w(n), a(truth);
+   for(size_t i=0; i<n; i++) w(i) = 0.5*uniform();
+   for(size_t i=0; i<n; i++)
+   {
+      for(size_t k=0; k<=i; k++) a(i) += C(i,k)*w(k);
+   }
+   return a;
+}
+
+int main(int argc, char *argv[])
+{
+
+   int epochs(20);
+   bool warm(false), partial(false);
+   for(int i=1; i<argc; i++)
+   {
+      string arg(argv[i]);
+      if(arg == "-r" && i+1 < argc) epochs = atoi(argv[++i]);
+      else if(arg == "-w") warm = true;
+      else if(arg == "-p") partial = true;
+      else
+      {
+         cout << "Usage: lambdabench [-r epochs] [-w] [-p]" << endl;
+         return 1;
+      }
+   }
+
+   if(epochs < 1)
+   {
+      cout << "Usage: lambdabench [-r epochs] [-w] [-p]" << endl;
+      return 1;
+   }
+
+   try
+   {
+      const int dims[5] = { 10, 20, 40, 70, 100 };
+
+      double checksum(0.0), total(0.0);
+      long solved(0);
+
+      for(int d=0; d<5; d++)
+      {
+         const int n( dims[d] );
+
+         for(int ill=0; ill<2; ill++)
+         {
+            Matrix<double> G(n, 4), dG(n, 4);
+            Vector<double> diag(n), truth(n);
+            for(int i=0; i<n; i++)
+            {
+               for(int k=0; k<4; k++)
+               {
+                  G(i,k) = uniform();
+                  dG(i,k) = uniform();
+               }
+               diag(i) = 1.0 + 0.5*uniform();
+               truth(i) = std::floor( 50.0*uniform() );
+            }
+
+            const double sd( ill ? 1.0e-3 : 2.0e-2 );
+            const double sg( ill ? 1.0 : 1.0e-3 );
+
+            ARMLambda lambda;
+            lambda.setWarmStart(warm);
+            long fixedCount(0);
+
+            double seconds(0.0);
+            for(int e=0; e<epochs; e++)
+            {
+               Matrix<double> Q( covariance(G, dG, diag, 0.01*e, sd, sg) );
+               Vector<double> a( floatAmbiguities(truth, Q) );
+
+               vector<int> order;
+               if(partial)
+               {
+                  for(int i=0; i<n; i++) order.push_back(i);
+                  stable_sort(order.begin(), order.end(), ByVariance(Q));
+               }
+
+               clock_t start( clock() );
+               if(partial) lambda.resolvePartial(a, Q, order, 3.0);
+               else lambda.resolve(a, Q);
+               seconds += double(clock()-start)/CLOCKS_PER_SEC;
+
+               Vector<double> fixedAmb( lambda.getFixedAmbVec() );
+               Vector<bool> fixedFlags( lambda.getFixedFlags() );
+               for(int i=0; i<n; i++)
+               {
+                  if( !fixedFlags(i) ) continue;
+                  checksum += (i+1)*std::fabs(std::floor(fixedAmb(i)+0.5)-truth(i));
+               }
+               checksum += lambda.getRatio();
+               fixedCount += lambda.getNumFixed();
+            }
+
+            cout << "n " << setw(3) << n << (ill ? " ill " : " well")
+                 << " per epoch : " << fixed << setw(10) << setprecision(3)
+                 << 1.0e6*seconds/epochs << " us, fixed "
+                 << setprecision(1) << double(fixedCount)/epochs << endl;
+
+            total += seconds;
+            solved += epochs;
+         }
+      }
+
+      cout << "per epoch : " << fixed << setw(10) << setprecision(3)
+           << 1.0e6*total/solved << " us" << endl
+           << "checksum " << scientific << setprecision(17) << checksum
+           << endl;
+   }
+   catch(Exception& e)
+   {
+      cerr << e << endl;
+      return 1;
+   }
+
+   return 0;
+
+}  // End of 'main()'
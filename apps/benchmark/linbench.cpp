@@ -0,0 +1,186 @@
+#pragma ident "$Id$"
+
+//============================================================================
+//
+//  This file is part of GPSTk, the GPS Toolkit.
+//
+//  The GPSTk is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU Lesser General Public License as published
+//  by the Free Software Foundation; either version 2.1 of the License, or
+//  any later version.
+//
+//  The GPSTk is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU Lesser General Public License for more details.
+//
+//  You should have received a copy of the GNU Lesser General Public
+//  License along with GPSTk; if not, write to the Free Software Foundation,
+//  Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110, USA
+//
+//============================================================================
+
+/**
+ * @file linbench.cpp
+ * Benchmark of ComputeLinear::Process() on a synthetic epoch of four
+ * constellations: GPS, GLONASS, Galileo and BeiDou satellites with their
+ * code and phase observables and model terms, and for each system the
+ * combinations of LinearCombinations used by the PPP programs: Pdelta,
+ * Melbourne-Wubbena, Ldelta, LI, PC, LC and the PC and LC prefit residuals,
+ * which use PC and LC computed before them. Prints the cost of one epoch
+ * and a checksum of the results, so that builds of the library may be
+ * compared.
+ *
+ * Usage: linbench [-s satellites] [-r repeat]
+ *
+ * 'satellites' is the number of satellites of each system, 10 by default,
+ * and the epoch is processed 'repeat' times, 100000 by default.
+ */
+
+#include <iostream>
+#include <iomanip>
+#include <string>
+#include <cstdlib>
+#include <ctime>
+
+#include "DataStructures.hpp"
+#include "LinearCombinations.hpp"
+#include "ComputeLinear.hpp"
+
+using namespace std;
+using namespace gpstk;
+
+int main(int argc, char *argv[])
+{
+
+   int nsats(10);
+   long repeat(100000);
+   for(int i=1; i<argc; i++)
+   {
+      string arg(argv[i]);
+      if(arg == "-s" && i+1 < argc) nsats = atoi(argv[++i]);
+      else if(arg == "-r" && i+1 < argc) repeat = atol(argv[++i]);
+      else
+      {
+         cout << "Usage: linbench [-s satellites] [-r repeat]" << endl;
+         return 1;
+      }
+   }
+
+   if(nsats < 1 || repeat < 1)
+   {
+      cout << "Usage: linbench [-s satellites] [-r repeat]" << endl;
+      return 1;
+   }
+
+   try
+   {
+      LinearCombinations comb;
+
+      ComputeLinear linear;
+      linear.addLinear(comb.pdeltaCombination);
+      linear.addLinear(comb.mwubbenaCombination);
+      linear.addLinear(comb.ldeltaCombination);
+      linear.addLinear(comb.liCombination);
+      linear.addLinear(comb.pcCombination);
+      linear.addLinear(comb.lcCombination);
+      linear.addLinear(comb.pcPrefit);
+      linear.addLinear(comb.lcPrefit);
+
+      linear.addGlonassLinear(comb.pdeltaCombForGlonass);
+      linear.addGlonassLinear(comb.mwubbenaCombForGlonass);
+      linear.addGlonassLinear(comb.ldeltaCombForGlonass);
+      linear.addGlonassLinear(comb.pcCombForGlonass);
+      linear.addGlonassLinear(comb.lcCombForGlonass);
+      linear.addGlonassLinear(comb.pcPrefit);
+      linear.addGlonassLinear(comb.lcPrefitForGlonass);
+
+      linear.addGalileoLinear(comb.pdeltaCombForGalileo);
+      linear.addGalileoLinear(comb.mwubbenaCombForGalileo);
+      linear.addGalileoLinear(comb.ldeltaCombForGalileo);
+      linear.addGalileoLinear(comb.liCombForGalileo);
+      linear.addGalileoLinear(comb.pcCombForGalileo);
+      linear.addGalileoLinear(comb.lcCombForGalileo);
+      linear.addGalileoLinear(comb.pcPrefit);
+      linear.addGalileoLinear(comb.lcPrefitForGalileo);
+
+      linear.addBeiDouLinear(comb.pdeltaCombForBeiDou);
+      linear.addBeiDouLinear(comb.mwubbenaCombForBeiDou);
+      linear.addBeiDouLinear(comb.ldeltaCombForBeiDou);
+      linear.addBeiDouLinear(comb.liCombForBeiDou);
+      linear.addBeiDouLinear(comb.pcCombForBeiDou);
+      linear.addBeiDouLinear(comb.lcCombForBeiDou);
+      linear.addBeiDouLinear(comb.pcPrefit);
+      linear.addBeiDouLinear(comb.lcPrefitForBeiDou);
+
+         // Observables of each system, in meters
+      const SatID::SatelliteSystem sys[4] = { SatID::systemGPS,
+                                              SatID::systemGlonass,
+                                              SatID::systemGalileo,
+                                              SatID::systemBeiDou };
+      const TypeID codes[4][2] = { { TypeID::P1, TypeID::P2 },
+                                   { TypeID::P1, TypeID::P2 },
+                                   { TypeID::C1, TypeID::C5 },
+                                   { TypeID::C2, TypeID::C7 } };
+      const TypeID phases[4][2] = { { TypeID::L1, TypeID::L2 },
+                                    { TypeID::L1, TypeID::L2 },
+                                    { TypeID::L1, TypeID::L5 },
+                                    { TypeID::L2, TypeID::L7 } };
+
+      satTypeValueMap epoch;
+      for(int s=0; s<4; s++)
+      {
+         for(int n=1; n<=nsats; n++)
+         {
+            SatID sat(n, sys[s]);
+            typeValueMap& tv( epoch[sat] );
+            double range( 2.0e7 + 1.0e5*n + 1.0e4*s );
+            tv[TypeID::C1] = range + 0.3;
+            tv[codes[s][0]] = range + 0.1;
+            tv[codes[s][1]] = range + 2.7;
+            tv[phases[s][0]] = range - 1.9 + 0.01*n;
+            tv[phases[s][1]] = range - 3.1 + 0.02*n;
+            tv[TypeID::rho] = range - 2.5;
+            tv[TypeID::dtSat] = 1.0e-4*n;
+            tv[TypeID::rel] = 0.5;
+            tv[TypeID::tropoSlant] = 2.4 + 0.1*n;
+            tv[TypeID::gravDelay] = 0.01;
+            tv[TypeID::satPCenter] = 0.2;
+            tv[TypeID::windUp] = 0.3*n;
+         }
+      }
+
+      clock_t start( clock() );
+      for(long r=0; r<repeat; r++)
+      {
+         linear.Process(CommonTime::BEGINNING_OF_TIME, epoch);
+      }
+      double seconds( double(clock()-start)/CLOCKS_PER_SEC );
+
+      double sum(0.0);
+      for(satTypeValueMap::iterator it = epoch.begin();
+          it != epoch.end();
+          ++it)
+      {
+         for(typeValueMap::iterator itt = it->second.begin();
+             itt != it->second.end();
+             ++itt)
+         {
+            sum += itt->second;
+         }
+      }
+
+      cout << "satellites " << epoch.size() << ", repeat " << repeat << endl
+           << "per epoch : " << fixed << setw(10) << setprecision(3)
+           << 1.0e6*seconds/repeat << " us" << endl
+           << "checksum " << scientific << setprecision(17) << sum << endl;
+   }
+   catch(Exception& e)
+   {
+      cerr << e << endl;
+      return 1;
+   }
+
+   return 0;
+
+}  // End of 'main()'
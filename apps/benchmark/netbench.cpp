@@ -0,0 +1,138 @@
+#pragma ident "$Id$"
+
+//============================================================================
+//
+//  This file is part of GPSTk, the GPS Toolkit.
+//
+//  The GPSTk is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU Lesser General Public License as published
+//  by the Free Software Foundation; either version 2.1 of the License, or
+//  any later version.
+//
+//  The GPSTk is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU Lesser General Public License for more details.
+//
+//  You should have received a copy of the GNU Lesser General Public
+//  License along with GPSTk; if not, write to the Free Software Foundation,
+//  Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110, USA
+//
+//============================================================================
+
+/**
+ * @file netbench.cpp
+ * Benchmark of NetworkObsStreams::readEpochData(): reads a network of
+ * RINEX observation files to the end, the first file being the reference.
+ * Prints the cost of one network epoch and a checksum of the data, so that
+ * builds of the library, and reading with and without read-ahead, may be
+ * compared.
+ *
+ * Usage: netbench [-a epochs] obsfile [obsfile ...]
+ *
+ * With -a, every file is decoded up to 'epochs' epochs ahead, in parallel
+ * when OpenMP is enabled. For example the ...0610.04o files of
+ * workplace/cc2noncc/data are a network of seven stations.
+ */
+
+#include <iostream>
+#include <iomanip>
+#include <string>
+#include <vector>
+#include <cstdlib>
+#include <ctime>
+
+#include "NetworkObsStreams.hpp"
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+using namespace std;
+using namespace gpstk;
+
+int main(int argc, char *argv[])
+{
+
+   int ahead(0);
+   vector<string> files;
+   for(int i=1; i<argc; i++)
+   {
+      string arg(argv[i]);
+      if(arg == "-a" && i+1 < argc) ahead = atoi(argv[++i]);
+      else files.push_back(arg);
+   }
+
+   if(files.empty() || ahead < 0)
+   {
+      cout << "Usage: netbench [-a epochs] obsfile [obsfile ...]" << endl;
+      return 1;
+   }
+
+   try
+   {
+      NetworkObsStreams network;
+      for(size_t f=0; f<files.size(); f++)
+      {
+         if(!network.addRinexObsFile(files[f]))
+         {
+            cerr << "Unable to open " << files[f] << endl;
+            return 1;
+         }
+      }
+      network.setReferenceSource(
+                           network.sourceIDOfRinexObsFile(files[0]) );
+      network.setReadAhead(ahead);
+
+      long nepochs(0), nsources(0);
+      double sum(0.0);
+      gnssDataMap gdsMap;
+
+         // wall clock, as decoding may run on several threads
+#ifdef _OPENMP
+      double start( omp_get_wtime() );
+#else
+      clock_t start( clock() );
+#endif
+      while( network.readEpochData(gdsMap) )
+      {
+         nepochs++;
+         for(gnssDataMap::iterator it = gdsMap.begin();
+             it != gdsMap.end();
+             ++it)
+         {
+            for(sourceDataMap::iterator its = it->second.begin();
+                its != it->second.end();
+                ++its)
+            {
+               nsources++;
+               for(satTypeValueMap::iterator itd = its->second.begin();
+                   itd != its->second.end();
+                   ++itd)
+               {
+                  sum += 1.0e-7*itd->second[TypeID::P1] + itd->first.id;
+               }
+            }
+         }
+      }
+#ifdef _OPENMP
+      double seconds( omp_get_wtime()-start );
+#else
+      double seconds( double(clock()-start)/CLOCKS_PER_SEC );
+#endif
+
+      cout << "files " << files.size() << ", read-ahead " << ahead << ", "
+           << nepochs << " epochs, " << nsources << " station epochs"
+           << endl << "per epoch : " << fixed << setw(10) << setprecision(3)
+           << 1.0e6*seconds/(nepochs > 0 ? nepochs : 1) << " us" << endl
+           << "checksum " << scientific << setprecision(17) << sum << endl;
+   }
+   catch(Exception& e)
+   {
+      cerr << e << endl;
+      return 1;
+   }
+
+   return 0;
+
+}  // End of 'main()'
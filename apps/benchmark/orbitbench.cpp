@@ -0,0 +1,116 @@
+#pragma ident "$Id$"
+
+//============================================================================
+//
+//  This file is part of GPSTk, the GPS Toolkit.
+//
+//  The GPSTk is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU Lesser General Public License as published
+//  by the Free Software Foundation; either version 2.1 of the License, or
+//  any later version.
+//
+//  The GPSTk is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU Lesser General Public License for more details.
+//
+//  You should have received a copy of the GNU Lesser General Public
+//  License along with GPSTk; if not, write to the Free Software Foundation,
+//  Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110, USA
+//
+//============================================================================
+
+/**
+ * @file orbitbench.cpp
+ * Benchmark of the orbit integration in Geodyn: a low orbit with the
+ * JGM3 geopotential, state and variational equations, integrated with
+ * fixed RKF78 steps. Prints the cost of one step and the final state, so
+ * that builds of the library may be compared for speed and results.
+ *
+ * Usage: orbitbench erpfile [steps [degree [stepsize]]]
+ *
+ * The ERP file is an IGS ERP file covering 2011-10-03, for example
+ * examples/py/data/igs16567.erp.
+ */
+
+#include <iostream>
+#include <iomanip>
+#include <cstdlib>
+#include <ctime>
+
+#include "IERS.hpp"
+#include "SatOrbit.hpp"
+#include "RungeKuttaFehlberg.hpp"
+
+using namespace std;
+using namespace gpstk;
+
+int main(int argc, char *argv[])
+{
+
+   if(argc < 2)
+   {
+      cout << "Usage: orbitbench erpfile [steps [degree [stepsize]]]" << endl;
+      return 1;
+   }
+
+   int nsteps(    argc > 2 ? atoi(argv[2]) : 2000 );
+   int degree(    argc > 3 ? atoi(argv[3]) : 20 );
+   double step(   argc > 4 ? atof(argv[4]) : 10.0 );
+
+   try
+   {
+      IERS::loadIGSFile(argv[1]);
+
+      UTCTime utc0(2011,10,3,0,0,0.0);
+
+      SatOrbit orbit;
+      orbit.setRefEpoch(utc0);
+      orbit.enableGeopotential(SatOrbit::GM_JGM3, degree, degree,
+                               false, false, false);
+
+      RungeKuttaFehlberg rkf;
+      rkf.setStepSize(step);
+
+         // Position and velocity, and the identity transition matrix
+      Vector<double> y(42,0.0);
+      y(0) = 2682920.8943;
+      y(1) = 4652720.5672;
+      y(2) = 4244260.0400;
+      y(3) = 2215.5999;
+      y(4) = 4183.3573;
+      y(5) = -5989.0576;
+      for(int i=0; i<3; i++)
+      {
+         y(6+4*i)  = 1.0;        // dr/dr0
+         y(33+4*i) = 1.0;        // dv/dv0
+      }
+
+      double t(0.0);
+
+      clock_t start( clock() );
+      for(int k=0; k<nsteps; k++)
+      {
+         y = rkf.integrateTo(t, y, &orbit, t+step);
+         t += step;
+      }
+      double seconds( double(clock()-start)/CLOCKS_PER_SEC );
+
+      cout << "steps " << nsteps << " of " << fixed << setprecision(1)
+           << step << " s, geopotential " << degree << "x" << degree << endl
+           << "per step : " << setw(10) << 1.0e6*seconds/nsteps
+           << " us" << endl
+           << scientific << setprecision(17)
+           << "r   " << y(0) << " " << y(1) << " " << y(2) << endl
+           << "v   " << y(3) << " " << y(4) << " " << y(5) << endl
+           << "phi " << y(6) << " " << y(20) << " " << y(40) << endl;
+   }
+   catch(Exception& e)
+   {
+      cerr << e << endl;
+      return 1;
+   }
+
+   return 0;
+
+}  // End of 'main()'
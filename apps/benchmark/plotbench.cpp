@@ -0,0 +1,159 @@
+#pragma ident "$Id$"
+
+//============================================================================
+//
+//  This file is part of GPSTk, the GPS Toolkit.
+//
+//  The GPSTk is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU Lesser General Public License as published
+//  by the Free Software Foundation; either version 2.1 of the License, or
+//  any later version.
+//
+//  The GPSTk is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU Lesser General Public License for more details.
+//
+//  You should have received a copy of the GNU Lesser General Public
+//  License along with GPSTk; if not, write to the Free Software Foundation,
+//  Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110, USA
+//
+//============================================================================
+
+/**
+ * @file plotbench.cpp
+ * Benchmark of the Vplot line and scatter plots on long time series: the
+ * residuals of a number of satellites at 1 Hz, with a few outliers, are
+ * drawn as a LinePlot and as a ScatterPlot to SVG images kept in memory.
+ * Prints the cost and the size of each plot and a checksum of the images,
+ * so that builds of the library may be compared.
+ *
+ * Usage: plotbench [-s satellites] [-n points] [-f]
+ *
+ * There are 30 satellites of 86400 points by default. With '-f' every
+ * point is drawn, as without decimation.
+ */
+
+#include <iostream>
+#include <iomanip>
+#include <sstream>
+#include <string>
+#include <vector>
+#include <cstdlib>
+#include <cstdio>
+#include <cmath>
+#include <ctime>
+
+#include "SVGImage.hpp"
+#include "LinePlot.hpp"
+#include "ScatterPlot.hpp"
+
+using namespace std;
+using namespace vdraw;
+using namespace vplot;
+
+   // Repeatable uniform numbers in [-1,1)
+static unsigned long seed(20161018UL);
+static double uniform(void)
+{
+   seed = (seed * 1103515245UL + 12345UL) & 0x7fffffffUL;
+   return 2.0*double(seed)/2147483648.0 - 1.0;
+}
+
+int main(int argc, char *argv[])
+{
+
+   int nsats(30);
+   long npoints(86400);
+   bool full(false);
+   for(int i=1; i<argc; i++)
+   {
+      string arg(argv[i]);
+      if(arg == "-s" && i+1 < argc) nsats = atoi(argv[++i]);
+      else if(arg == "-n" && i+1 < argc) npoints = atol(argv[++i]);
+      else if(arg == "-f") full = true;
+      else
+      {
+         cout << "Usage: plotbench [-s satellites] [-n points] [-f]" << endl;
+         return 1;
+      }
+   }
+
+   if(nsats < 1 || npoints < 2)
+   {
+      cout << "Usage: plotbench [-s satellites] [-n points] [-f]" << endl;
+      return 1;
+   }
+
+      // Residuals: a slow signal plus noise, with an outlier now and then
+   vector< vector< pair<double,double> > > series(nsats);
+   for(int s=0; s<nsats; s++)
+   {
+      series[s].reserve(npoints);
+      for(long k=0; k<npoints; k++)
+      {
+         const double t( static_cast<double>(k) );
+         double r( 0.02*std::sin(t/3600.0 + s) + 0.005*uniform() );
+         if( (k+37*s) % 10007 == 0 ) r += 0.1*uniform();
+         series[s].push_back( pair<double,double>(t, r) );
+      }
+   }
+
+   double checksum(0.0), total(0.0);
+
+   for(int scatter=0; scatter<2; scatter++)
+   {
+      ostringstream os;
+
+      clock_t start( clock() );
+      {
+         SVGImage image(os, 792, 612);
+         Frame frame(image);
+
+         if(scatter)
+         {
+            ScatterPlot plot;
+            if(full) plot.setResolution(0.0);
+            for(int s=0; s<nsats; s++)
+            {
+               char title[16];
+               snprintf(title, sizeof(title), "G%02d", s+1);
+               plot.addSeries(string(title), series[s]);
+            }
+            plot.drawPlot(frame);
+         }
+         else
+         {
+            LinePlot plot;
+            if(full) plot.setResolution(0.0);
+            for(int s=0; s<nsats; s++)
+            {
+               char title[16];
+               snprintf(title, sizeof(title), "G%02d", s+1);
+               plot.addSeries(string(title), series[s]);
+            }
+            plot.drawPlot(frame);
+         }
+      }
+      double seconds( double(clock()-start)/CLOCKS_PER_SEC );
+
+      const string svg( os.str() );
+      for(size_t i=0; i<svg.size(); i++)
+      {
+         checksum += double((unsigned char)svg[i]) * double(i%1009);
+      }
+      total += seconds;
+
+      cout << (scatter ? "scatter" : "line   ") << " : "
+           << fixed << setw(12) << setprecision(3) << 1.0e6*seconds
+           << " us, " << svg.size() << " bytes" << endl;
+   }
+
+   cout << "per epoch : " << fixed << setw(12) << setprecision(3)
+        << 1.0e6*total/2 << " us" << endl
+        << "checksum " << scientific << setprecision(17) << checksum
+        << endl;
+
+   return 0;
+
+}  // End of 'main()'
@@ -0,0 +1,123 @@
+#pragma ident "$Id$"
+
+//============================================================================
+//
+//  This file is part of GPSTk, the GPS Toolkit.
+//
+//  The GPSTk is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU Lesser General Public License as published
+//  by the Free Software Foundation; either version 2.1 of the License, or
+//  any later version.
+//
+//  The GPSTk is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU Lesser General Public License for more details.
+//
+//  You should have received a copy of the GNU Lesser General Public
+//  License along with GPSTk; if not, write to the Free Software Foundation,
+//  Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110, USA
+//
+//============================================================================
+
+/**
+ * @file pngbench.cpp
+ * Benchmark of the Vdraw PNG writer on a global map like those of
+ * SurfacePlot: a smooth TEC-like field on a 1 degree grid, written as an
+ * indexed image and as a true color one, oversampled. Prints the cost and
+ * the size of each image and a checksum of their CRC's, so that builds of
+ * the library may be compared.
+ *
+ * Usage: pngbench [-o oversampling] [-r repeat]
+ *
+ * Each pixel of the grid is 4 x 4 pixels of the image by default, and each
+ * image is written 'repeat' times, 5 by default.
+ */
+
+#include <iostream>
+#include <iomanip>
+#include <string>
+#include <cstdlib>
+#include <cmath>
+#include <ctime>
+
+#include "PNG.hpp"
+#include "CRC32.hpp"
+
+using namespace std;
+using namespace vdraw;
+
+int main(int argc, char *argv[])
+{
+
+   int os(4), repeat(5);
+   for(int i=1; i<argc; i++)
+   {
+      string arg(argv[i]);
+      if(arg == "-o" && i+1 < argc) os = atoi(argv[++i]);
+      else if(arg == "-r" && i+1 < argc) repeat = atoi(argv[++i]);
+      else
+      {
+         cout << "Usage: pngbench [-o oversampling] [-r repeat]" << endl;
+         return 1;
+      }
+   }
+
+   if(os < 1 || repeat < 1)
+   {
+      cout << "Usage: pngbench [-o oversampling] [-r repeat]" << endl;
+      return 1;
+   }
+
+   Palette p(Color(0,0,255), 0.0, 1.0);
+   p.setColor(0.5, Color(0,255,0));
+   p.setColor(1.0, Color(255,0,0));
+
+      // Equatorial anomaly crests and a smooth background
+   const int cols(360), rows(180);
+   InterpolatedColorMap icm(cols, rows, p);
+   for(int r=0; r<rows; r++)
+   {
+      double lat( (r - 90.0) * M_PI / 180.0 );
+      for(int c=0; c<cols; c++)
+      {
+         double lon( c * M_PI / 180.0 );
+         double v( 0.3 + 0.2*std::cos(lon - 0.5)*std::cos(lat)
+                   + 0.4*std::exp(-std::pow((std::fabs(lat)-0.26)/0.12, 2))
+                     *(0.6 + 0.4*std::cos(lon)) );
+         icm.setColor(r, c, std::min(std::max(v, 0.0), 1.0));
+      }
+   }
+   ColorMap cm(icm);
+
+   double checksum(0.0), total(0.0);
+
+   for(int full=0; full<2; full++)
+   {
+      PNG::string_ptr png;
+
+      clock_t start( clock() );
+      for(int k=0; k<repeat; k++)
+      {
+         png = full ? PNG::png(cm, os, os) : PNG::png(icm, os, os);
+      }
+      double seconds( double(clock()-start)/CLOCKS_PER_SEC/repeat );
+
+      CRC32 crc;
+      crc.update(*png);
+      checksum += double(crc.getValue()) + double(png->size());
+      total += seconds;
+
+      cout << (full ? "true color" : "indexed   ") << " : "
+           << fixed << setw(12) << setprecision(3) << 1.0e6*seconds
+           << " us, " << png->size() << " bytes" << endl;
+   }
+
+   cout << "per epoch : " << fixed << setw(12) << setprecision(3)
+        << 1.0e6*total/2 << " us" << endl
+        << "checksum " << scientific << setprecision(17) << checksum
+        << endl;
+
+   return 0;
+
+}  // End of 'main()'
@@ -0,0 +1,163 @@
+#pragma ident "$Id$"
+
+//============================================================================
+//
+//  This file is part of GPSTk, the GPS Toolkit.
+//
+//  The GPSTk is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU Lesser General Public License as published
+//  by the Free Software Foundation; either version 2.1 of the License, or
+//  any later version.
+//
+//  The GPSTk is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU Lesser General Public License for more details.
+//
+//  You should have received a copy of the GNU Lesser General Public
+//  License along with GPSTk; if not, write to the Free Software Foundation,
+//  Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110, USA
+//
+//============================================================================
+
+/**
+ * @file srifbench.cpp
+ * Benchmark of the estimation loop of DDBase (apps/geomatics/relposition)
+ * on a simulated network: one fixed site and the positions of the others,
+ * a residual zenith delay per site, and a double difference bias for each
+ * baseline and satellite pair. At each epoch the double differences of all
+ * baselines, correlated through their common reference satellite, are
+ * given to SRIFilter::measurementUpdate(), as Estimation.cpp does; at the
+ * end the state and covariance are computed. Prints the cost of one update
+ * and a checksum of the solution, so that builds of the library may be
+ * compared.
+ *
+ * Usage: srifbench [sites [satellites [epochs]]]
+ *
+ * The default is 20 sites, 10 satellites and 100 epochs; that is 248
+ * states and 171 double differences per epoch.
+ */
+
+#include <iostream>
+#include <iomanip>
+#include <cstdlib>
+#include <cmath>
+#include <ctime>
+
+#include "SRIFilter.hpp"
+
+using namespace std;
+using namespace gpstk;
+
+   // Repeatable uniform numbers in [-1,1)
+static unsigned long seed(20161017UL);
+static double uniform(void)
+{
+   seed = (seed * 1103515245UL + 12345UL) & 0x7fffffffUL;
+   return 2.0*double(seed)/2147483648.0 - 1.0;
+}
+
+int main(int argc, char *argv[])
+{
+
+   int nsites(  argc > 1 ? atoi(argv[1]) : 20 );
+   int nsats(   argc > 2 ? atoi(argv[2]) : 10 );
+   int nepochs( argc > 3 ? atoi(argv[3]) : 100 );
+
+   if(nsites < 2 || nsats < 2 || nepochs < 1)
+   {
+      cout << "Usage: srifbench [sites [satellites [epochs]]]" << endl;
+      return 1;
+   }
+
+   try
+   {
+      const int nbl(nsites-1);               // baselines from the fixed site
+      const int ndd(nsats-1);                // double differences per baseline
+      const int nbias(nbl*ndd);
+      const int N(3*nbl + nsites + nbias);   // positions, RZDs and biases
+      const int M(nbl*ndd);
+
+      Namelist NL(N);
+      SRIFilter srif(NL);
+
+         // a priori: loose positions and biases, tight zenith delays
+      Matrix<double> apCov(N,N,0.0);
+      Vector<double> apState(N,0.0);
+      for(int i=0; i<N; i++)
+         apCov(i,i) = (i >= 3*nbl && i < 3*nbl+nsites ? 0.25 : 100.0);
+      srif.addAPriori(apCov,apState);
+
+         // satellite directions, slowly moving
+      Matrix<double> dir(nsats,3), rate(nsats,3);
+      for(int s=0; s<nsats; s++)
+      {
+         for(int k=0; k<3; k++)
+         {
+            dir(s,k) = uniform();
+            rate(s,k) = 1.e-3 * uniform();
+         }
+      }
+
+         // double difference covariance: 2 on the diagonal and 1 between
+         // the double differences of a baseline, which share a satellite
+      Matrix<double> MC(M,M,0.0);
+      for(int b=0; b<nbl; b++)
+      {
+         for(int i=0; i<ndd; i++)
+            for(int j=0; j<ndd; j++)
+               MC(b*ndd+i,b*ndd+j) = (i == j ? 2.0 : 1.0);
+      }
+
+      double seconds(0.0);
+      for(int e=0; e<nepochs; e++)
+      {
+         Matrix<double> P(M,N,0.0);
+         Vector<double> f(M);
+
+         for(int b=0; b<nbl; b++)
+         {
+            for(int i=0; i<ndd; i++)
+            {
+               int m(b*ndd+i);
+               for(int k=0; k<3; k++)     // position of the remote site
+                  P(m,3*b+k) = dir(i+1,k) + e*rate(i+1,k)
+                             - dir(0,k) - e*rate(0,k);
+               P(m,3*nbl+b+1) = 1.0 + 0.1*uniform();  // RZD of each end
+               P(m,3*nbl)     = -1.0 - 0.1*uniform();
+               P(m,3*nbl+nsites+m) = 1.0;             // bias
+               f(m) = 0.01 * uniform();
+            }
+         }
+
+         clock_t start( clock() );
+         srif.measurementUpdate(P,f,MC);
+         seconds += double(clock()-start)/CLOCKS_PER_SEC;
+      }
+
+      Vector<double> X;
+      Matrix<double> Cov;
+      double small, big;
+      clock_t start( clock() );
+      srif.getStateAndCovariance(X,Cov,&small,&big);
+      double solve( double(clock()-start)/CLOCKS_PER_SEC );
+
+      double sum(0.0);
+      for(int i=0; i<N; i++) sum += X(i) + Cov(i,i);
+
+      cout << "sites " << nsites << ", satellites " << nsats << ", states "
+           << N << ", data " << M << " per epoch, " << nepochs << " epochs"
+           << endl << "per update : " << fixed << setw(10) << setprecision(3)
+           << 1.0e3*seconds/nepochs << " ms" << endl
+           << "solution   : " << setw(10) << 1.0e3*solve << " ms" << endl
+           << "checksum " << scientific << setprecision(17) << sum << endl;
+   }
+   catch(Exception& e)
+   {
+      cerr << e << endl;
+      return 1;
+   }
+
+   return 0;
+
+}  // End of 'main()'
@@ -0,0 +1,118 @@
+#pragma ident "$Id$"
+
+//============================================================================
+//
+//  This file is part of GPSTk, the GPS Toolkit.
+//
+//  The GPSTk is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU Lesser General Public License as published
+//  by the Free Software Foundation; either version 2.1 of the License, or
+//  any later version.
+//
+//  The GPSTk is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU Lesser General Public License for more details.
+//
+//  You should have received a copy of the GNU Lesser General Public
+//  License along with GPSTk; if not, write to the Free Software Foundation,
+//  Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110, USA
+//
+//============================================================================
+
+/**
+ * @file tropbench.cpp
+ * Microbenchmark of the Neill tropospheric model: the per satellite calls
+ * made by ComputeTropModel before, against the batched mapping functions
+ * with the coefficients prepared once per station and epoch.
+ *
+ * Usage: tropbench [epochs [satellites]]
+ */
+
+#include <iostream>
+#include <iomanip>
+#include <vector>
+#include <cstdlib>
+#include <cmath>
+#include <ctime>
+
+#include "TropModel.hpp"
+
+using namespace std;
+using namespace gpstk;
+
+int main(int argc, char *argv[])
+{
+
+   int nepochs( argc > 1 ? atoi(argv[1]) : 200000 );
+   int nsats(   argc > 2 ? atoi(argv[2]) : 12 );
+
+      // A station at mid latitude, and a spread of elevations
+   NeillTropModel neill(250.0, 41.5, 180);
+
+   vector<double> elevation(nsats);
+   for(int i=0; i<nsats; i++)
+   {
+      elevation[i] = 5.0 + 80.0*i/double(nsats);
+   }
+
+   vector<double> dryMap(nsats), wetMap(nsats);
+   double sum1(0.0), sum2(0.0), maxDiff(0.0);
+
+      // Every epoch the station is prepared again, as a positioning
+      // program does when the receiver position is updated
+   clock_t start( clock() );
+   for(int k=0; k<nepochs; k++)
+   {
+      neill.setReceiverHeight(250.0 + 1.0e-6*(k%10));
+
+      for(int i=0; i<nsats; i++)
+      {
+         sum1 += neill.correction(elevation[i])
+               + neill.dry_zenith_delay() + neill.wet_zenith_delay()
+               + neill.dry_mapping_function(elevation[i])
+               + neill.wet_mapping_function(elevation[i]);
+      }
+   }
+   double perSat( double(clock()-start)/CLOCKS_PER_SEC );
+
+   start = clock();
+   for(int k=0; k<nepochs; k++)
+   {
+      neill.setReceiverHeight(250.0 + 1.0e-6*(k%10));
+
+      double dz( neill.dry_zenith_delay() );
+      double wz( neill.wet_zenith_delay() );
+      neill.mapping_functions(elevation, dryMap, wetMap);
+
+      for(int i=0; i<nsats; i++)
+      {
+         sum2 += dz*dryMap[i] + wz*wetMap[i] + dz + wz + dryMap[i] + wetMap[i];
+      }
+   }
+   double batch( double(clock()-start)/CLOCKS_PER_SEC );
+
+      // The batched values must be the same as the single ones
+   for(int i=0; i<nsats; i++)
+   {
+      maxDiff = max( maxDiff,
+                     fabs(dryMap[i]-neill.dry_mapping_function(elevation[i])) );
+      maxDiff = max( maxDiff,
+                     fabs(wetMap[i]-neill.wet_mapping_function(elevation[i])) );
+   }
+
+   double n( double(nepochs)*nsats );
+
+   cout << fixed << setprecision(1)
+        << "epochs " << nepochs << ", satellites " << nsats << endl
+        << "per satellite calls : " << setw(8) << 1.0e9*perSat/n
+        << " ns/satellite" << endl
+        << "batched per epoch   : " << setw(8) << 1.0e9*batch/n
+        << " ns/satellite" << endl
+        << scientific << setprecision(3)
+        << "checksums " << sum1 << " " << sum2
+        << ", max mapping difference " << maxDiff << endl;
+
+   return ( maxDiff < 1.0e-12 ? 0 : 1 );
+
+}  // End of 'main()'
@@ -0,0 +1,332 @@
+#pragma ident "$Id$"
+
+//============================================================================
+//
+//  This file is part of GPSTk, the GPS Toolkit.
+//
+//  The GPSTk is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU Lesser General Public License as published
+//  by the Free Software Foundation; either version 2.1 of the License, or
+//  any later version.
+//
+//  The GPSTk is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU Lesser General Public License for more details.
+//
+//  You should have received a copy of the GNU Lesser General Public
+//  License along with GPSTk; if not, write to the Free Software Foundation,
+//  Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110, USA
+//
+//============================================================================
+
+/**
+ * @file xvtbench.cpp
+ * Stress test and benchmark of the ephemeris and clock stores shared by
+ * several threads. Positions and clocks of every satellite in the given
+ * files are asked for at a fixed interval, first from a single thread,
+ * then from all the OpenMP threads at once, with the stores as loaded and
+ * once frozen. The threaded results must be the same as the single
+ * threaded ones, bit for bit; the number of those that differ is printed
+ * with the cost of one query in each case and a checksum of the results,
+ * so that builds of the library may be compared.
+ *
+ * Usage: xvtbench [-t threads] [-i interval] [-r repeat] file [file ...]
+ *
+ * Files ending in '.sp3' go to a SP3EphemerisStore, files ending in '.clk'
+ * to a RinexClockStore and the others, RINEX navigation files, to a
+ * Rinex3EphemerisStore. The interval is 30 s by default, and the threaded
+ * queries are repeated 'repeat' times, 5 by default. For example
+ * examples/brdc0300.02n workplace/pppgnss/brdc0370.16g
+ * examples/py/data/igs16571.sp3 examples/py/data/igs16571.clk.
+ */
+
+#include <iostream>
+#include <iomanip>
+#include <string>
+#include <vector>
+#include <cstdlib>
+#include <cstring>
+#include <ctime>
+
+#include "Rinex3EphemerisStore.hpp"
+#include "SP3EphemerisStore.hpp"
+#include "RinexClockStore.hpp"
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+using namespace std;
+using namespace gpstk;
+
+   // Where a query goes
+enum StoreKind { navKind, sp3Kind, clkKind };
+
+   // One query, and its results: position and clock, or clock only
+struct Query
+{
+   StoreKind kind;
+   SatID sat;
+   CommonTime time;
+};
+
+struct Result
+{
+   bool valid;
+   double value[4];
+};
+
+   // The stores
+static Rinex3EphemerisStore navStore;
+static SP3EphemerisStore sp3Store;
+static RinexClockStore clkStore;
+
+static Result ask(const Query& q)
+{
+   Result r;
+   r.valid = false;
+   for(int k=0; k<4; k++) r.value[k] = 0.0;
+
+   try
+   {
+      if(q.kind == clkKind)
+      {
+         r.value[3] = clkStore.getClockBias(q.sat, q.time);
+      }
+      else
+      {
+         Xvt xvt( q.kind == navKind ? navStore.getXvt(q.sat, q.time)
+                                    : sp3Store.getXvt(q.sat, q.time) );
+         for(int k=0; k<3; k++) r.value[k] = xvt.x[k];
+         r.value[3] = xvt.clkbias;
+      }
+      r.valid = true;
+   }
+   catch(Exception& e)
+   {
+   }
+
+   return r;
+}
+
+   // Queries of one satellite at 'interval' over [first, last]
+static void addQueries( vector<Query>& queries,
+                        StoreKind kind,
+                        const SatID& sat,
+                        const CommonTime& first,
+                        const CommonTime& last,
+                        double interval )
+{
+   Query q;
+   q.kind = kind;
+   q.sat = sat;
+   for(q.time = first; q.time <= last; q.time += interval)
+   {
+      queries.push_back(q);
+   }
+}
+
+static bool endsWith(const string& name, const char *end)
+{
+   const size_t n( strlen(end) );
+   return name.size() >= n && name.compare(name.size()-n, n, end) == 0;
+}
+
+   // Wall clock, as queries may run on several threads
+static double wallClock(void)
+{
+#ifdef _OPENMP
+   return omp_get_wtime();
+#else
+   return double(clock())/CLOCKS_PER_SEC;
+#endif
+}
+
+   // Ask all the queries 'repeat' times from all the threads, and count
+   // the results that differ from the reference ones
+static long threaded( const vector<Query>& queries,
+                      const vector<Result>& reference,
+                      int repeat,
+                      double& seconds )
+{
+   const long n( queries.size() );
+   long differ(0);
+
+   double start( wallClock() );
+   for(int r=0; r<repeat; r++)
+   {
+#pragma omp parallel for schedule(dynamic,16) reduction(+:differ)
+      for(long i=0; i<n; i++)
+      {
+         Result res( ask(queries[i]) );
+         if(res.valid != reference[i].valid ||
+            memcmp(res.value, reference[i].value, sizeof(res.value)) != 0)
+         {
+            differ++;
+         }
+      }
+   }
+   seconds = wallClock() - start;
+
+   return differ;
+}
+
+int main(int argc, char *argv[])
+{
+
+   int threads(0), repeat(5);
+   double interval(30.0);
+   vector<string> files;
+   for(int i=1; i<argc; i++)
+   {
+      string arg(argv[i]);
+      if(arg == "-t" && i+1 < argc) threads = atoi(argv[++i]);
+      else if(arg == "-i" && i+1 < argc) interval = atof(argv[++i]);
+      else if(arg == "-r" && i+1 < argc) repeat = atoi(argv[++i]);
+      else files.push_back(arg);
+   }
+
+   if(files.empty() || threads < 0 || interval <= 0.0 || repeat < 1)
+   {
+      cout << "Usage: xvtbench [-t threads] [-i interval] [-r repeat] "
+           << "file [file ...]" << endl;
+      return 1;
+   }
+
+#ifdef _OPENMP
+   if(threads > 0) omp_set_num_threads(threads);
+   threads = omp_get_max_threads();
+#else
+   threads = 1;
+#endif
+
+   try
+   {
+      bool haveNav(false), haveSP3(false), haveClk(false);
+      for(size_t f=0; f<files.size(); f++)
+      {
+         if(endsWith(files[f], ".sp3"))
+         {
+            sp3Store.loadSP3File(files[f]);
+            haveSP3 = true;
+         }
+         else if(endsWith(files[f], ".clk"))
+         {
+            clkStore.loadFile(files[f]);
+            haveClk = true;
+         }
+         else
+         {
+            navStore.loadFile(files[f]);
+            haveNav = true;
+         }
+      }
+
+         // Every satellite of every store, over its own time span
+      vector<Query> queries;
+      const SatID::SatelliteSystem systems[2] = { SatID::systemGPS,
+                                                  SatID::systemGlonass };
+      for(int s=0; s<2; s++)
+      {
+         for(int prn=1; prn<=32; prn++)
+         {
+            SatID sat(prn, systems[s]);
+            if(haveNav && navStore.isPresent(sat))
+            {
+               addQueries( queries, navKind, sat,
+                           navStore.getInitialTime(sat),
+                           navStore.getFinalTime(sat), interval );
+            }
+         }
+      }
+
+      if(haveSP3)
+      {
+         vector<SatID> sats( sp3Store.getSatList() );
+         for(size_t i=0; i<sats.size(); i++)
+         {
+            addQueries( queries, sp3Kind, sats[i],
+                        sp3Store.getInitialTime(),
+                        sp3Store.getFinalTime(), interval );
+         }
+      }
+
+      if(haveClk)
+      {
+         vector<SatID> sats( clkStore.getSatList() );
+         for(size_t i=0; i<sats.size(); i++)
+         {
+            addQueries( queries, clkKind, sats[i],
+                        clkStore.getInitialTime(sats[i]),
+                        clkStore.getFinalTime(sats[i]), interval );
+         }
+      }
+
+      const long n( queries.size() );
+      if(n == 0)
+      {
+         cerr << "No satellites found" << endl;
+         return 1;
+      }
+
+         // Reference results, from one thread
+      vector<Result> reference(n);
+      double start( wallClock() );
+      for(long i=0; i<n; i++)
+      {
+         reference[i] = ask(queries[i]);
+      }
+      double singleSeconds( wallClock() - start );
+
+         // All the threads, with the stores as loaded, and then frozen
+      double lockedSeconds(0.0), frozenSeconds(0.0);
+      long lockedDiffer( threaded(queries, reference, repeat, lockedSeconds) );
+
+      navStore.freeze();
+      sp3Store.freeze();
+      if( !navStore.isFrozen() || !sp3Store.isFrozen() )
+      {
+         cerr << "Stores not frozen" << endl;
+         return 1;
+      }
+      long frozenDiffer( threaded(queries, reference, repeat, frozenSeconds) );
+
+      long failed(0);
+      double checksum(0.0);
+      for(long i=0; i<n; i++)
+      {
+         if( !reference[i].valid )
+         {
+            failed++;
+            continue;
+         }
+         checksum += 1.0e-3*( reference[i].value[0] + reference[i].value[1]
+                              + reference[i].value[2] )
+                     + 1.0e3*reference[i].value[3];
+      }
+
+      cout << "queries " << n << ", " << failed << " failed, threads "
+           << threads << endl
+           << "single   per query : " << fixed << setw(10) << setprecision(3)
+           << 1.0e6*singleSeconds/n << " us" << endl
+           << "locked   per query : " << setw(10)
+           << 1.0e6*lockedSeconds/(double(n)*repeat) << " us, "
+           << lockedDiffer << " differing" << endl
+           << "frozen   per query : " << setw(10)
+           << 1.0e6*frozenSeconds/(double(n)*repeat) << " us, "
+           << frozenDiffer << " differing" << endl
+           << "checksum " << scientific << setprecision(17) << checksum
+           << endl;
+
+      if(lockedDiffer > 0 || frozenDiffer > 0) return 1;
+   }
+   catch(Exception& e)
+   {
+      cerr << e << endl;
+      return 1;
+   }
+
+   return 0;
+
+}  // End of 'main()'
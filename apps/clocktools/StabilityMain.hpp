@@ -0,0 +1,116 @@
+#pragma ident "$Id$"
+/**********************************************
+/ GPSTk: Clock Tools
+/ StabilityMain.hpp
+/
+/ Common driver for the frequency stability
+/ programs (oallandev, mallandev, ohadamarddev,
+/ tallandev)
+**********************************************/
+
+//============================================================================
+//
+//  This file is part of GPSTk, the GPS Toolkit.
+//
+//  The GPSTk is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU Lesser General Public License as published
+//  by the Free Software Foundation; either version 2.1 of the License, or
+//  any later version.
+//
+//  The GPSTk is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU Lesser General Public License for more details.
+//
+//  You should have received a copy of the GNU Lesser General Public
+//  License along with GPSTk; if not, write to the Free Software Foundation,
+//  Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110, USA
+//
+//  Copyright 2009, The University of Texas at Austin
+//
+//============================================================================
+
+#ifndef CLOCKTOOLS_STABILITYMAIN_HPP
+#define CLOCKTOOLS_STABILITYMAIN_HPP
+
+#include <iostream>
+#include <vector>
+#include <string>
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "ClockStability.hpp"
+
+// Read time and clock phase pairs from the standard input, and write
+// "tau deviation" lines to the standard output for the given statistic.
+//
+// Options:
+//   -o, --octave     octave spaced taus (1,2,4,8,... times tau0)
+//   -d, --decade     decade spaced taus (1,2,4,10,20,40,... times tau0)
+//   -j, --threads n  number of threads used over the taus
+// The default is every multiple of tau0.
+inline int stabilityMain(int argc, char **argv,
+                         gpstk::ClockStability::DeviationType type,
+                         const std::string& description)
+{
+   using namespace std;
+   using namespace gpstk;
+
+   ClockStability::TauSpacing spacing(ClockStability::AllTau);
+   int threads(0);
+
+   for(int k=1; k<argc; k++)
+   {
+      string str = argv[k];
+      if((str == "-h") || (str == "--help"))
+      {
+         cout << description << endl
+              << "  -o, --octave     octave spaced taus" << endl
+              << "  -d, --decade     decade spaced taus (1,2,4 per decade)" << endl
+              << "  -j, --threads n  use n threads" << endl
+              << "  default is every multiple of the sample interval" << endl;
+         return 1;
+      }
+      else if((str == "-o") || (str == "--octave"))
+         spacing = ClockStability::OctaveTau;
+      else if((str == "-d") || (str == "--decade"))
+         spacing = ClockStability::DecadeTau;
+      else if(((str == "-j") || (str == "--threads")) && k+1 < argc)
+         threads = atoi(argv[++k]);
+   }
+
+   // The phase data is read from the standard input straight into the
+   // stability engine; the first two time tags give the sample interval
+   ClockStability cs;
+   long double time, phase, time0(0.0), time1(0.0);
+   unsigned long i(0);
+   while(cin >> time >> phase)
+   {
+      if(i == 0) time0 = time;
+      else if(i == 1) time1 = time;
+      cs.add(double(phase));
+      i++;
+   }
+
+   if(cs.maxFactor(type) == 0)
+   {
+      cout << "Not Enough Points to Calculate Tau0" << endl;
+      return 0;
+   }
+
+   cs.setTau0(double(time1 - time0)).setThreads(threads);
+
+   vector<double> tau, dev;
+   cs.compute(type, spacing, tau, dev);
+
+   for(size_t k=0; k<tau.size(); k++)
+   {
+      // outputs results to the standard output
+      fprintf(stdout, "%.1f %.4e \n", tau[k], dev[k]);
+   }
+
+   return 0;
+}
+
+#endif // CLOCKTOOLS_STABILITYMAIN_HPP
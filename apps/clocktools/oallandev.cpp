@@ -33,88 +33,12 @@
 //============================================================================
 
 
-#include <iostream>
-#include <vector>
-#include <string>
-
-#include <stdio.h>
-#include <string.h>
-#include <math.h>
-
-using namespace std;
+#include "StabilityMain.hpp"
 
+// The deviation is computed by gpstk::ClockStability, in O(N) per tau;
+// see StabilityMain.hpp for the options.
 int main(int argv, char **argc)
 {
-	if(argc[1])
-	{
-		string str = argc[1];
-		if((str == "-h") || (str == "--help"))
-		{
-	  	cout << "oallandev: Computes the overlapping Allan deviation from the standard input." << endl;
-	  	return 1;
-		}
-	}
-	// Structures used to store time and clock phase information
-	vector <double> timeArray;
-	vector <double> phaseArray;
-	long double time, phase;
-	long unsigned int numPoints, i, numGaps, N, m;
-	
-	// All of the time and clock phase data is read in from the standard input
-	i = 0;
-	while(!feof(stdin))
-	{
-		cin >> time >> phase;
-		if(feof(stdin)) break;
-		timeArray.resize(i+1);
-		phaseArray.resize(i+1);
-		timeArray[i] = time;
-		phaseArray[i] = phase;
-		i++;
-	}
-	
-	numPoints = i-1;
-	
-	// Variables used in Overlapping Allan Deviation calculations
-	double Tau, Tau0, sum, sigma;
-	
-	// Ensures there are at least the minimum number of points required to do calculations
-	N = numPoints;
-	if(N > 1) Tau0 = timeArray[1] - timeArray[0];
-	else
-	{
-		cout << "Not Enough Points to Calculate Tau0" << endl;
-	}
-	
-	// Actual Overlapping Allan Deviation Calculation is done here
-	// The Overlapping Allan Deviation is calculated as follows
-	//  Sigma^2(Tau) = 1 / (2*(N-2*m)*Tau^2) * Sum(X[i+2*m]-2*X[i+m]+X[i], i=1, i=N-2*m)
-	//  Where Tau is the averaging time, N is the total number of points, and Tau = m*Tau0
-	//  Where Tau0 is the basic measurement interval
-	
-        for(m = 1; m <= (N-1)/2; m++)
-	{
-	        numGaps=0;
-                Tau = m*Tau0;
-		sigma = 0;
-		
-		for(i = 0; i < (N-2*m); i++)
-		{
-			sum = 0;
-			if((phaseArray[i+2*m]==0 ||  phaseArray[i+m]==0 || phaseArray[i]==0) 
-			   && i!=0 && i!=(N-2*m-1))
-			    numGaps++;
-                        else
-                            sum = phaseArray[i+2*m] - 2*phaseArray[i+m] + phaseArray[i];
-			sigma += sum * sum;
-		}
-		
-		sigma = sigma / (2.0*((double)N-(double)numGaps-0-2.0*(double)m)*Tau*Tau);
-		sigma = sqrt(sigma);
-		fprintf(stdout, "%.1f %.4e \n", Tau, sigma); // outputs results to the standard output
-        }
-	/*************
-	*************/
-
-	return(0);
+	return stabilityMain(argv, argc, gpstk::ClockStability::OverlappingAllan,
+	   "oallandev: Computes the overlapping Allan deviation from the standard input.");
 }
@@ -52,90 +52,21 @@
    // Class for handling observation RINEX files
 #include "RinexObsStream.hpp"
 
-   // Class to store satellite precise navigation data
-#include "SP3EphemerisStore.hpp"
-
    // Class to store a list of processing objects
 #include "ProcessingList.hpp"
 
-   // Class in charge of basic GNSS signal modelling
-#include "BasicModel.hpp"
-
-   // Class to model the tropospheric delays
-#include "TropModel.hpp"
-
    // Class defining the GNSS data structures
 #include "DataStructures.hpp"
 
-   // Class to filter out satellites without required observables
-#include "RequireObservables.hpp"
-
-   // Class to filter out observables grossly out of limits
-#include "SimpleFilter.hpp"
-
-   // Class for easily changing reference base from ECEF to NEU
-#include "XYZ2NEU.hpp"
-
-   // Class to detect cycle slips using LI combination
-#include "LICSDetector.hpp"
-
-   // Class to detect cycle slips using the Melbourne-Wubbena combination
-#include "MWCSDetector2.hpp"
-
-   // Class to compute the effect of solid tides
-#include "SolidTides.hpp"
-
-   // Class to compute the effect of ocean loading
-#include "OceanLoading.hpp"
-
-   // Class to compute the effect of pole tides
-#include "PoleTides.hpp"
-
-   // Class to correct observables
-#include "CorrectObservables.hpp"
-
-   // Classes to deal with Antex antenna parameters
-#include "Antenna.hpp"
-#include "AntexReader.hpp"
-
-   // Class to compute the effect of wind-up
-#include "ComputeWindUp.hpp"
-
-   // Class to compute the effect of satellite antenna phase center
-#include "ComputeSatPCenter.hpp"
+   // Class holding the data stores of the PPP processing
+#include "PPPDataStores.hpp"
 
-   // Class to compute the tropospheric data
-#include "ComputeTropModel.hpp"
-
-   // Class to compute linear combinations
-#include "ComputeLinear.hpp"
-
-   // This class pre-defines several handy linear combinations
-#include "LinearCombinations.hpp"
+   // Class processing the observations up to the prefit residuals
+#include "PPPProcessing.hpp"
 
    // Class to compute Dilution Of Precision values
 #include "ComputeDOP.hpp"
 
-   // Class to keep track of satellite arcs
-#include "SatArcMarker.hpp"
-
-   // Class to keep track of satellite arcs
-#include "SatArcMarker2.hpp"
-
-   // Class to compute gravitational delays
-#include "GravitationalDelay.hpp"
-
-   // Class to align phases with code measurements
-#include "PhaseCodeAlignment.hpp"
-
-   // Used to delete satellites in eclipse
-#include "EclipsedSatFilter.hpp"
-
-   // Used to decimate data. This is important because RINEX observation
-   // data is provided with a 30 s sample rate, whereas SP3 files provide
-   // satellite clock information with a 900 s sample rate.
-#include "Decimate.hpp"
-
    // Class to compute the Precise Point Positioning (PPP) solution in
    // forwards-only mode.
 #include "SolverPPP.hpp"
@@ -144,24 +75,9 @@
    // forwards-backwards mode.
 #include "SolverPPPFB.hpp"
 
-   // Class to filter the MW combination
-#include "MWFilter.hpp"
-
    // Class to read configuration files.
 #include "ConfDataReader.hpp"
 
-   // Class to compute the elevation weights
-#include "ComputeElevWeights.hpp"
-
-   // Class to store satellite precise navigation data
-#include "MSCStore.hpp"
-
-   // Class to convert the CC to NONCC.
-#include "CC2NONCC.hpp"
-
-   // Class to read and store the receiver type.
-#include "RecTypeDataReader.hpp"
-
 
 
 
@@ -533,218 +449,34 @@ void ppp::spinUp()
    // Method that will really process information
 void ppp::process()
 {
-      //**********************************************
-      // Now, Let's read SP3 Files
-      //**********************************************
-
-      // Declare a "SP3EphemerisStore" object to handle precise ephemeris
-   SP3EphemerisStore SP3EphList;
-
-      // Set flags to reject satellites with bad or absent positional
-      // values or clocks
-   SP3EphList.rejectBadPositions(true);
-   SP3EphList.rejectBadClocks(true);
-
-      // Now read sp3 files from 'sp3FileList'
-   ifstream sp3FileListStream;
-
-   sp3FileListStream.open(sp3FileListName.c_str(), ios::in);
-   if(!sp3FileListStream)
-   {
-         // If file doesn't exist, issue a warning
-      cerr << "SP3 file List Name'" << sp3FileListName << "' doesn't exist or you don't "
-           << "have permission to read it." << endl;
-
-      exit(-1);
-   }
-
-   string sp3File;
-   while( sp3FileListStream >> sp3File )
-   {
-      try
-      {
-         SP3EphList.loadFile( sp3File );
-      }
-      catch (FileMissingException& e)
-      {
-            // If file doesn't exist, issue a warning
-         cerr << "SP3 file '" << sp3File << "' doesn't exist or you don't "
-              << "have permission to read it. Skipping it." << endl;
-         continue;
-      }
-   }
-      // Close file
-   sp3FileListStream.close();
-
-      //***********************
-      // Let's read clock files
-      //***********************
-
-      // If rinex clock file list is given, then use rinex clock
-   if(clkFileListOpt.getCount())
-   {
-         // Now read clk files from 'clkFileList'
-      ifstream clkFileListStream;
-
-         // Open clkFileList File
-      clkFileListStream.open(clkFileListName.c_str(), ios::in);
-      if(!clkFileListStream)
-      {
-            // If file doesn't exist, issue a warning
-         cerr << "clock file List Name'" << clkFileListName << "' doesn't exist or you don't "
-              << "have permission to read it." << endl;
-
-         exit(-1);
-      }
-
-      string clkFile;
-      while( clkFileListStream >> clkFile )
-      {
-         try
-         {
-            SP3EphList.loadRinexClockFile( clkFile );
-         }
-         catch (FileMissingException& e)
-         {
-               // If file doesn't exist, issue a warning
-            cerr << "rinex CLK file '" << clkFile << "' doesn't exist or you don't "
-                 << "have permission to read it. Skipping it." << endl;
-            continue;
-         }
-      }
 
-         // Close file
-      clkFileListStream.close();
-
-   }  // End of 'if(...)'
-
-      //***********************
-      // Let's read ocean loading BLQ data files
-      //***********************
-
-      // BLQ data store object
-   BLQDataReader blqStore;
-
-      // Read BLQ file name from the configure file
-   string blqFile = confReader.getValue( "oceanLoadingFile", "DEFAULT");
+      // Data stores: SP3, clock, BLQ, EOP, DCB and MSC files
+   PPPDataStores stores;
 
    try
    {
-      blqStore.open( blqFile );
-   }
-   catch (FileMissingException& e)
-   {
-         // If file doesn't exist, issue a warning
-      cerr << "BLQ file '" << blqFile << "' doesn't exist or you don't "
-           << "have permission to read it. Skipping it." << endl;
-      exit(-1);
-   }
-
-      //***********************
-      // Let's read eop files
-      //***********************
-
-      // Declare a "EOPDataStore" object to handle earth rotation parameter file
-   EOPDataStore eopStore;
-
-      // Now read eop files from 'eopFileList'
-   ifstream eopFileListStream;
-
-      // Open eopFileList File
-   eopFileListStream.open(eopFileListName.c_str(), ios::in);
-   if( !eopFileListStream )
-   {
-         // If file doesn't exist, issue a warning
-      cerr << "eop file List Name'" << eopFileListName << "' doesn't exist or you don't "
-           << "have permission to read it. Skipping it." << endl;
-
-      exit(-1);
-   }
+      stores.loadSP3FileList( sp3FileListName );
 
-   string eopFile;
-   while( eopFileListStream >> eopFile )
-   {
-      try
+         // If rinex clock file list is given, then use rinex clock
+      if(clkFileListOpt.getCount())
       {
-         eopStore.loadIGSFile( eopFile );
+         stores.loadClockFileList( clkFileListName );
       }
-      catch (FileMissingException& e)
-      {
-            // If file doesn't exist, issue a warning
-         cerr << "EOP file '" << eopFile << "' doesn't exist or you don't "
-              << "have permission to read it. Skipping it." << endl;
-         continue;
-      }
-   }
-      // Close file
-   eopFileListStream.close();
 
-      //***********************
-      // Let's read DCB files
-      //***********************
-
-      // Read and store dcb data
-   DCBDataReader dcbStore;
-
-   if(dcbFileListOpt.getCount() )
-   {
-         // Now read dcb file from 'dcbFileName'
-      ifstream dcbFileListStream;
+      stores.loadBLQFile( confReader.getValue( "oceanLoadingFile",
+                                               "DEFAULT" ) );
+      stores.loadEOPFileList( eopFileListName );
 
-         // Open dcbFileList File
-      dcbFileListStream.open(dcbFileListName.c_str(), ios::in);
-      if(!dcbFileListStream)
+      if(dcbFileListOpt.getCount())
       {
-            // If file doesn't exist, issue a warning
-         cerr << "dcb file List Name '" << dcbFileListName << "' doesn't exist or you don't "
-              << "have permission to read it." << endl;
-         exit(-1);
+         stores.loadDCBFileList( dcbFileListName );
       }
 
-      string dcbFile;
-
-         // Here is just a dcb file, we only read one month's dcb data.
-      while(dcbFileListStream >> dcbFile)
-      {
-         try
-         {
-            dcbStore.open(dcbFile);
-         }
-         catch(FileMissingException e)
-         {
-            cerr << "Warning! The DCB file '"<< dcbFile <<"' does not exist!" 
-                 << endl;
-            exit(-1);
-         }
-      };
-
-      dcbFileListStream.close();
-   }
-
-      //**********************************************
-      // Now, Let's read MSC data
-      //**********************************************
-      
-      // Declare a "MSCStore" object to handle msc file 
-   MSCStore mscStore;
-
-   try
-   {
-      mscStore.loadFile( mscFileName );
+      stores.loadMSCFile( mscFileName );
    }
-   catch (gpstk::FFStreamError& e)
+   catch(Exception& e)
    {
-         // If file doesn't exist, issue a warning
       cerr << e << endl;
-      cerr << "MSC file '" << mscFileName << "' Format is not supported!!!"
-           << "stop." << endl;
-      exit(-1);
-   }
-   catch (FileMissingException& e)
-   {
-         // If file doesn't exist, issue a warning
-      cerr << "MSC file '" << mscFileName << "' doesn't exist or you don't "
-           << "have permission to read it." << endl;
       exit(-1);
    }
 
@@ -901,7 +633,7 @@ void ppp::process()
 
          // Let's check the ocean loading data for current station before
          // the real data processing.
-      if( ! blqStore.isValid(station) )
+      if( ! stores.blqStore.isValid(station) )
       {
          cout << "There is no BLQ data for current station:" << station << endl;
          cout << "Current staion will be not processed !!!!" << endl;
@@ -912,13 +644,12 @@ void ppp::process()
       cout << "Starting processing for station: '" << station << "'." << endl;
 
          // MSC data for this station
-      initialTime.setTimeSystem(TimeSystem::Unknown);
-      MSCData mscData;
+      Position nominalPos;
       try
       {
-         mscData = mscStore.findMSC( station, initialTime );
+         nominalPos = stores.getNominalPosition( station, initialTime );
       }
-      catch (InvalidRequest& ie)
+      catch(InvalidRequest& ie)
       {
          	// If file doesn't exist, issue a warning
          cerr << "The station " << station 
@@ -931,300 +662,26 @@ void ppp::process()
          }
          continue;
       }
-      initialTime.setTimeSystem(TimeSystem::GPS);
 
-         // The former peculiar code is possible because each time we
-         // call a 'fetchListValue' method, it takes out the first element
-         // and deletes it from the given variable list.
-      Position nominalPos( mscData.coordinates );
+         // The processing works in GPS time
+      initialTime.setTimeSystem(TimeSystem::GPS);
 
       cout << nominalPos << endl;
 
+         // Processing of the observations, up to the prefit residuals
+      PPPProcessing pppModel( confReader,
+                              stores,
+                              station,
+                              nominalPos,
+                              initialTime,
+                              roh.recType,
+                              roh.antType,
+                              roh.antennaOffset );
+
          // Create a 'ProcessingList' object where we'll store
          // the processing objects in order
       ProcessingList pList;
-
-        	// Declare a CC2NONCC object
-      CC2NONCC cc2noncc(dcbStore);
-
-         // Read the receiver type file.
-      cc2noncc.loadRecTypeFile( confReader.getValue("recTypeFile"));
-      cc2noncc.setRecType(roh.recType);
-      cc2noncc.setCopyC1ToP1(true);
-
-         // Add to processing list
-      pList.push_back(cc2noncc);
-
-
-         // This object will check that all required observables are present
-      RequireObservables requireObs;
-      requireObs.addRequiredType(TypeID::P1);
-      requireObs.addRequiredType(TypeID::P2);
-      requireObs.addRequiredType(TypeID::L1);
-      requireObs.addRequiredType(TypeID::L2);
-         // Add 'requireObs' to processing list (it is the first)
-      pList.push_back(requireObs);
-
-         // This object will check that code observations are within
-         // reasonable limits
-      SimpleFilter pObsFilter;
-      pObsFilter.addFilteredType(TypeID::P1);
-      pObsFilter.setFilteredType(TypeID::P2);
-
-         // IMPORTANT NOTE:
-         // It turns out that some receivers don't correct their clocks
-         // from drift.
-         // When this happens, their code observations may drift well beyond
-         // what it is usually expected from a pseudorange. In turn, this
-         // effect causes that "SimpleFilter" objects start to reject a lot of
-         // satellites.
-         // Thence, the "filterCode" option allows you to deactivate the
-         // "SimpleFilter" object that filters out C1, P1 and P2, in case you
-         // need to.
-      bool filterCode( confReader.getValueAsBoolean( "filterCode" ) );
-
-         // Check if we are going to use this "SimpleFilter" object or not
-      if( filterCode )
-      {
-         pList.push_back(pObsFilter);       // Add to processing list
-      }
-
-
-         // This object defines several handy linear combinations
-      LinearCombinations comb;
-
-         // Object to compute linear combinations for cycle slip detection
-      ComputeLinear linear1;
-      linear1.addLinear(comb.pdeltaCombination);
-      linear1.addLinear(comb.mwubbenaCombination);
-      linear1.addLinear(comb.ldeltaCombination);
-      linear1.addLinear(comb.liCombination);
-      pList.push_back(linear1);       // Add to processing list
-
-         // Objects to mark cycle slips
-      LICSDetector markCSLI;         // Checks LI cycle slips
-      pList.push_back(markCSLI);     // Add to processing list
-      MWCSDetector2 markCSMW;        // Checks Merbourne-Wubbena cycle slips
-      pList.push_back(markCSMW);     // Add to processing list
-
-         // Object to keep track of satellite arcs
-         // Notes: delete unstable satellite may cause discontinuity
-         //        in the network processing!
-      SatArcMarker2 markArc;
-      markArc.setDeleteUnstableSats(false);
-      markArc.setUnstablePeriod(151.0);
-      pList.push_back(markArc);       // Add to processing list
-
-
-         // Object to decimate data
-      Decimate decimateData(
-              confReader.getValueAsDouble( "decimationInterval"),
-              confReader.getValueAsDouble( "decimationTolerance"),
-              initialTime);
-      pList.push_back(decimateData);       // Add to processing list
-
-
-         // Declare a basic modeler
-      BasicModel basic(nominalPos, SP3EphList);
-         // Set the minimum elevation
-      basic.setMinElev( confReader.getValueAsDouble("cutOffElevation"));
-         // If we are going to use P1 instead of C1, we must reconfigure 'basic'
-      basic.setDefaultObservable(TypeID::P1);
-         // Add to processing list
-      pList.push_back(basic);
-
-
-         // Object to compute weights based on elevation
-      ComputeElevWeights elevWeights;
-      pList.push_back(elevWeights);       // Add to processing list
-
-
-
-         // Object to remove eclipsed satellites
-      EclipsedSatFilter eclipsedSV;
-      pList.push_back(eclipsedSV);       // Add to processing list
-
-
-         // Object to compute gravitational delay effects
-      GravitationalDelay grDelay(nominalPos);
-      pList.push_back(grDelay);       // Add to processing list
-
-
-         // Vector from monument to antenna ARP [UEN], in meters
-      Triple offsetARP( roh.antennaOffset );
-
-         // Declare some antenna-related variables
-      Triple offsetL1( 0.0, 0.0, 0.0 ), offsetL2( 0.0, 0.0, 0.0 );
-      AntexReader antexReader;
-      Antenna receiverAntenna;
-
-         // Check if we want to use Antex information
-      bool useantex( confReader.getValueAsBoolean( "useAntex") );
-      string antennaModel;
-      if( useantex )
-      {
-            // Feed Antex reader object with Antex file
-         antexReader.open( confReader.getValue( "antexFile" ) );
-
-            // Antenna model 
-         antennaModel = roh.antType;
-
-            // Get receiver antenna parameters
-            // Warning: If no corrections are not found for one specific 
-            //          radome, then the antenna with radome NONE are used.
-         try
-         {
-            receiverAntenna = antexReader.getAntenna( antennaModel );
-         }
-         catch(ObjectNotFound& notFound)
-         {
-               // new antenna model
-            antennaModel.replace(16,4,"NONE");
-               // new receiver antenna with new antenna model
-            receiverAntenna = antexReader.getAntenna( antennaModel );
-         }
-      }
-
-
-         // Object to compute satellite antenna phase center effect
-      ComputeSatPCenter svPcenter(nominalPos);
-      if( useantex )
-      {
-            // Feed 'ComputeSatPCenter' object with 'AntexReader' object
-         svPcenter.setAntexReader( antexReader );
-      }
-      pList.push_back(svPcenter);       // Add to processing list
-
-
-         // Declare an object to correct observables to monument
-      CorrectObservables corr(SP3EphList);
-      corr.setNominalPosition(nominalPos);
-      corr.setMonument( offsetARP );
-
-         // Check if we want to use Antex patterns
-      bool usepatterns( confReader.getValueAsBoolean("usePCPatterns") );
-      if( useantex && usepatterns )
-      {
-         corr.setAntenna( receiverAntenna );
-
-            // Should we use elevation/azimuth patterns or just elevation?
-         corr.setUseAzimuth( confReader.getValueAsBoolean("useAzim") );
-      }
-      else
-      {
-            // Fill vector from antenna ARP to L1 phase center [UEN], in meters
-         offsetL1[0] = confReader.fetchListValueAsDouble("offsetL1");
-         offsetL1[1] = confReader.fetchListValueAsDouble("offsetL1");
-         offsetL1[2] = confReader.fetchListValueAsDouble("offsetL1");
-
-            // Vector from antenna ARP to L2 phase center [UEN], in meters
-         offsetL2[0] = confReader.fetchListValueAsDouble("offsetL2");
-         offsetL2[1] = confReader.fetchListValueAsDouble("offsetL2");
-         offsetL2[2] = confReader.fetchListValueAsDouble("offsetL2");
-
-         corr.setL1pc( offsetL1 );
-         corr.setL2pc( offsetL2 );
-
-      }
-
-      pList.push_back(corr);       // Add to processing list
-
-
-         // Object to compute wind-up effect
-      ComputeWindUp windup( SP3EphList,
-                            nominalPos );
-      if( useantex )
-      {
-            // Feed 'ComputeSatPCenter' object with 'AntexReader' object
-         windup.setAntexReader( antexReader );
-      }
-
-      pList.push_back(windup);       // Add to processing list
-
-
-         // Declare a NeillTropModel object, setting its parameters
-      NeillTropModel neillTM( nominalPos,
-                              initialTime );
-
-         // We will need this value later for printing
-      double drytropo( neillTM.dry_zenith_delay() );
-
-
-         // Object to compute the tropospheric data
-      ComputeTropModel computeTropo(neillTM);
-      pList.push_back(computeTropo);       // Add to processing list
-
-
-         // Object to compute code combination with minus ionospheric delays
-         // for L1/L2 calibration
-      ComputeLinear linear2;
-
-      linear2.addLinear(comb.q1Combination);
-      linear2.addLinear(comb.q2Combination);
-      pList.push_back(linear2);       // Add to processing list
-
-
-         // Object to align phase with code measurements
-      PhaseCodeAlignment phaseAlignL1;
-      phaseAlignL1.setCodeType(TypeID::Q1);
-      phaseAlignL1.setPhaseType(TypeID::L1);
-      phaseAlignL1.setPhaseWavelength( 0.190293672798);
-
-      pList.push_back(phaseAlignL1);       // Add to processing list
-
-         // Object to align phase with code measurements
-      PhaseCodeAlignment phaseAlignL2;
-      phaseAlignL2.setCodeType(TypeID::Q2);
-      phaseAlignL2.setPhaseType(TypeID::L2);
-      phaseAlignL2.setPhaseWavelength( 0.244210213425);
-      pList.push_back(phaseAlignL2);       // Add to processing list
-
-
-         // Object to compute ionosphere-free combinations to be used
-         // as observables in the PPP processing
-      ComputeLinear linear3;
-      linear3.addLinear(comb.pcCombination);
-      linear3.addLinear(comb.lcCombination);
-      pList.push_back(linear3);       // Add to processing list
-
-
-         // Declare a simple filter object to screen PC
-      SimpleFilter pcFilter;
-      pcFilter.setFilteredType(TypeID::PC);
-
-         // IMPORTANT NOTE:
-         // Like in the "filterCode" case, the "filterPC" option allows you to
-         // deactivate the "SimpleFilter" object that filters out PC, in case
-         // you need to.
-      bool filterPC( confReader.getValueAsBoolean( "filterPC" ) );
-
-         // Check if we are going to use this "SimpleFilter" object or not
-      if( filterPC )
-      {
-         pList.push_back(pcFilter);       // Add to processing list
-      }
-
-
-      ComputeLinear linear5;
-      linear5.addLinear(comb.mwubbenaCombination);
-      pList.push_back(linear5);       // Add to processing list
-
-
-         // Object to compute prefit-residuals
-      ComputeLinear linear4(comb.pcPrefit);
-      linear4.addLinear(comb.lcPrefit);
-      pList.push_back(linear4);       // Add to processing list
-
-
-         // Declare a base-changing object: From ECEF to North-East-Up (NEU)
-      XYZ2NEU baseChange(nominalPos);
-         // We always need both ECEF and NEU data for 'ComputeDOP', so add this
-      pList.push_back(baseChange);
-
-
-         // Object to compute DOP values
-      ComputeDOP cDOP;
-      pList.push_back(cDOP);       // Add to processing list
+      pList.push_back(pppModel);
 
       
          // Get if we want results in ECEF or NEU reference system
@@ -1280,16 +737,6 @@ void ppp::process()
       }  // End of 'if ( cycles > 0 )'
 
 
-         // Object to compute tidal effects
-      SolidTides solid;
-
-         // Configure ocean loading model
-      OceanLoading ocean(blqStore);
-
-         // Object to model pole tides
-      PoleTides pole(eopStore);
-
-
          // This is the GNSS data structure that will hold all the
          // GNSS-related information
       gnssRinex gRin;
@@ -1342,17 +789,6 @@ void ppp::process()
             // Store current epoch
          CommonTime time(gRin.header.epoch);
 
-            // Store the nominal position into 'SourceID'
-         gRin.header.source.nominalPos = nominalPos;
-
-            // Compute solid, oceanic and pole tides effects at this epoch
-         Triple tides( solid.getSolidTide( time, nominalPos )  +
-                       ocean.getOceanLoading( station, time )  +
-                       pole.getPoleTide( time, nominalPos )    );
-
-            // Update observable correction object with tides information
-         corr.setExtraBiases(tides);
-
          try
          {
                // Let's process data. Thanks to 'ProcessingList' this is
@@ -1402,10 +838,10 @@ void ppp::process()
             printSolution( outfile,
                            pppSolver,
                            time,
-                           cDOP,
+                           pppModel.getDOP(),
                            isNEU,
                            gRin.numSats(),
-                           drytropo,
+                           pppModel.getDryTropo(),
                            precision );
 
          }  // End of 'if ( cycles < 1 )'
@@ -1522,10 +958,10 @@ void ppp::process()
          printSolution( outfile,
                         fbpppSolver,
                         time,
-                        cDOP,
+                        pppModel.getDOP(),
                         isNEU,
                         gRin.numSats(),
-                        drytropo,
+                        pppModel.getDryTropo(),
                         precision );
 
       }  // End of 'while( fbpppSolver.LastProcess(gRin) )'
@@ -1574,9 +1010,7 @@ void ppp::process()
       // At last, Let's clear the content of SP3/EOP/MSC object
       //
       //***********************************************
-   SP3EphList.clear();
-   eopStore.clear();
-   mscStore.clear();
+   stores.clear();
 
 
    return;
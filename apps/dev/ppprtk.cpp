@@ -211,9 +211,16 @@ private:
    ConfDataReader confReader;
 
 
-      // Declare our own methods to handle output
+      // Corrections of the reference stations, either loaded at once
    gnssDataMap gdsMap;
 
+      // or read epoch by epoch from an indexed file
+   GnssDataFileReader corrReader;
+   bool indexedCorr;
+
+      // Corrections computed here, written as they are computed
+   GnssDataFileWriter corrWriter;
+
 
       // Method to print solution values
    void printSolution( ofstream& outfile,
@@ -267,7 +274,8 @@ ppprtk::ppprtk(char* arg0)
              'c',
              "conffile",
    " [-c|--conffile]    Name of configuration file ('ppprtk.conf' by default).",
-             false )
+             false ),
+   indexedCorr(false)
 {
 
       // This option may appear just once at CLI
@@ -496,8 +504,13 @@ void ppprtk::process()
 
    try
    {
-         // Try to load the correction data stored with gnssDataMap format
-      gdsMap = loadGnssDataMap( corrFileInput );
+         // Corrections in an indexed file are read as they are needed,
+         // other files are loaded at once
+      indexedCorr = GnssDataFileReader::isGnssDataFile( corrFileInput );
+      if( !indexedCorr )
+      {
+         gdsMap = loadGnssDataMap( corrFileInput );
+      }
 
    }
    catch(...)
@@ -514,6 +527,42 @@ void ppprtk::process()
    }  // End of 'try-catch' block
 
 
+   string corrFileOutput = confReader.getValue( "corrFileOut", "DEFAULT" );
+
+   try
+   {
+      corrWriter.open( corrFileOutput );
+
+         // The output holds the corrections of the input, followed by
+         // those of the rovers
+      if( indexedCorr )
+      {
+         GnssDataFileReader inputReader( corrFileInput );
+
+         CommonTime time;
+         sourceDataMap data;
+         while( inputReader.readEpoch( time, data ) )
+         {
+            corrWriter.writeEpoch( time, data );
+         }
+      }
+      else
+      {
+         corrWriter.write( gdsMap );
+      }
+   }
+   catch(...)
+   {
+
+      cerr << "Problem creating file "
+           << corrFileOutput
+           << endl;
+
+      exit (-1);
+
+   }  // End of 'try-catch' block
+
+
    cout << "Now, do the rtk station by station ... ..." << endl;
 
       // We will read each section name, which is equivalent to station name
@@ -992,7 +1041,16 @@ void ppprtk::process()
          // Object to compute the ionospheric delay and related parameters
       InterpCorrection interpCorr;
       interpCorr.setInitialRxPosition(nominalPos);
-      interpCorr.setReferenceData(gdsMap);
+      if( indexedCorr )
+      {
+            // Every station reads the file from the start
+         corrReader.open( corrFileInput );
+         interpCorr.setReferenceFile(corrReader);
+      }
+      else
+      {
+         interpCorr.setReferenceData(gdsMap);
+      }
       interpCorr.setInterpType(TypeID::corrPdelta);
       interpCorr.addInterpType(TypeID::corrLdelta);
       interpCorr.addInterpType(TypeID::corrPC);
@@ -1301,7 +1359,7 @@ void ppprtk::process()
          gRin.keepOnlyTypeID(types);
 
             // Store observation data
-         gdsMap.addGnssRinex(gRin);
+         corrWriter.writeEpoch(gRin);
 
          // The given epoch hass been processed. Let's get the next one
 
@@ -1340,16 +1398,16 @@ void ppprtk::process()
    // Method that will be executed AFTER the 'Process'
 void ppprtk::shutDown()
 {
-   string corrFileOutput= confReader.getValue( "corrFileOut", "DEFAULT" );
+      // Write the index of the corrections
+   corrWriter.close();
 
-      // Warning, the 'gdsMap' to a binary file 
-   saveGnssDataMap( gdsMap, corrFileOutput);
+   string corrFileOutput= confReader.getValue( "corrFileOut", "DEFAULT" );
 
       // Get the test file name 
    string testFile = confReader.getValue( "testFile", "DEFAULT" );
 
       // Now, write the 'correction' with format of gnssDataMap to text file?
-   dumpGnssDataMap(gdsMap, testFile);
+   dumpGnssDataMap(loadGnssDataMap(corrFileOutput), testFile);
 
 }
 
@@ -210,9 +210,13 @@ private:
    ConfDataReader confReader;
 
 
-      // Declare our own methods to handle output
+      // Corrections of the reference stations, either loaded at once
    gnssDataMap gdsMap;
 
+      // or read epoch by epoch from an indexed file
+   GnssDataFileReader corrReader;
+   bool indexedCorr;
+
 
       // Method to print solution values
    void printSolution( ofstream& outfile,
@@ -266,7 +270,8 @@ ppprtk::ppprtk(char* arg0)
              'c',
              "conffile",
    " [-c|--conffile]    Name of configuration file ('ppprtk.conf' by default).",
-             false )
+             false ),
+   indexedCorr(false)
 {
 
       // This option may appear just once at CLI
@@ -494,8 +499,13 @@ void ppprtk::process()
 
    try
    {
-         // Try to load the correction data stored with gnssDataMap format
-      gdsMap = loadGnssDataMap( corrFileInput );
+         // Corrections in an indexed file are read as they are needed,
+         // other files are loaded at once
+      indexedCorr = GnssDataFileReader::isGnssDataFile( corrFileInput );
+      if( !indexedCorr )
+      {
+         gdsMap = loadGnssDataMap( corrFileInput );
+      }
 
    }
    catch(...)
@@ -990,7 +1000,16 @@ void ppprtk::process()
          // Object to compute the ionospheric delay and related parameters
       InterpCorrection interpCorr;
       interpCorr.setInitialRxPosition(nominalPos);
-      interpCorr.setReferenceData(gdsMap);
+      if( indexedCorr )
+      {
+            // Every station reads the file from the start
+         corrReader.open( corrFileInput );
+         interpCorr.setReferenceFile(corrReader);
+      }
+      else
+      {
+         interpCorr.setReferenceData(gdsMap);
+      }
       if(usingC1)
       {
          interpCorr.setInterpType(TypeID::corrC1);
@@ -1441,6 +1460,13 @@ void ppprtk::process()
    // Method that will be executed AFTER the 'Process'
 void ppprtk::shutDown()
 {
+      // The corrections were only read; an indexed file was not loaded
+      // and there is nothing to save
+   if( indexedCorr )
+   {
+      return;
+   }
+
    string corrFileOutput= confReader.getValue( "corrFileOut", "DEFAULT" );
 
       // Warning, the 'gdsMap' to a binary file 
@@ -219,9 +219,13 @@ private:
    ConfDataReader confReader;
 
 
-      // Declare our own methods to handle output
+      // Corrections of the reference stations, either loaded at once
    gnssDataMap gdsMap;
 
+      // or read epoch by epoch from an indexed file
+   GnssDataFileReader corrReader;
+   bool indexedCorr;
+
 
       // Method to print solution values
    void printSolution( ofstream& outfile,
@@ -275,7 +279,8 @@ ppprtkx2::ppprtkx2(char* arg0)
              'c',
              "conffile",
    " [-c|--conffile]    Name of configuration file ('ppprtkx2.conf' by default).",
-             false )
+             false ),
+   indexedCorr(false)
 {
 
       // This option may appear just once at CLI
@@ -503,8 +508,13 @@ void ppprtkx2::process()
 
    try
    {
-         // Try to load the correction data stored with gnssDataMap format
-      gdsMap = loadGnssDataMap( corrFileInput );
+         // Corrections in an indexed file are read as they are needed,
+         // other files are loaded at once
+      indexedCorr = GnssDataFileReader::isGnssDataFile( corrFileInput );
+      if( !indexedCorr )
+      {
+         gdsMap = loadGnssDataMap( corrFileInput );
+      }
 
    }
    catch(...)
@@ -999,7 +1009,16 @@ void ppprtkx2::process()
          // Object to compute the ionospheric delay and related parameters
       InterpCorrection interpCorr;
       interpCorr.setInitialRxPosition(nominalPos);
-      interpCorr.setReferenceData(gdsMap);
+      if( indexedCorr )
+      {
+            // Every station reads the file from the start
+         corrReader.open( corrFileInput );
+         interpCorr.setReferenceFile(corrReader);
+      }
+      else
+      {
+         interpCorr.setReferenceData(gdsMap);
+      }
       if(usingC1)
       {
          interpCorr.setInterpType(TypeID::corrC1);
@@ -1442,6 +1461,13 @@ void ppprtkx2::process()
    // Method that will be executed AFTER the 'Process'
 void ppprtkx2::shutDown()
 {
+      // The corrections were only read; an indexed file was not loaded
+      // and there is nothing to save
+   if( indexedCorr )
+   {
+      return;
+   }
+
    string corrFileOutput= confReader.getValue( "corrFileOut", "DEFAULT" );
 
       // Warning, the 'gdsMap' to a binary file 
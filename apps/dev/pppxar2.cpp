@@ -214,8 +214,8 @@ private:
    ConfDataReader confReader;
 
 
-      // Declare our own methods to handle output
-   gnssDataMap gdsMap;
+      // Corrections of the network, written as they are computed
+   GnssDataFileWriter corrWriter;
 
 
       // Method to print solution values
@@ -487,6 +487,25 @@ void pppxar::spinUp()
 void pppxar::process()
 {
 
+      // Define the file name to store the corrections
+   string correctionFile=  confReader.getValue( "correctionFile", "DEFAULT" );
+
+   try
+   {
+      corrWriter.open( correctionFile );
+   }
+   catch(...)
+   {
+
+      cerr << "Problem creating file "
+           << correctionFile
+           << endl;
+
+      exit (-1);
+
+   }  // End of 'try-catch' block
+
+
       // We will read each section name, which is equivalent to station name
       // Station names will be read in alphabetical order
    string station;
@@ -1331,7 +1350,7 @@ void pppxar::process()
          gRin.keepOnlyTypeID(types);
          
             // Store observation data
-         gdsMap.addGnssRinex(gRin);
+         corrWriter.writeEpoch(gRin);
 
 
          // The given epoch hass been processed. Let's get the next one
@@ -1447,16 +1466,16 @@ void pppxar::process()
 void pppxar::shutDown()
 {
 
-      // Define the file name to store the 'gdsMap'
-   string correctionFile=  confReader.getValue( "correctionFile", "DEFAULT" );
+      // Write the index of the corrections
+   corrWriter.close();
 
-      // Warning, the 'gdsMap' to a binary file 
-   saveGnssDataMap( gdsMap, correctionFile);
+      // Define the file name to store the corrections
+   string correctionFile=  confReader.getValue( "correctionFile", "DEFAULT" );
 
    string testFile = confReader.getValue( "testFile", "DEFAULT" );
 
       // Now, write the 'correction' with format of gnssDataMap to text file?
-   dumpGnssDataMap(gdsMap, testFile);
+   dumpGnssDataMap(loadGnssDataMap(correctionFile), testFile);
 
 }
 
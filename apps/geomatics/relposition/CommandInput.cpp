@@ -121,6 +121,7 @@ try {
    convergence = 5.0e-8;                  // TD convergence criterion input
    noRAIM = false;                        // turn off pseudorange solution (! -> clk?)
    FixBiases = false;
+   nThreads = 0;                          // for Estimation(); 0 means all
    // Don't implement default constraints - this needs more study
    TightConstraint = 1.e-4; // 1.e-5;
    LooseConstraint = 1.e-1; // 1.e-1;
@@ -275,6 +276,11 @@ try {
       "Perform an extra, last iteration that fixes the phase biases (don't)");
    dashfixbias.setMaxCount(1);
 
+   CommandOption dashnthr(CommandOption::hasArgument, CommandOption::stdType,
+      0,"nThreads"," --nThreads <n>        Number of threads used in estimation, "
+      "if built with OpenMP [0 means all] (" + asString(nThreads) + ")");
+   dashnthr.setMaxCount(1);
+
    // state
    CommandOption dashntrop(CommandOption::hasArgument, CommandOption::stdType,
       0,"RZDnIntervals","\n# Model, state elements, a priori constraints:\n"
@@ -835,6 +841,12 @@ try {
       FixBiases = true;
       if(help) cout << " Input: Turn ON fixing of biases in last iteration" << endl;
    }
+   if(dashnthr.getCount()) {
+      values = dashnthr.getValue();
+      nThreads = asInt(values[0]);
+      if(help) cout << " Input: number of threads in Estimation : "
+         << nThreads << endl;
+   }
    if(dashntrop.getCount()) {
       values = dashntrop.getValue();
       NRZDintervals = asInt(values[0]);
@@ -1423,6 +1435,7 @@ try {
       << scientific << setprecision(3) << convergence << endl;
    ofs << " On last iteration," << (FixBiases ? "" : " do not")
       << " fix biases" << endl;
+   if(nThreads > 0) ofs << " Use " << nThreads << " threads in estimation" << endl;
    if(NRZDintervals > 0) {
       ofs << " Estimate " << NRZDintervals
          << " residual zenith delay intervals" << endl;
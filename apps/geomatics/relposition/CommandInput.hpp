@@ -112,6 +112,7 @@ public:
    int nIter;
    double convergence;
    bool FixBiases;
+   int nThreads;                          // threads in Estimation; 0 means all
    double TightConstraint,LooseConstraint;// in ppm (of baseline)
    double DefaultTemp,DefaultPress,DefaultRHumid;
       // output
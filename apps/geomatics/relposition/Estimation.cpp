@@ -52,6 +52,10 @@
 // system includes
 #include "TimeString.hpp"
 
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
 // GPSTk
 #include "Vector.hpp"
 #include "Matrix.hpp"
@@ -94,6 +98,8 @@ void EvaluateLSEquation(int n, Vector<double>& X,Vector<double>& f,Matrix<double
    throw(Exception);
 int MeasurementUpdate(Matrix<double>& P, Vector<double>& f, Matrix<double>& MC)
    throw(Exception);
+int FlushMeasurementUpdates(void) throw(Exception);
+int MergeMeasurementUpdates(void) throw(Exception);
 int Solve(void) throw(Exception);
 int UpdateNominalState(void) throw(Exception);
 void OutputIterationResults(bool final) throw(Exception);
@@ -122,6 +128,55 @@ static int NState;                 // true length of the state vector
 static Vector<double> BiasState;   // save the solution for biases, before bias fixing
 static Matrix<double> BiasCov;     // save covariance for biases, before bias fixing
 static Vector<double> NominalState;// save the nominal state to output with solution
+static int NThreads;               // number of threads used in the data loop
+static vector<SRIFilter> ThreadSRI;// SRIs of parallel updates, merged into srif
+static vector<Matrix<double> > BatchP,BatchMC;  // batch of epochs for ThreadSRI
+static vector<Vector<double> > BatchRHS;
+static int NBatch;                 // number of epochs in the batch
+
+//------------------------------------------------------------------------------------
+// One-way terms of the linearized DD equation, for one site and satellite at the
+// current epoch. Each DD combines four of these; they are computed only once,
+// although each of them appears in many DDs.
+class OneWayTerm {
+public:
+   GSatID sat;
+   double ER;                       // corrected ephemeris range
+   double trop;                     // trop correction
+   double mapf;                     // wet mapping function, if there are RZDs
+   double cosines[3];               // direction cosines
+};
+
+// The one-way terms of one site, and the indexes of its states
+class SiteTerms {
+public:
+   string site;
+   Station *pst;
+   int i,j,k;                       // position states, if not fixed
+   int n;                           // RZD state of the current interval, if any
+   vector<OneWayTerm> ow;
+      // index of sat in ow, adding it if not there already
+   int index(const GSatID& sat) {
+      for(size_t l=0; l<ow.size(); l++) if(ow[l].sat == sat) return l;
+      OneWayTerm t;
+      t.sat = sat;
+      ow.push_back(t);
+      return ow.size()-1;
+   }
+};
+
+// One DD: its sites and satellites, and where to find its one-way terms
+class DDTerms {
+public:
+   string site1,site2;
+   GSatID sat1,sat2;
+   int s1,s2;                       // indexes of the sites in the SiteTerms
+   int k11,k12,k21,k22;             // indexes of the one-way terms in each site
+};
+
+void EvaluateOneWayTerms(SiteTerms& st, int ntrop) throw(Exception);
+void EvaluateDDRow(int m, const DDTerms& dd, const vector<SiteTerms>& sites,
+                   Vector<double>& f, Matrix<double>& P) throw(Exception);
 
 //------------------------------------------------------------------------------------
 // currently the estimation problem is designed like this:
@@ -238,6 +293,8 @@ try {
       }  // end while loop over data epochs
       if(iret) break;
 
+      if((iret = MergeMeasurementUpdates())) break;
+
       if((iret = Solve())) break;
 
       if((iret = UpdateNominalState())) break;
@@ -311,6 +368,14 @@ try {
       // initial value
    Biasfix = false;
 
+      // number of threads for the data loop
+   NThreads = 1;
+#ifdef _OPENMP
+   NThreads = (CI.nThreads > 0 ? CI.nThreads : omp_get_max_threads());
+#endif
+   if(CI.Verbose) oflog << "Estimation will use " << NThreads << " thread"
+      << (NThreads > 1 ? "s" : "") << endl;
+
    return 0;
 }
 catch(Exception& e) { GPSTK_RETHROW(e); }
@@ -552,6 +617,11 @@ try {
    dX.resize(N);
    srif = SRIFilter(NL);
 
+      // SRIs with no information, for the parallel measurement updates
+   ThreadSRI.clear();
+   if(NThreads > 1) ThreadSRI = vector<SRIFilter>(NThreads,SRIFilter(NL));
+   NBatch = 0;
+
       // save the nominal state for output with Solution (OutputIterationResults)
    NominalState = State;
 
@@ -792,6 +862,9 @@ catch(...) { Exception e("Unknown exception"); GPSTK_THROW(e); }
 // Given a nominal state vector X, compute the function f(X) and the partials matrix
 // P at X.
 // NB X is not used here ... except that State is used for biases
+// The one-way terms are computed first, in parallel over sites; each site is done
+// by a single thread, as its trop model keeps state. Then the rows of f and P are
+// filled in parallel over the DDs.
 void EvaluateLSEquation(int count,              // count of current epoch
                         Vector<double>& X,      // nominal state (input)
                         Vector<double>& f,      // function f(X) at count (output)
@@ -799,13 +872,13 @@ void EvaluateLSEquation(int count,              // count of current epoch
    throw(Exception)
 {
 try {
-   int i,j,k,n,ntrop;
+   int ntrop,ifailed;
    size_t m;
-   double ER,trop,mapf;
-   string site1,site2;
-   GSatID sat1,sat2;
-   CorrectedEphemerisRange CER;
-   Position SatR;
+   map<string,int> siteIndex;
+   map<string,int>::const_iterator jt;
+   vector<SiteTerms> sites;
+   vector<DDTerms> dds(DataNL.size());
+   Exception failure;
 
    // Station.pos has been defined outside this routine in UpdateNominalState()
 
@@ -815,145 +888,188 @@ try {
                     (((LastEpoch-FirstEpoch)+CI.DataInterval)/CI.NRZDintervals) );
    }
 
-      // loop over the data vector, computing f(X) and filling P
-   f = Vector<double>(M,0.0);
-   P = Matrix<double>(M,N,0.0);
+      // break each name into its parts, and find the one-way terms it needs
    for(m=0; m<DataNL.size(); m++) {
-
-         // break name into its parts
-      DecomposeName(DataNL.getName(m), site1, site2, sat1, sat2);
-
-      Station& st1=Stations[site1];
-      Station& st2=Stations[site2];
-
-         // -----------------------------------------------------------
-         // site1 ----------------------------------------------------
-      if(!st1.fixed) {
-         i = StateNL.index(site1 + string("-X"));
-         j = StateNL.index(site1 + string("-Y"));
-         k = StateNL.index(site1 + string("-Z"));
-         if(i == -1 || j == -1 || k == -1) {
-            Exception e("Position states confused: unable to find for " + site1);
-            GPSTK_THROW(e);
+      DDTerms& dd(dds[m]);
+      DecomposeName(DataNL.getName(m), dd.site1, dd.site2, dd.sat1, dd.sat2);
+
+      for(int l=0; l<2; l++) {
+         const string& site(l == 0 ? dd.site1 : dd.site2);
+         int& s(l == 0 ? dd.s1 : dd.s2);
+         jt = siteIndex.find(site);
+         if(jt == siteIndex.end()) {
+            SiteTerms st;
+            st.site = site;
+            st.pst = &Stations[site];
+            st.i = st.j = st.k = st.n = -1;
+            s = siteIndex[site] = sites.size();
+            sites.push_back(st);
          }
+         else s = jt->second;
       }
-         // sat 1 -----------------------------------------------------
-         // should you use CER.rawrange here?
-      ER = CER.ComputeAtReceiveTime(SolutionEpoch,st1.pos,sat1,*pEph);
-      SatR.setECEF(CER.svPosVel.x[0],CER.svPosVel.x[1],CER.svPosVel.x[2]);
-      trop = st1.pTropModel->correction(st1.pos,SatR,SolutionEpoch);
-      f(m) += ER+trop;
-      if(!st1.fixed) {
-         P(m,i) += CER.cosines[0];
-         P(m,j) += CER.cosines[1];
-         P(m,k) += CER.cosines[2];
+
+      dd.k11 = sites[dd.s1].index(dd.sat1);
+      dd.k12 = sites[dd.s1].index(dd.sat2);
+      dd.k21 = sites[dd.s2].index(dd.sat1);
+      dd.k22 = sites[dd.s2].index(dd.sat2);
+   }
+
+      // compute the one-way terms, in parallel
+   ifailed = -1;
+#ifdef _OPENMP
+#pragma omp parallel for schedule(dynamic,1) num_threads(NThreads)
+#endif
+   for(int is=0; is<int(sites.size()); is++) {
+      try {
+         EvaluateOneWayTerms(sites[is],ntrop);
       }
-         // trop rzd .. depends on site, sat and trop model
-      if(CI.NRZDintervals > 0) {
-         n = StateNL.index(site1 + string("-RZD") + asString(ntrop));
-         if(n == -1) {
-            Exception e("RZD states confused: unable to find state " + 
-               site1 + string("-RZD") + asString(ntrop));
-            GPSTK_THROW(e);
+      catch(Exception& e) {
+#ifdef _OPENMP
+#pragma omp critical (Estimation_failure)
+#endif
+         {
+            if(ifailed == -1 || is < ifailed) { ifailed = is; failure = e; }
          }
-         mapf = st1.pTropModel->wet_mapping_function(CER.elevation);
-         P(m,n) += mapf;
-         f(m) += mapf * State(n);
       }
+   }
+   if(ifailed != -1) GPSTK_THROW(failure);
 
-         // sat 2 -----------------------------------------------------
-      ER = CER.ComputeAtReceiveTime(SolutionEpoch,st1.pos,sat2,*pEph);
-      SatR.setECEF(CER.svPosVel.x[0],CER.svPosVel.x[1],CER.svPosVel.x[2]);
-      trop = st1.pTropModel->correction(st1.pos,SatR,SolutionEpoch);
-      f(m) -= ER+trop;
-      if(!st1.fixed) {
-         P(m,i) -= CER.cosines[0];
-         P(m,j) -= CER.cosines[1];
-         P(m,k) -= CER.cosines[2];
-      }
-         // trop rzd .. depends on site, sat and trop model
-      if(CI.NRZDintervals > 0) {
-         mapf = st1.pTropModel->wet_mapping_function(CER.elevation);
-         P(m,n) += mapf;
-         f(m) += mapf * State(n);
+      // loop over the data vector, computing f(X) and filling P
+   f = Vector<double>(M,0.0);
+   P = Matrix<double>(M,N,0.0);
+   ifailed = -1;
+#ifdef _OPENMP
+#pragma omp parallel for schedule(static) num_threads(NThreads)
+#endif
+   for(int im=0; im<int(dds.size()); im++) {
+      try {
+         EvaluateDDRow(im,dds[im],sites,f,P);
       }
-
-         // -----------------------------------------------------------
-         // site 2 ----------------------------------------------------
-      if(!st2.fixed) {
-         i = StateNL.index(site2 + string("-X"));
-         j = StateNL.index(site2 + string("-Y"));
-         k = StateNL.index(site2 + string("-Z"));
-         if(i == -1 || j == -1 || k == -1) {
-            Exception e("Position states confused: unable to find for " + site2);
-            GPSTK_THROW(e);
+      catch(Exception& e) {
+#ifdef _OPENMP
+#pragma omp critical (Estimation_failure)
+#endif
+         {
+            if(ifailed == -1 || im < ifailed) { ifailed = im; failure = e; }
          }
       }
-         // sat 1 -----------------------------------------------------
-      ER = CER.ComputeAtReceiveTime(SolutionEpoch,st2.pos,sat1,*pEph);
-      SatR.setECEF(CER.svPosVel.x[0],CER.svPosVel.x[1],CER.svPosVel.x[2]);
-      trop = st2.pTropModel->correction(st2.pos,SatR,SolutionEpoch);
-      f(m) -= ER+trop;
-      if(!st2.fixed) {
-         P(m,i) -= CER.cosines[0];
-         P(m,j) -= CER.cosines[1];
-         P(m,k) -= CER.cosines[2];
+   }
+   if(ifailed != -1) GPSTK_THROW(failure);
+
+   f.resize(M);
+   P.resize(M,N);
+
+}
+catch(Exception& e) { GPSTK_RETHROW(e); }
+catch(exception& e) { Exception E("std except: "+string(e.what())); GPSTK_THROW(E); }
+catch(...) { Exception e("Unknown exception"); GPSTK_THROW(e); }
+}
+
+//------------------------------------------------------------------------------------
+// called by EvaluateLSEquation(), possibly in parallel with other sites
+// Find the states of one site, and compute its one-way terms at SolutionEpoch.
+void EvaluateOneWayTerms(SiteTerms& st,         // site and satellites (input/output)
+                         int ntrop)             // trop estimation interval (input)
+   throw(Exception)
+{
+try {
+   size_t l;
+   CorrectedEphemerisRange CER;
+   Position SatR;
+   Station& stn(*st.pst);
+
+   if(!stn.fixed) {
+      st.i = StateNL.index(st.site + string("-X"));
+      st.j = StateNL.index(st.site + string("-Y"));
+      st.k = StateNL.index(st.site + string("-Z"));
+      if(st.i == -1 || st.j == -1 || st.k == -1) {
+         Exception e("Position states confused: unable to find for " + st.site);
+         GPSTK_THROW(e);
       }
-         // trop rzd .. depends on site, sat and trop model
-      if(CI.NRZDintervals > 0) {
-         n = StateNL.index(site2 + string("-RZD") + asString(ntrop));
-         if(n == -1) {
-            Exception e("RZD states confused: unable to find state " + 
-               site2 + string("-RZD") + asString(ntrop));
-            GPSTK_THROW(e);
-         }
-         mapf = st2.pTropModel->wet_mapping_function(CER.elevation);
-         P(m,n) += mapf;
-         f(m) += mapf * State(n);
+   }
+      // trop rzd .. depends on site, sat and trop model
+   if(CI.NRZDintervals > 0) {
+      st.n = StateNL.index(st.site + string("-RZD") + asString(ntrop));
+      if(st.n == -1) {
+         Exception e("RZD states confused: unable to find state " +
+            st.site + string("-RZD") + asString(ntrop));
+         GPSTK_THROW(e);
       }
+   }
 
-         // sat 2 -----------------------------------------------------
-      ER = CER.ComputeAtReceiveTime(SolutionEpoch,st2.pos,sat2,*pEph);
+   for(l=0; l<st.ow.size(); l++) {
+      OneWayTerm& t(st.ow[l]);
+         // should you use CER.rawrange here?
+      t.ER = CER.ComputeAtReceiveTime(SolutionEpoch,stn.pos,t.sat,*pEph);
       SatR.setECEF(CER.svPosVel.x[0],CER.svPosVel.x[1],CER.svPosVel.x[2]);
-      trop = st2.pTropModel->correction(st2.pos,SatR,SolutionEpoch);
-      f(m) += ER+trop;
-      if(!st2.fixed) {
-         P(m,i) += CER.cosines[0];
-         P(m,j) += CER.cosines[1];
-         P(m,k) += CER.cosines[2];
+      t.trop = stn.pTropModel->correction(stn.pos,SatR,SolutionEpoch);
+      t.cosines[0] = CER.cosines[0];
+      t.cosines[1] = CER.cosines[1];
+      t.cosines[2] = CER.cosines[2];
+      if(CI.NRZDintervals > 0)
+         t.mapf = stn.pTropModel->wet_mapping_function(CER.elevation);
+   }
+
+}
+catch(Exception& e) { GPSTK_RETHROW(e); }
+catch(exception& e) { Exception E("std except: "+string(e.what())); GPSTK_THROW(E); }
+catch(...) { Exception e("Unknown exception"); GPSTK_THROW(e); }
+}
+
+//------------------------------------------------------------------------------------
+// called by EvaluateLSEquation(), possibly in parallel with other DDs
+// Compute f(m) and fill row m of P, from the one-way terms of DD m.
+void EvaluateDDRow(int m,                       // index of the DD (input)
+                   const DDTerms& dd,           // the DD (input)
+                   const vector<SiteTerms>& sites, // one-way terms (input)
+                   Vector<double>& f,           // function f(X) (output, row m)
+                   Matrix<double>& P)           // partials at X (output, row m)
+   throw(Exception)
+{
+try {
+   int i,j,l;
+      // site1-sat1, site1-sat2, site2-sat1 and site2-sat2, in that order
+   const SiteTerms *pst[4] = { &sites[dd.s1], &sites[dd.s1],
+                               &sites[dd.s2], &sites[dd.s2] };
+   const OneWayTerm *pow[4] = { &sites[dd.s1].ow[dd.k11], &sites[dd.s1].ow[dd.k12],
+                                &sites[dd.s2].ow[dd.k21], &sites[dd.s2].ow[dd.k22] };
+   const double sign[4] = { 1.0, -1.0, -1.0, 1.0 };
+
+   for(l=0; l<4; l++) {
+      const SiteTerms& st(*pst[l]);
+      const OneWayTerm& t(*pow[l]);
+      f(m) += sign[l] * (t.ER+t.trop);
+      if(!st.pst->fixed) {
+         P(m,st.i) += sign[l] * t.cosines[0];
+         P(m,st.j) += sign[l] * t.cosines[1];
+         P(m,st.k) += sign[l] * t.cosines[2];
       }
          // trop rzd .. depends on site, sat and trop model
       if(CI.NRZDintervals > 0) {
-         mapf = st2.pTropModel->wet_mapping_function(CER.elevation);
-         P(m,n) += mapf;
-         f(m) += mapf * State(n);
+         P(m,st.n) += t.mapf;
+         f(m) += t.mapf * State(st.n);
       }
+   }
 
-         // -----------------------------------------------------------
-         // bias ------------------------------------------------------
-      j = 1;
-      i = StateNL.index(DataNL.getName(m));
+      // -----------------------------------------------------------
+      // bias ------------------------------------------------------
+   j = 1;
+   i = StateNL.index(DataNL.getName(m));
+   if(i == -1) {
+      // but what if the bias is A-B_s-r and the data B-A_r-s?
+      j = -1;
+      i = StateNL.index(ComposeName(dd.site1,dd.site2,dd.sat2,dd.sat1)); // most likely
       if(i == -1) {
-         // but what if the bias is A-B_s-r and the data B-A_r-s?
-         // (Decompose was called at top of loop)
-         j = -1;
-         i = StateNL.index(ComposeName(site1,site2,sat2,sat1));      // most likely
+         i = StateNL.index(ComposeName(dd.site2,dd.site1,dd.sat1,dd.sat2));
          if(i == -1) {
-            i = StateNL.index(ComposeName(site2,site1,sat1,sat2));
-            if(i == -1) {
-               j = 1;
-               i = StateNL.index(ComposeName(site2,site1,sat2,sat1));
-            }
+            j = 1;
+            i = StateNL.index(ComposeName(dd.site2,dd.site1,dd.sat2,dd.sat1));
          }
       }
-      f(m) += j * State(i);
-      if(!Biasfix)
-         P(m,i) = j;
-
-   }  // end loop over data
-
-   f.resize(M);
-   P.resize(M,N);
+   }
+   f(m) += j * State(i);
+   if(!Biasfix)
+      P(m,i) = j;
 
 }
 catch(Exception& e) { GPSTK_RETHROW(e); }
@@ -963,12 +1079,88 @@ catch(...) { Exception e("Unknown exception"); GPSTK_THROW(e); }
 
 //------------------------------------------------------------------------------------
 // called by Estimation() - inside the data loop, inside the iteration loop
+// With more than one thread, the epochs are collected in batches of NThreads, and
+// the updates of a batch are done in parallel, epoch k of each batch going into
+// ThreadSRI[k]. The data of different epochs are uncorrelated, so this is the same
+// least squares problem; MergeMeasurementUpdates() adds ThreadSRI to srif.
 int MeasurementUpdate(Matrix<double>& P, Vector<double>& f, Matrix<double>& MC)
    throw(Exception)
 {
 try {
 
-   srif.measurementUpdate(P,f,MC);
+   if(NThreads <= 1) {
+      srif.measurementUpdate(P,f,MC);
+      return 0;
+   }
+
+   if(int(BatchP.size()) < NThreads) {
+      BatchP.resize(NThreads);
+      BatchRHS.resize(NThreads);
+      BatchMC.resize(NThreads);
+   }
+   BatchP[NBatch] = P;
+   BatchRHS[NBatch] = f;
+   BatchMC[NBatch] = MC;
+   NBatch++;
+
+   if(NBatch == NThreads) return FlushMeasurementUpdates();
+
+   return 0;
+}
+catch(Exception& e) { GPSTK_RETHROW(e); }
+catch(exception& e) { Exception E("std except: "+string(e.what())); GPSTK_THROW(E); }
+catch(...) { Exception e("Unknown exception"); GPSTK_THROW(e); }
+}
+
+//------------------------------------------------------------------------------------
+// called by MeasurementUpdate() and MergeMeasurementUpdates()
+// Update ThreadSRI with the epochs of the batch, in parallel, and empty the batch.
+int FlushMeasurementUpdates(void) throw(Exception)
+{
+try {
+   int kfailed(-1);
+   Exception failure;
+
+#ifdef _OPENMP
+#pragma omp parallel for schedule(static,1) num_threads(NThreads)
+#endif
+   for(int k=0; k<NBatch; k++) {
+      try {
+         ThreadSRI[k].measurementUpdate(BatchP[k],BatchRHS[k],BatchMC[k]);
+      }
+      catch(Exception& e) {
+#ifdef _OPENMP
+#pragma omp critical (Estimation_failure)
+#endif
+         {
+            if(kfailed == -1 || k < kfailed) { kfailed = k; failure = e; }
+         }
+      }
+   }
+   NBatch = 0;
+   if(kfailed != -1) GPSTK_THROW(failure);
+
+   return 0;
+}
+catch(Exception& e) { GPSTK_RETHROW(e); }
+catch(exception& e) { Exception E("std except: "+string(e.what())); GPSTK_THROW(E); }
+catch(...) { Exception e("Unknown exception"); GPSTK_THROW(e); }
+}
+
+//------------------------------------------------------------------------------------
+// called by Estimation() - after the data loop, inside the iteration loop
+// Do the last, partial batch of updates, and merge ThreadSRI into srif.
+int MergeMeasurementUpdates(void) throw(Exception)
+{
+try {
+   int iret;
+
+   if(NThreads <= 1) return 0;
+
+   if((iret = FlushMeasurementUpdates())) return iret;
+
+   for(size_t k=0; k<ThreadSRI.size(); k++)
+      srif.merge(ThreadSRI[k]);
 
    return 0;
 }
@@ -44,6 +44,7 @@
 
 #include "FDStreamBuff.hpp"
 #include "TCPStreamBuff.hpp"
+#include "StringUtils.hpp"
 
 namespace gpstk
 {
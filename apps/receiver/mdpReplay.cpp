@@ -0,0 +1,205 @@
+#pragma ident "$Id$"
+
+//============================================================================
+//
+//  This file is part of GPSTk, the GPS Toolkit.
+//
+//  The GPSTk is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU Lesser General Public License as published
+//  by the Free Software Foundation; either version 2.1 of the License, or
+//  any later version.
+//
+//  The GPSTk is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU Lesser General Public License for more details.
+//
+//  You should have received a copy of the GNU Lesser General Public
+//  License along with GPSTk; if not, write to the Free Software Foundation,
+//  Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110, USA
+//
+//============================================================================
+
+// Replays a recorded RINEX observation file as a live MDP stream on a tcp
+// port, so that real-time programs such as rtPPP can be tested without a
+// receiver. The epochs are sent at the pace given by their time tags,
+// optionally sped up, to the first client that connects.
+
+#include <string>
+#include <iostream>
+
+#include "Exception.hpp"
+#include "CommandOption.hpp"
+#include "CommandOptionParser.hpp"
+#include "StringUtils.hpp"
+#include "RinexObsStream.hpp"
+#include "RinexObsHeader.hpp"
+#include "RinexObsData.hpp"
+#include "MDPStream.hpp"
+#include "MDPObsEpoch.hpp"
+#include "RinexConverters.hpp"
+#include "TCPStreamBuff.hpp"
+
+#include <csignal>
+#include <unistd.h>
+#include <sys/time.h>
+
+using namespace std;
+using namespace gpstk;
+
+
+// Wall clock time in seconds
+double wallTime()
+{
+   struct timeval tv;
+   gettimeofday(&tv, NULL);
+   return tv.tv_sec + 1e-6*tv.tv_usec;
+}
+
+
+int main(int argc, char *argv[])
+{
+   try
+   {
+      CommandOptionNoArg helpOption('h', "help", "Print help usage");
+      CommandOptionNoArg verboseOption('v', "verbose", "Increased diagnostic messages");
+      CommandOptionWithAnyArg inputOption('i', "input", "The RINEX observation file to replay.", true);
+      CommandOptionWithNumberArg portOption('p', "port", "The tcp port to listen on (the default is 5000).");
+      CommandOptionWithAnyArg speedOption('x', "speed", "Factor the replay is sped up by (the default is 1, real time).");
+      CommandOptionWithNumberArg epochsOption('n', "epochs", "Stop after this many epochs.");
+
+      inputOption.setMaxCount(1);
+      portOption.setMaxCount(1);
+      speedOption.setMaxCount(1);
+      epochsOption.setMaxCount(1);
+
+      CommandOptionParser cop("Replays a RINEX observation file as an MDP stream on a tcp port.");
+      cop.parseOptions(argc, argv);
+
+      if (helpOption.getCount() || cop.hasErrors())
+      {
+         if (cop.hasErrors())
+            cop.dumpErrors(cout);
+         cop.displayUsage(cout);
+         exit(0);
+      }
+
+      bool verbose = (verboseOption.getCount()>0);
+
+      int port = 5000;
+      if (portOption.getCount())
+         port = StringUtils::asInt(portOption.getValue()[0]);
+
+      double speed = 1;
+      if (speedOption.getCount())
+         speed = StringUtils::asDouble(speedOption.getValue()[0]);
+      if (speed <= 0)
+      {
+         cerr << "The speed must be positive." << endl;
+         exit(-1);
+      }
+
+      long maxEpochs = -1;
+      if (epochsOption.getCount())
+         maxEpochs = StringUtils::asInt(epochsOption.getValue()[0]);
+
+      string fn = inputOption.getValue()[0];
+      RinexObsStream rin(fn.c_str());
+      if (!rin)
+      {
+         cerr << "Could not open " << fn << endl;
+         exit(-1);
+      }
+      RinexObsHeader roh;
+      rin >> roh;
+
+      // Wait for the client ***************************************************
+      int listener = ::socket(AF_INET, SOCK_STREAM, 0);
+      int on = 1;
+      ::setsockopt(listener, SOL_SOCKET, SO_REUSEADDR, &on, sizeof(on));
+      SocketAddr local(IPaddress(), port);
+      if (listener < 0 || ::bind(listener, local, sizeof(sockaddr_in)) < 0
+          || ::listen(listener, 1) < 0)
+      {
+         cerr << "Could not listen on port " << port << endl;
+         exit(-1);
+      }
+
+      if (verbose)
+         cout << "Waiting for a client on port " << port << endl;
+
+      TCPStreamBuff tcpbuff;
+      SocketAddr peer(IPaddress(), 0);
+      tcpbuff.accept(listener, peer);
+      ::close(listener);
+      if (!tcpbuff.is_open())
+      {
+         cerr << "Could not accept a client" << endl;
+         exit(-1);
+      }
+
+      if (verbose)
+         cout << "Sending " << fn << " to " << peer << endl;
+
+      // A client that goes away must not kill us
+      signal(SIGPIPE, SIG_IGN);
+
+      MDPStream output;
+      output.basic_ios<char>::rdbuf(&tcpbuff);
+
+      // Send the epochs *******************************************************
+      RinexObsData rod;
+      CommonTime firstEpoch;
+      double start = 0;
+      long count = 0;
+      unsigned short fc = 0;
+      while (rin >> rod && (maxEpochs < 0 || count < maxEpochs))
+      {
+         if (rod.epochFlag != 0 && rod.epochFlag != 1)
+            continue;
+
+         MDPEpoch me = makeMDPEpoch(rod);
+         if (me.empty())
+            continue;
+
+         if (count == 0)
+         {
+            firstEpoch = rod.time;
+            start = wallTime();
+         }
+
+         // Hold the epoch until it is due
+         double due = start + (rod.time - firstEpoch)/speed;
+         double wait = due - wallTime();
+         if (wait > 0)
+            usleep(static_cast<useconds_t>(wait*1e6));
+
+         for (MDPEpoch::iterator i=me.begin(); i!=me.end(); i++)
+            i->second.freshnessCount = fc++;
+
+         output << me;
+         output.flush();
+         if (!output)
+         {
+            if (verbose)
+               cout << "Client went away" << endl;
+            break;
+         }
+         count++;
+
+         if (verbose)
+            cout << rod.time << " " << me.size() << " SVs" << endl;
+      }
+
+      if (verbose)
+         cout << "Sent " << count << " epochs" << endl;
+   }
+   catch (gpstk::Exception &exc)
+   { cerr << exc << endl; }
+   catch (std::exception &exc)
+   { cerr << "Caught std::exception " << exc.what() << endl; }
+   catch (...)
+   { cerr << "Caught unknown exception" << endl; }
+
+   return 0;
+}
@@ -0,0 +1,859 @@
+#pragma ident "$Id$"
+
+//============================================================================
+//
+// Real-time PPP Positioning
+//
+// This program computes "Precise Point Positioning" (PPP) epoch by epoch
+// from a live stream of MDP observations, with the same processing as the
+// 'ppp' program in apps/dev. The stream may come from a receiver through a
+// tcp port or a serial port, or from a file; 'mdpReplay' serves a recorded
+// RINEX observation file as such a stream.
+//
+// Every epoch must be solved within a latency budget. The latency of an
+// epoch is counted from the moment it should have arrived, judging from its
+// time tag and from the epochs received so far, so that the time it waits
+// behind a slow epoch counts too. An epoch that, given its age and the
+// typical time taken to solve one, can not be solved within the budget any
+// more is dropped without processing, rather than delaying the ones that
+// follow. The percentiles of the latency and the number of epochs dropped
+// are reported at the end.
+//
+// Copyright
+//
+// Dagoberto Salazar - gAGE ( http://www.gage.es ). 2008, 2009
+//
+// Shoujian Zhang, Wuhan University, 2015
+//
+//============================================================================
+
+
+
+	// Basic input/output C++ classes
+#include <iostream>
+#include <iomanip>
+#include <fstream>
+#include <vector>
+#include <algorithm>
+#include <cmath>
+
+
+   // Basic framework for programs in the GPSTk. 'process()' method MUST
+   // be implemented
+#include "BasicFramework.hpp"
+
+   // Class to read data from files, serial ports and tcp sockets
+#include "DeviceStream.hpp"
+
+   // Class for handling MDP streams
+#include "MDPStream.hpp"
+
+   // Class holding the MDP observations of one SV
+#include "MDPObsEpoch.hpp"
+
+   // Conversions from MDP to RINEX observations
+#include "RinexConverters.hpp"
+
+   // Class to store a list of processing objects
+#include "ProcessingList.hpp"
+
+   // Class defining the GNSS data structures
+#include "DataStructures.hpp"
+
+   // Class holding the data stores of the PPP processing
+#include "PPPDataStores.hpp"
+
+   // Class processing the observations up to the prefit residuals
+#include "PPPProcessing.hpp"
+
+   // Class to compute Dilution Of Precision values
+#include "ComputeDOP.hpp"
+
+   // Class to compute the Precise Point Positioning (PPP) solution in
+   // forwards-only mode.
+#include "SolverPPP.hpp"
+
+   // Class to read configuration files.
+#include "ConfDataReader.hpp"
+
+#include <sys/time.h>
+
+
+using namespace std;
+using namespace gpstk;
+using namespace gpstk::StringUtils;
+
+
+   // A new class is declared that will handle program behaviour
+   // This class inherits from BasicFramework
+class rtPPP : public gpstk::BasicFramework
+{
+public:
+
+      // Constructor declaration
+   rtPPP(char* arg0);
+
+
+protected:
+
+
+      // Method that will take care of processing
+   virtual void process();
+
+      // Method that hold code to be run BEFORE processing
+   virtual void spinUp();
+
+
+private:
+
+
+      // This field represents an option at command line interface (CLI)
+   CommandOptionWithArg confFile;
+
+      // Option for the input stream
+   CommandOptionWithAnyArg inputOpt;
+
+      // Option for the station name
+   CommandOptionWithAnyArg stationOpt;
+
+      // Option for sp3 file list
+   CommandOptionWithAnyArg sp3FileListOpt;
+
+      // Option for clk file list
+   CommandOptionWithAnyArg clkFileListOpt;
+
+      // Option for eop file list
+   CommandOptionWithAnyArg eopFileListOpt;
+
+      // Option for monitor coordinate file
+   CommandOptionWithAnyArg mscFileOpt;
+
+      // Option for P1C1 DCB file
+   CommandOptionWithAnyArg dcbFileListOpt;
+
+      // Option for the receiver and antenna of the station
+   CommandOptionWithAnyArg recTypeOpt;
+   CommandOptionWithAnyArg antTypeOpt;
+   CommandOptionWithAnyArg antOffsetOpt;
+
+      // Option for the output file
+   CommandOptionWithAnyArg outputFileOpt;
+
+      // Option for the latency budget
+   CommandOptionWithAnyArg budgetOpt;
+
+      // Option for the speed of a replayed stream
+   CommandOptionWithAnyArg speedOpt;
+
+      // If you want to share objects and variables among methods, you'd
+      // better declare them here
+
+   string inputName;
+   string station;
+   string sp3FileListName;
+   string clkFileListName;
+   string eopFileListName;
+   string mscFileName;
+   string dcbFileListName;
+   string recType;
+   string antType;
+   Triple offsetARP;
+   string outputFileName;
+   double budget;
+   double speed;
+
+      // Configuration file reader
+   ConfDataReader confReader;
+
+
+      // Declare our own methods to handle output
+
+
+      // Method to print solution values
+   void printSolution( ofstream& outfile,
+                       const  SolverLMS& solver,
+                       const  CommonTime& time,
+                       const  ComputeDOP& cDOP,
+                       bool   useNEU,
+                       int    numSats,
+                       double dryTropo,
+                       int    precision = 3 );
+
+
+      // Method to print the latency statistics
+   void printLatency( ostream& out,
+                      vector<double>& latency,
+                      long dropped,
+                      long late );
+
+
+      // Wall clock time, in seconds
+   static double wallTime();
+
+
+}; // End of 'rtPPP' class declaration
+
+
+
+   // Let's implement constructor details
+rtPPP::rtPPP(char* arg0)
+   :
+   gpstk::BasicFramework(  arg0,
+"\nThis program reads parameters from a configuration file, \n"
+"reads the ephemeris data from command line and the GPS receiver \n"
+"data from a live MDP stream, then process the data using the PPP \n"
+"strategy, epoch by epoch, within a latency budget.\n\n"
+"Please consult the default configuration file, 'ppp.conf', for \n"
+"further details. Only forwards processing is possible in real time.\n\n"
+"The output file format is as follows:\n"
+"\n 1) Year"
+"\n 2) doy"
+"\n 3) Seconds of day"
+"\n 4) dx/dLat (m)"
+"\n 5) dy/dLon (m)"
+"\n 6) dz/dH (m)"
+"\n 7) Zenital Tropospheric Delay (zpd) (m)"
+"\n 8) Number of satellites"
+"\n 9) GDOP"
+"\n10) PDOP"
+"\n11) Latency (s)\n"),
+      // Option initialization. "true" means a mandatory option
+   confFile(          CommandOption::stdType,
+                      'c',
+                      "conffile",
+   "Name of configuration file ('ppp.conf' by default).",
+                      false),
+   inputOpt(          'i',
+                      "input",
+   "MDP stream: file, ser:device or tcp:host:port (stdin by default).",
+                      false),
+   stationOpt(        'n',
+                      "station",
+   "name of the station, as in the MSC and BLQ files",
+                      true),
+   sp3FileListOpt(    's',
+                      "sp3FileList",
+   "file storing a list of rinex SP3 file name ",
+                      true),
+   clkFileListOpt(    'k',
+                      "clkFileList",
+   "file storing a list of rinex clk file name ",
+                      false),
+   eopFileListOpt(    'e',
+                      "eopFileList",
+   "file storing a list of IGS erp file name ",
+                      true),
+   mscFileOpt(        'm',
+                      "mscFile",
+   "file storing monitor station coordinates ",
+                      true),
+   dcbFileListOpt(    'D',
+                      "dcbFileList",
+   "file storing the P1C1 DCB file list.",
+                      false),
+   recTypeOpt(        'R',
+                      "recType",
+   "receiver type of the station, as in the RINEX header.",
+                      false),
+   antTypeOpt(        'A',
+                      "antType",
+   "antenna type of the station, as in the RINEX header.",
+                      false),
+   antOffsetOpt(      'a',
+                      "antOffset",
+   "\"H E N\" vector from monument to antenna ARP, in meters.",
+                      false),
+   outputFileOpt(     'o',
+                      "outputFile",
+   "name of the output file ('<station>.out' by default).",
+                      false),
+   budgetOpt(         'b',
+                      "budget",
+   "latency budget of one epoch, in seconds (1 by default).",
+                      false),
+   speedOpt(          'x',
+                      "speed",
+   "factor a replayed stream is sped up by (1 by default).",
+                      false)
+{
+
+      // These options may appear just once at CLI
+   confFile.setMaxCount(1);
+   inputOpt.setMaxCount(1);
+   stationOpt.setMaxCount(1);
+   antOffsetOpt.setMaxCount(1);
+   outputFileOpt.setMaxCount(1);
+   budgetOpt.setMaxCount(1);
+   speedOpt.setMaxCount(1);
+
+}  // End of 'rtPPP::rtPPP'
+
+
+
+   // Method to print solution values
+void rtPPP::printSolution( ofstream& outfile,
+                           const SolverLMS& solver,
+                           const CommonTime& time,
+                           const ComputeDOP& cDOP,
+                           bool  useNEU,
+                           int   numSats,
+                           double dryTropo,
+                           int   precision )
+{
+
+      // Prepare for printing
+   outfile << fixed << setprecision( precision );
+
+
+      // Print results
+   outfile << static_cast<YDSTime>(time).year        << "  ";    // Year           - #1
+   outfile << setw(5) << static_cast<YDSTime>(time).doy         << "  ";    // DayOfYear      - #2
+   outfile << setw(12)<< static_cast<YDSTime>(time).sod   << "  ";    // SecondsOfDay   - #3
+
+   if( useNEU )
+   {
+
+      outfile<< setw(8) << solver.getSolution(TypeID::dLat) << "  ";       // dLat  - #4
+      outfile<< setw(8) << solver.getSolution(TypeID::dLon) << "  ";       // dLon  - #5
+      outfile<< setw(8) << solver.getSolution(TypeID::dH) << "  ";         // dH    - #6
+
+         // We add 0.1 meters to 'wetMap' because 'NeillTropModel' sets a
+         // nominal value of 0.1 m. Also to get the total we have to add the
+         // dry tropospheric delay value
+                                                                 // ztd - #7
+      outfile<< setw(8) << solver.getSolution(TypeID::wetMap) + 0.1 + dryTropo << "  ";
+
+   }
+   else
+   {
+
+      outfile << solver.getSolution(TypeID::dx) << "  ";         // dx    - #4
+      outfile << solver.getSolution(TypeID::dy) << "  ";         // dy    - #5
+      outfile << solver.getSolution(TypeID::dz) << "  ";         // dz    - #6
+
+         // We add 0.1 meters to 'wetMap' because 'NeillTropModel' sets a
+         // nominal value of 0.1 m. Also to get the total we have to add the
+         // dry tropospheric delay value
+                                                                 // ztd - #7
+      outfile << solver.getSolution(TypeID::wetMap) + 0.1 + dryTropo << "  ";
+
+   }
+
+   outfile << numSats << "  ";    // Number of satellites - #8
+   outfile << solver.getConverged() << "  ";
+
+   outfile << cDOP.getGDOP()        << "  ";  // GDOP - #9
+   outfile << cDOP.getPDOP()        << "  ";  // PDOP - #10
+
+   return;
+
+
+}  // End of method 'rtPPP::printSolution()'
+
+
+
+   // Method to print the latency statistics
+void rtPPP::printLatency( ostream& out,
+                          vector<double>& latency,
+                          long dropped,
+                          long late )
+{
+
+   out << "Epochs solved: " << latency.size()
+       << ", dropped: " << dropped
+       << ", over budget: " << late << endl;
+
+   if( latency.empty() )
+   {
+      return;
+   }
+
+   sort( latency.begin(), latency.end() );
+
+      // Nearest-rank percentiles
+   const double pct[] = { 50.0, 90.0, 99.0, 100.0 };
+   const char* name[] = { "p50", "p90", "p99", "max" };
+
+   out << "Latency (ms):";
+   for(int i = 0; i < 4; i++)
+   {
+      size_t k( static_cast<size_t>(
+                   std::ceil( pct[i]/100.0*latency.size() ) ) );
+      if( k < 1 ) k = 1;
+      if( k > latency.size() ) k = latency.size();
+
+      out << " " << name[i] << " " << fixed << setprecision(3)
+          << 1000.0*latency[k-1];
+   }
+   out << endl;
+
+}  // End of method 'rtPPP::printLatency()'
+
+
+
+   // Wall clock time, in seconds
+double rtPPP::wallTime()
+{
+   struct timeval tv;
+   gettimeofday(&tv, NULL);
+   return ( tv.tv_sec + 1.0e-6*tv.tv_usec );
+}
+
+
+
+   // Method that will be executed AFTER initialization but BEFORE processing
+void rtPPP::spinUp()
+{
+
+      // Check if the user provided a configuration file name
+   if ( confFile.getCount() > 0 )
+   {
+
+         // Enable exceptions
+      confReader.exceptions(ios::failbit);
+
+      try
+      {
+
+            // Try to open the provided configuration file
+         confReader.open( confFile.getValue()[0] );
+
+      }
+      catch(...)
+      {
+
+         cerr << "Problem opening file "
+              << confFile.getValue()[0]
+              << endl;
+         cerr << "Maybe it doesn't exist or you don't have proper "
+              << "read permissions." << endl;
+
+         exit (-1);
+
+      }  // End of 'try-catch' block
+
+   }
+   else
+   {
+
+      try
+      {
+            // Try to open default configuration file
+         confReader.open( "ppp.conf" );
+      }
+      catch(...)
+      {
+
+         cerr << "Problem opening default configuration file 'ppp.conf'"
+              << endl;
+         cerr << "Maybe it doesn't exist or you don't have proper read "
+              << "permissions. Try providing a configuration file with "
+              << "option '-c'."
+              << endl;
+
+         exit (-1);
+
+      }  // End of 'try-catch' block
+
+   }  // End of 'if ( confFile.getCount() > 0 )'
+
+      // If a given variable is not found in the provided section, then
+      // 'confReader' will look for it in the 'DEFAULT' section.
+   confReader.setFallback2Default(true);
+
+      // Now, Let's parse the command line
+   if(inputOpt.getCount())
+   {
+      inputName = inputOpt.getValue()[0];
+   }
+   if(stationOpt.getCount())
+   {
+      station = stationOpt.getValue()[0];
+   }
+   if(sp3FileListOpt.getCount())
+   {
+      sp3FileListName = sp3FileListOpt.getValue()[0];
+   }
+   if(clkFileListOpt.getCount())
+   {
+      clkFileListName = clkFileListOpt.getValue()[0];
+   }
+   if(eopFileListOpt.getCount())
+   {
+      eopFileListName = eopFileListOpt.getValue()[0];
+   }
+   if(mscFileOpt.getCount())
+   {
+      mscFileName = mscFileOpt.getValue()[0];
+   }
+   if(dcbFileListOpt.getCount())
+   {
+      dcbFileListName = dcbFileListOpt.getValue()[0];
+   }
+   if(recTypeOpt.getCount())
+   {
+      recType = recTypeOpt.getValue()[0];
+   }
+   if(antTypeOpt.getCount())
+   {
+      antType = antTypeOpt.getValue()[0];
+   }
+   if(antOffsetOpt.getCount())
+   {
+      string offset( antOffsetOpt.getValue()[0] );
+      offsetARP[0] = asDouble( stripFirstWord(offset) );
+      offsetARP[1] = asDouble( stripFirstWord(offset) );
+      offsetARP[2] = asDouble( stripFirstWord(offset) );
+   }
+   if(outputFileOpt.getCount())
+   {
+      outputFileName = outputFileOpt.getValue()[0];
+   }
+   else
+   {
+      outputFileName = station + ".out";
+   }
+
+   budget = 1.0;
+   if(budgetOpt.getCount())
+   {
+      budget = asDouble( budgetOpt.getValue()[0] );
+   }
+
+   speed = 1.0;
+   if(speedOpt.getCount())
+   {
+      speed = asDouble( speedOpt.getValue()[0] );
+   }
+   if( speed <= 0.0 )
+   {
+      cerr << "The speed must be positive." << endl;
+      exit(-1);
+   }
+
+}  // End of method 'rtPPP::spinUp()'
+
+
+
+   // Method that will really process information
+void rtPPP::process()
+{
+
+      // Data stores: SP3, clock, BLQ, EOP, DCB and MSC files
+   PPPDataStores stores;
+
+   try
+   {
+      stores.loadSP3FileList( sp3FileListName );
+
+         // If rinex clock file list is given, then use rinex clock
+      if(clkFileListOpt.getCount())
+      {
+         stores.loadClockFileList( clkFileListName );
+      }
+
+      stores.loadBLQFile( confReader.getValue( "oceanLoadingFile",
+                                               "DEFAULT" ) );
+      stores.loadEOPFileList( eopFileListName );
+
+      if(dcbFileListOpt.getCount())
+      {
+         stores.loadDCBFileList( dcbFileListName );
+      }
+
+      stores.loadMSCFile( mscFileName );
+   }
+   catch(Exception& e)
+   {
+      cerr << e << endl;
+      exit(-1);
+   }
+
+      // Let's check the ocean loading data for the station before
+      // the real data processing.
+   if( ! stores.blqStore.isValid(station) )
+   {
+      cerr << "There is no BLQ data for station: " << station << endl;
+      exit(-1);
+   }
+
+      //**********************************************************
+      // Now, Let's open the stream, and wait for the first epoch
+      //**********************************************************
+
+   DeviceStream<MDPStream> input( inputName );
+
+   MDPEpoch mdpEpoch;
+   if( !(input >> mdpEpoch) || mdpEpoch.empty() )
+   {
+      cerr << "No data from '" << input.getTarget() << "'." << endl;
+      exit(-1);
+   }
+
+      // First time for this stream
+   CommonTime initialTime( mdpEpoch.begin()->second.time );
+
+      // Show a message indicating that we are starting with this station
+   cout << "Starting processing for station: '" << station << "'." << endl;
+
+      // MSC data for this station
+   Position nominalPos;
+   try
+   {
+      nominalPos = stores.getNominalPosition( station, initialTime );
+   }
+   catch(InvalidRequest& ie)
+   {
+      cerr << "The station " << station
+           << " isn't included in MSC file." << endl;
+      exit(-1);
+   }
+
+      // The processing works in GPS time
+   initialTime.setTimeSystem(TimeSystem::GPS);
+
+   cout << nominalPos << endl;
+
+      // Processing of the observations, up to the prefit residuals
+   PPPProcessing pppModel( confReader,
+                           stores,
+                           station,
+                           nominalPos,
+                           initialTime,
+                           recType,
+                           antType,
+                           offsetARP );
+
+      // Get if we want results in ECEF or NEU reference system
+   bool isNEU( confReader.getValueAsBoolean( "USENEU") );
+
+
+      // Declare solver object. Only the 'forwards' solver makes sense
+      // in real time.
+   SolverPPP pppSolver(isNEU);
+
+   if( confReader.getValueAsInt("filterCycles") > 0 )
+   {
+      cout << "Forwards-backwards processing is not possible in real "
+           << "time; 'filterCycles' is ignored." << endl;
+   }
+
+      // Get if we want to process coordinates as white noise
+   bool isWN( confReader.getValueAsBoolean( "coordAsWhiteNoise") );
+
+      // White noise stochastic model
+   WhiteNoiseModel wnM(100.0);      // 100 m of sigma
+
+      // Check about coordinates as white noise
+   if ( isWN )
+   {
+         // Reconfigure solver
+      pppSolver.setCoordinatesModel(&wnM);
+   }
+
+      // Create a 'ProcessingList' object where we'll store
+      // the processing objects in order
+   ProcessingList pList;
+   pList.push_back(pppModel);
+   pList.push_back(pppSolver);
+
+
+      // This is the GNSS data structure that will hold all the
+      // GNSS-related information
+   gnssRinex gRin;
+   gRin.header.source.type = SourceID::GPS;
+   gRin.header.source.sourceName = station;
+   gRin.header.antennaType = antType;
+
+      // There is no RINEX header in the stream; the conversion needs none
+   RinexObsHeader roh;
+
+
+      // Prepare for printing
+   int precision( confReader.getValueAsInt( "precision" ) );
+
+   ofstream outfile;
+   outfile.open( outputFileName.c_str(), ios::out );
+
+      // print out the header
+   outfile << "# col  1 -  3: year/doy/sod \n"
+           << "# col  4 -  7: dN/dE/dU/ZTD \n"
+           << "# col  8 - 11: TotalSatNumber/Converged/GDOP/PDOP \n"
+           << "# col 12     : Latency (s) \n"
+           << "# END OF HEADER" << endl;
+
+
+      // Latency statistics
+   vector<double> latency;
+   long dropped(0), late(0);
+
+      // Typical time taken to solve one epoch, in seconds
+   double cost(0.0);
+
+      // Offset between the wall clock and the time tags of the stream,
+      // i.e., when the epoch at 'initialTime' arrived, or should have
+      // arrived judging from the others. It is taken once everything is
+      // set up, so that the setup does not count against the budget.
+   double streamStart( wallTime() );
+
+      //// *** Now comes the REAL forwards processing part *** ////
+
+      // Loop over all data epochs, as they arrive
+   do
+   {
+
+      if( mdpEpoch.empty() )
+      {
+         continue;
+      }
+
+         // Store current epoch
+      CommonTime time( mdpEpoch.begin()->second.time );
+
+         // When the epoch should have arrived, and when it did
+      double due( (time - initialTime)/speed );
+      double now( wallTime() );
+
+      streamStart = std::min( streamStart, now - due );
+
+         // Drop it if it can not be solved within the budget any more;
+         // it would delay the ones behind it
+      if( now - (streamStart + due) + cost > budget )
+      {
+         dropped++;
+
+            // Lower the cost a little, so that a few slow epochs can not
+            // stop the processing
+         cost *= 0.99;
+
+         continue;
+      }
+
+         // Convert the epoch to a GDS
+      RinexObsData rod( makeRinexObsData(mdpEpoch) );
+      gRin.header.epoch = time;
+      gRin.header.epochFlag = 0;
+      gRin.body = satTypeValueMapFromRinexObsData(roh, rod);
+
+      try
+      {
+            // Let's process data. Thanks to 'ProcessingList' this is
+            // very simple and compact: Just one line of code!!!.
+         gRin >> pList;
+
+      }
+      catch(DecimateEpoch& d)
+      {
+            // If we catch a DecimateEpoch exception, just continue.
+         continue;
+      }
+      catch(SVNumException& s)
+      {
+            // If we catch a SVNumException, just continue.
+         continue;
+      }
+      catch(Exception& e)
+      {
+         cerr << "Exception for station '" << station <<
+                 "' at epoch: " << time << ": " << e << endl;
+         continue;
+      }
+      catch(...)
+      {
+         cerr << "Unknown exception for station '" << station <<
+                 " at epoch: " << time << endl;
+         continue;
+      }
+
+         // The solution is ready
+      double done( wallTime() );
+      double lat( done - (streamStart + due) );
+
+         // Running mean of the processing cost
+      cost = ( (cost > 0.0) ? (0.9*cost + 0.1*(done - now)) : (done - now) );
+
+      latency.push_back(lat);
+      if( lat > budget )
+      {
+         late++;
+      }
+
+         // This is a 'forwards-only' filter. Let's print to output
+         // file the results of this epoch
+      printSolution( outfile,
+                     pppSolver,
+                     time,
+                     pppModel.getDOP(),
+                     isNEU,
+                     gRin.numSats(),
+                     pppModel.getDryTropo(),
+                     precision );
+
+      outfile << setprecision(6) << lat << endl;
+
+         // The given epoch hass been processed. Let's get the next one
+
+   } while( input >> mdpEpoch );
+
+      //// *** Forwards processing part is over *** ////
+
+      // Close output file for this station
+   outfile.close();
+
+      // We are done with this station. Let's show a message
+   cout << "Processing finished for station: '" << station
+        << "'. Results in file: '" << outputFileName << "'." << endl;
+
+   printLatency( cout, latency, dropped, late );
+
+      //***********************************************
+      //
+      // At last, Let's clear the content of SP3/EOP/MSC object
+      //
+      //***********************************************
+   stores.clear();
+
+
+   return;
+
+}  // End of 'rtPPP::process()'
+
+
+
+   // Main function
+int main(int argc, char* argv[])
+{
+   try
+   {
+
+      rtPPP program(argv[0]);
+
+         // We are disabling 'pretty print' feature to keep
+         // our description format
+      if ( !program.initialize(argc, argv, true) )
+      {
+         return 0;
+      }
+      if ( !program.run() )
+      {
+         return 1;
+      }
+
+      return 0;
+   }
+   catch(Exception& e)
+   {
+      cerr << "Problem: " << e << endl;
+
+      return 1;
+   }
+   catch(...)
+   {
+      cerr << "Unknown error." << endl;
+
+      return 1;
+   }
+
+   return 0;
+
+}  // End of 'main()'
@@ -51,6 +51,7 @@
 *   -t <dt>             time spacing
 *   -na                 do North America only [world default]
 *   -d                  dump grid results to file for each time step (time-intensive)
+*   -j <n>              number of threads used over the grid [all available]
 *   -h, --help          output options info and exit
 *   -v                  output version info and exit
 *
@@ -95,6 +96,11 @@
 *      mode, not almanac.
 *   6. The code uses geodetic coordinates for all calculations.
 *   7. The -d option is useful for e.g. making movies of DOPs throughout a day.
+*   8. Satellite positions are computed once per time step, and the position,
+*      up vector and UENT transform of each grid point once per run. When built
+*      with OpenMP the grid points of a time step are shared among threads;
+*      statistics and output are then gathered in grid order, so the results
+*      do not depend on the number of threads.
 *
 *-----------------------------------------------------------------------------------*/
 
@@ -106,6 +112,10 @@
 #include <iostream>
 #include <fstream>
 
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
 // GPS-Tk modules
 #include "FICStream.hpp"
 #include "FICAStream.hpp"
@@ -143,6 +153,7 @@ bool readStats = false; // if true, read initial statistics from a file
                         // (which was created in an earlier run of this program)
 bool NAonly    = false; // if true, limit consideration to North America; else world
 bool dumpeach  = false; // if true, dump grid results to a file at each time step
+int nthreads   = 0;     // number of threads used over the grid; 0 means all
 int week = -1;          // input initial timetag -- if not present in input, use the
 double sow = 0;         // TOA of the first almanac
 vector<int> ExPRN;      // PRNs to exclude from processing
@@ -190,15 +201,17 @@ WGS84Ellipsoid WGS84;
 double dlon;                  // dlon is the spacing in lon on the equator
 vector<int> Sats;             // satellite PRNs available in the AlmOrbit map aomap
 Xvt SVPVT;                    // satellite info used to calculate SV position
-Position SV;                  // dummy variable for satellite position
-vector<Position> SVs;         // satellite position array used for each time step;
-                              // a SV is added to SVs if it's valid
+vector<Triple> SVs;           // satellite ECEF position array used for each time
+                              // step; a SV is added to SVs if it's valid
 class M4 : public Matrix<double> // trick to declare a 4x4 double array of Matrix
 {
 public:
   M4() : Matrix<double>(4,4) {};
 };
-vector<M4> Rmat; // vector of XYZ->UENT coordinate transform 4x4 matrices
+vector<M4> Rmat;        // vector of XYZ->UENT coordinate transform 4x4 matrices
+vector<Triple> GridXYZ; // ECEF position of each grid point
+vector<Triple> GridUp;  // geodetic up unit vector (ECEF) of each grid point
+vector<char> Visible;   // whether each grid point saw 4 SVs at this time step
 
 // time averaging
 
@@ -237,7 +250,9 @@ int WriteStatsFile(string filename);
 int OutputGrid(string filename);
 int DumpGrid(CommonTime& tt, string filename);
 void BuildGrid(void);
-void ComputeDOPs(CommonTime& tt, GridData& gd, vector<Position>& SVs, M4& R);
+void SetupGridGeometry(void);
+bool ComputeDOPs(GridData& gd, const vector<Triple>& SVs,
+                 const Triple& Rx, const Triple& Up, const M4& R);
 
 //------------------------------------------------------------------------------------
 
@@ -262,6 +277,7 @@ try
            << "                 -t <dt>             time spacing" << endl
            << "                 -na                 do North America only" << endl
            << "                 -d                  dump grid results at each time step (time-intensive)" << endl
+           << "                 -j <n>              number of threads used over the grid [all]" << endl
            << "                 -h, --help          output options info and exit" << endl
            << "                 -v                  print version info and exit" << endl
            << endl;
@@ -289,6 +305,7 @@ try
      else if (string(argv[i]) == "-rs") readStats = true;
      else if (string(argv[i]) == "-na") NAonly = true;
      else if (string(argv[i]) == "-d" ) dumpeach = true;
+     else if (string(argv[i]) == "-j" ) nthreads = atoi(argv[++i]);
      else if (string(argv[i]) == "-v" )
      {
        cout << "CalcDOPs version " << fixed << setprecision(1) << setw(3) << version << endl;
@@ -344,6 +361,7 @@ try
 
    // build the spatial grid, and store it in vector<GridData> Grid;
    BuildGrid();
+   SetupGridGeometry();
 
    // get a list of the available satellite PRNs and the initial timetag
    bool ok;
@@ -456,43 +474,54 @@ try
           {
             continue;
           }
-          SV.setECEF(SVPVT.x[0],SVPVT.x[1],SVPVT.x[2]); // get SV position
-          SVs.push_back(SV);                            // add to the vector
+          SVs.push_back(Triple(SVPVT.x[0],SVPVT.x[1],SVPVT.x[2])); // add SV position
         }
         else          // almanac mode
         {
           SVPVT = aomap[Sats[i]].svXvt(tt);
-          SV.setECEF(SVPVT.x[0],SVPVT.x[1],SVPVT.x[2]); // get SV position
-          SVs.push_back(SV);                            // add to the vector
+          SVs.push_back(Triple(SVPVT.x[0],SVPVT.x[1],SVPVT.x[2])); // add SV position
         }
       }
 
+      // compute DOPs at all grid positions, in parallel
+      int ifailed = -1;
+      Exception failure;
+#ifdef _OPENMP
+      int nt( nthreads > 0 ? nthreads : omp_get_max_threads() );
+#pragma omp parallel for schedule(dynamic,64) num_threads(nt)
+#endif
+      for (i=0; i<int(Grid.size()); i++)
+      {
+        try
+        {
+          Visible[i] = ComputeDOPs(Grid[i],SVs,GridXYZ[i],GridUp[i],Rmat[i]);
+        }
+        catch(Exception& e)
+        {
+#ifdef _OPENMP
+#pragma omp critical (CalcDOPs_failure)
+#endif
+          {
+            if (ifailed == -1 || i < ifailed) { ifailed = i; failure = e; }
+          }
+        }
+      }
+      if (ifailed != -1) GPSTK_THROW(failure);
+
       // zero worst-site DOPs (worst #SVs to large #) for this time step
 
       StepWorstG = StepWorstP = StepWorstH = StepWorstV = StepWorstT = 0.;
       StepWorstN = 10000.;
 
-      for (i=0; i<int(Grid.size()); i++) // LOOP OVER GRID POSITIONS
+      for (i=0; i<int(Grid.size()); i++) // LOOP OVER GRID POSITIONS, in order
       {
-        if ( j == 0 ) // set up grid position vector only on first time step
+        if (!Visible[i])
         {
-          // transform XYZT to UENT: R*Vector(XYZT) = Vector(UENT)
-          double ca,sa,co,so;
           Position Rx(Grid[i].lat,Grid[i].lon,0.0,Position::Geodetic); // grid position
-          ca = cos(Rx.geodeticLatitude()*DEG_TO_RAD);
-          sa = sin(Rx.geodeticLatitude()*DEG_TO_RAD);
-          co = cos(Rx.longitude()*DEG_TO_RAD);
-          so = sin(Rx.longitude()*DEG_TO_RAD);
-          M4 Rtemp;
-          Rtemp(0,0) = ca*co ; Rtemp(0,1) = ca*so ; Rtemp(0,2) = sa ; Rtemp(0,3) = 0.0;
-          Rtemp(1,0) = -so   ; Rtemp(1,1) = co    ; Rtemp(1,2) = 0.0; Rtemp(1,3) = 0.0;
-          Rtemp(2,0) = -sa*co; Rtemp(2,1) = -sa*so; Rtemp(2,2) = ca ; Rtemp(2,3) = 0.0;
-          Rtemp(3,0) = 0.0   ; Rtemp(3,1) = 0.0   ; Rtemp(3,2) = 0.0; Rtemp(3,3) = 1.0;
-          Rmat.push_back(Rtemp); // add this grid point's R matrix to the stack
+          lofs << "Inadequate visibility: grid " << Rx.printf("%5.1AN %5.1LE")
+               << " time " << CivilTime(tt) << endl;
         }
 
-        ComputeDOPs(tt,Grid[i],SVs,Rmat[i]); // compute DOPs
-
         BadPDOP[i] = BadPDOP[i] + Grid[i].bdop; // adds up each grid pt.'s BDOP over all times
                                                 // BDOP for a single pt. is 0 or 1 for PDOP <= v. > 6
 
@@ -1341,14 +1370,59 @@ catch(Exception& e) { GPSTK_RETHROW(e); }
 
 //------------------------------------------------------------------------------------
 
-void ComputeDOPs(CommonTime& tt, GridData& gd, vector<Position>& SVs, M4& R)
+// Set up the ECEF position, up vector and XYZT->UENT transform of each grid
+// point; these do not change with time, so it is done once, after BuildGrid().
+void SetupGridGeometry(void)
+{
+try
+{
+   Rmat.clear();
+   GridXYZ.clear();
+   GridUp.clear();
+   for (size_t i=0; i<Grid.size(); i++)
+   {
+     // transform XYZT to UENT: R*Vector(XYZT) = Vector(UENT)
+     double ca,sa,co,so;
+     Position Rx(Grid[i].lat,Grid[i].lon,0.0,Position::Geodetic); // grid position
+     ca = cos(Rx.geodeticLatitude()*DEG_TO_RAD);
+     sa = sin(Rx.geodeticLatitude()*DEG_TO_RAD);
+     co = cos(Rx.longitude()*DEG_TO_RAD);
+     so = sin(Rx.longitude()*DEG_TO_RAD);
+     M4 Rtemp;
+     Rtemp(0,0) = ca*co ; Rtemp(0,1) = ca*so ; Rtemp(0,2) = sa ; Rtemp(0,3) = 0.0;
+     Rtemp(1,0) = -so   ; Rtemp(1,1) = co    ; Rtemp(1,2) = 0.0; Rtemp(1,3) = 0.0;
+     Rtemp(2,0) = -sa*co; Rtemp(2,1) = -sa*so; Rtemp(2,2) = ca ; Rtemp(2,3) = 0.0;
+     Rtemp(3,0) = 0.0   ; Rtemp(3,1) = 0.0   ; Rtemp(3,2) = 0.0; Rtemp(3,3) = 1.0;
+     Rmat.push_back(Rtemp); // add this grid point's R matrix to the stack
+
+     // local up, as in Position::elevationGeodetic()
+     double lat = Rx.getGeodeticLatitude()*DEG_TO_RAD;
+     double lon = Rx.getLongitude()*DEG_TO_RAD;
+     GridUp.push_back(Triple(::cos(lat)*::cos(lon), ::cos(lat)*::sin(lon), ::sin(lat)));
+
+     Rx.transformTo(Position::Cartesian);
+     GridXYZ.push_back(Triple(Rx.X(),Rx.Y(),Rx.Z()));
+   }
+   Visible.assign(Grid.size(),1);
+}
+catch(Exception& e) { GPSTK_RETHROW(e); }
+}
+
+//------------------------------------------------------------------------------------
+
+// Compute the DOPs at grid point gd, at ECEF position Rx with local up vector Up
+// and XYZT->UENT transform R, from the ECEF positions of the SVs. Elevations and
+// ranges are those of Position::elevationGeodetic() and range(). Returns false,
+// leaving the DOPs of gd unchanged, if fewer than 4 SVs are visible. This is
+// called from several threads at once, so it writes nothing but gd.
+bool ComputeDOPs(GridData& gd, const vector<Triple>& SVs,
+                 const Triple& Rx, const Triple& Up, const M4& R)
 {
 try
 {
    int j,n,Nsvs;
    double elev,rawrange;
 
-   Position Rx(gd.lat,gd.lon,0.0,Position::Geodetic); // grid position
    gd.bdop = 0.;
 
    Nsvs = SVs.size();
@@ -1360,26 +1434,28 @@ try
    n = 0;                                     // number of visible SVs
    for (j=0; j<Nsvs; j++)
    {
-      elev = Rx.elevationGeodetic(SVs[j]);
+      Triple z(SVs[j] - Rx);                  // slant vector, as in elevationGeodetic
+      if (z.mag() <= 1e-4)
+      {
+         GeometryException ge("Positions are within .1 millimeter");
+         GPSTK_THROW(ge);
+      }
+      elev = 90.0 - ::acos(z.dot(Up)/z.mag())*RAD_TO_DEG;
       if (elev <= 5.0) continue;              // TD Elevation limit input
 
-      rawrange = range(Rx,SVs[j]);            // geometric range
+      rawrange = RSS(Rx[0]-SVs[j][0],Rx[1]-SVs[j][1],Rx[2]-SVs[j][2]); // geometric range
 
-      DC(n,0) = (Rx.X()-SVs[j].X())/rawrange; // direction cosines
-      DC(n,1) = (Rx.Y()-SVs[j].Y())/rawrange; // (G matrix of Misra & Enge)
-      DC(n,2) = (Rx.Z()-SVs[j].Z())/rawrange;
+      DC(n,0) = (Rx[0]-SVs[j][0])/rawrange;   // direction cosines
+      DC(n,1) = (Rx[1]-SVs[j][1])/rawrange;   // (G matrix of Misra & Enge)
+      DC(n,2) = (Rx[2]-SVs[j][2])/rawrange;
       DC(n,3) = 1;
 
       n++;                                    // increase counter for # visible SVs
    }
 
    // if there aren't 4 satellites, we can't go on
-   if (n < 4)
-   {
-      lofs << "Inadequate visibility: grid " << Rx.printf("%5.1AN %5.1LE")
-           << " time " << CivilTime(tt) << endl;
-      return;
-   }
+   if (n < 4) return false;
+
    DC = Matrix<double>(DC,0,0,n,4);       // trim the unnecessary zeros
 
    DC = DC * transpose(R);                // transform to UENT (G~ matrix)
@@ -1395,6 +1471,8 @@ try
    gd.nsvs = n;
 
    if (gd.pdop > 6) { gd.bdop = gd.bdop + 1. ; } // def'n of BDOP
+
+   return true;
 }
 catch(Exception& e) { GPSTK_RETHROW(e); }
 }
@@ -734,37 +734,72 @@ void compSatVis::computeVisibility( gpstk::CommonTime currT )
    StaPosList::const_iterator splCI;
    DiscreteVisibleCounts& dvc0 = dvcList.find(0)->second;
 
-   vector<Position> staPosVector;
-   for (PRNID=1;PRNID<=gpstk::MAX_PRN;++PRNID)
+      // The counts and DOPs of the SVs are computed in parallel, then
+      // reported and accumulated in PRN order.
+   vector<Position> staPositions;
+   for (splCI =stationPositions.begin();
+        splCI!=stationPositions.end();
+        ++splCI)
+      staPositions.push_back(splCI->second);
+
+   int numVisList[gpstk::MAX_PRN+1];
+   double valDOPList[gpstk::MAX_PRN+1];
+   int failedPRN = -1;
+   Exception failure;
+#ifdef _OPENMP
+#pragma omp parallel for schedule(dynamic,1)
+#endif
+   for (int prn=1;prn<=gpstk::MAX_PRN;++prn)
    {
-      if (!SVAvail[PRNID]) continue;
-      int numVis = 0;
-      staPosVector.clear();
-      for (splCI =stationPositions.begin();
-           splCI!=stationPositions.end();
-           ++splCI)
+      if (!SVAvail[prn]) continue;
+      try
+      {
+         int numVis = 0;
+         vector<Position> staPosVector;
+         for (size_t k=0; k<staPositions.size(); ++k)
+         {
+            double elv = staPositions[k].elvAngle( SVpos[prn] );
+            if (elv>=minimumElevationAngle)
+            {
+               numVis++;
+               staPosVector.push_back(staPositions[k]);
+            }
+         }
+         numVisList[prn] = numVis;
+
+            // Compute DOP (if option requested)
+         if (compDop)
+         {
+            VisSupport::M4 Rtemp = VisSupport::calculateObserverVectors(SVpos[prn]);
+            valDOPList[prn] = VisSupport::computeDOP(SVpos[prn],
+                                       staPosVector,
+                                       Rtemp,
+                                       minimumElevationAngle, true);
+         }
+      }
+      catch(Exception& e)
       {
-         Position staPos = splCI->second;
-         double elv = staPos.elvAngle( SVpos[PRNID] );
-         if (elv>=minimumElevationAngle)
+#ifdef _OPENMP
+#pragma omp critical (compSatVis_failure)
+#endif
          {
-            numVis++;
-            staPosVector.push_back(staPos); 
+            if (failedPRN == -1 || prn < failedPRN) { failedPRN = prn; failure = e; }
          }
       }
+   }
+   if (failedPRN != -1) GPSTK_THROW(failure);
+
+   for (PRNID=1;PRNID<=gpstk::MAX_PRN;++PRNID)
+   {
+      if (!SVAvail[PRNID]) continue;
+      int numVis = numVisList[PRNID];
       if (detailPrint) fprintf(logfp,"   %2d,",numVis);
       if (numVis>maxNum) maxNum = numVis;
       if (numVis<minNum) minNum = numVis;
 
-         // Compute DOP (if option requested)
       if (compDop)
       {     
-         VisSupport::M4 Rtemp = VisSupport::calculateObserverVectors(SVpos[PRNID]);
-         double valDOP = VisSupport::computeDOP(SVpos[PRNID],
-                                    staPosVector,
-                                    Rtemp,
-                                    minimumElevationAngle, true);
-          int iValDop = (int) valDOP;
+          int iValDop = (int) valDOPList[PRNID];
           fprintf(DOPfp," %4d,",iValDop);
           if (iValDop>maxDOP) maxDOP = iValDop;
           if (iValDop<minDOP) minDOP = iValDop; 
@@ -761,16 +761,59 @@ void compStaVis::computeVisibility( gpstk::CommonTime currT )
    }
    DiscreteVisibleCounts& dvcAVG = dvcCI->second;
                         
+      // The elevations above each station are computed in parallel, then
+      // reported and accumulated in station order.
+   StaPosList::const_iterator splCI;
+   vector<Position> staPositions;
+   for (splCI =stationPositions.begin();
+        splCI!=stationPositions.end();
+        ++splCI)
+      staPositions.push_back(splCI->second);
+
+   int numSta = (int) staPositions.size();
+   vector< vector<int> > visPRNList(numSta);
+   vector< vector<double> > visElvList(numSta);
+   int failedSta = -1;
+   Exception failure;
+#ifdef _OPENMP
+#pragma omp parallel for schedule(dynamic,1)
+#endif
+   for (int k=0;k<numSta;++k)
+   {
+      try
+      {
+         for (int prn=1;prn<=gpstk::MAX_PRN;++prn)
+         {
+            if (!SVAvail[prn]) continue;
+            double elv = staPositions[k].elvAngle( SVpos[prn] );
+            if (elv>=minimumElevationAngle)
+            {
+               visPRNList[k].push_back(prn);
+               visElvList[k].push_back(elv);
+            }
+         }
+      }
+      catch(Exception& e)
+      {
+#ifdef _OPENMP
+#pragma omp critical (compStaVis_failure)
+#endif
+         {
+            if (failedSta == -1 || k < failedSta) { failedSta = k; failure = e; }
+         }
+      }
+   }
+   if (failedSta != -1) GPSTK_THROW(failure);
+
       // Now count number of SVs visible at each station
    int maxNum = 0;
    int minNum = gpstk::MAX_PRN + 1; 
-   StaPosList::const_iterator splCI;
+   int staIndex = 0;
    for (splCI =stationPositions.begin();
         splCI!=stationPositions.end();
-        ++splCI)
+        ++splCI, ++staIndex)
    {
       int numVis = 0;
-      double elv = 0.0;
       
          // Look up the appropriate StaStats object
       string staName = splCI->first;
@@ -785,30 +828,25 @@ void compStaVis::computeVisibility( gpstk::CommonTime currT )
 
       SVList = "";
       char SVform[10];
-      Position staPos = splCI->second;
-      for (PRNID=1;PRNID<=gpstk::MAX_PRN;++PRNID)
+      const vector<int>& visPRN = visPRNList[staIndex];
+      const vector<double>& visElv = visElvList[staIndex];
+      for (size_t i=0;i<visPRN.size();++i)
       {
-         if (SVAvail[PRNID])
+         PRNID = visPRN[i];
+         if (healthyOnly==0 ||
+            (healthyOnly!=0 && SVHealth[PRNID]==0))
          {
-            elv = staPos.elvAngle( SVpos[PRNID] );
-            if (elv>=minimumElevationAngle)
+            numVis++;
+            ss.addToElvBins( visElv[i] );
+            sprintf(SVform," %02d",PRNID);
+            SVList += SVform;
+         }
+         else
+         {
+            if (healthyOnly==2)
             {
-               if (healthyOnly==0 ||
-                  (healthyOnly!=0 && SVHealth[PRNID]==0))
-               {
-                  numVis++;
-                  ss.addToElvBins( elv );
-                  sprintf(SVform," %02d",PRNID);
-                  SVList += SVform;
-               }
-               else
-               {
-                  if (healthyOnly==2)
-                  {
-                     sprintf(SVform," %02d(HLTH)",PRNID);
-                     SVList += SVform;
-                  }
-               }
+               sprintf(SVform," %02d(HLTH)",PRNID);
+               SVList += SVform;
             }
          }
       }
@@ -142,8 +142,10 @@ struct option
 # ifdef __GNU_LIBRARY__
 /* Many other libraries have conflicting prototypes for getopt, with
    differences in the consts, in stdlib.h.  To avoid compilation
-   errors, only prototype getopt for the GNU C library.  */
-extern int getopt (int __argc, char *const *__argv, const char *__shortopts);
+   errors, only prototype getopt for the GNU C library, and with its
+   exception specification, since <unistd.h> declares it too.  */
+extern int getopt (int __argc, char *const *__argv, const char *__shortopts)
+       __THROW;
 # endif /* __GNU_LIBRARY__ */
 
 # ifndef __need_getopt
@@ -32,6 +32,9 @@
 
 #include "IonexStore.hpp"
 
+#include <algorithm>
+#include <cmath>
+
 using namespace gpstk::StringUtils;
 using namespace gpstk;
 using namespace std;
@@ -91,6 +94,9 @@ namespace gpstk
             addMap(iod);
          }
 
+            // flat copy of the maps for fast lookup
+         buildGrid();
+
       }
       catch (gpstk::Exception& e)
       {
@@ -127,6 +133,110 @@ namespace gpstk
 
 
 
+      // Copy the stored maps into flat lat x lon x time arrays
+   void IonexStore::buildGrid()
+      throw()
+   {
+
+      grid = IonexGrid();
+
+      if ( inxMaps.empty() )
+      {
+         return;
+      }
+
+         // the grid definition is taken from the first map
+      IonexMap::const_iterator itm = inxMaps.begin();
+      const IonexData& first( itm->second.begin()->second );
+
+      grid.firstEpoch = itm->first;
+      grid.nmaps = inxMaps.size();
+      if (grid.nmaps > 1)
+      {
+         grid.interval = (++itm)->first - grid.firstEpoch;
+      }
+
+      for (int i = 0; i < 3; i++)
+      {
+         grid.dim[i] = first.dim[i];
+         grid.lat[i] = first.lat[i];
+         grid.lon[i] = first.lon[i];
+         grid.hgt[i] = first.hgt[i];
+      }
+
+      grid.mapSize = grid.dim[0] * grid.dim[1] * grid.dim[2];
+      grid.ncyc = static_cast<int>( ( 360.0 / std::abs(grid.lon[2]) ) + 0.5 );
+
+      grid.tec.assign(grid.nmaps * grid.mapSize, 999.9);
+      grid.rms.assign(grid.nmaps * grid.mapSize, 999.9);
+      grid.hasTEC.assign(grid.nmaps, false);
+      grid.hasRMS.assign(grid.nmaps, false);
+
+      int imap(0);
+      for (itm = inxMaps.begin(); itm != inxMaps.end(); itm++, imap++)
+      {
+
+            // maps must be evenly spaced...
+         double dt( itm->first - grid.firstEpoch );
+         if ( std::abs(dt - imap*grid.interval) > 1.0e-6 )
+         {
+            grid = IonexGrid();
+            return;
+         }
+
+         IonexValTypeMap::const_iterator itv;
+         for (itv = itm->second.begin(); itv != itm->second.end(); itv++)
+         {
+
+            const IonexData& iod(itv->second);
+
+               // ... and share one grid
+            bool same( iod.data.size() == size_t(grid.mapSize) );
+            for (int i = 0; i < 3; i++)
+            {
+               same = same && iod.dim[i] == grid.dim[i]
+                           && iod.lat[i] == grid.lat[i]
+                           && iod.lon[i] == grid.lon[i]
+                           && iod.hgt[i] == grid.hgt[i];
+            }
+
+            if (!same)
+            {
+               grid = IonexGrid();
+               return;
+            }
+
+            double *values;
+            if (itv->first == IonexData::TEC)
+            {
+               values = &grid.tec[imap*grid.mapSize];
+               grid.hasTEC[imap] = true;
+            }
+            else if (itv->first == IonexData::RMS)
+            {
+               values = &grid.rms[imap*grid.mapSize];
+               grid.hasRMS[imap] = true;
+            }
+            else
+            {
+               continue;
+            }
+
+            for (int i = 0; i < grid.mapSize; i++)
+            {
+               values[i] = iod.data[i];
+            }
+
+         }  // End of 'for (itv = itm->second.begin(); ...'
+
+      }  // End of 'for (itm = inxMaps.begin(); ...'
+
+      grid.valid = true;
+
+   }  // End of method 'IonexStore::buildGrid()'
+
+
+
       /** Dump the store to the provided std::ostream (std::cout by default).
        *
        * @param s       std::ostream object to dump the data to.
@@ -231,6 +341,7 @@ namespace gpstk
    {
 
       inxMaps.clear();
+      grid = IonexGrid();
 
       initialTime = CommonTime::END_OF_TIME;
       finalTime = CommonTime::BEGINNING_OF_TIME;
@@ -297,73 +408,29 @@ namespace gpstk
 
       }
 
-         //let's define the number of maps to be considered
-      int nmap;
-      if      (strategy == 1) nmap = 1;
-      else if (strategy == 2) nmap = 2;
-      else if (strategy == 3) nmap = 2;
-      else if (strategy == 4) nmap = 1;
-      else
+         // the flat grid does the same with index arithmetic
+      if (grid.valid)
       {
-         InvalidRequest e("Invalid interpolation stategy");
-         GPSTK_THROW(e);
-      }
 
-         // let's look for valid Ionex maps
-      CommonTime T[2];
-         // iterator
-      IonexMap::const_iterator itm = inxMaps.find(t);
-      try
-      {
+         std::vector<Position> rx(1, RX);
+         std::vector<Triple> values;
+         std::vector<bool> valid;
 
-         if( itm != inxMaps.end() )              // exact match of t
+         if ( getIonexValues(t, rx, values, valid, strategy) == 0 )
          {
-
-               // get the current map
-            itm = inxMaps.lower_bound(t);
-               // store current and next epoch
-            T[0] = itm->first;
-            T[1] = (++itm)->first;
-
+            InvalidRequest e("Position off the grid or undefined TEC/RMS");
+            GPSTK_THROW(e);
          }
-         else                                   // t is between two maps
-         {
 
-               // get the next valid map
-            itm = inxMaps.lower_bound(t);
-               // store the next and previous epoch
-            T[1] = itm->first;
-            T[0] = (--itm)->first;
-
-         }  // end of 'if( itm != inxMaps.end() ) ... else ... '' 
+         return values[0];
 
       }
-      catch (...)
-      {
-         InvalidRequest e("IonexStore::getIonexValue() ... Invalid time!");
-         GPSTK_THROW(e);
-      }
-
 
-         // factors (As in Eq.(3), pag.2 of the manual)
+         // let's look for valid Ionex maps and their factors
+      int nmap;
+      CommonTime T[2];
       double f[2];
-      f[0] = (T[1]-t   ) / (T[1]-T[0]);
-      f[1] = (t   -T[0]) / (T[1]-T[0]);
-
-         // if only one map, then we have to use the neareast
-      if( nmap == 1 )
-      {
-
-            // closer to the next map
-         if( f[1] > f[0] )
-         {
-            T[0] = T[1];
-         }
-
-            // than the factor is unit
-         f[0] = 1.0;
-
-      }  // if( nmap == 1 )
+      findMaps(t, strategy, nmap, T, f);
 
          // loop over the number of maps considered
       for(int imap = 0; imap < nmap; imap++)
@@ -392,29 +459,25 @@ namespace gpstk
 
 
             // iterator to the current map
-         itm = inxMaps.find(T[imap]);
+         IonexMap::const_iterator itm = inxMaps.find(T[imap]);
 
             // map to hold the IONEX types for the current map
-         IonexValTypeMap ivtm = (*itm).second;
-
-            // object to hold the corresponding data to the current map
-         IonexData iod;
+         const IonexValTypeMap& ivtm = (*itm).second;
+         IonexValTypeMap::const_iterator itv;
 
             // Compute TEC value
-         if ( ivtm.find(IonexData::TEC) != ivtm.end() )
+         if ( (itv = ivtm.find(IonexData::TEC)) != ivtm.end() )
          {
 
-            iod = ivtm[IonexData::TEC];
-            tecval[0] = tecval[0] + f[imap]*iod.getValue(pos);
+            tecval[0] = tecval[0] + f[imap]*itv->second.getValue(pos);
 
          }
 
             // Compute RMS value
-         if ( ivtm.find(IonexData::RMS) != ivtm.end() )
+         if ( (itv = ivtm.find(IonexData::RMS)) != ivtm.end() )
          {
 
-            iod = ivtm[IonexData::RMS];
-            tecval[1] = tecval[1] + f[imap]*iod.getValue(pos);
+            tecval[1] = tecval[1] + f[imap]*itv->second.getValue(pos);
 
          }
 
@@ -430,6 +493,342 @@ namespace gpstk
 
 
 
+      // Get IONEX TEC, RMS and ionosphere height values for several
+      // positions at one epoch.
+   int IonexStore::getIonexValues( const CommonTime& t,
+                                   const std::vector<Position>& RX,
+                                   std::vector<Triple>& values,
+                                   std::vector<bool>& valid,
+                                   int strategy ) const
+      throw(InvalidRequest)
+   {
+
+      values.assign( RX.size(), Triple(0.0,0.0,0.0) );
+      valid.assign( RX.size(), false );
+
+         // maps and factors are common to all positions
+      int nmap;
+      CommonTime T[2];
+      double f[2];
+      findMaps(t, strategy, nmap, T, f);
+
+      int nvalid(0);
+
+         // without the flat grid, do one position at a time
+      if (!grid.valid)
+      {
+
+         for (size_t i = 0; i < RX.size(); i++)
+         {
+            try
+            {
+               values[i] = getIonexValue(t, RX[i], strategy);
+               valid[i] = true;
+               nvalid++;
+            }
+            catch (InvalidRequest& e)
+            {
+               continue;
+            }
+         }
+
+         return nvalid;
+
+      }
+
+         // offsets of the maps in the grid, and their rotation in longitude
+      int offset[2];
+      double rotation[2];
+      for (int imap = 0; imap < nmap; imap++)
+      {
+
+         int i( static_cast<int>( (T[imap] - grid.firstEpoch) /
+                                  (grid.interval > 0.0 ? grid.interval : 1.0)
+                                  + 0.5 ) );
+         offset[imap] = i * grid.mapSize;
+
+            // seconds of time to degree (360.0 / 86400.0)
+         rotation[imap] = (strategy == 1 || strategy == 2) ?
+                          0.0 : ( t - T[imap] ) * 4.16666666666667e-3;
+
+      }
+
+         // the object is required for AEarth to be consistent with 
+         // Position::getIonosphericPiercePoint()
+      WGS84Ellipsoid WGS84;
+      double AEarth( WGS84.a() );
+
+      for (size_t i = 0; i < RX.size(); i++)
+      {
+
+         if ( RX[i].getCoordinateSystem() != Position::Geocentric )
+         {
+            continue;
+         }
+
+         double beta( RX[i].theArray[0] );
+         double height( RX[i].theArray[2] - AEarth );
+         double tec(0.0), rms(0.0), value;
+         bool ok(true);
+
+         for (int imap = 0; ok && imap < nmap; imap++)
+         {
+
+               // a map with no weight does not contribute
+            if (f[imap] == 0.0)
+            {
+               continue;
+            }
+
+            int k( offset[imap] / grid.mapSize );
+
+               // IONEX longitude takes values within [-180 180]
+            double lambda( RX[i].theArray[1] + rotation[imap] );
+            if (lambda > 180.0)
+            {
+               lambda = lambda - 360.0;
+            }
+
+            if (grid.hasTEC[k])
+            {
+               ok = gridValue(&grid.tec[offset[imap]],
+                              beta, lambda, height, value);
+               tec += f[imap]*value;
+            }
+
+            if (ok && grid.hasRMS[k])
+            {
+               ok = gridValue(&grid.rms[offset[imap]],
+                              beta, lambda, height, value);
+               rms += f[imap]*value;
+            }
+
+         }  // End of 'for (int imap = 0; ok && imap < nmap; imap++)'
+
+         if (ok)
+         {
+            values[i] = Triple(tec, rms, RX[i].theArray[2]);
+            valid[i] = true;
+            nvalid++;
+         }
+
+      }  // End of 'for (size_t i = 0; i < RX.size(); i++)'
+
+      return nvalid;
+
+   }  // End of method 'IonexStore::getIonexValues()'
+
+
+
+      // Find the maps and interpolation factors for time t.
+   void IonexStore::findMaps( const CommonTime& t,
+                              int strategy,
+                              int& nmap,
+                              CommonTime T[2],
+                              double f[2] ) const
+      throw(InvalidRequest)
+   {
+
+         // current time check
+      if (t < getInitialTime())
+      {
+         InvalidRequest e("Inadequate data before requested time");
+         GPSTK_THROW(e);
+      }
+
+      if (t > getFinalTime() )
+      {
+         InvalidRequest e("Inadequate data after requested time");
+         GPSTK_THROW(e);
+      }
+
+         //let's define the number of maps to be considered
+      if      (strategy == 1) nmap = 1;
+      else if (strategy == 2) nmap = 2;
+      else if (strategy == 3) nmap = 2;
+      else if (strategy == 4) nmap = 1;
+      else
+      {
+         InvalidRequest e("Invalid interpolation stategy");
+         GPSTK_THROW(e);
+      }
+
+      if (grid.valid)
+      {
+
+            // index of the map at or before t
+         int i(0);
+         if (grid.interval > 0.0)
+         {
+            i = static_cast<int>( (t - grid.firstEpoch) / grid.interval );
+         }
+
+         if (i >= grid.nmaps - 1)
+         {
+            i = grid.nmaps - 1;
+         }
+
+         T[0] = grid.firstEpoch + i*grid.interval;
+         T[1] = (i < grid.nmaps - 1) ? T[0] + grid.interval : T[0];
+
+      }
+      else
+      {
+
+            // iterator
+         IonexMap::const_iterator itm = inxMaps.find(t);
+         try
+         {
+
+            if( itm != inxMaps.end() )              // exact match of t
+            {
+
+                  // get the current map
+               itm = inxMaps.lower_bound(t);
+                  // store current and next epoch
+               T[0] = itm->first;
+               T[1] = (++itm != inxMaps.end()) ? itm->first : T[0];
+
+            }
+            else                                   // t is between two maps
+            {
+
+                  // get the next valid map
+               itm = inxMaps.lower_bound(t);
+                  // store the next and previous epoch
+               T[1] = itm->first;
+               T[0] = (--itm)->first;
+
+            }  // end of 'if( itm != inxMaps.end() ) ... else ... '' 
+
+         }
+         catch (...)
+         {
+            InvalidRequest e("IonexStore::getIonexValue() ... Invalid time!");
+            GPSTK_THROW(e);
+         }
+
+      }  // End of 'if (grid.valid) ... else ...'
+
+
+         // factors (As in Eq.(3), pag.2 of the manual)
+      if (T[1] == T[0])
+      {
+         f[0] = 1.0;
+         f[1] = 0.0;
+      }
+      else
+      {
+         f[0] = (T[1]-t   ) / (T[1]-T[0]);
+         f[1] = (t   -T[0]) / (T[1]-T[0]);
+      }
+
+         // if only one map, then we have to use the neareast
+      if( nmap == 1 )
+      {
+
+            // closer to the next map
+         if( f[1] > f[0] )
+         {
+            T[0] = T[1];
+         }
+
+            // than the factor is unit
+         f[0] = 1.0;
+
+      }  // if( nmap == 1 )
+
+   }  // End of method 'IonexStore::findMaps()'
+
+
+
+      // Interpolate one map of the flat grid at a position; this follows
+      // IonexData::getIndex() and IonexData::getValue().
+   bool IonexStore::gridValue( const double* values,
+                               double beta,
+                               double lambda,
+                               double height,
+                               double& result ) const
+      throw()
+   {
+
+      int nlat( grid.dim[0] );
+      int nlon( grid.dim[1] );
+      int nhgt( grid.dim[2] );
+
+         // lower left hand grid point E00
+      int ilat( static_cast<int>( (beta - grid.lat[0]) / grid.lat[2] + 1.0 ) );
+      if ( ilat < 1 || ilat > nlat )
+      {
+         return false;
+      }
+
+      int ilon( static_cast<int>( (lambda - grid.lon[0]) / grid.lon[2] + 1.0 ) );
+      if      (ilon < 1)    ilon += grid.ncyc;
+      else if (ilon > nlon) ilon -= grid.ncyc;
+      if ( ilon < 1 || ilon > nlon )
+      {
+         return false;
+      }
+
+      int ihgt(1);
+      if (grid.hgt[2] != 0.0)
+      {
+         ihgt = static_cast<int>( (height/1000.0 - grid.hgt[0]) / grid.hgt[2]
+                                  + 1.0 );
+         if ( ihgt < 1 || ihgt > nhgt )
+         {
+            return false;
+         }
+      }
+
+         // compute factors P and Q
+      double xp( (lambda - (grid.lon[0] + (ilon-1)*grid.lon[2])) / grid.lon[2] );
+      double xq( (beta   - (grid.lat[0] + (ilat-1)*grid.lat[2])) / grid.lat[2] );
+         // rounding may leave a point on a grid line just outside the cell
+      const double eps(1.0e-9);
+      if ( (xp < -eps) || (xp > 1+eps) || (xq < -eps) || (xq > 1+eps) )
+      {
+         return false;
+      }
+      xp = std::min( std::max(xp, 0.0), 1.0 );
+      xq = std::min( std::max(xq, 0.0), 1.0 );
+
+         // neighbours E10, E01 and E11
+      int ilon1( ilon + 1 );
+      if (ilon1 > nlon) ilon1 -= grid.ncyc;
+      if ( ilon1 < 1 || ilon1 > nlon || ilat + 1 > nlat )
+      {
+         return false;
+      }
+
+      int base( (ihgt-1)*nlon*nlat );
+      double pntval[4];
+      pntval[0] = values[ base + (ilon -1) + (ilat-1)*nlon ];
+      pntval[1] = values[ base + (ilon1-1) + (ilat-1)*nlon ];
+      pntval[2] = values[ base + (ilon -1) +  ilat   *nlon ];
+      pntval[3] = values[ base + (ilon1-1) +  ilat   *nlon ];
+
+      for (int i = 0; i < 4; i++)
+      {
+         if (pntval[i] == 999.9)
+         {
+            return false;
+         }
+      }
+
+         // bivariate interpolation (pag.3, IONEX manual)
+      result = (1.0-xp) * (1.0-xq) * pntval[0] +
+                    xp  * (1.0-xq) * pntval[1] +
+               (1.0-xp) *      xq  * pntval[2] +
+                    xp  *      xq  * pntval[3];
+
+      return true;
+
+   }  // End of method 'IonexStore::gridValue()'
+
+
+
       /** Get slant total electron content (STEC) in TECU
        *
        * @param elevation     Time tag of signal (CommonTime object)
@@ -34,6 +34,7 @@
 
 
 #include <map>
+#include <vector>
 
 #include "FileStore.hpp"
 #include "IonexData.hpp"
@@ -85,11 +86,25 @@ namespace gpstk
          throw(FileMissingException);
 
 
-         /// Insert a new IonexData object into the store
+         /// Insert a new IonexData object into the store. Call buildGrid()
+         /// after the last map has been added.
       void addMap(const IonexData& iod)
          throw();
 
 
+         /** Copy the stored maps into flat lat x lon x time arrays, so that
+          *  getIonexValue() and getIonexValues() find grid points by index
+          *  arithmetic. This is done by loadFile(); call it after adding
+          *  maps with addMap().
+          *
+          * The flat arrays are only built when all maps share one grid and
+          * are evenly spaced in time; otherwise the maps are searched as
+          * before.
+          */
+      void buildGrid()
+         throw();
+
+
          /** Dump the store to the provided std::ostream (std::cout by default).
           *
           * @param s       std::ostream object to dump the data to.
@@ -136,6 +151,36 @@ namespace gpstk
          throw(InvalidRequest);
 
 
+         /** Get IONEX TEC, RMS and ionosphere height values for several
+          *  positions at one epoch, e.g. all the ionospheric pierce points
+          *  of an epoch.
+          *
+          * The maps and interpolation factors are found once for the epoch,
+          * and each position then costs a few index computations. The
+          * interpolation is the same as in getIonexValue().
+          *
+          * @param t          Time tag of signal (CommonTime object)
+          * @param RX         Positions in GEOCENTRIC coordinates
+          * @param values     Output TEC, RMS and ionosphere height values,
+          *                   parallel to RX
+          * @param valid      Output flags, parallel to RX, false where the
+          *                   position is off the grid or touches undefined
+          *                   values; such values are set to zero.
+          * @param strategy   Interpolation strategy, as in getIonexValue()
+          *
+          * @return           Number of valid values
+          *
+          * @throw InvalidRequest if there are no maps for time t, or the
+          *                       strategy is invalid
+          */
+      int getIonexValues( const CommonTime& t,
+                          const std::vector<Position>& RX,
+                          std::vector<Triple>& values,
+                          std::vector<bool>& valid,
+                          int strategy = 3 ) const
+         throw(InvalidRequest);
+
+
 
       /** Get slant total electron content (STEC) in TECU
        *
@@ -359,6 +404,73 @@ namespace gpstk
       IonexDCBMap inxDCBMap;
 
 
+         /// The maps of inxMaps as flat arrays, built by buildGrid().
+      struct IonexGrid
+      {
+            /// True if the arrays hold all the maps
+         bool valid;
+
+            /// Epoch of the first map, and spacing of the maps (seconds)
+         CommonTime firstEpoch;
+         double interval;
+
+            /// Number of maps, and values per map
+         int nmaps, mapSize;
+
+            /// Grid definition shared by all maps, as in IonexData
+         int dim[3];
+         double lat[3], lon[3], hgt[3];
+
+            /// Number of longitude steps in 360 degrees
+         int ncyc;
+
+            /// TEC and RMS values, map after map, each laid out as in
+            /// IonexData::data; 999.9 marks undefined values
+         std::vector<double> tec, rms;
+
+            /// Whether map i has TEC and RMS values
+         std::vector<bool> hasTEC, hasRMS;
+
+         IonexGrid() : valid(false), interval(0.0), nmaps(0), mapSize(0) {};
+
+      } grid;
+
+
+         /** Find the maps and interpolation factors for time t.
+          *
+          * @param t          Time tag
+          * @param strategy   Interpolation strategy, as in getIonexValue()
+          * @param nmap       Output number of maps used (1 or 2)
+          * @param T          Output epochs of the maps
+          * @param f          Output interpolation factors of the maps
+          */
+      void findMaps( const CommonTime& t,
+                     int strategy,
+                     int& nmap,
+                     CommonTime T[2],
+                     double f[2] ) const
+         throw(InvalidRequest);
+
+
+         /** Interpolate one map of the flat grid at a position.
+          *
+          * @param values     First value of the map in grid.tec or grid.rms
+          * @param beta       Geocentric latitude (degrees)
+          * @param lambda     Longitude (degrees)
+          * @param height     Height above the grid ellipsoid (meters)
+          * @param result     Interpolated value
+          *
+          * @return           false if the position is off the grid, or any
+          *                   of the four grid points is undefined
+          */
+      bool gridValue( const double* values,
+                      double beta,
+                      double lambda,
+                      double height,
+                      double& result ) const
+         throw();
+
+
    }; // End of class 'IonexStore'
 
       //@}
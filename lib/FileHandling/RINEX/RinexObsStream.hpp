@@ -111,6 +111,7 @@ namespace gpstk
          FFTextStream::open(fn, mode);
          headerRead = false;
          header = RinexObsHeader();
+         previousTime = CommonTime();
       };
 
 
@@ -131,6 +132,10 @@ namespace gpstk
          /// The header for this file.
       RinexObsHeader header;
 
+
+         /// Time of the previous epoch read, for epochs without a time.
+      CommonTime previousTime;
+
          /// Check if the input stream is the kind of RinexObsStream
       static bool IsRinexObsStream(std::istream& i)
       {
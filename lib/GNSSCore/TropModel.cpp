@@ -78,6 +78,27 @@ namespace gpstk
 
    }  // end TropModel::correction(elevation)
 
+      // Compute the dry and wet mapping functions for all the elevations
+      // of an epoch.
+      // @param elevation Elevations of satellites, in degrees
+      // @param dryMap    Dry mapping functions, parallel to elevation
+      // @param wetMap    Wet mapping functions, parallel to elevation
+   void TropModel::mapping_functions(const std::vector<double>& elevation,
+                                     std::vector<double>& dryMap,
+                                     std::vector<double>& wetMap) const
+      throw(TropModel::InvalidTropModel)
+   {
+      dryMap.resize(elevation.size());
+      wetMap.resize(elevation.size());
+
+      for(size_t i=0; i<elevation.size(); i++)
+      {
+         dryMap[i] = dry_mapping_function(elevation[i]);
+         wetMap[i] = wet_mapping_function(elevation[i]);
+      }
+
+   }  // end TropModel::mapping_functions()
+
       // Compute and return the full tropospheric delay, given the positions of
       // receiver and satellite and the time tag. This version is most useful
       // within positioning algorithms, where the receiver position and timetag may
@@ -2614,6 +2635,13 @@ namespace gpstk
                               { 0.0, 0.000090128400, 0.000043497037,
                                 0.00084795348, 0.0017037206 };
 
+      // constants for the height correction of the dry mapping function
+   static const double NeillHgtA( 0.0000253 );
+   static const double NeillHgtB( 0.00549 );
+   static const double NeillHgtC( 0.00114 );
+   static const double NeillHgtTop(
+                  1.0 + NeillHgtA/(1.0 + NeillHgtB/(1.0 + NeillHgtC)) );
+
 
       // Compute and return the full tropospheric delay. The receiver height,
       // latitude and Day oy Year must has been set before using the
@@ -2841,10 +2869,7 @@ namespace gpstk
          throw InvalidTropModel("Invalid model");
       }
 
-         // Note: 1.013*2.27 = 2.29951
-      double ddry( 2.29951*std::exp( (-0.000116 * NeillHeight) ) );
-
-      return ddry;
+      return dryZenith;
 
    }  // end NeillTropModel::dry_zenith_delay()
 
@@ -2857,93 +2882,87 @@ namespace gpstk
    double NeillTropModel::dry_mapping_function(double elevation) const
       throw(TropModel::InvalidTropModel)
    {
-      if(!valid)
+      checkValid();
+
+      if(elevation < 3.0)
       {
-         if(!validLat)
-         {
-            GPSTK_THROW( InvalidTropModel( "Invalid Neill trop model: Rx \
-                                            Latitude" ) );
-         }
+         return 0.0;
+      }
 
-         if(!validHeight)
-         {
-            GPSTK_THROW( InvalidTropModel( "Invalid Neill trop model: Rx \
-                                            Height" ) );
-         }
+      double se = ::sin(elevation*DEG_TO_RAD);
+      double map = dryTop/(se+dryA/(se+dryB/(se+dryC)));
 
-         if(!validDOY)
-         {
-            GPSTK_THROW( InvalidTropModel( "Invalid Neill trop model: day \
-                                            of year" ) );
-         }
+      map += heightFactor *
+             ( 1./se - NeillHgtTop/(se+NeillHgtA/(se+NeillHgtB/(se+NeillHgtC))) );
+
+      return map;
+
+   }  // end NeillTropModel::dry_mapping_function()
 
-         GPSTK_THROW(InvalidTropModel( "Valid flag corrupted in Neill trop \
-                                        model" ) );
-      }
+
+      // Compute and return the mapping function for wet component of the
+      // troposphere.
+      //
+      // @param elevation Elevation of satellite as seen at receiver,
+      //                  in degrees.
+   double NeillTropModel::wet_mapping_function(double elevation) const
+      throw(TropModel::InvalidTropModel)
+   {
+      checkValid();
 
       if(elevation < 3.0)
       {
          return 0.0;
       }
 
-      double lat, t, ct;
-      lat = fabs(NeillLat);         // degrees
-      t = static_cast<double>(NeillDOY) - 28.0;  // mid-winter
+      double se = ::sin(elevation*DEG_TO_RAD);
+      double map = wetTop / (se + wetA/(se + wetB/(se+wetC) ) );
 
-      if(NeillLat < 0.0)              // southern hemisphere
-      {
-         t += 365.25/2.;
-      }
+      return map;
 
-      t *= 360.0/365.25;            // convert to degrees
-      ct = ::cos(t*DEG_TO_RAD);
+   }  // end NeillTropModel::wet_mapping_function()
 
-      double a, b, c;
-      if(lat < 15.0)
-      {
-         a = NeillDryA[0];
-         b = NeillDryB[0];
-         c = NeillDryC[0];
-      }
-      else if(lat < 75.)      // coefficients are for 15,30,45,60,75 deg
-      {
-         int i=int(lat/15.0)-1;
-         double frac=(lat-15.*(i+1))/15.;
-         a = NeillDryA[i] + frac*(NeillDryA[i+1]-NeillDryA[i]);
-         b = NeillDryB[i] + frac*(NeillDryB[i+1]-NeillDryB[i]);
-         c = NeillDryC[i] + frac*(NeillDryC[i+1]-NeillDryC[i]);
 
-         a -= ct * (NeillDryA1[i] + frac*(NeillDryA1[i+1]-NeillDryA1[i]));
-         b -= ct * (NeillDryB1[i] + frac*(NeillDryB1[i+1]-NeillDryB1[i]));
-         c -= ct * (NeillDryC1[i] + frac*(NeillDryC1[i+1]-NeillDryC1[i]));
-      }
-      else
+      // Compute the dry and wet mapping functions for all the elevations
+      // of an epoch.
+      //
+      // @param elevation Elevations of satellites, in degrees
+      // @param dryMap    Dry mapping functions, parallel to elevation
+      // @param wetMap    Wet mapping functions, parallel to elevation
+   void NeillTropModel::mapping_functions( const std::vector<double>& elevation,
+                                           std::vector<double>& dryMap,
+                                           std::vector<double>& wetMap ) const
+      throw(TropModel::InvalidTropModel)
+   {
+      checkValid();
+
+      size_t n( elevation.size() );
+      dryMap.resize(n);
+      wetMap.resize(n);
+
+      for(size_t i=0; i<n; i++)
       {
-         a = NeillDryA[4] - ct * NeillDryA1[4];
-         b = NeillDryB[4] - ct * NeillDryB1[4];
-         c = NeillDryC[4] - ct * NeillDryC1[4];
-      }
+            // Neill mapping functions work down to 3 degrees of elevation
+         if(elevation[i] < 3.0)
+         {
+            dryMap[i] = wetMap[i] = 0.0;
+            continue;
+         }
 
-      double se = ::sin(elevation*DEG_TO_RAD);
-      double map = (1.+a/(1.+b/(1.+c)))/(se+a/(se+b/(se+c)));
+         double se = ::sin(elevation[i]*DEG_TO_RAD);
 
-      a = 0.0000253;
-      b = 0.00549;
-      c = 0.00114;
-      map += ( NeillHeight/1000.0 ) *
-             ( 1./se - ( (1.+a/(1.+b/(1.+c))) / (se+a/(se+b/(se+c))) ) );
+         dryMap[i] = dryTop/(se+dryA/(se+dryB/(se+dryC)))
+                   + heightFactor * ( 1./se -
+                     NeillHgtTop/(se+NeillHgtA/(se+NeillHgtB/(se+NeillHgtC))) );
 
-      return map;
+         wetMap[i] = wetTop / (se + wetA/(se + wetB/(se+wetC) ) );
+      }
 
-   }  // end NeillTropModel::dry_mapping_function()
+   }  // end NeillTropModel::mapping_functions()
 
 
-      // Compute and return the mapping function for wet component of the
-      // troposphere.
-      //
-      // @param elevation Elevation of satellite as seen at receiver,
-      //                  in degrees.
-   double NeillTropModel::wet_mapping_function(double elevation) const
+      // Throw if any of height, latitude or day of year is missing.
+   void NeillTropModel::checkValid(void) const
       throw(TropModel::InvalidTropModel)
    {
       if(!valid)
@@ -2953,14 +2972,16 @@ namespace gpstk
             GPSTK_THROW( InvalidTropModel( "Invalid Neill trop model: Rx \
                                             Latitude" ) );
          }
+
          if(!validHeight)
          {
             GPSTK_THROW( InvalidTropModel( "Invalid Neill trop model: Rx \
                                             Height" ) );
          }
+
          if(!validDOY)
          {
-            GPSTK_THROW( InvalidTropModel(" Invalid Neill trop model: day \
+            GPSTK_THROW( InvalidTropModel( "Invalid Neill trop model: day \
                                             of year" ) );
          }
 
@@ -2968,45 +2989,14 @@ namespace gpstk
                                         model" ) );
       }
 
-      if(elevation < 3.0)
-      {
-         return 0.0;
-      }
-
-      double a,b,c,lat;
-      lat = fabs(NeillLat);         // degrees
-      if(lat < 15.0)
-      {
-         a = NeillWetA[0];
-         b = NeillWetB[0];
-         c = NeillWetC[0];
-      }
-      else if(lat < 75.)          // coefficients are for 15,30,45,60,75 deg
-      {
-         int i=int(lat/15.0)-1;
-         double frac=(lat-15.*(i+1))/15.;
-         a = NeillWetA[i] + frac*(NeillWetA[i+1]-NeillWetA[i]);
-         b = NeillWetB[i] + frac*(NeillWetB[i+1]-NeillWetB[i]);
-         c = NeillWetC[i] + frac*(NeillWetC[i+1]-NeillWetC[i]);
-      }
-      else
-      {
-         a = NeillWetA[4];
-         b = NeillWetB[4];
-         c = NeillWetC[4];
-      }
-
-      double se = ::sin(elevation*DEG_TO_RAD);
-      double map = ( 1.+ a/ (1.+ b/(1.+c) ) ) / (se + a/(se + b/(se+c) ) );
-
-      return map;
-
-   }  // end NeillTropModel::wet_mapping_function()
+   }  // end NeillTropModel::checkValid()
 
 
       // This method configure the model to estimate the weather using height,
       // latitude and day of year (DOY). It is called automatically when
-      // setting those parameters.
+      // setting those parameters. The coefficients of the mapping functions
+      // and the dry zenith delay depend only on these, and are computed here
+      // once instead of for every satellite.
    void NeillTropModel::setWeather()
       throw(TropModel::InvalidTropModel)
    {
@@ -3026,6 +3016,68 @@ namespace gpstk
 
       valid = validHeight && validLat && validDOY;
 
+      if(!valid)
+      {
+         return;
+      }
+
+      double lat, t, ct;
+      lat = fabs(NeillLat);         // degrees
+      t = static_cast<double>(NeillDOY) - 28.0;  // mid-winter
+
+      if(NeillLat < 0.0)              // southern hemisphere
+      {
+         t += 365.25/2.;
+      }
+
+      t *= 360.0/365.25;            // convert to degrees
+      ct = ::cos(t*DEG_TO_RAD);
+
+      if(lat < 15.0)
+      {
+         dryA = NeillDryA[0];
+         dryB = NeillDryB[0];
+         dryC = NeillDryC[0];
+
+         wetA = NeillWetA[0];
+         wetB = NeillWetB[0];
+         wetC = NeillWetC[0];
+      }
+      else if(lat < 75.)      // coefficients are for 15,30,45,60,75 deg
+      {
+         int i=int(lat/15.0)-1;
+         double frac=(lat-15.*(i+1))/15.;
+         dryA = NeillDryA[i] + frac*(NeillDryA[i+1]-NeillDryA[i]);
+         dryB = NeillDryB[i] + frac*(NeillDryB[i+1]-NeillDryB[i]);
+         dryC = NeillDryC[i] + frac*(NeillDryC[i+1]-NeillDryC[i]);
+
+         dryA -= ct * (NeillDryA1[i] + frac*(NeillDryA1[i+1]-NeillDryA1[i]));
+         dryB -= ct * (NeillDryB1[i] + frac*(NeillDryB1[i+1]-NeillDryB1[i]));
+         dryC -= ct * (NeillDryC1[i] + frac*(NeillDryC1[i+1]-NeillDryC1[i]));
+
+         wetA = NeillWetA[i] + frac*(NeillWetA[i+1]-NeillWetA[i]);
+         wetB = NeillWetB[i] + frac*(NeillWetB[i+1]-NeillWetB[i]);
+         wetC = NeillWetC[i] + frac*(NeillWetC[i+1]-NeillWetC[i]);
+      }
+      else
+      {
+         dryA = NeillDryA[4] - ct * NeillDryA1[4];
+         dryB = NeillDryB[4] - ct * NeillDryB1[4];
+         dryC = NeillDryC[4] - ct * NeillDryC1[4];
+
+         wetA = NeillWetA[4];
+         wetB = NeillWetB[4];
+         wetC = NeillWetC[4];
+      }
+
+      dryTop = 1.+dryA/(1.+dryB/(1.+dryC));
+      wetTop = 1.+wetA/(1.+wetB/(1.+wetC));
+
+      heightFactor = NeillHeight/1000.0;
+
+         // Note: 1.013*2.27 = 2.29951
+      dryZenith = 2.29951*std::exp( (-0.000116 * NeillHeight) );
+
    }
 
 
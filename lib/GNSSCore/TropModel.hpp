@@ -45,6 +45,8 @@
  * of several published models
  */
 
+#include <vector>
+
 #include "Exception.hpp"
 #include "ObsEpochMap.hpp"
 #include "WxObsMap.hpp"
@@ -163,6 +165,19 @@ namespace gpstk
       virtual double wet_mapping_function(double elevation)
          const throw(InvalidTropModel) = 0;
 
+         /// Compute the dry and wet mapping functions for all the elevations
+         /// of an epoch. Models whose mapping function coefficients depend
+         /// only on the station and the epoch override this to compute them
+         /// once for all the satellites.
+         /// @param elevation Elevations of satellites as seen at receiver,
+         ///                  in degrees
+         /// @param dryMap    Dry mapping functions, parallel to elevation
+         /// @param wetMap    Wet mapping functions, parallel to elevation
+      virtual void mapping_functions( const std::vector<double>& elevation,
+                                      std::vector<double>& dryMap,
+                                      std::vector<double>& wetMap ) const
+         throw(InvalidTropModel);
+
          /// Re-define the tropospheric model with explicit weather data.
          /// Typically called just before correction().
          /// @param T temperature in degrees Celsius
@@ -1672,9 +1687,25 @@ namespace gpstk
          throw(InvalidTropModel);
 
 
+         /// Compute the dry and wet mapping functions for all the elevations
+         /// of an epoch, sharing the coefficients prepared by setWeather().
+         ///
+         /// @param elevation Elevations of satellites as seen at receiver,
+         ///                  in degrees
+         /// @param dryMap    Dry mapping functions, parallel to elevation
+         /// @param wetMap    Wet mapping functions, parallel to elevation
+      virtual void mapping_functions( const std::vector<double>& elevation,
+                                      std::vector<double>& dryMap,
+                                      std::vector<double>& wetMap ) const
+         throw(InvalidTropModel);
+
+
          /// This method configure the model to estimate the weather using
          /// height, latitude and day of year (DOY). It is called
-         /// automatically when setting those parameters.
+         /// automatically when setting those parameters, and prepares the
+         /// coefficients of the mapping functions and the dry zenith delay,
+         /// which are the same for all the satellites seen by a receiver
+         /// at one epoch.
       void setWeather()
          throw(InvalidTropModel);
 
@@ -1741,6 +1772,19 @@ namespace gpstk
       bool validLat;
       bool validDOY;
 
+         // Prepared by setWeather(): interpolated coefficients of the dry
+         // and wet mapping functions, their values at zenith, and the
+         // height correction factor of the dry mapping function
+      double dryA, dryB, dryC, dryTop;
+      double wetA, wetB, wetC, wetTop;
+      double heightFactor;
+      double dryZenith;
+
+
+         /// Throw if any of height, latitude or day of year is missing.
+      void checkValid(void) const
+         throw(InvalidTropModel);
+
 
    };    // end class NeillTropModel
 
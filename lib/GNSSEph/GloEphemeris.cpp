@@ -24,6 +24,7 @@
 //============================================================================
 
 #include <iomanip>
+#include <cmath>
 #include "GloEphemeris.hpp"
 #include "TimeString.hpp"
 
@@ -76,117 +77,53 @@ namespace gpstk
 
       }
 
-         // Get the data out of the GloRecord structure
-      double px( x[0] );   // X coordinate (km)
-      double vx( v[0] );   // X velocity   (km/s)
-      double ax( a[0] );   // X acceleration (km/s^2)
-      double py( x[1] );   // Y coordinate
-      double vy( v[1] );   // Y velocity
-      double ay( a[1] );   // Y acceleration
-      double pz( x[2] );   // Z coordinate
-      double vz( v[2] );   // Z velocity
-      double az( a[2] );   // Z acceleration
+         // Integrate the trajectory the first time it is needed
+      prepare();
 
-         // We will need some PZ-90 ellipsoid parameters
-      PZ90Ellipsoid pz90;
-      double we( pz90.angVelocity() );
-
-         // Get sidereal time at Greenwich at 0 hours UT
-      double gst( getSidTime( ephTime ) );
-      double s0( gst*PI/12.0 );
-      YDSTime ytime( ephTime );
-      double numSeconds( ytime.sod );
-      double s( s0 + we*numSeconds );
-      double cs( std::cos(s) );
-      double ss( std::sin(s) );
+         // Find the nodes around the epoch
+      double dt( epoch - ephTime );
+      double u( (dt - firstNode)/nodeStep );
+      int numNodes( traj.size()/12 );
 
-         // Initial state matrix
-      Vector<double> initialState(6), accel(3), dxt1(6), dxt2(6), dxt3(6),
-                     dxt4(6), tempRes(6);
-
-         // Get the reference state out of GloEphemeris object data. Values
-         // must be rotated from PZ-90 to an absolute coordinate system
-         // Initial x coordinate (m)
-      initialState(0)  = (px*cs - py*ss);
-         // Initial y coordinate
-      initialState(2)  = (px*ss + py*cs);
-         // Initial z coordinate
-      initialState(4)  = pz;
-
-         // Initial x velocity   (m/s)
-      initialState(1)  = (vx*cs - vy*ss - we*initialState(2) );
-         // Initial y velocity
-      initialState(3)  = (vx*ss + vy*cs + we*initialState(0) );
-         // Initial z velocity
-      initialState(5)  = vz;
-
-
-         // Integrate satellite state to desired epoch using the given step
-      double rkStep( step );
-
-      if ( (epoch - ephTime) < 0.0 ) rkStep = step*(-1.0);
-      CommonTime workEpoch( ephTime );
-
-      double tolerance( 1e-9 );
-      bool done( false );
-      while (!done)
+         // Never extrapolate beyond the nodes; only the last one is
+         // reached from the interval before it
+      if( u < 0.0 || u > numNodes-1 )
       {
+         InvalidRequest e( "Requested time is out of integrated trajectory" );
+         GPSTK_THROW(e);
+      }
 
-            // If we are about to overstep, change the stepsize appropriately
-            // to hit our target final time.
-         if( rkStep > 0.0 )
-         {
-            if( (workEpoch + rkStep) > epoch )
-               rkStep = (epoch - workEpoch);
-         }
-         else
-         {
-            if ( (workEpoch + rkStep) < epoch )
-               rkStep = (epoch - workEpoch);
-         }
-
-         numSeconds += rkStep;
-         s = s0 + we*( numSeconds );
-         cs = std::cos(s);
-         ss = std::sin(s);
-
-            // Accelerations are computed once per iteration
-         accel(0) = ax*cs - ay*ss;
-         accel(1) = ax*ss + ay*cs;
-         accel(2) = az;
-
-         dxt1 = derivative( initialState, accel );
-         for( int j = 0; j < 6; ++j )
-            tempRes(j) = initialState(j) + rkStep*dxt1(j)/2.0;
-
-         dxt2 = derivative( tempRes, accel );
-         for( int j = 0; j < 6; ++j )
-            tempRes(j) = initialState(j) + rkStep*dxt2(j)/2.0;
-
-         dxt3 = derivative( tempRes, accel );
-         for( int j = 0; j < 6; ++j )
-            tempRes(j) = initialState(j) + rkStep*dxt3(j);
-
-         dxt4 = derivative( tempRes, accel );
-         for( int j = 0; j < 6; ++j )
-            initialState(j) = initialState(j) + rkStep * ( dxt1(j)
-                            + 2.0 * ( dxt2(j) + dxt3(j) ) + dxt4(j) ) / 6.0;
+      int k( static_cast<int>( std::floor(u) ) );
+      if( k > numNodes-2 ) k = numNodes-2;
+      double t( u - k );
 
+         // Cubic Hermite interpolation of the state, using the derivatives
+      double t1( 1.0 - t );
+      double h00( (1.0 + 2.0*t)*t1*t1 );
+      double h10( t*t1*t1*nodeStep );
+      double h01( t*t*(3.0 - 2.0*t) );
+      double h11( -t*t*t1*nodeStep );
 
-            // If we are within tolerance of the target time, we are done.
-         workEpoch += rkStep;
-         if ( std::fabs(epoch - workEpoch ) < tolerance )
-            done = true;
+      const double *n0( &traj[12*k] );
+      const double *n1( n0 + 12 );
+      double state[6];
+      for( int j = 0; j < 6; ++j )
+         state[j] = h00*n0[j] + h10*n0[6+j] + h01*n1[j] + h11*n1[6+j];
 
-      }  // End of 'while (!done)...'
+         // We will need some PZ-90 ellipsoid parameters
+      PZ90Ellipsoid pz90;
+      double we( pz90.angVelocity() );
 
+      double s( siderealAngle + we*( refSeconds + dt ) );
+      double cs( std::cos(s) );
+      double ss( std::sin(s) );
 
-      px = initialState(0);
-      py = initialState(2);
-      pz = initialState(4);
-      vx = initialState(1);
-      vy = initialState(3);
-      vz = initialState(5);
+      double px( state[0] );
+      double py( state[2] );
+      double pz( state[4] );
+      double vx( state[1] );
+      double vy( state[3] );
+      double vz( state[5] );
 
       sv.x[0] = 1000.0*( px*cs + py*ss );         // X coordinate
       sv.x[1] = 1000.0*(-px*ss + py*cs);          // Y coordinate
@@ -243,6 +180,43 @@ namespace gpstk
    }  // End of method 'GloEphemeris::getPRNID()'
 
 
+      /* Integrate the trajectory now, instead of the first time a
+       * position is asked for.
+       */
+   void GloEphemeris::prepare() const
+   {
+
+         // Several threads may ask for positions from the same ephemeris
+         // at once, so only one of them integrates, and the others wait
+         // for it.
+#ifdef _OPENMP
+      bool ready;
+#pragma omp flush
+      ready = trajValid;
+      if( !ready )
+      {
+#pragma omp critical(GloEphemerisTrajectory)
+         {
+            if( !trajValid )
+            {
+               buildTrajectory();
+#pragma omp flush
+               trajValid = true;
+            }
+         }
+      }
+#pragma omp flush
+#else
+      if( !trajValid )
+      {
+         buildTrajectory();
+         trajValid = true;
+      }
+#endif
+
+   }  // End of method 'GloEphemeris::prepare()'
+
+
       /* Compute the satellite clock bias (sec) at the given time
        *
        * @param epoch   Epoch to compute satellite clock bias.
@@ -376,6 +350,10 @@ namespace gpstk
 
       step = rkStep;
 
+         // The trajectory will be integrated again when needed
+      trajValid = false;
+      traj.clear();
+
          // Set this object as valid
       valid = true;
 
@@ -418,9 +396,9 @@ namespace gpstk
 
 
       // Function implementing the derivative of GLONASS orbital model.
-   Vector<double> GloEphemeris::derivative( const Vector<double>& inState,
-                                            const Vector<double>& accel )
-      const
+   void GloEphemeris::derivative( const double* inState,
+                                  const double* accel,
+                                  double* dxt ) const
    {
 
          // We will need some important PZ90 ellipsoid values
@@ -429,14 +407,10 @@ namespace gpstk
       const double mu( pz90.gm_km() );
       const double ae( pz90.a_km() );
 
-         // Let's start getting the current satellite position and velocity
-      double  x( inState(0) );          // X coordinate
-      double vx( inState(1) );          // X velocity
-      double  y( inState(2) );          // Y coordinate
-      double vy( inState(3) );          // Y velocity
-      double  z( inState(4) );          // Z coordinate
-      double vz( inState(5) );          // Z velocity
-#pragma unused(vx,vy,vz)
+         // Let's start getting the current satellite position
+      double  x( inState[0] );          // X coordinate
+      double  y( inState[2] );          // Y coordinate
+      double  z( inState[4] );          // Z coordinate
 
       double r2( x*x + y*y + z*z );
       double r( std::sqrt(r2) );
@@ -451,29 +425,148 @@ namespace gpstk
       double cmz( k1*(3.0-5.0*zr2) );
       double k2(cm-xmu);
 
-      double gloAx( k2*xr + accel(0) );
-      double gloAy( k2*yr + accel(1) );
-      double gloAz( (cmz-xmu)*zr + accel(2) );
-
-      Vector<double> dxt(6, 0.0);
-
          // Let's insert data related to X coordinates
-      dxt(0) = inState(1);       // Set X'  = Vx
-      dxt(1) = gloAx;            // Set Vx' = gloAx
+      dxt[0] = inState[1];                // Set X'  = Vx
+      dxt[1] = k2*xr + accel[0];          // Set Vx' = gloAx
 
          // Let's insert data related to Y coordinates
-      dxt(2) = inState(3);       // Set Y'  = Vy
-      dxt(3) = gloAy;            // Set Vy' = gloAy
+      dxt[2] = inState[3];                // Set Y'  = Vy
+      dxt[3] = k2*yr + accel[1];          // Set Vy' = gloAy
 
          // Let's insert data related to Z coordinates
-      dxt(4) = inState(5);       // Set Z'  = Vz
-      dxt(5) = gloAz;            // Set Vz' = gloAz
-
-      return dxt;
+      dxt[4] = inState[5];                // Set Z'  = Vz
+      dxt[5] = (cmz-xmu)*zr + accel[2];   // Set Vz' = gloAz
 
    }  // End of method 'GloEphemeris::derivative()'
 
 
+      // One Runge-Kutta step of the given length, with the luni-solar
+      // accelerations rotated by 'angle' (radians).
+   void GloEphemeris::rk4Step( double* state,
+                               double h,
+                               double angle ) const
+   {
+
+      double cs( std::cos(angle) );
+      double ss( std::sin(angle) );
+
+         // Accelerations are computed once per step
+      double accel[3];
+      accel[0] = a[0]*cs - a[1]*ss;
+      accel[1] = a[0]*ss + a[1]*cs;
+      accel[2] = a[2];
+
+      double dxt1[6], dxt2[6], dxt3[6], dxt4[6], tempRes[6];
+
+      derivative( state, accel, dxt1 );
+      for( int j = 0; j < 6; ++j )
+         tempRes[j] = state[j] + h*dxt1[j]/2.0;
+
+      derivative( tempRes, accel, dxt2 );
+      for( int j = 0; j < 6; ++j )
+         tempRes[j] = state[j] + h*dxt2[j]/2.0;
+
+      derivative( tempRes, accel, dxt3 );
+      for( int j = 0; j < 6; ++j )
+         tempRes[j] = state[j] + h*dxt3[j];
+
+      derivative( tempRes, accel, dxt4 );
+      for( int j = 0; j < 6; ++j )
+         state[j] = state[j] + h * ( dxt1[j]
+                  + 2.0 * ( dxt2[j] + dxt3[j] ) + dxt4[j] ) / 6.0;
+
+   }  // End of method 'GloEphemeris::rk4Step()'
+
+
+      /* Integrate the trajectory nodes over the validity interval.
+       *
+       * The nodes are some 30 seconds apart, a whole number of integration
+       * steps, and cover the 15 minutes before and after the ephemeris
+       * epoch. The integration goes out from the epoch in both directions
+       * with the same steps as a direct integration, so a node holds the
+       * same state that integrating straight to its epoch would give.
+       */
+   void GloEphemeris::buildTrajectory() const
+   {
+
+         // We will need some PZ-90 ellipsoid parameters
+      PZ90Ellipsoid pz90;
+      double we( pz90.angVelocity() );
+
+         // Get sidereal time at Greenwich at 0 hours UT
+      double gst( getSidTime( ephTime ) );
+      siderealAngle = gst*PI/12.0;
+      YDSTime ytime( ephTime );
+      refSeconds = ytime.sod;
+
+      int stepsPerNode( static_cast<int>( 30.0/step + 0.5 ) );
+      if( stepsPerNode < 1 ) stepsPerNode = 1;
+      nodeStep = stepsPerNode*step;
+
+      int half( static_cast<int>( std::ceil( 900.0/nodeStep ) ) );
+      firstNode = -half*nodeStep;
+      traj.resize( 12*(2*half + 1) );
+
+      double s( siderealAngle + we*refSeconds );
+      double cs( std::cos(s) );
+      double ss( std::sin(s) );
+
+         // Get the reference state out of GloEphemeris object data. Values
+         // must be rotated from PZ-90 to an absolute coordinate system
+      double initialState[6];
+      initialState[0] = (x[0]*cs - x[1]*ss);
+      initialState[2] = (x[0]*ss + x[1]*cs);
+      initialState[4] = x[2];
+      initialState[1] = (v[0]*cs - v[1]*ss - we*initialState[2] );
+      initialState[3] = (v[0]*ss + v[1]*cs + we*initialState[0] );
+      initialState[5] = v[2];
+
+         // Integrate forwards, and then backwards, from the epoch
+      for( int dir = 1; dir >= -1; dir -= 2 )
+      {
+
+         double state[6];
+         for( int j = 0; j < 6; ++j )
+            state[j] = initialState[j];
+
+         double numSeconds( refSeconds );
+         double rkStep( dir*step );
+
+         for( int k = 0; k <= half; ++k )
+         {
+
+            if( k > 0 )
+            {
+               for( int i = 0; i < stepsPerNode; ++i )
+               {
+                  numSeconds += rkStep;
+                  rk4Step( state, rkStep, siderealAngle + we*numSeconds );
+               }
+            }
+
+               // Store the state at this node, and its derivative
+            double *node( &traj[12*(half + dir*k)] );
+            for( int j = 0; j < 6; ++j )
+               node[j] = state[j];
+
+            s = siderealAngle + we*numSeconds;
+            cs = std::cos(s);
+            ss = std::sin(s);
+
+            double accel[3];
+            accel[0] = a[0]*cs - a[1]*ss;
+            accel[1] = a[0]*ss + a[1]*cs;
+            accel[2] = a[2];
+
+            derivative( state, accel, node+6 );
+
+         }  // End of 'for( int k = 0; k <= half; ++k )'
+
+      }  // End of 'for( int dir = 1; ... )'
+
+   }  // End of method 'GloEphemeris::buildTrajectory()'
+
+
       // Output the contents of this ephemeris to the given stream.
    std::ostream& operator<<( std::ostream& s, const GloEphemeris& glo )
    {
@@ -27,6 +27,7 @@
 #define GPSTK_GLOEPHEMERIS_HPP
 
 #include <iostream>
+#include <vector>
 #include "Triple.hpp"
 #include "Xvt.hpp"
 #include "CommonTime.hpp"
@@ -44,6 +45,11 @@ namespace gpstk
        * Ephemeris information for a single GLONASS satellite.  This class
        * encapsulates the ephemeris navigation message and provides functions
        * to handle the ephemerides.
+       *
+       * The orbit is integrated over the whole validity interval the first
+       * time a position is asked for, and kept as a set of nodes; later
+       * requests are interpolated from the nodes, instead of integrating
+       * again from the reference epoch every time.
        */
    class GloEphemeris : public Xvt
    {
@@ -51,7 +57,7 @@ namespace gpstk
 
          /// Default constructor
       GloEphemeris()
-         : valid(false), step(1.0)
+         : valid(false), step(1.0), trajValid(false)
       {};
 
 
@@ -67,6 +73,11 @@ namespace gpstk
          /** Compute satellite position & velocity at the given time
           *  using this ephemeris data.
           *
+          *  Position and velocity are interpolated (cubic Hermite) from the
+          *  integrated trajectory; they agree with a direct Runge-Kutta
+          *  integration to the epoch at the sub-millimeter level, and exactly
+          *  at the nodes of the trajectory.
+          *
           * @param epoch   Epoch to compute position and velocity.
           *
           * @throw InvalidRequest if required data has not been stored.
@@ -75,6 +86,13 @@ namespace gpstk
          throw( gpstk::InvalidRequest );
 
 
+         /** Integrate the trajectory now, instead of the first time a
+          *  position is asked for, so that later calls to svXvt() only read
+          *  this object and take no lock.
+          */
+      void prepare() const;
+
+
          /// Get the epoch time for this ephemeris
       CommonTime getEphemerisEpoch() const
          throw( gpstk::InvalidRequest );
@@ -127,7 +145,7 @@ namespace gpstk
           * @param rkStep  Runge-Kutta integration step in seconds.
           */
       GloEphemeris& setIntegrationStep( double rkStep )
-      { step = rkStep; return (*this); };
+      { step = rkStep; trajValid = false; return (*this); };
 
 
          /// Get the acceleration vector.
@@ -220,13 +238,53 @@ namespace gpstk
       double step;
 
 
+         /// Flag indicating that the trajectory below has been integrated.
+      mutable bool trajValid;
+
+
+         /** Nodes of the integrated trajectory, in the inertial frame used
+          *  by the integration: for each node, the state (x,vx,y,vy,z,vz)
+          *  followed by its derivative, 12 values [km, km/s, km/s^2].
+          */
+      mutable std::vector<double> traj;
+
+
+         /// Seconds between the nodes of the trajectory
+      mutable double nodeStep;
+
+
+         /// Offset of the first node from the ephemeris epoch (seconds)
+      mutable double firstNode;
+
+
+         /// Sidereal angle at 0 hours UT of the ephemeris day (radians)
+      mutable double siderealAngle;
+
+
+         /// Seconds of day of the ephemeris epoch
+      mutable double refSeconds;
+
+
          /// Compute true sidereal time (in hours) at Greenwich at 0 hours UT.
       double getSidTime( const CommonTime& time ) const;
 
 
          /// Function implementing the derivative of GLONASS orbital model.
-      Vector<double> derivative( const Vector<double>& inState,
-                                 const Vector<double>& accel ) const;
+      void derivative( const double* inState,
+                       const double* accel,
+                       double* dxt ) const;
+
+
+         /** One Runge-Kutta step of the given length, with the luni-solar
+          *  accelerations rotated by 'angle' (radians).
+          */
+      void rk4Step( double* state,
+                    double h,
+                    double angle ) const;
+
+
+         /// Integrate the trajectory nodes over the validity interval.
+      void buildTrajectory() const;
 
 
 
@@ -49,6 +49,7 @@ namespace gpstk
 
          SatID sat( data.sat );
          pe[sat][t] = gloEphem; // find or add entry
+         frozen = false;
 
          if (t < initialTime)
             initialTime = t;
@@ -141,8 +142,9 @@ namespace gpstk
          GPSTK_THROW(e);
       }
 
-         // We now have the proper reference data record. Let's use it
-      GloEphemeris data( i->second );
+         // We now have the proper reference data record. Let's use it in
+         // place, so that its integrated trajectory is kept for next time
+      const GloEphemeris& data( i->second );
 
          // Compute the satellite position, velocity and clock offset
       sv = data.svXvt( epoch );
@@ -153,6 +155,31 @@ namespace gpstk
    }; // End of method 'GloEphemerisStore::getXvt()'
 
 
+      /* Prepare the store to be queried from several threads at once,
+       * integrating the trajectories of all the ephemerides now.
+       */
+   void GloEphemerisStore::freeze(void)
+   {
+
+      for( GloEphMap::const_iterator it = pe.begin();
+           it != pe.end();
+           ++it )
+      {
+         for( TimeGloMap::const_iterator tgmIter = (*it).second.begin();
+              tgmIter != (*it).second.end();
+              ++tgmIter )
+         {
+            (*tgmIter).second.prepare();
+         }
+      }
+
+      frozen = true;
+
+      return;
+
+   }; // End of method 'GloEphemerisStore::freeze()'
+
+
       /* A debugging function that outputs in human readable form,
        * all data stored in this object.
        *
@@ -291,6 +318,7 @@ namespace gpstk
 
          // Update the data map before returning
       pe = bak;
+      frozen = false;
 
       return;
       
@@ -60,7 +60,7 @@ namespace gpstk
       GloEphemerisStore()
          : initialTime(CommonTime::END_OF_TIME),
            finalTime(CommonTime::BEGINNING_OF_TIME),
-           step(1.0), checkHealthFlag(false)
+           step(1.0), checkHealthFlag(false), frozen(false)
       { };
 
          /** Common constructor
@@ -72,7 +72,7 @@ namespace gpstk
                          double checkHealth )
          : initialTime(CommonTime::END_OF_TIME),
            finalTime(CommonTime::BEGINNING_OF_TIME),
-           step(rkStep), checkHealthFlag(checkHealth)
+           step(rkStep), checkHealthFlag(checkHealth), frozen(false)
       { };
 
          /// Destructor
@@ -144,6 +144,7 @@ namespace gpstk
       { pe.clear();
         initialTime = CommonTime::END_OF_TIME;
         finalTime = CommonTime::BEGINNING_OF_TIME;
+        frozen = false;
         return;
       };
 
@@ -183,6 +184,17 @@ namespace gpstk
          /// Return true if the given SatID is present in the store
       virtual bool isPresent(const SatID& id) const;
 
+         /** Prepare the store to be queried from several threads at once,
+          *  integrating the trajectories of all the ephemerides now, so
+          *  that getXvt() only reads them. Adding, editing or clearing
+          *  ephemerides thaws the store. See XvtStore::freeze().
+          */
+      virtual void freeze(void);
+
+         /// Return true if the store was frozen, and not changed since.
+      virtual bool isFrozen(void) const
+      { return frozen; };
+
          /// Return the number of satellites present in the store
       int size(void) const
       { return pe.size(); }
@@ -252,6 +264,9 @@ namespace gpstk
          /// their health bit (by default it is false)
       bool checkHealthFlag;
 
+         /// True from freeze() until the ephemerides are changed
+      bool frozen;
+
    };  // End of class 'GloEphemerisStore'
 
 }  // End of namespace gpstk
@@ -44,6 +44,8 @@
 //
 //=============================================================================
 
+#include <vector>
+
 #include "OrbitEph.hpp"
 
 #include "MathBase.hpp"
@@ -100,76 +102,153 @@ namespace gpstk {
    // Compute satellite position at the given time.
    // throw Invalid Request if the required data has not been stored.
    Xvt OrbitEph::svXvt(const CommonTime& t) const
+   {
+      Constants c;
+      prepare(c);
+      return svXvt(c, t);
+   }
+
+   // Compute the time independent quantities used by svXvt().
+   // throw Invalid Request if the required data has not been stored.
+   void OrbitEph::prepare(Constants& c) const
+   {
+      if(!dataLoadedFlag)
+         GPSTK_THROW(InvalidRequest("Data not loaded"));
+
+      GPSEllipsoid ell;
+      c.sqrtgm = SQRT(ell.gm());
+      c.Ahalf = SQRT(A);                  // A is semi-major axis of orbit
+      c.n0 = c.sqrtgm / (A*c.Ahalf);      // Eqn specifies A0, not Ak
+      c.q = SQRT(1.0e0 - ecc*ecc);
+      c.ToeSOW = GPSWeekSecond(ctToe).sow; // SOW is time-system-independent
+      c.omegaE = ell.angVelocity();
+   }
+
+   // Compute satellite position at the given time, using the quantities
+   // computed by prepare().
+   // throw Invalid Request if the required data has not been stored.
+   Xvt OrbitEph::svXvt(const Constants& c, const CommonTime& t) const
    {
       if(!dataLoadedFlag)
          GPSTK_THROW(InvalidRequest("Data not loaded"));
 
       Xvt sv;
-      double ea;              // eccentric anomaly
-      double delea;           // delta eccentric anomaly during iteration
-      double elapte;          // elapsed time since Toe
-      //double elaptc;          // elapsed time since Toc
-      //double dtc,dtr;
-      double q,sinea,cosea;
-      double GSTA,GCTA;
-      double amm;
-      double meana;           // mean anomaly
-      double F,G;             // temporary real variables
-      double alat,talat,c2al,s2al,du,dr,di,U,R,truea,AINC;
-      double ANLON,cosu,sinu,xip,yip,can,san,cinc,sinc;
-      double xef,yef,zef,dek,dlk,div,domk,duv,drv;
-      double dxp,dyp,vxef,vyef,vzef;
+      double amm, ea;
+      int idx;
 
-      GPSEllipsoid ell;
-      double sqrtgm = SQRT(ell.gm());
-      double twoPI = 2.0e0 * PI;
-      double lecc;            // eccentricity
-      double tdrinc;          // dt inclination
-      double Ahalf = SQRT(A); // A is semi-major axis of orbit
-      double ToeSOW = GPSWeekSecond(ctToe).sow;    // SOW is time-system-independent
+      // Compute time since ephemeris epoch
+      double elapte = t - ctToe;
+      double meana = meanAnomaly(c, elapte, amm);
+      solveKepler(ecc, 1, &meana, &ea, &idx);
+      completeXvt(c, t, elapte, amm, ea, sv);
+
+      return sv;
+   }
+
+   // Compute satellite positions at n times, using the quantities computed
+   // by prepare().
+   // throw Invalid Request if the required data has not been stored.
+   void OrbitEph::svXvt(const Constants& c, int n, const CommonTime *t,
+                        Xvt *sv) const
+   {
+      if(!dataLoadedFlag)
+         GPSTK_THROW(InvalidRequest("Data not loaded"));
 
-      lecc = ecc;
-      tdrinc = idot;
+      if(n <= 0) return;
 
-      // Compute time since ephemeris & clock epochs
-      elapte = t - ctToe;
+      vector<double> elapte(n), amm(n), meana(n), ea(n);
+      vector<int> idx(n);
 
-      // Compute A at time of interest (LNAV: Adot==0)
-      double Ak = A + Adot * elapte;
+      for(int i=0; i<n; i++) {
+         elapte[i] = t[i] - ctToe;
+         meana[i] = meanAnomaly(c, elapte[i], amm[i]);
+      }
+
+      solveKepler(ecc, n, &meana[0], &ea[0], &idx[0]);
+
+      for(int i=0; i<n; i++)
+         completeXvt(c, t[i], elapte[i], amm[i], ea[i], sv[i]);
+   }
+
+   // Solve Kepler's equation for n mean anomalies together.
+   void OrbitEph::solveKepler(double ecc, int n, const double *meana,
+                              double *ea, int *idx)
+   {
+      for(int i=0; i<n; i++) {
+         ea[i] = meana[i] + ecc * ::sin(meana[i]);
+         idx[i] = i;
+      }
+
+      // at most 20 iterations, as in svRelativity(); the anomalies that
+      // have converged drop out of the index list
+      int active = n;
+      for(int loop_cnt = 1; active > 0 && loop_cnt <= 20; loop_cnt++) {
+         int still = 0;
+         for(int k=0; k<active; k++) {
+            int i = idx[k];
+            double F = meana[i] - (ea[i] - ecc * ::sin(ea[i]));
+            double G = 1.0 - ecc * ::cos(ea[i]);
+            double delea = F/G;
+            ea[i] = ea[i] + delea;
+            if(fabs(delea) > 1.0e-11) idx[still++] = i;
+         }
+         active = still;
+      }
+   }
+
+   // Mean anomaly, and mean motion, at elapte seconds from Toe.
+   double OrbitEph::meanAnomaly(const Constants& c, double elapte,
+                                double& amm) const
+   {
+      double twoPI = 2.0e0 * PI;
 
       // Compute mean motion (LNAV: dndot==0)
       double dnA = dn + 0.5*dndot*elapte;
-      amm  = (sqrtgm / (A*Ahalf)) + dnA;     // Eqn specifies A0, not Ak
+      amm  = c.n0 + dnA;
 
       // In-plane angles
       //     meana - Mean anomaly
       //     ea    - Eccentric anomaly
       //     truea - True anomaly
-      meana = M0 + elapte * amm;
-      meana = fmod(meana, twoPI);
-      ea = meana + lecc * ::sin(meana);
+      double meana = M0 + elapte * amm;
+      return fmod(meana, twoPI);
+   }
 
-      int loop_cnt = 1;
-      do  {
-         F = meana - (ea - lecc * ::sin(ea));
-         G = 1.0 - lecc * ::cos(ea);
-         delea = F/G;
-         ea = ea + delea;
-         loop_cnt++;
-      } while ((fabs(delea) > 1.0e-11) && (loop_cnt <= 20));
+   // Complete the Xvt at time t, once the eccentric anomaly is known.
+   void OrbitEph::completeXvt(const Constants& c, const CommonTime& t,
+                              double elapte, double amm, double ea,
+                              Xvt& sv) const
+   {
+      double q,sinea,cosea;
+      double GSTA,GCTA;
+      double G;               // temporary real variable
+      double alat,talat,c2al,s2al,du,dr,di,U,R,truea,AINC;
+      double ANLON,cosu,sinu,xip,yip,can,san,cinc,sinc;
+      double xef,yef,zef,dek,dlk,div,domk,duv,drv;
+      double dxp,dyp,vxef,vyef,vzef;
 
-      // Compute clock corrections
-      sv.relcorr = svRelativity(t);
-      sv.clkbias = svClockBias(t);
-      sv.clkdrift = svClockDrift(t);
-      sv.frame = ReferenceFrame::WGS84;
+      double lecc = ecc;      // eccentricity
+      double tdrinc = idot;   // dt inclination
+
+      // Compute A at time of interest (LNAV: Adot==0)
+      double Ak = A + Adot * elapte;
 
       // Compute true anomaly
-      q     = SQRT(1.0e0 - lecc*lecc);
+      q     = c.q;
       sinea = ::sin(ea);
       cosea = ::cos(ea);
       G     = 1.0e0 - lecc * cosea;
 
+      // Compute clock corrections. With no rate of mean motion (LNAV),
+      // svRelativity() would solve Kepler's equation again for the same ea.
+      if(dndot == 0.0)
+         sv.relcorr = REL_CONST * lecc * SQRT(Ak) * sinea;
+      else
+         sv.relcorr = svRelativity(t);
+      sv.clkbias = svClockBias(t);
+      sv.clkdrift = svClockDrift(t);
+      sv.frame = ReferenceFrame::WGS84;
+
       //  G*SIN(TA) AND G*COS(TA)
       GSTA  = q * sinea;
       GCTA  = cosea - lecc;
@@ -193,8 +272,8 @@ namespace gpstk {
       AINC = i0 + tdrinc * elapte  +  di;
 
       //  Longitude of ascending node (ANLON)
-      ANLON = OMEGA0 + (OMEGAdot - ell.angVelocity()) *
-              elapte - ell.angVelocity() * ToeSOW;
+      ANLON = OMEGA0 + (OMEGAdot - c.omegaE) *
+              elapte - c.omegaE * c.ToeSOW;
 
       // In plane location
       cosu = ::cos(U);
@@ -218,9 +297,9 @@ namespace gpstk {
 
       // Compute velocity of rotation coordinates
       dek = amm * Ak / R;
-      dlk = Ahalf * q * sqrtgm / (R*R);
+      dlk = c.Ahalf * q * c.sqrtgm / (R*R);
       div = tdrinc - 2.0e0 * dlk * (Cic  * s2al - Cis * c2al);
-      domk = OMEGAdot - ell.angVelocity();
+      domk = OMEGAdot - c.omegaE;
       duv = dlk*(1.e0+ 2.e0 * (Cus*c2al - Cuc*s2al));
       drv = Ak * lecc * dek * sinea - 2.e0 * dlk * (Crc * s2al - Crs * c2al);
       dxp = drv*cosu - R*sinu*duv;
@@ -237,8 +316,6 @@ namespace gpstk {
       sv.v[0] = vxef;
       sv.v[1] = vyef;
       sv.v[2] = vzef;
-
-      return sv;
    }
 
    // Compute satellite relativity correction (sec) at the given time
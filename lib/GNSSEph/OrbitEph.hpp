@@ -119,6 +119,43 @@ namespace gpstk
       /// @throw Invalid Request if the required data has not been stored.
       Xvt svXvt(const CommonTime& t) const;
 
+      /// Quantities of the orbit that do not depend on time. prepare() computes
+      /// them once, and the svXvt() functions taking them then evaluate any
+      /// number of times without computing them again.
+      struct Constants
+      {
+         double sqrtgm;    ///< Square root of GM (m**1.5/sec)
+         double Ahalf;     ///< Square root of the semi-major axis (m**0.5)
+         double n0;        ///< Computed mean motion (rad/sec)
+         double q;         ///< Square root of (1 - ecc**2)
+         double ToeSOW;    ///< Seconds of week of Toe
+         double omegaE;    ///< Earth rotation rate (rad/sec)
+      };
+
+      /// Compute the time independent quantities used by svXvt().
+      /// @throw Invalid Request if the required data has not been stored.
+      void prepare(Constants& c) const;
+
+      /// Compute satellite position at the given time, using the quantities
+      /// computed by prepare(). The result is the same as svXvt(t).
+      /// @throw Invalid Request if the required data has not been stored.
+      Xvt svXvt(const Constants& c, const CommonTime& t) const;
+
+      /// Compute satellite positions at n times t[0..n-1] into sv[0..n-1],
+      /// using the quantities computed by prepare(). Kepler's equation is
+      /// solved for all the times together; each result is the same as
+      /// svXvt(t[i]).
+      /// @throw Invalid Request if the required data has not been stored.
+      void svXvt(const Constants& c, int n, const CommonTime *t, Xvt *sv) const;
+
+      /// Solve Kepler's equation for the eccentric anomalies ea[0..n-1] of
+      /// the mean anomalies meana[0..n-1]. Each solution takes the same
+      /// iterations as when solved alone, but every iteration runs over all
+      /// the anomalies not yet converged, with no dependency between them.
+      /// @param idx workspace of n ints
+      static void solveKepler(double ecc, int n, const double *meana,
+                              double *ea, int *idx);
+
       /// Compute satellite relativity correction (sec) at the given time
       /// @throw Invalid Request if the required data has not been stored.
       double svRelativity(const CommonTime& t) const;
@@ -167,6 +204,17 @@ namespace gpstk
       /// @return true if OrbitEph was defined, false otherwise
       //virtual bool load(const Rinex3NavData& rnd);
 
+   protected:
+
+      /// Mean anomaly, and mean motion, at elapte seconds from Toe.
+      double meanAnomaly(const Constants& c, double elapte, double& amm) const;
+
+      /// Complete the Xvt at time t, once the eccentric anomaly ea is known.
+      void completeXvt(const Constants& c, const CommonTime& t, double elapte,
+                       double amm, double ea, Xvt& sv) const;
+
+   public:
+
    // member data
      
       // overhead
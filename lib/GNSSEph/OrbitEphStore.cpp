@@ -46,6 +46,10 @@
 #include <fstream>
 #include <iomanip>
 
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
 #include "StringUtils.hpp"
 #include "MathBase.hpp"
 #include "CivilTime.hpp"
@@ -64,7 +68,8 @@ namespace gpstk
    {
       try {
          // get the appropriate OrbitEph
-         const OrbitEph *eph = findOrbitEph(sat,t);
+         CurrentEph cur;
+         const OrbitEph *eph = findPreparedOrbitEph(sat,t,cur);
          if(!eph)
             GPSTK_THROW(InvalidRequest("No OrbitEph for satellite " + asString(sat)));
 
@@ -74,12 +79,177 @@ namespace gpstk
             GPSTK_THROW(InvalidRequest("Not healthy"));
 
          // compute the position, velocity and time
-         Xvt sv = eph->svXvt(t);
+         Xvt sv = eph->svXvt(cur.constants,t);
          return sv;
       }
       catch(InvalidRequest& ir) { GPSTK_RETHROW(ir); }
    }
 
+   //---------------------------------------------------------------------------------
+   void OrbitEphStore::getXvt(const vector<SatID>& sats, const CommonTime& t,
+                              vector<Xvt>& xvt, vector<bool>& valid) const
+   {
+      xvt.resize(sats.size());
+      valid.assign(sats.size(), false);
+
+      for(size_t i=0; i<sats.size(); i++) {
+         CurrentEph cur;
+         const OrbitEph *eph = findPreparedOrbitEph(sats[i],t,cur);
+         if(!eph || (onlyHealthy && !eph->isHealthy()))
+            continue;
+
+         xvt[i] = eph->svXvt(cur.constants,t);
+         valid[i] = true;
+      }
+   }
+
+   //---------------------------------------------------------------------------------
+   void OrbitEphStore::getXvt(const SatID& sat, const vector<CommonTime>& times,
+                              vector<Xvt>& xvt, vector<bool>& valid) const
+   {
+      size_t n(times.size());
+      xvt.resize(n);
+      valid.assign(n, false);
+
+      size_t i(0);
+      while(i < n) {
+         CurrentEph cur;
+         const OrbitEph *eph = findPreparedOrbitEph(sat,times[i],cur);
+         if(!eph || (onlyHealthy && !eph->isHealthy())) {
+            i++;
+            continue;
+         }
+
+         // extend the run over the following times with the same ephemeris
+         size_t j(i+1);
+         if(strictMethod) {
+            while(j < n && cur.after < times[j] && times[j] <= cur.upTo
+                        && eph->isValid(times[j]))
+               j++;
+         }
+         else {
+            while(j < n && findNearOrbitEph(sat,times[j]) == eph)
+               j++;
+         }
+
+         eph->svXvt(cur.constants, int(j-i), &times[i], &xvt[i]);
+         for(size_t k=i; k<j; k++)
+            valid[k] = true;
+
+         i = j;
+      }
+   }
+
+   //---------------------------------------------------------------------------------
+   // Find the ephemeris getXvt() uses for sat at t, and prepare it. With the
+   // 'user' search method, the table is only searched when t is out of the
+   // span of the current ephemeris of the satellite; the result is the same
+   // as findUserOrbitEph().
+   const OrbitEph* OrbitEphStore::findPreparedOrbitEph(const SatID& sat,
+                                                       const CommonTime& t,
+                                                       CurrentEph& cur) const
+   {
+      if(!strictMethod) {
+         const OrbitEph *eph = findNearOrbitEph(sat,t);
+         if(eph) {
+            cur.eph = eph;
+            eph->prepare(cur.constants);
+         }
+         return eph;
+      }
+
+      // A frozen store keeps the current ephemerides of each thread of a
+      // parallel region apart. Thread numbers are only unique within the
+      // team of a single parallel region, hence the test on the level.
+      map<SatID, CurrentEph> *mine(0);
+#ifdef _OPENMP
+      if(frozen && omp_get_level() == 1 && omp_in_parallel()) {
+         size_t thread(omp_get_thread_num());
+         if(thread < threadEph.size())
+            mine = &threadEph[thread];
+      }
+#endif
+
+      bool found(false);
+      if(mine) {
+         map<SatID, CurrentEph>::const_iterator it = mine->find(sat);
+         if(it != mine->end() &&
+            it->second.after < t && t <= it->second.upTo) {
+            cur = it->second;
+            found = true;
+         }
+      }
+      else if(!frozen) {
+         // Nothing may throw out of the critical section; if comparing the
+         // times fails, the search below will throw the same exception.
+#ifdef _OPENMP
+#pragma omp critical(OrbitEphStoreCurrent)
+#endif
+         {
+            try {
+               map<SatID, CurrentEph>::const_iterator it = currentEph.find(sat);
+               if(it != currentEph.end() &&
+                  it->second.after < t && t <= it->second.upTo) {
+                  cur = it->second;
+                  found = true;
+               }
+            }
+            catch(...) { found = false; }
+         }
+      }
+
+      if(!found) {
+         SatTableMap::const_iterator st = satTables.find(sat);
+         if(st == satTables.end())
+            return NULL;
+
+         // As in findUserOrbitEph(): the ephemeris used is the last one with
+         // key before t, and the next key ends its span
+         const TimeOrbitEphTable& table = st->second;
+         TimeOrbitEphTable::const_iterator next = table.lower_bound(t);
+         if(next == table.begin())
+            return NULL;
+
+         TimeOrbitEphTable::const_iterator it = next;
+         it--;
+
+         cur.eph = it->second;
+         cur.after = it->first;
+         cur.upTo = (next == table.end() ? CommonTime::END_OF_TIME : next->first);
+         cur.eph->prepare(cur.constants);
+
+         if(mine) {
+            (*mine)[sat] = cur;
+         }
+         else if(!frozen) {
+#ifdef _OPENMP
+#pragma omp critical(OrbitEphStoreCurrent)
+#endif
+            {
+               currentEph[sat] = cur;
+            }
+         }
+      }
+
+      // there may be a "hole" in the middle of the map
+      if(!cur.eph->isValid(t))
+         return NULL;
+
+      return cur.eph;
+   }
+
+   //---------------------------------------------------------------------------------
+   // Give each thread of a parallel region its own current ephemerides
+   void OrbitEphStore::freeze(void)
+   {
+#ifdef _OPENMP
+      threadEph.assign(omp_get_max_threads(), map<SatID, CurrentEph>());
+#else
+      threadEph.clear();
+#endif
+      frozen = true;
+   }
+
    //---------------------------------------------------------------------------------
    void OrbitEphStore::dump(ostream& os, short detail) const
    {
@@ -193,6 +363,7 @@ namespace gpstk
    OrbitEph* OrbitEphStore::addEphemeris(const OrbitEph* eph)
    {
       OrbitEph *ret(0);
+      clearCurrentEph();
       try {
          // is the satellite found in the table? If not, create one
          if(satTables.find(eph->satID) == satTables.end()) {
@@ -292,6 +463,8 @@ namespace gpstk
    //---------------------------------------------------------------------------------
    void OrbitEphStore::edit(const CommonTime& tmin, const CommonTime& tmax)
    {
+      clearCurrentEph();
+
       for(SatTableMap::iterator i = satTables.begin(); i != satTables.end(); i++)
       {
          TimeOrbitEphTable& eMap = i->second;
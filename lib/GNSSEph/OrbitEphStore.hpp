@@ -47,6 +47,8 @@
 
 #include <iostream>
 #include <list>
+#include <map>
+#include <vector>
 
 #include "OrbitEph.hpp"
 #include "Exception.hpp"
@@ -75,7 +77,7 @@ namespace gpstk
       OrbitEphStore()
          : initialTime(CommonTime::END_OF_TIME), 
            finalTime(CommonTime::BEGINNING_OF_TIME),
-           strictMethod(true), onlyHealthy(false)
+           strictMethod(true), onlyHealthy(false), frozen(false)
       {
          timeSystem = TimeSystem::Any;
          initialTime.setTimeSystem(timeSystem);
@@ -98,6 +100,27 @@ namespace gpstk
       ///        orbit elements at time t.
       virtual Xvt getXvt(const SatID& id, const CommonTime& t) const;
 
+      /// Compute the Xvt of each of the given satellites at the same time.
+      /// Satellites for which getXvt(sat,t) would throw InvalidRequest
+      /// (no ephemeris, or not healthy) are flagged invalid instead.
+      /// @param[in] sats satellites of interest
+      /// @param[in] t the time to look up
+      /// @param[out] xvt the Xvt of each satellite, in the order of sats
+      /// @param[out] valid true where xvt holds a result
+      void getXvt(const std::vector<SatID>& sats, const CommonTime& t,
+                  std::vector<Xvt>& xvt, std::vector<bool>& valid) const;
+
+      /// Compute the Xvt of one satellite at each of the given times. The
+      /// consecutive times that use the same ephemeris are computed together.
+      /// Times for which getXvt(sat,t) would throw InvalidRequest are flagged
+      /// invalid instead.
+      /// @param[in] sat satellite of interest
+      /// @param[in] times the times to look up
+      /// @param[out] xvt the Xvt at each time, in the order of times
+      /// @param[out] valid true where xvt holds a result
+      void getXvt(const SatID& sat, const std::vector<CommonTime>& times,
+                  std::vector<Xvt>& xvt, std::vector<bool>& valid) const;
+
       /// Output summary of store data in human readable form, with detail:
       ///  0: Time limits and number of entries for entire store
       ///  1: Level 0 plus for each satellite: one line giving number and time limits
@@ -126,6 +149,7 @@ namespace gpstk
          } 
 
          satTables.clear();
+         clearCurrentEph();
 
          initialTime = CommonTime::END_OF_TIME;
          initialTime.setTimeSystem(timeSystem);
@@ -202,6 +226,18 @@ namespace gpstk
       virtual TimeSystem getTimeSystem(void) const
       { return timeSystem; }
 
+      /// Prepare the store to be queried from several threads at once. Each
+      /// thread of an OpenMP parallel region then keeps its own current
+      /// ephemerides, and getXvt() takes no lock; queries made outside a
+      /// parallel region, or within a nested one, search the tables without
+      /// the cache. Adding, editing or clearing ephemerides thaws the store.
+      /// See XvtStore::freeze().
+      virtual void freeze(void);
+
+      /// Return true if the store was frozen, and not changed since.
+      virtual bool isFrozen(void) const
+      { return frozen; }
+
       //---------------------------------------------------------------
       // This ends the XvtStore<SatID> interface. Below are interfaces that are
       // unique to this class (i.e. not in the parent class XvtStore<SatID>)
@@ -348,6 +384,45 @@ namespace gpstk
       /// otherwise it will throw (default false)
       bool onlyHealthy;
 
+      /// The ephemeris last found by findUserOrbitEph() for a satellite, with
+      /// its prepared constants. The same ephemeris is found for every time
+      /// in (after, upTo], as long as it is valid at that time.
+      struct CurrentEph
+      {
+         const OrbitEph *eph;             ///< the ephemeris, owned by satTables
+         CommonTime after;                ///< key of the ephemeris in the table
+         CommonTime upTo;                 ///< key of the next one, if any
+         OrbitEph::Constants constants;   ///< from eph->prepare()
+      };
+
+      /// The current ephemeris of each satellite. It saves the table lookup
+      /// and the preparation of the ephemeris while time moves on within its
+      /// validity. Shared by all the threads using the store, so it is only
+      /// accessed within a critical section, and not at all while the store
+      /// is frozen.
+      mutable std::map<SatID, CurrentEph> currentEph;
+
+      /// True from freeze() until satTables is changed
+      bool frozen;
+
+      /// The current ephemerides of each thread of a parallel region, used
+      /// instead of currentEph while the store is frozen. Thread i only
+      /// touches threadEph[i], so no lock is needed.
+      mutable std::vector< std::map<SatID, CurrentEph> > threadEph;
+
+      /// Forget the current ephemerides, and thaw the store; must be called
+      /// whenever satTables is changed.
+      void clearCurrentEph(void)
+      { currentEph.clear(); threadEph.clear(); frozen = false; }
+
+      /// Find the ephemeris getXvt() uses for satellite sat at time t, with
+      /// the current search method, and prepare it.
+      /// @param cur the ephemeris and its constants; when the search method is
+      ///        findUserOrbitEph(), also the times over which it is the same
+      /// @return the ephemeris, or NULL if none is found.
+      const OrbitEph* findPreparedOrbitEph(const SatID& sat, const CommonTime& t,
+                                           CurrentEph& cur) const;
+
       /// Convenience routines
       void updateTimeLimits(const OrbitEph* eph)
       {
@@ -196,6 +196,21 @@ namespace gpstk
       virtual bool hasVelocity(void) const
          { return true; }
 
+      /// Prepare the store to be queried from several threads at once, by
+      /// freezing the system stores; loading a file or adding data thaws
+      /// them. The time system corrections must not be changed while the
+      /// store is shared. See XvtStore::freeze().
+      virtual void freeze(void)
+      {
+         ORBstore.freeze();
+         GLOstore.freeze();
+         //GEOstore.freeze();
+      }
+
+      /// Return true if the system stores are frozen
+      virtual bool isFrozen(void) const
+         { return ORBstore.isFrozen() && GLOstore.isFrozen(); }
+
    // end of XvtStore interface
 
       /// Determine the earliest time for which this object can successfully 
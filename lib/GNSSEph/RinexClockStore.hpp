@@ -26,7 +26,8 @@ namespace gpstk
 
    /// Store a table of data vs time for each of several satellites using data from
    /// RINEX clock files. Most of the functionality is in ClockSatStore and
-   /// TabularSatStore.
+   /// TabularSatStore. Once the files are loaded, clock queries may be made
+   /// from several threads at once, see TabularSatStore.
    class RinexClockStore : public ClockSatStore
    {
 
@@ -179,6 +180,7 @@ namespace gpstk
          // close
          strm.close();
 
+         return true;
       }
       catch(Exception& e) { GPSTK_RETHROW(e); }
 
@@ -112,6 +112,25 @@ namespace gpstk
       /// Return true if the given IndexType is present in the store
       virtual bool isPresent(const IndexType& id) const = 0;
 
+      /// Prepare the store to be queried from several threads at once, once
+      /// all the data are loaded. Whatever the queries would otherwise
+      /// compute and keep the first time they need it is computed here, and
+      /// caches kept between queries are made private to each thread.
+      /// Until the store is changed again (data added, edited or cleared),
+      /// getXvt() and the other const queries may then be called
+      /// concurrently without any lock; the settings of the store must not
+      /// be changed while it is shared. Changing the data thaws the store,
+      /// which stays usable from one thread, and freeze() may be called
+      /// again afterwards.
+      virtual void freeze(void)
+      {}
+
+      /// Return true if the const queries of the store may be called from
+      /// several threads at once without locks, see freeze(). A store must
+      /// override this to promise it; the default is false.
+      virtual bool isFrozen(void) const
+      { return false; }
+
    }; // end class XvtStore
 
    //@}
@@ -68,8 +68,8 @@ namespace gpstk
       double omega_e = 7.292115E-05;  // IERS 1996 conventions
       //double omega_e = rb.getSpinRate(utc);
 
-      Vector<double> r = sc.R();   // satellite position in m
-      Vector<double> v = sc.V();   // satellite velocity in m/s
+      const Vector<double>& r = sc.R();   // satellite position in m
+      const Vector<double>& v = sc.V();   // satellite velocity in m/s
 
       const double cd = sc.getDragCoeff();
       const double area = sc.getDragArea();
@@ -85,11 +85,11 @@ namespace gpstk
       //rho  = 6.3097802844338E-12;
       
       // compute the relative velocity vector and magnitude
-      Vector<double> we(3,0.0);
+      Vector3 we;
       we(2)= omega_e;
 
-      Vector<double> wxr = cross(we,r);
-      Vector<double> vr = v - wxr;
+      Vector3 wxr = cross(we,Vector3(r));
+      Vector3 vr = Vector3(v) - wxr;
       double vrmag = norm(vr);
       
       // form -1/2 (Cd*A/m) rho
@@ -103,17 +103,15 @@ namespace gpstk
 
       // form partial of drag wrt v  
       // da_dv = -0.5*Cd*(A/M)*p*(vr*transpose(vr)/vr+vr1)
-      Matrix<double> tr(3,1,0.0);
+      FixedMatrix<double,3,1> tr;
       tr(0,0)=vr(0);
       tr(1,0)=vr(1);
       tr(2,0)=vr(2);
 
-      Matrix<double> vrvrt = tr*transpose(tr); 
+      Matrix3 vrvrt = tr*transpose(tr); 
       vrvrt = vrvrt / vrmag;
       
-      double eye3[3*3] = {1,0,0,0,1,0,0,0,1};
-      Matrix<double> vrm(3,3,0.0);
-      vrm = eye3;
+      Matrix3 vrm = Matrix3::identity();
 
       vrm = vrm * vrmag;
       da_dv = (vrvrt + vrm) * coeff;               //////// da_dv
@@ -122,7 +120,7 @@ namespace gpstk
       // da_dr = -0.5*Cd*(A/M)*vr*dp_dr-da_dv*X(w)
       da_dr.resize(3,3,0.0);
 
-      Matrix<double> X(3,3,0.0);
+      Matrix3 X;
       X(0,1) = -we(2);      // -wz
       X(0,2) = +we(1);      //  wy
       X(1,0) = +we(2);      // +wz
@@ -130,8 +128,8 @@ namespace gpstk
       X(2,0) = -we(1);      // -wy
       X(2,1) = +we(0);      // +wx
       
-      Matrix<double> part1(3,3,0.0);
-      Matrix<double> part2(3,3,0.0);
+      Matrix3 part1;
+      Matrix3 part2;
       
    
       // Get the J2000 to TOD transformation
@@ -166,9 +164,9 @@ namespace gpstk
       double Hh = H[bracket];
       double coeff4 = -1.0 / (Hh * rmag);
 
-      Vector<double> drhodr = r*coeff4;
+      Vector3 drhodr = Vector3(r)*coeff4;
       
-      Matrix<double> tr2(3,1,0.0);
+      FixedMatrix<double,3,1> tr2;
       tr2(0,0) = drhodr(0);
       tr2(1,0) = drhodr(1);
       tr2(2,0) = drhodr(2);
@@ -69,7 +69,7 @@ namespace gpstk
           * @param v Velocity vector
           * @return Atmospheric density in kg/m^3
           */
-      virtual double computeDensity(UTCTime t, EarthBody& rb, Vector<double> r,Vector<double> v) = 0;
+      virtual double computeDensity(UTCTime t, EarthBody& rb, const Vector<double>& r, const Vector<double>& v) = 0;
       
 
          /// Return force model name
@@ -93,7 +93,7 @@ namespace gpstk
       double dailyKp;
 
          /// dadcd
-      Vector<double> dadcd;
+      Vector3 dadcd;
 
          // Constant
       enum CiraSize{ CIRA_SIZE = 24 };
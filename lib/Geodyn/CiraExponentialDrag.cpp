@@ -75,8 +75,8 @@ namespace gpstk
        */
    double CiraExponentialDrag::computeDensity(UTCTime utc, 
                                               EarthBody& rb,
-                                              Vector<double> r, 
-                                              Vector<double> v)
+                                              const Vector<double>& r, 
+                                              const Vector<double>& /*v*/)
    {
       // Get the J2000 to TOD transformation
       Matrix<double> N = ReferenceFrames::J2kToTODMatrix(utc);
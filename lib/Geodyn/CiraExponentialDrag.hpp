@@ -71,8 +71,8 @@ namespace gpstk
           */
       virtual double computeDensity(UTCTime utc, 
                                     EarthBody& rb, 
-                                    Vector<double> r, 
-                                    Vector<double> v);
+                                    const Vector<double>& r, 
+                                    const Vector<double>& v);
 
    protected:
 
@@ -63,6 +63,20 @@ namespace gpstk
           */
       virtual Vector<double> getDerivatives(const double& t, const Vector<double>& y) = 0;
 
+         /** Compute the derivatives into 'dydt', which is resized as
+          *  needed. Integrators call this at every stage with the same
+          *  'dydt', so an equation of motion that overrides it, and keeps
+          *  its own work space, runs without allocating. The default
+          *  just copies the result of the method above.
+          * @params t    time or the independent variable.
+          * @params y    the required data.
+          * @params dydt the derivatives.
+          */
+      virtual void getDerivatives( const double& t,
+                                   const Vector<double>& y,
+                                   Vector<double>& dydt )
+      { dydt = getDerivatives(t, y); }
+
 
    }; // End of class 'EquationOfMotion'
 
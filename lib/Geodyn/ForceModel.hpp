@@ -52,6 +52,8 @@
 
 #include "Vector.hpp"
 #include "Matrix.hpp"
+#include "FixedVector.hpp"
+#include "FixedMatrix.hpp"
 #include "Spacecraft.hpp"
 #include "EarthBody.hpp"
 
@@ -138,21 +140,21 @@ namespace gpstk
           * Return the acceleration
           * @return  acceleration
           */
-      virtual Vector<double> getAccel() const
+      virtual const Vector3& getAccel() const
       { return a; }
 
          /**
           * Return the partial derivative of acceleration wrt position
-          * @return Matrix containing the partial derivative of acceleration wrt velocity
+          * @return Matrix containing the partial derivative of acceleration wrt position
           */
-      virtual Matrix<double> partialR() const
+      virtual const Matrix3& partialR() const
       { return da_dr; }
 
          /**
           * Return the partial derivative of acceleration wrt velocity
           * @return Matrix containing the partial derivative of acceleration wrt velocity
           */
-      virtual Matrix<double> partialV() const
+      virtual const Matrix3& partialV() const
       { return da_dv; }
 
          /**
@@ -166,14 +168,14 @@ namespace gpstk
           * Return the partial derivative of acceleration wrt velocity
           * @return Matrix containing the partial derivative of acceleration wrt cd
           */
-      virtual Matrix<double> partialCd() const
+      virtual const FixedMatrix<double,3,1>& partialCd() const
       { return da_dcd; } 
 
          /**
           * Return the partial derivative of acceleration wrt velocity
           * @return Matrix containing the partial derivative of acceleration wrt cr
           */
-      virtual Matrix<double> partialCr() const
+      virtual const FixedMatrix<double,3,1>& partialCr() const
       { return da_dcr; }
 
          /** return number of np
@@ -253,23 +255,26 @@ namespace gpstk
 
    protected:
 
+         // The 3-vector and 3x3 members are of fixed size, so that the
+         // force models fill them without allocating at every step.
+
          /// Acceleration
-      Vector<double> a;         // 3
+      Vector3 a;
       
          /// Partial derivative of acceleration wrt position
-      Matrix<double> da_dr;      // 3*3
+      Matrix3 da_dr;
       
          /// Partial derivative of acceleration wrt velocity
-      Matrix<double> da_dv;      // 3*3
+      Matrix3 da_dv;
       
          /// Partial derivative of acceleration wrt dynamic parameters
       Matrix<double> da_dp;      // 3*np
          
          /// Partial derivative of acceleration wrt Cd
-      Matrix<double> da_dcd;      // 3*1
+      FixedMatrix<double,3,1> da_dcd;
          
          /// Partial derivative of acceleration wrt Cr
-      Matrix<double> da_dcr;      // 3*1
+      FixedMatrix<double,3,1> da_dcr;
 
       
 
@@ -284,9 +289,9 @@ namespace gpstk
    inline std::ostream& operator<<( std::ostream& s,
                                     const gpstk::ForceModel& fm )
    {
-      Vector<double> a = fm.getAccel();
-      Matrix<double> da_dr = fm.partialR();
-      Matrix<double> da_dv = fm.partialV();
+      const Vector3& a = fm.getAccel();
+      const Matrix3& da_dr = fm.partialR();
+      const Matrix3& da_dv = fm.partialV();
       Matrix<double> da_dp = fm.partialP();
 
       s<<"a ["<<a.size()<<"]\n{\n"
@@ -44,6 +44,20 @@ namespace gpstk
 
       // interface implementation for the 'ForceModel'
    Vector<double> ForceModelList::getDerivatives(UTCTime utc, EarthBody& bref, Spacecraft& sc)
+   {
+      Vector<double> dy;
+      getDerivatives(utc, bref, sc, dy);
+
+      return dy;
+
+   }  // End of method 'ForceModelList::getDerivatives()'
+
+
+      // As above, writing the derivatives to 'dy'
+   void ForceModelList::getDerivatives( UTCTime utc,
+                                        EarthBody& bref,
+                                        Spacecraft& sc,
+                                        Vector<double>& dy )
    {
       const int np = setFMT.size(); //getNP();
 
@@ -101,6 +115,13 @@ namespace gpstk
          i++;
       }  
 
+      if(sc.getNumOfP() != np)
+      {
+         Exception e("Error in ForceModelList::getDerivatives():"
+                     "spacecraft and force model parameters differ");
+         GPSTK_THROW(e);
+      }
+
       /* Transition Matrix (6+np)*(6+np)
            |                          |
            | dr_dr0   dr_dv0   dr_dp0  |
@@ -109,10 +130,8 @@ namespace gpstk
            |                          |
            | 0         0          I      |
            |                          |
-      */
-      Matrix<double> phi = sc.getTransitionMatrix();
 
-      /* A Matrix (6+np)*(6+np)
+         A Matrix (6+np)*(6+np)
           |                       |
           | 0         I      0      |
           |                       |
@@ -120,10 +139,8 @@ namespace gpstk
           |                       |
           | 0         0      0      |
           |                       |
-      */
-      Matrix<double> A = getAMatrix();
-      
-      /* dphi Matrix
+
+         dphi Matrix
              |                          |
              | dv_dr0   dv_dv0   dv_dp0 |
              |                          |
@@ -137,14 +154,15 @@ namespace gpstk
       da_dv0 = da_dr*dr_dv0 + da_dv*dv_dv0
 
       da_dp0 = da_dr*dr_dp0 + da_dv*dv_dp0 + da_dp0;
+
+      dphi = A * phi is not formed; the elements needed are computed from
+      the blocks of phi held by the spacecraft, in the same order of
+      summation as the matrix product.
       */
-      Matrix<double> dphi = A * phi;
 
+      const Vector<double>& v = sc.V();
 
-      Vector<double> r = sc.R();
-      Vector<double> v = sc.V();
-      
-      gpstk::Vector<double> dy(42+6*np,0.0);   //////////////////////////////////////////////////////////////////////////
+      dy.resize(42+6*np);
 
       dy(0) = v(0);      // v
       dy(1) = v(1);
@@ -157,23 +175,68 @@ namespace gpstk
       {
          for(int j=0;j<3;j++)
          {
-            dy(6+i*3+j) = dphi(i,j);            // dv_dr0
-            dy(15+i*3+j) = dphi(i,j+3);         // dv_dv0
-            dy(24+3*np+i*3+j) = dphi(i+3,j);    // da_dr0
-            dy(33+3*np+i*3+j) = dphi(i+3,j+3);  // da_dv0   
+            dy(6+i*3+j) = transition(sc,np,i+3,j);          // dv_dr0
+            dy(15+i*3+j) = transition(sc,np,i+3,j+3);       // dv_dv0
+            dy(24+3*np+i*3+j) = accelTransition(sc,np,i,j);    // da_dr0
+            dy(33+3*np+i*3+j) = accelTransition(sc,np,i,j+3);  // da_dv0
          }
          for(int k=0;k<np;k++)
          {
-            dy(24+i*np+k) = dphi(i,i*np+k);         // dv_dp0
-            dy(42+3*np+i*np+k) = dphi(i+3,i*np+k);  // da_dp0
+            dy(24+i*np+k) = transition(sc,np,i+3,i*np+k);         // dv_dp0
+            dy(42+3*np+i*np+k) = accelTransition(sc,np,i,i*np+k); // da_dp0
          }
       }
 
-      return dy;
-
    }  // End of method 'ForceModelList::getDerivatives()'
 
 
+      // Element (row,col) of the transition matrix phi of 'sc'
+   double ForceModelList::transition( const Spacecraft& sc,
+                                      int np,
+                                      int row,
+                                      int col ) const
+   {
+      if(row >= 6) return (row == col) ? 1.0 : 0.0;
+
+      const int i = row % 3;
+
+      if(col < 3)
+         return (row < 3) ? sc.dR_dR0()(3*i+col) : sc.dV_dR0()(3*i+col);
+
+      if(col < 6)
+         return (row < 3) ? sc.dR_dV0()(3*i+col-3) : sc.dV_dV0()(3*i+col-3);
+
+      return (row < 3) ? sc.dR_dP0()(i*np+col-6) : sc.dV_dP0()(i*np+col-6);
+
+   }  // End of method 'ForceModelList::transition()'
+
+
+      // Element (3+i,col) of dphi = A * phi
+   double ForceModelList::accelTransition( const Spacecraft& sc,
+                                           int np,
+                                           int i,
+                                           int col ) const
+   {
+      double sum(0.0);
+
+      for(int k=0;k<3;k++)
+      {
+         sum += da_dr(i,k)*transition(sc,np,k,col);
+      }
+      for(int k=0;k<3;k++)
+      {
+         sum += da_dv(i,k)*transition(sc,np,k+3,col);
+      }
+      if(col >= 6)
+      {
+         sum += da_dp(i,col-6);
+      }
+
+      return sum;
+
+   }  // End of method 'ForceModelList::accelTransition()'
+
+
    void ForceModelList::printForceModel(std::ostream& s)
    {
       // a counter
@@ -79,6 +79,14 @@ namespace gpstk
 
          /// interface implementation for the 'ForceModel'
       virtual Vector<double> getDerivatives(UTCTime utc, EarthBody& bref, Spacecraft& sc);
+
+         /** As above, but the derivatives are written to 'dy', which is
+          *  resized as needed; once 'dy' has its size nothing is allocated.
+          */
+      void getDerivatives( UTCTime utc,
+                           EarthBody& bref,
+                           Spacecraft& sc,
+                           Vector<double>& dy );
       
 
       void setForceModelType(std::set<ForceModel::ForceModelType> fmt);
@@ -97,6 +105,17 @@ namespace gpstk
 
    protected:
 
+         /// Element (row,col) of the transition matrix of 'sc', as given
+         /// by Spacecraft::getTransitionMatrix()
+      double transition(const Spacecraft& sc, int np, int row, int col) const;
+
+         /// Element (3+i,col) of the product of getAMatrix() and the
+         /// transition matrix of 'sc'
+      double accelTransition( const Spacecraft& sc,
+                              int np,
+                              int i,
+                              int col ) const;
+
          /// List of forces
       list<ForceModel*> forceList;
 
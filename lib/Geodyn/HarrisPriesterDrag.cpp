@@ -797,8 +797,8 @@ namespace gpstk
        */
    double HarrisPriesterDrag::computeDensity( UTCTime utc, 
                                               EarthBody& rb, 
-                                              Vector<double> r, 
-                                              Vector<double> v)
+                                              const Vector<double>& r, 
+                                              const Vector<double>& v)
    {
       double density = 0.0;
       
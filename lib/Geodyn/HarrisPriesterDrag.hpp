@@ -70,7 +70,7 @@ namespace gpstk
           * @param v   Velocity vector
           * @return Atmospheric density in kg/m^3
           */
-      virtual double computeDensity(UTCTime utc, EarthBody& rb, Vector<double> r, Vector<double> v);
+      virtual double computeDensity(UTCTime utc, EarthBody& rb, const Vector<double>& r, const Vector<double>& v);
 
    protected:
 
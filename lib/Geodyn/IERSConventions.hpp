@@ -79,7 +79,8 @@ namespace gpstk
       /// ERP data file from STK
    void LoadSTKFile(const std::string& fileName);
 
-      /// Request EOP Data
+      /// Request EOP Data, all the fields with one interpolation. Prefer
+      /// it to the functions below when more than one field is needed.
    EOPDataStore::EOPData EOPData(const CommonTime& UTC)
       throw(InvalidRequest);
    
@@ -55,22 +55,22 @@ namespace gpstk
        * da/dr = -GM*( I/norm(r-s)^3 - 3(r-s)transpose(r-s)/norm(r-s)^5)
        */
 
-      Vector<double> r_moon = ReferenceFrames::getJ2kPosition(utc.asTDB(), SolarSystem::Moon);
+      Vector3 r_moon = ReferenceFrames::getJ2kPosition(utc.asTDB(), SolarSystem::Moon);
       
       r_moon = r_moon * 1000.0;         // from km to m
 
-      Vector<double> d = sc.R() - r_moon;
+      Vector3 d = Vector3(sc.R()) - r_moon;
       double dmag = norm(d);
       double dcubed = dmag * dmag *dmag;
 
-      Vector<double> temp1 = d / dcubed;         //  detRJ/detRJ^3
+      Vector3 temp1 = d / dcubed;         //  detRJ/detRJ^3
 
       double smag = norm(r_moon);
       double scubed = smag * smag * smag;
 
-      Vector<double> temp2 = r_moon / scubed;   //  Rj/Rj^3
+      Vector3 temp2 = r_moon / scubed;   //  Rj/Rj^3
 
-      Vector<double> sum = temp1 + temp2;
+      Vector3 sum = temp1 + temp2;
       a = sum * (-mu);                          // a
 
       // da_dr
@@ -299,8 +299,8 @@ namespace gpstk
        */
    double Msise00Drag::computeDensity(UTCTime utc, 
                                       EarthBody& rb, 
-                                      Vector<double> r, 
-                                      Vector<double> v)
+                                      const Vector<double>& r, 
+                                      const Vector<double>& /*v*/)
    {
       struct nrlmsise_output output;
       struct nrlmsise_input input; 
@@ -45,8 +45,8 @@ namespace gpstk
       const double GM = ASConstant::GM_Earth;
       const double C = ASConstant::SPEED_OF_LIGHT;
       
-      Vector<double> r = sc.R();
-      Vector<double> v = sc.V();
+      const Vector3 r = sc.R();
+      const Vector3 v = sc.V();
 
       double beta = 1.0;
       double gama = 1.0;
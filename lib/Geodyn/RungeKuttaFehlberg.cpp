@@ -197,72 +197,52 @@ namespace gpstk
       // number of variable
       const int n = y.size();
 
-      Vector<double> dydx = peom->getDerivatives(x, y);  // ak1
-      
-      Vector<double> ytemp(n,0.0) ;
+      // the 13 stages dydx, ak2 ... ak13 are kept between calls, so that
+      // no step allocates once the sizes are set
+      if(ak.size() != 13) ak.resize(13);
+      ytemp.resize(n);
 
+      Vector<double>& dydx = ak[0];
+      peom->getDerivatives(x, y, dydx);   // ak1
+      
       // ak2
-      ytemp = y + B(1,0) * h * dydx ;
-      Vector<double> ak2 = peom->getDerivatives(x + A(1) * h, ytemp);
-
+      for(int i = 0; i < n; i++)
+      {
+         ytemp[i] = y[i] + B(1,0) * h * dydx[i];
+      }
+      peom->getDerivatives(x + A(1) * h, ytemp, ak[1]);
 
-      // ak3
-      ytemp = y + h * (B(2,0) * dydx + B(2,1) * ak2) ;
-      Vector<double> ak3 = peom->getDerivatives(x + A(2) * h, ytemp);
-      
-      // ak4
-      ytemp = y + h * (B(3,0) * dydx + B(3,1) * ak2 + B(3,2) * ak3) ;
-      Vector<double> ak4 = peom->getDerivatives(x + A(3) * h, ytemp);
+      // ak3 ... ak13
+      //   ytemp = y + h * (B(s,0) * dydx + B(s,1) * ak2 + ... )
+      for(int stage = 2; stage < 13; stage++)
+      {
+         for(int i = 0; i < n; i++)
+         {
+            double sum = B(stage,0) * dydx[i];
+            for(int j = 1; j < stage; j++)
+            {
+               sum += B(stage,j) * ak[j][i];
+            }
+            ytemp[i] = y[i] + h * sum;
+         }
+         peom->getDerivatives(x + A(stage) * h, ytemp, ak[stage]);
+      }
 
-      // ak5
-      ytemp = y + h * (B(4,0) * dydx + B(4,1) * ak2 + B(4,2) * ak3 + B(4,3) * ak4) ;
-      Vector<double> ak5 = peom->getDerivatives(x + A(4) * h, ytemp);
-      
-      // ak6
-      ytemp = y + h * (B(5,0) * dydx + B(5,1) * ak2 + B(5,2) * ak3 + B(5,3) * ak4 
-         + B(5,4) * ak5) ;
-      Vector<double> ak6 = peom->getDerivatives(x + A(5) * h, ytemp);
-      
-      // ak7
-      ytemp = y + h * (B(6,0) * dydx + B(6,1) * ak2 + B(6,2) * ak3 + B(6,3) * ak4
-         + B(6,4) * ak5 + B(6,5) * ak6) ;
-      Vector<double> ak7 = peom->getDerivatives(x + A(6) * h, ytemp);
-      
-      // ak8
-      ytemp = y + h * (B(7,0) * dydx + B(7,1) * ak2 + B(7,2) * ak3 + B(7,3) * ak4 
-         + B(7,4) * ak5 + B(7,5) * ak6 + B(7,6) * ak7) ;
-      Vector<double> ak8 = peom->getDerivatives(x + A(7) * h, ytemp);
-      
-      // ak9
-      ytemp = y + h * (B(8,0) * dydx + B(8,1) * ak2 + B(8,2) * ak3 + B(8,3) * ak4 
-         + B(8,4) * ak5 + B(8,5) * ak6 + B(8,6) * ak7 + B(8,7) * ak8) ;
-      Vector<double> ak9 = peom->getDerivatives(x + A(8) * h, ytemp);
+      const Vector<double>& ak2 = ak[1];
+      const Vector<double>& ak3 = ak[2];
+      const Vector<double>& ak4 = ak[3];
+      const Vector<double>& ak5 = ak[4];
+      const Vector<double>& ak6 = ak[5];
+      const Vector<double>& ak7 = ak[6];
+      const Vector<double>& ak8 = ak[7];
+      const Vector<double>& ak9 = ak[8];
+      const Vector<double>& ak10 = ak[9];
+      const Vector<double>& ak11 = ak[10];
+      const Vector<double>& ak12 = ak[11];
+      const Vector<double>& ak13 = ak[12];
       
-      // ak10
-      ytemp = y + h * (B(9,0) * dydx + B(9,1) * ak2 + B(9,2) * ak3 + B(9,3) * ak4
-         + B(9,4) * ak5 + B(9,5) * ak6 + B(9,6) * ak7 + B(9,7) * ak8 + B(9,8) * ak9) ;
-      Vector<double> ak10 = peom->getDerivatives(x + A(9) * h, ytemp);
-
-      // ak11
-      ytemp = y + h * (B(10,0) * dydx + B(10,1) * ak2 + B(10,2) * ak3 + B(10,3) * ak4
-         + B(10,4) * ak5 + B(10,5) * ak6 + B(10,6) * ak7 + B(10,7) * ak8 + B(10,8) * ak9 
-         + B(10,9) * ak10) ;
-      Vector<double> ak11 = peom->getDerivatives(x + A(10) * h, ytemp);
-      
-      // ak12
-      ytemp = y + h * (B(11,0) * dydx + B(11,1) * ak2 + B(11,2) * ak3 + B(11,3) * ak4 
-         + B(11,4) * ak5 + B(11,5) * ak6 + B(11,6) * ak7 + B(11,7) * ak8 + B(11,8) * ak9 
-         + B(11,9) * ak10 + B(11,10) * ak11) ;
-      Vector<double> ak12 = peom->getDerivatives(x + A(11) * h, ytemp);
-      
-      // ak13
-      ytemp = y + h * (B(12,0) * dydx + B(12,1) * ak2 + B(12,2) * ak3 + B(12,3) * ak4 
-         + B(12,4) * ak5 + B(12,5) * ak6 + B(12,6) * ak7 + B(12,7) * ak8 + B(12,8) * ak9
-         + B(12,9) * ak10 + B(12,10) * ak11 + B(12,11) * ak12) ;
-      Vector<double> ak13 = peom->getDerivatives(x + A(12) * h, ytemp);
-      
-      yout.resize(n,0.0);
-      yerr.resize(n,0.0);
+      yout.resize(n);
+      yerr.resize(n);
       for (int i = 0; i < n; i++ ) 
       {
          /*
@@ -432,12 +412,14 @@ namespace gpstk
       // make a copy of the data
       Vector<double> yend = y;
 
+      Vector<double> dydx(nvar,0.0);
+      Vector<double> yscal(nvar,0.0);
+
       for (int nstp = 0; nstp < RKF_MAXSTEP; nstp++ ) 
       {
 
-         Vector<double> dydx = peom->getDerivatives(x, yend);
+         peom->getDerivatives(x, yend, dydx);
       
-         Vector<double> yscal(nvar,0.0);
          for(int i=0;i<nvar;i++)
          {
             yscal(i) = std::fabs(yend(i)) + std::fabs(dydx(i)*h) + RKF_EPS;
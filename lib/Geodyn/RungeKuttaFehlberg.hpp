@@ -33,6 +33,7 @@
 //============================================================================
 
 
+#include <vector>
 #include "Integrator.hpp"
 
 
@@ -157,6 +158,12 @@ namespace gpstk
          /// Max step
       static const double RKF_MAXSTEP;
 
+         /// Work space of rkfs78(): the 13 stage derivatives and the
+         /// intermediate state, reused from step to step. One object
+         /// should therefore not be shared between threads.
+      std::vector< Vector<double> > ak;
+      Vector<double> ytemp;
+
    private:
      
       /// Object holding all parameters for rkf78
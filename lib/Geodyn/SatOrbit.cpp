@@ -54,6 +54,24 @@ namespace gpstk
       return forceList.getDerivatives(utc, earthBody, sc);
    }
 
+   // get derivative dy/dt into 'dydt'
+   void SatOrbit::getDerivatives(const double&         t,
+                                 const Vector<double>& y,
+                                 Vector<double>&       dydt)
+   {
+      if(fmlPrepared == false)
+      {
+         createFMObjects(forceConfig);
+      }
+
+      // import the state vector to sc
+      sc.setStateVector(y);
+
+      UTCTime utc = utc0;
+      utc += t;
+      forceList.getDerivatives(utc, earthBody, sc, dydt);
+   }
+
    void SatOrbit::init()
    {
       setSpacecraftData("sc-test01",1000.0,20.0,20.0,1.0,2.2);
@@ -153,6 +153,11 @@ namespace gpstk
       virtual Vector<double> getDerivatives(const double&         t,
                                             const Vector<double>& y );
 
+         /// get derivative dy/dt into 'dydt'; allocation free
+      virtual void getDerivatives( const double&         t,
+                                   const Vector<double>& y,
+                                   Vector<double>&       dydt );
+
          /// Restore the default setting
       SatOrbit& reset()
       {deleteFMObjects(forceConfig);fmlPrepared = false;init();return(*this);}
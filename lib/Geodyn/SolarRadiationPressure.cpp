@@ -43,9 +43,9 @@ namespace gpstk
        * @param r_Moon Moon position vector (geocentric) [m].
        * @return 0.0 if in shadow, 1.0 if in sunlight, 0 to 1.0 if in partial shadow
        */
-   double SolarRadiationPressure::getShadowFunction(Vector<double> r, 
-                                                    Vector<double> r_Sun,
-                                                    Vector<double> r_Moon,
+   double SolarRadiationPressure::getShadowFunction(const Vector3& r,
+                                                    const Vector3& r_Sun,
+                                                    const Vector3& /*r_Moon*/,
                                                     SolarRadiationPressure::ShadowModel sm)
    {
       // shadow function
@@ -57,7 +57,7 @@ namespace gpstk
 #pragma unused(R_moon)
       const double R_earth = ASConstant::R_Earth;
 
-      Vector<double> e_Sun = r_Sun/norm(r_Sun);   // Sun direction unit vector
+      Vector3 e_Sun = r_Sun/norm(r_Sun);   // Sun direction unit vector
 
       double r_dot_sun = dot(r,e_Sun);
       
@@ -146,7 +146,7 @@ namespace gpstk
 #pragma unused(r_sun_mag)
          double r_mag = norm(r);
          
-         Vector<double> d = r_Sun-r;            // vector from sc to sun
+         Vector3 d = r_Sun-r;            // vector from sc to sun
          double dmag = norm(d);               
 
          double a = std::asin(R_sun/dmag);               // eq. 3.85
@@ -189,10 +189,10 @@ namespace gpstk
        * @param r_Sun ECI position vector of Sun in m.
        * @return Acceleration due to solar radiation pressure in m/s^2.
        */
-   Vector<double> SolarRadiationPressure::accelSRP(Vector<double> r, Vector<double> r_Sun) 
+   Vector3 SolarRadiationPressure::accelSRP(const Vector3& r, const Vector3& r_Sun) 
    {
       // Relative position vector of spacecraft w.r.t. Sun (from the sun to s/c)
-      Vector<double> d = r-r_Sun;
+      Vector3 d = r-r_Sun;
       double dmag = norm(d);
       double dcubed = dmag * dmag * dmag;
       double au2 = ASConstant::AU * ASConstant::AU;
@@ -207,7 +207,7 @@ namespace gpstk
       double factor = reflectCoeff * (crossArea/dryMass) * Ls 
                     / (4.0*ASConstant::PI*ASConstant::SPEED_OF_LIGHT*dcubed); // STK HPOP method
       
-      Vector<double> out = d * factor;
+      Vector3 out = d * factor;
       
       return  out;
 
@@ -220,7 +220,7 @@ namespace gpstk
        * @param r_Sun Sun position vector (geocentric) [m].
        * @return 0.0 if in shadow, 1.0 if in sunlight, 0 to 1.0 if in partial shadow
        */
-   double SolarRadiationPressure::partial_illumination(Vector<double> r, Vector<double> r_Sun )
+   double SolarRadiationPressure::partial_illumination(const Vector3& r, const Vector3& r_Sun )
    {
       double r_sun_mag = norm(r_Sun);
 #pragma unused(r_sun_mag)
@@ -228,7 +228,7 @@ namespace gpstk
 
       double R_sun = ASConstant::R_Sun;
       double R_earth = ASConstant::R_Earth;
-      Vector<double> d = r_Sun-r;
+      Vector3 d = r_Sun-r;
       double dmag = norm(d);
       double sd = -1.0 * dot(r,d);
       double a = std::asin(R_sun/dmag);
@@ -261,8 +261,8 @@ namespace gpstk
       dryMass = sc.getDryMass();
       reflectCoeff = sc.getReflectCoeff();
 
-      Vector<double> r_sun = ReferenceFrames::getJ2kPosition(utc.asTDB(),SolarSystem::Sun);
-      Vector<double> r_moon = ReferenceFrames::getJ2kPosition(utc.asTDB(),SolarSystem::Moon);
+      Vector3 r_sun = ReferenceFrames::getJ2kPosition(utc.asTDB(),SolarSystem::Sun);
+      Vector3 r_moon = ReferenceFrames::getJ2kPosition(utc.asTDB(),SolarSystem::Moon);
       
       // from km to m
       r_sun = r_sun*1000.0;
@@ -278,12 +278,10 @@ namespace gpstk
       double au2 = ASConstant::AU * ASConstant::AU;
       double factor = -1.0*reflectCoeff * (crossArea/dryMass) * ASConstant::P_Sol*au2;
 
-      Vector<double> d = sc.R() - r_sun;
+      Vector3 d = Vector3(sc.R()) - r_sun;
       double dmag = norm(d);
       double dcubed = dmag * dmag *dmag;
 
-      Vector<double> temp1 = d / dcubed;         //  detRJ/detRJ^3
-
       double smag = norm(r_sun);
       double scubed = smag * smag * smag;
 #pragma unused(scubed)
@@ -69,9 +69,9 @@ namespace gpstk
           * @param r_Moon Moon position vector (geocentric) [m].
           * @return 0.0 if in shadow, 1.0 if in sunlight, 0 to 1.0 if in partial shadow
           */
-      double getShadowFunction(Vector<double> r, 
-                               Vector<double> r_Sun,
-                               Vector<double> r_Moon, 
+      double getShadowFunction(const Vector3& r,
+                               const Vector3& r_Sun,
+                               const Vector3& r_Moon, 
                                SolarRadiationPressure::ShadowModel sm = SM_CONICAL);
 
          // this is the real one
@@ -90,7 +90,7 @@ namespace gpstk
           * @param r_Sun ECI position vector of Sun in m.
           * @return Acceleration due to solar radiation pressure in m/s^2.
           */
-      Vector<double> accelSRP(Vector<double> r, Vector<double> r_Sun);
+      Vector3 accelSRP(const Vector3& r, const Vector3& r_Sun);
 
 
          /** Determines if the satellite is in sunlight or shadow based on simple cylindrical shadow model.
@@ -99,7 +99,7 @@ namespace gpstk
           * @param r_Sun Sun position vector (geocentric) [m].
           * @return 0.0 if in shadow, 1.0 if in sunlight, 0 to 1.0 if in partial shadow
           */
-      double partial_illumination(Vector<double> r, Vector<double> r_Sun );
+      double partial_illumination(const Vector3& r, const Vector3& r_Sun );
 
     
    protected:      
@@ -117,7 +117,7 @@ namespace gpstk
       double reflectCoeff;      // CR
 
          /// Object hold da/dCr
-      Vector<double> dadcr;
+      Vector3 dadcr;
 
    }; // End of class 'SolarRadiationPressure'
 
@@ -381,7 +381,7 @@ namespace gpstk
    }  // End of method 'Spacecraft::getStateVector()'
 
 
-   void Spacecraft::setStateVector(Vector<double> y)
+   void Spacecraft::setStateVector(const Vector<double>& y)
    {
       const int dim = y.size();
       const int np = (dim-42)/6;
@@ -58,17 +58,17 @@ namespace gpstk
       ~Spacecraft() {};
 
          /// SC position(R), velocity(V) and dynamic parameters(P)
-      Vector<double> R() {return r;}
-      Vector<double> V() {return v;}
-      Vector<double> P() {return p;}
+      const Vector<double>& R() const {return r;}
+      const Vector<double>& V() const {return v;}
+      const Vector<double>& P() const {return p;}
       
          /// SC derivatives
-      Vector<double> dR_dR0() {return dr_dr0;}
-      Vector<double> dR_dV0() {return dr_dv0;}
-      Vector<double> dR_dP0() {return dr_dp0;}
-      Vector<double> dV_dR0() {return dv_dr0;}
-      Vector<double> dV_dV0() {return dv_dv0;}
-      Vector<double> dV_dP0() {return dv_dp0;}
+      const Vector<double>& dR_dR0() const {return dr_dr0;}
+      const Vector<double>& dR_dV0() const {return dr_dv0;}
+      const Vector<double>& dR_dP0() const {return dr_dp0;}
+      const Vector<double>& dV_dR0() const {return dv_dr0;}
+      const Vector<double>& dV_dV0() const {return dv_dv0;}
+      const Vector<double>& dV_dP0() const {return dv_dp0;}
 
          /// Get number of force model parameters
       int getNumOfP()
@@ -79,7 +79,7 @@ namespace gpstk
       
          /// Methods to handle SC state vector
       Vector<double> getStateVector();
-      void setStateVector(Vector<double> y);
+      void setStateVector(const Vector<double>& y);
 
          /// Methods to handle SC transition matrix
       Matrix<double> getTransitionMatrix();
@@ -65,18 +65,10 @@ namespace gpstk
        * @param r ECI position vector.
        * @param E ECI to ECEF transformation matrix.
        */
-   void SphericalHarmonicGravity::computeVW(Vector<double> r, Matrix<double> E)
+   void SphericalHarmonicGravity::computeVW(const Vector3& r, const Matrix3& E)
    {   
-      // dimension should be checked here
-      // I'll do it latter...
-      if((r.size()!=3) || (E.rows()!=3) || (E.cols()!=3))
-      {
-         Exception e("Wrong input for computeVW");
-         GPSTK_THROW(e);
-      }
-
       // Rotate from ECI to ECEF
-      Vector<double> r_bf = E * r; 
+      Vector3 r_bf = E * r; 
 
       const double R_ref = gmData.refDistance;
 
@@ -99,16 +91,16 @@ namespace gpstk
       //
 
       // Calculate zonal terms V(n,0); set W(n,0)=0.0
-      V[0][0] = R_ref / std::sqrt(r_sqr);
-      W[0][0] = 0.0;
+      V(0,0) = R_ref / std::sqrt(r_sqr);
+      W(0,0) = 0.0;
 
-      V[1][0] = z0 * V[0][0];
-      W[1][0] = 0.0;
+      V(1,0) = z0 * V(0,0);
+      W(1,0) = 0.0;
 
       for(int n = 2; n <= (desiredDegree+2); n++) 
       {
-         V[n][0] = ((2*n - 1) * z0 * V[n-1][0] - (n - 1) * rho * V[n-2][0]) /n;
-         W[n][0] = 0.0;
+         V(n,0) = ((2*n - 1) * z0 * V(n-1,0) - (n - 1) * rho * V(n-2,0)) /n;
+         W(n,0) = 0.0;
       }
 
       // Calculate tesseral and sectorial terms
@@ -116,19 +108,19 @@ namespace gpstk
       {
          // Calculate V(m,m) .. V(n_max+1,m)
 
-         V[m][m] = (2 * m - 1) * ( x0 * V[m-1][m-1] - y0 * W[m-1][m-1] );
-         W[m][m] = (2 * m - 1) * ( x0 * W[m-1][m-1] + y0 * V[m-1][m-1] );
+         V(m,m) = (2 * m - 1) * ( x0 * V(m-1,m-1) - y0 * W(m-1,m-1) );
+         W(m,m) = (2 * m - 1) * ( x0 * W(m-1,m-1) + y0 * V(m-1,m-1) );
 
          if (m <= (desiredDegree+1) ) 
          {
-            V[m+1][m] = (2 * m + 1) * z0 * V[m][m];
-            W[m+1][m] = (2 * m + 1) * z0 * W[m][m];
+            V(m+1,m) = (2 * m + 1) * z0 * V(m,m);
+            W(m+1,m) = (2 * m + 1) * z0 * W(m,m);
          }
 
          for (int n = (m+2); n <= (desiredDegree+2); n++) 
          {
-            V[n][m] = ((2*n-1)*z0*V[n-1][m] - (n+m-1)*rho*V[n-2][m]) / (n-m);
-            W[n][m] = ((2*n-1)*z0*W[n-1][m] - (n+m-1)*rho*W[n-2][m]) / (n-m);
+            V(n,m) = ((2*n-1)*z0*V(n-1,m) - (n+m-1)*rho*V(n-2,m)) / (n-m);
+            W(n,m) = ((2*n-1)*z0*W(n-1,m) - (n+m-1)*rho*W(n-2,m)) / (n-m);
          }
 
       }  // End 'for (int m = 1; m <= (desiredOrder + 2); m++) '
@@ -141,17 +133,10 @@ namespace gpstk
        * @param E ECI to ECEF transformation matrix.
        * @return ECI acceleration in m/s^2.
        */
-   Vector<double> SphericalHarmonicGravity::gravity(Vector<double> r, Matrix<double> E)
+   Vector3 SphericalHarmonicGravity::gravity( const Vector3& /*r*/,
+                                              const Matrix3& E )
    {
-      // dimension should be checked here
-      // I'll do it latter...
-      if((r.size()!=3) || (E.rows()!=3) || (E.cols()!=3))
-      {
-         Exception e("Wrong input for computeVW");
-         GPSTK_THROW(e);
-      }
-
-      Matrix<double> CS = gmData.unnormalizedCS;
+      const Matrix<double>& CS = gmData.unnormalizedCS;
 
    
       // Calculate accelerations ax,ay,az
@@ -163,21 +148,21 @@ namespace gpstk
          {
             if (m==0) 
             {
-               double C = CS[n][0];               // = C_n,0
+               double C = CS(n,0);               // = C_n,0
 
-               ax -=       C * V[n+1][1];
-               ay -=       C * W[n+1][1];
-               az -= (n+1)*C * V[n+1][0];
+               ax -=       C * V(n+1,1);
+               ay -=       C * W(n+1,1);
+               az -= (n+1)*C * V(n+1,0);
             }
             else 
             {
-               double C = CS[n][m];   // = C_n,m
-               double S = CS[m-1][n]; // = S_n,m
+               double C = CS(n,m);   // = C_n,m
+               double S = CS(m-1,n); // = S_n,m
                double Fac = 0.5 * (n-m+1) * (n-m+2);
                
-               ax += 0.5*(-C*V[n+1][m+1] - S*W[n+1][m+1]) + Fac*(C*V[n+1][m-1] + S*W[n+1][m-1]);
-               ay += 0.5*(-C*W[n+1][m+1] + S*V[n+1][m+1]) + Fac*(-C*W[n+1][m-1] + S*V[n+1][m-1]);
-               az += (n-m+1)*(-C*V[n+1][m] - S*W[n+1][m]);
+               ax += 0.5*(-C*V(n+1,m+1) - S*W(n+1,m+1)) + Fac*(C*V(n+1,m-1) + S*W(n+1,m-1));
+               ay += 0.5*(-C*W(n+1,m+1) + S*V(n+1,m+1)) + Fac*(-C*W(n+1,m-1) + S*V(n+1,m-1));
+               az += (n-m+1)*(-C*V(n+1,m) - S*W(n+1,m));
             }
 
          }  // End of 'for (int n = m; n <= (desiredDegree+1) ; n++)'
@@ -185,7 +170,7 @@ namespace gpstk
       }  // End of 'for (int m = 0; m <= (desiredOrder+1); m++)'
 
       // Body-fixed acceleration
-      Vector<double> a_bf(3,0.0);
+      Vector3 a_bf;
       a_bf(0) = ax;
       a_bf(1) = ay;
       a_bf(2) = az;
@@ -193,8 +178,7 @@ namespace gpstk
       a_bf = a_bf * ( gmData.GM / (gmData.refDistance * gmData.refDistance) );
 
       // Inertial acceleration
-      Matrix<double> Etrans = transpose(E);
-      Vector<double> out = Etrans * a_bf;            // this line may be wrong  matrix * vector
+      Vector3 out = transposeTimes(E, a_bf);
 
       return out;
 
@@ -206,17 +190,10 @@ namespace gpstk
        * @param r ECI position vector.
        * @param E ECI to ECEF transformation matrix.
        */
-   Matrix<double> SphericalHarmonicGravity::gravityGradient(gpstk::Vector<double> r, gpstk::Matrix<double> E)
+   Matrix3 SphericalHarmonicGravity::gravityGradient( const Vector3& /*r*/,
+                                                      const Matrix3& E )
    {
-      // dimension should be checked here
-      // I'll do it latter...
-      if((r.size()!=3) || (E.rows()!=3) || (E.cols()!=3))
-      {
-         Exception e("Wrong input for gravityGradient");
-         GPSTK_THROW(e);
-      }
-
-      Matrix<double> CS = gmData.unnormalizedCS;
+      const Matrix<double>& CS = gmData.unnormalizedCS;
 
    
       double xx = 0.0;     
@@ -226,7 +203,7 @@ namespace gpstk
       double yz = 0.0;
       double zz = 0.0;
 
-      Matrix<double> out(3, 3, 0.0);
+      Matrix3 out;
 
       for (int m = 0; m <= desiredOrder; m++) 
       {
@@ -234,48 +211,48 @@ namespace gpstk
          {
             double Fac = (n-m+2)*(n-m+1);
             
-            double C = CS[n][m];
-            double S = (m==0) ? 0.0 : CS[m-1][n];   // yan changed
-            //S = (m==0)?Sn0(n):CS[m-1][n];   // yan changed
+            double C = CS(n,m);
+            double S = (m==0) ? 0.0 : CS(m-1,n);   // yan changed
+            //S = (m==0)?Sn0(n):CS(m-1,n);   // yan changed
 
-            zz += Fac*(C*V[n+2][m] + S*W[n+2][m]);
+            zz += Fac*(C*V(n+2,m) + S*W(n+2,m));
 
             if (m==0) 
             {
-               C = CS[n][0];   // = C_n,0
+               C = CS(n,0);   // = C_n,0
 
                Fac = (n+2)*(n+1);
-               xx += 0.5 * (C*V[n+2][2] - Fac*C*V[n+2][0]);
-               xy += 0.5 * C * W[n+2][2];
+               xx += 0.5 * (C*V(n+2,2) - Fac*C*V(n+2,0));
+               xy += 0.5 * C * W(n+2,2);
                
                Fac = n + 1;
-               xz += Fac * C * V[n+2][1];
-               yz += Fac * C * W[n+2][1];
+               xz += Fac * C * V(n+2,1);
+               yz += Fac * C * W(n+2,1);
             }
             if (m > 0)
             {
-               C = CS[n][m];
-               S = CS[m-1][n];
+               C = CS(n,m);
+               S = CS(m-1,n);
                
                double f1 = 0.5*(n-m+1);
                double f2 = (n-m+3)*(n-m+2)*f1;
 
-               xz += f1*(C*V[n+2][m+1]+S*W[n+2][m+1])-f2*(C*V[n+2][m-1]+S*W[n+2][m-1]);
-               yz += f1*(C*W[n+2][m+1]-S*V[n+2][m+1])+f2*(C*W[n+2][m-1]-S*V[n+2][m-1]);         //* bug in JAT, I fix it
+               xz += f1*(C*V(n+2,m+1)+S*W(n+2,m+1))-f2*(C*V(n+2,m-1)+S*W(n+2,m-1));
+               yz += f1*(C*W(n+2,m+1)-S*V(n+2,m+1))+f2*(C*W(n+2,m-1)-S*V(n+2,m-1));         //* bug in JAT, I fix it
           
                if (m == 1)
                {
                   Fac = (n+1)*n;
-                  xx += 0.25*(C*V[n+2][3]+S*W[n+2][3]-Fac*(3.0*C*V[n+2][1]+S*W[n+2][1]));
-                  xy += 0.25*(C*W[n+2][3]-S*V[n+2][3]-Fac*(C*W[n+2][1]+S*V[n+2][1]));
+                  xx += 0.25*(C*V(n+2,3)+S*W(n+2,3)-Fac*(3.0*C*V(n+2,1)+S*W(n+2,1)));
+                  xy += 0.25*(C*W(n+2,3)-S*V(n+2,3)-Fac*(C*W(n+2,1)+S*V(n+2,1)));
                }
                if (m > 1) 
                {
                   f1 = 2.0*(n-m+2)*(n-m+1);
                   f2 = (n-m+4)*(n-m+3)*f1*0.5;
-                  xx += 0.25*(C*V[n+2][m+2]+S*W[n+2][m+2]-f1*(C*V[n+2][m]+S*W[n+2][m])+f2*(C*V[n+2][m-2]+S*W[n+2][m-2]));
+                  xx += 0.25*(C*V(n+2,m+2)+S*W(n+2,m+2)-f1*(C*V(n+2,m)+S*W(n+2,m))+f2*(C*V(n+2,m-2)+S*W(n+2,m-2)));
 
-                  xy += 0.25*(C*W[n+2][m+2]-S*V[n+2][m+2]+f2*(-C*W[n+2][m-2]+S*V[n+2][m-2]));
+                  xy += 0.25*(C*W(n+2,m+2)-S*V(n+2,m+2)+f2*(-C*W(n+2,m-2)+S*V(n+2,m-2)));
                }
             }
          }
@@ -297,8 +274,7 @@ namespace gpstk
       out = out * (gmData.GM / (R_ref * R_ref * R_ref));
 
       // Rotate to ECI
-      Matrix<double> Etrans = transpose(E);
-      out = Etrans*(out*E);
+      out = transpose(E)*(out*E);
 
       return out;         // the result should be checked
 
@@ -315,7 +291,8 @@ namespace gpstk
    void SphericalHarmonicGravity::doCompute(UTCTime utc, EarthBody& rb, Spacecraft& sc)
    {
 
-      Matrix<double> C2T = ReferenceFrames::J2kToECEFMatrix(utc);
+      Matrix3 C2T = ReferenceFrames::J2kToECEFMatrix(utc);
+      const Vector3 r = sc.R();
 
       /*
       // debuging
@@ -339,13 +316,13 @@ namespace gpstk
       correctCSTides(utc, correctSolidTide, correctOceanTide, correctPoleTide);
 
       // Evaluate harmonic functions
-      computeVW(sc.R(), C2T);         // update VM
+      computeVW(r, C2T);         // update VM
 
       // a
-      a = gravity(sc.R(), C2T);
+      a = gravity(r, C2T);
       
       // da_dr
-      da_dr = gravityGradient(sc.R(), C2T);
+      da_dr = gravityGradient(r, C2T);
       
       //da_dv
       da_dv.resize(3,3,0.0);
@@ -357,6 +334,9 @@ namespace gpstk
    // Correct tides to coefficients 
    void SphericalHarmonicGravity::correctCSTides(UTCTime t,bool solidFlag,bool oceanFlag,bool poleFlag)
    {
+      // with no tide to correct, spare the copy of the whole CS matrix
+      if(!solidFlag && !oceanFlag && !poleFlag) return;
+
       // copy CS
       Matrix<double> CS = gmData.unnormalizedCS;
       Vector<double> Sn0(CS.rows(),0.0);
@@ -72,7 +72,7 @@ namespace gpstk
           * @param E ECI to ECEF transformation matrix.
           * @return ECI acceleration in m/s^2.
           */
-      Vector<double> gravity(Vector<double> r, Matrix<double> E);
+      Vector3 gravity(const Vector3& r, const Matrix3& E);
 
 
          /** Computes the partial derivative of gravity with respect to position.
@@ -80,7 +80,7 @@ namespace gpstk
           * @param r ECI position vector.
           * @param E ECI to ECEF transformation matrix.
           */
-      Matrix<double> gravityGradient(Vector<double> r, Matrix<double> E);
+      Matrix3 gravityGradient(const Vector3& r, const Matrix3& E);
       
 
          /** Call the relevant methods to compute the acceleration.
@@ -92,8 +92,22 @@ namespace gpstk
       virtual void doCompute(UTCTime utc, EarthBody& rb, Spacecraft& sc);
 
 
+         /** Set the degree and order used, which may not exceed those of
+          * the model; V and W are sized to match. Element access in the
+          * harmonic sums is not range checked, so this is checked here.
+          */
       SphericalHarmonicGravity& setDesiredDegree(const int& n, const int& m)
-      { desiredDegree = n; desiredOrder = m; return (*this); }
+      {
+         if(n > gmData.maxDegree || m > n || m < 0)
+         {
+            Exception e("Invalid degree or order for the gravity model");
+            GPSTK_THROW(e);
+         }
+         desiredDegree = n; desiredOrder = m;
+         V.resize(n+3, n+3, 0.0);
+         W.resize(n+3, n+3, 0.0);
+         return (*this);
+      }
 
 
       /// Methods to enable earth tide correction
@@ -124,7 +138,7 @@ namespace gpstk
           * @param r ECI position vector.
           * @param E ECI to ECEF transformation matrix.
           */
-      void computeVW(Vector<double> r, Matrix<double> E);
+      void computeVW(const Vector3& r, const Matrix3& E);
 
          /// Add tides to coefficients 
       void correctCSTides(UTCTime t,bool solidFlag = false, bool oceanFlag = false, bool poleFlag = false);
@@ -57,22 +57,22 @@ namespace gpstk
        * da/dr = -GM*( I/norm(r-s)^3 - 3(r-s)transpose(r-s)/norm(r-s)^5)
        */
 
-      Vector<double> r_sun = ReferenceFrames::getJ2kPosition(utc.asTDB(), SolarSystem::Sun);
+      Vector3 r_sun = ReferenceFrames::getJ2kPosition(utc.asTDB(), SolarSystem::Sun);
 
       r_sun = r_sun * 1000.0;                          // from km to m
 
-      Vector<double> d = sc.R() - r_sun;
+      Vector3 d = Vector3(sc.R()) - r_sun;
       double dmag = norm(d);
       double dcubed = dmag * dmag *dmag;
 
-      Vector<double> temp1 = d / dcubed;              //  detRJ/detRJ^3
+      Vector3 temp1 = d / dcubed;              //  detRJ/detRJ^3
 
       double smag = norm(r_sun);
       double scubed = smag * smag * smag;
 
-      Vector<double> temp2 = r_sun / scubed;            //  Rj/Rj^3
+      Vector3 temp2 = r_sun / scubed;            //  Rj/Rj^3
 
-      Vector<double> sum = temp1 + temp2;
+      Vector3 sum = temp1 + temp2;
       a = sum * (-mu);
 
       // da_dr
@@ -758,20 +758,20 @@ try {
    for(ilast=-1, i=0; i<size(); i++) {
 
       // ignore data the caller has marked BAD
-      if(!(spdvector[i].flag & OK)) continue;
+      if(!(spdflag[i] & OK)) continue;
 
       // just in case the caller has set it to something else...
-      spdvector[i].flag = OK;
+      spdflag[i] = OK;
 
          // look for obvious outliers
          // Don't do this - sometimes the pseudoranges get extreme values b/c the
          // clock is allowed to run off for long times - perfectly normal
-      //if(spdvector[i].data[P1] < cfg(MinRange) ||
-      //   spdvector[i].data[P1] > cfg(MaxRange) ||
-      //   spdvector[i].data[P2] < cfg(MinRange) ||
-      //   spdvector[i].data[P2] > cfg(MaxRange) )
+      //if(spddata[P1][i] < cfg(MinRange) ||
+      //   spddata[P1][i] > cfg(MaxRange) ||
+      //   spddata[P2][i] < cfg(MinRange) ||
+      //   spddata[P2][i] > cfg(MaxRange) )
       //{
-      //   spdvector[i].flag = BAD;
+      //   spdflag[i] = BAD;
       //   learn["points deleted: obvious outlier"]++;
       //   if(cfg(Debug) > 6)
       //      log << "Obvious outlier " << GDCUnique << " " << sat
@@ -805,30 +805,30 @@ try {
 
          // loop over points in this segment
       for(i=it->nbeg; i<=it->nend; i++) {
-         if(!(spdvector[i].flag & OK)) continue;
+         if(!(spdflag[i] & OK)) continue;
 
-         dbias = fabs(spdvector[i].data[P1]-wl1*spdvector[i].data[L1]-biasL1);
+         dbias = fabs(spddata[P1][i]-wl1*spddata[L1][i]-biasL1);
          if(dbias > cfg(RawBiasLimit)) {
             if(cfg(Debug) >= 2) log << "BEFresetL1 " << GDCUnique
                << " " << sat << " " << printTime(time(i),outFormat)
                << " " << fixed << setprecision(3) << biasL1
-               << " " << spdvector[i].data[P1] - wl1 * spdvector[i].data[L1] << endl;
-            biasL1 = spdvector[i].data[P1] - wl1 * spdvector[i].data[L1];
+               << " " << spddata[P1][i] - wl1 * spddata[L1][i] << endl;
+            biasL1 = spddata[P1][i] - wl1 * spddata[L1][i];
          }
 
-         dbias = fabs(spdvector[i].data[P2]-wl2*spdvector[i].data[L2]-biasL2);
+         dbias = fabs(spddata[P2][i]-wl2*spddata[L2][i]-biasL2);
          if(dbias > cfg(RawBiasLimit)) {
             if(cfg(Debug) >= 2) log << "BEFresetL2 " << GDCUnique
                << " " << sat << " " << printTime(time(i),outFormat)
                << " " << fixed << setprecision(3) << biasL2
-               << " " << spdvector[i].data[P2] - wl2 * spdvector[i].data[L2] << endl;
-            biasL2 = spdvector[i].data[P2] - wl2 * spdvector[i].data[L2];
+               << " " << spddata[P2][i] - wl2 * spddata[L2][i] << endl;
+            biasL2 = spddata[P2][i] - wl2 * spddata[L2][i];
          }
 
-         spdvector[i].data[A1] =
-            spdvector[i].data[P1] - wl1 * spdvector[i].data[L1] - biasL1;
-         spdvector[i].data[A2] =
-            spdvector[i].data[P2] - wl2 * spdvector[i].data[L2] - biasL2;
+         spddata[A1][i] =
+            spddata[P1][i] - wl1 * spddata[L1][i] - biasL1;
+         spddata[A2][i] =
+            spddata[P2][i] - wl2 * spddata[L2][i] - biasL2;
 
       }  // end loop over points in the segment
 
@@ -864,16 +864,16 @@ try {
 
       // loop over points in this segment
       for(i=it->nbeg; i<=it->nend; i++) {
-         if(!(spdvector[i].flag & OK)) continue;
+         if(!(spdflag[i] & OK)) continue;
 
          // narrow lane range (m)
-         wlr = wl1r * spdvector[i].data[P1] + wl2r * spdvector[i].data[P2];
+         wlr = wl1r * spddata[P1][i] + wl2r * spddata[P2][i];
          // wide lane phase (m)
-         wlp = wl1p * spdvector[i].data[L1] + wl2p * spdvector[i].data[L2];
+         wlp = wl1p * spddata[L1][i] + wl2p * spddata[L2][i];
          // geometry-free range (m)
-         gfr =        spdvector[i].data[P1] -        spdvector[i].data[P2];
+         gfr =        spddata[P1][i] -        spddata[P2][i];
          // geometry-free phase (m)
-         gfp = gf1p * spdvector[i].data[L1] + gf2p * spdvector[i].data[L2];
+         gfp = gf1p * spddata[L1][i] + gf2p * spddata[L2][i];
          // wide lane bias (cycles)
          wlbias = (wlp-wlr)/wlwl;
 
@@ -884,10 +884,10 @@ try {
          }
 
          // change the arrays
-         spdvector[i].data[L1] = gfp + gfr;              // only used in GF
-         spdvector[i].data[L2] = gfp;
-         spdvector[i].data[P1] = wlbias;
-         spdvector[i].data[P2] = - gfr;
+         spddata[L1][i] = gfp + gfr;              // only used in GF
+         spddata[L2][i] = gfp;
+         spddata[P1][i] = wlbias;
+         spddata[P2][i] = - gfr;
 
          it->npts++;
       }
@@ -1007,8 +1007,8 @@ try {
       }
       if(i > it->nend) {                  // change segments
          if(outlier) {
-            if(spdvector[ibad].flag & OK) nok--;
-            spdvector[ibad].flag = BAD;
+            if(spdflag[ibad] & OK) nok--;
+            spdflag[ibad] = BAD;
             learn[string("points deleted: ") + which + string(" slip outlier")]++;
             outlier = false;
          }
@@ -1016,36 +1016,36 @@ try {
          // update nbeg and nend
          while(it->nbeg < it->nend
             && it->nbeg < size()
-            && !(spdvector[it->nbeg].flag & OK) ) it->nbeg++;
+            && !(spdflag[it->nbeg] & OK) ) it->nbeg++;
          while(it->nend > it->nbeg
             && it->nend > 0
-            && !(spdvector[it->nend].flag & OK) ) it->nend--;
+            && !(spdflag[it->nend] & OK) ) it->nend--;
          it++;
          if(it == SegList.end())
             return ReturnOK;
          nok = 0;
       }
 
-      if(!(spdvector[i].flag & OK))
+      if(!(spdflag[i] & OK))
          continue;
       nok++;                                   // nok = # good points in segment
 
       if(igood == -1) igood = i;               // igood is index of last good point
 
-      if(fabs(spdvector[i].data[A1]) > limit) {// found an outlier (1st diff, cycles)
+      if(fabs(spddata[A1][i]) > limit) {// found an outlier (1st diff, cycles)
          outlier = true;
          ibad = i;                             // ibad is index of last bad point
       }
       else if(outlier) {                       // this point good, but not past one(s)
          for(j=igood+1; j<ibad; j++) {
-            if(spdvector[j].flag & OK)
+            if(spdflag[j] & OK)
                nok--;
-            if(spdvector[j].flag & DETECT)
+            if(spdflag[j] & DETECT)
                log << "Warning - found an obvious slip, "
                   << "but marking BAD a point already marked with slip "
                   << GDCUnique << " " << sat
                   << " " << printTime(time(j),outFormat) << " " << j << endl;
-            spdvector[j].flag = BAD;             // mark all points between as bad
+            spdflag[j] = BAD;             // mark all points between as bad
             learn[string("points deleted: ") + which + string(" slip outlier")]++;
          }
 
@@ -1055,15 +1055,15 @@ try {
          it = createSegment(it,ibad,which+string(" slip gross"));
 
             // mark it
-         spdvector[ibad].flag |= (which == string("WL") ? WLDETECT : GFDETECT);
+         spdflag[ibad] |= (which == string("WL") ? WLDETECT : GFDETECT);
 
             // change the bias in the new segment
          if(which == "WL") {
-            wlbias = spdvector[ibad].data[P1];
+            wlbias = spddata[P1][ibad];
             it->bias1 = long(wlbias+(wlbias > 0 ? 0.5 : -0.5));   // WL bias (NWL)
          }
          if(which == "GF")
-            it->bias2 = spdvector[ibad].data[L2];                 // GFP bias
+            it->bias2 = spddata[L2][ibad];                 // GFP bias
 
             // prep for next point
          nok = 2;
@@ -1095,34 +1095,34 @@ try {
 
    for(size_t i=0; i<size(); i++) {
       // ignore bad data
-      if(!(spdvector[i].flag & OK)) {
-         spdvector[i].data[A1] = spdvector[i].data[A2] = 0.0;
+      if(!(spdflag[i] & OK)) {
+         spddata[A1][i] = spddata[A2][i] = 0.0;
          continue;
       }
 
       // compute first differences - 'change the arrays' A1 and A2
       if(which == string("WL")) {
          if(iprev == -1)
-            spdvector[i].data[A1] = 0.0;
+            spddata[A1][i] = 0.0;
          else
-            spdvector[i].data[A1] =
-               (spdvector[i].data[P1] - spdvector[iprev].data[P1]) /
-                  (spdvector[i].ndt-spdvector[iprev].ndt);
+            spddata[A1][i] =
+               (spddata[P1][i] - spddata[P1][iprev]) /
+                  (spdndt[i]-spdndt[iprev]);
       }
       else if(which == string("GF")) {
          if(iprev == -1)            // first difference not defined at first point
-            spdvector[i].data[A1] = spdvector[i].data[A2] = 0.0;
+            spddata[A1][i] = spddata[A2][i] = 0.0;
          else {
             // compute first difference of L1 = raw residual GFP-GFR
-            spdvector[i].data[A1] =
-               (spdvector[i].data[L1] - spdvector[iprev].data[L1]);
+            spddata[A1][i] =
+               (spddata[L1][i] - spddata[L1][iprev]);
                   // 040809 should this be divided by delta N?
-                  // / (spdvector[i].ndt-spdvector[iprev].ndt);
+                  // / (spdndt[i]-spdndt[iprev]);
             // compute first difference of L2 = GFP
-            spdvector[i].data[A2] =
-               (spdvector[i].data[L2] - spdvector[iprev].data[L2]);
+            spddata[A2][i] =
+               (spddata[L2][i] - spddata[L2][iprev]);
                   // 040809 should this be divided by delta N?
-                  // / (spdvector[i].ndt-spdvector[iprev].ndt);
+                  // / (spdndt[i]-spdndt[iprev]);
          }
       }
 
@@ -1149,8 +1149,8 @@ try {
 
    // loop over data, adding to Stats, and counting good points
    for(size_t i=it->nbeg; i<=it->nend; i++) {
-      if(!(spdvector[i].flag & OK)) continue;
-      it->WLStats.Add(spdvector[i].data[P1] - it->bias1);
+      if(!(spdflag[i] & OK)) continue;
+      it->WLStats.Add(spddata[P1][i] - it->bias1);
       it->npts++;
    }
 
@@ -1187,8 +1187,8 @@ try {
 
       // put wlbias in vecA1, but without gaps: let j index good points only from nbeg
       for(j=i=it->nbeg; i<=it->nend; i++) {
-         if(!(spdvector[i].flag & OK)) continue;
-         wlbias = spdvector[i].data[P1] - it->bias1;
+         if(!(spdflag[i] & OK)) continue;
+         wlbias = spddata[P1][i] - it->bias1;
          vecA1.push_back(wlbias);
          vecA2.push_back(0.0);
          j++;
@@ -1201,41 +1201,41 @@ try {
       // change the array : A1 is wlbias, A2 (output) will contain the weights
       // copy temps out into A1 and A2
       for(k=0,i=it->nbeg; i<j; k++,i++) {
-         spdvector[i].data[A1] = vecA1[k];
-         spdvector[i].data[A2] = vecA2[k];
+         spddata[A1][i] = vecA1[k];
+         spddata[A2][i] = vecA2[k];
       }
 
       haveslip = false;
       for(j=i=it->nbeg; i<=it->nend; i++) {
-         if(!(spdvector[i].flag & OK)) continue;
+         if(!(spdflag[i] & OK)) continue;
 
-         wlbias = spdvector[i].data[P1] - it->bias1;
+         wlbias = spddata[P1][i] - it->bias1;
 
          // TD ? use weights at all? they remove a lot of points
          // TD add absolute limit?
          if(fabs(wlbias-ave) > nsigma ||
-               spdvector[j].data[A2] < cfg(WLRobustWeightLimit))
+               spddata[A2][j] < cfg(WLRobustWeightLimit))
             outlier = true;
          else
             outlier = false;
 
          // remove points by sigma stripping
          if(outlier) {
-            if(spdvector[i].flag & DETECT || i == it->nbeg) {
+            if(spdflag[i] & DETECT || i == it->nbeg) {
                haveslip = true;
                slipindex = i;        // mark
-               slip = spdvector[i].flag; // save to put on first good point
+               slip = spdflag[i]; // save to put on first good point
                //log << "Warning - marking a slip point BAD in WL sigma strip "
                //   << GDCUnique << " " << sat
                //   << " " << time(i).printf(outFormat) << " " << i << endl;
             }
-            spdvector[i].flag = BAD;
+            spdflag[i] = BAD;
             learn["points deleted: WL sigma stripping"]++;
             it->npts--;
             it->WLStats.Subtract(wlbias);
          }
          else if(haveslip) {
-            spdvector[i].flag = slip;
+            spdflag[i] = slip;
             haveslip = false;
          }
 
@@ -1244,10 +1244,10 @@ try {
             << " " << it->nseg
             << " " << printTime(time(i),outFormat)
             << fixed << setprecision(3)
-            << " " << setw(3) << spdvector[i].flag
-            << " " << setw(13) << spdvector[j].data[A1] // wlbias
+            << " " << setw(3) << spdflag[i]
+            << " " << setw(13) << spddata[A1][j] // wlbias
             << " " << setw(13) << fabs(wlbias-ave)
-            << " " << setw(5) << spdvector[j].data[A2]  // 0 <= weight <= 1
+            << " " << setw(5) << spddata[A2][j]  // 0 <= weight <= 1
             << " " << setw(3) << i
             << (outlier ? " outlier" : "");
             if(i == it->nbeg) log
@@ -1268,27 +1268,27 @@ try {
       haveslip = false;
       ave = it->WLStats.Average();
       for(i=it->nbeg; i<=it->nend; i++) {
-         if(!(spdvector[i].flag & OK)) continue;
+         if(!(spdflag[i] & OK)) continue;
 
-         wlbias = spdvector[i].data[P1] - it->bias1;
+         wlbias = spddata[P1][i] - it->bias1;
 
          // remove points by sigma stripping
          if(fabs(wlbias-ave) > nsigma) { // TD add absolute limit?
-            if(spdvector[i].flag & DETECT) {
+            if(spdflag[i] & DETECT) {
                haveslip = true;
                slipindex = i;        // mark
-               slip = spdvector[i].flag; // save to put on first good point
+               slip = spdflag[i]; // save to put on first good point
                //log << "Warning - marking a slip point BAD in WL sigma strip "
                //   << GDCUnique << " " << sat
                //   << " " << time(i).printf(outFormat) << " " << i << endl;
             }
-            spdvector[i].flag = BAD;
+            spdflag[i] = BAD;
             learn["points deleted: WL sigma stripping"]++;
             it->npts--;
             it->WLStats.Subtract(wlbias);
          }
          else if(haveslip) {
-            spdvector[i].flag = slip;
+            spdflag[i] = slip;
             haveslip = false;
          }
 
@@ -1298,7 +1298,7 @@ try {
    // change nbeg, but don't change the bias
    if(haveslip) {
       it->nbeg = slipindex;
-      //wlbias = spdvector[slipindex].data[P1];
+      //wlbias = spddata[P1][slipindex];
       //it->bias1 = long(wlbias+(wlbias > 0 ? 0.5 : -0.5));
    }
 
@@ -1307,8 +1307,8 @@ try {
       deleteSegment(it,"WL sigma stripping");
    else {
       // update nbeg and nend // TD add limit 0 size()
-      while(it->nbeg < it->nend && !(spdvector[it->nbeg].flag & OK)) it->nbeg++;
-      while(it->nend > it->nbeg && !(spdvector[it->nend].flag & OK)) it->nend--;
+      while(it->nbeg < it->nend && !(spdflag[it->nbeg] & OK)) it->nbeg++;
+      while(it->nend > it->nbeg && !(spdflag[it->nend] & OK)) it->nend--;
    }
 
 }
@@ -1345,15 +1345,15 @@ try {
 
    // fill up the future window to size 'uwidth' (unsigned 'width'), but don't go beyond the segment
    while(futureStats.N() < uwidth && iplus <= it->nend) {
-      if(spdvector[iplus].flag & OK) {                // add only good data
-         futureStats.Add(spdvector[iplus].data[P1] - it->bias1);
+      if(spdflag[iplus] & OK) {                // add only good data
+         futureStats.Add(spddata[P1][iplus] - it->bias1);
       }
       iplus++;
    }
 
    // now loop over all points in the segment
    for(i=it->nbeg; i<= it->nend; i++) {
-      if(!(spdvector[i].flag & OK))                      // add only good data
+      if(!(spdflag[i] & OK))                      // add only good data
          continue;
 
       // compute test and limit
@@ -1362,10 +1362,10 @@ try {
          test = fabs(futureStats.Average()-pastStats.Average());
       limit = ::sqrt(futureStats.Variance() + pastStats.Variance());
       // 'change the arrays' A1 and A2
-      spdvector[i].data[A1] = test;
-      spdvector[i].data[A2] = limit;
+      spddata[A1][i] = test;
+      spddata[A2][i] = limit;
 
-      wlbias = spdvector[i].data[P1] - it->bias1;        // debiased WLbias
+      wlbias = spddata[P1][i] - it->bias1;        // debiased WLbias
 
       // dump the stats
       if(cfg(Debug) >= 6) log << "WLS " << GDCUnique
@@ -1378,8 +1378,8 @@ try {
          << " " << setw(3) << futureStats.N()
          << " " << setw(7) << futureStats.Average()
          << " " << setw(7) << futureStats.StdDev()
-         << " " << setw(9) << spdvector[i].data[A1]
-         << " " << setw(9) << spdvector[i].data[A2]
+         << " " << setw(9) << spddata[A1][i]
+         << " " << setw(9) << spddata[A2][i]
          << " " << setw(9) << wlbias
          << " " << setw(3) << i
          << endl;
@@ -1390,15 +1390,15 @@ try {
       pastStats.Add(wlbias);
       // ... and move iplus up by one (good) point, ...
       while(futureStats.N() < uwidth && iplus <= it->nend) {
-         if(spdvector[iplus].flag & OK) {
-            futureStats.Add(spdvector[iplus].data[P1] - it->bias1);
+         if(spdflag[iplus] & OK) {
+            futureStats.Add(spddata[P1][iplus] - it->bias1);
          }
          iplus++;
       }
       // ... and move iminus up by one good point
       while(pastStats.N() > uwidth && iminus <= it->nend) {// <= nend not really nec.
-         if(spdvector[iminus].flag & OK) {
-            pastStats.Subtract(spdvector[iminus].data[P1] - it->bias1);
+         if(spdflag[iminus] & OK) {
+            pastStats.Subtract(spddata[P1][iminus] - it->bias1);
          }
          iminus++;
       }
@@ -1451,11 +1451,11 @@ try {
          }
       }
 
-      if(spdvector[i].flag & OK) {
+      if(spdflag[i] & OK) {
          nok++;                                 // nok = # good points in segment
 
          if(nok == 1) {                         // change the bias, as WLStats reset
-            wlbias = spdvector[i].data[P1];
+            wlbias = spddata[P1][i];
             it->bias1 = long(wlbias+(wlbias > 0 ? 0.5 : -0.5));
          }
 
@@ -1467,7 +1467,7 @@ try {
             if(cfg(Debug) >= 6) log << "too near end " << GDCUnique
                << " " << i << " " << nok << " " << it->npts-nok
                << " " << printTime(time(i),outFormat)
-               << " " << spdvector[i].data[A1] << " " << spdvector[i].data[A2]
+               << " " << spddata[A1][i] << " " << spddata[A2][i]
                << endl;
          }
          else if(foundWLsmallSlip(it,i)) { // met condition 3
@@ -1479,18 +1479,18 @@ try {
             it = createSegment(it,i,"WL slip small");
 
             // mark it
-            spdvector[i].flag |= WLDETECT;
+            spdflag[i] |= WLDETECT;
 
             // prep for next segment
             // biases remain the same in the new segment
             it->npts = k - nok;
             nok = 0;
             it->WLStats.Reset();
-            wlbias = spdvector[i].data[P1]; // change the bias, as WLStats reset
+            wlbias = spddata[P1][i]; // change the bias, as WLStats reset
             it->bias1 = long(wlbias+(wlbias > 0 ? 0.5 : -0.5));
          }
 
-         it->WLStats.Add(spdvector[i].data[P1] - it->bias1);
+         it->WLStats.Add(spddata[P1][i] - it->bias1);
 
       } // end if good data
 
@@ -1529,8 +1529,8 @@ try {
    // A1 = test = fabs(futureStats.Average() - pastStats.Average());
    // A2 = limit = ::sqrt(futureStats.Variance() + pastStats.Variance());
    // all units WL cycles
-   double test = spdvector[i].data[A1];
-   double lim = spdvector[i].data[A2];
+   double test = spddata[A1][i];
+   double lim = spddata[A2][i];
 
    // 050109 if Debug=6, print only possible slips, if 7 print all
    bool isSlip=false;
@@ -1545,11 +1545,11 @@ try {
          //<< " " << it->npts << "pt"
          << fixed << setprecision(2)
          << " test=" << test << " lim=" << lim
-         << " (1)" << spdvector[i].data[A1]
-         << (spdvector[i].data[A1] > cfg(WLSlipSize) ? ">" : "<=")
+         << " (1)" << spddata[A1][i]
+         << (spddata[A1][i] > cfg(WLSlipSize) ? ">" : "<=")
          << cfg(WLSlipSize)
-         << " (2)" << spdvector[i].data[A1]-spdvector[i].data[A2]
-         << (spdvector[i].data[A1]-spdvector[i].data[A2]>cfg(WLSlipExcess)?">":"<=")
+         << " (2)" << spddata[A1][i]-spddata[A2][i]
+         << (spddata[A1][i]-spddata[A2][i]>cfg(WLSlipExcess)?">":"<=")
          << cfg(WLSlipExcess); // no endl
 
       // CONDITION 1  ||  CONDITION 2
@@ -1570,20 +1570,20 @@ try {
       jp = jm = i;
       do {
          // find next good point in future
-         do { jp++; } while(jp < it->nend && !(spdvector[jp].flag & OK));
+         do { jp++; } while(jp < it->nend && !(spdflag[jp] & OK));
          if(jp >= it->nend) break;
             // CONDITION 4: test(A1) is a local maximum
-         if(spdvector[i].data[A1]-spdvector[jp].data[A1] > j*slope) pass4++;
+         if(spddata[A1][i]-spddata[A1][jp] > j*slope) pass4++;
             // CONDITION 5: limit(A2) is a local minimum
-         if(spdvector[i].data[A2]-spdvector[jp].data[A2] < -j*slope) pass5++;
+         if(spddata[A2][i]-spddata[A2][jp] < -j*slope) pass5++;
 
          // find next good point in past
-         do { jm--; } while(jm > it->nbeg && !(spdvector[jm].flag & OK));
+         do { jm--; } while(jm > it->nbeg && !(spdflag[jm] & OK));
          if(jm <= it->nbeg) break;
             // CONDITION 4: test(A1) is a local maximum
-         if(spdvector[i].data[A1]-spdvector[jm].data[A1] > j*slope) pass4++;
+         if(spddata[A1][i]-spddata[A1][jm] > j*slope) pass4++;
             // CONDITION 5: limit(A2) is a local minimum
-         if(spdvector[i].data[A2]-spdvector[jm].data[A2] < -j*slope) pass5++;
+         if(spddata[A2][i]-spddata[A2][jm] < -j*slope) pass5++;
 
       } while(++j < minMaxWidth);
 
@@ -1664,8 +1664,8 @@ try {
    if(which == string("WL")) {                                    // WL
       WLPassStats.Reset();
       for(i=kt->nbeg; i <= kt->nend; i++) {
-         if(!(spdvector[i].flag & OK)) continue;
-         WLPassStats.Add(spdvector[i].data[P1] - kt->bias1);
+         if(!(spdflag[i] & OK)) continue;
+         WLPassStats.Add(spddata[P1][i] - kt->bias1);
       }
       // NB Now you have a measure of range noise for the whole pass :
       // sigma(WLbias) ~ sigma(WLrange) = 0.71*sigma(range), so
@@ -1678,14 +1678,14 @@ try {
    else {                                                         // GF
       //dumpSegments("GFFbefRebias",2,true); //temp
       for(ifirst=-1,i=kt->nbeg; i <= kt->nend; i++) {
-         if(!(spdvector[i].flag & OK)) continue;
+         if(!(spdflag[i] & OK)) continue;
          if(ifirst == -1) {
             ifirst = i;
-            kt->bias2 = spdvector[ifirst].data[L2] + spdvector[ifirst].data[P2];
-            kt->bias1 = spdvector[ifirst].data[P1];
+            kt->bias2 = spddata[L2][ifirst] + spddata[P2][ifirst];
+            kt->bias1 = spddata[P1][ifirst];
          }
          // change the data - recompute GFR-GFP so it has one consistent bias
-         spdvector[i].data[L1] = spdvector[i].data[L2] + spdvector[i].data[P2];
+         spddata[L1][i] = spddata[L2][i] + spddata[P2][i];
       }
    }
 
@@ -1804,12 +1804,12 @@ try {
 
    // now do the fixing - change the data in the right segment to match left's
    for(i=right->nbeg; i<=right->nend; i++) {
-      //if(!(spdvector[i].flag & OK)) continue;
-      spdvector[i].data[P1] -= nwl;                                 // WLbias
-      spdvector[i].data[L2] -= nwl * wl2;                           // GFP
+      //if(!(spdflag[i] & OK)) continue;
+      spddata[P1][i] -= nwl;                                 // WLbias
+      spddata[L2][i] -= nwl * wl2;                           // GFP
       // add to WLStats
-      //if(!(spdvector[i].flag & OK)) continue;
-      //left->WLStats.Add(spdvector[i].data[P1] - left->bias1);
+      //if(!(spdflag[i] & OK)) continue;
+      //left->WLStats.Add(spddata[P1][i] - left->bias1);
    }
 
    // fix the slips beyond the 'right' segment.
@@ -1822,9 +1822,9 @@ try {
       // can build up and produce errors.
       it->bias1 -= dwl;
       for(i=it->nbeg; i<=it->nend; i++) {
-         //if(!(spdvector[i].flag & OK)) continue;                 // TD don't?
-         spdvector[i].data[P1] -= nwl;                                 // WLbias
-         spdvector[i].data[L2] -= nwl * wl2;                           // GFP
+         //if(!(spdflag[i] & OK)) continue;                 // TD don't?
+         spddata[P1][i] -= nwl;                                 // WLbias
+         spddata[L2][i] -= nwl * wl2;                           // GFP
       }
    }
 
@@ -1835,7 +1835,7 @@ try {
    SlipList.push_back(newSlip);
 
    // mark it
-   spdvector[right->nbeg].flag |= WLFIX;
+   spdflag[right->nbeg] |= WLFIX;
 
    return;
 }
@@ -1870,11 +1870,11 @@ try {
    nl = 0;
    ilast = -1;                               // ilast is last good point before slip
    while(nb > left->nbeg && i < Npts) {
-      if(spdvector[nb].flag & OK) {
+      if(spdflag[nb] & OK) {
          if(ilast == -1) ilast = nb;
          i++; nl++;
-         Lstats.Add(spdvector[nb].data[L1] - left->bias2);
-//log << "LDATA " << nb << " " << spdvector[nb].data[L1]-left->bias2 << endl;
+         Lstats.Add(spddata[L1][nb] - left->bias2);
+//log << "LDATA " << nb << " " << spddata[L1][nb]-left->bias2 << endl;
       }
       nb--;
    }
@@ -1882,10 +1882,10 @@ try {
    i = 1;
    nr = 0;
    while(ne < right->nend && i < Npts) {
-      if(spdvector[ne].flag & OK) {
+      if(spdflag[ne] & OK) {
          i++; nr++;
-         Rstats.Add(spdvector[ne].data[L1] - right->bias2);
-//log << "RDATA " << ne << " " << spdvector[ne].data[L1]-right->bias2 << endl;
+         Rstats.Add(spddata[L1][ne] - right->bias2);
+//log << "RDATA " << ne << " " << spddata[L1][ne]-right->bias2 << endl;
       }
       ne++;
    }
@@ -1897,8 +1897,8 @@ try {
    // ultimately, GFR-GFP is accurate but noisy.
    // rms rof should tell you how much weight to put on rof
    // larger rof -> smaller npts and larger degree
-   dn1 = spdvector[right->nbeg].data[L2] - right->bias2
-         - (spdvector[ilast].data[L2] - left->bias2);
+   dn1 = spddata[L2][right->nbeg] - right->bias2
+         - (spddata[L2][ilast] - left->bias2);
    // this screws up most fixes
    //dn1 = Rstats.Average() - right->bias2 - (Lstats.Average() - left->bias2);
    n1 = long(dn1 + (dn1 > 0 ? 0.5 : -0.5));
@@ -1955,10 +1955,10 @@ try {
    // now do the fixing : 'change the data' within right segment
    // and through the end of the pass, to fix the slip
    for(i=right->nbeg; i<size(); i++) {
-      //if(!(spdvector[i].flag & OK)) continue;                 // TD? don't?
-      //spdvector[i].data[P1] -= nwl;                           // no change to WLbias
-      spdvector[i].data[L2] -= n1;                              // GFP
-      spdvector[i].data[L1] -= n1;                              // GFR+GFP
+      //if(!(spdflag[i] & OK)) continue;                 // TD? don't?
+      //spddata[P1][i] -= nwl;                           // no change to WLbias
+      spddata[L2][i] -= n1;                              // GFP
+      spddata[L1][i] -= n1;                              // GFR+GFP
    }
 
    // 'change the bias'  for all segments in the future (although right to be deleted)
@@ -1983,7 +1983,7 @@ try {
    }
 
    // mark it
-   spdvector[right->nbeg].flag |= GFFIX;
+   spdflag[right->nbeg] |= GFFIX;
 
    return;
 }
@@ -2024,14 +2024,14 @@ try {
 
          // add all the data
          for(i=nb; i<=size_t(ne); i++) {
-            if(!(spdvector[i].flag & OK)) continue;
+            if(!(spdflag[i] & OK)) continue;
             PF[in[k]].Add(
                // data
-               spdvector[i].data[L2]
+               spddata[L2][i]
                // - (either               left bias - poss. slip : right bias)
                   - (i < right->nbeg ? left->bias2-n1-(nadj+k-1) : right->bias2),
                //  use a debiased count
-               spdvector[i].ndt - spdvector[nb].ndt
+               spdndt[i] - spdndt[nb]
             );
          }
 
@@ -2040,11 +2040,11 @@ try {
          // compute RMS residual of fit
          rmsrof[in[k]] = 0.0;
          for(i=nb; i<=size_t(ne); i++) {
-            if(!(spdvector[i].flag & OK)) continue;
+            if(!(spdflag[i] & OK)) continue;
             rof =    // data minus fit
-               spdvector[i].data[L2]
+               spddata[L2][i]
                   - (i < right->nbeg ? left->bias2-n1-(nadj+k-1) : right->bias2)
-               - PF[in[k]].Evaluate(spdvector[i].ndt - spdvector[nb].ndt);
+               - PF[in[k]].Evaluate(spdndt[i] - spdndt[nb]);
             rmsrof[in[k]] += rof*rof;
          }
          rmsrof[in[k]] = ::sqrt(rmsrof[in[k]]);
@@ -2108,15 +2108,15 @@ try {
 
    // dump the raw data with all the fits
    if(cfg(Debug) >= 4) for(i=nb; i<=size_t(ne); i++) {
-      if(!(spdvector[i].flag & OK)) continue;
+      if(!(spdflag[i] & OK)) continue;
       log << "GFE " << GDCUnique << " " << sat
          << " " << GDCUniqueFix
          << " " << printTime(time(i),outFormat)
-         << " " << setw(2) << spdvector[i].flag << fixed << setprecision(3);
-      for(k=0; k<3; k++) log << " " << spdvector[i].data[L2]
+         << " " << setw(2) << spdflag[i] << fixed << setprecision(3);
+      for(k=0; k<3; k++) log << " " << spddata[L2][i]
             - (i < right->nbeg ? left->bias2-n1-(nadj+k-1) : right->bias2)
-         << " " << PF[in[k]].Evaluate(spdvector[i].ndt - spdvector[nb].ndt);
-      log << " " << setw(3) << spdvector[i].ndt << endl;
+         << " " << PF[in[k]].Evaluate(spdndt[i] - spdndt[nb]);
+      log << " " << setw(3) << spdndt[i] << endl;
    }
 
    return nadj;
@@ -2149,14 +2149,14 @@ try {
    GFPassFit.Reset(ndeg);
 
    for(first=true,i=nbeg; i <= nend; i++) {
-      if(!(spdvector[i].flag & OK)) continue;
+      if(!(spdflag[i] & OK)) continue;
 
       // 'change the bias' (initial bias only) in the GFP by changing units, also
       // slip fixing in the WL may have changed the values of GFP
       if(first) {
 //temp uncomment next 3 lines then comment again
-         //if(fabs(spdvector[i].data[L2] - SegList.begin()->bias2) > 10.*wl21) {
-         //   SegList.begin()->bias2 = spdvector[i].data[L2];
+         //if(fabs(spddata[L2][i] - SegList.begin()->bias2) > 10.*wl21) {
+         //   SegList.begin()->bias2 = spddata[L2][i];
          //}
          SegList.begin()->bias2 /= wl21;
          first = false;
@@ -2164,18 +2164,18 @@ try {
 
       // 'change the arrays'
       // change units on the GFP and the GFR
-      spdvector[i].data[P2] /= wl21;                    // -gfr (cycles of wl21)
-      spdvector[i].data[L2] /= wl21;                    // gfp (cycles of wl21)
+      spddata[P2][i] /= wl21;                    // -gfr (cycles of wl21)
+      spddata[L2][i] /= wl21;                    // gfp (cycles of wl21)
 
       // compute polynomial fit
-      GFPassFit.Add(spdvector[i].data[P2],spdvector[i].ndt);
+      GFPassFit.Add(spddata[P2][i],spdndt[i]);
 
       // 'change the data'
       // save in L1                          // gfp+gfr residual (cycles of wl21)
-      // ?? spdvector[i].data[L1] =
-      //    spdvector[i].data[L2] - spdvector[i].data[P2] - SegList.begin()->bias2;
+      // ?? spddata[L1][i] =
+      //    spddata[L2][i] - spddata[P2][i] - SegList.begin()->bias2;
 // temp add -bias2  then remove it again
-      spdvector[i].data[L1] = spdvector[i].data[L2] - spdvector[i].data[P2];
+      spddata[L1][i] = spddata[L2][i] - spddata[P2][i];
                                  // - SegList.begin()->bias2;
    }
 
@@ -2214,15 +2214,15 @@ try {
 
       // compute stats on dGF/dt
       for(i=it->nbeg; i <= it->nend; i++) {
-         if(!(spdvector[i].flag & OK)) continue;
+         if(!(spdflag[i] & OK)) continue;
 
          // compute first-diff stats in meters
          // skip the first point in a segment - it is an obvious GF slip
-         if(i > it->nbeg) GFPassStats.Add(spdvector[i].data[A1]*wl21);
+         if(i > it->nbeg) GFPassStats.Add(spddata[A1][i]*wl21);
 
          // if a gross GF slip was found, must remove bias in L1=GF(R-P)
          // in all subsequent segments ; 'change the data' L1
-         //temp if(it != SegList.begin()) spdvector[i].data[L1] += bias - it->bias2;
+         //temp if(it != SegList.begin()) spddata[L1][i] += bias - it->bias2;
 
       }  // end loop over data in segment it
 
@@ -2290,8 +2290,8 @@ try {
    it->PF.Reset(ndeg);     // for fit to GF range
 
    for(i=it->nbeg; i <= it->nend; i++) {
-      if(!(spdvector[i].flag & OK)) continue;
-      it->PF.Add(spdvector[i].data[P2],spdvector[i].ndt);
+      if(!(spdflag[i] & OK)) continue;
+      it->PF.Add(spddata[P2][i],spdndt[i]);
    }
 
    if(it->PF.isSingular()) {     // this should never happen
@@ -2305,41 +2305,41 @@ try {
    rofStats.Reset();
    for(i=it->nbeg; i <= it->nend; i++) {
       // skip bad data
-      if(!(spdvector[i].flag & OK)) continue;
+      if(!(spdflag[i] & OK)) continue;
 
       // TD? Use whole pass for small segments?
-      //fit = GFPassFit.Evaluate(spdvector[i].ndt);  // use fit to gfr for whole pass
-      fit = it->PF.Evaluate(spdvector[i].ndt);
+      //fit = GFPassFit.Evaluate(spdndt[i]);  // use fit to gfr for whole pass
+      fit = it->PF.Evaluate(spdndt[i]);
 
       // all (fit, resid, gfr and gfp) are in cycles of wl21 (5.4cm)
 
       // compute gfp-(fit to gfr), store in A1 - 'change the arrays' A1 and A2
       // OR let's try first difference of residual of fit
       //           residual =  phase                            - fit to range
-      spdvector[i].data[A1] = spdvector[i].data[L2] - it->bias2 - fit;
+      spddata[A1][i] = spddata[L2][i] - it->bias2 - fit;
       if(rbias == 0.0) {
-         rbias = spdvector[i].data[A1];
-         nprev = spdvector[i].ndt - 1;
+         rbias = spddata[A1][i];
+         nprev = spdndt[i] - 1;
       }
-      spdvector[i].data[A1] -= rbias;                    // debias residual for plots
+      spddata[A1][i] -= rbias;                    // debias residual for plots
 
          // compute stats on residual of fit
-      rofStats.Add(spdvector[i].data[A1]);
+      rofStats.Add(spddata[A1][i]);
 
       if(1) { // 1stD of residual - remember A1 has just been debiased
-         tmp = spdvector[i].data[A1];
-         spdvector[i].data[A1] -= prev;       // diff with previous epoch's
+         tmp = spddata[A1][i];
+         spddata[A1][i] -= prev;       // diff with previous epoch's
          // 040809 should this be divided by delta n?
-         // spdvector[i].data[A1] /= (spdvector[i].ndt - nprev);
+         // spddata[A1][i] /= (spdndt[i] - nprev);
          prev = tmp;          // store residual for next point
-         nprev = spdvector[i].ndt;
+         nprev = spdndt[i];
       }
 
       // store fit in A2
-      //spdvector[i].data[A2] = fit;                   // fit to gfr (cycles of wl21)
+      //spddata[A2][i] = fit;                   // fit to gfr (cycles of wl21)
       // store raw residual GFP-GFR (cycles of wl21) in A2
-      //spdvector[i].data[A2]
-      //    = spdvector[i].data[L2] - it->bias2 - spdvector[i].data[P2];
+      //spddata[A2][i]
+      //    = spddata[L2][i] - it->bias2 - spddata[P2][i];
    }
 
    // TD? need this? use this?
@@ -2393,21 +2393,21 @@ try {
       for(iplus=it->nbeg; iplus<=it->nend+width; iplus++) {
 
          // ignore bad points
-         if(iplus <= it->nend && !(spdvector[iplus].flag & OK)) continue;
+         if(iplus <= it->nend && !(spdflag[iplus] & OK)) continue;
          if(ifirst == -1) ifirst = iplus;
 
          // pop the new i from the future
          if(futureIndex.size() == width || iplus > it->nend) {
             inew = futureIndex.front();
             futureIndex.pop_front();
-            futureStats.Subtract(spdvector[inew].data[A1]);
+            futureStats.Subtract(spddata[A1][inew]);
             nok++;
          }
 
          // put iplus into the future deque
          if(iplus <= it->nend) {
             futureIndex.push_back(iplus);
-            futureStats.Add(spdvector[iplus].data[A1]);
+            futureStats.Add(spddata[A1][iplus]);
          }
          else
             futureIndex.push_back(-1);
@@ -2423,15 +2423,15 @@ try {
          if(foundGFoutlier(i,inew,pastStats,futureStats)) {
             // check that i was not marked a slip in the last iteration
             // if so, let inew be the slip and i the outlier
-            if(spdvector[i].flag & DETECT) {
+            if(spdflag[i] & DETECT) {
                //log << "Warning - marking a slip point BAD in GF detect small "
                //   << GDCUnique << " " << sat
                //   << " " << time(i).printf(outFormat) << " " << i << endl;
-               spdvector[inew].flag = spdvector[i].flag;
+               spdflag[inew] = spdflag[i];
                it->nbeg = inew;
             }
-            spdvector[i].flag = BAD;
-            spdvector[inew].data[A1] += spdvector[i].data[A1];
+            spdflag[i] = BAD;
+            spddata[A1][inew] += spddata[A1][i];
             learn["points deleted: GF outlier"]++;
             i = inew;
             nok--;
@@ -2441,13 +2441,13 @@ try {
          if(pastIndex.size() == width) {
             j = pastIndex.front();
             pastIndex.pop_front();
-            pastStats.Subtract(spdvector[j].data[A1]);
+            pastStats.Subtract(spddata[A1][j]);
          }
 
          // move i into the past
          if(i > -1) {
             pastIndex.push_back(i);
-            pastStats.Add(spdvector[i].data[A1]);
+            pastStats.Add(spddata[A1][i]);
          }
 
          // return to original state
@@ -2463,7 +2463,7 @@ try {
             nok = 1;
 
             // mark it
-            spdvector[i].flag |= GFDETECT;
+            spdflag[i] |= GFDETECT;
 
             // TD print the "possible GF slip" and timetag here - see WLS
          }
@@ -2487,8 +2487,8 @@ bool GDCPass::foundGFoutlier(int i, int inew,
 {
 try {
    if(i < 0 || inew < 0) return false;
-   double pmag = spdvector[i].data[A1]; // -pastSt.Average();
-   double fmag = spdvector[inew].data[A1]; // -futureSt.Average();
+   double pmag = spddata[A1][i]; // -pastSt.Average();
+   double fmag = spddata[A1][inew]; // -futureSt.Average();
    double var = ::sqrt(pastSt.Variance() + futureSt.Variance());
 
    ostringstream oss;
@@ -2547,8 +2547,8 @@ try {
    pmag = fmag = pvar = fvar = 0.0;
    // note when past.N == 1, this is first good point, which has 1stD==0
    // TD be very careful when N is small
-   if(pastSt.N() > 0) pmag = spdvector[i].data[A1]-pastSt.Average();
-   if(futureSt.N() > 0) fmag = spdvector[i].data[A1]-futureSt.Average();
+   if(pastSt.N() > 0) pmag = spddata[A1][i]-pastSt.Average();
+   if(futureSt.N() > 0) fmag = spddata[A1][i]-futureSt.Average();
    if(pastSt.N() > 1) pvar = pastSt.Variance();
    if(futureSt.N() > 1) fvar = futureSt.Variance();
    mag = (pmag + fmag) / 2.0;
@@ -2576,7 +2576,7 @@ try {
       << " " << setw(7) << futureSt.StdDev()
       << " " << setw(7) << mag
       << " " << setw(7) << ::sqrt(pvar+fvar)
-      << " " << setw(9) << spdvector[i].data[A1]
+      << " " << setw(9) << spddata[A1][i]
       << " " << setw(7) << pmag
       << " " << setw(7) << pvar
       << " " << setw(7) << fmag
@@ -2646,10 +2646,10 @@ try {
          double magGFR,mtnGFR;
          Stats<double> pGFRmPh,fGFRmPh;
          for(size_t jj=0; jj<pastIn.size(); jj++) {
-            if(pastIn[jj] > -1) pGFRmPh.Add(spdvector[pastIn[jj]].data[L1]);
-            if(futureIn[jj] > -1) fGFRmPh.Add(spdvector[futureIn[jj]].data[L1]);
+            if(pastIn[jj] > -1) pGFRmPh.Add(spddata[L1][pastIn[jj]]);
+            if(futureIn[jj] > -1) fGFRmPh.Add(spddata[L1][futureIn[jj]]);
          }
-         magGFR = spdvector[i].data[L1] - (pGFRmPh.Average()+fGFRmPh.Average())/2.0;
+         magGFR = spddata[L1][i] - (pGFRmPh.Average()+fGFRmPh.Average())/2.0;
          mtnGFR = fabs(magGFR)/::sqrt(pGFRmPh.Variance()+fGFRmPh.Variance());
 
          if(cfg(Debug) >= 6)
@@ -2677,15 +2677,15 @@ try {
          Stats<double> fdStats;
          j = i-1; k=0;
          while(j >= ibeg && k < 15) {
-            if(spdvector[j].flag & OK) { fdStats.Add(spdvector[j].data[A2]); k++; }
+            if(spdflag[j] & OK) { fdStats.Add(spddata[A2][j]); k++; }
             j--;
          }
          j = i+1; k=0;
          while(j <= iend && k < 15) {
-            if(spdvector[j].flag & OK) { fdStats.Add(spdvector[j].data[A2]); k++; }
+            if(spdflag[j] & OK) { fdStats.Add(spddata[A2][j]); k++; }
             j++;
          }
-         magFD = spdvector[i].data[A2] - fdStats.Average();
+         magFD = spddata[A2][i] - fdStats.Average();
 
          if(cfg(Debug) >= 6)
             oss << " (7)1stD(GFP)mag=" << magFD
@@ -2719,24 +2719,24 @@ try {
    // loop over the data and look for points with GFDETECT but not WLDETECT or WLFIX
    for(size_t i=0; i<size(); i++) {
 
-      if(!(spdvector[i].flag & OK)) continue;        // bad
-      if(!(spdvector[i].flag & DETECT)) continue;    // no slips
-      if(spdvector[i].flag & WLDETECT) continue;     // WL was detected
+      if(!(spdflag[i] & OK)) continue;        // bad
+      if(!(spdflag[i] & DETECT)) continue;    // no slips
+      if(spdflag[i] & WLDETECT) continue;     // WL was detected
 
       // GF only slip - compute WL stats on both sides
       Stats<double> futureStats,pastStats;
       size_t k = i;
       // fill future
       while(k < size() && futureStats.N() < N) {
-         if(spdvector[k].flag & OK)                  // data is good
-            futureStats.Add(spdvector[k].data[P1]);        // wlbias
+         if(spdflag[k] & OK)                  // data is good
+            futureStats.Add(spddata[P1][k]);        // wlbias
          k++;
       }
       // fill past
       int j = i-1;
       while(j >= 0 && pastStats.N() < N) {
-         if(spdvector[j].flag & OK)                  // data is good
-            pastStats.Add(spdvector[j].data[P1]);          // wlbias
+         if(spdflag[j] & OK)                  // data is good
+            pastStats.Add(spddata[P1][j]);          // wlbias
          j--;
       }
 
@@ -2758,9 +2758,9 @@ try {
 
          // now do the fixing - change the data to the future of the slip
          for(k=i; k<size(); k++) {
-            //if(!(spdvector[i].flag & OK)) continue;
-            spdvector[k].data[P1] -= nwl;                                 // WLbias
-            spdvector[k].data[L2] -= nwl * factor;                        // GFP
+            //if(!(spdflag[i] & OK)) continue;
+            spddata[P1][k] -= nwl;                                 // WLbias
+            spddata[L2][k] -= nwl * factor;                        // GFP
          }
 
          // Add to slip list
@@ -2770,7 +2770,7 @@ try {
          SlipList.push_back(newSlip);
 
          // mark it
-         spdvector[i].flag |= (WLDETECT + WLFIX);
+         spdflag[i] |= (WLDETECT + WLFIX);
 
          if(cfg(Debug) >= 7) log << "CHECK " << GDCUnique << " " << sat
             << " " << i
@@ -2833,7 +2833,7 @@ try {
    for(i=0; i<size(); i++) {
 
       // is this point bad?
-      if(!(spdvector[i].flag & OK)) {       // data is bad
+      if(!(spdflag[i] & OK)) {       // data is bad
          ok = false;
          if(i == size() - 1) {    // but this is the last point
             i++;
@@ -2930,31 +2930,28 @@ try {
       if(i >= size()) break;
 
       // 'change the data' for the last time
-      spdvector[i].data[L1] = svp.data(i,DCobstypes[L1]) - slipL1;
-      spdvector[i].data[L2] = svp.data(i,DCobstypes[L2]) - slipL2;
-      spdvector[i].data[P1] = svp.data(i,DCobstypes[P1]);
-      spdvector[i].data[P2] = svp.data(i,DCobstypes[P2]);
+      spddata[L1][i] = svp.data(i,DCobstypes[L1]) - slipL1;
+      spddata[L2][i] = svp.data(i,DCobstypes[L2]) - slipL2;
+      spddata[P1][i] = svp.data(i,DCobstypes[P1]);
+      spddata[P2][i] = svp.data(i,DCobstypes[P2]);
 
       // compute range minus phase for output
       // do the same at the beginning ("BEG")
 
       // compute WL and GFP
          // narrow lane range (m)
-      double wlr = wl1r * spdvector[i].data[P1] + wl2r * spdvector[i].data[P2];
+      double wlr = wl1r * spddata[P1][i] + wl2r * spddata[P2][i];
          // wide lane phase (m)
-      double wlp = wl1p * spdvector[i].data[L1] + wl2p * spdvector[i].data[L2];
-         // geo-free range (m)
-      double gfr = gf1r * spdvector[i].data[P1] + gf2r * spdvector[i].data[P2];
-#pragma unused(gfr)
+      double wlp = wl1p * spddata[L1][i] + wl2p * spddata[L2][i];
          // geo-free phase (m)
-      double gfp = gf1p * spdvector[i].data[L1] + gf2p * spdvector[i].data[L2];
+      double gfp = gf1p * spddata[L1][i] + gf2p * spddata[L2][i];
       if(i == ifirst) {
          WLbias = (wlp-wlr)/wlwl;
          GFbias = gfp;
       }
-      spdvector[i].data[A1] = (wlp-wlr)/wlwl - WLbias; // wide lane bias (cyc)
-      spdvector[i].data[A2] = gfp - GFbias;            // geo-free phase (m)
-      //spdvector[i].data[A2] = gfr - gfp;             // geo-free range - phase (m)
+      spddata[A1][i] = (wlp-wlr)/wlwl - WLbias; // wide lane bias (cyc)
+      spddata[A2][i] = gfp - GFbias;            // geo-free phase (m)
+      //spddata[A2][i] = gfr - gfp;             // geo-free range - phase (m)
 
    } // end loop over all data
 
@@ -2976,10 +2973,10 @@ try {
    // ---------------------------------------------------------
    // copy corrected data into original SatPass, without disturbing other obs types
    for(i=0; i<size(); i++) {
-      svp.data(i,DCobstypes[L1]) = spdvector[i].data[L1];
-      svp.data(i,DCobstypes[L2]) = spdvector[i].data[L2];
-      svp.data(i,DCobstypes[P1]) = spdvector[i].data[P1];
-      svp.data(i,DCobstypes[P2]) = spdvector[i].data[P2];
+      svp.data(i,DCobstypes[L1]) = spddata[L1][i];
+      svp.data(i,DCobstypes[L2]) = spddata[L2][i];
+      svp.data(i,DCobstypes[P1]) = spddata[P1][i];
+      svp.data(i,DCobstypes[P2]) = spddata[P2][i];
 
       // change the flag for use by SatPass
       //const unsigned short SatPass::OK  = 1; good data
@@ -2989,20 +2986,20 @@ try {
       //const unsigned short SatPass::LL3 = 6; discontinuity on L1 and L2
       //const unsigned short GDCPass::DETECT   =   6;  // = WLDETECT | GFDETECT
       //const unsigned short GDCPass::FIX      =  24;  // = WLFIX | GFFIX
-      if(spdvector[i].flag & OK) {
-//??     if(((spdvector[i].flag & DETECT)!=0 && (spdvector[i].flag & FIX)==0)
-         if(((spdvector[i].flag & DETECT)==0 && (spdvector[i].flag & FIX)!=0)
+      if(spdflag[i] & OK) {
+//??     if(((spdflag[i] & DETECT)!=0 && (spdflag[i] & FIX)==0)
+         if(((spdflag[i] & DETECT)==0 && (spdflag[i] & FIX)!=0)
             || i == ifirst)
-            spdvector[i].flag = LL3 + OK;
+            spdflag[i] = LL3 + OK;
          else
-            spdvector[i].flag = OK;
+            spdflag[i] = OK;
       }
       else
-         spdvector[i].flag = BAD;
+         spdflag[i] = BAD;
 
-      svp.LLI(i,DCobstypes[L1]) = (spdvector[i].flag & LL1) ? 1 : 0;
-      svp.LLI(i,DCobstypes[L2]) = (spdvector[i].flag & LL2) ? 1 : 0;
-      svp.setFlag(i,spdvector[i].flag);
+      svp.LLI(i,DCobstypes[L1]) = (spdflag[i] & LL1) ? 1 : 0;
+      svp.LLI(i,DCobstypes[L2]) = (spdflag[i] & LL2) ? 1 : 0;
+      svp.setFlag(i,spdflag[i]);
    }
 
    // ---------------------------------------------------------
@@ -3102,8 +3099,8 @@ try {
    sit->nend = ibeg-1;
 
    // 'trim' beg and end indexes
-   while(s.nend > s.nbeg && !(spdvector[s.nend].flag & OK)) s.nend--;
-   while(sit->nend > sit->nbeg && !(spdvector[sit->nend].flag & OK)) sit->nend--;
+   while(s.nend > s.nbeg && !(spdflag[s.nend] & OK)) s.nend--;
+   while(sit->nend > sit->nbeg && !(spdflag[sit->nend] & OK)) sit->nend--;
 
    // get the segment number right
    s.nseg++;
@@ -3152,8 +3149,8 @@ try {
    ilast = -1;                               // last good point
    for(it=SegList.begin(); it != SegList.end(); it++) {
       //if(it->npts > 0) {
-      //   biaswl = spdvector[it->nbeg].data[P1];
-      //   biasgf = spdvector[it->nbeg].data[L2];
+      //   biaswl = spddata[P1][it->nbeg];
+      //   biasgf = spddata[L2][it->nbeg];
       //}
       //else biaswl = biasgf = 0.0;
 
@@ -3173,13 +3170,13 @@ try {
             << " bias(gf)=" << setw(13) << it->bias2; //biasgf;
          if(ilast > -1) {
             ifirst = it->nbeg;
-            while(ifirst <= it->nend && !(spdvector[ifirst].flag & OK)) ifirst++;
-            i = spdvector[ifirst].ndt - spdvector[ilast].ndt;
+            while(ifirst <= it->nend && !(spdflag[ifirst] & OK)) ifirst++;
+            i = spdndt[ifirst] - spdndt[ilast];
             oss << " Gap " << setprecision(1) << setw(5)
                << cfg(DT)*i << " s = " << i << " pts.";
          }
          ilast = it->nend;
-         while(ilast >= it->nbeg && !(spdvector[ilast].flag & OK)) ilast--;
+         while(ilast >= it->nbeg && !(spdflag[ilast] & OK)) ilast--;
       }
 
       oss << endl;
@@ -3192,20 +3189,20 @@ try {
       // dump the data
    for(it=SegList.begin(); it != SegList.end(); it++) {
       for(i=it->nbeg; i<=it->nend; i++) {
-         //if(!(spdvector[i].flag & OK)) continue;  //dfplot ignores bad data
+         //if(!(spdflag[i] & OK)) continue;  //dfplot ignores bad data
 
          log << "DSC" << label << " " << GDCUnique << " " << sat << " " << it->nseg
             << " " << printTime(time(i),outFormat)
-            << " " << setw(3) << spdvector[i].flag
+            << " " << setw(3) << spdflag[i]
             << fixed << setprecision(3)
-            << " " << setw(13) << spdvector[i].data[L1] - it->bias2 //biasgf  //temp
-            << " " << setw(13) << spdvector[i].data[L2] - it->bias2 //biasgf
-            << " " << setw(13) << spdvector[i].data[P1] - it->bias1 //biaswl
-            << " " << setw(13) << spdvector[i].data[P2];
+            << " " << setw(13) << spddata[L1][i] - it->bias2 //biasgf  //temp
+            << " " << setw(13) << spddata[L2][i] - it->bias2 //biasgf
+            << " " << setw(13) << spddata[P1][i] - it->bias1 //biaswl
+            << " " << setw(13) << spddata[P2][i];
          if(extra) log
-            << " " << setw(13) << spdvector[i].data[A1]
-            << " " << setw(13) << spdvector[i].data[A2];
-         log << " " << setw(4) << i;          // TD? make this spdvector[i].ndt?
+            << " " << setw(13) << spddata[A1][i]
+            << " " << setw(13) << spddata[A2][i];
+         log << " " << setw(4) << i;          // TD? make this spdndt[i]?
          if(i == it->nbeg) log
             << " " << setw(13) << it->bias1 //biaswl
             << " " << setw(13) << it->bias2; //biasgf;
@@ -3234,10 +3231,10 @@ try {
       << endl;
 
    it->npts = 0;
-   for(i=it->nbeg; i<=it->nend; i++) if(spdvector[i].flag & OK) {
+   for(i=it->nbeg; i<=it->nend; i++) if(spdflag[i] & OK) {
       // count these : learn
       learn["points deleted: " + msg]++;
-      spdvector[i].flag = BAD;
+      spdflag[i] = BAD;
    }
 
    learn["segments deleted: " + msg]++;
@@ -153,15 +153,36 @@ void SRIFilter::measurementUpdate(const Matrix<double>& H,
    }
    try {
       Matrix<double> P(H);
-      Cholesky<double> Ch;
+      Matrix<double> L;
 
-         // whiten partials and data
+         // whiten partials and data: P = inverse(L)*P and D = inverse(L)*D, by
+         // forward substitution since L is lower triangular. Zeros in P are
+         // skipped, and each column of L only down to its last non-zero, since
+         // the measurement covariance is often block diagonal.
       if(&CM != &SRINullMatrix) {
-         Matrix<double> L;
-         Ch(CM);
-         L = inverse(Ch.L);
-         P = L * P;
-         D = L * D;
+         L = lowerCholesky(CM);
+         const unsigned int m(D.size()), n(P.cols());
+         unsigned int i,j,k;
+         vector<unsigned int> last(m);
+         for(j=0; j<m; j++) {
+            last[j] = j+1;
+            for(i=j+1; i<m; i++)
+               if(L(i,j) != 0.0) last[j] = i+1;
+         }
+         for(k=0; k<n; k++) {
+            for(j=0; j<m; j++) {
+               if(P(j,k) == 0.0) continue;
+               P(j,k) /= L(j,j);
+               for(i=j+1; i<last[j]; i++)
+                  P(i,k) -= L(i,j) * P(j,k);
+            }
+         }
+         for(j=0; j<m; j++) {
+            if(D(j) == 0.0) continue;
+            D(j) /= L(j,j);
+            for(i=j+1; i<last[j]; i++)
+               D(i) -= L(i,j) * D(j);
+         }
       }
 
          // update *this with the whitened information
@@ -169,7 +190,7 @@ void SRIFilter::measurementUpdate(const Matrix<double>& H,
 
          // un-whiten residuals
       if(&CM != &SRINullMatrix) {
-         D = Ch.L * D;
+         D = L * D;
       }
    }
    catch(MatrixException& me) { GPSTK_RETHROW(me); }
@@ -319,6 +340,8 @@ void SRIFilter::Reset(const int N)
 // (n)  |     G    PhiInv  Z   |
 //       -                    -
 // then the (upper triangular) matrix R is copied out of PhiInv into R.
+// The transformation is done by SrifHouseholder(), which for large problems
+// applies it in panels of columns; the product R*PhiInv skips the zeros of R.
 // -------------------------------------------------------------------
 //    The matrix Rwx is related to the sensitivity of the state
 // estimate to the unmodeled parameters in Zw.  The sensitivity matrix
@@ -343,10 +366,8 @@ void SRIFilter::SrifTU(Matrix<T>& R,
                        Matrix<T>& Rwx)
    throw(MatrixException)
 {
-   const T EPS=-T(1.e-200);
    unsigned int n=R.rows(),ns=Rw.rows();
-   unsigned int i,j,k;
-   T sum, beta, delta, dum;
+   unsigned int i,j;
 
    if(PhiInv.rows() < n || PhiInv.cols() < n ||
       G.rows() < n || G.cols() < ns ||
@@ -373,112 +394,44 @@ void SRIFilter::SrifTU(Matrix<T>& R,
    try {
       // initialize
       Rwx = T(0);
-      PhiInv = R * PhiInv;                   // set PhiInv = Rd = R*PhiInv
+      PhiInv = UTtimes(R,PhiInv);            // set PhiInv = Rd = R*PhiInv
       G = -PhiInv * G;
       // fixed Matrix problem - unary minus should not return an l-value
       //G = -(PhiInv * G);                     // set G = -Rd*G
 
-      // temp
-      //Matrix <T> A;
-      //A = (Rw || Rwx || Zw) && (G || PhiInv || Z);
+      // concatenate A = (Rw || Rwx || Zw) && (G || PhiInv || Z)
+      Matrix<T> A(ns+n,ns+n+1,T(0));
+      for(j=0; j<ns; j++) {
+         for(i=0; i<=j; i++) A(i,j) = Rw(i,j);
+         for(i=0; i<n; i++) A(ns+i,j) = G(i,j);
+         A(j,ns+n) = Zw(j);
+      }
+      for(j=0; j<n; j++) {
+         for(i=0; i<n; i++) A(ns+i,ns+j) = PhiInv(i,j);
+         A(ns+j,ns+n) = Z(j);
+      }
       //cout << "SrifTU - :\n" << fixed << setw(10) << setprecision(5) << A << endl;
 
       //---------------------------------------------------------------
-      for(j=0; j<ns; j++) {               // loop over first ns columns
-         sum = T(0);
-         for(i=0; i<n; i++)               // rows of -Rd*G
-            sum += G(i,j)*G(i,j);
-         dum = Rw(j,j);
-         sum += dum*dum;
-         sum = (dum > T(0) ? -T(1) : T(1)) * ::sqrt(sum);
-         delta = dum - sum;
-         Rw(j,j) = sum;
-
-         beta = sum * delta;
-         if(beta > EPS) continue;
-         beta = T(1)/beta;
-
-            // apply jth Householder transformation
-            // to submatrix below and right of (j,j)
-         if(j+1 < ns) {                   // apply to G
-            for(k=j+1; k<ns; k++) {       // columns to right of diagonal
-               sum = delta * Rw(j,k);
-               for(i=0; i<n; i++)         // rows of G
-                  sum += G(i,j)*G(i,k);
-               if(sum == T(0)) continue;
-               sum *= beta;
-               Rw(j,k) += sum*delta;
-               for(i=0; i<n; i++)         // rows of G again
-                  G(i,k) += sum * G(i,j);
-            }
-         }
+      // Householder transformation of the first ns+n columns; Rw is upper
+      // triangular, so for the first ns columns only the diagonal and the rows
+      // of G are involved.
+      SrifHouseholder(A,ns,ns+n,false);
 
-            // apply jth Householder transformation
-            // to Rwx and PhiInv
-         for(k=0; k<n; k++) {             // columns of Rwx and PhiInv
-            sum = delta * Rwx(j,k);
-            for(i=0; i<n; i++)            // rows of PhiInv and G
-               sum += PhiInv(i,k) * G(i,j);
-            if(sum == T(0)) continue;
-            sum *= beta;
-            Rwx(j,k) += sum*delta;
-            for(i=0; i<n; i++)            // rows of PhiInv and G
-               PhiInv(i,k) += sum * G(i,j);
-         }                                // end loop over columns of Rwx and PhiInv
-
-            // apply jth Householder transformation
-            // to Zw and Z
-         sum = delta * Zw(j);
-         for(i=0; i<n; i++)               // rows of G and elements of Z
-            sum += Z(i) * G(i,j);
-         if(sum == T(0)) continue;
-         sum *= beta;
-         Zw(j) += sum * delta;
-         for(i=0; i<n; i++)               // rows of G and elements of Z
-            Z(i) += sum * G(i,j);
-      }                                   // end loop over first ns columns
-
-      //---------------------------------------------------------------
-      for(j=0; j<n; j++) {                // loop over columns of Rwx and PhiInv
-         sum = T(0);
-         for(i=j+1; i<n; i++)             // rows of PhiInv
-            sum += PhiInv(i,j)*PhiInv(i,j);
-         dum = PhiInv(j,j);
-         sum += dum*dum;
-         sum = (dum > T(0) ? -T(1) : T(1)) * ::sqrt(sum);
-         delta = dum - sum;
-         PhiInv(j,j) = sum;
-         beta = sum*delta;
-         if(beta > EPS) continue;
-         beta = T(1)/beta;
-
-            // apply jth Householder transformation to columns of PhiInv on row j
-         for(k=j+1; k<n; k++) {           // columns of PhiInv
-            sum = delta * PhiInv(j,k);
-            for(i=j+1; i<n; i++)
-               sum += PhiInv(i,j)*PhiInv(i,k);
-            if(sum == T(0)) continue;
-            sum *= beta;
-            PhiInv(j,k) += sum*delta;
-            for(i=j+1; i<n; i++)
-               PhiInv(i,k) += sum * PhiInv(i,j);
-         }
-
-            // apply jth Householder transformation to Z
-         sum = delta *Z(j);
-         for(i=j+1; i<n; i++)
-            sum += Z(i) * PhiInv(i,j);
-         if(sum == T(0)) continue;
-         sum *= beta;
-         Z(j) += sum*delta;
-         for(i=j+1; i<n; i++)
-            Z(i) += sum * PhiInv(i,j);
-      }                                   // end loop over cols of Rwx and PhiInv
-
-      // temp
-      //A = (Rw || Rwx || Zw) && (G || PhiInv || Z);
       //cout << "SrifTU + :\n" << fixed << setw(10) << setprecision(5) << A << endl;
 
+         // copy out Rw, Rwx and Zw, and the transformed G, PhiInv and Z
+      for(j=0; j<ns; j++) {
+         for(i=0; i<=j; i++) Rw(i,j) = A(i,j);
+         for(i=0; i<n; i++) G(i,j) = A(ns+i,j);
+         Zw(j) = A(j,ns+n);
+      }
+      for(j=0; j<n; j++) {
+         for(i=0; i<ns; i++) Rwx(i,j) = A(i,ns+j);
+         for(i=0; i<n; i++) PhiInv(i,j) = A(ns+i,ns+j);
+         Z(j) = A(ns+j,ns+n);
+      }
+
          // copy transformed R out of PhiInv
       for(j=0; j<n; j++)
          for(i=0; i<=j; i++)
@@ -556,6 +509,8 @@ void SRIFilter::SrifTU(Matrix<T>& R,
 // (N)  |   G    Phi   z    |
 //       -                 -
 // then the (upper triangular) matrix R is copied out of Phi into R.
+// The transformation is done by SrifHouseholder(), which for large problems
+// applies it in panels of columns.
 //
 // Ref: Bierman, G.J. "Factorization Methods for Discrete Sequential
 //      Estimation," Academic Press, 1977, pg 216.
@@ -593,143 +548,45 @@ void SRIFilter::SrifSU(Matrix<T>& R,
       GPSTK_THROW(me);
    }
 
-   const T EPS=-T(1.e-200);
-   size_t i, j, k;
-   T sum, beta, delta, diag;
+   size_t i, j;
 
 try {
       // Rw+Rwx*G -> A
    Matrix<T> A;
    A = Rw + Rwx*G;
    Rwx = Rwx * Phi;
-   Phi = R * Phi;
-   G = R * G;
+   Phi = UTtimes(R,Phi);
+   G = UTtimes(R,G);
+
+      // concatenate B = (A || Rwx || Zw) && (G || Phi || Z)
+   Matrix<T> B(Ns+N,Ns+N+1,T(0));
+   for(j=0; j<Ns; j++) {
+      for(i=0; i<Ns; i++) B(i,j) = A(i,j);
+      for(i=0; i<N; i++) B(Ns+i,j) = G(i,j);
+      B(j,Ns+N) = Zw(j);
+   }
+   for(j=0; j<N; j++) {
+      for(i=0; i<Ns; i++) B(i,Ns+j) = Rwx(i,j);
+      for(i=0; i<N; i++) B(Ns+i,Ns+j) = Phi(i,j);
+      B(Ns+j,Ns+N) = Z(j);
+   }
 
          //-----------------------------------------
-         // HouseHolder Transformation
-
-         // Loop over first Ns columns
-   for(j=0; j<Ns; j++) {                  // columns of A
-      sum = T(0);
-      for(i=j+1; i<Ns; i++) {             // rows i below diagonal in A
-         sum += A(i,j) * A(i,j);
-      }
-      for(i=0; i<N; i++) {                // all rows i in G
-         sum += G(i,j) * G(i,j);
-      }
+         // HouseHolder Transformation, of the first Ns columns (A and G) and then
+         // of the columns past the Ns block (Rwx and Phi); A is not triangular.
+   SrifHouseholder(B,0,Ns+N,false);
 
-      diag = A(j,j);
-      sum += diag*diag;
-      sum = (diag > T(0) ? -T(1) : T(1)) * ::sqrt(sum);
-      delta = diag - sum;
-      A(j,j) = sum;
-      beta = sum*delta;
-      if(beta > EPS) continue;
-      beta = T(1)/beta;
-
-            // apply jth HH trans to submatrix below and right of j,j
-      for(k=j+1; k<Ns; k++) {                // cols to right of diag
-         sum = delta * A(j,k);
-         for(i=j+1; i<Ns; i++) {             // rows of A below diagonal
-            sum += A(i,j)*A(i,k);
-         }
-         for(i=0; i<N; i++) {                // all rows of G
-            sum += G(i,j)*G(i,k);
-         }
-         if(sum == T(0)) continue;
-         sum *= beta;
-            //------------------------------------------
-         A(j,k) += sum*delta;
-
-         for(i=j+1; i<Ns; i++) {             // rows of A > j (same loops again)
-            A(i,k) += sum * A(i,j);
-         }
-         for(i=0; i<N; i++) {                // all rows of G (again)
-            G(i,k) += sum * G(i,j);
-         }
-      }
-
-            // apply jth HH trans to Rwx and Phi sub-matrices
-      for(k=0; k<N; k++) {                // all columns of Rwx / Phi
-         sum = delta * Rwx(j,k);
-         for(i=j+1; i<Ns; i++) {          // rows of Rwx below j
-            sum += A(i,j) * Rwx(i,k);
-         }
-         for(i=0; i<N; i++) {             // all rows of Phi
-            sum += G(i,j) * Phi(i,k);
-         }
-         if(sum == T(0)) continue;
-         sum *= beta;
-         Rwx(j,k) += sum*delta;
-         for(i=j+1; i<Ns; i++) {          // rows of Rwx below j (again)
-            Rwx(i,k) += sum * A(i,j);
-         }
-         for(i=0; i<N; i++) {             // all rows of Phi (again)
-            Phi(i,k) += sum * G(i,j);
-         }
-      }
-
-            // apply jth HH trans to Zw and Z
-      sum = delta * Zw(j);
-      for(i=j+1; i<Ns; i++) {             // rows (elements) of Zw below j
-         sum += A(i,j) * Zw(i);
-      }
-      for(i=0; i<N; i++) {                // all rows (elements) of Z
-         sum += Z(i) * G(i,j);
-      }
-      if(sum == T(0)) continue;
-      sum *= beta;
-      Zw(j) += sum*delta;
-      for(i=j+1; i<Ns; i++) {             // rows of Zw below j (again)
-         Zw(i) += sum * A(i,j);
-      }
-      for(i=0; i<N; i++) {                // all rows of Z (again)
-         Z(i) += sum * G(i,j);
-      }
+      //------------------------------
+      // Transformation finished; copy out the transformed matrices
+   for(j=0; j<Ns; j++) {
+      for(i=0; i<N; i++) G(i,j) = B(Ns+i,j);
+      Zw(j) = B(j,Ns+N);
    }
-
-         // Loop over columns past the Ns block: all of Rwx and Phi
    for(j=0; j<N; j++) {
-      sum = T(0);
-      for(i=j+1; i<N; i++) {              // rows of Phi at and below j
-         sum += Phi(i,j) * Phi(i,j);
-      }
-      diag = Phi(j,j);
-      sum += diag*diag;
-      sum = (diag > T(0) ? -T(1) : T(1)) * ::sqrt(sum);
-      delta = diag - sum;
-      Phi(j,j) = sum;
-      beta = sum*delta;
-      if(beta > EPS) continue;
-      beta = T(1)/beta;
-
-               // apply HH trans to Phi sub-block below and right of j,j
-      for(k=j+1; k<N; k++) {                 // columns k > j
-         sum = delta * Phi(j,k);
-         for(i=j+1; i<N; i++) {              // rows below j
-            sum += Phi(i,j) * Phi(i,k);
-         }
-         if(sum == T(0)) continue;
-         sum *= beta;
-         Phi(j,k) += sum*delta;
-         for(i=j+1; i<N; i++) {              // rows below j (again)
-            Phi(i,k) += sum * Phi(i,j);
-         }
-      }
-               // Now apply to the Z column
-      sum = delta * Z(j);
-      for(i=j+1; i<N; i++) {                 // rows of Z below j
-         sum += Z(i) * Phi(i,j);
-      }
-      if(sum == T(0)) continue;
-      sum *= beta;
-      Z(j) += sum*delta;
-      for(i=j+1; i<N; i++) {                 // rows of Z below j (again)
-         Z(i) += sum * Phi(i,j);
-      }
+      for(i=0; i<Ns; i++) Rwx(i,j) = B(i,Ns+j);
+      for(i=0; i<N; i++) Phi(i,j) = B(Ns+i,Ns+j);
+      Z(j) = B(Ns+j,Ns+N);
    }
-      //------------------------------
-      // Transformation finished
 
       //-------------------------------------
       // copy transformed R out of Phi into R
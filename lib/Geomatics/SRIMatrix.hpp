@@ -48,6 +48,7 @@
 
 //------------------------------------------------------------------------------------
 // system includes
+#include <vector>
 // GPSTk
 #include "Vector.hpp"
 #include "Matrix.hpp"
@@ -57,6 +58,216 @@
 namespace gpstk
 {
 
+   //---------------------------------------------------------------------------------
+   /// Number of columns in each panel of the blocked Householder transformation;
+   /// SrifMU uses the blocked form when there are at least this many rows of data
+   /// and more than this many states.
+   static const unsigned int SRIFBlockSize = 32;
+
+   //---------------------------------------------------------------------------------
+   // Blocked form of the Householder transformation of SrifMU, used by SrifMU for
+   // large problems and by the time and smoother updates of SRIFilter.
+   // W is the concatenation of all the information, e.g. W = [ R Z ; A ] in
+   // SrifMU, and its first nf columns are zeroed below the diagonal. The first
+   // ntri rows of W hold an upper triangular block, like R in SrifMU: the
+   // transformation of column j < ntri involves only row j and the rows from ntri
+   // on, so that the zeros below the diagonal of the block are neither read nor
+   // filled in. Columns j >= ntri are transformed as in an ordinary QR.
+   //    The columns are taken in panels of nb. Within a panel the transformations
+   // are computed and applied one at a time, exactly as in SrifMU, but only to the
+   // columns of the panel. Then the product of the panel's transformations,
+   // H(nb-1)*...*H(1)*H(0) = I - V*transpose(T)*transpose(V), where the columns of
+   // V are the Householder vectors and T is upper triangular (the compact WY form,
+   // Schreiber and Van Loan), is applied to each column right of the panel in
+   // turn. Thus each column is read once per panel rather than once per
+   // transformation, and the work is done on columns that fit in cache.
+   // When nf <= nb there is one panel, and the result is the same as that of the
+   // column-at-a-time algorithm.
+   //    If skipZero is true, a column that is already zero below the diagonal is
+   // skipped, as in SrifMU; otherwise its diagonal element changes sign, as in the
+   // time and smoother updates.
+   //
+   // Ref: Schreiber, R. and C. Van Loan, "A Storage-Efficient WY Representation
+   //      for Products of Householder Transformations," SIAM J. Sci. Stat.
+   //      Comput. 10(1), 1989.
+
+   /// Blocked Householder transformation of the first nf columns of W, where the
+   /// first ntri rows of W are upper triangular. See doc for SrifMU().
+   /// @param  W        Matrix to be transformed, upper triangular on output in
+   ///                     the first nf columns.
+   /// @param  ntri     Number of leading rows of W that are upper triangular.
+   /// @param  nf       Number of columns of W to be zeroed below the diagonal.
+   /// @param  skipZero If true, skip columns that are zero below the diagonal.
+   /// @param  nb       Number of columns in each panel.
+   /// @throw MatrixException if the input has inconsistent dimensions.
+   template <class T>
+   void SrifHouseholder(Matrix<T>& W,
+                        const unsigned int ntri,
+                        const unsigned int nf,
+                        const bool skipZero,
+                        const unsigned int nb=SRIFBlockSize)
+      throw(MatrixException)
+   {
+      const unsigned int p=W.rows(), q=W.cols();
+      if(nf > q || nf > p || ntri > p || nb == 0) {
+         MatrixException me("Invalid input dimensions:\n  W has dimension "
+            + StringUtils::asString<int>(p) + "x"
+            + StringUtils::asString<int>(q) + ", with "
+            + StringUtils::asString<int>(ntri) + " triangular rows and "
+            + StringUtils::asString<int>(nf) + " columns to transform");
+         GPSTK_THROW(me);
+      }
+
+      const T EPS=-T(1.e-200);
+      unsigned int i,j,k,l,r,j0,j1,kend,nv,i0,i1;
+      T sum, dum, delta, beta;
+      T *u, *c, *cg[4];
+         // Householder vector l of a panel is Delta[l] in row j0+l and column
+         // j0+l of W in rows Lo[l] to Hi[l]-1, outside of which it is zero;
+         // the transformation is I - Tau[l]*v*v^T.
+      std::vector<T> Delta(nb), Tau(nb), TT(nb*nb), w(nb), wg(4*nb), zero;
+      std::vector<unsigned int> Lo(nb), Hi(nb);
+
+      for(j0=0; j0<nf; j0=j1) {     // loop over panels
+         j1 = (nf-j0 > nb ? j0+nb : nf);
+         if(j0 < ntri && j1 > ntri) j1 = ntri;  // panels do not straddle ntri
+         nv = j1-j0;
+            // in the last panel, apply each transformation to all columns
+         kend = (j1 == nf ? q : j1);
+
+            // compute the transformations of the panel, one column at a time
+         for(j=j0; j<j1; j++) {
+            l = j-j0;
+            Delta[l] = Tau[l] = T(0);
+            Lo[l] = Hi[l] = p;
+            u = &W(0,j);
+
+               // the rows below the diagonal, less leading and trailing zeros
+            for(i=(j < ntri ? ntri : j+1); i<p; i++) {
+               if(u[i] == T(0)) continue;
+               if(Lo[l] == p) Lo[l] = i;
+               Hi[l] = i+1;
+            }
+            sum = T(0);
+            for(i=Lo[l]; i<Hi[l]; i++)
+               sum += u[i]*u[i];    // sum squares of elements in this column below d
+            if(skipZero && sum <= T(0)) continue;
+
+            dum = u[j];
+            sum += dum * dum;       // add diagonal element
+            sum = (dum > T(0) ? -T(1) : T(1)) * ::sqrt(sum);
+            delta = dum - sum;
+            u[j] = sum;
+
+            beta = sum*delta;       // beta must be negative
+            if(beta > EPS) continue;
+            beta = T(1)/beta;
+            Delta[l] = delta;
+            Tau[l] = -beta;
+
+            for(k=j+1; k<kend; k++) {  // columns to right of diagonal
+               c = &W(0,k);
+               sum = delta * c[j];
+               for(i=Lo[l]; i<Hi[l]; i++)
+                  sum += u[i] * c[i];
+               if(sum == T(0)) continue;
+
+               sum *= beta;
+               c[j] += sum*delta;
+               for(i=Lo[l]; i<Hi[l]; i++)
+                  c[i] += sum * u[i];
+            }
+         }
+
+         if(kend == q) break;
+
+            // form T, column by column:
+            // T(l,l) = Tau[l], T(0:l-1,l) = -Tau[l] * T(0:l-1,0:l-1) * V^T * v(l)
+         for(l=0; l<nv; l++) {
+            for(r=0; r<nv; r++) TT[r+l*nb] = T(0);
+            if(Tau[l] == T(0)) continue;
+            u = &W(0,j0+l);
+            for(r=0; r<l; r++) {
+               w[r] = T(0);
+               if(Tau[r] == T(0)) continue;
+               c = &W(0,j0+r);
+               sum = (Lo[r] <= j0+l && j0+l < Hi[r] ? c[j0+l]*Delta[l] : T(0));
+               i0 = (Lo[r] > Lo[l] ? Lo[r] : Lo[l]);
+               i1 = (Hi[r] < Hi[l] ? Hi[r] : Hi[l]);
+               for(i=i0; i<i1; i++)
+                  sum += c[i] * u[i];
+               w[r] = sum;
+            }
+            for(r=0; r<l; r++) {
+               sum = T(0);
+               for(k=r; k<l; k++)
+                  sum += TT[r+k*nb] * w[k];
+               TT[r+l*nb] = -Tau[l] * sum;
+            }
+            TT[l+l*nb] = Tau[l];
+         }
+
+            // apply the panel's transformations to the columns right of it,
+            // four columns at a time so that each element of V is loaded once
+            // for all four; columns missing from the last four are taken from
+            // a column of zeros, and the results discarded.
+         for(k=j1; k<q; k+=4) {
+            for(r=0; r<4; r++) {
+               if(k+r < q) cg[r] = &W(0,k+r);
+               else {
+                  zero.assign(p,T(0));
+                  cg[r] = &zero[0];
+               }
+            }
+
+            for(l=0; l<nv; l++) {      // w = V^T * c
+               for(r=0; r<4; r++) wg[4*l+r] = T(0);
+               if(Tau[l] == T(0)) continue;
+               u = &W(0,j0+l);
+               T s0(Delta[l]*cg[0][j0+l]), s1(Delta[l]*cg[1][j0+l]),
+                 s2(Delta[l]*cg[2][j0+l]), s3(Delta[l]*cg[3][j0+l]);
+               for(i=Lo[l]; i<Hi[l]; i++) {
+                  dum = u[i];
+                  s0 += dum * cg[0][i];
+                  s1 += dum * cg[1][i];
+                  s2 += dum * cg[2][i];
+                  s3 += dum * cg[3][i];
+               }
+               wg[4*l] = s0; wg[4*l+1] = s1; wg[4*l+2] = s2; wg[4*l+3] = s3;
+            }
+
+            for(l=nv; l-- > 0; ) {     // w = T^T * w, from the bottom up
+               for(j=0; j<4; j++) {
+                  sum = T(0);
+                  for(r=0; r<=l; r++)
+                     sum += TT[r+l*nb] * wg[4*r+j];
+                  wg[4*l+j] = sum;
+               }
+            }
+
+            for(l=0; l<nv; l++) {      // c = c - V * w
+               if(Tau[l] == T(0)) continue;
+               u = &W(0,j0+l);
+               const T w0(wg[4*l]), w1(wg[4*l+1]), w2(wg[4*l+2]), w3(wg[4*l+3]);
+               cg[0][j0+l] -= Delta[l] * w0;
+               cg[1][j0+l] -= Delta[l] * w1;
+               cg[2][j0+l] -= Delta[l] * w2;
+               cg[3][j0+l] -= Delta[l] * w3;
+               for(i=Lo[l]; i<Hi[l]; i++) {
+                  dum = u[i];
+                  cg[0][i] -= dum * w0;
+                  cg[1][i] -= dum * w1;
+                  cg[2][i] -= dum * w2;
+                  cg[3][i] -= dum * w3;
+               }
+            }
+         }
+
+      }  // end loop over panels
+
+   }  // end SrifHouseholder
+
+
    //---------------------------------------------------------------------------------
    // This routine uses the Householder algorithm to update the SRI
    // state and covariance.
@@ -114,6 +325,9 @@ namespace gpstk
    // 2. If column k is already zero below the diagonal, AND A(k,k) is zero,
    // then y=0,sum=0,u=0 and b is infinite...the transformation is undefined.
    // However this column should be skipped (Biermann Appendix VII.B).
+   //    When there are at least SRIFBlockSize rows of data and more than
+   // SRIFBlockSize states, the same transformations are applied in panels of
+   // columns by SrifHouseholder(), which gives the same result to within rounding.
    //
    // Ref: Bierman, G.J. "Factorization Methods for Discrete Sequential
    //      Estimation," Academic Press, 1977.
@@ -148,6 +362,27 @@ namespace gpstk
       unsigned int np1=n+1;         // if np1 = n, state vector Z is not updated
       unsigned int i,j,k;
       T dum, delta, beta;
+
+         // for large problems, transform [ R Z ; A ] in panels of columns
+      if(m >= SRIFBlockSize && n > SRIFBlockSize) {
+         Matrix<T> W(n+m,np1,T(0));
+         for(j=0; j<n; j++) {
+            for(i=0; i<=j; i++) W(i,j) = R(i,j);
+            W(j,n) = Z(j);
+         }
+         for(j=0; j<np1; j++)
+            for(i=0; i<m; i++) W(n+i,j) = A(i,j);
+
+         SrifHouseholder(W,n,n,true);
+
+         for(j=0; j<n; j++) {
+            for(i=0; i<=j; i++) R(i,j) = W(i,j);
+            Z(j) = W(j,n);
+         }
+         for(j=0; j<np1; j++)
+            for(i=0; i<m; i++) A(i,j) = W(n+i,j);
+         return;
+      }
    
       for(j=0; j<n; j++) {          // loop over columns
          T sum = T(0);
@@ -428,6 +663,46 @@ namespace gpstk
       return S;
    }
    
+
+
+   //---------------------------------------------------------------------------------
+   // Given an upper triangular matrix UT and a matrix B, compute UT * B, skipping
+   // the zeros below the diagonal of UT. The sums are formed in the same order
+   // as in operator*, so the result is the same.
+   /// Compute the product of an upper triangular matrix and another matrix.
+   /// @param UT upper triangular matrix
+   /// @param B  matrix with as many rows as UT has columns
+   /// @return product UT * B
+   /// @throw MatrixException if UT is not square or B has the wrong dimension.
+   template <class T>
+   Matrix<T> UTtimes(const Matrix<T>& UT, const Matrix<T>& B)
+      throw(MatrixException)
+   {
+      const unsigned int n=UT.rows(), m=B.cols();
+      if(n == 0 || UT.cols() != n || B.rows() != n) {
+         MatrixException me("Invalid input dimensions: "
+               + StringUtils::asString<int>(UT.rows()) + "x"
+               + StringUtils::asString<int>(UT.cols()) + " times "
+               + StringUtils::asString<int>(B.rows()) + "x"
+               + StringUtils::asString<int>(B.cols()));
+         GPSTK_THROW(me);
+      }
+
+      unsigned int i,j,k;
+      T sum;
+      Matrix<T> P(n,m);
+
+      for(j=0; j<m; j++) {          // loop over columns of B
+         for(i=0; i<n; i++) {       // loop over rows of UT
+            sum = T(0);
+            for(k=i; k<n; k++)
+               sum += UT(i,k) * B(k,j);
+            P(i,j) = sum;
+         }
+      }
+
+      return P;
+   }
    
 } // end namespace gpstk
    
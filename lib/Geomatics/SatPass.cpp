@@ -91,6 +91,8 @@ void SatPass::init(GSatID insat, double indt, vector<string> obstypes) throw()
       indexForLabel[obstypes[i]] = i;
       labelForIndex[i] = obstypes[i];
    }
+
+   resizeColumns();
 }
 
 SatPass& SatPass::operator=(const SatPass& right) throw()
@@ -104,9 +106,12 @@ SatPass& SatPass::operator=(const SatPass& right) throw()
       firstTime = right.firstTime;
       lastTime = right.lastTime;
       ngood = right.ngood;
-      spdvector.resize(right.spdvector.size());
-      for(size_t i=0; i<right.spdvector.size(); i++)
-         spdvector[i] = right.spdvector[i];
+      spdflag = right.spdflag;
+      spdndt = right.spdndt;
+      spdtoffset = right.spdtoffset;
+      spddata = right.spddata;
+      spdlli = right.spdlli;
+      spdssi = right.spdssi;
    }
 
    return *this;
@@ -138,26 +143,27 @@ int SatPass::addData(const CommonTime tt,
                   + StringUtils::asString(ssi.size()));
       GPSTK_THROW(e);
    }
-   if(spdvector.size() > 0 && spdvector[0].data.size() != data.size()) {
+   if(spddata.size() != data.size()) {
       Exception e("Error - addData passed different dimension that earlier!"
                    + StringUtils::asString(data.size()) + " != "
-                   + StringUtils::asString(spdvector[0].data.size()));
+                   + StringUtils::asString(spddata.size()));
       GPSTK_THROW(e);
    }
 
-   // create a new SatPassData
-   SatPassData spd(data.size());
-   spd.flag = flag;
+   // push_back defines count and
+   // returns : >=0 index of added data (ok), -1 gap, -2 tt out of order
+   int n = push_back(tt);
+   if(n < 0) return n;
+
+   spdflag[n] = flag;
    for(size_t k=0; k<data.size(); k++) {
       int i = indexForLabel[obstypes[k]];
-      spd.data[i] = data[k];
-      spd.lli[i] = lli[k];
-      spd.ssi[i] = ssi[k];
+      spddata[i][n] = data[k];
+      spdlli[i][n] = lli[k];
+      spdssi[i][n] = ssi[k];
    }
 
-   // push_back defines count and
-   // returns : >=0 index of added data (ok), -1 gap, -2 tt out of order
-   return push_back(tt, spd);
+   return n;
 }
 
 // return -3 sat not found, data not added
@@ -170,29 +176,25 @@ int SatPass::addData(const RinexObsData& robs) throw()
    RinexObsData::RinexSatMap::const_iterator it;
    RinexObsData::RinexObsTypeMap::const_iterator jt;
    map<string,unsigned int>::const_iterator kt;
-   SatPassData spd(indexForLabel.size());
 
    // loop over satellites
    for(it=robs.obs.begin(); it != robs.obs.end(); it++) {
       if(it->first == sat) {
+         // add the epoch; flag is OK by default, missing data is zero
+         int n = push_back(robs.time);
+         if(n < 0) return n;
+
          // loop over obs
          for(kt=indexForLabel.begin(); kt != indexForLabel.end(); kt++) {
             if((jt=it->second.find(RinexObsHeader::convertObsType(kt->first)))
-                  == it->second.end()) {
-               spd.data[kt->second] = 0.0;
-               spd.lli[kt->second] = 0;
-               spd.ssi[kt->second] = 0;
-            }
-            else {
-               spd.data[kt->second] = jt->second.data;
-               spd.lli[kt->second] = jt->second.lli;
-               spd.ssi[kt->second] = jt->second.ssi;
+                  != it->second.end()) {
+               spddata[kt->second][n] = jt->second.data;
+               spdlli[kt->second][n] = jt->second.lli;
+               spdssi[kt->second][n] = jt->second.ssi;
             }
          }  // end loop over obs
 
-         spd.flag = OK;             // default
-
-         return push_back(robs.time,spd);
+         return n;
       }
    }
    return -3;
@@ -243,14 +245,16 @@ void SatPass::smooth(bool smoothPR, bool debiasPH, string& msg) throw(Exception)
    size_t i;
    double RB1,RB2,dbL1,dbL2;
    Stats<double> PB1,PB2;
+   vector<double>& dL1 = spddata[indexForLabel["L1"]];
+   vector<double>& dL2 = spddata[indexForLabel["L2"]];
+   vector<double>& dP1 = spddata[indexForLabel[(useC1 ? "C1" : "P1")]];
+   vector<double>& dP2 = spddata[indexForLabel["P2"]];
 
    // get the biases B = L - DP
-   for(first=true,i=0; i<spdvector.size(); i++) {
-      if(!(spdvector[i].flag & OK)) continue;        // skip bad data
-      double P1 = spdvector[i].data[indexForLabel[(useC1 ? "C1" : "P1")]];
-      double P2 = spdvector[i].data[indexForLabel["P2"]];
-      RB1 = wl1*spdvector[i].data[indexForLabel["L1"]] - D11*P1 - D12*P2;
-      RB2 = wl2*spdvector[i].data[indexForLabel["L2"]] - D21*P1 - D22*P2;
+   for(first=true,i=0; i<spdflag.size(); i++) {
+      if(!(spdflag[i] & OK)) continue;               // skip bad data
+      RB1 = wl1*dL1[i] - D11*dP1[i] - D12*dP2[i];
+      RB2 = wl2*dL2[i] - D21*dP1[i] - D22*dP2[i];
       if(first) { dbL1 = RB1; dbL2 = RB2; first = false; }
       PB1.Add(RB1-dbL1);
       PB2.Add(RB2-dbL2);
@@ -280,23 +284,22 @@ void SatPass::smooth(bool smoothPR, bool debiasPH, string& msg) throw(Exception)
 
    if(!debiasPH && !smoothPR) return;
 
-   for(i=0; i<spdvector.size(); i++) {
-      if(!(spdvector[i].flag & OK)) continue;        // skip bad data
+   for(i=0; i<spdflag.size(); i++) {
+      if(!(spdflag[i] & OK)) continue;               // skip bad data
 
       // compute the debiased phase
-      dbL1 = spdvector[i].data[indexForLabel["L1"]] - RB1;
-      dbL2 = spdvector[i].data[indexForLabel["L2"]] - RB2;
+      dbL1 = dL1[i] - RB1;
+      dbL2 = dL2[i] - RB2;
 
       // replace the phase with the debiased phase
       if(debiasPH) {
-         spdvector[i].data[indexForLabel["L1"]] = dbL1;
-         spdvector[i].data[indexForLabel["L2"]] = dbL2;
+         dL1[i] = dbL1;
+         dL2[i] = dbL2;
       }
       // smooth the range - replace the pseudorange with the smoothed pseudorange
       if(smoothPR) {
-         spdvector[i].data[indexForLabel[(useC1 ? "C1" : "P1")]]
-                                                = D11*wl1*dbL1 + D12*wl2*dbL2;
-         spdvector[i].data[indexForLabel["P2"]] = D21*wl1*dbL1 + D22*wl2*dbL2;
+         dP1[i] = D11*wl1*dbL1 + D12*wl2*dbL2;
+         dP2[i] = D21*wl1*dbL1 + D22*wl2*dbL2;
       }
    }
 }
@@ -304,7 +307,7 @@ void SatPass::smooth(bool smoothPR, bool debiasPH, string& msg) throw(Exception)
 // -------------------------- get and set routines ----------------------------
 double& SatPass::data(unsigned int i, std::string type) throw(Exception)
 {
-   if(i >= spdvector.size()) {
+   if(i >= spdflag.size()) {
       Exception e("Invalid index in data() " + asString(i));
       GPSTK_THROW(e);
    }
@@ -313,21 +316,21 @@ double& SatPass::data(unsigned int i, std::string type) throw(Exception)
       Exception e("Invalid obs type in data() " + type);
       GPSTK_THROW(e);
    }
-   return spdvector[i].data[it->second];
+   return spddata[it->second][i];
 }
 
 double& SatPass::timeoffset(unsigned int i) throw(Exception)
 {
-   if(i >= spdvector.size()) {
+   if(i >= spdflag.size()) {
       Exception e("Invalid index in timeoffset() " + asString(i));
       GPSTK_THROW(e);
    }
-   return spdvector[i].toffset;
+   return spdtoffset[i];
 }
 
 unsigned short& SatPass::LLI(unsigned int i, std::string type) throw(Exception)
 {
-   if(i >= spdvector.size()) {
+   if(i >= spdflag.size()) {
       Exception e("Invalid index in LLI() " + asString(i));
       GPSTK_THROW(e);
    }
@@ -336,12 +339,12 @@ unsigned short& SatPass::LLI(unsigned int i, std::string type) throw(Exception)
       Exception e("Invalid obs type in LLI() " + type);
       GPSTK_THROW(e);
    }
-   return spdvector[i].lli[it->second];
+   return spdlli[it->second][i];
 }
 
 unsigned short& SatPass::SSI(unsigned int i, std::string type) throw(Exception)
 {
-   if(i >= spdvector.size()) {
+   if(i >= spdflag.size()) {
       Exception e("Invalid index in SSI() " + asString(i));
       GPSTK_THROW(e);
    }
@@ -350,53 +353,53 @@ unsigned short& SatPass::SSI(unsigned int i, std::string type) throw(Exception)
       Exception e("Invalid obs type in SSI() " + type);
       GPSTK_THROW(e);
    }
-   return spdvector[i].ssi[it->second];
+   return spdssi[it->second][i];
 }
 
 // ---------------------------------- set routines ----------------------------
 void SatPass::setFlag(unsigned int i, unsigned short f) throw(Exception)
 {
-   if(i >= spdvector.size()) {
+   if(i >= spdflag.size()) {
       Exception e("Invalid index in setFlag() " + asString(i));
       GPSTK_THROW(e);
    }
 
-   if(spdvector[i].flag != BAD && f == BAD) ngood--;
-   if(spdvector[i].flag == BAD && f != BAD) ngood++;
-   spdvector[i].flag = f;
+   if(spdflag[i] != BAD && f == BAD) ngood--;
+   if(spdflag[i] == BAD && f != BAD) ngood++;
+   spdflag[i] = f;
 }
 
 // ---------------------------------- get routines ----------------------------
 // get value of flag at one index
 unsigned short SatPass::getFlag(unsigned int i) throw(Exception)
 {
-   if(i >= spdvector.size()) {
+   if(i >= spdflag.size()) {
       Exception e("Invalid index in getFlag() " + asString(i));
       GPSTK_THROW(e);
    }
-   return spdvector[i].flag;
+   return spdflag[i];
 }
 
 // get one element of the count array of this SatPass
 unsigned int SatPass::getCount(unsigned int i) const throw(Exception)
 {
-   if(i >= spdvector.size()) {
+   if(i >= spdflag.size()) {
       Exception e("invalid in getCount() " + asString(i));
       GPSTK_THROW(e);
    }
-   return spdvector[i].ndt;
+   return spdndt[i];
 }
 
 // ---------------------------------- utils -----------------------------------
 // return the time corresponding to the given index in the data array
 CommonTime SatPass::time(unsigned int i) const throw(Exception)
 {
-   if(i > spdvector.size()) {
+   if(i > spdflag.size()) {
       Exception e("invalid in time() " + asString(i));
       GPSTK_THROW(e);
    }
    // computing toff first is necessary to avoid a rare bug in CommonTime..
-   double toff = spdvector[i].ndt * dt + spdvector[i].toffset;
+   double toff = spdndt[i] * dt + spdtoffset[i];
    return (firstTime + toff);
 }
 
@@ -425,14 +428,15 @@ try {
    newSP.Status = Status;
    newSP.indexForLabel = indexForLabel;
    newSP.labelForIndex = labelForIndex;
+   newSP.resizeColumns();
 
    oldgood = ngood;
    ngood = ilast = 0;
-   for(i=0; i<spdvector.size(); i++) {             // loop over all data
-      n = spdvector[i].ndt;
+   for(i=0; i<spdflag.size(); i++) {               // loop over all data
+      n = spdndt[i];
       tt = time(i);
       if(n < N) {                                     // keep in this SatPass
-         if(spdvector[i].flag != BAD) ngood++;
+         if(spdflag[i] != BAD) ngood++;
          ilast = i;
       }
       else {                                          // copy out data into new SP
@@ -441,14 +445,19 @@ try {
             newSP.firstTime = newSP.lastTime = tt;
          }
          j = newSP.countForTime(tt);
-         spdvector[i].ndt = j;
-         spdvector[i].toffset = tt - newSP.firstTime - j*dt;
-         newSP.spdvector.push_back(spdvector[i]);
+         newSP.copyEpoch(*this, i, j, tt - newSP.firstTime - j*dt);
       }
    }
 
    // now trim this SatPass
-   spdvector.resize(ilast+1);
+   spdflag.resize(ilast+1);
+   spdndt.resize(ilast+1);
+   spdtoffset.resize(ilast+1);
+   for(i=0; i<spddata.size(); i++) {
+      spddata[i].resize(ilast+1);
+      spdlli[i].resize(ilast+1);
+      spdssi[i].resize(ilast+1);
+   }
    lastTime = time(ilast);
 
    return true;
@@ -460,12 +469,12 @@ void SatPass::decimate(const int N, CommonTime refTime) throw(Exception)
 {
 try {
    if(N <= 1) return;
-   if(int(spdvector.size()) < N) { dt = N*dt; return; }
+   if(int(spdflag.size()) < N) { dt = N*dt; return; }
    if(refTime == CommonTime::BEGINNING_OF_TIME) refTime = firstTime;
 
    // find new firstTime = time(nstart)
    int j,nstart=int(0.5+(firstTime-refTime)/dt);
-   size_t i;
+   size_t i,k;
    nstart = nstart % N;
    while(nstart < 0) nstart += N;
    if(nstart > 0) nstart = N-nstart;
@@ -473,27 +482,42 @@ try {
    // decimate
    ngood = 0;
    CommonTime newfirstTime, tt;
-   for(j=0,i=0; i<spdvector.size(); i++) {
-      if(spdvector[i].ndt % N != nstart) continue;
+   for(j=0,i=0; i<spdflag.size(); i++) {
+      if(spdndt[i] % N != nstart) continue;
       lastTime = time(i);
       if(j==0) {
          newfirstTime = time(i);
-         spdvector[i].toffset = 0.0;
-         spdvector[i].ndt = 0;
+         spdtoffset[i] = 0.0;
+         spdndt[i] = 0;
       }
       else {
          tt = time(i);
-         spdvector[i].ndt = int(0.5+(tt-newfirstTime)/(N*dt));
-         spdvector[i].toffset = tt - newfirstTime - spdvector[i].ndt * N * dt;
+         spdndt[i] = int(0.5+(tt-newfirstTime)/(N*dt));
+         spdtoffset[i] = tt - newfirstTime - spdndt[i] * N * dt;
+      }
+      spdflag[j] = spdflag[i];
+      spdndt[j] = spdndt[i];
+      spdtoffset[j] = spdtoffset[i];
+      for(k=0; k<spddata.size(); k++) {
+         spddata[k][j] = spddata[k][i];
+         spdlli[k][j] = spdlli[k][i];
+         spdssi[k][j] = spdssi[k][i];
       }
-      spdvector[j] = spdvector[i];
-      if(spdvector[j].flag != BAD) ngood++;
+      if(spdflag[j] != BAD) ngood++;
       j++;
    }
 
    dt = N*dt;
    firstTime = newfirstTime;
-   spdvector.resize(j); // trim
+   // trim
+   spdflag.resize(j);
+   spdndt.resize(j);
+   spdtoffset.resize(j);
+   for(k=0; k<spddata.size(); k++) {
+      spddata[k].resize(j);
+      spdlli[k].resize(j);
+      spdssi[k].resize(j);
+   }
 }
 catch(Exception& e) { GPSTK_RETHROW(e); }
 }
@@ -512,24 +536,24 @@ void SatPass::dump(ostream& os, string msg1, string msg2) throw()
    os << " gap(pts)";
    os << endl;
 
-   for(i=0; i<spdvector.size(); i++) {
+   for(i=0; i<spdflag.size(); i++) {
       tt = time(i);
       os << msg1
          << " " << setw(3) << i
          << " " << sat
-         << " " << setw(3) << spdvector[i].ndt
-         << " " << setw(2) << spdvector[i].flag
+         << " " << setw(3) << spdndt[i]
+         << " " << setw(2) << spdflag[i]
          << " " << printTime(tt,SatPass::outFormat)
          << fixed << setprecision(6)
-         << " " << setw(9) << spdvector[i].toffset
+         << " " << setw(9) << spdtoffset[i]
          << setprecision(3);
       for(j=0; j<indexForLabel.size(); j++)
-         os << " " << setw(13) << spdvector[i].data[j]
-            << " " << spdvector[i].lli[j]
-            << " " << spdvector[i].ssi[j];
-      if(i==0) last = spdvector[i].ndt;
-      if(spdvector[i].ndt - last > 1) os << " " << spdvector[i].ndt-last;
-      last = spdvector[i].ndt;
+         os << " " << setw(13) << spddata[j][i]
+            << " " << spdlli[j][i]
+            << " " << spdssi[j][i];
+      if(i==0) last = spdndt[i];
+      if(spdndt[i] - last > 1) os << " " << spdndt[i]-last;
+      last = spdndt[i];
       os << endl;
    }
 }
@@ -537,7 +561,7 @@ void SatPass::dump(ostream& os, string msg1, string msg2) throw()
 // output SatPass to ostream
 ostream& operator<<(ostream& os, SatPass& sp )
 {
-   os << setw(4) << sp.spdvector.size()
+   os << setw(4) << sp.spdflag.size()
       << " " << sp.sat
       << " " << setw(4) << sp.ngood
       << " " << setw(2) << sp.Status
@@ -549,14 +573,25 @@ ostream& operator<<(ostream& os, SatPass& sp )
    return os;
 }
 
-// ---------------------------- private SatPassData functions --------------------
-// add data to the arrays at timetag tt (private)
+// ---------------------------- private column functions ------------------------
+// size the columns to the obs types and remove all data (private)
+void SatPass::resizeColumns(void) throw()
+{
+   spdflag.clear();
+   spdndt.clear();
+   spdtoffset.clear();
+   spddata.assign(labelForIndex.size(), vector<double>());
+   spdlli.assign(labelForIndex.size(), vector<unsigned short>());
+   spdssi.assign(labelForIndex.size(), vector<unsigned short>());
+}
+
+// add a new epoch, with flag OK and zero data, at timetag tt (private)
 // return >=0 ok (index of added data), -1 gap, -2 timetag out of order
-int SatPass::push_back(const CommonTime tt, SatPassData& spd) throw()
+int SatPass::push_back(const CommonTime tt) throw()
 {
    unsigned int n;
       // if this is the first point, save first time
-   if(spdvector.size() == 0) {
+   if(spdflag.size() == 0) {
       firstTime = lastTime = tt;
       n = 0;
    }
@@ -565,29 +600,36 @@ int SatPass::push_back(const CommonTime tt, SatPassData& spd) throw()
          // compute count for this point - prev line means n is >= 0
       n = countForTime(tt);
          // test size of gap
-      if( (n - spdvector[spdvector.size()-1].ndt) * dt > maxGap)
+      if( (n - spdndt.back()) * dt > maxGap)
          return -1;
       lastTime = tt;
    }
 
       // add it
-   //spd.flag = 1;
    ngood++;  // ngood is useless unless it's changed whenever any flag is...
-   spd.ndt = n;
-   spd.toffset = tt - firstTime - n*dt;
-   spdvector.push_back(spd);
-   return (spdvector.size()-1);
+   spdflag.push_back(OK);
+   spdndt.push_back(n);
+   spdtoffset.push_back(tt - firstTime - n*dt);
+   for(size_t k=0; k<spddata.size(); k++) {
+      spddata[k].push_back(0.0);
+      spdlli[k].push_back(0);
+      spdssi[k].push_back(0);
+   }
+   return (spdflag.size()-1);
 }
 
-// get one element of the data array of this SatPass (private)
-struct SatPass::SatPassData SatPass::getData(unsigned int i) const
-   throw(Exception)
+// append epoch i of sp, with new count and offset, to the columns (private)
+void SatPass::copyEpoch(const SatPass& sp, unsigned int i,
+                        unsigned int n, double toff) throw()
 {
-   if(i >= spdvector.size()) {         // TD ?? keep this - its private
-      Exception e("invalid in getData() " + asString(i));
-      GPSTK_THROW(e);
+   spdflag.push_back(sp.spdflag[i]);
+   spdndt.push_back(n);
+   spdtoffset.push_back(toff);
+   for(size_t k=0; k<spddata.size(); k++) {
+      spddata[k].push_back(sp.spddata[k][i]);
+      spdlli[k].push_back(sp.spdlli[k][i]);
+      spdssi[k].push_back(sp.spdssi[k][i]);
    }
-   return spdvector[i];
 }
 
 // -------------------------------------------------------------------------------
@@ -680,14 +722,14 @@ int SatPassIterator::next(map<unsigned int, unsigned int>& indexMap) throw(Excep
 
          if(SPList[i].Status < 0) continue;     // should never happen
 
-         if(countOffset[sat] + SPList[i].spdvector[j].ndt == currentN) {
+         if(countOffset[sat] + SPList[i].spdndt[j] == currentN) {
             // found active sat at this count - add to map
             nextIndexMap[i] = j;
             numsvs++;
 
             // increment data index
             j++;
-            if(j == SPList[i].spdvector.size()) {     // this pass is done
+            if(j == SPList[i].spdflag.size()) {       // this pass is done
                indexStatus[i] = 1;
 
                // find the next pass for this sat
@@ -754,7 +796,7 @@ int SatPassIterator::next(RinexObsData& robs) throw(Exception)
       GSatID sat = SPList[i].getSat();
 
       bool found = false;
-      bool flag = (SPList[i].spdvector[j].flag != SatPass::BAD);
+      bool flag = (SPList[i].spdflag[j] != SatPass::BAD);
 
       for(size_t k=0; k<SPList[i].labelForIndex.size(); k++) {
          RinexObsType ot;
@@ -763,9 +805,9 @@ int SatPassIterator::next(RinexObsData& robs) throw(Exception)
          }
          else {
             found = true;
-            robs.obs[sat][ot].data = flag ? SPList[i].spdvector[j].data[k] : 0.;
-            robs.obs[sat][ot].lli  = flag ? SPList[i].spdvector[j].lli[k] : 0;
-            robs.obs[sat][ot].ssi  = flag ? SPList[i].spdvector[j].ssi[k] : 0;
+            robs.obs[sat][ot].data = flag ? SPList[i].spddata[k][j] : 0.;
+            robs.obs[sat][ot].lli  = flag ? SPList[i].spdlli[k][j] : 0;
+            robs.obs[sat][ot].ssi  = flag ? SPList[i].spdssi[k][j] : 0;
          }
       }
       if(found) robs.numSvs++;
@@ -227,7 +227,7 @@ public:
 
    /// @return the earliest time of good data in this SatPass data
    CommonTime getFirstGoodTime(void) const throw() {
-      for(size_t j=0; j<spdvector.size(); j++) if(spdvector[j].flag & OK) {
+      for(size_t j=0; j<spdflag.size(); j++) if(spdflag[j] & OK) {
          return time(j);
       }
       return CommonTime::END_OF_TIME;
@@ -235,7 +235,7 @@ public:
 
    /// @return the latest time of good data in this SatPass data
    CommonTime getLastGoodTime(void) const throw() {
-      for(int j=spdvector.size()-1; j>=0; j--) if(spdvector[j].flag & OK) {
+      for(int j=spdflag.size()-1; j>=0; j--) if(spdflag[j] & OK) {
          return time(j);
       }
       return CommonTime::BEGINNING_OF_TIME;
@@ -255,7 +255,7 @@ public:
 
    /// get the size of (the arrays in) this SatPass
    /// @return the size of the data array in this object
-   unsigned int size(void) const throw() { return spdvector.size(); }
+   unsigned int size(void) const throw() { return spdflag.size(); }
 
    /// get one element of the count array of this SatPass
    /// @param  i   index of the data of interest
@@ -266,7 +266,7 @@ public:
    // -------------------------------- utils ---------------------------------
 
    /// clear the data (but not the obs types) from the arrays
-   void clear(void) throw() { spdvector.clear(); }
+   void clear(void) throw() { resizeColumns(); }
 
    /// compute the timetag associated with index i in the data array
    /// @param  i   index of the data of interest
@@ -351,58 +351,6 @@ protected:
    int countForTime(const CommonTime& tt) const throw(Exception)
       { return int((tt-firstTime)/dt + 0.5); }
 
-   // --------------- SatPassData data structure for internal use only ----------
-   //
-   struct SatPassData {
-
-      // ---------------------- member data ----------------------------------
-
-      /// a flag (cf. SatPass::BAD, etc.) that is set to OK at creation
-      /// then reset by other processing.
-      unsigned short flag;
-      /// time 'count' : time of data = FirstTime + ndt * dt + offset
-      unsigned int ndt;
-      /// offset of time from integer number * dt since FirstTime.
-      double toffset;
-      /// data for one epoch of RINEX data
-      std::vector<double> data;
-      /// loss-of-lock and signal-strength indicators (from RINEX) for data
-      /// parallel to data vector
-      std::vector<unsigned short> lli,ssi;
-
-      // ---------------------- private member functions ---------------------
-
-      /// constructor
-      /// @param n the number of data types to be stored, default 4
-      SatPassData(unsigned short n=4) : flag(SatPass::OK), ndt(0), toffset(0.0)
-      {
-         data = std::vector<double>(n,0.0);
-         lli = std::vector<unsigned short>(n,0);
-         ssi = std::vector<unsigned short>(n,0);
-      }
-
-      // d'tor, copy c'tor and operator= are built by compiler,
-      // but operator= will not work correctly, b/c a deep copy is needed.
-      SatPassData& operator=(const SatPassData& right) throw()
-      {
-         if(&right != this) {
-            flag = right.flag;
-            ndt = right.ndt;
-            toffset = right.toffset;
-            data.resize(right.data.size());
-            lli.resize(right.lli.size());
-            ssi.resize(right.ssi.size());
-            size_t i;
-            for(i=0; i<right.data.size(); i++) data[i] = right.data[i];
-            for(i=0; i<right.lli.size(); i++) lli[i] = right.lli[i];
-            for(i=0; i<right.ssi.size(); i++) ssi[i] = right.ssi[i];
-         }
-
-         return *this;
-      }
-
-   }; // end struct SatPassData
-
    // --------------- private member data -----------------------------
    /// Status flag for use exclusively by the caller. It is set to 0
    /// by the constructors, but otherwise ignored by class SatPass and
@@ -415,7 +363,7 @@ protected:
    /// Satellite identifier for this data.
    GSatID sat;
 
-   /// STL map relating strings identifying obs types with indexes in SatPassData
+   /// STL map relating strings identifying obs types with indexes in spddata, etc.
    std::map<std::string,unsigned int> indexForLabel;
    std::map<unsigned int,std::string> labelForIndex;
 
@@ -427,22 +375,50 @@ protected:
    /// number of timetags with good data in the data arrays.
    unsigned int ngood;
 
-   /// ALL data in the pass, stored in SatPassData objects, in time order
-   std::vector<SatPassData> spdvector;
+   /// ALL data in the pass, in time order, stored as parallel columns so that
+   /// the whole pass costs a handful of allocations rather than several per
+   /// epoch. Epoch i has flag spdflag[i], count spdndt[i] and time offset
+   /// spdtoffset[i]; obs type k (cf. indexForLabel) has its data, LLI and SSI
+   /// in the contiguous columns spddata[k], spdlli[k] and spdssi[k], all of
+   /// which are the same length as spdflag.
+
+   /// a flag (cf. SatPass::BAD, etc.) at each epoch, set to OK at creation
+   /// then reset by other processing.
+   std::vector<unsigned short> spdflag;
+
+   /// time 'count' at each epoch : time of data = firstTime + ndt * dt + offset
+   std::vector<unsigned int> spdndt;
+
+   /// offset of time from integer number * dt since firstTime, at each epoch
+   std::vector<double> spdtoffset;
+
+   /// data, one column per obs type, indexed [obstype index][epoch index]
+   std::vector< std::vector<double> > spddata;
+
+   /// loss-of-lock and signal-strength indicators (from RINEX), parallel to
+   /// spddata
+   std::vector< std::vector<unsigned short> > spdlli,spdssi;
 
    // --------------- private member functions ------------------------
 
    /// called by constructors to initialize - see doc for them.
    void init(GSatID sat, double dt, std::vector<std::string> obstypes) throw();
 
-   /// add a complete SatPassData at time tt
+   /// size the data columns to hold the obs types in labelForIndex, and
+   /// remove all the data
+   void resizeColumns(void) throw();
+
+   /// add a new epoch at time tt to the end of the columns, with flag OK and
+   /// zero data, lli and ssi; the caller then fills the data at the returned index.
    /// @return n>=0 if data was added successfully, n is the index of the new data
    ///            -1 if a gap is found (no data is added),
    ///            -2 if time tag is out of order (no data is added)
-   int push_back(const CommonTime tt, SatPassData& spd) throw();
+   int push_back(const CommonTime tt) throw();
 
-   /// get a complete SatPassData at count i
-   struct SatPassData getData(unsigned int i) const throw(Exception);
+   /// copy the complete epoch at index i of SatPass sp onto the end of the
+   /// columns of this SatPass, with count n and time offset toff.
+   void copyEpoch(const SatPass& sp, unsigned int i, unsigned int n, double toff)
+      throw();
 
    // --------------- friend functions --------------------------------
 
@@ -586,7 +562,7 @@ private:
    /// index of the current object in the list for this satellite
    std::map<GSatID,int> listIndex;
 
-   /// index of the data vector (spdvector) of the current object in the list
+   /// index of the data columns (spdflag, etc) of the current object in the list
    /// for this satellite
    std::map<GSatID,int> dataIndex;
 
@@ -602,7 +578,7 @@ private:
    std::vector<SatPass>& SPList;
 
    /// map of indexes i,j, created by next(), such that data returned by next() is
-   /// found at SatPassList[i].spdvector[j] where map[i]=j.
+   /// found at epoch j of SatPassList[i] where map[i]=j.
    std::map<unsigned int,unsigned int> nextIndexMap;
 
 }; // end class SatPassIterator
@@ -33,6 +33,7 @@
 #include <ostream>
 
 #include "Exception.hpp"
+#include "ClockStability.hpp"
 
 namespace gpstk
 {
@@ -53,33 +54,13 @@ namespace gpstk
             GPSTK_THROW(e);
          }
 
-         // Actual Overlapping Allan Deviation Calculation is done here
-         // The Overlapping Allan Deviation is calculated as follows
-         //  Sigma^2(Tau) = 1 / (2*(N-2*m)*Tau^2) * Sum(X[i+2*m]-2*X[i+m]+X[i], i=1, i=N-2*m)
-         //  Where Tau is the averaging time, N is the total number of points, and Tau = m*Tau0
-         //  Where Tau0 is the basic measurement interval	
-         double sum, sigma;
-         for(int m = 1; m <= (N-1)/2; m++)
-         {
-            double tau = m*tau0;
-            sigma = 0;
-            
-            for(int i = 0; i < (N-2*m); i++)
-            {
-               sum = 0;
-               if((phase[i+2*m]==0 ||  phase[i+m]==0 || phase[i]==0) 
-                  && i!=0 && i!=(N-2*m-1))
-                  numGaps++;
-               else
-                  sum = phase[i+2*m] - 2*phase[i+m] + phase[i];
-               sigma += sum * sum;
-            }
-		
-            sigma = sigma / (2.0*((double)N-(double)numGaps-0-2.0*(double)m)*tau*tau);
-            sigma = sqrt(sigma);
-            deviation.push_back(sigma);
-            time.push_back(tau);
-         }
+         // Overlapping Allan deviation at every averaging factor,
+         // computed by ClockStability
+         ClockStability cs(tau0);
+         cs.add(phase);
+         cs.compute(ClockStability::OverlappingAllan, ClockStability::AllTau,
+                    time, deviation);
+         numGaps = cs.getNumGaps();
       }
 
       void dump(std::ostream& s = std::cout) const throw()
@@ -94,7 +75,7 @@ namespace gpstk
       int numGaps;
    };
 
-   std::ostream& operator<<(std::ostream& s, const AllanDeviation& a)
+   inline std::ostream& operator<<(std::ostream& s, const AllanDeviation& a)
    {
       a.dump(s);
       return s;
@@ -0,0 +1,370 @@
+#pragma ident "$Id$"
+
+//============================================================================
+//
+//  This file is part of GPSTk, the GPS Toolkit.
+//
+//  The GPSTk is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU Lesser General Public License as published
+//  by the Free Software Foundation; either version 2.1 of the License, or
+//  any later version.
+//
+//  The GPSTk is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU Lesser General Public License for more details.
+//
+//  You should have received a copy of the GNU Lesser General Public
+//  License along with GPSTk; if not, write to the Free Software Foundation,
+//  Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110, USA
+//
+//  Copyright 2004, The University of Texas at Austin
+//
+//============================================================================
+
+/**
+ * @file ClockStability.cpp
+ * Frequency stability (Allan, modified Allan, Hadamard and total deviation)
+ * of clock phase data.
+ */
+
+#include <cmath>
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+#include "ClockStability.hpp"
+#include "StringUtils.hpp"
+
+using namespace std;
+
+namespace gpstk
+{
+
+      // Remove all phase data.
+   void ClockStability::clear(void) throw()
+   {
+      x0 = slope = 0.0;
+      x.clear();
+      missing.clear();
+      sums.assign(1, 0.0L);
+      gaps.assign(1, 0UL);
+   }
+
+
+      // Append one phase point.
+   void ClockStability::add(double phase) throw()
+   {
+      unsigned long k(missing.size());
+
+         // zero phase is missing data, except at the first point, where
+         // phase is often measured relative to itself
+      bool gap( k > 0 && phase == 0.0 );
+
+      if(k == 0)
+      {
+         x0 = phase;
+      }
+      else if(k == 1 && !gap)
+      {
+         slope = phase - x0;
+      }
+
+      double value( gap ? 0.0 : (phase - x0 - slope*double(k)) );
+
+      x.push_back(value);
+      sums.push_back(sums.back() + value);
+      missing.push_back(gap ? 1 : 0);
+      gaps.push_back(gaps.back() + (gap ? 1 : 0));
+
+   }  // End of method 'ClockStability::add()'
+
+
+      // Append a vector of phase points, in time order.
+   void ClockStability::add(const std::vector<double>& phase) throw()
+   {
+      x.reserve(x.size() + phase.size());
+      sums.reserve(sums.size() + phase.size());
+      missing.reserve(missing.size() + phase.size());
+      gaps.reserve(gaps.size() + phase.size());
+
+      for(size_t i=0; i<phase.size(); i++)
+      {
+         add(phase[i]);
+      }
+   }
+
+
+      // Largest averaging factor for which the statistic is defined.
+   unsigned long ClockStability::maxFactor(DeviationType type) const throw()
+   {
+      unsigned long N(x.size());
+
+      switch(type)
+      {
+         case OverlappingAllan:
+         case TotalAllan:
+            return (N < 3 ? 0 : (N-1)/2);
+         case ModifiedAllan:
+            return N/3;
+         case OverlappingHadamard:
+            return (N < 4 ? 0 : (N-1)/3);
+      }
+
+      return 0;
+   }
+
+
+      // Averaging factors, with the given spacing, up to maxFactor().
+   std::vector<unsigned long> ClockStability::factors(DeviationType type,
+                                                      TauSpacing spacing) const
+      throw()
+   {
+      std::vector<unsigned long> m;
+      unsigned long mmax(maxFactor(type));
+
+      if(spacing == OctaveTau)
+      {
+         for(unsigned long k=1; k<=mmax; k*=2)
+         {
+            m.push_back(k);
+         }
+      }
+      else if(spacing == DecadeTau)
+      {
+         static const unsigned long steps[3] = { 1, 2, 4 };
+         for(unsigned long decade=1; decade<=mmax; decade*=10)
+         {
+            for(int i=0; i<3 && steps[i]*decade<=mmax; i++)
+            {
+               m.push_back(steps[i]*decade);
+            }
+         }
+      }
+      else
+      {
+         for(unsigned long k=1; k<=mmax; k++)
+         {
+            m.push_back(k);
+         }
+      }
+
+      return m;
+
+   }  // End of method 'ClockStability::factors()'
+
+
+      // Variance at averaging factor m.
+   double ClockStability::variance(DeviationType type, unsigned long m) const
+      throw(Exception)
+   {
+      if(m < 1 || m > maxFactor(type))
+      {
+         Exception e("Averaging factor " + StringUtils::asString(m)
+                     + " is out of range for "
+                     + StringUtils::asString(x.size()) + " phase points");
+         GPSTK_THROW(e);
+      }
+
+      return computeVariance(type, m);
+   }
+
+
+      // Deviation at averaging factor m.
+   double ClockStability::deviation(DeviationType type, unsigned long m) const
+      throw(Exception)
+   {
+      try
+      {
+         return std::sqrt(variance(type, m));
+      }
+      catch(Exception& e)
+      {
+         GPSTK_RETHROW(e);
+      }
+   }
+
+
+      // Compute the deviation at each of the given averaging factors.
+   void ClockStability::compute(DeviationType type,
+                                const std::vector<unsigned long>& m,
+                                std::vector<double>& tau,
+                                std::vector<double>& dev) const
+      throw(Exception)
+   {
+      unsigned long mmax(maxFactor(type));
+
+         // check first; nothing may throw inside the parallel loop
+      for(size_t k=0; k<m.size(); k++)
+      {
+         if(m[k] < 1 || m[k] > mmax)
+         {
+            Exception e("Averaging factor " + StringUtils::asString(m[k])
+                        + " is out of range for "
+                        + StringUtils::asString(x.size()) + " phase points");
+            GPSTK_THROW(e);
+         }
+      }
+
+      long nm(m.size());
+      tau.resize(nm);
+      dev.resize(nm);
+
+#ifdef _OPENMP
+      int nt( numThreads > 0 ? numThreads : omp_get_max_threads() );
+#pragma omp parallel for schedule(dynamic) num_threads(nt)
+#endif
+      for(long k=0; k<nm; k++)
+      {
+         tau[k] = double(m[k])*tau0;
+         dev[k] = std::sqrt(computeVariance(type, m[k]));
+      }
+
+   }  // End of method 'ClockStability::compute()'
+
+
+      // Variance at factor m; no checking of m.
+   double ClockStability::computeVariance(DeviationType type,
+                                          unsigned long m) const
+      throw()
+   {
+      switch(type)
+      {
+         case OverlappingAllan:
+            return allanVariance(m);
+         case ModifiedAllan:
+            return modifiedVariance(m);
+         case OverlappingHadamard:
+            return hadamardVariance(m);
+         case TotalAllan:
+            return totalVariance(m);
+      }
+
+      return 0.0;
+   }
+
+
+      // Overlapping Allan variance
+      //  sigma^2 = Sum(x[i+2m]-2x[i+m]+x[i])^2 / (2 (N-2m) tau^2)
+   double ClockStability::allanVariance(unsigned long m) const throw()
+   {
+      unsigned long N(x.size()), n(0);
+      double sum(0.0), tau(double(m)*tau0);
+      const double *p(&x[0]);
+
+      if(gaps.back() == 0)
+      {
+         n = N-2*m;
+         for(unsigned long i=0; i<n; i++)
+         {
+            double d(p[i+2*m] - 2.0*p[i+m] + p[i]);
+            sum += d*d;
+         }
+      }
+      else
+      {
+         for(unsigned long i=0; i<N-2*m; i++)
+         {
+            if(missing[i] || missing[i+m] || missing[i+2*m]) continue;
+            double d(p[i+2*m] - 2.0*p[i+m] + p[i]);
+            sum += d*d;
+            n++;
+         }
+      }
+
+      if(n == 0) return 0.0;
+
+      return sum/(2.0*double(n)*tau*tau);
+   }
+
+
+      // Modified Allan variance
+      //  sigma^2 = Sum_j [Sum_{i=j}^{j+m-1} (x[i+2m]-2x[i+m]+x[i])]^2
+      //                                          / (2 m^2 tau^2 (N-3m+1))
+      // where the inner sum is a third difference of the cumulative sums.
+   double ClockStability::modifiedVariance(unsigned long m) const throw()
+   {
+      unsigned long N(x.size()), n(0);
+      double sum(0.0), tau(double(m)*tau0);
+      bool check(gaps.back() > 0);
+
+      for(unsigned long j=0; j<=N-3*m; j++)
+      {
+         if(check && gaps[j+3*m] != gaps[j]) continue;
+         double d( sums[j+3*m] - 3.0L*sums[j+2*m]
+                 + 3.0L*sums[j+m] - sums[j] );
+         sum += d*d;
+         n++;
+      }
+
+      if(n == 0) return 0.0;
+
+      return sum/(2.0*double(m)*double(m)*tau*tau*double(n));
+   }
+
+
+      // Overlapping Hadamard variance
+      //  sigma^2 = Sum(x[i+3m]-3x[i+2m]+3x[i+m]-x[i])^2 / (6 (N-3m) tau^2)
+   double ClockStability::hadamardVariance(unsigned long m) const throw()
+   {
+      unsigned long N(x.size()), n(0);
+      double sum(0.0), tau(double(m)*tau0);
+      const double *p(&x[0]);
+
+      if(gaps.back() == 0)
+      {
+         n = N-3*m;
+         for(unsigned long i=0; i<n; i++)
+         {
+            double d(p[i+3*m] - 3.0*p[i+2*m] + 3.0*p[i+m] - p[i]);
+            sum += d*d;
+         }
+      }
+      else
+      {
+         for(unsigned long i=0; i<N-3*m; i++)
+         {
+            if(missing[i] || missing[i+m] || missing[i+2*m] || missing[i+3*m])
+               continue;
+            double d(p[i+3*m] - 3.0*p[i+2*m] + 3.0*p[i+m] - p[i]);
+            sum += d*d;
+            n++;
+         }
+      }
+
+      if(n == 0) return 0.0;
+
+      return sum/(6.0*double(n)*tau*tau);
+   }
+
+
+      // Total variance, using the phase reflected about both ends
+      //  sigma^2 = Sum_{i=1}^{N-2} (x*[i-m]-2x[i]+x*[i+m])^2 / (2 (N-2) tau^2)
+   double ClockStability::totalVariance(unsigned long m) const throw()
+   {
+      long N(x.size()), k(m);
+      double sum(0.0), tau(double(m)*tau0);
+
+      for(long i=1; i<N-1; i++)
+      {
+         double d(reflected(i-k) - 2.0*x[i] + reflected(i+k));
+         sum += d*d;
+      }
+
+      return sum/(2.0*double(N-2)*tau*tau);
+   }
+
+
+      // Phase reflected about both ends of the data.
+   double ClockStability::reflected(long k) const throw()
+   {
+      long last(x.size()-1);
+
+      if(k < 0) return 2.0*x[0] - x[-k];
+      if(k > last) return 2.0*x[last] - x[2*last-k];
+
+      return x[k];
+   }
+
+}  // End of namespace gpstk
@@ -0,0 +1,200 @@
+#pragma ident "$Id$"
+
+//============================================================================
+//
+//  This file is part of GPSTk, the GPS Toolkit.
+//
+//  The GPSTk is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU Lesser General Public License as published
+//  by the Free Software Foundation; either version 2.1 of the License, or
+//  any later version.
+//
+//  The GPSTk is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU Lesser General Public License for more details.
+//
+//  You should have received a copy of the GNU Lesser General Public
+//  License along with GPSTk; if not, write to the Free Software Foundation,
+//  Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110, USA
+//
+//  Copyright 2004, The University of Texas at Austin
+//
+//============================================================================
+
+/**
+ * @file ClockStability.hpp
+ * Frequency stability (Allan, modified Allan, Hadamard and total deviation)
+ * of clock phase data.
+ */
+
+#ifndef GPSTK_CLOCKSTABILITY_HPP
+#define GPSTK_CLOCKSTABILITY_HPP
+
+#include <vector>
+
+#include "Exception.hpp"
+
+namespace gpstk
+{
+   /** @addtogroup math */
+   //@{
+
+   /// Compute frequency stability statistics of clock phase data, sampled
+   /// at a constant interval tau0.
+   ///
+   /// Phase data may be added a point at a time as it arrives, and results
+   /// are available at any time. Each averaging factor m (tau = m*tau0) is
+   /// computed in O(N): the modified Allan deviation uses cumulative sums of
+   /// the phase in place of its inner average. Averaging factors may be
+   /// every m, or octave or decade spaced, and the factors are distributed
+   /// over threads when the library is built with OpenMP.
+   ///
+   /// A phase of exactly zero, other than the first point, marks missing
+   /// data; terms touching a missing point are skipped and the variance is
+   /// normalized by the number of terms used. The total deviation ignores
+   /// missing data.
+   ///
+   /// Formulas follow W. J. Riley, "Handbook of Frequency Stability
+   /// Analysis", NIST SP 1065.
+   class ClockStability
+   {
+   public:
+
+         /// The statistics that may be computed.
+      enum DeviationType
+      {
+         OverlappingAllan,       ///< overlapping Allan deviation
+         ModifiedAllan,          ///< modified Allan deviation
+         OverlappingHadamard,    ///< overlapping Hadamard deviation
+         TotalAllan              ///< total (Allan) deviation
+      };
+
+         /// Spacing of the averaging factors m, tau = m*tau0.
+      enum TauSpacing
+      {
+         AllTau,                 ///< m = 1,2,3,...
+         OctaveTau,              ///< m = 1,2,4,8,...
+         DecadeTau               ///< m = 1,2,4,10,20,40,...
+      };
+
+         /// Constructor
+         /// @param t0  basic measurement interval of the phase data (s)
+      ClockStability(double t0 = 1.0) throw()
+         : tau0(t0), numThreads(0)
+      { clear(); }
+
+         /// Remove all phase data.
+      void clear(void) throw();
+
+         /// Append one phase point.
+      void add(double phase) throw();
+
+         /// Append a vector of phase points, in time order.
+      void add(const std::vector<double>& phase) throw();
+
+         /// Number of phase points stored.
+      unsigned long size(void) const throw()
+      { return missing.size(); }
+
+         /// Number of missing points (phase exactly zero) found so far.
+      unsigned long getNumGaps(void) const throw()
+      { return gaps.back(); }
+
+         /// Set the basic measurement interval (s).
+      ClockStability& setTau0(double t0) throw()
+      { tau0 = t0; return (*this); }
+
+         /// Get the basic measurement interval (s).
+      double getTau0(void) const throw()
+      { return tau0; }
+
+         /// Set the number of threads used by compute(); zero means the
+         /// OpenMP default. Ignored when built without OpenMP.
+      ClockStability& setThreads(int n) throw()
+      { numThreads = n; return (*this); }
+
+         /// Largest averaging factor m for which the given statistic is
+         /// defined with the current data; zero if none.
+      unsigned long maxFactor(DeviationType type) const throw();
+
+         /// Averaging factors m, with the given spacing, up to maxFactor().
+      std::vector<unsigned long> factors(DeviationType type,
+                                         TauSpacing spacing) const throw();
+
+         /// Variance at averaging factor m.
+         /// @throw Exception if m is zero or greater than maxFactor(type)
+      double variance(DeviationType type, unsigned long m) const
+         throw(Exception);
+
+         /// Deviation (square root of variance()) at averaging factor m.
+      double deviation(DeviationType type, unsigned long m) const
+         throw(Exception);
+
+         /// Compute the deviation at each of the given averaging factors.
+         /// @param type   statistic to compute
+         /// @param m      averaging factors, each in 1..maxFactor(type)
+         /// @param tau    output averaging times m*tau0 (s), parallel to m
+         /// @param dev    output deviations, parallel to m
+         /// @throw Exception if any factor is out of range
+      void compute(DeviationType type,
+                   const std::vector<unsigned long>& m,
+                   std::vector<double>& tau,
+                   std::vector<double>& dev) const
+         throw(Exception);
+
+         /// Compute the deviation at all factors with the given spacing.
+      void compute(DeviationType type,
+                   TauSpacing spacing,
+                   std::vector<double>& tau,
+                   std::vector<double>& dev) const
+         throw(Exception)
+      { compute(type, factors(type, spacing), tau, dev); }
+
+   private:
+
+         /// Variance at factor m; no checking of m.
+      double computeVariance(DeviationType type, unsigned long m) const
+         throw();
+
+      double allanVariance(unsigned long m) const throw();
+      double modifiedVariance(unsigned long m) const throw();
+      double hadamardVariance(unsigned long m) const throw();
+      double totalVariance(unsigned long m) const throw();
+
+         /// Phase at index k of the data reflected about both ends, as used
+         /// by the total variance; -(N-1) < k < 2(N-1).
+      double reflected(long k) const throw();
+
+         /// Basic measurement interval (s).
+      double tau0;
+
+         /// Number of threads for compute(), 0 for the default.
+      int numThreads;
+
+         /// Phase and slope of the first points; these are removed from the
+         /// stored phase, to which all the statistics are insensitive, to
+         /// keep the cumulative sums small.
+      double x0, slope;
+
+         /// Phase minus the linear trend given by x0 and slope; zero where
+         /// the point is missing.
+      std::vector<double> x;
+
+         /// Cumulative sums: sums[k] = x[0] + ... + x[k-1].
+      std::vector<long double> sums;
+
+         /// Non-zero where the phase point is missing.
+      std::vector<char> missing;
+
+         /// Cumulative count of missing points: gaps[k] is the number
+         /// missing in x[0] ... x[k-1].
+      std::vector<unsigned long> gaps;
+
+   }; // End of class 'ClockStability'
+
+   //@}
+
+}  // End of namespace gpstk
+
+#endif   // GPSTK_CLOCKSTABILITY_HPP
@@ -0,0 +1,288 @@
+#pragma ident "$Id$"
+
+
+
+/**
+ * @file FixedMatrix.hpp
+ * Small matrix of compile time size, held on the stack
+ */
+
+#ifndef GPSTK_FIXEDMATRIX_HPP
+#define GPSTK_FIXEDMATRIX_HPP
+
+//============================================================================
+//
+//  This file is part of GPSTk, the GPS Toolkit.
+//
+//  The GPSTk is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU Lesser General Public License as published
+//  by the Free Software Foundation; either version 2.1 of the License, or
+//  any later version.
+//
+//  The GPSTk is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU Lesser General Public License for more details.
+//
+//  You should have received a copy of the GNU Lesser General Public
+//  License along with GPSTk; if not, write to the Free Software Foundation,
+//  Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110, USA
+//
+//============================================================================
+
+#include "FixedVector.hpp"
+#include "Matrix.hpp"
+
+namespace gpstk
+{
+ /** @addtogroup MatrixGroup */
+   //@{
+
+/**
+ * A matrix whose size R x C is fixed at compile time, stored by rows inside
+ * the object; the companion of FixedVector for 3x3 and 6x6 rotations and
+ * partial derivatives. No operation allocates.
+ *
+ * A FixedMatrix converts to and from a Matrix<T> of the same size.
+ */
+   template <class T, size_t R, size_t C>
+   class FixedMatrix
+   {
+   public:
+         /// STL value type
+      typedef T value_type;
+
+         /// Default constructor; all elements are zero.
+      FixedMatrix()
+         { fill(T(0)); }
+
+         /// Constructor setting all elements to \c x.
+      explicit FixedMatrix(const T& x)
+         { fill(x); }
+
+         /// Constructor from a Matrix<T>, which must be R x C.
+      FixedMatrix(const Matrix<T>& x)
+         { (*this) = x; }
+
+         /// Assignment from a Matrix<T>, which must be R x C.
+      FixedMatrix& operator=(const Matrix<T>& x)
+         {
+            if(x.rows() != R || x.cols() != C)
+            {
+               MatrixException e("Matrix size does not match FixedMatrix");
+               GPSTK_THROW(e);
+            }
+            for(size_t i=0; i<R; i++)
+               for(size_t j=0; j<C; j++)
+                  m[i][j] = x(i,j);
+            return *this;
+         }
+
+         /// Conversion to a Matrix<T>.
+      operator Matrix<T>() const
+         {
+            Matrix<T> x(R, C);
+            for(size_t i=0; i<R; i++)
+               for(size_t j=0; j<C; j++)
+                  x(i,j) = m[i][j];
+            return x;
+         }
+
+         /// The number of rows
+      static size_t rows()
+         { return R; }
+         /// The number of columns
+      static size_t cols()
+         { return C; }
+         /// The number of elements
+      static size_t size()
+         { return R*C; }
+
+         /// Kept for code written for Matrix<T>; the size must be R x C.
+      FixedMatrix& resize(const size_t r, const size_t c, const T& x)
+         {
+            if(r != R || c != C)
+            {
+               MatrixException e("A FixedMatrix can not be resized");
+               GPSTK_THROW(e);
+            }
+            fill(x);
+            return *this;
+         }
+
+         /// Set all elements to \c x.
+      FixedMatrix& fill(const T& x)
+         {
+            for(size_t i=0; i<R; i++)
+               for(size_t j=0; j<C; j++)
+                  m[i][j] = x;
+            return *this;
+         }
+
+         /// The identity matrix
+      static FixedMatrix identity()
+         {
+            FixedMatrix x;
+            for(size_t i=0; i<R && i<C; i++) x.m[i][i] = T(1);
+            return x;
+         }
+
+         /// Non-const element access
+      T& operator()(size_t i, size_t j)
+         { return m[i][j]; }
+         /// Const element access
+      const T& operator()(size_t i, size_t j) const
+         { return m[i][j]; }
+         /// Row i, as a pointer to its C elements
+      T* operator[](size_t i)
+         { return m[i]; }
+         /// Row i, as a pointer to its C elements
+      const T* operator[](size_t i) const
+         { return m[i]; }
+
+         /// Element-wise addition
+      FixedMatrix& operator+=(const FixedMatrix& x)
+         {
+            for(size_t i=0; i<R; i++)
+               for(size_t j=0; j<C; j++)
+                  m[i][j] += x.m[i][j];
+            return *this;
+         }
+         /// Element-wise subtraction
+      FixedMatrix& operator-=(const FixedMatrix& x)
+         {
+            for(size_t i=0; i<R; i++)
+               for(size_t j=0; j<C; j++)
+                  m[i][j] -= x.m[i][j];
+            return *this;
+         }
+         /// Multiplication by a scalar
+      FixedMatrix& operator*=(const T& x)
+         {
+            for(size_t i=0; i<R; i++)
+               for(size_t j=0; j<C; j++)
+                  m[i][j] *= x;
+            return *this;
+         }
+         /// Division by a scalar
+      FixedMatrix& operator/=(const T& x)
+         {
+            for(size_t i=0; i<R; i++)
+               for(size_t j=0; j<C; j++)
+                  m[i][j] /= x;
+            return *this;
+         }
+
+   private:
+         /// The elements, by rows
+      T m[R][C];
+   };
+
+      /// Sum of two FixedMatrices
+   template <class T, size_t R, size_t C>
+   inline FixedMatrix<T,R,C> operator+(FixedMatrix<T,R,C> l,
+                                       const FixedMatrix<T,R,C>& r)
+      { return l += r; }
+
+      /// Difference of two FixedMatrices
+   template <class T, size_t R, size_t C>
+   inline FixedMatrix<T,R,C> operator-(FixedMatrix<T,R,C> l,
+                                       const FixedMatrix<T,R,C>& r)
+      { return l -= r; }
+
+      /// Negation
+   template <class T, size_t R, size_t C>
+   inline FixedMatrix<T,R,C> operator-(FixedMatrix<T,R,C> x)
+      { return x *= T(-1); }
+
+      /// Product of a FixedMatrix and a scalar
+   template <class T, size_t R, size_t C>
+   inline FixedMatrix<T,R,C> operator*(FixedMatrix<T,R,C> l, const T& r)
+      { return l *= r; }
+
+      /// Product of a scalar and a FixedMatrix
+   template <class T, size_t R, size_t C>
+   inline FixedMatrix<T,R,C> operator*(const T& l, FixedMatrix<T,R,C> r)
+      { return r *= l; }
+
+      /// Quotient of a FixedMatrix and a scalar
+   template <class T, size_t R, size_t C>
+   inline FixedMatrix<T,R,C> operator/(FixedMatrix<T,R,C> l, const T& r)
+      { return l /= r; }
+
+      /// Matrix product
+   template <class T, size_t R, size_t K, size_t C>
+   inline FixedMatrix<T,R,C> operator*(const FixedMatrix<T,R,K>& l,
+                                       const FixedMatrix<T,K,C>& r)
+      {
+         FixedMatrix<T,R,C> p;
+         for(size_t i=0; i<R; i++)
+            for(size_t k=0; k<K; k++)
+               for(size_t j=0; j<C; j++)
+                  p(i,j) += l(i,k)*r(k,j);
+         return p;
+      }
+
+      /// Product of a matrix and a column vector
+   template <class T, size_t R, size_t C>
+   inline FixedVector<T,R> operator*(const FixedMatrix<T,R,C>& l,
+                                     const FixedVector<T,C>& r)
+      {
+         FixedVector<T,R> p;
+         for(size_t i=0; i<R; i++)
+            for(size_t j=0; j<C; j++)
+               p[i] += l(i,j)*r[j];
+         return p;
+      }
+
+      /// Product of the transpose of a matrix and a column vector, l' * r
+   template <class T, size_t R, size_t C>
+   inline FixedVector<T,C> transposeTimes(const FixedMatrix<T,R,C>& l,
+                                          const FixedVector<T,R>& r)
+      {
+         FixedVector<T,C> p;
+         for(size_t i=0; i<R; i++)
+            for(size_t j=0; j<C; j++)
+               p[j] += l(i,j)*r[i];
+         return p;
+      }
+
+      /// Transpose
+   template <class T, size_t R, size_t C>
+   inline FixedMatrix<T,C,R> transpose(const FixedMatrix<T,R,C>& x)
+      {
+         FixedMatrix<T,C,R> t;
+         for(size_t i=0; i<R; i++)
+            for(size_t j=0; j<C; j++)
+               t(j,i) = x(i,j);
+         return t;
+      }
+
+      /// Output, in the same format as Matrix<T>
+   template <class T, size_t R, size_t C>
+   std::ostream& operator<<(std::ostream& s, const FixedMatrix<T,R,C>& x)
+      {
+         std::streamsize w(s.width());
+         for(size_t i=0; i<R; i++)
+         {
+            for(size_t j=0; j<C; j++)
+            {
+               s << (j ? " " : "");
+               s.width(w);
+               s << x(i,j);
+            }
+            if(i < R-1) s << std::endl;
+         }
+         return s;
+      }
+
+      /// 3x3 matrix of doubles, e.g. a rotation or a gravity gradient
+   typedef FixedMatrix<double,3,3> Matrix3;
+      /// 6x6 matrix of doubles, e.g. a state transition matrix
+   typedef FixedMatrix<double,6,6> Matrix6;
+
+   //@}
+
+}  // namespace
+
+#endif
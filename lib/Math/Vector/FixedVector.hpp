@@ -0,0 +1,253 @@
+#pragma ident "$Id$"
+
+
+
+/**
+ * @file FixedVector.hpp
+ * Small vector of compile time size, held on the stack
+ */
+
+#ifndef GPSTK_FIXEDVECTOR_HPP
+#define GPSTK_FIXEDVECTOR_HPP
+
+//============================================================================
+//
+//  This file is part of GPSTk, the GPS Toolkit.
+//
+//  The GPSTk is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU Lesser General Public License as published
+//  by the Free Software Foundation; either version 2.1 of the License, or
+//  any later version.
+//
+//  The GPSTk is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU Lesser General Public License for more details.
+//
+//  You should have received a copy of the GNU Lesser General Public
+//  License along with GPSTk; if not, write to the Free Software Foundation,
+//  Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110, USA
+//
+//============================================================================
+
+#include <cmath>
+#include <ostream>
+#include "Vector.hpp"
+
+namespace gpstk
+{
+ /** @addtogroup VectorGroup */
+   //@{
+
+/**
+ * A vector whose size N is fixed at compile time. The elements live inside
+ * the object, so creating, copying and returning a FixedVector never touches
+ * the heap. It is meant for the 3- and 6-vectors of positions, velocities
+ * and accelerations in inner loops, where Vector<T> would allocate for
+ * every temporary.
+ *
+ * A FixedVector converts to and from a Vector<T> of the same size, so it
+ * can be passed to code that still uses Vector<T>.
+ */
+   template <class T, size_t N>
+   class FixedVector
+   {
+   public:
+         /// STL value type
+      typedef T value_type;
+         /// STL iterator type
+      typedef T* iterator;
+         /// STL const iterator type
+      typedef const T* const_iterator;
+
+         /// Default constructor; all elements are zero.
+      FixedVector()
+         { fill(T(0)); }
+
+         /// Constructor setting all elements to \c x.
+      explicit FixedVector(const T& x)
+         { fill(x); }
+
+         /// Constructor from the first N elements of an array.
+      explicit FixedVector(const T* x)
+         { for(size_t i=0; i<N; i++) v[i] = x[i]; }
+
+         /// Constructor from a Vector<T>, which must have N elements.
+      FixedVector(const Vector<T>& x)
+         { (*this) = x; }
+
+         /// Assignment from a Vector<T>, which must have N elements.
+      FixedVector& operator=(const Vector<T>& x)
+         {
+            if(x.size() != N)
+            {
+               VectorException e("Vector size does not match FixedVector");
+               GPSTK_THROW(e);
+            }
+            for(size_t i=0; i<N; i++) v[i] = x[i];
+            return *this;
+         }
+
+         /// Conversion to a Vector<T>.
+      operator Vector<T>() const
+         {
+            Vector<T> x(N);
+            for(size_t i=0; i<N; i++) x[i] = v[i];
+            return x;
+         }
+
+         /// Returns the size of the vector.
+      static size_t size()
+         { return N; }
+
+         /// Kept for code written for Vector<T>; \c n must be N.
+      FixedVector& resize(const size_t n, const T& x)
+         {
+            if(n != N)
+            {
+               VectorException e("A FixedVector can not be resized");
+               GPSTK_THROW(e);
+            }
+            fill(x);
+            return *this;
+         }
+
+         /// Set all elements to \c x.
+      FixedVector& fill(const T& x)
+         { for(size_t i=0; i<N; i++) v[i] = x; return *this; }
+
+         /// Non-const element access
+      T& operator[](size_t i)
+         { return v[i]; }
+         /// Const element access
+      const T& operator[](size_t i) const
+         { return v[i]; }
+         /// Non-const element access
+      T& operator()(size_t i)
+         { return v[i]; }
+         /// Const element access
+      const T& operator()(size_t i) const
+         { return v[i]; }
+
+         /// STL begin
+      iterator begin() { return v; }
+         /// STL const begin
+      const_iterator begin() const { return v; }
+         /// STL end
+      iterator end() { return v + N; }
+         /// STL const end
+      const_iterator end() const { return v + N; }
+
+         /// Element-wise addition
+      FixedVector& operator+=(const FixedVector& x)
+         { for(size_t i=0; i<N; i++) v[i] += x.v[i]; return *this; }
+         /// Element-wise subtraction
+      FixedVector& operator-=(const FixedVector& x)
+         { for(size_t i=0; i<N; i++) v[i] -= x.v[i]; return *this; }
+         /// Multiplication by a scalar
+      FixedVector& operator*=(const T& x)
+         { for(size_t i=0; i<N; i++) v[i] *= x; return *this; }
+         /// Division by a scalar
+      FixedVector& operator/=(const T& x)
+         { for(size_t i=0; i<N; i++) v[i] /= x; return *this; }
+
+   private:
+         /// The elements
+      T v[N];
+   };
+
+      /// Sum of two FixedVectors
+   template <class T, size_t N>
+   inline FixedVector<T,N> operator+(FixedVector<T,N> l,
+                                     const FixedVector<T,N>& r)
+      { return l += r; }
+
+      /// Difference of two FixedVectors
+   template <class T, size_t N>
+   inline FixedVector<T,N> operator-(FixedVector<T,N> l,
+                                     const FixedVector<T,N>& r)
+      { return l -= r; }
+
+      /// Negation
+   template <class T, size_t N>
+   inline FixedVector<T,N> operator-(FixedVector<T,N> x)
+      { return x *= T(-1); }
+
+      /// Product of a FixedVector and a scalar
+   template <class T, size_t N>
+   inline FixedVector<T,N> operator*(FixedVector<T,N> l, const T& r)
+      { return l *= r; }
+
+      /// Product of a scalar and a FixedVector
+   template <class T, size_t N>
+   inline FixedVector<T,N> operator*(const T& l, FixedVector<T,N> r)
+      { return r *= l; }
+
+      /// Quotient of a FixedVector and a scalar
+   template <class T, size_t N>
+   inline FixedVector<T,N> operator/(FixedVector<T,N> l, const T& r)
+      { return l /= r; }
+
+      /// Dot product
+   template <class T, size_t N>
+   inline T dot(const FixedVector<T,N>& l, const FixedVector<T,N>& r)
+      {
+         T sum(0);
+         for(size_t i=0; i<N; i++) sum += l[i]*r[i];
+         return sum;
+      }
+
+      /// Euclidian norm, computed as norm() of a Vector<T>, which
+      /// guards against overflow, so both give the same result
+   template <class T, size_t N>
+   inline T norm(const FixedVector<T,N>& x)
+      {
+         T mag = std::abs(x[0]);
+         for(size_t i=1; i<N; i++)
+         {
+            if(mag > std::abs(x[i]))
+               mag *= std::sqrt(T(1)+(x[i]/mag)*(x[i]/mag));
+            else if(std::abs(x[i]) > mag)
+               mag = std::abs(x[i])*std::sqrt(T(1)+(mag/x[i])*(mag/x[i]));
+            else
+               mag *= std::sqrt(T(2));
+         }
+         return mag;
+      }
+
+      /// Cross product of two 3-vectors
+   template <class T>
+   inline FixedVector<T,3> cross(const FixedVector<T,3>& l,
+                                 const FixedVector<T,3>& r)
+      {
+         FixedVector<T,3> c;
+         c[0] = l[1]*r[2] - l[2]*r[1];
+         c[1] = l[2]*r[0] - l[0]*r[2];
+         c[2] = l[0]*r[1] - l[1]*r[0];
+         return c;
+      }
+
+      /// Output, in the same format as Vector<T>
+   template <class T, size_t N>
+   std::ostream& operator<<(std::ostream& s, const FixedVector<T,N>& x)
+      {
+         std::streamsize w(s.width());
+         for(size_t i=0; i<N; i++)
+         {
+            s << (i ? " " : "");
+            s.width(w);
+            s << x[i];
+         }
+         return s;
+      }
+
+      /// 3-vector of doubles, e.g. a position or an acceleration
+   typedef FixedVector<double,3> Vector3;
+      /// 6-vector of doubles, e.g. a position and velocity state
+   typedef FixedVector<double,6> Vector6;
+
+   //@}
+
+}  // namespace
+
+#endif
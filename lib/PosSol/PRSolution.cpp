@@ -28,6 +28,7 @@
 #include "PRSolution.hpp"
 #include "GPSEllipsoid.hpp"
 #include "Combinations.hpp"
+#include "PRSubsetSearch.hpp"
 #include "TimeString.hpp"
 #include "stl_helpers.hpp"
 #include "logstream.hpp"
@@ -562,19 +563,80 @@ namespace gpstk
          // Resids stores the post-fit data residuals.
          Vector<double> Resids;
 
+         // The combinations of a stage are solved in the order of the RMS residual
+         // predicted from the solution with all satellites (stage 0), and the
+         // search ends when the rest cannot do better than the best found; see
+         // ExhaustiveSearch. The same combination is chosen as when all are solved:
+         // ties go to the first combination, the combinations after one with too
+         // few satellites are not used, and the last combination is always solved
+         // when the stage fails, as its return value decides whether to go on.
+         bool Ordered(false);
+         PRSubsetSearch Search;
+         int BestStage(-1), BestCombo(-1);
+
          // stage is the number of satellites to reject.
          int stage(0);
 
          do {
             // compute all the combinations of N satellites taken stage at a time
+            vector< vector<bool> > UseCombo;
             Combinations Combo(N,stage);
+            do {
+               vector<bool> Use(N,true);
+               for(i=0; i<GoodIndexes.size(); i++)
+                  if(Combo.isSelected(i)) Use[i] = false;
+               UseCombo.push_back(Use);
+            } while(Combo.Next() != -1);
+
+            // predict the RMS residual of each combination, and order them
+            vector<double> Predicted(UseCombo.size(),-1.0);
+            int NCombo(UseCombo.size()), TooFew(-1);
+            if(Ordered) {
+               Vector<double> dX,PResid;
+               for(int c=0; c<NCombo; c++) {
+                  // SimplePRSolution() returns -3, and the stage ends, at the
+                  // first combination with fewer satellites than unknowns
+                  vector<SatID::SatelliteSystem> comboSyss;
+                  int nsats(0);
+                  for(i=0; i<GoodIndexes.size(); i++) {
+                     if(!UseCombo[c][i]) continue;
+                     nsats++;
+                     if(vectorindex(comboSyss, Sats[GoodIndexes[i]].system) == -1)
+                        comboSyss.push_back(Sats[GoodIndexes[i]].system);
+                  }
+                  if(nsats < 3+int(comboSyss.size())) {
+                     TooFew = c;
+                     NCombo = c+1;
+                     break;
+                  }
+
+                  if(Search.predict(UseCombo[c], dX, PResid))
+                     Predicted[c] = RMS(PResid);
+               }
+            }
+            vector<int> Order(PRSubsetSearch::order(
+                        vector<double>(Predicted.begin(),Predicted.begin()+NCombo)));
+            if(TooFew > -1) {          // solve it last
+               Order.erase(find(Order.begin(), Order.end(), TooFew));
+               Order.push_back(TooFew);
+            }
+            double MaxError(0.0);
+            int LastIret(0);
 
             // compute a solution for each combination of marked satellites
-            do {
+            for(int k=0; k<NCombo; k++) {
+               const int c(Order[k]);
+
+               // skip it if it is predicted to be worse than the best
+               if(Predicted[c] >= 0.0 && BestRMS >= 0.0
+                  && Predicted[c] > BestRMS + SearchMargin + 2.0*MaxError
+                  && (c != NCombo-1 || (BestRMS > 0.0 && BestRMS < RMSLimit)))
+                  continue;
+
                // Mark the satellites for this combination
                Sats = SaveSats;
                for(i=0; i<GoodIndexes.size(); i++)
-                  if(Combo.isSelected(i))
+                  if(!UseCombo[c][i])
                      Sats[GoodIndexes[i]].id = -::abs(Sats[GoodIndexes[i]].id);
 
                if(LOGlevel >= ConfigureLOG::Level("DEBUG")) {
@@ -601,6 +663,7 @@ namespace gpstk
 
                LOG(DEBUG) << " RAIM: SimplePRS returns " << iret;
                if(iret <= 0 && iret > BestIret) BestIret = iret;
+               if(c == NCombo-1) LastIret = iret;
 
                // ----------------------------------------------------------------
                // if error, either quit or continue with next combo (SPS sets Valid F)
@@ -623,6 +686,9 @@ namespace gpstk
                   }
                }
 
+               if(Predicted[c] >= 0.0 && ::fabs(RMSResidual-Predicted[c]) > MaxError)
+                  MaxError = ::fabs(RMSResidual-Predicted[c]);
+
                // ----------------------------------------------------------------
                // print solution with diagnostic information
                LOG(DEBUG) << outputString(string("RPS"),iret);
@@ -634,7 +700,8 @@ namespace gpstk
 
                // deal with the results of SimplePRSolution()
                // save 'best' solution for later
-               if(BestRMS < 0.0 || RMSResidual < BestRMS) {
+               if(BestRMS < 0.0 || RMSResidual < BestRMS ||
+                  (RMSResidual == BestRMS && stage == BestStage && c < BestCombo)) {
                   BestRMS = RMSResidual;
                   BestSol = Solution;
                   BestSats = SatelliteIDs;
@@ -648,12 +715,17 @@ namespace gpstk
                   BestPFR = PreFitResidual;
                   BestTropFlag = TropFlag;
                   BestIret = iret;
+                  BestStage = stage;
+                  BestCombo = c;
                }
 
                if(stage==0 && RMSResidual < RMSLimit)
                   break;
 
-            } while(Combo.Next() != -1);  // get the next combinations and repeat
+            }  // get the next combinations and repeat
+
+            // the return value of the last combination, as if all were solved
+            if(Ordered) iret = LastIret;
 
             // end of the stage
             if(BestRMS > 0.0 && BestRMS < RMSLimit) {          // success
@@ -662,6 +734,13 @@ namespace gpstk
                break;
             }
 
+            // the solution with all satellites predicts the others
+            if(stage == 0 && iret == 0 && !ExhaustiveSearch
+                  && Partials.rows() == size_t(N) && Resids.size() == size_t(N)) {
+               Search = PRSubsetSearch(Partials, Resids, invMeasCov);
+               Ordered = true;
+            }
+
             // go to next stage
             stage++;
 
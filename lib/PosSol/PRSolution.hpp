@@ -348,6 +348,8 @@ namespace gpstk
                              NSatsReject(-1),
                              MaxNIterations(10),
                              ConvergenceLimit(3.e-7),
+                             ExhaustiveSearch(false),
+                             SearchMargin(0.01),
                              Valid(false),
                              hasMemory(true)
          {};
@@ -377,6 +379,19 @@ namespace gpstk
       /// solution exceeds this.
       double ConvergenceLimit;
 
+      /// If false (the default), when satellites must be rejected RAIMCompute()
+      /// predicts the RMS residual of every combination from the solution with all
+      /// the satellites (see PRSubsetSearch), solves the combinations in the order
+      /// of the prediction, and stops when the rest are predicted to be worse than
+      /// the best found by more than SearchMargin. If true, every combination is
+      /// solved.
+      bool ExhaustiveSearch;
+
+      /// Margin (m) on the predicted RMS residual used to end the search (see
+      /// ExhaustiveSearch); twice the largest error of the prediction found so far,
+      /// in the current stage, is added to it.
+      double SearchMargin;
+
       /// vector<SatID> containing the satellite systems included in the solution. 
       /// It should be defined before the first solution call; if it is empty at that
       /// time it will be determined by the input SatelliteIDs. It is used to
@@ -29,6 +29,7 @@
  
 #include "MathBase.hpp"
 #include "PRSolution2.hpp"
+#include "PRSubsetSearch.hpp"
 #include "EphemerisRange.hpp"
 #include "GPSEllipsoid.hpp"
 #include "GPSWeekSecond.hpp"
@@ -335,22 +336,74 @@ namespace gpstk
          // Residuals stores the post-fit data residuals.
          Vector<double> Residuals(Satellite.size(),0.0);
          
+         // The combinations of a stage are solved in the order of the RMS predicted
+         // from the solution with all satellites (stage 0), and the search ends when
+         // the rest cannot do better than the best found; see ExhaustiveSearch.
+         // The same combination is chosen as when all are solved: ties go to the
+         // first combination, and the last combination is always solved when the
+         // stage fails, as its return value decides whether to go on.
+         bool Ordered(false);
+         PRSubsetSearch Search;
+         Vector<double> APoint;     // linearization point of Search
+         Matrix<double> Partials;
+         int BestStage(-1), BestCombo(-1);
+
          // stage is the number of satellites to reject.
          stage = 0;
          
          do{
-            // compute all the Combinations of N satellites taken stage at a time
+            // compute all the Combinations of N satellites taken stage at a time,
+            // and mark the satellites for each
+            vector< vector<bool> > UseCombo;
             Combinations Combo(N,stage);
-            
-            // compute a solution for each combination of marked satellites
             do{
-               // Mark the satellites for this combination
                UseSat = UseSave;
                for (i = 0; i < GoodIndexes.size(); i++)
                {
                   if (Combo.isSelected(i))
-                     UseSat[i]=false;
+                     UseSat[GoodIndexes[i]]=false;
+               }
+               UseCombo.push_back(UseSat);
+            } while(Combo.Next() != -1);
+            const int NCombo(UseCombo.size());
+
+            // predict the RMS of each combination, and order them
+            vector<double> Predicted(NCombo,-1.0);
+            if (Ordered)
+            {
+               vector<bool> UseRow(N);
+               Vector<double> dX,PResid;
+               for (int c = 0; c < NCombo; c++)
+               {
+                  for (j = 0; j < GoodIndexes.size(); j++)
+                     UseRow[j] = UseCombo[c][GoodIndexes[j]];
+                  if (!Search.predict(UseRow, dX, PResid))
+                     continue;
+                  if (!ResidualCriterion)
+                  {
+                     Vector<double> D=APoint+dX-APrioriSolution;
+                     Predicted[c] = RMS(D);
+                  }
+                  else
+                     Predicted[c] = RMS(PResid);
                }
+            }
+            vector<int> Order(PRSubsetSearch::order(Predicted));
+            double MaxError(0.0);
+            int LastIret(0);
+            
+            // compute a solution for each combination of marked satellites
+            for (int k = 0; k < NCombo; k++)
+            {
+               const int c(Order[k]);
+
+               // skip it if it is predicted to be worse than the best
+               if (Predicted[c] >= 0.0 && BestRMS >= 0.0
+                  && Predicted[c] > BestRMS + SearchMargin + 2.0*MaxError
+                  && (c != NCombo-1 || (BestRMS > 0.0 && BestRMS < RMSLimit)))
+                  continue;
+
+               UseSat = UseCombo[c];
                // ----------------------------------------------------------------
                // Compute a solution given the data; ignore ranges for marked
                // satellites. Fill Vector 'Slopes' with slopes for each unmarked
@@ -363,7 +416,10 @@ namespace gpstk
                Convergence = ConvergenceLimit;
                iret = AutonomousPRSolution(Tr, UseSat, SVP, pTropModel, Algebraic,
                   NIterations, Convergence, Solution, Covariance, Residuals, Slopes,
-                  pDebugStream, ((hasGlonass && hasOther)?(&satSystems):(NULL)) );
+                  pDebugStream, ((hasGlonass && hasOther)?(&satSystems):(NULL)),
+                  (stage == 0 ? &Partials : NULL) );
+               if (c == NCombo-1)
+                  LastIret = iret;
                
                // ----------------------------------------------------------------
                // Compute RMS residual...
@@ -378,6 +434,9 @@ namespace gpstk
                   // and in the usual case
                   RMSResidual = RMS(Residuals);
                }
+               if (iret == 0 && Predicted[c] >= 0.0
+                  && ::fabs(RMSResidual-Predicted[c]) > MaxError)
+                  MaxError = ::fabs(RMSResidual-Predicted[c]);
                // ... and find the maximum slope
                MaxSlope = 0.0;
                if (iret == 0)
@@ -429,7 +488,8 @@ namespace gpstk
                else
                {  // success
                      // save 'best' solution for later
-                  if (BestRMS < 0.0 || RMSResidual < BestRMS)
+                  if (BestRMS < 0.0 || RMSResidual < BestRMS ||
+                      (RMSResidual == BestRMS && stage == BestStage && c < BestCombo))
                   {
                      BestRMS = RMSResidual;
                      BestSol = Solution;
@@ -437,6 +497,8 @@ namespace gpstk
                      BestSL = MaxSlope;
                      BestConv = Convergence;
                      BestNIter = NIterations;
+                     BestStage = stage;
+                     BestCombo = c;
                   }
                      // quit immediately?
                   if ((stage==0 || ReturnAtOnce) && RMSResidual < RMSLimit)
@@ -444,7 +506,10 @@ namespace gpstk
                }
                
                // get the next Combinations and repeat
-            } while(Combo.Next() != -1);
+            }
+            // the return value of the last combination, as if all were solved
+            if (Ordered)
+               iret = LastIret;
             
             // end of the stage
             if (BestRMS > 0.0 && BestRMS < RMSLimit)
@@ -452,6 +517,19 @@ namespace gpstk
                iret=0;
                break;
             }
+
+            // the solution with all satellites predicts the others
+            if (stage == 0 && iret == 0 && !ExhaustiveSearch && !ReturnAtOnce
+               && !Algebraic && int(Partials.rows()) == N)
+            {
+               Search = PRSubsetSearch(Partials, Residuals, Matrix<double>());
+               Vector<double> dX,PResid;
+               if (Search.predict(vector<bool>(N,true), dX, PResid))
+               {
+                  APoint = Solution - dX;
+                  Ordered = true;
+               }
+            }
             
             // go to next stage
             stage++;
@@ -677,7 +755,8 @@ namespace gpstk
                                         Vector<double>& Resid,
                                         Vector<double>& Slope,
                                         ostream *pDebugStream,
-                                        Vector<int>* satSystems)   ///Change
+                                        Vector<int>* satSystems,   ///Change
+                                        Matrix<double>* pPartials)
    throw(Exception)
    {
       if (!pTropModel)
@@ -907,6 +986,8 @@ namespace gpstk
                Slope(i) = SQRT(Slope(i)*double(n-4)/(1.0-PG(j,j)));
                j++;
             }
+            if (pPartials)
+               *pPartials = P;
          }
          
          return iret;
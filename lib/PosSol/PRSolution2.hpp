@@ -60,7 +60,8 @@ namespace gpstk
          RMSLimit(6.5), SlopeLimit(1000.), Algebraic(false),
          ResidualCriterion(true), ReturnAtOnce(false), NSatsReject(-1),
          Debug(false), pDebugStream(&std::cout), MaxNIterations(10),
-         ConvergenceLimit(3.e-7), Valid(false)
+         ConvergenceLimit(3.e-7), ExhaustiveSearch(false), SearchMargin(0.01),
+         Valid(false)
       {};
 
       /** Compute a position/time solution, given satellite PRNs and pseudoranges
@@ -140,6 +141,20 @@ namespace gpstk
       /// solution exceeds this.
       double ConvergenceLimit;
 
+      /** If false (the default), when satellites must be rejected RAIMCompute()
+       * predicts the RMS of every combination from the solution with all the
+       * satellites (see PRSubsetSearch), solves the combinations in the order of
+       * the prediction, and stops when the rest are predicted to be worse than
+       * the best found by more than SearchMargin. If true, every combination is
+       * solved, as is always done when ReturnAtOnce or Algebraic is set.
+       */
+      bool ExhaustiveSearch;
+
+      /// Margin (m) on the predicted RMS used to end the search (see
+      /// ExhaustiveSearch); twice the largest error of the prediction found so far,
+      /// in the current stage, is added to it.
+      double SearchMargin;
+
       // output:
 
       /// flag: output content is valid.
@@ -234,6 +249,11 @@ namespace gpstk
        *                    good satellite, length N
        * @param pDebug      pointer to an ostream for debug output, NULL (the default)
        *                    for no debug output.
+       * @param satSystems  for a mixed GPS/GLONASS solution, 1 for each GLONASS
+       *                    satellite and 0 otherwise; NULL (the default) if not mixed.
+       * @param pPartials   if not NULL, on success the partials matrix (one row per
+       *                    satellite used) of the last iteration, which goes with
+       *                    Resid.
        * @return Return values:
        *  0  ok
        * -1  failed to converge
@@ -253,7 +273,8 @@ namespace gpstk
                                       Vector<double>& Resid,
                                       Vector<double>& Slope,
                                       std::ostream *pDebug=NULL,
-                                      Vector<int>* satSystems=NULL)
+                                      Vector<int>* satSystems=NULL,
+                                      Matrix<double>* pPartials=NULL)
             throw(Exception);
 
    private:
@@ -0,0 +1,198 @@
+/// @file PRSubsetSearch.cpp
+/// Prediction of the pseudorange solutions of subsets of the satellites, from the
+/// linearized problem of the full set; used to order the RAIM search.
+
+//============================================================================
+//
+//  This file is part of GPSTk, the GPS Toolkit.
+//
+//  The GPSTk is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU Lesser General Public License as published
+//  by the Free Software Foundation; either version 2.1 of the License, or
+//  any later version.
+//
+//  The GPSTk is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU Lesser General Public License for more details.
+//
+//  You should have received a copy of the GNU Lesser General Public
+//  License along with GPSTk; if not, write to the Free Software Foundation,
+//  Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110, USA
+//
+//============================================================================
+
+#include <algorithm>
+#include <cmath>
+#include "PRSubsetSearch.hpp"
+
+using namespace std;
+
+namespace gpstk
+{
+   // -------------------------------------------------------------------------
+   PRSubsetSearch::PRSubsetSearch(const Matrix<double>& P,
+                                  const Vector<double>& R,
+                                  const Matrix<double>& W)
+      throw(Exception)
+      : Partials(P), Resids(R), diagonal(true)
+   {
+      const size_t n(P.rows()), dim(P.cols());
+      size_t i,j,k;
+
+      if(R.size() != n || (W.rows() > 0 && (W.rows() != n || W.cols() != n))) {
+         Exception e("Invalid dimensions");
+         GPSTK_THROW(e);
+      }
+
+      Wts = Vector<double>(n,1.0);
+      if(W.rows() > 0) {
+         for(i=0; i<n; i++) {
+            Wts(i) = W(i,i);
+            for(j=0; j<n; j++)
+               if(j != i && W(i,j) != 0.0) diagonal = false;
+         }
+         if(!diagonal) Weights = W;
+      }
+
+      // with diagonal weights, the normal equations of the full set are formed
+      // once, and downdated for each subset
+      if(diagonal) {
+         Normal = Matrix<double>(dim,dim,0.0);
+         RHS = Vector<double>(dim,0.0);
+         for(i=0; i<n; i++) {
+            for(j=0; j<dim; j++) {
+               if(P(i,j) == 0.0) continue;
+               const double wp(Wts(i)*P(i,j));
+               RHS(j) += wp*R(i);
+               for(k=0; k<dim; k++) Normal(j,k) += wp*P(i,k);
+            }
+         }
+      }
+   }
+
+   // -------------------------------------------------------------------------
+   bool PRSubsetSearch::predict(const vector<bool>& Use,
+                                Vector<double>& dX,
+                                Vector<double>& Resid) const
+      throw()
+   {
+      const size_t n(Partials.rows()), dim(Partials.cols());
+      size_t i,j,k;
+      int m,nact;
+
+      if(n == 0 || Use.size() != n) return false;
+
+      // count the satellites, and find the unknowns they determine
+      vector<bool> active(dim,false);
+      for(m=0,i=0; i<n; i++) {
+         if(!Use[i]) continue;
+         m++;
+         for(j=0; j<dim; j++)
+            if(Partials(i,j) != 0.0) active[j] = true;
+      }
+      vector<int> act;
+      for(j=0; j<dim; j++)
+         if(active[j]) act.push_back(j);
+      nact = act.size();
+      if(nact == 0 || m < nact) return false;
+
+      // normal equations of the subset, over the active unknowns
+      Matrix<double> N(nact,nact,0.0);
+      Vector<double> b(nact,0.0);
+      if(diagonal) {
+         // downdate the full set by the rank-one term of each rejected satellite
+         for(j=0; j<size_t(nact); j++) {
+            b(j) = RHS(act[j]);
+            for(k=0; k<size_t(nact); k++) N(j,k) = Normal(act[j],act[k]);
+         }
+         for(i=0; i<n; i++) {
+            if(Use[i]) continue;
+            for(j=0; j<size_t(nact); j++) {
+               const double wp(Wts(i)*Partials(i,act[j]));
+               if(wp == 0.0) continue;
+               b(j) -= wp*Resids(i);
+               for(k=0; k<size_t(nact); k++) N(j,k) -= wp*Partials(i,act[k]);
+            }
+         }
+      }
+      else {
+         // correlated data: form the subset directly
+         for(i=0; i<n; i++) {
+            if(!Use[i]) continue;
+            for(size_t l=0; l<n; l++) {
+               if(!Use[l] || Weights(i,l) == 0.0) continue;
+               for(j=0; j<size_t(nact); j++) {
+                  const double wp(Partials(i,act[j])*Weights(i,l));
+                  if(wp == 0.0) continue;
+                  b(j) += wp*Resids(l);
+                  for(k=0; k<size_t(nact); k++) N(j,k) += wp*Partials(l,act[k]);
+               }
+            }
+         }
+      }
+
+      // Cholesky decomposition N = L*LT, in place in the lower triangle;
+      // a pivot that has lost nearly all of its diagonal means (near) singular
+      for(j=0; j<size_t(nact); j++) {
+         double d(N(j,j));
+         for(k=0; k<j; k++) d -= N(j,k)*N(j,k);
+         if(!(d > 1.e-10*N(j,j))) return false;
+         N(j,j) = ::sqrt(d);
+         for(i=j+1; i<size_t(nact); i++) {
+            double s(N(i,j));
+            for(k=0; k<j; k++) s -= N(i,k)*N(j,k);
+            N(i,j) = s/N(j,j);
+         }
+      }
+
+      // solve L*y = b then LT*x = y
+      Vector<double> x(b);
+      for(j=0; j<size_t(nact); j++) {
+         for(k=0; k<j; k++) x(j) -= N(j,k)*x(k);
+         x(j) /= N(j,j);
+      }
+      for(j=nact; j-- > 0; ) {
+         for(k=j+1; k<size_t(nact); k++) x(j) -= N(k,j)*x(k);
+         x(j) /= N(j,j);
+      }
+
+      dX = Vector<double>(dim,0.0);
+      for(j=0; j<size_t(nact); j++) dX(act[j]) = x(j);
+
+      // post-fit residuals of the satellites used
+      Resid = Vector<double>(m);
+      for(m=0,i=0; i<n; i++) {
+         if(!Use[i]) continue;
+         double r(Resids(i));
+         for(j=0; j<dim; j++) r -= Partials(i,j)*dX(j);
+         Resid(m++) = r;
+      }
+
+      return true;
+   }
+
+   // -------------------------------------------------------------------------
+   namespace {
+      // compare candidates by prediction (none first), then by index
+      struct PredictedLess {
+         const vector<double>& P;
+         PredictedLess(const vector<double>& p) : P(p) {}
+         bool operator()(int i, int j) const {
+            const bool ni(P[i] < 0.0), nj(P[j] < 0.0);
+            if(ni != nj) return ni;
+            if(!ni && P[i] != P[j]) return P[i] < P[j];
+            return i < j;
+         }
+      };
+   }
+
+   vector<int> PRSubsetSearch::order(const vector<double>& Predicted) throw()
+   {
+      vector<int> Order(Predicted.size());
+      for(size_t i=0; i<Order.size(); i++) Order[i] = i;
+      sort(Order.begin(), Order.end(), PredictedLess(Predicted));
+      return Order;
+   }
+
+} // namespace gpstk
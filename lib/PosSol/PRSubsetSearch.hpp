@@ -0,0 +1,106 @@
+/// @file PRSubsetSearch.hpp
+/// Prediction of the pseudorange solutions of subsets of the satellites, from the
+/// linearized problem of the full set; used to order the RAIM search.
+
+#ifndef PRS_SUBSET_SEARCH_HPP
+#define PRS_SUBSET_SEARCH_HPP
+
+//============================================================================
+//
+//  This file is part of GPSTk, the GPS Toolkit.
+//
+//  The GPSTk is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU Lesser General Public License as published
+//  by the Free Software Foundation; either version 2.1 of the License, or
+//  any later version.
+//
+//  The GPSTk is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU Lesser General Public License for more details.
+//
+//  You should have received a copy of the GNU Lesser General Public
+//  License along with GPSTk; if not, write to the Free Software Foundation,
+//  Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110, USA
+//
+//============================================================================
+
+#include <vector>
+#include "Matrix.hpp"
+
+namespace gpstk
+{
+   /** @addtogroup GPSsolutions */
+   //@{
+
+   /// The RAIM algorithms of PRSolution and PRSolution2 solve the problem again
+   /// for every combination of rejected satellites. This class takes the partials
+   /// and residuals of the solution with all the satellites and predicts, without
+   /// iterating, the solution and residuals when some of them are rejected: the
+   /// normal equations of the full set are downdated by one rank-one term per
+   /// rejected satellite and solved by Cholesky decomposition. Near the solution
+   /// the problem is very nearly linear, so the predicted RMS residual is
+   /// typically good to a millimeter, which is enough to choose the order in
+   /// which the combinations are solved, and where the search may stop.
+   class PRSubsetSearch
+   {
+   public:
+      /// Empty constructor; predict() will always fail.
+      PRSubsetSearch() throw() : diagonal(true) {}
+
+      /// Constructor.
+      /// @param P  partials matrix (n x dim) of all the satellites at the
+      ///           linearization point
+      /// @param R  residuals (n) of all the satellites at the same point
+      /// @param W  weight matrix = inverse measurement covariance (n x n), or an
+      ///           empty matrix for unit weights
+      PRSubsetSearch(const Matrix<double>& P,
+                     const Vector<double>& R,
+                     const Matrix<double>& W)
+         throw(Exception);
+
+      /// Predict the solution using only the satellites with Use[i] true.
+      /// Unknowns without partials among those satellites (e.g. the clock of a
+      /// system that has been entirely rejected) are left out, and set to zero.
+      /// @param Use    vector of length n; false means reject that satellite
+      /// @param dX     output correction (dim) to the linearization point
+      /// @param Resid  output residuals of the satellites used, in order
+      /// @return false if the subset is too small or (nearly) singular; then
+      ///           there is no prediction.
+      bool predict(const std::vector<bool>& Use,
+                   Vector<double>& dX,
+                   Vector<double>& Resid) const
+         throw();
+
+      /// Return the indexes of the candidates in the order they should be solved:
+      /// those without a prediction (Predicted < 0) first, then by increasing
+      /// Predicted; ties are broken by the index.
+      static std::vector<int> order(const std::vector<double>& Predicted)
+         throw();
+
+   private:
+      /// partials and residuals at the linearization point
+      Matrix<double> Partials;
+      Vector<double> Resids;
+
+      /// weight matrix, if it is not diagonal
+      Matrix<double> Weights;
+
+      /// diagonal of the weight matrix
+      Vector<double> Wts;
+
+      /// true when the weight matrix is diagonal; only then may the normal
+      /// equations be downdated
+      bool diagonal;
+
+      /// normal matrix and right hand side of the full set, when diagonal
+      Matrix<double> Normal;
+      Vector<double> RHS;
+
+   }; // end class PRSubsetSearch
+
+   //@}
+
+} // namespace gpstk
+
+#endif
@@ -0,0 +1,321 @@
+#pragma ident "$Id$"
+
+/**
+ * @file AntennaPattern.cpp
+ * Phase center offsets and variations of one antenna, held in flat arrays.
+ */
+
+//============================================================================
+//
+//  This file is part of GPSTk, the GPS Toolkit.
+//
+//  The GPSTk is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU Lesser General Public License as published
+//  by the Free Software Foundation; either version 2.1 of the License, or
+//  any later version.
+//
+//  The GPSTk is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU Lesser General Public License for more details.
+//
+//  You should have received a copy of the GNU Lesser General Public
+//  License along with GPSTk; if not, write to the Free Software Foundation,
+//  Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110, USA
+//
+//============================================================================
+
+
+#include <cmath>
+#include <algorithm>
+
+#include "AntennaPattern.hpp"
+
+
+
+namespace gpstk
+{
+
+
+      /* Common constructor.
+       *
+       * @param[in] antenna   Antenna whose offsets and patterns are kept.
+       */
+   AntennaPattern::AntennaPattern( const Antenna& antenna )
+      : valid( antenna.isValid() ),
+        validFrom( antenna.getAntennaValidFrom() ),
+        validUntil( antenna.getAntennaValidUntil() ),
+        dazi(0.0), zen1(0.0), zen2(0.0), dzen(0.0)
+   {
+
+      clearIndex();
+
+         // Eccentricities, turned into UEN once and for all
+      Antenna::AntennaEccDataMap eccMap( antenna.getAntennaEccMap() );
+      for( Antenna::AntennaEccDataMap::const_iterator it = eccMap.begin();
+           it != eccMap.end();
+           ++it )
+      {
+         hasEcc[(*it).first] = true;
+         ecc[(*it).first][0] = (*it).second[2];
+         ecc[(*it).first][1] = (*it).second[1];
+         ecc[(*it).first][2] = (*it).second[0];
+      }
+
+         // The grid limits only mean something when there are patterns
+      if( antenna.getNoAziMapSize() == 0 &&
+          antenna.getPCMapSize()    == 0 )
+      {
+         return;
+      }
+
+      dazi = antenna.getDazi();
+      zen1 = antenna.getZen1();
+      zen2 = antenna.getZen2();
+      dzen = antenna.getDzen();
+
+         // Non-azimuth dependent patterns: one row per frequency
+      Antenna::NoAziDataMap noAziMap( antenna.getAntennaNoAziMap() );
+      for( Antenna::NoAziDataMap::const_iterator it = noAziMap.begin();
+           it != noAziMap.end();
+           ++it )
+      {
+         noAziStart[(*it).first] = values.size();
+         values.insert( values.end(), (*it).second.begin(),
+                                      (*it).second.end() );
+      }
+
+         // Azimuth dependent patterns: rows for 0, dazi, 2*dazi, ... degrees
+         // and as many zenith values in each row as in the longest one.
+         // Rows are only taken while their azimuths follow that sequence,
+         // which is what the lookup in Antenna is able to find.
+      if( dazi > 0.0 )
+      {
+
+         Antenna::PCDataMap pcMap( antenna.getAntennaPCMap() );
+         for( Antenna::PCDataMap::const_iterator it = pcMap.begin();
+              it != pcMap.end();
+              ++it )
+         {
+
+            const Antenna::AzimuthDataMap& aziMap( (*it).second );
+
+            int rows(0);
+            size_t length(0);
+            for( Antenna::AzimuthDataMap::const_iterator it2 = aziMap.begin();
+                 it2 != aziMap.end() && (*it2).first == rows*dazi;
+                 ++it2 )
+            {
+               length = std::max( length, (*it2).second.size() );
+               ++rows;
+            }
+
+            if( rows == 0 ) continue;
+
+            aziStart[(*it).first] = values.size();
+            aziRows[(*it).first] = rows;
+            rowLength[(*it).first] = length;
+
+            values.resize( values.size() + rows*length, 0.0 );
+            Antenna::AzimuthDataMap::const_iterator it2( aziMap.begin() );
+            for( int k = 0; k < rows; ++k, ++it2 )
+            {
+               std::copy( (*it2).second.begin(), (*it2).second.end(),
+                          values.begin() + aziStart[(*it).first] + k*length );
+            }
+
+         }  // End of 'for( Antenna::PCDataMap::const_iterator it = ...'
+
+      }  // End of 'if( dazi > 0.0 )'
+
+   }  // End of constructor 'AntennaPattern::AntennaPattern()'
+
+
+
+      // Marks every frequency as having no data.
+   void AntennaPattern::clearIndex()
+   {
+
+      for( int i = 0; i < numFreq; ++i )
+      {
+         hasEcc[i] = false;
+         ecc[i][0] = ecc[i][1] = ecc[i][2] = 0.0;
+         noAziStart[i] = -1;
+         aziStart[i] = -1;
+         aziRows[i] = 0;
+         rowLength[i] = 0;
+      }
+
+   }  // End of method 'AntennaPattern::clearIndex()'
+
+
+
+      /* Get antenna eccentricity as a Triple in UEN system.
+       *
+       * @param[in] freq      Frequency
+       */
+   Triple AntennaPattern::getAntennaEccentricity(
+                                       Antenna::frequencyType freq ) const
+      throw(InvalidRequest)
+   {
+
+      if( !hasEcc[freq] )
+      {
+         InvalidRequest e("No eccentricities were found for this frequency.");
+         GPSTK_THROW(e);
+      }
+
+      return Triple( ecc[freq][0], ecc[freq][1], ecc[freq][2] );
+
+   }  // End of method 'AntennaPattern::getAntennaEccentricity()'
+
+
+
+      /* Get the elevation-dependent antenna phase center variation,
+       * as a Triple in UEN system.
+       *
+       * @param[in] freq      Frequency
+       * @param[in] elevation Elevation (degrees)
+       */
+   Triple AntennaPattern::getAntennaPCVariation( Antenna::frequencyType freq,
+                                                 double elevation ) const
+      throw(InvalidRequest)
+   {
+
+         // The angle should be measured respect to zenith
+      const double angle( 90.0 - elevation );
+
+         // Check that angle is within limits
+      if( ( angle < zen1 ) ||
+          ( angle > zen2 ) )
+      {
+         InvalidRequest e("Elevation is out of allowed range.");
+         GPSTK_THROW(e);
+      }
+
+      if( noAziStart[freq] < 0 )
+      {
+         InvalidRequest e("No data was found for this frequency.");
+         GPSTK_THROW(e);
+      }
+
+         // Only the "Up" component is important
+      return Triple( linearInterpol( &values[noAziStart[freq]],
+                                     (angle-zen1)/dzen ),
+                     0.0,
+                     0.0 );
+
+   }  // End of method 'AntennaPattern::getAntennaPCVariation()'
+
+
+
+      /* Get the elevation and azimuth-dependent antenna phase center
+       * variation, as a Triple in UEN system.
+       *
+       * @param[in] freq      Frequency
+       * @param[in] elevation Elevation (degrees)
+       * @param[in] azimuth   Azimuth (degrees)
+       */
+   Triple AntennaPattern::getAntennaPCVariation( Antenna::frequencyType freq,
+                                                 double elevation,
+                                                 double azimuth ) const
+      throw(InvalidRequest)
+   {
+
+         // The angle should be measured respect to zenith
+      const double angle( 90.0 - elevation );
+
+         // Check that angle is within limits
+      if( ( angle < zen1 ) ||
+          ( angle > zen2 ) )
+      {
+         InvalidRequest e("Elevation is out of allowed range.");
+         GPSTK_THROW(e);
+      }
+
+         // Reduce azimuth to 0 <= azimuth < 360 interval
+      while( azimuth < 0.0 )
+      {
+         azimuth += 360.0;
+      }
+      while( azimuth >= 360.0 )
+      {
+         azimuth -= 360.0;
+      }
+
+      if( aziStart[freq] < 0 )
+      {
+         InvalidRequest e("No data was found for this frequency.");
+         GPSTK_THROW(e);
+      }
+
+         // Get the right azimuth interval, and the rows holding it
+      const double lower( std::floor(azimuth/dazi) );
+      const double lowerAzimuth( lower * dazi );
+      const double upperAzimuth( lowerAzimuth + dazi );
+      const int row( static_cast<int>(lower) );
+
+      const double fractionalAzimuth( ( azimuth - lowerAzimuth ) /
+                                      ( upperAzimuth - lowerAzimuth ) );
+
+      const double normalizedAngle( (angle-zen1)/dzen );
+      const double* grid( &values[aziStart[freq]] );
+
+         // Check if 'azimuth' exactly corresponds to a row
+      if( fractionalAzimuth == 0.0 )
+      {
+         if( row >= aziRows[freq] )
+         {
+            InvalidRequest e("No data was found for this azimuth.");
+            GPSTK_THROW(e);
+         }
+
+         return Triple( linearInterpol( grid + row*rowLength[freq],
+                                        normalizedAngle ),
+                        0.0,
+                        0.0 );
+      }
+
+      if( row+1 >= aziRows[freq] )
+      {
+         InvalidRequest e("Not enough data was found for this azimuth.");
+         GPSTK_THROW(e);
+      }
+
+         // Interpolate in zenith within both rows, then in azimuth
+      const double val1( linearInterpol( grid + row*rowLength[freq],
+                                         normalizedAngle ) );
+      const double val2( linearInterpol( grid + (row+1)*rowLength[freq],
+                                         normalizedAngle ) );
+
+      return Triple( ( val1 + (val2-val1) * fractionalAzimuth ), 0.0, 0.0 );
+
+   }  // End of method 'AntennaPattern::getAntennaPCVariation()'
+
+
+
+      /* Linear interpolation as function of normalized angle, as
+       * Antenna::linearInterpol() does.
+       *
+       * @param[in] row                Pointer to the first value of a row.
+       * @param[in] normalizedAngle    Normalized angle.
+       */
+   double AntennaPattern::linearInterpol( const double* row,
+                                          double normalizedAngle )
+   {
+
+      const int index( static_cast<int>( std::floor(normalizedAngle) ) );
+      const double fraction( normalizedAngle - std::floor(normalizedAngle) );
+
+      if( fraction == 0.0 )
+      {
+         return row[index];
+      }
+
+      return ( row[index] + (row[index+1]-row[index]) * fraction );
+
+   }  // End of method 'AntennaPattern::linearInterpol()'
+
+
+
+}  // End of namespace gpstk
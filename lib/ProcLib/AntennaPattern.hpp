@@ -0,0 +1,221 @@
+#pragma ident "$Id$"
+
+/**
+ * @file AntennaPattern.hpp
+ * Phase center offsets and variations of one antenna, held in flat arrays.
+ */
+
+#ifndef GPSTK_ANTENNAPATTERN_HPP
+#define GPSTK_ANTENNAPATTERN_HPP
+
+//============================================================================
+//
+//  This file is part of GPSTk, the GPS Toolkit.
+//
+//  The GPSTk is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU Lesser General Public License as published
+//  by the Free Software Foundation; either version 2.1 of the License, or
+//  any later version.
+//
+//  The GPSTk is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU Lesser General Public License for more details.
+//
+//  You should have received a copy of the GNU Lesser General Public
+//  License along with GPSTk; if not, write to the Free Software Foundation,
+//  Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110, USA
+//
+//============================================================================
+
+
+#include <vector>
+
+#include "Exception.hpp"
+#include "CommonTime.hpp"
+#include "Triple.hpp"
+#include "Antenna.hpp"
+
+
+
+namespace gpstk
+{
+
+      /** @addtogroup DataStructures */
+      //@{
+
+
+      /** This class holds the phase center offsets and variations of one
+       *  Antenna, resolved once so that they may be looked up on every
+       *  epoch without searching maps or copying the Antenna.
+       *
+       * Offsets are kept per frequency in UEN, and the patterns of all
+       * frequencies share one contiguous array: the non-azimuth dependent
+       * pattern is one row of zenith values, and the azimuth dependent
+       * pattern is a grid of rows, one per azimuth step from 0 to 360
+       * degrees. The lookup methods return exactly what the methods of the
+       * same name in Antenna return, and throw in the same cases.
+       *
+       * A typical way to use this class follows:
+       *
+       * @code
+       *   AntexReader antexread;
+       *   antexread.open("igs05.atx");
+       *
+       *   AntennaPattern satG07( antexread.getAntenna( "G07", epoch ) );
+       *
+       *   while( ... )
+       *   {
+       *      if( !satG07.isValidAt(time) )
+       *      {
+       *         satG07 = AntennaPattern( antexread.getAntenna("G07", time) );
+       *      }
+       *
+       *      Triple pco( satG07.getAntennaEccentricity( Antenna::G01 ) );
+       *      Triple pcv( satG07.getAntennaPCVariation( Antenna::G01, elev ) );
+       *   }
+       * @endcode
+       *
+       * @sa Antenna.hpp, AntexReader.hpp
+       */
+   class AntennaPattern
+   {
+   public:
+
+         /// Default constructor. The object is not valid at any epoch.
+      AntennaPattern()
+         : valid(false), validFrom(CommonTime::END_OF_TIME),
+           validUntil(CommonTime::BEGINNING_OF_TIME),
+           dazi(0.0), zen1(0.0), zen2(0.0), dzen(0.0)
+      { clearIndex(); };
+
+
+         /** Common constructor.
+          *
+          * @param[in] antenna   Antenna whose offsets and patterns are kept.
+          */
+      explicit AntennaPattern( const Antenna& antenna );
+
+
+         /// Returns if this object is valid, as Antenna::isValid() does.
+      bool isValid() const
+      { return valid; };
+
+
+         /// Returns if 'epoch' is within the validity period of the antenna.
+      bool isValidAt( const CommonTime& epoch ) const
+      { return ( epoch >= validFrom && epoch <= validUntil ); };
+
+
+         /// Get start of antenna validity period.
+      CommonTime getAntennaValidFrom() const
+      { return validFrom; };
+
+
+         /// Get end of antenna validity period.
+      CommonTime getAntennaValidUntil() const
+      { return validUntil; };
+
+
+         /** Get antenna eccentricity as a Triple in UEN system.
+          *
+          * @param[in] freq      Frequency
+          */
+      Triple getAntennaEccentricity( Antenna::frequencyType freq ) const
+         throw(InvalidRequest);
+
+
+         /** Get the elevation-dependent antenna phase center variation,
+          *  as a Triple in UEN system.
+          *
+          * @param[in] freq      Frequency
+          * @param[in] elevation Elevation (degrees)
+          */
+      Triple getAntennaPCVariation( Antenna::frequencyType freq,
+                                    double elevation ) const
+         throw(InvalidRequest);
+
+
+         /** Get the elevation and azimuth-dependent antenna phase center
+          *  variation, as a Triple in UEN system. Values are interpolated
+          *  bilinearly in zenith angle and azimuth.
+          *
+          * @param[in] freq      Frequency
+          * @param[in] elevation Elevation (degrees)
+          * @param[in] azimuth   Azimuth (degrees)
+          */
+      Triple getAntennaPCVariation( Antenna::frequencyType freq,
+                                    double elevation,
+                                    double azimuth ) const
+         throw(InvalidRequest);
+
+
+         /// Destructor
+      virtual ~AntennaPattern() {};
+
+
+   private:
+
+
+         /// Number of values of Antenna::frequencyType
+      static const int numFreq = Antenna::J06 + 1;
+
+
+         /// Whether the antenna was valid
+      bool valid;
+
+      CommonTime validFrom;            ///< Start of validity period
+      CommonTime validUntil;           ///< End of validity period
+
+      double dazi;                     ///< Increment of the azimuth
+      double zen1;                     ///< Initial zenith grid value
+      double zen2;                     ///< Final zenith grid value
+      double dzen;                     ///< Increment of the zenith
+
+
+         /// Whether there is an eccentricity for each frequency
+      bool hasEcc[numFreq];
+
+         /// Eccentricities for each frequency, in METERS, UEN
+      double ecc[numFreq][3];
+
+         /// Start of the non-azimuth dependent pattern of each frequency
+         /// in 'values', or -1
+      int noAziStart[numFreq];
+
+         /// Start of the azimuth dependent grid of each frequency in
+         /// 'values', or -1
+      int aziStart[numFreq];
+
+         /// Number of azimuth rows in the grid of each frequency
+      int aziRows[numFreq];
+
+         /// Number of zenith values in each row of each frequency
+      int rowLength[numFreq];
+
+         /// The patterns of all frequencies, in METERS
+      std::vector<double> values;
+
+
+         /// Marks every frequency as having no data.
+      void clearIndex();
+
+
+         /** Linear interpolation as function of normalized angle, as
+          *  Antenna::linearInterpol() does.
+          *
+          * @param[in] row                Pointer to the first value of a row.
+          * @param[in] normalizedAngle    Normalized angle.
+          */
+      static double linearInterpol( const double* row,
+                                    double normalizedAngle );
+
+
+   }; // End of class 'AntennaPattern'
+
+
+      //@}
+
+}  // End of namespace gpstk
+
+#endif   // GPSTK_ANTENNAPATTERN_HPP
@@ -28,6 +28,8 @@
 //============================================================================
 
 
+#include <map>
+#include <set>
 #include "ComputeLinear.hpp"
 
 using namespace std;
@@ -54,57 +56,35 @@ namespace gpstk
       try
       {
 
+            // Compile the lists if they changed
+         if( !compiled )
+         {
+            kernel[0].compile(linearList);
+            kernel[1].compile(GlonassLinearList);
+            kernel[2].compile(GalileoLinearList);
+            kernel[3].compile(BeiDouLinearList);
+            compiled = true;
+         }
+
             // Loop through all the satellites
          satTypeValueMap::iterator it;
-            // a copy of GPS linearList for the first time
-         LinearCombList GPSLinearList = linearList;
-
          for( it = gData.begin(); it != gData.end(); ++it )
          {
+            int k(0);
             if ((*it).first.system == SatID::systemGlonass)
             {
-               setLinearCombination(GlonassLinearList); 
+               k = 1;
             }
             else if ((*it).first.system == SatID::systemGalileo)
             {
-               setLinearCombination(GalileoLinearList); 
+               k = 2;
             }
             else if ((*it).first.system == SatID::systemBeiDou)
             {
-               setLinearCombination(BeiDouLinearList);  
+               k = 3;
             }
 
-               // Loop through all the defined linear combinations
-            LinearCombList::const_iterator pos;
-
-            for( pos = linearList.begin(); pos != linearList.end(); ++pos )
-            {
-
-               double result(0.0);
-
-                  // Read the information of each linear combination
-               typeValueMap::const_iterator iter;
-               for(iter = pos->body.begin(); iter != pos->body.end(); ++iter)
-               {
-                  double temp(0.0);
-
-                  TypeID type(iter->first);
-                  if( (*it).second.find(type) != (*it).second.end() )
-                  {
-                     temp = (*it).second[type];
-                  }
-                  else
-                  {
-                     temp = 0.0;
-                  }
-                  result = result + (*iter).second * temp;
-               }
-
-                  // Store the result in the proper place
-               (*it).second[pos->header] = result;
-            }
-                   // set default linearlist to GPS
-               setLinearCombination(GPSLinearList);
+            kernel[k].apply( (*it).second, values );
          }
 
          return gData;
@@ -122,4 +102,141 @@ namespace gpstk
    }  // End of method 'ComputeLinear::Process()'
 
 
+
+      /* Builds the kernel of a list of combinations.
+       *
+       * @param list      List of linear combinations.
+       */
+   void ComputeLinear::LinearKernel::compile(const LinearCombList& list)
+   {
+
+         // Index of every type, read or written
+      std::map<TypeID, int> index;
+
+      LinearCombList::const_iterator pos;
+      for( pos = list.begin(); pos != list.end(); ++pos )
+      {
+         index[pos->header] = 0;
+
+         typeValueMap::const_iterator iter;
+         for(iter = pos->body.begin(); iter != pos->body.end(); ++iter)
+         {
+            index[iter->first] = 0;
+         }
+      }
+
+      types.clear();
+      for( std::map<TypeID, int>::iterator itIdx = index.begin();
+           itIdx != index.end();
+           ++itIdx )
+      {
+         itIdx->second = types.size();
+         types.push_back(itIdx->first);
+      }
+
+         // One row of coefficients per combination
+      const size_t n( types.size() );
+      output.clear();
+      coef.assign( list.size()*n, 0.0 );
+
+      size_t row(0);
+      for( pos = list.begin(); pos != list.end(); ++pos, ++row )
+      {
+         output.push_back( index[pos->header] );
+
+         typeValueMap::const_iterator iter;
+         for(iter = pos->body.begin(); iter != pos->body.end(); ++iter)
+         {
+            coef[row*n + index[iter->first]] = iter->second;
+         }
+      }
+
+      std::set<int> results( output.begin(), output.end() );
+      written.assign( results.begin(), results.end() );
+
+   }  // End of method 'ComputeLinear::LinearKernel::compile()'
+
+
+
+      /* Computes the combinations for one satellite.
+       *
+       * @param tvMap     Data of the satellite.
+       * @param values    Work vector.
+       */
+   void ComputeLinear::LinearKernel::apply( typeValueMap& tvMap,
+                                            std::vector<double>& values ) const
+   {
+
+      const size_t n( types.size() );
+      if( n == 0 )
+      {
+         return;
+      }
+
+         // Load the values, walking along both sorted sequences. The
+         // data the satellite doesn't have are taken as zero.
+      values.assign(n, 0.0);
+
+      typeValueMap::iterator it( tvMap.begin() );
+      size_t j(0);
+      while( j < n && it != tvMap.end() )
+      {
+         if( (*it).first < types[j] )
+         {
+            ++it;
+         }
+         else if( types[j] < (*it).first )
+         {
+            ++j;
+         }
+         else
+         {
+            values[j] = (*it).second;
+            ++j;
+            ++it;
+         }
+      }
+
+         // Apply the combinations in order. The terms are added in the
+         // order of the types, as when reading the combinations.
+      const double* row( &coef[0] );
+      for( size_t k = 0; k < output.size(); ++k, row += n )
+      {
+         double result(0.0);
+         for( j = 0; j < n; ++j )
+         {
+            if( row[j] != 0.0 )
+            {
+               result = result + row[j] * values[j];
+            }
+         }
+
+         values[ output[k] ] = result;
+      }
+
+         // Store the results in the proper place, again in order
+      it = tvMap.begin();
+      for( size_t w = 0; w < written.size(); ++w )
+      {
+         const TypeID& type( types[ written[w] ] );
+
+         while( it != tvMap.end() && (*it).first < type )
+         {
+            ++it;
+         }
+
+         if( it != tvMap.end() && !(type < (*it).first) )
+         {
+            (*it).second = values[ written[w] ];
+         }
+         else
+         {
+            it = tvMap.insert( it,
+                               std::make_pair( type, values[ written[w] ] ) );
+         }
+      }
+
+   }  // End of method 'ComputeLinear::LinearKernel::apply()'
+
+
 } // End of namespace gpstk
@@ -32,6 +32,7 @@
 
 
 
+#include <vector>
 #include "ProcessingClass.hpp"
 
 
@@ -134,6 +135,7 @@ namespace gpstk
 
          /// Default constructor
       ComputeLinear()
+         : compiled(false)
       { clearAll(); };
 
 
@@ -142,6 +144,7 @@ namespace gpstk
           * @param linearComb   Linear combination to be computed.
           */
       ComputeLinear( const gnssLinearCombination& linearComb )
+         : compiled(false)
       { linearList.push_back(linearComb); };
 
 
@@ -150,7 +153,7 @@ namespace gpstk
           * @param list    List of linear combination definitions to compute.
           */
       ComputeLinear(const LinearCombList& list)
-         : linearList(list)
+         : linearList(list), compiled(false)
       { };
 
 
@@ -192,7 +195,7 @@ namespace gpstk
 
          /// Clear all linear combinations.
       virtual ComputeLinear& clearAll(void)
-      { linearList.clear(); return (*this); };
+      { linearList.clear(); compiled = false; return (*this); };
 
 
          /** Sets a linear combinations to be computed.
@@ -213,7 +216,7 @@ namespace gpstk
           * @warning All previous linear combinations will be deleted.
           */
       virtual ComputeLinear& setLinearCombination(const LinearCombList& list)
-      { clearAll(); linearList = list; return (*this); };
+      { clearAll(); linearList = list; compiled = false; return (*this); };
 
 
          /** Add a linear combination to be computed.
@@ -221,16 +224,16 @@ namespace gpstk
           * @param linear    Linear combination definitions to be added.
           */
       virtual ComputeLinear& addLinear(const gnssLinearCombination& linear)
-      { linearList.push_back(linear); return (*this); };
+      { linearList.push_back(linear); compiled = false; return (*this); };
 
       virtual ComputeLinear& addGlonassLinear(const gnssLinearCombination& linear)
-      { GlonassLinearList.push_back(linear); return (*this); };
+      { GlonassLinearList.push_back(linear); compiled = false; return (*this); };
 
       virtual ComputeLinear& addGalileoLinear(const gnssLinearCombination& linear)
-      { GalileoLinearList.push_back(linear); return (*this); };
+      { GalileoLinearList.push_back(linear); compiled = false; return (*this); };
 
       virtual ComputeLinear& addBeiDouLinear(const gnssLinearCombination& linear)
-      { BeiDouLinearList.push_back(linear); return (*this); };
+      { BeiDouLinearList.push_back(linear); compiled = false; return (*this); };
 
 
          /// Returns a string identifying this object.
@@ -253,6 +256,49 @@ namespace gpstk
          /// for BeiDou
       LinearCombList BeiDouLinearList;
 
+
+         /** A list of linear combinations, compiled into a matrix of
+          *  coefficients over a fixed index of the types involved.
+          *
+          * Each row of 'coef' is a combination and each column a type of
+          * 'types', which are sorted as in a typeValueMap. The values of a
+          * satellite are loaded into a vector over the same index, and each
+          * row is applied in turn, so a combination may use the result of
+          * a former one, as in the lists.
+          */
+      struct LinearKernel
+      {
+            /// Builds the kernel of a list of combinations.
+         void compile(const LinearCombList& list);
+
+            /// Computes the combinations for one satellite.
+         void apply(typeValueMap& tvMap, std::vector<double>& values) const;
+
+            /// Types read or written, in typeValueMap order
+         std::vector<TypeID> types;
+
+            /// Index in 'types' of the result of each combination
+         std::vector<int> output;
+
+            /// Index in 'types' of every result, sorted and unique
+         std::vector<int> written;
+
+            /// Coefficients, one row of types.size() per combination
+         std::vector<double> coef;
+      };
+
+
+         /// Kernels of the GPS (and other), Glonass, Galileo and BeiDou
+         /// lists
+      LinearKernel kernel[4];
+
+         /// Whether the kernels are up to date with the lists
+      bool compiled;
+
+         /// Values of one satellite over the index of a kernel
+      std::vector<double> values;
+
+
    }; // End class ComputeLinear
 
       //@}
@@ -165,6 +165,51 @@ namespace gpstk
 
 
 
+      /* Returns the antenna of a satellite at a given epoch, looking it
+       * up in the AntexReader object only if it is not kept yet.
+       *
+       * @param satid     Satellite ID
+       * @param time      Epoch of interest
+       */
+   const AntennaPattern& ComputeSatPCenter::getSatAntenna(
+                                                   const SatID& satid,
+                                                   const CommonTime& time )
+   {
+
+      AntennaPattern& antenna( satAntennas[satid] );
+
+      if( !antenna.isValidAt(time) )
+      {
+
+            // Antex name of the satellite: system letter and at least two
+            // digits
+         std::stringstream sat;
+         switch( satid.system )
+         {
+            case SatID::systemGPS:     sat << "G"; break;
+            case SatID::systemGlonass: sat << "R"; break;
+            case SatID::systemGalileo: sat << "E"; break;
+            case SatID::systemBeiDou:  sat << "C"; break;
+            case SatID::systemQZSS:    sat << "J"; break;
+            default:                   sat << "?"; break;
+         }
+         if( satid.id < 10 )
+         {
+            sat << "0";
+         }
+         sat << satid.id;
+
+         antenna = AntennaPattern( pAntexReader->getAntenna( sat.str(),
+                                                             time ) );
+
+      }
+
+      return antenna;
+
+   }  // End of method 'ComputeSatPCenter::getSatAntenna()'
+
+
+
       /* Compute the value of satellite antenna phase correction, in meters.
        * @param satid     Satellite ID
        * @param time      Epoch of interest
@@ -232,167 +277,37 @@ namespace gpstk
 
          double elev( 90.0 - nadir );
 
-            // Get satellite information in Antex format. Currently this
-            // only works for GPS and Glonass.
-         if( satid.system == SatID::systemGPS )
+            // Frequency whose phase center is used for each system. Other
+            // systems get no correction.
+         Antenna::frequencyType freq;
+         switch( satid.system )
          {
-            std::stringstream sat;
-            sat << "G";
-            if( satid.id < 10 )
-            {
-               sat << "0";
-            }
-            sat << satid.id;
-               // Get satellite antenna information out of AntexReader object
-            Antenna antenna( pAntexReader->getAntenna( sat.str(), time ) );
-
-               // Get antenna eccentricity for frequency "G01" (L1), in
-               // satellite reference system.
-               // NOTE: It is NOT in ECEF, it is in UEN!!!
-            Triple satAnt( antenna.getAntennaEccentricity( Antenna::G01) );
-
-               // Now, get the phase center variation.
-            Triple var( antenna.getAntennaPCVariation( Antenna::G01, elev) );
-
-               // We must substract them
-            satAnt = satAnt - var;
-
-                  // Change to ECEF
-            Triple svAntenna( satAnt[2]*ri + satAnt[1]*rj + satAnt[0]*rk );
-
-               // Projection of "svAntenna" vector to line of sight vector rrho
-            svPCcorr =  (rrho.dot(svAntenna));
-
+            case SatID::systemGPS:     freq = Antenna::G01; break;
+            case SatID::systemGlonass: freq = Antenna::R01; break;
+            case SatID::systemGalileo: freq = Antenna::E01; break;
+            case SatID::systemBeiDou:  freq = Antenna::C01; break;
+            case SatID::systemQZSS:    freq = Antenna::J01; break;
+            default:                   return 0.0;
          }
-         else
-         {
-               // Check if this satellite belongs to Glonass system
-            if( satid.system == SatID::systemGlonass )
-            {
-               std::stringstream sat;
-               sat << "R";
-               if( satid.id < 10 )
-               {
-                  sat << "0";
-               }
-               sat << satid.id;
-
-                  // Get satellite antenna information out of AntexReader object
-               Antenna antenna( pAntexReader->getAntenna( sat.str(), time ) );
-
-                  // Get antenna offset for frequency "R01" (Glonass), in
-                  // satellite reference system.
-                  // NOTE: It is NOT in ECEF, it is in UEN!!!
-               Triple satAnt( antenna.getAntennaEccentricity( Antenna::R01) );
-                  // Now, get the phase center variation.
-               Triple var( antenna.getAntennaPCVariation( Antenna::R01, elev) );
-
-                  // We must substract them
-               satAnt = satAnt - var;
-
-                     // Change to ECEF
-               Triple svAntenna( satAnt[2]*ri + satAnt[1]*rj + satAnt[0]*rk );
-
-                  // Project "svAntenna" vector to line of sight vector rrho
-               svPCcorr = (rrho.dot(svAntenna));
-
-            }
-               // Check if this satellite belongs to Galileo system
-            else if( satid.system == SatID::systemGalileo )
-            {
-               std::stringstream sat;
-               sat << "E";
-               if( satid.id < 10 )
-               {
-                  sat << "0";
-               }
-               sat << satid.id;
-
-                  // Get satellite antenna information out of AntexReader object
-               Antenna antenna( pAntexReader->getAntenna( sat.str(), time ) );
-
-                  // Get antenna offset for frequency "E01" (Galileo), in
-                  // satellite reference system.
-                  // NOTE: It is NOT in ECEF, it is in UEN!!!
-               Triple satAnt( antenna.getAntennaEccentricity( Antenna::E01) );
-                  // Now, get the phase center variation.
-               Triple var( antenna.getAntennaPCVariation( Antenna::E01, elev) );
-
-                  // We must substract them
-               satAnt = satAnt - var;
-
-                     // Change to ECEF
-               Triple svAntenna( satAnt[2]*ri + satAnt[1]*rj + satAnt[0]*rk );
-
-                  // Project "svAntenna" vector to line of sight vector rrho
-               svPCcorr = (rrho.dot(svAntenna));
-
-            }
-               // Check if this satellite belongs to BeiDou system
-            else if( satid.system == SatID::systemBeiDou )
-            {
-               std::stringstream sat;
-               sat << "C";
-               if( satid.id < 10 )
-               {
-                  sat << "0";
-               }
-               sat << satid.id;
-
-                  // Get satellite antenna information out of AntexReader object
-               Antenna antenna( pAntexReader->getAntenna( sat.str(), time ) );
-                  //get PCO, NOTE: It is NOT in ECEF, it is in UEN!!!
-               Triple satAnt( antenna.getAntennaEccentricity( Antenna::C01) );
-                  // Now, get the phase center variation.
-               Triple var( antenna.getAntennaPCVariation( Antenna::C01, elev) );
-                  // We must substract them
-               satAnt = satAnt - var;
 
-                     // Change to ECEF
-               Triple svAntenna( satAnt[2]*ri + satAnt[1]*rj + satAnt[0]*rk );
+            // Get satellite antenna information out of AntexReader object
+         const AntennaPattern& antenna( getSatAntenna( satid, time ) );
 
-                  // Project "svAntenna" vector to line of sight vector rrho
-               svPCcorr = (rrho.dot(svAntenna));
+            // Get antenna eccentricity in satellite reference system.
+            // NOTE: It is NOT in ECEF, it is in UEN!!!
+         Triple satAnt( antenna.getAntennaEccentricity( freq ) );
 
-            }
-               // Check if this satellite belongs to QZSS system
-            else if( satid.system == SatID::systemQZSS )
-            {
-               std::stringstream sat;
-               sat << "J";
-               if( satid.id < 10 )
-               {
-                  sat << "0";
-               }
-               sat << satid.id;
+            // Now, get the phase center variation.
+         Triple var( antenna.getAntennaPCVariation( freq, elev ) );
 
-                  // Get satellite antenna information out of AntexReader object
-               Antenna antenna( pAntexReader->getAntenna( sat.str(), time ) );
+            // We must substract them
+         satAnt = satAnt - var;
 
-                  // Get antenna offset for frequency "J01" (QZSS), in
-                  // satellite reference system.
-                  // NOTE: It is NOT in ECEF, it is in UEN!!!
-               Triple satAnt( antenna.getAntennaEccentricity( Antenna::J01) );
-                  // Now, get the phase center variation.
-               Triple var( antenna.getAntennaPCVariation( Antenna::J01, elev) );
-
-                  // We must substract them
-               satAnt = satAnt - var;
-
-                     // Change to ECEF
-               Triple svAntenna( satAnt[2]*ri + satAnt[1]*rj + satAnt[0]*rk );
-
-                  // Project "svAntenna" vector to line of sight vector rrho
-               svPCcorr = (rrho.dot(svAntenna));
-
-            }
-            else
-            {
-                  // In this case no correction will be computed
-               svPCcorr = 0.0;
-            }
+               // Change to ECEF
+         Triple svAntenna( satAnt[2]*ri + satAnt[1]*rj + satAnt[0]*rk );
 
-         }  // End of 'if( satid.system == SatID::systemGPS )...'
+            // Projection of "svAntenna" vector to line of sight vector rrho
+         svPCcorr =  (rrho.dot(svAntenna));
 
       }
       else
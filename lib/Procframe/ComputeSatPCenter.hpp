@@ -34,6 +34,7 @@
 
 #include <cmath>
 #include <string>
+#include <map>
 #include <sstream>
 #include "ProcessingClass.hpp"
 #include "Triple.hpp"
@@ -42,6 +43,7 @@
 #include "XvtStore.hpp"
 #include "SatDataReader.hpp"
 #include "AntexReader.hpp"
+#include "AntennaPattern.hpp"
 #include "geometry.hpp"
 #include "StringUtils.hpp"
 
@@ -253,7 +255,7 @@ namespace gpstk
           *                  antenna data.
           */
       virtual ComputeSatPCenter& setAntexReader(AntexReader& antexObj)
-      { pAntexReader = &antexObj; return (*this); };
+      { pAntexReader = &antexObj; satAntennas.clear(); return (*this); };
 
 
          /// Returns a string identifying this object.
@@ -287,6 +289,22 @@ namespace gpstk
       AntexReader* pAntexReader;
 
 
+         /// Antenna of each satellite, kept while the epoch stays within
+         /// its validity period so that Antex data is looked up only when
+         /// a satellite changes antenna.
+      std::map<SatID, AntennaPattern> satAntennas;
+
+
+         /** Returns the antenna of a satellite at a given epoch, looking it
+          *  up in the AntexReader object only if it is not kept yet.
+          *
+          * @param satid     Satellite ID
+          * @param time      Epoch of interest
+          */
+      const AntennaPattern& getSatAntenna( const SatID& satid,
+                                           const CommonTime& time );
+
+
          /** Compute the value of satellite antenna phase correction, in meters
           * @param satid     Satellite ID
           * @param time      Epoch of interest
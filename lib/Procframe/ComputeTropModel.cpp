@@ -58,70 +58,92 @@ namespace gpstk
 
          SatIDSet satRejectedSet;
 
-            // Loop through all the satellites
-         satTypeValueMap::iterator stv;
-         for(stv = gData.begin(); stv != gData.end(); ++stv) 
+            // First check if TropModel was set
+         if(pTropModel==NULL)
          {
+               // If TropModel is missing, then remove all satellites
+            gData.clear();
+            return gData;
+         }
 
-            // First check if TropModel was set
-            if(pTropModel==NULL)
-            {
-                  // If TropModel is missing, then remove all satellites
-               satRejectedSet.insert( (*stv).first );
-               continue;
-            }
+            // Elevations of the satellites that have one, in gData order
+         std::vector<double> elevation;
 
+         satTypeValueMap::iterator stv;
+         for(stv = gData.begin(); stv != gData.end(); ++stv)
+         {
                // If satellite elevation is missing, remove satellite
             if( (*stv).second.find(TypeID::elevation) == (*stv).second.end() )
             {
                satRejectedSet.insert( (*stv).first );
                continue;
             }
+
+            elevation.push_back( (*stv).second(TypeID::elevation) );
+         }
+
+            // Zenith delays and mapping functions are computed once for the
+            // epoch; the models prepare their station dependent coefficients
+            // when the receiver position and time are set
+         double dryZDelay(0.0), wetZDelay(0.0);
+         std::vector<double> dryMap, wetMap;
+         bool modelOK(true);
+
+         try
+         {
+               // As correction(), reject everything if the model is invalid
+            if( !(pTropModel->isValid()) )
+            {
+               modelOK = false;
+            }
             else
             {
+               dryZDelay = pTropModel->dry_zenith_delay();
+               wetZDelay = pTropModel->wet_zenith_delay();
+               pTropModel->mapping_functions(elevation, dryMap, wetMap);
+            }
+         }
+         catch(TropModel::InvalidTropModel& e)
+         {
+               // If some problem appears, then remove all satellites
+            modelOK = false;
+         }
 
-                  // Scalar to hold satellite elevation
-               double elevation( (*stv).second(TypeID::elevation) );
-               double tropoCorr(0.0), dryZDelay(0.0), wetZDelay(0.0);
-               double dryMap(0.0), wetMap(0.0);
-
-               try
-               {
-                     // Compute tropospheric slant correction
-                  tropoCorr = pTropModel->correction(elevation);
-                  dryZDelay = pTropModel->dry_zenith_delay();
-                  wetZDelay = pTropModel->wet_zenith_delay();
-                  dryMap = pTropModel->dry_mapping_function(elevation);
-                  wetMap = pTropModel->wet_mapping_function(elevation);
-
-                     // Check validity
-                  if( !(pTropModel->isValid()) )
-                  {
-                     tropoCorr = 0.0;
-                     dryZDelay = 0.0;
-                     wetZDelay = 0.0;
-                     dryMap    = 0.0;
-                     wetMap    = 0.0;
-                  }
-
-               }
-               catch(TropModel::InvalidTropModel& e)
-               {
-                     // If some problem appears, then schedule this
-                     // satellite for removal
-                  satRejectedSet.insert( (*stv).first );
-                  continue;    // Skip this SV if problems arise
-               };
-
-                  // Now we have to add the new values to the data structure
-               (*stv).second[TypeID::tropoSlant] = tropoCorr;
-               (*stv).second[TypeID::dryTropo] = dryZDelay;
-               (*stv).second[TypeID::wetTropo] = wetZDelay;
-               (*stv).second[TypeID::dryMap] = dryMap;
-               (*stv).second[TypeID::wetMap] = wetMap;
+            // Loop through all the satellites
+         size_t i(0);
+         for(stv = gData.begin(); stv != gData.end(); ++stv) 
+         {
 
+            if( satRejectedSet.find( (*stv).first ) != satRejectedSet.end() )
+            {
+               continue;
             }
 
+            size_t k(i++);
+
+            if(!modelOK)
+            {
+               satRejectedSet.insert( (*stv).first );
+               continue;
+            }
+
+               // Tropospheric slant correction, as correction() computes it:
+               // the mapping functions are already zero below the cutoff
+               // of the models that have one, and there is no correction
+               // for negative elevations
+            double tropoCorr(0.0);
+            if( elevation[k] >= 0.0 )
+            {
+               tropoCorr = dryZDelay*dryMap[k] + wetZDelay*wetMap[k];
+            }
+
+               // Now we have to add the new values to the data structure
+            (*stv).second[TypeID::tropoSlant] = tropoCorr;
+            (*stv).second[TypeID::dryTropo] = dryZDelay;
+            (*stv).second[TypeID::wetTropo] = wetZDelay;
+            (*stv).second[TypeID::dryMap] = dryMap[k];
+            (*stv).second[TypeID::wetMap] = wetMap[k];
+
          }  // End of loop 'for(stv = gData.begin()...'
 
             // Remove satellites with missing data
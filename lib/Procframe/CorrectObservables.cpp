@@ -86,20 +86,20 @@ namespace gpstk
          {
 
             // Check if we have a valid Antenna object
-           if( antenna.isValid() )
+           if( pattern.isValid() )
            {
 
                // Compute phase center offsets
             if ((*it).first.system == SatID::systemGPS)
             {
-                L1PhaseCenter = antenna.getAntennaEccentricity( Antenna::G01 );
-                L2PhaseCenter = antenna.getAntennaEccentricity( Antenna::G02 );
+                L1PhaseCenter = pattern.getAntennaEccentricity( Antenna::G01 );
+                L2PhaseCenter = pattern.getAntennaEccentricity( Antenna::G02 );
             }
                // for Glonass
             else if ((*it).first.system == SatID::systemGlonass)
             {
-                L1PhaseCenter = antenna.getAntennaEccentricity( Antenna::R01 );
-                L2PhaseCenter = antenna.getAntennaEccentricity( Antenna::R02 );
+                L1PhaseCenter = pattern.getAntennaEccentricity( Antenna::R01 );
+                L2PhaseCenter = pattern.getAntennaEccentricity( Antenna::R02 );
             }
               // warning : The PCO and PCV of antenna for Galileo and BeiDou are not avaliable now
           }
@@ -167,7 +167,7 @@ namespace gpstk
 
   
                // Check if we have a valid Antenna object
-            if( antenna.isValid() )
+            if( pattern.isValid() )
             {
 
                   // Check if we have elevation information
@@ -188,14 +188,14 @@ namespace gpstk
                            // Compute phase center variation values
                         if ((*it).first.system == SatID::systemGPS)
                         {
-                           L1Var = antenna.getAntennaPCVariation( Antenna::G01,elev );
-                           L2Var = antenna.getAntennaPCVariation( Antenna::G02,elev );
+                           L1Var = pattern.getAntennaPCVariation( Antenna::G01,elev );
+                           L2Var = pattern.getAntennaPCVariation( Antenna::G02,elev );
                         }
                            // for Glonass
                         else if ((*it).first.system == SatID::systemGlonass)
                         {
-                           L1Var = antenna.getAntennaPCVariation( Antenna::R01,elev );
-                           L2Var = antenna.getAntennaPCVariation( Antenna::R02,elev );
+                           L1Var = pattern.getAntennaPCVariation( Antenna::R01,elev );
+                           L2Var = pattern.getAntennaPCVariation( Antenna::R02,elev );
                         }
 
                      }
@@ -229,22 +229,22 @@ namespace gpstk
                               // Compute phase center variation values
                            if ((*it).first.system == SatID::systemGPS)
                            {
-                              L1Var = antenna.getAntennaPCVariation( Antenna::G01,
+                              L1Var = pattern.getAntennaPCVariation( Antenna::G01,
                                                                      elev,
                                                                      azim );
 
-                              L2Var = antenna.getAntennaPCVariation( Antenna::G02,
+                              L2Var = pattern.getAntennaPCVariation( Antenna::G02,
                                                                      elev,
                                                                      azim );
                            }
                               // for Glonass
                            else if ((*it).first.system == SatID::systemGlonass)
                            {
-                              L1Var = antenna.getAntennaPCVariation( Antenna::R01,
+                              L1Var = pattern.getAntennaPCVariation( Antenna::R01,
                                                                      elev,
                                                                      azim );
 
-                              L2Var = antenna.getAntennaPCVariation( Antenna::R02,
+                              L2Var = pattern.getAntennaPCVariation( Antenna::R02,
                                                                      elev,
                                                                      azim );
                            }
@@ -259,17 +259,17 @@ namespace gpstk
                                  // Compute phase center variation values
                               if ((*it).first.system == SatID::systemGPS)
                               {
-                                  L1Var = antenna.getAntennaPCVariation( Antenna::G01,
+                                  L1Var = pattern.getAntennaPCVariation( Antenna::G01,
                                                                          elev );
-                                  L2Var = antenna.getAntennaPCVariation( Antenna::G02,
+                                  L2Var = pattern.getAntennaPCVariation( Antenna::G02,
                                                                          elev );
                               }
                                  // for Glonass
                               else if ((*it).first.system == SatID::systemGlonass)
                               {
-                                  L1Var = antenna.getAntennaPCVariation( Antenna::R01,
+                                  L1Var = pattern.getAntennaPCVariation( Antenna::R01,
                                                                          elev );
-                                  L2Var = antenna.getAntennaPCVariation( Antenna::R02,
+                                  L2Var = pattern.getAntennaPCVariation( Antenna::R02,
                                                                          elev );
                               }
 
@@ -316,7 +316,7 @@ namespace gpstk
                }  // End of 'if( (*it).second.find(TypeID::elevation) != ...'
 
 
-            }  // End of 'if( antenna.isValid() )...'
+            }  // End of 'if( pattern.isValid() )...'
 
                // Update displacement vectors with current phase centers
             Triple dL1( dispL1 + L1PhaseCenter - L1Var );
@@ -41,6 +41,7 @@
 #include "Triple.hpp"
 #include "Position.hpp"
 #include "Antenna.hpp"
+#include "AntennaPattern.hpp"
 #include "geometry.hpp"
 
 
@@ -165,6 +166,7 @@ namespace gpstk
                           const Position& stapos,
                           const Antenna& antennaObj )
          : pEphemeris(&ephem), nominalPos(stapos), antenna(antennaObj),
+           pattern(antennaObj),
            useAzimuth(true),
            L1PhaseCenter(0.0, 0.0, 0.0), L2PhaseCenter(0.0, 0.0, 0.0),
            L5PhaseCenter(0.0, 0.0, 0.0), L6PhaseCenter(0.0, 0.0, 0.0),
@@ -501,7 +503,12 @@ namespace gpstk
           * @param antennaObj    Antenna object to be used.
           */
       virtual CorrectObservables& setAntenna(const Antenna& antennaObj)
-      { antenna = antennaObj; useAzimuth = true; return (*this); };
+      {
+         antenna = antennaObj;
+         pattern = AntennaPattern(antennaObj);
+         useAzimuth = true;
+         return (*this);
+      };
 
 
          /// Returns whether azimuth-dependent antenna patterns are being used.
@@ -541,6 +548,11 @@ namespace gpstk
       Antenna antenna;
 
 
+         /// Phase center offsets and variations of 'antenna', as used
+         /// on every epoch.
+      AntennaPattern pattern;
+
+
          /// Whether azimuth-dependent antenna patterns will be used or not
       bool useAzimuth;
 
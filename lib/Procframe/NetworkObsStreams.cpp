@@ -28,6 +28,8 @@
 //============================================================================
 
 
+#include <cmath>
+#include <vector>
 #include "NetworkObsStreams.hpp"
 #include "RinexObsHeader.hpp"
 
@@ -73,6 +75,7 @@ namespace gpstk
 
          mapSourceStream[oData.obsSource] = oData.pObsStream;
          mapSourceSynchro[oData.obsSource] = oData.pSynchro;
+         mapSourceData[oData.obsSource] = &allStreamData.back();
 
          referenceSource = oData.obsSource;
 
@@ -98,6 +101,8 @@ namespace gpstk
    bool NetworkObsStreams::readEpochData(gnssDataMap& gdsMap)
       throw(SynchronizeException)
    {
+      if(readAhead > 0) return readBufferedEpochData(gdsMap);
+
       // First, We clear the data map
       gdsMap.clear();
 
@@ -152,10 +157,175 @@ namespace gpstk
 
    }  // End of method 'NetworkObsStreams::readEpochData()'
 
+      // Get epoch data of the network out of the buffers
+   bool NetworkObsStreams::readBufferedEpochData(gnssDataMap& gdsMap)
+      throw(SynchronizeException)
+   {
+      gdsMap.clear();
+
+      gnssRinex gRef;
+
+      if( !nextBufferedEpoch(*mapSourceData[referenceSource], gRef) )
+      {
+         return false;
+      }
+
+      gdsMap.addGnssRinex(gRef);
+
+      std::map<SourceID, ObsData*>::iterator it;
+      for( it = mapSourceData.begin();
+           it != mapSourceData.end();
+         ++it)
+      {
+         if( it->first == referenceSource) continue;
+
+         gnssRinex gRin;
+
+         if( synchronizeBuffered(*it->second, gRef.header.epoch, gRin) )
+         {
+            gdsMap.addGnssRinex(gRin);
+         }
+         else if(synchronizeException)
+         {
+            std::stringstream ss;
+            ss << "Exception when try to synchronize at epoch: "
+               << gRef.header.epoch << std::endl;
+
+            SynchronizeException e(ss.str());
+
+            GPSTK_THROW(e);
+         }
+
+      }  // End of 'for( it = mapSourceData.begin(); ...'
+
+      return true;
+
+   }  // End of method 'NetworkObsStreams::readBufferedEpochData()'
+
+      // Get the epoch of a source matching 'time', as 'Synchronize' does:
+      // its first epoch is the starting point of every search, and epochs
+      // are read until one is not before 'time' by more than the tolerance.
+   bool NetworkObsStreams::synchronizeBuffered(ObsData& oData,
+                                               const CommonTime& time,
+                                               gnssRinex& gRin)
+   {
+      const double tolerance(oData.pSynchro->getTolerance());
+
+      if(!oData.started)
+      {
+         if( !nextBufferedEpoch(oData, oData.firstEpoch) ) return false;
+         oData.started = true;
+      }
+
+      const CommonTime& first(oData.firstEpoch.header.epoch);
+
+      if( std::abs( first - time ) <= tolerance )
+      {
+         gRin = oData.firstEpoch;
+         return true;
+      }
+
+      if( first > time ) return false;
+
+         // keep reading while the epoch is before 'time'
+      do
+      {
+         if( !nextBufferedEpoch(oData, gRin) ) return false;
+      }
+      while( (gRin.header.epoch < time) &&
+             (std::abs( gRin.header.epoch - time ) > tolerance) );
+
+      return ( std::abs( gRin.header.epoch - time ) <= tolerance );
+
+   }  // End of method 'NetworkObsStreams::synchronizeBuffered()'
+
+      // Get the next epoch of a source, refilling buffers if needed
+   bool NetworkObsStreams::nextBufferedEpoch(ObsData& oData, gnssRinex& gRin)
+   {
+      if( oData.buffer.empty() && !oData.exhausted ) fillBuffers();
+
+      if( oData.buffer.empty() )
+      {
+         if(oData.failed)
+         {
+            GPSTK_RETHROW(oData.error);
+         }
+
+         return false;
+      }
+
+      gRin.header = oData.buffer.front().header;
+      gRin.body.swap( oData.buffer.front().body );
+      oData.buffer.pop_front();
+
+      return true;
+
+   }  // End of method 'NetworkObsStreams::nextBufferedEpoch()'
+
+      // Decode ahead the epochs of every source running low. Each stream is
+      // read by one thread only, so the buffers are filled in parallel.
+   void NetworkObsStreams::fillBuffers()
+   {
+      std::vector<ObsData*> low;
+
+      std::map<SourceID, ObsData*>::iterator it;
+      for( it = mapSourceData.begin();
+           it != mapSourceData.end();
+         ++it)
+      {
+         ObsData& oData(*it->second);
+         if( !oData.exhausted &&
+             2*oData.buffer.size() <= static_cast<size_t>(readAhead) )
+         {
+            low.push_back(&oData);
+         }
+      }
+
+#ifdef _OPENMP
+#pragma omp parallel for schedule(dynamic,1)
+#endif
+      for(int i = 0; i < static_cast<int>(low.size()); i++)
+      {
+         ObsData& oData(*low[i]);
+
+         while( oData.buffer.size() < static_cast<size_t>(readAhead) )
+         {
+            oData.buffer.push_back( gnssRinex() );
+
+            bool good(false);
+            try
+            {
+               good = ( (*oData.pObsStream) >> oData.buffer.back() );
+            }
+            catch(Exception& e)
+            {
+               oData.error = e;
+               oData.failed = true;
+            }
+            catch(...)
+            {
+               oData.error = Exception( "Unknown exception when reading: "
+                                        + oData.obsFile );
+               oData.failed = true;
+            }
+
+            if(!good)
+            {
+               oData.buffer.pop_back();
+               oData.exhausted = true;
+               break;
+            }
+         }
+      }
+
+   }  // End of method 'NetworkObsStreams::fillBuffers()'
+
       // do some clean operation 
    void NetworkObsStreams::cleanUp()
    {
       mapSourceStream.clear();
+      mapSourceSynchro.clear();
+      mapSourceData.clear();
 
       std::list<ObsData>::iterator it;
       for( it = allStreamData.begin();
@@ -33,6 +33,7 @@
 #include <iostream>
 #include <string>
 #include <list>
+#include <deque>
 #include <map>
 #include "RinexObsStream.hpp"
 #include "DataStructures.hpp"
@@ -82,12 +83,19 @@ namespace gpstk
        * to be synchronized. When 'NetworkObsStreams::setSynchronizeException(true)'
        * is used, it'll throw a 'SynchronizeException' when faied to synchronize data.
        * Then, you must handle it appropriately.
+       *
+       * For large networks most of the time goes into decoding the files. After
+       * 'NetworkObsStreams::setReadAhead(n)', every file is decoded up to n epochs
+       * ahead into a buffer of its own, and the buffers running low are refilled
+       * together, one file per thread when OpenMP is enabled. Epochs are then
+       * synchronized out of the buffers exactly as 'Synchronize' does out of the
+       * files, so the gnssDataMap objects are the same as without read-ahead.
        */
    class NetworkObsStreams
    {
    public:
          /// Default constructor
-      NetworkObsStreams() : synchronizeException(false)
+      NetworkObsStreams() : synchronizeException(false), readAhead(0)
       {}
 
          /// Default destructor
@@ -109,6 +117,19 @@ namespace gpstk
       void setSynchronizeException(const bool& synException = true)
       { synchronizeException = synException; }
 
+         /** Sets the number of epochs of every file that are decoded ahead of
+          *  time. It must be set before the first call to readEpochData().
+          *
+          * @param epochs   Size of the buffer of every file; 0 (the default)
+          *                 reads each epoch when it is needed.
+          */
+      NetworkObsStreams& setReadAhead(int epochs)
+      { readAhead = (epochs > 0) ? epochs : 0; return (*this); }
+
+         /// Get the number of epochs of every file decoded ahead of time
+      int getReadAhead() const
+      { return readAhead; }
+
          /// Get epoch data of the network
          /// @gdsMap  Object hold epoch observation data of the network
          /// @return  Is there more epoch data for the network 
@@ -118,6 +139,8 @@ namespace gpstk
          /// Get the SourceID of the rinex observation file
       SourceID sourceIDOfRinexObsFile(std::string obsFile);
 
+         /// Get the stream of a source. With read-ahead, the stream is ahead
+         /// of the epochs returned by readEpochData().
       RinexObsStream* getRinexObsStream(const SourceID& source)
       { return mapSourceStream[source]; }
 
@@ -132,6 +155,29 @@ namespace gpstk
 
          Synchronize* pSynchro;
          RinexObsStream* pObsStream;
+
+            /// Epochs decoded ahead of time
+         std::deque<gnssRinex> buffer;
+
+            /// Whether the stream has no more epochs
+         bool exhausted;
+
+            /// Whether reading the stream threw 'error'
+         bool failed;
+
+            /// Exception thrown while decoding ahead, rethrown once the
+            /// epochs buffered before it are used
+         Exception error;
+
+            /// First epoch of the stream, which 'Synchronize' keeps
+         gnssRinex firstEpoch;
+
+            /// Whether 'firstEpoch' has been read
+         bool started;
+
+         ObsData() : pSynchro(NULL), pObsStream(NULL),
+                     exhausted(false), failed(false), started(false)
+         {}
       };
 
          /// Object to hold all the data of the network
@@ -142,6 +188,9 @@ namespace gpstk
 
          /// Map to easy access the synchronize object
       std::map<SourceID, Synchronize*> mapSourceSynchro;
+
+         /// Map to easy access all the data of a source
+      std::map<SourceID, ObsData*> mapSourceData;
      
          /// Reference Sourcee
       SourceID referenceSource;
@@ -149,6 +198,26 @@ namespace gpstk
          /// Flag indicate will throw 'SynchronizeException'
       bool synchronizeException;
 
+         /// Number of epochs of every file decoded ahead of time
+      int readAhead;
+
+         /// Get epoch data of the network out of the buffers
+      bool readBufferedEpochData(gnssDataMap& gdsMap)
+         throw(SynchronizeException);
+
+         /// Get the epoch of a source matching 'time', as 'Synchronize' does
+         /// @return  false if it can't be synchronized
+      bool synchronizeBuffered(ObsData& oData,
+                               const CommonTime& time,
+                               gnssRinex& gRin);
+
+         /// Get the next epoch of a source, refilling buffers if needed
+         /// @return  false if the source has no more epochs
+      bool nextBufferedEpoch(ObsData& oData, gnssRinex& gRin);
+
+         /// Decode ahead the epochs of every source running low, in parallel
+      void fillBuffers();
+
    private:
          // Do some clean operation 
       virtual void cleanUp();
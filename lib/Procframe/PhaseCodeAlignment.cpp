@@ -131,18 +131,8 @@ namespace gpstk
             }
 
 
-               // Check if satellite currently has entries
-            std::map<SatID, alignData>::const_iterator itDat(
-                                                svData.find( (*it).first ) );
-            if( itDat == svData.end() )
-            {
-
-                  // If it doesn't have an entry, insert one
-               alignData aData;
-
-               svData[ (*it).first ] = aData;
-
-            }
+               // Alignment data of this satellite, inserted if it has none
+            alignData& data( svData[ (*it).first ] );
 
 
                // Place to store if there was a cycle slip. False by default
@@ -174,14 +164,14 @@ namespace gpstk
 
 
                   // Check if satellite arc has changed
-               if( svData[(*it).first].arcNumber != arcN )
+               if( data.arcNumber != arcN )
                {
 
                      // Set flag
                   csflag = true;
 
                      // Update satellite arc information
-                  svData[(*it).first].arcNumber = arcN;
+                  data.arcNumber = arcN;
                }
 
             }  // End of first part of 'if(useSatArcs)'
@@ -232,14 +222,14 @@ namespace gpstk
                diff = std::floor(diff);
 
                   // The new offset is the INTEGER number of cycles, in meters
-               svData[(*it).first].offset = diff * phaseWavelength;
+               data.offset = diff * phaseWavelength;
 
             }
 
                // Let's align the phase measurement using the
                // corresponding offset
             (*it).second[phaseType] = (*it).second[phaseType]
-                                      + svData[(*it).first].offset;
+                                      + data.offset;
               // for the next satellite 
             setCSFlag(csFlag);
             setPhaseWavelength(wavelength);
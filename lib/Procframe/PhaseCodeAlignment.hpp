@@ -33,6 +33,7 @@
 
 
 #include "ProcessingClass.hpp"
+#include "SatStateTable.hpp"
 
 
 
@@ -223,6 +224,15 @@ namespace gpstk
       { watchCSFlag = watchFlag; return (*this); };
 
 
+         /** Method to keep the alignment data in a table shared with the
+          *  other objects processing the same data stream.
+          *
+          * @param table   SatStateTable of the data stream.
+          */
+      virtual PhaseCodeAlignment& setStateTable(SatStateTable& table)
+      { svData.setTable(table); return (*this); };
+
+
          /** Returns a satTypeValueMap object, adding the new data generated
           *  when calling this object.
           *
@@ -296,8 +306,8 @@ namespace gpstk
       };
 
 
-         /// Map holding the information regarding every satellite
-      std::map<SatID, alignData> svData;
+         /// Column holding the information regarding every satellite
+      SatStateColumn<alignData> svData;
 
 
    }; // End of class 'PhaseCodeAlignment'
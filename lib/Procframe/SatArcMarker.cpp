@@ -92,10 +92,10 @@ namespace gpstk
        */
    CommonTime SatArcMarker::getArcChangedEpoch(const SatID& sat)
    {
-      std::map<SatID, CommonTime>::iterator it = satArcChangeMap.find(sat);
-      if(it!=satArcChangeMap.end())
+      const arcData* pData( satArcData.find(sat) );
+      if(pData != NULL)
       {
-         return it->second;
+         return pData->arcChangeEpoch;
       }
       else
       {
@@ -149,30 +149,21 @@ namespace gpstk
                continue;
             }
 
-               // Check if satellite currently has entries
-            std::map<SatID, double>::const_iterator itArc(
-                                                satArcMap.find( (*it).first ) );
-            if( itArc == satArcMap.end() )
-            {
-                  // If it doesn't have an entry, insert one
-               satArcMap[ (*it).first ] = 0.0;
-               satArcChangeMap[ (*it).first ] = CommonTime::BEGINNING_OF_TIME;
-
-                  // This is a new satellite
-               satIsNewMap[ (*it).first ] = true;
-            }
+               // Arc data of this satellite. If it has none, it is inserted
+               // as a new satellite
+            arcData& data( satArcData[ (*it).first ] );
 
                // Check if we are inside unstable period
-            bool insideUnstable(std::abs(epoch-satArcChangeMap[(*it).first]) <=
+            bool insideUnstable( std::abs(epoch-data.arcChangeEpoch) <=
                                                                unstablePeriod );
 
                // Satellites can be new only once, and having at least once a
                // flag > 0.0 outside 'unstablePeriod' will make them old.
-            if( satIsNewMap[ (*it).first ] &&
-                !insideUnstable            &&
+            if( data.isNew      &&
+                !insideUnstable &&
                 flag <= 0.0 )
             {
-               satIsNewMap[ (*it).first ] = false;
+               data.isNew = false;
             }
 
 
@@ -180,15 +171,15 @@ namespace gpstk
             if ( flag > 0.0 )
             {
                   // Increment the value of "TypeID::satArc"
-               satArcMap[ (*it).first ] = satArcMap[ (*it).first ] + 1.0;
+               data.arcNumber = data.arcNumber + 1.0;
 
                   // Update arc change epoch
-               satArcChangeMap[ (*it).first ] = epoch;
+               data.arcChangeEpoch = epoch;
 
                   // If we want to delete unstable satellites, we must do it
                   // also when arc changes, but only if this SV is not new
                if ( deleteUnstableSats  &&
-                    (!satIsNewMap[ (*it).first ]) )
+                    (!data.isNew) )
                {
                   satRejectedSet.insert( (*it).first );
                }
@@ -200,13 +191,13 @@ namespace gpstk
                // if satellite is NOT new and we are inside unstable period
             if ( insideUnstable &&
                  deleteUnstableSats &&
-                 ( !satIsNewMap[ (*it).first ] ) )
+                 ( !data.isNew ) )
             {
                satRejectedSet.insert( (*it).first );
             }
 
                // We will insert satellite arc number
-            (*it).second[TypeID::satArc] = satArcMap[ (*it).first ];
+            (*it).second[TypeID::satArc] = data.arcNumber;
 
          }
 
@@ -33,6 +33,7 @@
 
 
 #include "ProcessingClass.hpp"
+#include "SatStateTable.hpp"
 
 
 
@@ -165,6 +166,15 @@ namespace gpstk
           */
       virtual CommonTime getArcChangedEpoch(const SatID& sat);
 
+
+         /** Method to keep the arc data in a table shared with the other
+          *  objects processing the same data stream.
+          *
+          * @param table   SatStateTable of the data stream.
+          */
+      virtual SatArcMarker& setStateTable(SatStateTable& table)
+      { satArcData.setTable(table); return (*this); };
+
          /** Returns a satTypeValueMap object, adding the new data generated
           *  when calling this object.
           *
@@ -218,16 +228,23 @@ namespace gpstk
       double unstablePeriod;
 
 
-         /// Map holding information regarding every satellite
-      std::map<SatID, double> satArcMap;
-
+         /// A structure used to store arc data for a SV.
+      struct arcData
+      {
+            // Default constructor initializing the data in the structure
+         arcData() : arcNumber(0.0),
+                     arcChangeEpoch(CommonTime::BEGINNING_OF_TIME),
+                     isNew(true)
+         {};
 
-         /// Map holding information about epoch of last arc change
-      std::map<SatID, CommonTime> satArcChangeMap;
+         double arcNumber;          ///< Current satellite arc.
+         CommonTime arcChangeEpoch; ///< Epoch of last arc change.
+         bool isNew;                ///< Whether this satellite is new.
+      };
 
 
-         /// Map keeping track if this satellite is new or not
-      std::map<SatID, bool> satIsNewMap;
+         /// Column holding information regarding every satellite
+      SatStateColumn<arcData> satArcData;
 
 
    }; // End of class 'SatArcMarker'
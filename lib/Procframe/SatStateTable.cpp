@@ -0,0 +1,159 @@
+#pragma ident "$Id$"
+
+/**
+ * @file SatStateTable.cpp
+ * Dense table of per-satellite state, shared by the processing objects of
+ * one data source.
+ */
+
+//============================================================================
+//
+//  This file is part of GPSTk, the GPS Toolkit.
+//
+//  The GPSTk is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU Lesser General Public License as published
+//  by the Free Software Foundation; either version 2.1 of the License, or
+//  any later version.
+//
+//  The GPSTk is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU Lesser General Public License for more details.
+//
+//  You should have received a copy of the GNU Lesser General Public
+//  License along with GPSTk; if not, write to the Free Software Foundation,
+//  Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110, USA
+//
+//============================================================================
+
+
+#include "SatStateTable.hpp"
+
+
+namespace gpstk
+{
+
+      // Copy constructor, copying every column.
+   SatStateTable::SatStateTable(const SatStateTable& right)
+      : sats(right.sats), denseIndex(right.denseIndex),
+        sparseIndex(right.sparseIndex)
+   {
+
+      for(size_t i = 0; i < right.columns.size(); ++i)
+      {
+         columns.push_back( right.columns[i]->clone() );
+      }
+
+   }  // End of copy constructor 'SatStateTable::SatStateTable()'
+
+
+
+      // Assignment operator, copying every column.
+   SatStateTable& SatStateTable::operator=(const SatStateTable& right)
+   {
+
+      if( this == &right )
+      {
+         return (*this);
+      }
+
+      deleteColumns();
+
+      sats = right.sats;
+      denseIndex = right.denseIndex;
+      sparseIndex = right.sparseIndex;
+
+      for(size_t i = 0; i < right.columns.size(); ++i)
+      {
+         columns.push_back( right.columns[i]->clone() );
+      }
+
+      return (*this);
+
+   }  // End of method 'SatStateTable::operator=()'
+
+
+
+      /* Returns the slot of a satellite, or -1 if it is not in the
+       * table.
+       *
+       * @param[in] sat    Satellite.
+       */
+   int SatStateTable::findSlot(const SatID& sat) const
+   {
+
+      if( sat.system >= 0 && sat.system < numSystems &&
+          sat.id >= 0 && sat.id < maxDenseId )
+      {
+         return denseIndex[ sat.system*maxDenseId + sat.id ];
+      }
+
+      std::map<SatID, int>::const_iterator it( sparseIndex.find(sat) );
+      if( it == sparseIndex.end() )
+      {
+         return -1;
+      }
+
+      return it->second;
+
+   }  // End of method 'SatStateTable::findSlot()'
+
+
+
+      // Adds a satellite, growing every column.
+   int SatStateTable::addSlot(const SatID& sat)
+   {
+
+      int s( sats.size() );
+
+      int* p( indexOf(sat) );
+      if( p != NULL )
+      {
+         *p = s;
+      }
+      else
+      {
+         std::map<SatID, int>::const_iterator it( sparseIndex.find(sat) );
+         if( it != sparseIndex.end() )
+         {
+            return it->second;
+         }
+         sparseIndex[sat] = s;
+      }
+
+      sats.push_back(sat);
+
+      for(size_t i = 0; i < columns.size(); ++i)
+      {
+         columns[i]->resize( sats.size() );
+      }
+
+      return s;
+
+   }  // End of method 'SatStateTable::addSlot()'
+
+
+
+      // Deletes the columns.
+   void SatStateTable::deleteColumns()
+   {
+
+      for(size_t i = 0; i < columns.size(); ++i)
+      {
+         delete columns[i];
+      }
+
+      columns.clear();
+
+   }  // End of method 'SatStateTable::deleteColumns()'
+
+
+
+      // Destructor
+   SatStateTable::~SatStateTable()
+   {
+      deleteColumns();
+   }
+
+
+}  // End of namespace gpstk
@@ -0,0 +1,331 @@
+#pragma ident "$Id$"
+
+/**
+ * @file SatStateTable.hpp
+ * Dense table of per-satellite state, shared by the processing objects of
+ * one data source.
+ */
+
+#ifndef GPSTK_SATSTATETABLE_HPP
+#define GPSTK_SATSTATETABLE_HPP
+
+//============================================================================
+//
+//  This file is part of GPSTk, the GPS Toolkit.
+//
+//  The GPSTk is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU Lesser General Public License as published
+//  by the Free Software Foundation; either version 2.1 of the License, or
+//  any later version.
+//
+//  The GPSTk is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU Lesser General Public License for more details.
+//
+//  You should have received a copy of the GNU Lesser General Public
+//  License along with GPSTk; if not, write to the Free Software Foundation,
+//  Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110, USA
+//
+//============================================================================
+
+
+#include <vector>
+#include <map>
+
+#include "Exception.hpp"
+#include "SatID.hpp"
+
+
+
+namespace gpstk
+{
+
+      /** @addtogroup DataStructures */
+      //@{
+
+
+      /** This class keeps the state that processing objects such as cycle
+       *  slip detectors carry from one epoch to the next, for every
+       *  satellite of one data source.
+       *
+       * Each satellite gets a compact slot the first time it is seen, and
+       * the slot is found by direct indexing on system and PRN, not by
+       * searching a map. Each processing object registers a column, which
+       * is a std::vector of its own per-satellite structure indexed by slot;
+       * all the columns grow together when a satellite is added, and the new
+       * entry of each column is a copy of the value given when the column
+       * was registered.
+       *
+       * A typical way to use this class follows:
+       *
+       * @code
+       *   SatStateTable satStates;
+       *
+       *   LICSDetector markCSLI;
+       *   markCSLI.setStateTable(satStates);
+       *   MWCSDetector2 markCSMW;
+       *   markCSMW.setStateTable(satStates);
+       *
+       *   while(rin >> gRin)
+       *   {
+       *      gRin >> markCSLI >> markCSMW;
+       *   }
+       * @endcode
+       *
+       * \warning A table holds the state of ONE data stream; use a different
+       * table for each receiver.
+       *
+       * @sa SatStateColumn, which is what processing objects keep.
+       */
+   class SatStateTable
+   {
+   public:
+
+         /// Default constructor, an empty table.
+      SatStateTable()
+         : denseIndex(numSystems*maxDenseId, -1)
+      {};
+
+
+         /// Copy constructor, copying every column.
+      SatStateTable(const SatStateTable& right);
+
+
+         /// Assignment operator, copying every column.
+      SatStateTable& operator=(const SatStateTable& right);
+
+
+         /** Registers a new column, and returns its index.
+          *
+          * @param[in] init   Value of the entries of new satellites.
+          */
+      template<class T>
+      int addColumn(const T& init = T())
+      {
+         Column<T>* pc( new Column<T>(init) );
+         pc->resize( sats.size() );
+         columns.push_back(pc);
+         return ( columns.size() - 1 );
+      };
+
+
+         /** Returns a column, indexed by slot. The type must be the one
+          *  the column was registered with.
+          *
+          * @param[in] col    Index returned by addColumn().
+          */
+      template<class T>
+      std::vector<T>& column(int col)
+         throw(InvalidRequest)
+      {
+         if( col < 0 || col >= static_cast<int>(columns.size()) )
+         {
+            InvalidRequest e("SatStateTable: column out of range");
+            GPSTK_THROW(e);
+         }
+         return static_cast< Column<T>* >(columns[col])->values;
+      };
+
+
+         /** Returns the slot of a satellite, adding it to the table if it
+          *  is not there yet.
+          *
+          * @param[in] sat    Satellite.
+          */
+      int slot(const SatID& sat)
+      {
+         int* p( indexOf(sat) );
+         if( p != NULL && *p >= 0 )
+         {
+            return *p;
+         }
+         return addSlot(sat);
+      };
+
+
+         /** Returns the slot of a satellite, or -1 if it is not in the
+          *  table.
+          *
+          * @param[in] sat    Satellite.
+          */
+      int findSlot(const SatID& sat) const;
+
+
+         /// Returns the satellite of a slot.
+      const SatID& satellite(int s) const
+      { return sats[s]; };
+
+
+         /// Returns the number of satellites in the table.
+      int size() const
+      { return sats.size(); };
+
+
+         /// Returns the number of columns in the table.
+      int numColumns() const
+      { return columns.size(); };
+
+
+         /// Destructor
+      virtual ~SatStateTable();
+
+
+   private:
+
+
+         /// Number of systems and PRNs indexed directly; other satellites
+         /// are kept in 'sparseIndex'.
+      static const int numSystems = SatID::systemUnknown + 1;
+      static const int maxDenseId = 64;
+
+
+         /// Interface of the columns, whatever their type.
+      struct ColumnBase
+      {
+         virtual void resize(size_t n) = 0;
+         virtual ColumnBase* clone() const = 0;
+         virtual ~ColumnBase() {};
+      };
+
+
+         /// A column of values of type T.
+      template<class T>
+      struct Column : public ColumnBase
+      {
+         Column(const T& init) : initValue(init) {};
+
+         virtual void resize(size_t n)
+         { values.resize(n, initValue); };
+
+         virtual ColumnBase* clone() const
+         { return new Column<T>(*this); };
+
+         std::vector<T> values;
+         T initValue;
+      };
+
+
+         /// Satellite of each slot.
+      std::vector<SatID> sats;
+
+         /// Slot of each system and PRN, or -1.
+      std::vector<int> denseIndex;
+
+         /// Slot of the satellites outside 'denseIndex'.
+      std::map<SatID, int> sparseIndex;
+
+         /// The columns, owned by the table.
+      std::vector<ColumnBase*> columns;
+
+
+         /// Returns the entry of 'denseIndex' of a satellite, or NULL if it
+         /// has none.
+      int* indexOf(const SatID& sat)
+      {
+         if( sat.system >= 0 && sat.system < numSystems &&
+             sat.id >= 0 && sat.id < maxDenseId )
+         {
+            return &denseIndex[ sat.system*maxDenseId + sat.id ];
+         }
+         return NULL;
+      };
+
+
+         /// Adds a satellite, growing every column.
+      int addSlot(const SatID& sat);
+
+
+         /// Deletes the columns.
+      void deleteColumns();
+
+
+   }; // End of class 'SatStateTable'
+
+
+
+      /** A column of a SatStateTable, as kept by a processing object.
+       *
+       * The column is registered the first time it is used. Until
+       * setTable() is called the object keeps its own table, so that the
+       * processing object works alone, as it always did; after that, the
+       * column lives in the given table, which must outlive it.
+       *
+       * @code
+       *   SatStateColumn<filterData> LIData;
+       *
+       *   filterData& data( LIData[sat] );
+       * @endcode
+       */
+   template<class T>
+   class SatStateColumn
+   {
+   public:
+
+         /** Common constructor.
+          *
+          * @param[in] init   Value of the entries of new satellites.
+          */
+      SatStateColumn(const T& init = T())
+         : pTable(NULL), col(-1), initValue(init)
+      {};
+
+
+         /// Keeps the column in 'table' from now on; former state is lost.
+      void setTable(SatStateTable& table)
+      { pTable = &table; col = -1; };
+
+
+         /// Returns the table where the column is kept.
+      SatStateTable& getTable()
+      { return ( (pTable != NULL) ? *pTable : ownTable ); };
+
+
+         /// Returns the state of a satellite, adding it if needed.
+      T& operator[](const SatID& sat)
+      {
+         SatStateTable& table( getTable() );
+         if( col < 0 )
+         {
+            col = table.addColumn(initValue);
+         }
+         int s( table.slot(sat) );
+         return table.template column<T>(col)[s];
+      };
+
+
+         /// Returns the state of a satellite, or NULL if it has none.
+      const T* find(const SatID& sat)
+      {
+         SatStateTable& table( getTable() );
+         int s( table.findSlot(sat) );
+         if( col < 0 || s < 0 )
+         {
+            return NULL;
+         }
+         return &table.template column<T>(col)[s];
+      };
+
+
+   private:
+
+         /// Table used until setTable() is called.
+      SatStateTable ownTable;
+
+         /// Shared table, or NULL.
+      SatStateTable* pTable;
+
+         /// Index of the column in the table, or -1 if not registered.
+      int col;
+
+         /// Value of the entries of new satellites.
+      T initValue;
+
+   }; // End of class 'SatStateColumn'
+
+
+      //@}
+
+}  // End of namespace gpstk
+
+#endif   // GPSTK_SATSTATETABLE_HPP
@@ -164,6 +164,9 @@ namespace gpstk {
    //HelmertTransform::PZ90Epoch(2454364L,61200L,0.0,TimeSystem::UTC);
 
    // array of pre-defined HelmertTransforms
+   // NB the transforms without an epoch are given CommonTime(TimeSystem::Any),
+   // which is BEGINNING_OF_TIME; that static, defined in another file, may not be
+   // constructed yet when this array is.
    const HelmertTransform HelmertTransform::stdTransforms[stdCount] =
    {
       HelmertTransform(ReferenceFrame::WGS84, ReferenceFrame::ITRF,
@@ -184,7 +187,8 @@ namespace gpstk {
                   "\"ITRS, PZ-90 and WGS 84: current realizations\n       "
                   "and the related transformation parameters,\"\n       "
                   "Journal Geodesy (2001), 75:613, by Boucher and Altamimi.\n       "
-                  "Use before 20 Sept 2007 17:00 UTC (ICD-2008 v5.1 table 3.2).")),
+                  "Use before 20 Sept 2007 17:00 UTC (ICD-2008 v5.1 table 3.2)."),
+           CommonTime(TimeSystem::Any)),
 
       HelmertTransform(ReferenceFrame::PZ90, ReferenceFrame::WGS84,
            0, 0, 0,  -0.36, 0.08, 0.18,  0,
@@ -203,7 +207,8 @@ namespace gpstk {
                   "\"ITRS, PZ-90 and WGS 84: current realizations\n       "
                   "and the related transformation parameters,\"\n       "
                   "Journal Geodesy (2001), 75:613, by Boucher and Altamimi.\n       "
-                  "Use before 20 Sept 2007 17:00 UTC (ICD-2008 v5.1 table 3.2).")),
+                  "Use before 20 Sept 2007 17:00 UTC (ICD-2008 v5.1 table 3.2)."),
+           CommonTime(TimeSystem::Any)),
 
       HelmertTransform(ReferenceFrame::PZ90, ReferenceFrame::ITRF,
            0, 0, 0,  -0.36, 0.08, 0.18,  0,
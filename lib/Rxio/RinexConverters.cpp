@@ -38,6 +38,8 @@
 
 /** @file Translates between various similiar objects */
 
+#include <algorithm>
+
 #include "StringUtils.hpp"
 #include "RinexObsID.hpp"
 
@@ -173,6 +175,88 @@ namespace gpstk
       return rod;
    }
 
+   // Fill one MDP observation block from the given Rinex obs. Returns false
+   // if there is no pseudorange.
+   static bool makeMDPObservation(MDPObsEpoch::Observation& mo,
+                                  const RinexObsData::RinexObsTypeMap& rotm,
+                                  const RinexObsType& code,
+                                  const RinexObsType& phase,
+                                  const RinexObsType& doppler,
+                                  const RinexObsType& snr)
+   {
+      RinexObsData::RinexObsTypeMap::const_iterator j = rotm.find(code);
+      if (j == rotm.end() || j->second.data == 0)
+         return false;
+      mo.pseudorange = j->second.data;
+
+      short lli = 0;
+      if ((j = rotm.find(phase)) != rotm.end())
+      {
+         mo.phase = j->second.data;
+         lli = j->second.lli;
+      }
+      if ((j = rotm.find(doppler)) != rotm.end())
+         mo.doppler = j->second.data;
+      if ((j = rotm.find(snr)) != rotm.end())
+         mo.snr = std::min(std::max(j->second.data, 0.0), 65.0);
+
+      mo.lockCount = (lli & 1) ? 0 : 1;
+      return true;
+   }
+
+
+   MDPEpoch makeMDPEpoch(const RinexObsData& rod)
+   {
+      MDPEpoch me;
+
+      for (RinexObsData::RinexSatMap::const_iterator i=rod.obs.begin();
+           i!=rod.obs.end() && me.size() < 15; i++)
+      {
+         if (i->first.system != SatID::systemGPS)
+            continue;
+
+         const RinexObsData::RinexObsTypeMap& rotm = i->second;
+         MDPObsEpoch moe;
+         moe.time = rod.time;
+         moe.prn = i->first.id;
+         moe.channel = me.size() + 1;
+
+         MDPObsEpoch::Observation mo;
+         mo.carrier = ccL1;
+         mo.range = rcCA;
+         if (makeMDPObservation(mo, rotm, RinexObsHeader::C1,
+                                RinexObsHeader::L1, RinexObsHeader::D1,
+                                RinexObsHeader::S1))
+            moe.obs[MDPObsEpoch::ObsKey(ccL1, rcCA)] = mo;
+
+         mo = MDPObsEpoch::Observation();
+         mo.carrier = ccL1;
+         mo.range = rcPcode;
+         if (makeMDPObservation(mo, rotm, RinexObsHeader::P1,
+                                RinexObsHeader::L1, RinexObsHeader::D1,
+                                RinexObsHeader::S1))
+            moe.obs[MDPObsEpoch::ObsKey(ccL1, rcPcode)] = mo;
+
+         mo = MDPObsEpoch::Observation();
+         mo.carrier = ccL2;
+         mo.range = rcPcode;
+         if (makeMDPObservation(mo, rotm, RinexObsHeader::P2,
+                                RinexObsHeader::L2, RinexObsHeader::D2,
+                                RinexObsHeader::S2))
+            moe.obs[MDPObsEpoch::ObsKey(ccL2, rcPcode)] = mo;
+
+         if (moe.obs.empty())
+            continue;
+
+         me.insert(pair<const int, MDPObsEpoch>(moe.prn, moe));
+      }
+
+      for (MDPEpoch::iterator i=me.begin(); i!=me.end(); i++)
+         i->second.numSVs = me.size();
+
+      return me;
+   }
+
    // Try to convert the given pages into an EngAlmanc object. Returns true
    // upon success. This routine is tuned for two different types of nav data.
    //
@@ -66,5 +66,11 @@ namespace gpstk
    /// Conversion Function from MDP data
    RinexObsData::RinexObsTypeMap makeRinexObsTypeMap(const MDPObsEpoch& moe) throw();
    RinexObsData makeRinexObsData(const MDPEpoch& me);
+
+   /// Conversion Function to MDP data, the reverse of makeRinexObsData().
+   /// Only GPS SVs with a pseudorange are kept, at most 15 since that is all
+   /// the numSVs field can count. The SNR is limited to the 0-65 dB-Hz range
+   /// accepted by the MDP decoder.
+   MDPEpoch makeMDPEpoch(const RinexObsData& rod);
 }
 #endif
@@ -28,8 +28,9 @@
 //============================================================================
 
 
+#include <algorithm>
+#include <cmath>
 #include "EpochDataStore.hpp"
-#include "MiscMath.hpp"
 
 using namespace std;
 
@@ -39,16 +40,29 @@ namespace gpstk
       // get epoch list stored in this object
    EpochDataStore::EpochList EpochDataStore::epochList()
    {
-      EpochList epochList;
-      for(EpochData::const_iterator it = allData.begin();
-         it != allData.end();
-         ++it)
-      {
-         epochList.insert(it->first);
-      }
-      
-      return epochList;
+      return EpochList(epochs.begin(), epochs.end());
+   }
+
+
+   bool EpochDataStore::isEpochExist(CommonTime t)
+   {
+      vector<CommonTime>::const_iterator it =
+         lower_bound(epochs.begin(), epochs.end(), t);
+
+      return (it != epochs.end() && *it == t);
    }
+
+
+      // clear the all the data
+   void EpochDataStore::clear()
+   {
+      epochs.clear();
+      values.clear();
+      width = 0;
+
+      updateEpochs();
+   }
+
    
       /* Edit the dataset, removing data outside the indicated time
        *  interval.
@@ -68,37 +82,18 @@ namespace gpstk
       if(tmin > finalTime) return;
       if(tmax < initialTime) return;
 
-      EpochData::iterator it = allData.lower_bound(tmin);
-      if(it != allData.begin())
-      {
-         allData.erase(allData.begin(), it);
-      }
+      size_t first = lower_bound(epochs.begin(), epochs.end(), tmin)
+                     - epochs.begin();
+      size_t last = upper_bound(epochs.begin(), epochs.end(), tmax)
+                    - epochs.begin();
 
-      it = allData.upper_bound(tmax);
-      if(it != allData.end())
-      {
-         allData.erase(it, allData.end());
-      }
+      epochs.erase(epochs.begin()+last, epochs.end());
+      epochs.erase(epochs.begin(), epochs.begin()+first);
 
-      it = allData.begin();
-      if(it == allData.end())
-      {
-         initialTime = CommonTime::END_OF_TIME;
-      }
-      else
-      {
-         initialTime = it->first;
-      }
+      values.erase(values.begin()+last*width, values.end());
+      values.erase(values.begin(), values.begin()+first*width);
 
-      it = allData.end();
-      if(--it == allData.end())
-      {
-         finalTime = CommonTime::BEGINNING_OF_TIME;
-      }
-      else 
-      {
-         finalTime = it->first;
-      }
+      updateEpochs();
 
    } // End of method 'EpochDataStore::edit()'
    
@@ -106,24 +101,60 @@ namespace gpstk
       // Add to the store directly
    void EpochDataStore::addData(const CommonTime& time, 
                                 const std::vector<double>& data)
+      throw(InvalidRequest)
    {
-      
-      allData[time] = data;
-
-      if((initialTime == CommonTime::END_OF_TIME)    ||
-         (finalTime == CommonTime::BEGINNING_OF_TIME) )
+      if(epochs.empty())
       {
-         initialTime = finalTime = time;
+         width = data.size();
       }
-      else if(time < initialTime) 
+      else if(data.size() != width)
       {
-         initialTime = time;
+         InvalidRequest e("Size of the data vector doesn't match!");
+         GPSTK_THROW(e);
       }
-      else if(time > finalTime) 
+
+         // Tables come in time order: append, and keep the spacing
+      if(epochs.empty() || epochs.back() < time)
       {
+         epochs.push_back(time);
+         values.insert(values.end(), data.begin(), data.end());
+
+         const size_t n( epochs.size() );
+         if(n == 1)
+         {
+            initialTime = time;
+         }
+         else if(n == 2)
+         {
+            step = epochs[1] - epochs[0];
+            uniform = true;
+         }
+         else if(uniform)
+         {
+            uniform = ( (epochs[n-1] - epochs[n-2]) == step );
+         }
          finalTime = time;
+         lastValid = false;
+
+         return;
+      }
+
+      vector<CommonTime>::iterator it =
+         lower_bound(epochs.begin(), epochs.end(), time);
+      const size_t k( it - epochs.begin() );
+
+      if(*it == time)
+      {
+         copy(data.begin(), data.end(), values.begin()+k*width);
+      }
+      else
+      {
+         epochs.insert(it, time);
+         values.insert(values.begin()+k*width, data.begin(), data.end());
       }
 
+      updateEpochs();
+
    }  // End of method 'EpochDataStore::addData()'
    
    
@@ -135,6 +166,20 @@ namespace gpstk
        */
    std::vector<double> EpochDataStore::getData(const CommonTime& t) const
          throw(InvalidRequest)
+   {
+      std::vector<double> vd;
+      getData(t, vd);
+      return vd;
+
+   }  // End of method 'EpochDataStore::getData()'
+
+
+      /* Get the Data at the given epoch into a vector, which is resized if
+       *  needed.
+       */
+   void EpochDataStore::getData( const CommonTime& t,
+                                 std::vector<double>& vd ) const
+         throw(InvalidRequest)
    {
          // check the time
       if( (t < initialTime) || (t > finalTime))
@@ -145,124 +190,166 @@ namespace gpstk
          GPSTK_THROW(ire);
       }
 
-      EpochData::const_iterator it = allData.find(t);
-      if(it != allData.end())
+         // The same time as the last call, or the same interval. Nothing
+         // may throw out of the critical section; the times were compared
+         // above, so they can be compared again.
+      bool same(false);
+      size_t hint(0);
+#ifdef _OPENMP
+#pragma omp critical(EpochDataStoreLast)
+#endif
       {
-         return it->second;
+         try
+         {
+            if(lastValid)
+            {
+               if(lastTime == t)
+               {
+                  vd = lastData;
+                  same = true;
+               }
+               else
+               {
+                  hint = lastIndex;
+               }
+            }
+         }
+         catch(...) { same = false; hint = 0; }
       }
-      
-     
-      const int half = ( interPoints + 1 ) / 2;
 
-      it = allData.lower_bound(t);   // i points to first element with key >= t
+      if(same) return;
 
-      if(t > finalTime) 
-      { 
-         it = allData.end();
-         it--;
+         // First epoch not before t
+      const int n( epochs.size() );
+      int k;
+      if( hint > 0 && epochs[hint-1] < t && t <= epochs[hint] )
+      {
+         k = hint;
+      }
+      else
+      {
+         k = findIndex(t);
       }
- 
-      EpochData::const_iterator its = it;
-      EpochData::const_iterator ite = it;
 
-      if(int(allData.size())> 2*half)
+      if(epochs[k] == t)
       {
-         int ileft = half;
-         for(int i = 0; i < half; i++)
+         vd.assign(values.begin()+k*width, values.begin()+(k+1)*width);
+      }
+      else
+      {
+            // The interPoints epochs (rounded up to an even number) around
+            // t, or all of them
+         const int half( (interPoints + 1) / 2 );
+         int left(0), count(n);
+         if(n > 2*half)
          {
-            if(its==allData.begin()) break;
-            its--;
-            ileft--;
+            count = std::max(2*half, 1);
+            left = std::max(0, std::min(k-half, n-count));
          }
 
-
-         int iright = half-1+ileft;
-         for(int i = 0; i < (half-1+ileft); i++)
+         std::vector<double> times(count);
+         for(int i = 0; i < count; i++)
          {
-            ite++;
+            times[i] = epochs[left+i] - epochs[left];
+         }
 
-            if(ite == allData.end())
-            {
-               ite--;
-               break;
-            }
+         const double dt( t - epochs[left] );
 
-            iright--;
+            // Lagrange interpolation of all the values at once, with the
+            // same operations as SimpleLagrangeInterpolation()
+         int exact(-1);
+         for(int i = 0; i < count; i++)
+         {
+            if(dt == times[i]) { exact = i; break; }
          }
 
-         int ileft2 = iright; 
-         for(int i = 0; i < iright; i++)
+         if(exact >= 0)
          {
-            if(its == allData.begin()) break;
-            its--;
-            ileft2--;
+            const size_t r( (left+exact)*width );
+            vd.assign(values.begin()+r, values.begin()+r+width);
          }
-
-         if(ileft2 > 0)
+         else
          {
-            // the code never go here
-            // just throw an exception
-
-            InvalidRequest e("My God, it should never go here!!!");
-            GPSTK_THROW(e);
+            vd.assign(width, 0.0);
+            for(int i = 0; i < count; i++)
+            {
+               double Li(1.0);
+               for(int j = 0; j < count; j++)
+               {
+                  if(i != j) Li *= (dt-times[j])/(times[i]-times[j]);
+               }
+
+               const double* y = &values[(left+i)*width];
+               for(size_t c = 0; c < width; c++)
+               {
+                  vd[c] += Li*y[c];
+               }
+            }
          }
       }
-      else
+
+#ifdef _OPENMP
+#pragma omp critical(EpochDataStoreLast)
+#endif
       {
-         its = allData.begin();
-         ite = allData.end();
-         ite--;
+         lastTime = t;
+         lastIndex = k;
+         lastData = vd;
+         lastValid = true;
       }
-      
-      const int N = its->second.size();
-
-      std::vector<double> times;
-      std::vector<std::vector<double> > datas(N);
-      
-      EpochData::const_iterator itrEnd = ite;
-      itrEnd++;
-      for(EpochData::const_iterator itr=its; itr!=itrEnd; itr++)
-      {
-         CommonTime time = itr->first;
-         std::vector<double> vd = itr->second;
 
-         times.push_back(itr->first - its->first);
-         
-         if( vd.size() != N)
-         {
-            // Exception
-            InvalidRequest e("Size of the data vector doesn't match!");
-            GPSTK_THROW(e);
-            
-         }
-         
-         for(int i = 0; i < N; i++)
-         {
-            datas[i].push_back( vd[i] );
-         }
-      }
-      
-      std::vector<double> vd(N, 0.0);
+   }  // End of method 'EpochDataStore::getData()'
+
+
+      // Index of the first epoch not before t, which is within the span
+   size_t EpochDataStore::findIndex(const CommonTime& t) const
+   {
+      const size_t n( epochs.size() );
 
-      double dt = t - its->first;
-      
-      for(int i = 0; i < N; i++)
+      if(!uniform)
       {
-         vd[i] = SimpleLagrangeInterpolation(times,datas[i],dt);
+         return lower_bound(epochs.begin(), epochs.end(), t) - epochs.begin();
       }
 
-      return vd;
-   
-   }  // End of method 'EpochDataStore::getPVData()'
+         // The spacing is only known to the precision of a double, so the
+         // index may be one off
+      double x( std::ceil( (t - epochs[0]) / step ) );
+      size_t k( (x <= 0.0) ? 0 : ( (x >= double(n-1)) ? n-1 : size_t(x) ) );
 
+      while( k > 0 && !(epochs[k-1] < t) ) k--;
+      while( k < n-1 && epochs[k] < t ) k++;
 
-}  // End of namespace gpstk
+      return k;
 
+   }  // End of method 'EpochDataStore::findIndex()'
 
 
+      // Recompute the time span and spacing after the epochs changed
+   void EpochDataStore::updateEpochs()
+   {
+      const size_t n( epochs.size() );
 
+      if(n == 0)
+      {
+         initialTime = CommonTime::END_OF_TIME;
+         finalTime = CommonTime::BEGINNING_OF_TIME;
+      }
+      else
+      {
+         initialTime = epochs.front();
+         finalTime = epochs.back();
+      }
 
+      uniform = (n >= 2);
+      step = uniform ? (epochs[1] - epochs[0]) : 0.0;
+      for(size_t i = 2; uniform && i < n; i++)
+      {
+         uniform = ( (epochs[i] - epochs[i-1]) == step );
+      }
 
+      lastValid = false;
 
+   }  // End of method 'EpochDataStore::updateEpochs()'
 
 
+}  // End of namespace gpstk
@@ -36,6 +36,7 @@
 #include <string>
 #include <set>
 #include <map>
+#include <vector>
 #include "CommonTime.hpp"
 
 
@@ -47,6 +48,12 @@ namespace gpstk
 
       /** Class to handle interpolatable time serial data 
        * 
+       * The epochs are kept sorted in a vector and the data of all the
+       * epochs in one contiguous array. When the epochs are equally spaced,
+       * as in most tables, the epochs around a given time are found by
+       * index arithmetic instead of a search. The last result of getData()
+       * is kept, so that asking again for the same time, as the helpers
+       * returning one value each do, costs a comparison.
        */
    class EpochDataStore
    {
@@ -59,30 +66,30 @@ namespace gpstk
 
          /// Default constructor
       EpochDataStore()
-         : initialTime(CommonTime::END_OF_TIME),
+         : width(0), uniform(false), step(0.0),
+           initialTime(CommonTime::END_OF_TIME),
            finalTime(CommonTime::BEGINNING_OF_TIME),
-           interPoints(10)
+           interPoints(10), lastValid(false), lastIndex(0)
       {}
 
       EpochDataStore(int interpolationPoints)
-         : initialTime(CommonTime::END_OF_TIME),
+         : width(0), uniform(false), step(0.0),
+         initialTime(CommonTime::END_OF_TIME),
          finalTime(CommonTime::BEGINNING_OF_TIME),
-         interPoints(interpolationPoints)
+         interPoints(interpolationPoints), lastValid(false), lastIndex(0)
       {}
 
          /// Default deconstructor
       virtual ~EpochDataStore()
-      { allData.clear(); }
+      { clear(); }
          
          /// get epoch list stored in this object
       EpochList epochList();
 
-      bool isEpochExist(CommonTime t)
-      { return (allData.find(t) != allData.end()) ? true : false ; }
+      bool isEpochExist(CommonTime t);
       
          /// clear the all the data
-      void clear()
-      { allData.clear(); }
+      void clear();
 
          /** Edit the dataset, removing data outside the indicated time
           *  interval.
@@ -95,7 +102,7 @@ namespace gpstk
 
          /// return the number of entries in the store
       size_t size(void)
-      { return allData.size(); }
+      { return epochs.size(); }
 
          /** Determine the earliest time stored in the object 
           *
@@ -116,13 +123,22 @@ namespace gpstk
 
 
       EpochDataStore& setInterpolationPoints(const int& n)
-      { interPoints = n; return (*this); }
+      { interPoints = n; lastValid = false; return (*this); }
+
+
+         /// Return true if the epochs are equally spaced
+      bool isUniform() const
+      { return uniform; }
 
 
    protected:
 
-         /// Add to the store directly
-      void addData(const CommonTime& time,const std::vector<double>& data);
+         /** Add to the store directly
+          *  @throw InvalidRequest if the size of the data differs from
+          *     that of the data already stored.
+          */
+      void addData(const CommonTime& time,const std::vector<double>& data)
+         throw(InvalidRequest);
 
 
          /** Get the Data at the given epoch and return it.
@@ -134,9 +150,27 @@ namespace gpstk
       std::vector<double> getData(const CommonTime& t) const
          throw(InvalidRequest);
 
+
+         /** Get the Data at the given epoch into a vector, which is
+          *  resized if needed.
+          *  @param t CommonTime at which to compute the data.
+          *  @param data Data at time t.
+          *  @throw InvalidRequest if t is out of the span of the store.
+          */
+      void getData(const CommonTime& t, std::vector<double>& data) const
+         throw(InvalidRequest);
+
       
-         /// Object holding all the data for the vehicle
-      EpochData allData;
+         /// Epochs of the data, sorted
+      std::vector<CommonTime> epochs;
+
+         /// Data of all the epochs, 'width' values per epoch
+      std::vector<double> values;
+      size_t width;
+
+         /// Whether the epochs are equally spaced, and their spacing
+      bool uniform;
+      double step;
          
          /// These give the overall span of time for which this object
          ///  contains data.
@@ -146,6 +180,23 @@ namespace gpstk
          /// Number of points to do Lagrange Interpolation, default is 10
       int interPoints;
 
+
+   private:
+
+         /// Index of the first epoch not before t
+      size_t findIndex(const CommonTime& t) const;
+
+         /// Recompute the time span and spacing after the epochs changed
+      void updateEpochs();
+
+         /// Last time asked for, the index found for it and its data. They
+         /// are shared by all the threads, and only used in critical
+         /// sections.
+      mutable bool lastValid;
+      mutable CommonTime lastTime;
+      mutable size_t lastIndex;
+      mutable std::vector<double> lastData;
+
    }; // End of class 'EpochDataStore'
 
       // @}
@@ -35,14 +35,34 @@ namespace vdraw
     if (buf == 0 || len == 0)
       return;
 
-    // Go in order...
-    for(unsigned int i=0;i<len;i++)
+    const unsigned char* p = reinterpret_cast<const unsigned char*>(buf);
+
+    // The sums are reduced once per block: 5552 is the largest number of
+    // bytes for which b can't overflow 32 bits.
+    while(len)
     {
-      a = (a+(((int)buf[i])&0x000000FF)) % mod;
-      b = (b+a) % mod;
+      unsigned int n = (len < 5552 ? len : 5552);
+      len -= n;
+
+      for(; n >= 8; n -= 8, p += 8)
+      {
+        a += p[0]; b += a;
+        a += p[1]; b += a;
+        a += p[2]; b += a;
+        a += p[3]; b += a;
+        a += p[4]; b += a;
+        a += p[5]; b += a;
+        a += p[6]; b += a;
+        a += p[7]; b += a;
+      }
+      for(; n; n--, p++)
+      {
+        a += *p; b += a;
+      }
+
+      a %= mod;
+      b %= mod;
     }
   }
 
 } // namespace vdraw
-
-
@@ -89,14 +89,49 @@ namespace vdraw
     0x2d02ef8d
   };
 
+  namespace
+  {
+    // Tables of the slicing-by-8 algorithm: t[k][i] is the CRC of byte i
+    // followed by k zero bytes.
+    struct SliceTables
+    {
+      unsigned int t[8][256];
+
+      SliceTables(const unsigned int* base)
+      {
+        for(int i=0; i<256; i++)
+          t[0][i] = base[i];
+        for(int k=1; k<8; k++)
+          for(int i=0; i<256; i++)
+            t[k][i] = (t[k-1][i] >> 8) ^ base[t[k-1][i] & 0xff];
+      }
+    };
+  }
+
   void CRC32::update(const char* buf, unsigned int len)
   {
     if (buf == 0 || len == 0) return;
-    
-    for (unsigned int i=0; i < len; i++) 
-      crc32 = (crc32 >> 8) ^ crc_table[(crc32 ^ buf[i]) & 0xff];
-  }
 
-} // namespace vdraw
+    static const SliceTables slices(crc_table);
+    const unsigned int (*t)[256] = slices.t;
+    const unsigned char* p = reinterpret_cast<const unsigned char*>(buf);
+    unsigned int c = crc32;
+
+    // Eight bytes at a time, read one by one so it doesn't depend on the
+    // byte order of the host
+    for (; len >= 8; len -= 8, p += 8)
+    {
+      c ^= (unsigned int)p[0] | ((unsigned int)p[1] << 8) |
+           ((unsigned int)p[2] << 16) | ((unsigned int)p[3] << 24);
+      c = t[7][c & 0xff] ^ t[6][(c >> 8) & 0xff] ^
+          t[5][(c >> 16) & 0xff] ^ t[4][c >> 24] ^
+          t[3][p[4]] ^ t[2][p[5]] ^ t[1][p[6]] ^ t[0][p[7]];
+    }
 
+    for (; len; len--, p++)
+      c = (c >> 8) ^ crc_table[(c ^ *p) & 0xff];
 
+    crc32 = c;
+  }
+
+} // namespace vdraw
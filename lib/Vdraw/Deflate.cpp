@@ -0,0 +1,521 @@
+#pragma ident "$Id$"
+
+/// @file Deflate.cpp Used to compress a sequence of bytes with the deflate
+/// format. Class definitions.
+
+//============================================================================
+//
+//  This file is part of GPSTk, the GPS Toolkit.
+//
+//  The GPSTk is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU Lesser General Public License as published
+//  by the Free Software Foundation; either version 2.1 of the License, or
+//  any later version.
+//
+//  The GPSTk is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU Lesser General Public License for more details.
+//
+//  You should have received a copy of the GNU Lesser General Public
+//  License along with GPSTk; if not, write to the Free Software Foundation,
+//  Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110, USA
+//
+//  Copyright 2004, The University of Texas at Austin
+//
+//============================================================================
+
+//http://www.ietf.org/rfc/rfc1951.txt
+
+#include <vector>
+#include <algorithm>
+
+#include "Deflate.hpp"
+
+namespace vdraw
+{
+  namespace
+  {
+    /// Size of the window matches are looked for in
+    const unsigned int window = 32768;
+
+    /// Number of bits of the hash of three bytes
+    const int hash_bits = 15;
+
+    /// Shortest and longest matches
+    const unsigned int min_match = 3;
+    const unsigned int max_match = 258;
+
+    /// Length of a match good enough to stop looking for a longer one
+    const unsigned int nice_match = 128;
+
+    /// Number of symbols in a block
+    const unsigned int block_symbols = 16384;
+
+    /// Base and extra bits of the length codes 257 to 285
+    const unsigned int len_base[29] =
+    {
+      3, 4, 5, 6, 7, 8, 9, 10, 11, 13, 15, 17, 19, 23, 27, 31,
+      35, 43, 51, 59, 67, 83, 99, 115, 131, 163, 195, 227, 258
+    };
+    const int len_extra[29] =
+    {
+      0, 0, 0, 0, 0, 0, 0, 0, 1, 1, 1, 1, 2, 2, 2, 2,
+      3, 3, 3, 3, 4, 4, 4, 4, 5, 5, 5, 5, 0
+    };
+
+    /// Base and extra bits of the distance codes 0 to 29
+    const unsigned int dist_base[30] =
+    {
+      1, 2, 3, 4, 5, 7, 9, 13, 17, 25, 33, 49, 65, 97, 129, 193,
+      257, 385, 513, 769, 1025, 1537, 2049, 3073, 4097, 6145,
+      8193, 12289, 16385, 24577
+    };
+    const int dist_extra[30] =
+    {
+      0, 0, 0, 0, 1, 1, 2, 2, 3, 3, 4, 4, 5, 5, 6, 6,
+      7, 7, 8, 8, 9, 9, 10, 10, 11, 11, 12, 12, 13, 13
+    };
+
+    /// Order the code length code lengths are written in
+    const int cl_order[19] =
+    {
+      16, 17, 18, 0, 8, 7, 9, 6, 10, 5, 11, 4, 12, 3, 13, 2, 14, 1, 15
+    };
+
+    /// A literal (dist is zero) or a match
+    struct Symbol
+    {
+      unsigned short litlen;
+      unsigned short dist;
+      Symbol(unsigned int l, unsigned int d) : litlen(l), dist(d) {}
+    };
+
+    /// Writes bits least significant first, as deflate wants
+    class BitWriter
+    {
+      public:
+        BitWriter(std::string& o) : out(o), bits(0), count(0) {}
+
+        /// Write the n (at most 16) low bits of value
+        inline void put(unsigned int value, int n)
+        {
+          bits |= value << count;
+          count += n;
+          while(count >= 8)
+          {
+            out += (char)(bits & 0xff);
+            bits >>= 8;
+            count -= 8;
+          }
+        }
+
+        /// Pad to a byte boundary
+        inline void align()
+        {
+          if(count > 0)
+            put(0, 8-count);
+        }
+
+        std::string& out;
+        unsigned int bits;
+        int count;
+    };
+
+    inline int lenCode(unsigned int len)
+    {
+      return std::upper_bound(len_base, len_base+29, len) - len_base - 1;
+    }
+
+    inline int distCode(unsigned int dist)
+    {
+      return std::upper_bound(dist_base, dist_base+30, dist) - dist_base - 1;
+    }
+
+    inline unsigned int hash(const unsigned char* p)
+    {
+      unsigned int v = p[0] | (p[1] << 8) | (p[2] << 16);
+      return (v * 2654435761u) >> (32 - hash_bits);
+    }
+
+    /**
+     * Huffman code lengths of at most maxBits for these frequencies. The
+     * frequencies are halved until the lengths fit. A single used symbol
+     * gets a companion so the code is complete.
+     */
+    void buildLengths(const std::vector<unsigned int>& freq, int maxBits,
+        std::vector<int>& lens)
+    {
+      int n = freq.size();
+      lens.assign(n, 0);
+
+      std::vector< std::pair<unsigned int,int> > leaves;
+      for(int i=0; i<n; i++)
+        if(freq[i])
+          leaves.push_back(std::make_pair(freq[i], i));
+
+      int m = leaves.size();
+      if(m == 0)
+        return;
+      if(m == 1)
+      {
+        lens[leaves[0].second] = 1;
+        lens[leaves[0].second == 0 ? 1 : 0] = 1;
+        return;
+      }
+
+      std::vector<unsigned long> weight(2*m-1);
+      std::vector<int> left(2*m-1), right(2*m-1), depth(2*m-1);
+      for(;;)
+      {
+        std::sort(leaves.begin(), leaves.end());
+        for(int i=0; i<m; i++)
+          weight[i] = leaves[i].first;
+
+        // Two queues: the sorted leaves and the nodes, made in order of
+        // weight
+        int i = 0, j = m;
+        for(int k=m; k<2*m-1; k++)
+        {
+          int a = (i<m && (j>=k || weight[i]<=weight[j])) ? i++ : j++;
+          int b = (i<m && (j>=k || weight[i]<=weight[j])) ? i++ : j++;
+          left[k] = a;
+          right[k] = b;
+          weight[k] = weight[a] + weight[b];
+        }
+
+        int maxDepth = 0;
+        depth[2*m-2] = 0;
+        for(int k=2*m-2; k>=m; k--)
+        {
+          depth[left[k]] = depth[right[k]] = depth[k] + 1;
+          maxDepth = std::max(maxDepth, depth[k] + 1);
+        }
+
+        if(maxDepth <= maxBits)
+          break;
+
+        for(int k=0; k<m; k++)
+          leaves[k].first = (leaves[k].first + 1) / 2;
+      }
+
+      for(int i=0; i<m; i++)
+        lens[leaves[i].second] = depth[i];
+    }
+
+    /// Canonical codes for these lengths, bit reversed for writing
+    void buildCodes(const std::vector<int>& lens,
+        std::vector<unsigned int>& codes)
+    {
+      int count[16] = { 0 };
+      for(size_t i=0; i<lens.size(); i++)
+        count[lens[i]]++;
+      count[0] = 0;
+
+      unsigned int next[16];
+      unsigned int code = 0;
+      for(int bits=1; bits<16; bits++)
+      {
+        code = (code + count[bits-1]) << 1;
+        next[bits] = code;
+      }
+
+      codes.assign(lens.size(), 0);
+      for(size_t i=0; i<lens.size(); i++)
+      {
+        int len = lens[i];
+        if(!len)
+          continue;
+        unsigned int c = next[len]++;
+        unsigned int r = 0;
+        for(int k=0; k<len; k++, c>>=1)
+          r = (r << 1) | (c & 1);
+        codes[i] = r;
+      }
+    }
+
+    /// Write the symbols of a block and its end with these codes
+    void writeSymbols(BitWriter& bw, const std::vector<Symbol>& syms,
+        const std::vector<unsigned int>& litCodes,
+        const std::vector<int>& litLens,
+        const std::vector<unsigned int>& distCodes,
+        const std::vector<int>& distLens)
+    {
+      for(size_t i=0; i<syms.size(); i++)
+      {
+        const Symbol& s = syms[i];
+        if(!s.dist)
+        {
+          bw.put(litCodes[s.litlen], litLens[s.litlen]);
+          continue;
+        }
+        int lc = lenCode(s.litlen);
+        bw.put(litCodes[257+lc], litLens[257+lc]);
+        if(len_extra[lc])
+          bw.put(s.litlen - len_base[lc], len_extra[lc]);
+        int dc = distCode(s.dist);
+        bw.put(distCodes[dc], distLens[dc]);
+        if(dist_extra[dc])
+          bw.put(s.dist - dist_base[dc], dist_extra[dc]);
+      }
+      bw.put(litCodes[256], litLens[256]);
+    }
+
+    /// Write a block, choosing the smallest of the three types
+    void writeBlock(BitWriter& bw, const std::vector<Symbol>& syms,
+        const unsigned char* raw, unsigned int rawLen, bool final)
+    {
+      std::vector<unsigned int> litFreq(286, 0), distFreq(30, 0);
+      unsigned long extraBits = 0;
+      litFreq[256] = 1;
+      for(size_t i=0; i<syms.size(); i++)
+      {
+        const Symbol& s = syms[i];
+        if(!s.dist)
+        {
+          litFreq[s.litlen]++;
+          continue;
+        }
+        int lc = lenCode(s.litlen);
+        int dc = distCode(s.dist);
+        litFreq[257+lc]++;
+        distFreq[dc]++;
+        extraBits += len_extra[lc] + dist_extra[dc];
+      }
+
+      // Dynamic codes, and their code lengths, run length encoded
+      std::vector<int> litLens, distLens;
+      buildLengths(litFreq, 15, litLens);
+      buildLengths(distFreq, 15, distLens);
+
+      int hlit = 286;
+      while(hlit > 257 && !litLens[hlit-1])
+        hlit--;
+      int hdist = 30;
+      while(hdist > 1 && !distLens[hdist-1])
+        hdist--;
+
+      std::vector<int> all(litLens.begin(), litLens.begin()+hlit);
+      all.insert(all.end(), distLens.begin(), distLens.begin()+hdist);
+
+      std::vector< std::pair<int,int> > rle;
+      for(size_t i=0; i<all.size(); )
+      {
+        int v = all[i];
+        size_t r = 1;
+        while(i+r < all.size() && all[i+r] == v)
+          r++;
+        i += r;
+        if(v == 0)
+        {
+          while(r >= 11)
+          {
+            size_t n = std::min(r, (size_t)138);
+            rle.push_back(std::make_pair(18, (int)n-11));
+            r -= n;
+          }
+          if(r >= 3)
+          {
+            rle.push_back(std::make_pair(17, (int)r-3));
+            r = 0;
+          }
+        }
+        else
+        {
+          rle.push_back(std::make_pair(v, 0));
+          r--;
+          while(r >= 3)
+          {
+            size_t n = std::min(r, (size_t)6);
+            rle.push_back(std::make_pair(16, (int)n-3));
+            r -= n;
+          }
+        }
+        for(; r; r--)
+          rle.push_back(std::make_pair(v, 0));
+      }
+
+      std::vector<unsigned int> clFreq(19, 0);
+      for(size_t i=0; i<rle.size(); i++)
+        clFreq[rle[i].first]++;
+      std::vector<int> clLens;
+      buildLengths(clFreq, 7, clLens);
+      int hclen = 19;
+      while(hclen > 4 && !clLens[cl_order[hclen-1]])
+        hclen--;
+
+      unsigned long dynBits = 3 + 14 + 3*hclen + extraBits;
+      for(int i=0; i<19; i++)
+        dynBits += (unsigned long)clFreq[i]*clLens[i];
+      dynBits += 2*clFreq[16] + 3*clFreq[17] + 7*clFreq[18];
+
+      // Fixed codes
+      static std::vector<int> fixLitLens, fixDistLens;
+      static std::vector<unsigned int> fixLitCodes, fixDistCodes;
+      if(fixLitLens.empty())
+      {
+        fixLitLens.assign(288, 8);
+        std::fill(fixLitLens.begin()+144, fixLitLens.begin()+256, 9);
+        std::fill(fixLitLens.begin()+256, fixLitLens.begin()+280, 7);
+        fixDistLens.assign(30, 5);
+        buildCodes(fixLitLens, fixLitCodes);
+        buildCodes(fixDistLens, fixDistCodes);
+      }
+
+      unsigned long fixBits = 3 + extraBits;
+      for(int i=0; i<286; i++)
+      {
+        dynBits += (unsigned long)litFreq[i]*litLens[i];
+        fixBits += (unsigned long)litFreq[i]*fixLitLens[i];
+      }
+      for(int i=0; i<30; i++)
+      {
+        dynBits += (unsigned long)distFreq[i]*distLens[i];
+        fixBits += (unsigned long)distFreq[i]*5;
+      }
+
+      // Stored, in pieces of at most 0xFFFF bytes
+      unsigned long pieces = rawLen/0xFFFF + (rawLen%0xFFFF || !rawLen ? 1 : 0);
+      unsigned long storedBits = pieces*(3+7+32) + 8*(unsigned long)rawLen;
+
+      if(storedBits <= dynBits && storedBits <= fixBits)
+      {
+        unsigned int pos = 0;
+        do
+        {
+          unsigned int n = std::min(rawLen-pos, 0xFFFFu);
+          bw.put((final && pos+n == rawLen) ? 1 : 0, 1);
+          bw.put(0, 2);
+          bw.align();
+          bw.put(n, 16);
+          bw.put(~n & 0xFFFF, 16);
+          bw.out.append(reinterpret_cast<const char*>(raw+pos), n);
+          pos += n;
+        } while(pos < rawLen);
+      }
+      else if(fixBits <= dynBits)
+      {
+        bw.put(final ? 1 : 0, 1);
+        bw.put(1, 2);
+        writeSymbols(bw, syms, fixLitCodes, fixLitLens,
+            fixDistCodes, fixDistLens);
+      }
+      else
+      {
+        std::vector<unsigned int> litCodes, distCodes, clCodes;
+        buildCodes(litLens, litCodes);
+        buildCodes(distLens, distCodes);
+        buildCodes(clLens, clCodes);
+
+        bw.put(final ? 1 : 0, 1);
+        bw.put(2, 2);
+        bw.put(hlit-257, 5);
+        bw.put(hdist-1, 5);
+        bw.put(hclen-4, 4);
+        for(int i=0; i<hclen; i++)
+          bw.put(clLens[cl_order[i]], 3);
+        for(size_t i=0; i<rle.size(); i++)
+        {
+          int s = rle[i].first;
+          bw.put(clCodes[s], clLens[s]);
+          if(s == 16) bw.put(rle[i].second, 2);
+          else if(s == 17) bw.put(rle[i].second, 3);
+          else if(s == 18) bw.put(rle[i].second, 7);
+        }
+        writeSymbols(bw, syms, litCodes, litLens, distCodes, distLens);
+      }
+    }
+  }
+
+  std::auto_ptr<std::string> Deflate::compress(const std::string &str)
+  {
+    return compress(str.data(), str.length());
+  }
+
+  std::auto_ptr<std::string> Deflate::compress(const char* buf,
+      unsigned int len)
+  {
+    std::auto_ptr<std::string> out(new std::string);
+    out->reserve(len/4 + 64);
+    BitWriter bw(*out);
+
+    const unsigned char* p = reinterpret_cast<const unsigned char*>(buf);
+
+    // Most recent position of each hash, and the previous position with
+    // the same hash of each position in the window
+    std::vector<int> head(1 << hash_bits, -1);
+    std::vector<int> prev(window, -1);
+
+    std::vector<Symbol> syms;
+    syms.reserve(block_symbols);
+    unsigned int blockStart = 0;
+    unsigned int pos = 0;
+
+    while(pos < len)
+    {
+      unsigned int bestLen = 0, bestDist = 0;
+      if(pos + min_match <= len)
+      {
+        unsigned int h = hash(p+pos);
+        unsigned int maxLen = std::min(max_match, len-pos);
+        int cand = head[h];
+        for(int chain=max_chain; cand>=0 && chain>0; chain--)
+        {
+          unsigned int dist = pos - cand;
+          if(dist > window)
+            break;
+          if(p[cand+bestLen] == p[pos+bestLen])
+          {
+            unsigned int l = 0;
+            while(l < maxLen && p[cand+l] == p[pos+l])
+              l++;
+            if(l > bestLen)
+            {
+              bestLen = l;
+              bestDist = dist;
+              if(l >= nice_match || l == maxLen)
+                break;
+            }
+          }
+          int next = prev[cand & (window-1)];
+          if(next >= cand)
+            break;
+          cand = next;
+        }
+        prev[pos & (window-1)] = head[h];
+        head[h] = pos;
+      }
+
+      if(bestLen >= min_match)
+      {
+        syms.push_back(Symbol(bestLen, bestDist));
+        // The positions inside the match may start later matches
+        for(unsigned int k=pos+1; k<pos+bestLen && k+min_match<=len; k++)
+        {
+          unsigned int h = hash(p+k);
+          prev[k & (window-1)] = head[h];
+          head[h] = k;
+        }
+        pos += bestLen;
+      }
+      else
+      {
+        syms.push_back(Symbol(p[pos], 0));
+        pos++;
+      }
+
+      if(syms.size() >= block_symbols && pos < len)
+      {
+        writeBlock(bw, syms, p+blockStart, pos-blockStart, false);
+        syms.clear();
+        blockStart = pos;
+      }
+    }
+
+    writeBlock(bw, syms, p+blockStart, pos-blockStart, true);
+    bw.align();
+
+    return out;
+  }
+
+} // namespace vdraw
@@ -0,0 +1,79 @@
+#pragma ident "$Id$"
+
+/// @file Deflate.hpp Used to compress a sequence of bytes with the deflate
+/// format. Class declarations.
+
+//============================================================================
+//
+//  This file is part of GPSTk, the GPS Toolkit.
+//
+//  The GPSTk is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU Lesser General Public License as published
+//  by the Free Software Foundation; either version 2.1 of the License, or
+//  any later version.
+//
+//  The GPSTk is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU Lesser General Public License for more details.
+//
+//  You should have received a copy of the GNU Lesser General Public
+//  License along with GPSTk; if not, write to the Free Software Foundation,
+//  Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110, USA
+//
+//  Copyright 2004, The University of Texas at Austin
+//
+//============================================================================
+
+
+#ifndef VDRAW_DEFLATE_H
+#define VDRAW_DEFLATE_H
+
+#include <string>
+#include <memory>
+
+//http://www.ietf.org/rfc/rfc1951.txt
+
+namespace vdraw
+{
+  /** \addtogroup BasicVectorGraphics */
+  //@{
+
+  /**
+   * This class is used to compress a sequence of bytes to a raw deflate
+   * stream (RFC 1951), as found in zlib streams and PNG images.
+   *
+   * Repeated strings are found with hash chains over a 32 KB window, and
+   * each block is written with dynamic Huffman codes, the fixed codes or
+   * stored, whichever is smallest, so the stream is never much larger than
+   * the data.
+   */
+  class Deflate
+  {
+    public:
+      /// Longest hash chain followed when looking for a match
+      static const int max_chain = 64;
+
+      /**
+       * Compress a string.
+       * @param str The bytes to compress
+       * @return The deflate stream, ending with a final block
+       */
+      static std::auto_ptr<std::string> compress(const std::string &str);
+
+      /**
+       * Compress an array of bytes.
+       * @param buf The bytes to compress
+       * @param len The number of bytes
+       * @return The deflate stream, ending with a final block
+       */
+      static std::auto_ptr<std::string> compress(const char* buf,
+          unsigned int len);
+
+  }; // class Deflate
+
+  //@}
+
+} // namespace vdraw
+
+#endif //VDRAW_DEFLATE_H
@@ -131,6 +131,7 @@ namespace vdraw
 
   int PNG::cost_idat(int stream)
   {
+    // As if the stream were stored, which bounds the compressed size
     int i = stream;
     // Huffman bits, 5 per 0xFFFF and 5 for whats left
     i += 5*((stream>>16) + (stream&0xFFFF?1:0));
@@ -211,7 +212,7 @@ namespace vdraw
     std::stringstream s;
     string_ptr tmp = data(c,osr,osc);
     unsigned int a = alder(tmp);
-    s << *huff(*tmp)
+    s << *Deflate::compress(*tmp)
       << *itos(a);
     tmp = string_ptr(new std::string(s.str()));
     return split(*prefix(*tmp));
@@ -222,7 +223,7 @@ namespace vdraw
     std::stringstream s;
     string_ptr tmp = data(c,osr,osc);
     unsigned int a = alder(tmp);
-    s << *huff(*tmp)
+    s << *Deflate::compress(*tmp)
       << *itos(a);
     tmp = string_ptr(new std::string(s.str()));
     return split(*prefix(*tmp));
@@ -252,94 +253,60 @@ namespace vdraw
 
   PNG::string_ptr PNG::prefix(const std::string &str)
   {
-    // TODO There are limits to IDAT length...check and split
-    int len = str.size();
-    int cmp = (int)(log((double)len)/log(2.0))-8;
-    if(cmp<0) cmp = 0;
-    else if(cmp>7) cmp = 7;
-    cmp = (cmp<<4) | 0x08;
+    // The deflate stream may refer back up to 32 KB, the largest window
+    int cmp = (7<<4) | 0x08;
     int flg = 0;
     int tmp = (cmp*256+flg)%31;
     if(tmp!=0) flg += 31-tmp;
     std::stringstream s;
-    // TODO ZLIB data stream...? Adler-32
     s << btoc(cmp)          // See CMP notes above
       << btoc(flg)          // Flag
       << str;
     return string_ptr(new std::string(s.str()));            
   }
 
-  PNG::string_ptr PNG::huff(const std::string &str)
-  {
-    // Add huff information
-    std::stringstream s;
-    int len = str.size();
-    int pos = 0;
-    do
-    {
-      //printf("huff() :: len=%08x pos=%08x\n",len,pos);          
-      int dist=0;
-      if(len>0x0FFFF)
-        dist = 0x0FFFF;
-      else
-        dist = len;
-      len -= dist;
-
-      // These go backwards
-      s << btoc((len?0x00:0x01)) // Set final bit on last block
-        << btoc(dist) 
-        << btoc(dist>>8)
-        << btoc(~dist)
-        << btoc((~dist)>>8)
-        << str.substr(pos,dist);
-
-      pos += dist;
-    } while(len);
-    return string_ptr(new std::string(s.str()));            
-  }
-
   PNG::string_ptr PNG::data(const ColorMap &c, int osr, int osc)
   {
     // For oversampling, we make a row buffer and a column one and repeat as
     // necessary to create the image.
-    std::stringstream s;
+    string_ptr s(new std::string);
+    s->reserve((size_t)c.getRows()*osr*(3*c.getCols()*osc+1));
+    std::string rstr;
     for(int row=0; row<c.getRows(); row++)
     {
-      std::stringstream r;
-      r << btoc(0x00);   // Filter method 0 (identity)
+      rstr.assign(1,btoc(0x00));   // Filter method 0 (identity)
       for(int col=0; col<c.getCols(); col++)
       {
-        string_ptr t = ctos(c.get(row,col));
-        for(int cc=0; cc<osc; cc++) 
-          r << *t;
+        unsigned int l = c.get(row,col).getRGB();
+        for(int cc=0; cc<osc; cc++)
+        {
+          rstr += btoc(l>>16);
+          rstr += btoc(l>>8);
+          rstr += btoc(l);
+        }
       }
-      std::string rstr = r.str();
       for(int rr=0; rr<osr; rr++) 
-        s << rstr;
+        *s += rstr;
     }
-    return string_ptr(new std::string(s.str()));            
+    return s;
   }
 
   PNG::string_ptr PNG::data(const InterpolatedColorMap &c, int osr, int osc)
   {
     // For oversampling, we make a row buffer and a column one and repeat as
     // necessary to create the image.
-    std::stringstream s;
+    string_ptr s(new std::string);
+    s->reserve((size_t)c.getRows()*osr*(c.getCols()*osc+1));
+    std::string rstr;
     for(int row=0; row<c.getRows(); row++)
     {
-      std::stringstream r;
-      r << btoc(0x00);   // Filter method 0 (no filter)
+      rstr.assign(1,btoc(0x00));   // Filter method 0 (no filter)
       for(int col=0; col<c.getCols(); col++)
-      {
-        char t = btoc((int)(c.getIndex(row,col)*255));
-        for(int cc=0; cc<osc; cc++) 
-          r << t;
-      }
-      std::string rstr = r.str();      
+        rstr.append(osc,btoc((int)(c.getIndex(row,col)*255)));
       for(int rr=0; rr<osr; rr++) 
-        s << rstr;
+        *s += rstr;
     }
-    return string_ptr(new std::string(s.str()));            
+    return s;
   }
 
 
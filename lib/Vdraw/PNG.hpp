@@ -40,6 +40,7 @@
 #include "Palette.hpp"
 #include "CRC32.hpp"
 #include "Adler32.hpp"
+#include "Deflate.hpp"
 
 namespace vdraw
 {
@@ -90,7 +91,8 @@ namespace vdraw
       /// PNG file format header bytes 
       static const std::string header;
 
-      /// Get the cost for IDAT chunks for a stream of this length
+      /// Get the cost for IDAT chunks for a stream of this length, stored
+      /// (an upper bound of the compressed cost)
       static int cost_idat(int stream);
 
       /// IHDR Chunk for full color maps
@@ -133,9 +135,6 @@ namespace vdraw
       /// Add the IDAT prefix bytes for the zlib stream
       static string_ptr prefix(const std::string &str);
 
-      /// Add the segment bits for the huffman format (non compressed)
-      static string_ptr huff(const std::string &str);
-
       /// Get the color data for a full color map
       static string_ptr data(const ColorMap &c, int osr, int osc);
 
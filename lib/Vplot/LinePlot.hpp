@@ -95,6 +95,12 @@ namespace vplot
         sl.addSeries(label,series,ss);
       }
 
+      /// Set the size of the cells the series are decimated to (see SeriesList)
+      inline void setResolution(double res)
+      {
+        sl.setResolution(res);
+      }
+
       /// Draw the Plot to this frame, with the key on the dir side
       inline void draw(Frame& frame, int dir)
       {
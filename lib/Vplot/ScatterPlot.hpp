@@ -78,6 +78,12 @@ namespace vplot
         sl.addSeries(label,series,m);
       }
 
+      /// Set the size of the cells the series are decimated to (see SeriesList)
+      inline void setResolution(double res)
+      {
+        sl.setResolution(res);
+      }
+
       /// Draw the Plot to this frame
       inline void drawPlot(Frame& frame)
       {
@@ -77,7 +77,11 @@ namespace vplot
         continue;
       }
 
-      vector< pair<double,double> >& vec = getPointList(i);
+      // Only keep what the frame can show
+      vector< pair<double,double> > vec;
+      decimate(getPointList(i),vec,!s.getColor().isClear(),
+          !m.getColor().isClear(),minX,maxX,minY,maxY,
+          innerFrame.getWidth(),innerFrame.getHeight());
       Path curve(vec,innerFrame.lx(), innerFrame.ly());
 
       // What I'd give for a line of haskell...
@@ -116,6 +120,127 @@ namespace vplot
     }
   }
 
+  void SeriesList::decimate(const vector< pair<double,double> >& in,
+      vector< pair<double,double> >& out, bool lines, bool markers,
+      double minX, double maxX, double minY, double maxY,
+      double width, double height) const
+  {
+    // Size of the grid of cells
+    double fcols = (resolution > 0 ? width/resolution : 0);
+    double frows = (resolution > 0 ? height/resolution : 0);
+
+    // A scatter plot marks the cells it has used, so a resolution too fine
+    // for the frame isn't worth the memory.
+    if(fcols < 1 || frows < 1 || maxX <= minX || maxY <= minY ||
+        (!lines && fcols*frows > 16777216.0))
+    {
+      out = in;
+      return;
+    }
+
+    long cols = (long)fcols;
+    long rows = (long)frows;
+    double multX = cols/(maxX-minX);
+    double multY = rows/(maxY-minY);
+
+    out.clear();
+    out.reserve(lines ? std::min((double)in.size(),4.0*cols+16) : in.size());
+
+    if(!lines)
+    {
+      // Scatter: the first point of each cell
+      vector<bool> used(cols*rows,false);
+      for(size_t k=0; k<in.size(); k++)
+      {
+        double x = in[k].first;
+        double y = in[k].second;
+        if(!(x>=minX && x<=maxX && y>=minY && y<=maxY))
+        {
+          out.push_back(in[k]);
+          continue;
+        }
+        long c = std::min((long)(multX*(x-minX)),cols-1);
+        long r = std::min((long)(multY*(y-minY)),rows-1);
+        if(!used[c*rows+r])
+        {
+          used[c*rows+r] = true;
+          out.push_back(in[k]);
+        }
+      }
+      return;
+    }
+
+    if(markers)
+    {
+      // Line with markers: drop a point in the same cell as the previous
+      // one, which moves neither the line nor the markers by a cell
+      long lastCell = -1;
+      for(size_t k=0; k<in.size(); k++)
+      {
+        double x = in[k].first;
+        double y = in[k].second;
+        if(!(x>=minX && x<=maxX && y>=minY && y<=maxY))
+        {
+          lastCell = -1;
+          out.push_back(in[k]);
+          continue;
+        }
+        long c = std::min((long)(multX*(x-minX)),cols-1);
+        long r = std::min((long)(multY*(y-minY)),rows-1);
+        if(c*rows+r != lastCell)
+        {
+          lastCell = c*rows+r;
+          out.push_back(in[k]);
+        }
+      }
+      // Keep the end of the line where it was
+      if(!in.empty() && (out.empty() || out.back() != in.back()))
+        out.push_back(in.back());
+      return;
+    }
+
+    // Line: for each run of consecutive points in the same column, the
+    // first, lowest, highest and last ones, in their order.
+    long runCol = -1;
+    size_t first = 0, lo = 0, hi = 0, last = 0;
+    for(size_t k=0; k<=in.size(); k++)
+    {
+      bool inside = false;
+      long c = -1;
+      if(k < in.size())
+      {
+        double x = in[k].first;
+        double y = in[k].second;
+        inside = (x>=minX && x<=maxX && y>=minY && y<=maxY);
+        if(inside)
+          c = std::min((long)(multX*(x-minX)),cols-1);
+      }
+
+      if(runCol >= 0 && c == runCol)
+      {
+        if(in[k].second < in[lo].second) lo = k;
+        if(in[k].second > in[hi].second) hi = k;
+        last = k;
+        continue;
+      }
+
+      // The run ends here
+      if(runCol >= 0)
+      {
+        size_t idx[4] = { first, lo, hi, last };
+        std::sort(idx,idx+4);
+        for(int j=0; j<4; j++)
+          if(j == 0 || idx[j] != idx[j-1])
+            out.push_back(in[idx[j]]);
+      }
+
+      runCol = c;
+      first = lo = hi = last = k;
+      if(k < in.size() && !inside)
+        out.push_back(in[k]);
+    }
+  }
+
   void SeriesList::drawLegend(Frame& frame, double pointsize, unsigned int columns)
   {
     if(columns <= 1)
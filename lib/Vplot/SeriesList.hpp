@@ -57,7 +57,7 @@ namespace vplot
       /**
        * Constructor.
        */
-      SeriesList() 
+      SeriesList() : resolution(1.0)
       {
       }
 
@@ -165,6 +165,20 @@ namespace vplot
       /// Return the minimums and maximum of all the data.
       void findMinMax(double& minX, double &maxX, double& minY, double& maxY);
 
+      /**
+       * Set the size, in units of the frame, of the cells the points are
+       * decimated to when drawn. Within one column of cells a line only
+       * keeps the first, lowest, highest and last points of each run of
+       * consecutive points, and a scatter plot keeps one point per cell, so
+       * that long series cost what the frame can show. Points outside the
+       * axes limits are always kept. The default is one unit; zero or less
+       * draws every point.
+       */
+      void setResolution(double res) { resolution = res; }
+
+      /// Return the size of the decimation cells
+      double getResolution() const { return resolution; }
+
       /// Draw all of the series in innerFrame
       void drawInFrame(Frame& innerFrame, double minX, double maxX, double minY, double maxY);
 
@@ -192,6 +206,9 @@ namespace vplot
       /// List of markers indexed by number
       vector< Marker > markers;
 
+      /// Size of the decimation cells, in units of the frame
+      double resolution;
+
       /// This struct helps in translating coordinates for a set of points
       struct map_object
       {
@@ -210,6 +227,20 @@ namespace vplot
         }
       };
 
+      /**
+       * Decimate a series to the cells of the frame.
+       * @param in Points of the series
+       * @param out Points to draw, in the order of in
+       * @param lines Whether the points are joined by a line
+       * @param markers Whether a marker is drawn at each point
+       * @param width Width of the frame
+       * @param height Height of the frame
+       */
+      void decimate(const vector< pair<double,double> >& in,
+          vector< pair<double,double> >& out, bool lines, bool markers,
+          double minX, double maxX, double minY, double maxY,
+          double width, double height) const;
+
       /// Draw a segment of a legend from begin for n indexes
       void drawLegendSegment(Frame& frame, double pointsize, 
           unsigned int begin, unsigned int n);
@@ -27,6 +27,7 @@
 //
 //============================================================================
 
+#include <algorithm>
 #include "ARLambda.hpp"
 
 using namespace std;
@@ -50,34 +51,241 @@ namespace gpstk
 
       try
       {
+         const int n = static_cast<int>(ambFloat.size());
+
             // Initialize the 'ambFixed'
-         ambFixed.resize( ambFloat.size(), 0.0 );
+         ambFixed.resize( n, 0.0 );
+         fixedFlags.resize( n, false );
+         numFixed = 0;
 
             // squaredRatio initialization
          squaredRatio = 0.0;
 
+            // Covariance to factorize, decorrelated by the previous
+            // Z-transform if warm started
+         dim = n;
+         QC.resize( tri(n,0) );
+         if( warmStart && lastDim==n )
+         {
+               // T = Q*Z, then QC = Z'*T
+            std::vector<double> T(n*n, 0.0);
+            for(int j=0; j<n; j++)
+            {
+               const double* Zj = &lastZ[j*n];
+               double* Tj = &T[j*n];
+               for(int l=0; l<n; l++)
+               {
+                  if( Zj[l] == 0.0 ) continue;
+                  for(int k=0; k<n; k++) Tj[k] += ambCov(k,l) * Zj[l];
+               }
+            }
+            for(int i=0; i<n; i++)
+            {
+               const double* Zi = &lastZ[i*n];
+               for(int j=0; j<=i; j++)
+               {
+                  const double* Tj = &T[j*n];
+                  double sum(0.0);
+                  for(int k=0; k<n; k++) sum += Zi[k] * Tj[k];
+                  QC[tri(i,j)] = sum;
+               }
+            }
+            Z = lastZ;
+            W = lastW;
+            zc.resize(n);
+            for(int i=0; i<n; i++) zc[i] = i;
+         }
+         else
+         {
+            for(int i=0; i<n; i++)
+            {
+               for(int j=0; j<=i; j++) QC[tri(i,j)] = ambCov(i,j);
+            }
+            resetTransform();
+         }
+
             // Now, Let's solve the integer ambiguities with LAMBDA 
         
-         Matrix<double> F; 
-         Vector<double> S;
-         if( lambda(ambFloat,ambCov,F,S,2)==0 )
+         std::vector<double> af(n), F;
+         for(int i=0; i<n; i++) af[i] = ambFloat(i);
+
+         if( lambda(&af[0],F,2)==0 )
          {
                // Now, Let's get the fixed integer ambiguities
-            for(size_t i=0; i<ambFloat.size(); i++) 
+            for(int i=0; i<n; i++) 
             {
-               ambFixed(i) = F(i,0);
+               ambFixed(i) = F[i];
+               fixedFlags(i) = true;
             }
+            numFixed = n;
 
                // Now, get the ratio
-            squaredRatio = (S(0)<1e-12) ? 9999.9 : S(1)/S(0);
+            squaredRatio = (s[0]<1e-12) ? 9999.9 : s[1]/s[0];
+
+               // Keep the transform for the next call, unless it grew
+               // too large to be accurate
+            lastDim = 0;
+            if( warmStart )
+            {
+               double zmax(0.0);
+               for(size_t i=0; i<Z.size(); i++)
+               {
+                  zmax = std::max( zmax, std::fabs(Z[i]) );
+                  zmax = std::max( zmax, std::fabs(W[i]) );
+               }
+               if( zmax < 1.0e6 )
+               {
+                  saveTransform(lastZ, lastW);
+                  lastDim = n;
+               }
+            }
 
          }
          else
          {
 
+            lastDim = 0;
+
+            ARException e("Failed to resolve the integer ambiguities.");
+            GPSTK_THROW(e);
+
+         }
+
+      }
+      catch(Exception& e)
+      {
+
+         GPSTK_RETHROW(e);
+
+      }
+      catch (...)
+      {
+
+         ARException e("Failed to resolve the integer ambiguities.");
+         GPSTK_THROW(e);
+
+      }
+
+      return (*this);
+
+   }  // End of method 'ARLambda::resolve()'
+
+
+   ARLambda& ARLambda::resolvePartial( const Vector<double>& ambFloat,
+                                       const Matrix<double>& ambCov,
+                                       const std::vector<int>& dropOrder,
+                                       double minRatio,
+                                       int minFixed,
+                                       int minDropped )
+      throw(ARException)
+   {
+         // check input
+      if( ambFloat.size()!=ambCov.rows() || 
+          ambFloat.size()!=ambCov.cols() )
+      {
+
+         ARException e("The dimension of input does not match.");
+         GPSTK_THROW(e);
+
+      }
+
+      const int n = static_cast<int>(ambFloat.size());
+      const int nd = static_cast<int>(dropOrder.size());
+
+         // Order of the ambiguities: those to drop first, then the others
+      std::vector<int> perm;
+      std::vector<bool> used(n, false);
+      for(int i=0; i<nd; i++)
+      {
+         const int k( dropOrder[i] );
+         if( k<0 || k>=n || used[k] )
+         {
+            ARException e("Invalid order of the ambiguities to drop.");
+            GPSTK_THROW(e);
+         }
+         used[k] = true;
+         perm.push_back(k);
+      }
+      for(int k=0; k<n; k++)
+      {
+         if( !used[k] ) perm.push_back(k);
+      }
+
+      try
+      {
+         ambFixed = ambFloat;
+         fixedFlags.resize( n, false );
+         numFixed = 0;
+         squaredRatio = 0.0;
+
+         if( minFixed < 1 ) minFixed = 1;
+         if( minDropped < 1 ) minDropped = 1;
+
+         if( n < minFixed ) return (*this);
+
+            // Factorize the reordered covariance once: the factor of the
+            // last 'n-d' ambiguities is the trailing block of it
+         dim = n;
+         QC.resize( tri(n,0) );
+         for(int i=0; i<n; i++)
+         {
+            for(int j=0; j<=i; j++)
+            {
+               QC[tri(i,j)] = ambCov(perm[i],perm[j]);
+            }
+         }
+
+         if( factorize()!=0 )
+         {
             ARException e("Failed to resolve the integer ambiguities.");
             GPSTK_THROW(e);
+         }
+
+         const std::vector<double> LB(L), DB(D);
+
+         std::vector<double> af(n), F;
+         for(int i=0; i<n; i++) af[i] = ambFloat(perm[i]);
+
+         for( int d=0;
+              d<=nd && n-d>=minFixed;
+              d = (d==0) ? minDropped : d+1 )
+         {
+            const int k( n-d );
+
+            dim = k;
+            L.resize( tri(k,0) );
+            D.resize( k );
+            for(int i=0; i<k; i++)
+            {
+               const double* LBi = &LB[tri(i+d,d)];
+               double* Li = &L[tri(i,0)];
+               for(int j=0; j<=i; j++) Li[j] = LBi[j];
+               D[i] = DB[i+d];
+            }
+            resetTransform();
+
+            reduction();
+            transform(&af[d]);
 
+            if( search(2)!=0 )
+            {
+               ARException e("Failed to resolve the integer ambiguities.");
+               GPSTK_THROW(e);
+            }
+
+            squaredRatio = (s[0]<1e-12) ? 9999.9 : s[1]/s[0];
+
+            if( squaredRatio > minRatio )
+            {
+               backTransform(F,1);
+               for(int i=0; i<k; i++)
+               {
+                  ambFixed(perm[i+d]) = F[i];
+                  fixedFlags(perm[i+d]) = true;
+               }
+               numFixed = k;
+               break;
+            }
          }
 
       }
@@ -97,33 +305,34 @@ namespace gpstk
 
       return (*this);
 
-   }  // End of method 'ARMLambda::resolve()'
+   }  // End of method 'ARLambda::resolvePartial()'
 
    
-   int ARLambda::factorize( const Matrix<double>& Q, 
-                            Matrix<double>& L, 
-                            Vector<double>& D)
+   int ARLambda::factorize()
    {
-      // TODO: CHECK UNEXPECTED INPUT
-      // L:nxn Z:nxn 0<=(i,j)<n
+      // QC: packed nxn, L: packed nxn, D: n  with n = dim
 
-      const int n = static_cast<int>(Q.rows());
+      const int n = dim;
 
-      Matrix<double> QC(Q);
-      L.resize(n, n, 0.0);
-      D.resize(n, 0.0);
+      L.assign(tri(n,0), 0.0);
+      D.assign(n, 0.0);
 
       for(int i = n-1; i >= 0; i--) 
       {
-         D(i) = QC(i,i);
-         if( D(i) <= 0.0 ) return -1;
-         double temp = std::sqrt(D(i));
-         for(int j=0; j<=i; j++) L(i,j) = QC(i,j)/temp;
+         double* Li = &L[tri(i,0)];
+         const double* Qi = &QC[tri(i,0)];
+
+         D[i] = Qi[i];
+         if( D[i] <= 0.0 ) return -1;
+         double temp = std::sqrt(D[i]);
+         for(int j=0; j<=i; j++) Li[j] = Qi[j]/temp;
          for(int j=0; j<=i-1; j++) 
          {
-            for(int k=0; k<=j; k++) QC(j,k) -= L(i,k) * L(i,j);
+            double* Qj = &QC[tri(j,0)];
+            const double lij = Li[j];
+            for(int k=0; k<=j; k++) Qj[k] -= Li[k] * lij;
          }
-         for(int j=0; j<=i; j++) L(i,j) /= L(i,i);
+         for(int j=0; j<=i; j++) Li[j] /= Li[i];
       }
 
       return 0;
@@ -131,59 +340,60 @@ namespace gpstk
    }  // End of method 'ARLambda::factorize()'
 
 
-   void ARLambda::gauss(Matrix<double>& L, Matrix<double>& Z, int i, int j)
+   void ARLambda::gauss(int i, int j)
    {
-      //TODO: CHECK UNEXPECTED INPUT
-      // L:nxn Z:nxn 0<=(i,j)<n
+      // L: packed nxn, Z,W: nxn  0<=j<i<n
 
-      const int n = L.rows();
-      const int mu = (int)round(L(i,j));
+      const int n = dim;
+      const int mu = (int)round(L[tri(i,j)]);
       if(mu != 0) 
       {
-         for(int k=i; k<n; k++) L(k,j) -= (double)mu*L(k,i);
-         for(int k=0; k<n; k++) Z(k,j) -= (double)mu*Z(k,i);
+         for(int k=i; k<n; k++) L[tri(k,j)] -= (double)mu*L[tri(k,i)];
+
+            // Z(:,j) -= mu*Z(:,i), and so W(:,i) += mu*W(:,j)
+         double* Zi = &Z[zc[i]*n];
+         double* Zj = &Z[zc[j]*n];
+         for(int k=0; k<n; k++) Zj[k] -= (double)mu*Zi[k];
+         double* Wi = &W[zc[i]*n];
+         double* Wj = &W[zc[j]*n];
+         for(int k=0; k<n; k++) Wi[k] += (double)mu*Wj[k];
       }
    }  // End of method 'ARLambda::gauss()'
 
    
-   void ARLambda::permute( Matrix<double>& L, 
-                           Vector<double>& D, 
-                           int j, 
-                           double del, 
-                           Matrix<double>& Z )
+   void ARLambda::permute(int j, double del)
    {  
-      //TODO: CHECK UNEXPECTED INPUT
-      // L:nxn D:nx1 Z:nxn 0<=j<n
+      // L: packed nxn, D: n, Z,W: nxn  0<=j<n-1
+
+      const int n = dim;
 
-      const int n = L.rows();
+      double* Lj = &L[tri(j,0)];
+      double* Lj1 = &L[tri(j+1,0)];
 
-      double eta=D(j)/del;
-      double lam=D(j+1)*L(j+1,j)/del;
+      double eta=D[j]/del;
+      double lam=D[j+1]*Lj1[j]/del;
 
-      D[j]=eta*D(j+1); 
-      D(j+1)=del;
+      D[j]=eta*D[j+1]; 
+      D[j+1]=del;
       for(int k=0;k<=j-1;k++) 
       {
-         double a0=L(j,k); 
-         double a1=L(j+1,k);
-         L(j,k) =-L(j+1,j)*a0 + a1;
-         L(j+1,k) = eta*a0 + lam*a1;
+         double a0=Lj[k]; 
+         double a1=Lj1[k];
+         Lj[k] =-Lj1[j]*a0 + a1;
+         Lj1[k] = eta*a0 + lam*a1;
       }
-      L(j+1,j)=lam;
-      for(int k=j+2; k<n; k++) swap(L(k,j),L(k,j+1));
-      for(int k=0; k<n; k++) swap(Z(k,j),Z(k,j+1));
+      Lj1[j]=lam;
+      for(int k=j+2; k<n; k++) swap(L[tri(k,j)],L[tri(k,j+1)]);
+      std::swap(zc[j],zc[j+1]);
 
    }  // End of method 'ARLambda::permute()'
 
    
-   void ARLambda::reduction( Matrix<double>& L, 
-                             Vector<double>& D,
-                             Matrix<double>& Z)
+   void ARLambda::reduction()
    {
-      //TODO: CHECK UNEXPECTED INPUT
-      // L:nxn D:nx1 Z:nxn 0<=j<n
+      // L: packed nxn, D: n, Z,W: nxn
 
-      const int n = L.rows();
+      const int n = dim;
 
       int j(n-2), k(n-2);
       while(j>=0) 
@@ -192,15 +402,16 @@ namespace gpstk
          {
             for (int i=j+1; i<n; i++) 
             {
-               gauss(L,Z,i,j);
+               gauss(i,j);
             }
          } 
 
-         double del=D(j)+L(j+1,j)*L(j+1,j)*D(j+1);
+         const double l = L[tri(j+1,j)];
+         double del=D[j]+l*l*D[j+1];
 
-         if(del+1E-6<D(j+1)) 
+         if(del+1E-6<D[j+1]) 
          { 
-            permute(L,D,j,del,Z);
+            permute(j,del);
             k=j; j=n-2;
          }
          else
@@ -213,138 +424,102 @@ namespace gpstk
    }  // End of method 'ARLambda::reduction()'
 
 
-   int ARLambda::search( const Matrix<double>& L, 
-                         const Vector<double>& D, 
-                         const Vector<double>& zs, 
-                         Matrix<double>& zn, 
-                         Vector<double>& s, 
-                          const int& m )
+   void ARLambda::resetTransform()
    {
+      const int n = dim;
 
-      ARException e("The LAMBDA search method have not been implemented.");
-      GPSTK_THROW(e);
+      Z.assign(n*n, 0.0);
+      W.assign(n*n, 0.0);
+      zc.resize(n);
+      for(int i=0; i<n; i++)
+      {
+         Z[i*n+i] = 1.0;
+         W[i*n+i] = 1.0;
+         zc[i] = i;
+      }
+
+   }  // End of method 'ARLambda::resetTransform()'
 
-      // TODO: CHECK UNEXPECTED INPUT
-      // n - number of float parameters
-      // m - number of fixed solutions
-      // L - nxn
-      // D - nx1
-      // zs - nxn
-      // zn - nxm
-      // s  - m
-      const int LOOPMAX = 10000;
-      const int n = L.rows();
-
-      zn.resize(n,m,0.0);
-      s.resize(m,0.0);
-
-      Matrix<double> S(n,n,0.0);
-      Vector<double> dist(n,0.0),zb(n,0.0),z(n,0.0),step(n,0.0);
-
-      int k=n-1; dist[k]=0.0;
-      zb(k)=zs(k);
-      z(k)=round(zb(k)); 
-      double y=zb(k)-z(k); 
-      step(k)=sign(y);
-
-      int c(0),nn(0),imax(0);
-      double maxdist=1E99;
-      for(int c=0;c<LOOPMAX;c++)
+
+   void ARLambda::saveTransform( std::vector<double>& Zs,
+                                 std::vector<double>& Ws ) const
+   {
+      const int n = dim;
+
+      Zs.resize(n*n);
+      Ws.resize(n*n);
+      for(int j=0; j<n; j++)
       {
-         double newdist=dist(k)+y*y/D(k);
-         if(newdist<maxdist) 
-         {
-            if(k!=0) 
-            {
-               dist(--k)=newdist;
-               for(int i=0;i<=k;i++)
-               {
-                  S(k,i)=S(k+1,i)+(z(k+1)-zb(k+1))*L(k+1,i);
-               }
-               zb(k)=zs(k)+S(k,k);
-               z(k)=round(zb(k)); y=zb(k)-z(k); step(k)=sign(y);
-            }
-            else 
-            {
-               if(nn<m) 
-               {
-                  if(nn==0||newdist>s(imax)) imax=nn;
-                  for(int i=0;i<n;i++) zn(i,nn)=z(i);
-                  s(nn++)=newdist;
-               }
-               else 
-               {
-                  if(newdist<s(imax)) 
-                  {
-                     for(int i=0;i<n;i++) zn(i,imax)=z(i);
-                     s(imax)=newdist;
-                     for(int i=imax=0;i<m;i++) if (s(imax)<s(i)) imax=i;
-                  }
-                  maxdist=s(imax);
-               }
-               z(0)+=step(0); y=zb(0)-z(0); step(0)=-step(0)-sign(step(0));
-            }
-         }
-         else 
-         {
-            if(k==n-1) break;
-            else 
-            {
-               k++;
-               z(k)+=step(k); y=zb(k)-z(k); step(k)=-step(k)-sign(step(k));
-            }
-         }
+         std::copy(&Z[zc[j]*n], &Z[zc[j]*n]+n, &Zs[j*n]);
+         std::copy(&W[zc[j]*n], &W[zc[j]*n]+n, &Ws[j*n]);
       }
-      for(int i=0;i<m-1;i++) 
-      { 
-         for(int j=i+1;j<m;j++) 
-         {
-            if(s(i)<s(j)) continue;
-            swap(s(i),s(j));
-            for(k=0;k<n;k++) swap(zn(k,i),zn(k,j));
-         }
+
+   }  // End of method 'ARLambda::saveTransform()'
+
+
+   void ARLambda::transform(const double* a)
+   {
+      const int n = dim;
+
+      zs.resize(n);
+      for(int i=0; i<n; i++)
+      {
+         const double* Zi = &Z[zc[i]*n];
+         double sum(0.0);
+         for(int k=0; k<n; k++) sum += Zi[k] * a[k];
+         zs[i] = sum;
       }
 
-      if (c>=LOOPMAX) 
+   }  // End of method 'ARLambda::transform()'
+
+
+   void ARLambda::backTransform(std::vector<double>& F, int m)
+   {
+      // F=Z'\E=W*E - W nxn  E nxm F nxm
+
+      const int n = dim;
+
+      F.assign(n*m, 0.0);
+      for(int c=0; c<m; c++)
       {
-         return -1;
+         double* Fc = &F[c*n];
+         for(int k=0; k<n; k++)
+         {
+            const double e( zn[c*n+k] );
+            if( e == 0.0 ) continue;
+            const double* Wk = &W[zc[k]*n];
+            for(int i=0; i<n; i++) Fc[i] += Wk[i] * e;
+         }
       }
 
-      return 0;
+   }  // End of method 'ARLambda::backTransform()'
+
+
+   int ARLambda::search(int /*m*/)
+   {
+
+      ARException e("The LAMBDA search method have not been implemented.");
+      GPSTK_THROW(e);
+
+      return -1;
 
    }  // End of method 'ARLambda::search()'
 
 
-   int ARLambda::lambda( const Vector<double>& a, 
-                         const Matrix<double>& Q, 
-                         Matrix<double>& F,
-                         Vector<double>& s,
-                         const int& m )
+   int ARLambda::lambda( const double* a, 
+                         std::vector<double>& F,
+                         int m )
    {
-      if( (a.size()!=Q.rows()) || (Q.rows()!=Q.cols()) ) return -1;
       if( m < 1) return -1;
 
-      const int n = static_cast<int>(a.size());
+      if( factorize()!=0 ) return -1;
 
-      Matrix<double> L(n,n,0.0),E(n,m,0.0);
-      Vector<double> D(n,0.0),z(n,0.0);
-      Matrix<double> Z = ident<double>(n);
+      reduction();
+      transform(a);
 
-      if (factorize(Q,L,D)==0) 
-      {      
-         reduction(L,D,Z);
-         z = transpose(Z)*a;
+      if( search(m)!=0 ) return -1;
 
-         if (search(L,D,z,E,s,m)==0) 
-         {
-            try
-            {  // F=Z'\E - Z nxn  E nxm F nxm
-               F = transpose( inverseLUD(Z) ) * E;
-            }
-            catch(...) 
-            { return -1; }
-         }
-      }
+      backTransform(F,m);
 
       return 0;
 
@@ -352,4 +527,3 @@ namespace gpstk
 
 
 }   // End of namespace gpstk
-
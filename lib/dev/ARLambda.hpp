@@ -30,6 +30,7 @@
 //
 //============================================================================
 
+#include <vector>
 #include "ARBase.hpp"
 
 namespace gpstk
@@ -41,6 +42,26 @@ namespace gpstk
        *   P.J.G.Teunissen, The least-square ambiguity decorrelation adjustment:
        *   a method for fast GPS ambiguity estimation, J.Geodesy, Vol.70, 65-82,
        *   1995
+       *
+       * The factor L and the search workspace are kept in packed lower
+       * triangular form, row by row, and the Z-transform is kept together
+       * with its inverse transpose, so that the fixed ambiguities are
+       * obtained as exact integers without inverting Z. The storage is
+       * reused from one call to the next.
+       *
+       * Two extensions are provided:
+       *
+       * - With setWarmStart(true), a call to resolve() with the same number
+       *   of ambiguities as the previous one starts the reduction from the
+       *   previous Z-transform. As any unimodular Z is valid, the result
+       *   doesn't depend on it, but when the covariance changes slowly from
+       *   epoch to epoch the reduction has little left to do. The ambiguities
+       *   should be given in the same order in every call.
+       *
+       * - resolvePartial() fixes the largest subset of the ambiguities that
+       *   passes the ratio test, dropping them in a given order. The
+       *   covariance is factorized once, the factor of every subset being a
+       *   trailing block of it.
        */
    class ARLambda : public ARBase
    {
@@ -48,6 +69,8 @@ namespace gpstk
       
          /// Default constructor
       ARLambda() 
+         : dim(0), squaredRatio(0.0), numFixed(0),
+           warmStart(false), lastDim(0)
       {}      
       
 
@@ -55,6 +78,38 @@ namespace gpstk
       virtual ARLambda& resolve( const Vector<double>& ambFloat, 
                                  const Matrix<double>& ambCov )
          throw(ARException);
+
+
+         /** Partial ambiguity resolution.
+          *
+          * The ambiguities are resolved all together first. If the ratio
+          * isn't greater than 'minRatio', they are dropped one at a time in
+          * the order given by 'dropOrder', and the remaining subset is
+          * resolved again, until the ratio test passes or fewer than
+          * 'minFixed' ambiguities would be left.
+          *
+          * @param ambFloat    Float ambiguities.
+          * @param ambCov      Covariance of the float ambiguities.
+          * @param dropOrder   Indexes of the ambiguities in the order they
+          *                    may be dropped. Ambiguities not listed are
+          *                    never dropped.
+          * @param minRatio    Threshold of the ratio test.
+          * @param minFixed    Minimum number of ambiguities to fix.
+          * @param minDropped  Number of ambiguities to drop at least, once
+          *                    the whole set failed.
+          *
+          * getFixedFlags() tells which ambiguities were fixed, and
+          * getFixedAmbVec() returns the float value for the others. If no
+          * subset passed, nothing is fixed and getRatio() returns the ratio
+          * of the last subset tried.
+          */
+      virtual ARLambda& resolvePartial( const Vector<double>& ambFloat,
+                                        const Matrix<double>& ambCov,
+                                        const std::vector<int>& dropOrder,
+                                        double minRatio,
+                                        int minFixed = 2,
+                                        int minDropped = 1 )
+         throw(ARException);
       
 
          /// Get integer ambiguities
@@ -67,6 +122,21 @@ namespace gpstk
       { return squaredRatio; }
 
 
+         /// Get the flags of the ambiguities fixed by the last call
+      virtual Vector<bool> getFixedFlags() const
+      { return fixedFlags; }
+
+
+         /// Get the number of ambiguities fixed by the last call
+      virtual int getNumFixed() const
+      { return numFixed; }
+
+
+         /// Sets whether resolve() starts from the previous Z-transform
+      virtual ARLambda& setWarmStart(bool warm)
+      { warmStart = warm; lastDim = 0; return (*this); }
+
+
          /// Destractor
       virtual ~ARLambda(){}
 
@@ -86,56 +156,86 @@ namespace gpstk
       { double t(a); a = b; b = t; }
 
 
-         // Q = L'*diag(D)*L
-      int factorize( const Matrix<double>& Q,
-                     Matrix<double>& L, 
-                     Vector<double>& D );
+         /// Position of element (i,j), j<=i, of a packed lower triangle
+      static int tri(int i, int j)
+      { return i*(i+1)/2 + j; }
+
+
+         /// Dimension of the current problem
+      int dim;
+
+
+         /// Packed lower triangle of the covariance to factorize
+      std::vector<double> QC;
+
+
+         /// Q = L'*diag(D)*L, L packed lower triangular with unit diagonal
+      std::vector<double> L, D;
+
+
+         /// Z-transform and its inverse transpose W, column by column.
+         /// Column j of both is stored at slot zc[j]: permute() swaps the
+         /// slots rather than the columns.
+      std::vector<double> Z, W;
+      std::vector<int> zc;
+
+
+         /// Decorrelated float ambiguities, candidates (column by column)
+         /// and their squared distances
+      std::vector<double> zs, zn, s;
+
+
+         /// Workspace of the search
+      std::vector<double> S, dist, zb, z, step;
+
+
+         // Q = L'*diag(D)*L, from the packed 'QC', which is destroyed
+      int factorize();
 
 
          /// integer gauss transformation
-      void gauss(Matrix<double>& L, Matrix<double>& Z, int i, int j );
+      void gauss(int i, int j);
 
 
          /// permutations
-      void permute( Matrix<double>& L, 
-                    Vector<double>& D, 
-                    int j, 
-                    double del, 
-                    Matrix<double>& Z);
+      void permute(int j, double del);
 
 
          /// lambda reduction (z=Z'*a, Qz=Z'*Q*Z=L'*diag(D)*L)
-      void reduction( Matrix<double>& L, 
-                      Vector<double>& D, 
-                      Matrix<double>& Z );
-
-
-         // modified lambda (mlambda) search
-      virtual int search( const Matrix<double>& L, 
-                          const Vector<double>& D, 
-                          const Vector<double>& zs, 
-                          Matrix<double>& zn, 
-                          Vector<double>& s, 
-                          const int& m = 2 );
-
-         // lambda/mlambda integer least-square estimation
-         // a     Float parameters (n x 1)
-         // Q     Covariance matrix of float parameters (n x n)
-         // F     Fixed solutions (n x m)
-         // s     Sum of squared residulas of fixed solutions (1 x m)
-         // m     Number of fixed solutions
-         //      status (0:ok,other:error)
-      int lambda( const Vector<double>& a, 
-                  const Matrix<double>& Q, 
-                  Matrix<double>& F, 
-                  Vector<double>& s, 
-                  const int& m = 2 );
+      void reduction();
+
+
+         /// Sets Z and W to the identity
+      void resetTransform();
+
+
+         /// Copies Z and W, with their columns in order
+      void saveTransform( std::vector<double>& Zs,
+                          std::vector<double>& Ws ) const;
 
 
-   private:
+         /// Computes 'zs' from the float ambiguities 'a', of size 'dim'
+      void transform(const double* a);
 
 
-         /// Some internal variables
+         /// F = W*zn, the first 'm' candidates in the original space
+      void backTransform(std::vector<double>& F, int m);
+
+
+         // Integer least-squares search: the 'm' best candidates of 'zs'
+         // into 'zn', and their squared distances into 's'
+      virtual int search(int m = 2);
+
+
+         // lambda/mlambda integer least-square estimation of 'QC',
+         // with 'Z' and 'W' set
+         // a     Float parameters ('dim')
+         // F     Fixed solutions ('dim' x m, column by column)
+         // m     Number of fixed solutions
+         //      status (0:ok,other:error)
+      int lambda( const double* a, 
+                  std::vector<double>& F,
+                  int m = 2 );
 
 
          /// squared ratio
@@ -145,6 +245,17 @@ namespace gpstk
          /// Vector to store the fixed ambiguities
       Vector<double> ambFixed;
 
+
+         /// Fixed ambiguities, and their number
+      Vector<bool> fixedFlags;
+      int numFixed;
+
+
+         /// Warm start, and the transform of the last call to resolve()
+      bool warmStart;
+      int lastDim;
+      std::vector<double> lastZ, lastW;
+
       
          
    };   // End of class 'ARLambda'
@@ -153,4 +264,3 @@ namespace gpstk
 
 
 #endif  //GPSTK_ARLAMBDA_HPP
-
@@ -27,78 +27,86 @@
 //
 //============================================================================
 
+#include <algorithm>
 #include "ARMLambda.hpp"
 
 
 namespace gpstk
 {
 
-   int ARMLambda::search( const Matrix<double>& L, 
-                          const Vector<double>& D, 
-                          const Vector<double>& zs, 
-                          Matrix<double>& zn, 
-                          Vector<double>& s, 
-                          const int& m )
+   int ARMLambda::search(int m)
    {
-      // TODO: CHECK UNEXPECTED INPUT
       // n - number of float parameters
       // m - number of fixed solutions
-      // L - nxn
+      // L - packed nxn
       // D - nx1
-      // zs - nxn
+      // zs - nx1
       // zn - nxm
       // s  - m
+      // S  - packed nxn, row k updated from row k+1
       const int LOOPMAX = 10000;
-      const int n = L.rows();
+      const int n = dim;
 
-      zn.resize(n,m,0.0);
-      s.resize(m,0.0);
+      if( n < 1 || m < 1 ) return -1;
 
-      Matrix<double> S(n,n,0.0);
-      Vector<double> dist(n,0.0),zb(n,0.0),z(n,0.0),step(n,0.0);
+      zn.assign(n*m,0.0);
+      s.assign(m,0.0);
+
+      S.resize(tri(n,0));
+      dist.assign(n,0.0); zb.assign(n,0.0); z.assign(n,0.0); step.assign(n,0.0);
+      std::fill(&S[tri(n-1,0)], &S[tri(n-1,0)]+n, 0.0);
 
       int k=n-1; dist[k]=0.0;
-      zb(k)=zs(k);
-      z(k)=round(zb(k)); 
-      double y=zb(k)-z(k); 
-      step(k)=sign(y);
+      zb[k]=zs[k];
+      z[k]=round(zb[k]); 
+      double y=zb[k]-z[k]; 
+      step[k]=sign(y);
 
-      int c(0),nn(0),imax(0);
+         // The enumeration is the zig-zag one around the conditional
+         // estimates, which visits the candidates of each level by
+         // increasing distance, and the radius shrinks to the worst of the
+         // 'm' best candidates as soon as they are found. After LOOPMAX
+         // iterations the best candidates found so far are kept.
+      int nn(0),imax(0);
       double maxdist=1E99;
       for(int c=0;c<LOOPMAX;c++)
       {
-         double newdist=dist(k)+y*y/D(k);
+         double newdist=dist[k]+y*y/D[k];
          if(newdist<maxdist) 
          {
             if(k!=0) 
             {
-               dist(--k)=newdist;
+               dist[--k]=newdist;
+               const double dz = z[k+1]-zb[k+1];
+               const double* Sk1 = &S[tri(k+1,0)];
+               const double* Lk1 = &L[tri(k+1,0)];
+               double* Sk = &S[tri(k,0)];
                for(int i=0;i<=k;i++)
                {
-                  S(k,i)=S(k+1,i)+(z(k+1)-zb(k+1))*L(k+1,i);
+                  Sk[i]=Sk1[i]+dz*Lk1[i];
                }
-               zb(k)=zs(k)+S(k,k);
-               z(k)=round(zb(k)); y=zb(k)-z(k); step(k)=sign(y);
+               zb[k]=zs[k]+Sk[k];
+               z[k]=round(zb[k]); y=zb[k]-z[k]; step[k]=sign(y);
             }
             else 
             {
                if(nn<m) 
                {
-                  if(nn==0||newdist>s(imax)) imax=nn;
-                  for(int i=0;i<n;i++) zn(i,nn)=z(i);
-                  s(nn++)=newdist;
+                  if(nn==0||newdist>s[imax]) imax=nn;
+                  std::copy(z.begin(), z.end(), &zn[nn*n]);
+                  s[nn++]=newdist;
                }
                else 
                {
-                  if(newdist<s(imax)) 
+                  if(newdist<s[imax]) 
                   {
-                     for(int i=0;i<n;i++) zn(i,imax)=z(i);
-                     s(imax)=newdist;
-                     for(int i=imax=0;i<m;i++) if (s(imax)<s(i)) imax=i;
+                     std::copy(z.begin(), z.end(), &zn[imax*n]);
+                     s[imax]=newdist;
+                     for(int i=imax=0;i<m;i++) if (s[imax]<s[i]) imax=i;
                   }
-                  maxdist=s(imax);
+                  maxdist=s[imax];
                }
-               z(0)+=step(0); y=zb(0)-z(0); step(0)=-step(0)-sign(step(0));
+               z[0]+=step[0]; y=zb[0]-z[0]; step[0]=-step[0]-sign(step[0]);
             }
          }
          else 
@@ -107,7 +115,7 @@ namespace gpstk
             else 
             {
                k++;
-               z(k)+=step(k); y=zb(k)-z(k); step(k)=-step(k)-sign(step(k));
+               z[k]+=step[k]; y=zb[k]-z[k]; step[k]=-step[k]-sign(step[k]);
             }
          }
       }
@@ -115,13 +123,14 @@ namespace gpstk
       { 
          for(int j=i+1;j<m;j++) 
          {
-            if(s(i)<s(j)) continue;
-            swap(s(i),s(j));
-            for(k=0;k<n;k++) swap(zn(k,i),zn(k,j));
+            if(s[i]<s[j]) continue;
+            swap(s[i],s[j]);
+            std::swap_ranges(&zn[i*n], &zn[i*n]+n, &zn[j*n]);
          }
       }
 
-      if (c>=LOOPMAX) 
+         // Not even 'm' candidates within LOOPMAX iterations
+      if (nn<m) 
       {
          return -1;
       }
@@ -56,12 +56,7 @@ namespace gpstk
    protected:
 
          /// modified lambda (mlambda) search
-      virtual int search( const Matrix<double>& L, 
-                          const Vector<double>& D, 
-                          const Vector<double>& zs, 
-                          Matrix<double>& zn, 
-                          Vector<double>& s, 
-                          const int& m = 2 );
+      virtual int search(int m = 2);
          
    };   // End of class 'ARMLambda'
    
@@ -277,4 +277,261 @@ namespace gpstk
    }  // End of method 'AmbiDatum::getAmbFixedMap()'
 
 
+      /* Prepare the datum of a network, updating its spanning tree.
+       *
+       * @param gData   Data of every source at the current epoch, with
+       *                the 'satArc' and 'elevation' of each satellite.
+       */
+   AmbiDatum& AmbiDatum::Prepare( sourceDataMap& gData )
+   {
+
+         // Clear the datum of the previous epoch
+      ambNetFixedMap.clear();
+      datumEdgeSet.clear();
+
+         // Ambiguities of the current epoch
+      std::vector<NetAmb> currAmbs;
+
+         // Indexes of the satellites at this epoch
+      std::map<SatID, int> satIndex;
+
+         // Loop all the ambiguities of the network
+      for( std::map<SourceID, satValueMap>::const_iterator itSource =
+                                                         ambNetMap.begin();
+           itSource != ambNetMap.end();
+           ++itSource )
+      {
+
+         const SourceID& source( (*itSource).first );
+
+         sourceDataMap::iterator itData( gData.find(source) );
+         std::map<SourceID, satValueMap>::iterator itVar(
+                                                   varNetMap.find(source) );
+         if( itData == gData.end() || itVar == varNetMap.end() )
+         {
+            continue;
+         }
+
+         int receiver( getVertexIndex( Vertex(source) ) );
+
+         for( satValueMap::const_iterator itamb = (*itSource).second.begin();
+              itamb != (*itSource).second.end();
+              ++itamb )
+         {
+
+            const SatID& sat( (*itamb).first );
+
+               // Ambiguities without arc, elevation or variance are skipped
+            satTypeValueMap::iterator itSat( (*itData).second.find(sat) );
+            satValueMap::iterator itSatVar( (*itVar).second.find(sat) );
+            if( itSat == (*itData).second.end() ||
+                itSatVar == (*itVar).second.end() ||
+                (*itSatVar).second <= 0.0 )
+            {
+               continue;
+            }
+
+            typeValueMap::iterator itArc(
+                                 (*itSat).second.find(TypeID::satArc) );
+            typeValueMap::iterator itElev(
+                                 (*itSat).second.find(TypeID::elevation) );
+            if( itArc == (*itSat).second.end() ||
+                itElev == (*itSat).second.end() )
+            {
+               continue;
+            }
+
+            std::map<SatID, int>::iterator itIndex( satIndex.find(sat) );
+            if( itIndex == satIndex.end() )
+            {
+               itIndex = satIndex.insert( std::make_pair( sat,
+                                   getVertexIndex( Vertex(sat) ) ) ).first;
+            }
+
+            NetAmb netAmb;
+            netAmb.key.receiver = receiver;
+            netAmb.key.satellite = (*itIndex).second;
+            netAmb.key.arcNum = static_cast<int>( (*itArc).second );
+            netAmb.itSource = itSource;
+            netAmb.sat = sat;
+            netAmb.amb = (*itamb).second;
+            netAmb.variance = (*itSatVar).second;
+            netAmb.elevation = (*itElev).second;
+
+            currAmbs.push_back(netAmb);
+
+         }  // End of 'for( satValueMap::const_iterator itamb = ...'
+
+      }  // End of 'for( std::map<SourceID, satValueMap>::const_iterator ...'
+
+      std::sort(currAmbs.begin(), currAmbs.end());
+
+         // Remove the tree edges whose arc is over
+      bool removed(false);
+      NetAmb probe;
+      for( std::set<ArcKey>::iterator itArc = treeArcSet.begin();
+           itArc != treeArcSet.end(); )
+      {
+         probe.key = (*itArc);
+         if( !std::binary_search(currAmbs.begin(), currAmbs.end(), probe) )
+         {
+            treeArcSet.erase(itArc++);
+            removed = true;
+         }
+         else
+         {
+            ++itArc;
+         }
+      }
+
+         // In the reference mode the tree is built from scratch, as the
+         // minimum spanning tree of the current edges
+      if(!incremental)
+      {
+         treeArcSet.clear();
+      }
+
+         // While the tree only grows, the union-find forest is still valid.
+         // Otherwise, it is built again from the surviving edges.
+      if( removed || firstTime || !incremental )
+      {
+         for(size_t i=0; i<vertexParent.size(); i++)
+         {
+            vertexParent[i] = i;
+         }
+
+         for( std::set<ArcKey>::iterator itArc = treeArcSet.begin();
+              itArc != treeArcSet.end();
+              ++itArc )
+         {
+            vertexParent[ findRoot( (*itArc).receiver ) ] =
+                                            findRoot( (*itArc).satellite );
+         }
+      }
+
+         // Only the edges joining two parts of the tree may be added to it,
+         // so the other ones are left out. In the reference mode the tree
+         // is empty and every edge is a candidate.
+      std::vector< std::pair<Edge, ArcKey> > candEdges;
+      for(size_t i=0; i<currAmbs.size(); i++)
+      {
+         const ArcKey& key( currAmbs[i].key );
+
+         if( findRoot(key.receiver) == findRoot(key.satellite) )
+         {
+            continue;
+         }
+
+         candEdges.push_back( std::make_pair( currAmbs[i].getEdge(), key ) );
+      }
+
+         // Kruskal's algorithm on the candidates, best edges first
+      std::sort(candEdges.begin(), candEdges.end());
+      for(size_t i=0; i<candEdges.size(); i++)
+      {
+         int r1( findRoot( candEdges[i].second.receiver ) );
+         int r2( findRoot( candEdges[i].second.satellite ) );
+         if( r1 != r2 )
+         {
+            vertexParent[r1] = r2;
+            treeArcSet.insert( candEdges[i].second );
+         }
+      }
+
+         // The datum are the ambiguities of the tree edges, fixed to the
+         // nearest integer
+      for( std::set<ArcKey>::iterator itArc = treeArcSet.begin();
+           itArc != treeArcSet.end();
+           ++itArc )
+      {
+         probe.key = (*itArc);
+         const NetAmb& netAmb( *std::lower_bound( currAmbs.begin(),
+                                                  currAmbs.end(),
+                                                  probe ) );
+
+         ambNetFixedMap[ (*netAmb.itSource).first ][ netAmb.sat ]
+                                          = std::floor( netAmb.amb + 0.5 );
+         datumEdgeSet.insert( netAmb.getEdge() );
+      }
+
+      firstTime = false;
+
+         // Set the network datum as "prepared"
+      netPrepared = true;
+
+      return (*this);
+
+   }  // End of method 'AmbiDatum::Prepare()'
+
+
+      /* Get the ambiguities of the network datum, fixed directly to the
+       * nearest integer.
+       */
+   std::map<SourceID, satValueMap> AmbiDatum::getNetAmbFixedMap( void )
+      throw(InvalidAmbiDatum)
+   {
+
+         // If the object as not ready, throw an exception
+      if (!netPrepared)
+      {
+         GPSTK_THROW(InvalidAmbiDatum("AmbiDatum is not prepared"));
+      }
+
+      return ambNetFixedMap;
+
+   }  // End of method 'AmbiDatum::getNetAmbFixedMap()'
+
+
+      // Get the edges of the spanning tree of the network datum.
+   EdgeSet AmbiDatum::getDatumEdges( void )
+      throw(InvalidAmbiDatum)
+   {
+
+         // If the object as not ready, throw an exception
+      if (!netPrepared)
+      {
+         GPSTK_THROW(InvalidAmbiDatum("AmbiDatum is not prepared"));
+      }
+
+      return datumEdgeSet;
+
+   }  // End of method 'AmbiDatum::getDatumEdges()'
+
+
+      // Index of a vertex, which is added if needed.
+   int AmbiDatum::getVertexIndex(const Vertex& vertex)
+   {
+
+      VertexValueMap::iterator it( vertexIndex.find(vertex) );
+      if( it != vertexIndex.end() )
+      {
+         return (*it).second;
+      }
+
+         // A new vertex is a part of the tree on its own
+      int index( vertexParent.size() );
+      vertexIndex[vertex] = index;
+      vertexParent.push_back(index);
+
+      return index;
+
+   }  // End of method 'AmbiDatum::getVertexIndex()'
+
+
+      // Root of the part of the tree holding a vertex.
+   int AmbiDatum::findRoot(int v)
+   {
+
+      while( vertexParent[v] != v )
+      {
+            // Path halving
+         vertexParent[v] = vertexParent[ vertexParent[v] ];
+         v = vertexParent[v];
+      }
+
+      return v;
+
+   }  // End of method 'AmbiDatum::findRoot()'
+
+
 }  // End of namespace gpstk
@@ -24,6 +24,8 @@
 #include <algorithm>
 
 #include "Arc.hpp"
+#include "Edge.hpp"
+#include "Vertex.hpp"
 #include "ARRound.hpp"
 #include "DataStructures.hpp"
 #include "StochasticModel.hpp"
@@ -51,6 +53,37 @@ namespace gpstk
        * applied together to select a reasonable ambiguity datum for 
        * PPP positioning.
        *
+       * For a network, whose receiver and satellite clocks are both
+       * estimated, the datum is a spanning tree of the graph whose vertices
+       * are the receivers and satellites and whose edges are the ambiguity
+       * arcs, as 'Edge' objects ordered by variance and then elevation.
+       * The tree is kept from epoch to epoch: edges of the previous tree
+       * stay while their arc lasts, and the tree is completed with the best
+       * of the other edges, as Kruskal's algorithm would do starting from
+       * the surviving edges. Only the edges that join two parts of the tree
+       * are examined, so that an epoch where satellites rise or set, or
+       * arcs are broken, costs little more than reading the ambiguities.
+       *
+       * Keeping the surviving edges is intended: the datum only changes
+       * where an arc is over. The tree spans the same parts of the graph
+       * as the minimum spanning tree of the current edges, but it is not
+       * that tree in general, since an edge that has become better than a
+       * surviving one does not replace it. That minimum spanning tree is
+       * built from scratch at every epoch after 'setIncremental(false)'.
+       *
+       * The network datum is not used by SolverPPPUCAR nor by pppucar
+       * yet, which prepare the datum of each station on its own:
+       *
+       * @code
+       *   AmbiDatum datum;
+       *
+       *   datum.Reset(ambNetMap, varNetMap);
+       *   datum.Prepare( gdsMap.begin()->second );
+       *
+       *   std::map<SourceID, satValueMap> fixedMap;
+       *   fixedMap = datum.getNetAmbFixedMap();
+       * @endcode
+       *
        * @sa SolverPPPAR.hpp
        *
        */
@@ -60,7 +93,8 @@ namespace gpstk
 
          /// Default constructor
       AmbiDatum()
-         : firstTime(true), isPrepared(false)
+         : firstTime(true), isPrepared(false),
+           incremental(true), netPrepared(false)
       {};
 
 
@@ -117,6 +151,56 @@ namespace gpstk
          throw(InvalidAmbiDatum);
 
 
+         /** Prepare the datum of a network, updating its spanning tree.
+          *
+          * @param gData   Data of every source at the current epoch, with
+          *                the 'satArc' and 'elevation' of each satellite.
+          */
+      virtual AmbiDatum& Prepare(sourceDataMap& gData);
+
+
+         /** Reset the ambiguity values and variances of a network.
+          *
+          * @param apriAmbDataMap   Apriori ambiguities, by source.
+          * @param apriAmbVarMap    Apriori ambiguity variances, by source.
+          */
+      virtual void Reset( 
+                   std::map<SourceID, satValueMap>& apriAmbDataMap,
+                   std::map<SourceID, satValueMap>& apriAmbVarMap )
+         throw(InvalidAmbiDatum)
+      {
+         ambNetMap = apriAmbDataMap;
+         varNetMap = apriAmbVarMap;
+      };
+
+
+         /** Get the ambiguities of the network datum, fixed directly to the
+          *  nearest integer.
+          */
+      virtual std::map<SourceID, satValueMap> getNetAmbFixedMap( void )
+         throw(InvalidAmbiDatum);
+
+
+         /// Get the edges of the spanning tree of the network datum.
+      virtual EdgeSet getDatumEdges( void )
+         throw(InvalidAmbiDatum);
+
+
+         /** Set whether the spanning tree is updated incrementally, which
+          *  is the default, or built from scratch at every epoch by
+          *  Kruskal's algorithm over all the current edges. The latter is
+          *  the minimum spanning tree of the epoch, which the incremental
+          *  tree may differ from, and is meant as a reference.
+          */
+      virtual AmbiDatum& setIncremental(bool inc)
+      { incremental = inc; return (*this); };
+
+
+         /// Get whether the spanning tree is updated incrementally.
+      virtual bool getIncremental(void) const
+      { return incremental; };
+
+
          /// Destructor
       virtual ~AmbiDatum() {};
 
@@ -165,6 +249,91 @@ namespace gpstk
       SatIDSet currentSatSet;
 
 
+         /// Ambiguities of the network, and their variances
+      std::map<SourceID, satValueMap> ambNetMap;
+      std::map<SourceID, satValueMap> varNetMap;
+
+
+         /// Fixed ambiguities of the network datum
+      std::map<SourceID, satValueMap> ambNetFixedMap;
+
+
+         /// Edges of the spanning tree at the current epoch
+      EdgeSet datumEdgeSet;
+
+
+         /// Arc of the network, given by the indexes of its vertices
+      struct ArcKey
+      {
+         int receiver;
+         int satellite;
+         int arcNum;
+
+         bool operator<(const ArcKey& right) const
+         {
+            if( receiver != right.receiver )
+            {
+               return receiver < right.receiver;
+            }
+            if( satellite != right.satellite )
+            {
+               return satellite < right.satellite;
+            }
+            return arcNum < right.arcNum;
+         }
+      };
+
+
+         /// Ambiguity of the network at the current epoch
+      struct NetAmb
+      {
+         ArcKey key;
+         std::map<SourceID, satValueMap>::const_iterator itSource;
+         SatID sat;
+         double amb;
+         double variance;
+         double elevation;
+
+         bool operator<(const NetAmb& right) const
+         { return key < right.key; }
+
+            /// Edge of this ambiguity, weighted by its variance
+         Edge getEdge() const
+         {
+            return Edge( (*itSource).first, sat, key.arcNum,
+                         1.0/variance, elevation );
+         }
+      };
+
+
+         /// Arcs of the spanning tree
+      std::set<ArcKey> treeArcSet;
+
+
+         /// Index of every vertex seen so far
+      VertexValueMap vertexIndex;
+
+
+         /// Union-find forest of the vertices, joined by the tree edges
+      std::vector<int> vertexParent;
+
+
+         /// Whether the spanning tree is updated incrementally
+      bool incremental;
+
+
+         /// Whether the network datum is ready to be used
+      bool netPrepared;
+
+
+         /// Index of a vertex, which is added if needed
+      int getVertexIndex(const Vertex& vertex);
+
+
+         /// Root of the part of the tree holding a vertex
+      int findRoot(int v);
+
+
    }; // End of class 'AmbiDatum'
 
       //@}
@@ -49,6 +49,7 @@
 
 #include "CivilTime.hpp"
 #include "DataStructures.hpp"
+#include "GnssDataFile.hpp"
 
 namespace gpstk
 {
@@ -481,9 +482,16 @@ namespace gpstk
       return;
    }
 
-      /// Load the data of gnssDataMap object from a binary file
+      /// Load the data of gnssDataMap object from a binary file, either
+      /// written by 'saveGnssDataMap()' or by a 'GnssDataFileWriter'
    gnssDataMap loadGnssDataMap(const std::string& file)
    {
+      if( GnssDataFileReader::isGnssDataFile(file) )
+      {
+         GnssDataFileReader reader(file);
+         return reader.readAll();
+      }
+
       ifstream ifs(file.c_str(),ios::binary);
 
       gnssDataMapBin gdsMapBin(ifs);
@@ -0,0 +1,933 @@
+#pragma ident "$Id$"
+
+/**
+ * @file GnssDataFile.cpp
+ * Indexed binary files of gnssDataMap data, written and read one epoch at
+ * a time.
+ */
+
+//============================================================================
+//
+//  This file is part of GPSTk, the GPS Toolkit.
+//
+//  The GPSTk is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU Lesser General Public License as published
+//  by the Free Software Foundation; either version 2.1 of the License, or
+//  any later version.
+//
+//  The GPSTk is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU Lesser General Public License for more details.
+//
+//  You should have received a copy of the GNU Lesser General Public
+//  License along with GPSTk; if not, write to the Free Software Foundation,
+//  Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110, USA
+//
+//============================================================================
+
+
+#include <sstream>
+#include <algorithm>
+#include <cstring>
+
+#include "GnssDataFile.hpp"
+
+
+namespace gpstk
+{
+
+   using namespace GnssDataFile;
+
+   namespace
+   {
+         // Number of the records that only carry a SourceID or a SatID,
+         // for sources without satellites and satellites without data
+      const uint16_t noEntry = 0xFFFF;
+
+
+      template <class T>
+      void writeBin(std::ostream& s, const T& data)
+      { s.write( (const char*)&data, sizeof(T) ); }
+
+
+      template <class T>
+      void readBin(std::istream& s, T& data)
+      { s.read( (char*)&data, sizeof(T) ); }
+
+
+      void writeString(std::ostream& s, const std::string& str)
+      {
+         writeBin( s, uint32_t(str.size()) );
+         s.write( str.data(), str.size() );
+      }
+
+
+      void readString(std::istream& s, std::string& str)
+      {
+         uint32_t size(0);
+         readBin(s, size);
+         str.resize(size);
+         if( size > 0 )
+         {
+            s.read( &str[0], size );
+         }
+      }
+
+
+      void writeTime(std::ostream& s, const CommonTime& time)
+      {
+         long day, msod;
+         double fsod;
+         TimeSystem sys;
+         time.getInternal(day, msod, fsod, sys);
+
+         writeBin( s, int32_t(day) );
+         writeBin( s, int32_t(msod) );
+         writeBin( s, fsod );
+         writeBin( s, int32_t(sys.getTimeSystem()) );
+      }
+
+
+      void readTime(std::istream& s, CommonTime& time)
+      {
+         int32_t day(0), msod(0), sys(0);
+         double fsod(0.0);
+         readBin(s, day);
+         readBin(s, msod);
+         readBin(s, fsod);
+         readBin(s, sys);
+
+         time.setInternal( day, msod, fsod, TimeSystem(sys) );
+      }
+
+
+         // All the members of a SourceID, as they are written
+      std::string sourceBytes(const SourceID& source)
+      {
+         std::ostringstream s;
+
+         writeBin( s, int32_t(source.type) );
+         writeString( s, source.sourceName );
+         writeString( s, source.sourceNumber );
+         writeBin( s, source.nominalPos.X() );
+         writeBin( s, source.nominalPos.Y() );
+         writeBin( s, source.nominalPos.Z() );
+         writeBin( s, uint8_t(source.staticFlag) );
+         writeBin( s, source.antennaOffset[0] );
+         writeBin( s, source.antennaOffset[1] );
+         writeBin( s, source.antennaOffset[2] );
+
+         writeBin( s, uint32_t(source.zwdMap.size()) );
+         for( std::map<TypeID, double>::const_iterator it =
+                                                      source.zwdMap.begin();
+              it != source.zwdMap.end();
+              ++it )
+         {
+            writeBin( s, int32_t(it->first.type) );
+            writeBin( s, it->second );
+         }
+
+         return s.str();
+      }
+
+
+      SourceID readSource(std::istream& s)
+      {
+         SourceID source;
+
+         int32_t type(0);
+         readBin(s, type);
+         source.type = SourceID::SourceType(type);
+         readString(s, source.sourceName);
+         readString(s, source.sourceNumber);
+
+         double x(0.0), y(0.0), z(0.0);
+         readBin(s, x);
+         readBin(s, y);
+         readBin(s, z);
+         source.nominalPos = Position(x, y, z);
+
+         uint8_t flag(0);
+         readBin(s, flag);
+         source.staticFlag = (flag != 0);
+
+         readBin(s, source.antennaOffset[0]);
+         readBin(s, source.antennaOffset[1]);
+         readBin(s, source.antennaOffset[2]);
+
+         uint32_t size(0);
+         readBin(s, size);
+         for(uint32_t i = 0; i < size && s; ++i)
+         {
+            int32_t t(0);
+            double value(0.0);
+            readBin(s, t);
+            readBin(s, value);
+            source.zwdMap[ TypeID(TypeID::ValueType(t)) ] = value;
+         }
+
+         return source;
+      }
+
+
+         // Writes the entries of the tables from the given numbers on
+      void writeTables( std::ostream& s,
+                        const std::vector<std::string>& sources,
+                        const std::vector<SatID>& sats,
+                        const std::vector<TypeID>& types,
+                        size_t firstSource,
+                        size_t firstSat,
+                        size_t firstType )
+      {
+         writeBin( s, uint32_t(firstSource) );
+         writeBin( s, uint32_t(sources.size() - firstSource) );
+         for(size_t i = firstSource; i < sources.size(); ++i)
+         {
+            writeString( s, sources[i] );
+         }
+
+         writeBin( s, uint32_t(firstSat) );
+         writeBin( s, uint32_t(sats.size() - firstSat) );
+         for(size_t i = firstSat; i < sats.size(); ++i)
+         {
+            writeBin( s, int32_t(sats[i].id) );
+            writeBin( s, int32_t(sats[i].system) );
+         }
+
+         writeBin( s, uint32_t(firstType) );
+         writeBin( s, uint32_t(types.size() - firstType) );
+         for(size_t i = firstType; i < types.size(); ++i)
+         {
+            writeBin( s, int32_t(types[i].type) );
+         }
+      }
+
+
+         // Sets an entry of a table. Tables only grow by appending, so a
+         // number beyond the end means the file is corrupt.
+      template <class T>
+      void setEntry( std::istream& s,
+                     std::vector<T>& table,
+                     uint32_t number,
+                     const T& entry )
+      {
+         if( number < table.size() )
+         {
+            table[number] = entry;
+         }
+         else if( number == table.size() )
+         {
+            table.push_back(entry);
+         }
+         else
+         {
+            s.setstate(std::ios::failbit);
+         }
+      }
+
+
+         // Reads entries of the tables. They go at the numbers written
+         // with them, so reading the same entries twice does no harm.
+      void readTables( std::istream& s,
+                       std::vector<SourceID>& sources,
+                       std::vector<SatID>& sats,
+                       std::vector<TypeID>& types )
+      {
+         uint32_t first(0), size(0);
+
+         readBin(s, first);
+         readBin(s, size);
+         for(uint32_t i = 0; i < size && s; ++i)
+         {
+            std::string bytes;
+            readString(s, bytes);
+            std::istringstream is(bytes);
+            setEntry( s, sources, first+i, readSource(is) );
+         }
+
+         readBin(s, first);
+         readBin(s, size);
+         for(uint32_t i = 0; i < size && s; ++i)
+         {
+            int32_t id(0), sys(0);
+            readBin(s, id);
+            readBin(s, sys);
+            setEntry( s, sats, first+i,
+                      SatID( id, SatID::SatelliteSystem(sys) ) );
+         }
+
+         readBin(s, first);
+         readBin(s, size);
+         for(uint32_t i = 0; i < size && s; ++i)
+         {
+            int32_t t(0);
+            readBin(s, t);
+            setEntry( s, types, first+i, TypeID( TypeID::ValueType(t) ) );
+         }
+      }
+
+
+      bool entryBefore(const IndexEntry& left, const IndexEntry& right)
+      { return left.time < right.time; }
+
+   }  // End of anonymous namespace
+
+
+
+      /* Opens a file, closing the previous one.
+       *
+       * @param file    Name of the file, which is truncated.
+       */
+   void GnssDataFileWriter::open(const std::string& file)
+      throw(FileMissingException)
+   {
+
+      close();
+
+      ofs.clear();
+      ofs.open( file.c_str(), std::ios::out | std::ios::binary |
+                              std::ios::trunc );
+      if( !ofs )
+      {
+         FileMissingException e("Could not create file " + file);
+         GPSTK_THROW(e);
+      }
+
+         // The index offset is zero until the file is closed
+      ofs.write( magic, sizeof(magic) );
+      writeBin( ofs, version );
+      writeBin( ofs, uint32_t(0) );
+      writeBin( ofs, int64_t(0) );
+      ofs.flush();
+
+   }  // End of method 'GnssDataFileWriter::open()'
+
+
+
+      /* Appends the data of one epoch.
+       *
+       * @param time    Epoch of the data.
+       * @param data    Data of every source at that epoch.
+       */
+   GnssDataFileWriter& GnssDataFileWriter::writeEpoch(
+                                                   const CommonTime& time,
+                                                   const sourceDataMap& data )
+      throw(InvalidRequest)
+   {
+
+      if( !ofs.is_open() )
+      {
+         InvalidRequest e("No file is open");
+         GPSTK_THROW(e);
+      }
+
+      const size_t firstSource( sources.size() );
+      const size_t firstSat( sats.size() );
+      const size_t firstType( types.size() );
+
+         // Turn the data into records, numbering what is new
+      records.clear();
+      for( sourceDataMap::const_iterator itSrc = data.begin();
+           itSrc != data.end();
+           ++itSrc )
+      {
+         std::string bytes( sourceBytes(itSrc->first) );
+         std::map<std::string, uint32_t>::iterator itIdx(
+                                                sourceIndex.find(bytes) );
+         if( itIdx == sourceIndex.end() )
+         {
+            itIdx = sourceIndex.insert(
+                        std::make_pair( bytes, uint32_t(sources.size()) ) ).first;
+            sources.push_back(bytes);
+         }
+
+         Record rec;
+         rec.source = itIdx->second;
+         rec.sat = noEntry;
+         rec.type = noEntry;
+         rec.value = 0.0;
+
+         if( itSrc->second.empty() )
+         {
+            records.push_back(rec);
+         }
+
+         for( satTypeValueMap::const_iterator itSat = itSrc->second.begin();
+              itSat != itSrc->second.end();
+              ++itSat )
+         {
+            std::map<SatID, uint16_t>::iterator itSatIdx(
+                                              satIndex.find(itSat->first) );
+            if( itSatIdx == satIndex.end() )
+            {
+               if( sats.size() >= noEntry )
+               {
+                  InvalidRequest e("Too many satellites");
+                  GPSTK_THROW(e);
+               }
+               itSatIdx = satIndex.insert(
+                  std::make_pair( itSat->first, uint16_t(sats.size()) ) ).first;
+               sats.push_back(itSat->first);
+            }
+
+            rec.sat = itSatIdx->second;
+            rec.type = noEntry;
+            rec.value = 0.0;
+
+            if( itSat->second.empty() )
+            {
+               records.push_back(rec);
+            }
+
+            for( typeValueMap::const_iterator itType = itSat->second.begin();
+                 itType != itSat->second.end();
+                 ++itType )
+            {
+               std::map<TypeID, uint16_t>::iterator itTypeIdx(
+                                            typeIndex.find(itType->first) );
+               if( itTypeIdx == typeIndex.end() )
+               {
+                  if( types.size() >= noEntry )
+                  {
+                     InvalidRequest e("Too many types");
+                     GPSTK_THROW(e);
+                  }
+                  itTypeIdx = typeIndex.insert(
+                     std::make_pair( itType->first,
+                                     uint16_t(types.size()) ) ).first;
+                  types.push_back(itType->first);
+               }
+
+               rec.type = itTypeIdx->second;
+               rec.value = itType->second;
+               records.push_back(rec);
+            }
+         }
+      }
+
+         // The tables of the chunk go first, so their size is needed
+      std::ostringstream tables;
+      writeTables( tables, sources, sats, types,
+                   firstSource, firstSat, firstType );
+      const std::string tableBytes( tables.str() );
+
+      IndexEntry entry;
+      entry.time = time;
+      entry.offset = ofs.tellp();
+      index.push_back(entry);
+
+      ofs.write( chunkTag, sizeof(chunkTag) );
+      writeTime( ofs, time );
+      writeBin( ofs, uint32_t(tableBytes.size()) );
+      writeBin( ofs, uint32_t(records.size()) );
+      ofs.write( tableBytes.data(), tableBytes.size() );
+      if( !records.empty() )
+      {
+         ofs.write( (const char*)&records[0],
+                    records.size()*sizeof(Record) );
+      }
+
+         // Readers following the file only see complete chunks
+      ofs.flush();
+
+      if( !ofs )
+      {
+         InvalidRequest e("Error writing the file");
+         GPSTK_THROW(e);
+      }
+
+      return (*this);
+
+   }  // End of method 'GnssDataFileWriter::writeEpoch()'
+
+
+
+      /* Appends the data of one receiver.
+       *
+       * @param gData   Data of one receiver at one epoch.
+       */
+   GnssDataFileWriter& GnssDataFileWriter::writeEpoch(const gnssRinex& gData)
+      throw(InvalidRequest)
+   {
+
+      sourceDataMap data;
+      data[gData.header.source] = gData.body;
+
+      return writeEpoch(gData.header.epoch, data);
+
+   }  // End of method 'GnssDataFileWriter::writeEpoch()'
+
+
+
+      /* Appends all the epochs of a gnssDataMap.
+       *
+       * @param gdsMap  Data to be written.
+       */
+   GnssDataFileWriter& GnssDataFileWriter::write(const gnssDataMap& gdsMap)
+      throw(InvalidRequest)
+   {
+
+      for( gnssDataMap::const_iterator it = gdsMap.begin();
+           it != gdsMap.end();
+           ++it )
+      {
+         writeEpoch(it->first, it->second);
+      }
+
+      return (*this);
+
+   }  // End of method 'GnssDataFileWriter::write()'
+
+
+
+      // Writes the index and closes the file.
+   void GnssDataFileWriter::close()
+   {
+
+      if( !ofs.is_open() )
+      {
+         return;
+      }
+
+      const int64_t indexOffset( ofs.tellp() );
+
+      ofs.write( indexTag, sizeof(indexTag) );
+      writeTables( ofs, sources, sats, types, 0, 0, 0 );
+
+         // Chunks of the same epoch stay in the order they were written
+      std::stable_sort( index.begin(), index.end(), entryBefore );
+
+      writeBin( ofs, uint64_t(index.size()) );
+      for(size_t i = 0; i < index.size(); ++i)
+      {
+         writeTime( ofs, index[i].time );
+         writeBin( ofs, int64_t(index[i].offset) );
+      }
+
+      ofs.seekp( sizeof(magic) + 2*sizeof(uint32_t) );
+      writeBin( ofs, indexOffset );
+      ofs.close();
+
+      sourceIndex.clear();
+      sources.clear();
+      satIndex.clear();
+      sats.clear();
+      typeIndex.clear();
+      types.clear();
+      index.clear();
+      records.clear();
+
+   }  // End of method 'GnssDataFileWriter::close()'
+
+
+
+      /* Opens a file, reading its index if it has one.
+       *
+       * @param file    Name of the file.
+       */
+   void GnssDataFileReader::open(const std::string& file)
+      throw(FileMissingException)
+   {
+
+      if( ifs.is_open() )
+      {
+         ifs.close();
+      }
+
+      indexed = false;
+      index.clear();
+      next = 0;
+      sources.clear();
+      sats.clear();
+      types.clear();
+
+      ifs.clear();
+      ifs.open( file.c_str(), std::ios::in | std::ios::binary );
+
+      char fileMagic[sizeof(magic)];
+      uint32_t fileVersion(0), reserved(0);
+      int64_t indexOffset(0);
+      ifs.read( fileMagic, sizeof(fileMagic) );
+      readBin(ifs, fileVersion);
+      readBin(ifs, reserved);
+      readBin(ifs, indexOffset);
+
+      if( !ifs || std::memcmp(fileMagic, magic, sizeof(magic)) != 0 )
+      {
+         FileMissingException e( file + " is not an indexed gnssDataMap"
+                                 " file" );
+         GPSTK_THROW(e);
+      }
+
+      if( fileVersion != version )
+      {
+         FileMissingException e( "Unknown version of file " + file );
+         GPSTK_THROW(e);
+      }
+
+      if( indexOffset != 0 )
+      {
+         char tag[sizeof(indexTag)];
+         ifs.seekg(indexOffset);
+         ifs.read( tag, sizeof(tag) );
+         if( ifs && std::memcmp(tag, indexTag, sizeof(tag)) != 0 )
+         {
+            ifs.setstate(std::ios::failbit);
+         }
+         readTables(ifs, sources, sats, types);
+
+         uint64_t size(0);
+         readBin(ifs, size);
+         for(uint64_t i = 0; i < size && ifs; ++i)
+         {
+            IndexEntry entry;
+            int64_t offset(0);
+            readTime(ifs, entry.time);
+            readBin(ifs, offset);
+            entry.offset = offset;
+            index.push_back(entry);
+         }
+
+         if( !ifs )
+         {
+            FileMissingException e( "The index of file " + file
+                                    + " is corrupt" );
+            GPSTK_THROW(e);
+         }
+
+         indexed = true;
+      }
+
+      ifs.seekg(headerSize);
+
+   }  // End of method 'GnssDataFileReader::open()'
+
+
+
+      // Returns true if the file starts like an indexed gnssDataMap file.
+   bool GnssDataFileReader::isGnssDataFile(const std::string& file)
+   {
+
+      std::ifstream s( file.c_str(), std::ios::in | std::ios::binary );
+
+      char fileMagic[sizeof(magic)];
+      s.read( fileMagic, sizeof(fileMagic) );
+
+      return ( s && std::memcmp(fileMagic, magic, sizeof(magic)) == 0 );
+
+   }  // End of method 'GnssDataFileReader::isGnssDataFile()'
+
+
+
+      /* Reads the chunk at the current position.
+       *
+       * @param time    Epoch of the chunk.
+       * @param data    Map the data are added to.
+       * @param tables  Whether to read the tables of the chunk.
+       */
+   bool GnssDataFileReader::readChunk( CommonTime& time,
+                                       sourceDataMap& data,
+                                       bool tables )
+   {
+
+      const std::streampos start( ifs.tellg() );
+
+      char tag[sizeof(chunkTag)];
+      uint32_t tableSize(0), numRecords(0);
+      ifs.read( tag, sizeof(tag) );
+
+         // The index follows the last chunk
+      if( ifs && std::memcmp(tag, indexTag, sizeof(tag)) == 0 )
+      {
+         ifs.seekg(start);
+         return false;
+      }
+
+      if( ifs && std::memcmp(tag, chunkTag, sizeof(tag)) != 0 )
+      {
+         FileMissingException e("Corrupt gnssDataMap file");
+         GPSTK_THROW(e);
+      }
+
+      readTime(ifs, time);
+      readBin(ifs, tableSize);
+      readBin(ifs, numRecords);
+
+         // The sizes can't go beyond the end of the file
+      if( ifs )
+      {
+         const std::streampos pos( ifs.tellg() );
+         ifs.seekg(0, std::ios::end);
+         const uint64_t remaining( ifs.tellg() - pos );
+         ifs.seekg(pos);
+
+         if( tableSize + uint64_t(numRecords)*sizeof(Record) > remaining )
+         {
+            ifs.setstate(std::ios::failbit);
+         }
+      }
+
+      std::string tableBytes;
+      if( ifs && tableSize > 0 )
+      {
+         tableBytes.resize(tableSize);
+         ifs.read( &tableBytes[0], tableSize );
+      }
+
+      if( ifs )
+      {
+         records.resize(numRecords);
+         if( numRecords > 0 )
+         {
+            ifs.read( (char*)&records[0], numRecords*sizeof(Record) );
+         }
+      }
+
+         // A chunk still being written: try again later
+      if( !ifs )
+      {
+         ifs.clear();
+         ifs.seekg(start);
+         return false;
+      }
+
+      if( tables )
+      {
+         std::istringstream s(tableBytes);
+         readTables(s, sources, sats, types);
+      }
+
+         // The records come in order, so they are appended
+      sourceDataMap::iterator itSrc( data.end() );
+      satTypeValueMap::iterator itSat;
+      uint32_t lastSource(0);
+      uint16_t lastSat(noEntry);
+      for(size_t i = 0; i < records.size(); ++i)
+      {
+         const Record& rec( records[i] );
+
+         if( rec.source >= sources.size() ||
+             ( rec.sat != noEntry && rec.sat >= sats.size() ) ||
+             ( rec.type != noEntry && rec.type >= types.size() ) )
+         {
+            FileMissingException e("Corrupt gnssDataMap file");
+            GPSTK_THROW(e);
+         }
+
+         if( itSrc == data.end() || rec.source != lastSource )
+         {
+            itSrc = data.insert( data.end(),
+                         std::make_pair( sources[rec.source],
+                                         satTypeValueMap() ) );
+            lastSource = rec.source;
+            lastSat = noEntry;
+         }
+
+         if( rec.sat == noEntry )
+         {
+            continue;
+         }
+
+         if( rec.sat != lastSat )
+         {
+            itSat = itSrc->second.insert( itSrc->second.end(),
+                         std::make_pair( sats[rec.sat], typeValueMap() ) );
+            lastSat = rec.sat;
+         }
+
+         if( rec.type == noEntry )
+         {
+            continue;
+         }
+
+         typeValueMap::iterator itType( itSat->second.insert(
+                                   itSat->second.end(),
+                                   std::make_pair( types[rec.type], 0.0 ) ) );
+         itType->second = rec.value;
+      }
+
+      return true;
+
+   }  // End of method 'GnssDataFileReader::readChunk()'
+
+
+
+      /* Reads the next epoch.
+       *
+       * @param time    Epoch of the data.
+       * @param data    Data of every source at that epoch.
+       */
+   bool GnssDataFileReader::readEpoch( CommonTime& time,
+                                       sourceDataMap& data )
+      throw(FileMissingException)
+   {
+
+      data.clear();
+
+      if( !ifs.is_open() )
+      {
+         return false;
+      }
+
+      if( !indexed )
+      {
+         return readChunk(time, data, true);
+      }
+
+      if( next >= index.size() )
+      {
+         return false;
+      }
+
+         // Merge all the chunks of this epoch
+      time = index[next].time;
+      while( next < index.size() && index[next].time == time )
+      {
+         CommonTime chunkTime;
+         ifs.seekg( index[next].offset );
+         if( !readChunk(chunkTime, data, false) )
+         {
+            FileMissingException e("Corrupt gnssDataMap file");
+            GPSTK_THROW(e);
+         }
+         ++next;
+      }
+
+      return true;
+
+   }  // End of method 'GnssDataFileReader::readEpoch()'
+
+
+
+      /* Reads the next epoch into a gnssDataMap, which is cleared first.
+       *
+       * @param gdsMap  Data of the epoch.
+       */
+   bool GnssDataFileReader::readEpoch(gnssDataMap& gdsMap)
+      throw(FileMissingException)
+   {
+
+      gdsMap.clear();
+
+      if( !ifs.is_open() )
+      {
+         return false;
+      }
+
+      CommonTime time;
+      sourceDataMap data;
+
+      if( !indexed )
+      {
+         if( !readChunk(time, data, true) )
+         {
+            return false;
+         }
+
+         gdsMap.insert( std::make_pair(time, sourceDataMap()) )
+                                                         ->second.swap(data);
+         return true;
+      }
+
+      if( next >= index.size() )
+      {
+         return false;
+      }
+
+         // Each chunk of this epoch is one entry, as 'addGnssRinex()' does
+      time = index[next].time;
+      while( next < index.size() && index[next].time == time )
+      {
+         CommonTime chunkTime;
+         data.clear();
+         ifs.seekg( index[next].offset );
+         if( !readChunk(chunkTime, data, false) )
+         {
+            FileMissingException e("Corrupt gnssDataMap file");
+            GPSTK_THROW(e);
+         }
+         gdsMap.insert( std::make_pair(time, sourceDataMap()) )
+                                                         ->second.swap(data);
+         ++next;
+      }
+
+      return true;
+
+   }  // End of method 'GnssDataFileReader::readEpoch()'
+
+
+
+      /* Places the reader at the first epoch not before a given time.
+       *
+       * @param time    Time to look for.
+       */
+   bool GnssDataFileReader::seekEpoch(const CommonTime& time)
+      throw(FileMissingException)
+   {
+
+      if( !ifs.is_open() )
+      {
+         return false;
+      }
+
+      if( indexed )
+      {
+         IndexEntry entry;
+         entry.time = time;
+         entry.offset = 0;
+         next = std::lower_bound( index.begin(), index.end(),
+                                  entry, entryBefore ) - index.begin();
+         return ( next < index.size() );
+      }
+
+         // Read forward, and step back over the epoch found
+      sourceDataMap data;
+      while( true )
+      {
+         const std::streampos start( ifs.tellg() );
+
+         CommonTime chunkTime;
+         data.clear();
+         if( !readChunk(chunkTime, data, true) )
+         {
+            return false;
+         }
+
+         if( !(chunkTime < time) )
+         {
+            ifs.seekg(start);
+            return true;
+         }
+      }
+
+   }  // End of method 'GnssDataFileReader::seekEpoch()'
+
+
+
+      // Reads all the remaining epochs into a gnssDataMap.
+   gnssDataMap GnssDataFileReader::readAll()
+      throw(FileMissingException)
+   {
+
+      gnssDataMap gdsMap;
+
+      gnssDataMap epochMap;
+      while( readEpoch(epochMap) )
+      {
+         for( gnssDataMap::iterator it = epochMap.begin();
+              it != epochMap.end();
+              ++it )
+         {
+            gdsMap.insert( gdsMap.end(),
+                           std::make_pair(it->first, sourceDataMap()) )
+                                                   ->second.swap(it->second);
+         }
+      }
+
+      return gdsMap;
+
+   }  // End of method 'GnssDataFileReader::readAll()'
+
+
+}  // End of namespace gpstk
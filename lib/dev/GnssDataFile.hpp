@@ -0,0 +1,405 @@
+#pragma ident "$Id$"
+
+/**
+ * @file GnssDataFile.hpp
+ * Indexed binary files of gnssDataMap data, written and read one epoch at
+ * a time.
+ */
+
+#ifndef GPSTK_GNSSDATAFILE_HPP
+#define GPSTK_GNSSDATAFILE_HPP
+
+//============================================================================
+//
+//  This file is part of GPSTk, the GPS Toolkit.
+//
+//  The GPSTk is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU Lesser General Public License as published
+//  by the Free Software Foundation; either version 2.1 of the License, or
+//  any later version.
+//
+//  The GPSTk is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU Lesser General Public License for more details.
+//
+//  You should have received a copy of the GNU Lesser General Public
+//  License along with GPSTk; if not, write to the Free Software Foundation,
+//  Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110, USA
+//
+//============================================================================
+
+
+#include <stdint.h>
+#include <fstream>
+#include <string>
+#include <vector>
+#include <map>
+
+#include "Exception.hpp"
+#include "CommonTime.hpp"
+#include "DataStructures.hpp"
+
+
+
+namespace gpstk
+{
+
+      /** @addtogroup DataStructures */
+      //@{
+
+
+      /** Layout of the indexed gnssDataMap files.
+       *
+       * A file is a fixed header followed by one chunk per call to
+       * GnssDataFileWriter::writeEpoch(), and, once the writer is closed,
+       * by an index. Everything is written in the byte order of the host.
+       *
+       * The header holds a magic string, the format version and the offset
+       * of the index, which stays zero until the writer is closed.
+       *
+       * Chunks and the index start with a tag of their own, so that a
+       * reader following the file stops at the index even before the
+       * header points to it.
+       *
+       * A chunk holds the epoch, the SourceID's, SatID's and TypeID's used
+       * for the first time in the chunk, and then the data as fixed-width
+       * records (source, satellite, type, value) that refer to those by
+       * number. Records come in the order of the gnssDataMap, so a reader
+       * rebuilds the maps by appending.
+       *
+       * The index holds the complete SourceID, SatID and TypeID tables and
+       * the time and offset of every chunk, sorted by time, so that a reader
+       * may seek to any epoch without reading the chunks before it.
+       *
+       * SourceID's are stored with all their members; as the zenith wet
+       * delays they carry may change from epoch to epoch, the same station
+       * may appear several times in the table.
+       */
+   namespace GnssDataFile
+   {
+         /// Identifies the files, and their version
+      const char magic[8] = { 'G', 'N', 'S', 'S', 'D', 'M', 'A', 'P' };
+      const uint32_t version = 1;
+
+         /// Size of the header, in bytes
+      const std::streamoff headerSize = 24;
+
+         /// Start of every chunk, and of the index
+      const char chunkTag[4] = { 'C', 'H', 'N', 'K' };
+      const char indexTag[4] = { 'I', 'N', 'D', 'X' };
+
+         /// One value of the data
+      struct Record
+      {
+         uint32_t source;
+         uint16_t sat;
+         uint16_t type;
+         double value;
+      };
+
+         /// Time and position of a chunk
+      struct IndexEntry
+      {
+         CommonTime time;
+         std::streamoff offset;
+      };
+
+   }  // End of namespace GnssDataFile
+
+
+
+      /** This class writes gnssDataMap data to an indexed binary file, one
+       *  epoch at a time, so that the data need not be kept in memory until
+       *  the processing ends.
+       *
+       * A typical way to use this class follows:
+       *
+       * @code
+       *   GnssDataFileWriter corrWriter("network.gdx");
+       *
+       *   while(rin >> gRin)
+       *   {
+       *      gRin >> basic >> solver;
+       *      corrWriter.writeEpoch(gRin);
+       *   }
+       *
+       *   corrWriter.close();
+       * @endcode
+       *
+       * Each chunk is flushed when written, so a GnssDataFileReader may
+       * follow the file while it grows. The index is written by close(),
+       * which the destructor calls if needed. The epochs may come in any
+       * order, for instance station by station; the index sorts them, and
+       * a reader of the closed file merges the chunks of the same epoch.
+       *
+       * @sa GnssDataFileReader, and GnssDataFile for the layout.
+       */
+   class GnssDataFileWriter
+   {
+   public:
+
+         /// Default constructor
+      GnssDataFileWriter()
+      {};
+
+
+         /** Common constructor, opening a file.
+          *
+          * @param file    Name of the file, which is truncated.
+          */
+      GnssDataFileWriter(const std::string& file)
+         throw(FileMissingException)
+      { open(file); };
+
+
+         /** Opens a file, closing the previous one.
+          *
+          * @param file    Name of the file, which is truncated.
+          */
+      virtual void open(const std::string& file)
+         throw(FileMissingException);
+
+
+         /** Appends the data of one epoch.
+          *
+          * @param time    Epoch of the data.
+          * @param data    Data of every source at that epoch.
+          */
+      virtual GnssDataFileWriter& writeEpoch( const CommonTime& time,
+                                              const sourceDataMap& data )
+         throw(InvalidRequest);
+
+
+         /** Appends the data of one receiver.
+          *
+          * @param gData   Data of one receiver at one epoch.
+          */
+      virtual GnssDataFileWriter& writeEpoch(const gnssRinex& gData)
+         throw(InvalidRequest);
+
+
+         /** Appends all the epochs of a gnssDataMap.
+          *
+          * @param gdsMap  Data to be written.
+          */
+      virtual GnssDataFileWriter& write(const gnssDataMap& gdsMap)
+         throw(InvalidRequest);
+
+
+         /// Writes the index and closes the file.
+      virtual void close();
+
+
+         /// Returns true if a file is open.
+      bool isOpen() const
+      { return ofs.is_open(); };
+
+
+         /// Returns the number of epochs written.
+      size_t numEpochs() const
+      { return index.size(); };
+
+
+         /// Destructor, closing the file.
+      virtual ~GnssDataFileWriter()
+      { close(); };
+
+
+   private:
+
+
+         /// Output file
+      std::ofstream ofs;
+
+
+         /// Interned SourceID's, by their contents as written
+      std::map<std::string, uint32_t> sourceIndex;
+      std::vector<std::string> sources;
+
+
+         /// Interned SatID's and TypeID's
+      std::map<SatID, uint16_t> satIndex;
+      std::vector<SatID> sats;
+      std::map<TypeID, uint16_t> typeIndex;
+      std::vector<TypeID> types;
+
+
+         /// Time and offset of the chunks written
+      std::vector<GnssDataFile::IndexEntry> index;
+
+
+         /// Records of the current chunk
+      std::vector<GnssDataFile::Record> records;
+
+
+         // Copying a writer makes no sense
+      GnssDataFileWriter(const GnssDataFileWriter&);
+      GnssDataFileWriter& operator=(const GnssDataFileWriter&);
+
+
+   }; // End of class 'GnssDataFileWriter'
+
+
+
+      /** This class reads the indexed binary files written by
+       *  GnssDataFileWriter, one epoch at a time.
+       *
+       * A typical way to use this class follows:
+       *
+       * @code
+       *   GnssDataFileReader corrReader("network.gdx");
+       *
+       *   gnssDataMap refData;
+       *   corrReader.seekEpoch(firstEpoch);
+       *   while( corrReader.readEpoch(refData) )
+       *   {
+       *      ...
+       *   }
+       * @endcode
+       *
+       * If the file was closed by its writer, the index is used: epochs come
+       * in time order, with the chunks of the same epoch merged, and
+       * seekEpoch() is a binary search. Otherwise the chunks are read in the
+       * order they were written, and when readEpoch() reaches the last
+       * complete chunk it returns false but may be called again later, to
+       * follow a file that is still being written.
+       *
+       * Only the data of the current epoch are kept in memory.
+       *
+       * @sa GnssDataFileWriter.
+       */
+   class GnssDataFileReader
+   {
+   public:
+
+         /// Default constructor
+      GnssDataFileReader()
+         : indexed(false), next(0)
+      {};
+
+
+         /** Common constructor, opening a file.
+          *
+          * @param file    Name of the file.
+          */
+      GnssDataFileReader(const std::string& file)
+         throw(FileMissingException)
+         : indexed(false), next(0)
+      { open(file); };
+
+
+         /** Opens a file, reading its index if it has one.
+          *
+          * @param file    Name of the file.
+          */
+      virtual void open(const std::string& file)
+         throw(FileMissingException);
+
+
+         /// Returns true if the file starts like an indexed gnssDataMap file.
+      static bool isGnssDataFile(const std::string& file);
+
+
+         /** Reads the next epoch.
+          *
+          * @param time    Epoch of the data.
+          * @param data    Data of every source at that epoch.
+          *
+          * @return false if there are no more (complete) epochs.
+          */
+      virtual bool readEpoch( CommonTime& time,
+                              sourceDataMap& data )
+         throw(FileMissingException);
+
+
+         /** Reads the next epoch into a gnssDataMap, which is cleared first.
+          *  Each chunk of the epoch is one entry of the map, as written.
+          *
+          * @param gdsMap  Data of the epoch.
+          *
+          * @return false if there are no more (complete) epochs.
+          */
+      virtual bool readEpoch(gnssDataMap& gdsMap)
+         throw(FileMissingException);
+
+
+         /** Places the reader at the first epoch not before a given time.
+          *  Without index, the reader only moves forward.
+          *
+          * @param time    Time to look for.
+          *
+          * @return false if there is no such epoch (yet).
+          */
+      virtual bool seekEpoch(const CommonTime& time)
+         throw(FileMissingException);
+
+
+         /// Reads all the remaining epochs into a gnssDataMap.
+      virtual gnssDataMap readAll()
+         throw(FileMissingException);
+
+
+         /// Returns true if the file has an index.
+      bool isIndexed() const
+      { return indexed; };
+
+
+         /// Returns the number of epochs of an indexed file.
+      size_t numEpochs() const
+      { return index.size(); };
+
+
+         /// Destructor
+      virtual ~GnssDataFileReader()
+      {};
+
+
+   private:
+
+
+         /// Input file
+      std::ifstream ifs;
+
+
+         /// True if the index was read
+      bool indexed;
+
+
+         /// Chunks of an indexed file, and the next one to read
+      std::vector<GnssDataFile::IndexEntry> index;
+      size_t next;
+
+
+         /// Interned SourceID's, SatID's and TypeID's
+      std::vector<SourceID> sources;
+      std::vector<SatID> sats;
+      std::vector<TypeID> types;
+
+
+         /// Records of the current chunk
+      std::vector<GnssDataFile::Record> records;
+
+
+         /** Reads the chunk at the current position.
+          *
+          * @param time    Epoch of the chunk.
+          * @param data    Map the data are added to.
+          * @param tables  Whether to read the tables of the chunk.
+          *
+          * @return false, leaving the position alone, if the chunk isn't
+          * complete or the index comes next.
+          */
+      bool readChunk( CommonTime& time,
+                      sourceDataMap& data,
+                      bool tables );
+
+
+   }; // End of class 'GnssDataFileReader'
+
+
+      //@}
+
+}  // End of namespace gpstk
+
+#endif   // GPSTK_GNSSDATAFILE_HPP
@@ -79,7 +79,7 @@ namespace gpstk
                                        const Position& RxCoordinates, 
                                        const gnssDataMap& referenceData,
                                        bool onlyStatic)
-       : firstTime(true)
+       : pRefReader(NULL), firstTime(true)
    {
          // Set the typeSet with 'type'
       setInterpType( type);
@@ -116,7 +116,7 @@ namespace gpstk
                                        const Position& RxCoordinates, 
                                        const gnssDataMap& refData,
                                        bool onlyStatic )
-       : firstTime(true)
+       : pRefReader(NULL), firstTime(true)
    {
          // Set the initial coordinates
       setInitialRxPosition( RxCoordinates );
@@ -188,6 +188,7 @@ namespace gpstk
       {
            // Now, get the reference gnss data
          gdsRef = refData; 
+         pRefReader = NULL;
 
          return 0;
       }
@@ -278,8 +279,7 @@ namespace gpstk
          if(firstTime)
          {
                 // Get the data of the first epoch
-             refDataMap = gdsRef.frontEpoch();
-             gdsRef.pop_front_epoch();
+             refDataMap = nextReferenceEpoch();
 
                 // Get the first epoch time
              CommonTime refEpoch = refDataMap.begin()->first;
@@ -292,13 +292,20 @@ namespace gpstk
                  GPSTK_THROW(e);
              }
 
+                // A file of corrections goes straight to 'epoch'
+             if( refEpoch < epoch && pRefReader != NULL )
+             {
+                 pRefReader->seekEpoch(epoch);
+                 refDataMap = nextReferenceEpoch();
+                 refEpoch = refDataMap.begin()->first;
+             }
+
                 // If the first time of 'gdsMap' is less than the 
                 // observation time 'epoch', then contine 'poping', until
                 // they equals.
              while (refEpoch < epoch)
              {
-                 refDataMap = gdsRef.frontEpoch();
-                 gdsRef.pop_front_epoch();
+                 refDataMap = nextReferenceEpoch();
                  refEpoch = refDataMap.begin()->first;
                  cout << "refEpoch" << refEpoch << endl;
              }
@@ -311,8 +318,7 @@ namespace gpstk
                 // Only pop 'ONE' epoch data given that
                 // the data sampling rate equals with the rate of the
                 // correction data.
-             refDataMap = gdsRef.frontEpoch();
-             gdsRef.pop_front_epoch();
+             refDataMap = nextReferenceEpoch();
          }
 
          cout << "InterpCorrection:epoch:" << epoch 
@@ -519,6 +525,43 @@ namespace gpstk
 
 
 
+      // Returns the next epoch of the corrections
+   gnssDataMap InterpCorrection::nextReferenceEpoch()
+      throw(ProcessingException)
+   {
+
+      gnssDataMap refDataMap;
+
+      if( pRefReader != NULL )
+      {
+         try
+         {
+            pRefReader->readEpoch(refDataMap);
+         }
+         catch(Exception& u)
+         {
+            ProcessingException e( getClassName() + ":" + u.what() );
+            GPSTK_THROW(e);
+         }
+      }
+      else
+      {
+         refDataMap = gdsRef.frontEpoch();
+         gdsRef.pop_front_epoch();
+      }
+
+      if( refDataMap.empty() )
+      {
+         ProcessingException e("there are no more reference data");
+         GPSTK_THROW(e);
+      }
+
+      return refDataMap;
+
+   }  // End of method 'InterpCorrection::nextReferenceEpoch()'
+
+
+
       /** Method that determine the coefficients for the corrections 
        *  interpolation
        *
@@ -43,6 +43,7 @@
 #include "Position.hpp"
 #include "SolverBase.hpp"
 #include "ProcessingClass.hpp"
+#include "GnssDataFile.hpp"
 #include <list>
 #include <vector>
 #include <algorithm>
@@ -103,7 +104,7 @@ namespace gpstk
 
          /// Default constructor.
       InterpCorrection()
-          : firstTime(true), useOnlyStaticSta(true)
+          : pRefReader(NULL), firstTime(true), useOnlyStaticSta(true)
       {};
 
 
@@ -174,6 +175,17 @@ namespace gpstk
       virtual int setReferenceData(const gnssDataMap& refData);
 
 
+         /** Method to read the reference data epoch by epoch from an
+          *  indexed gnssDataMap file, instead of keeping them all in memory.
+          *  This replaces the data given by 'setReferenceData()'.
+          *
+          * @param reader  Reader of the file, which must live as long as
+          *                this object.
+          */
+      virtual InterpCorrection& setReferenceFile(GnssDataFileReader& reader)
+      { pRefReader = &reader; gdsRef.clear(); return (*this); };
+
+
          /** Method to add the TypeID's to be interpolated. This method will erase
           *  previous types.
           * @param typeSet       Set of TypeID's to be interpolated.
@@ -249,6 +261,15 @@ namespace gpstk
       gnssDataMap gdsRef;
 
 
+         /// Reader of the corrections, used instead of 'gdsRef' if set
+      GnssDataFileReader* pRefReader;
+
+
+         /// Returns the next epoch of the corrections
+      gnssDataMap nextReferenceEpoch()
+         throw(ProcessingException);
+
+
          /// Boolean indicating if this filter was run at least once
       bool firstTime;
 
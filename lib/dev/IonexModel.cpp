@@ -117,8 +117,43 @@ namespace gpstk
       try
       {
 
-            // Loop through all the satellites
+            // Ionospheric pierce points of the satellites with elevation and
+            // azimuth, in the order of gData, and their TEC, RMS and height
+         std::vector<Position> ippPos;
+         std::vector<Triple> ippVal;
+         std::vector<bool> ippValid;
+
          satTypeValueMap::iterator stv;
+
+         if(pDefaultMaps!=NULL)
+         {
+
+            for(stv = gData.begin(); stv != gData.end(); ++stv)
+            {
+
+               if( stv->second.find(TypeID::elevation) == stv->second.end() ||
+                   stv->second.find(TypeID::azimuth)   == stv->second.end() )
+               {
+                  continue;
+               }
+
+               Position IPP = rxPos.getIonosphericPiercePoint(
+                                             stv->second(TypeID::elevation),
+                                             stv->second(TypeID::azimuth),
+                                             ionoHeight );
+               IPP.transformTo(Position::Geocentric);
+
+               ippPos.push_back(IPP);
+
+            }
+
+               // All the pierce points are looked up in the maps at once
+            pDefaultMaps->getIonexValues( time, ippPos, ippVal, ippValid );
+
+         }  // End of 'if(pDefaultMaps!=NULL)'
+
+            // Loop through all the satellites
+         size_t ipp(0);
          for(stv = gData.begin(); stv != gData.end(); ++stv)
          {
 
@@ -146,26 +181,30 @@ namespace gpstk
             else
             {
 
-                  // Scalars to hold satellite elevation, azimuth, ionospheric
+                  // Scalars to hold satellite elevation, ionospheric
                   // map and ionospheric slant delays
                double elevation( stv->second(TypeID::elevation) );
-               double azimuth(   stv->second(TypeID::azimuth)   );
                double ionoMap(0.0);
                double ionexL1(0.0), ionexL2(0.0), ionexL5(0.0);   // GPS
                double ionexL6(0.0), ionexL7(0.0), ionexL8(0.0);   // Galileo
 
-                  //	calculate the position of the ionospheric pierce-point
-                  // corresponding to the receiver-satellite ray
-               Position IPP = rxPos.getIonosphericPiercePoint( elevation,
-                                                               azimuth,
-                                                               ionoHeight);
+                  // the ionospheric pierce-point corresponding to the
+                  // receiver-satellite ray, already in geocentric coordinates
+               size_t k(ipp++);
+               const Position& IPP( ippPos[k] );
 
                   // TODO
                   // Checking the collinearity of rxPos, IPP and SV
 
-                  // Convert coordinate system
-               Position pos(IPP);
-               pos.transformTo(Position::Geocentric);
+                  // If the pierce point is off the maps, then remove satellite
+               if( !ippValid[k] )
+               {
+
+                  satRejectedSet.insert( stv->first );
+
+                  continue;
+
+               }
                   // Compute the IPP position directly above the place of the
                   // receiver. 
                Position rxIPP = rxPos.getIonosphericPiercePoint( 90,
@@ -179,7 +218,7 @@ namespace gpstk
 
                   // Now, compute the difference of the longitude between
                   // the IPP and rxIPP
-               double lonIPP = pos.getLongitude(); 
+               double lonIPP = IPP.getLongitude(); 
                double lonRxIPP = rxIPP.getLongitude(); 
 
                   // Get the radius
@@ -216,9 +255,8 @@ namespace gpstk
                   // Insert the latitude and longitude of IPP
                (*stv).second[TypeID::LatIPP]  = latIPP;
                (*stv).second[TypeID::LonIPP]  = lonIPP;
-                  // Let's get TEC, RMS and ionosphere height for IPP
-                  // at current epoch
-               Triple val = pDefaultMaps->getIonexValue( time, pos );
+                  // TEC, RMS and ionosphere height for IPP at current epoch
+               const Triple& val( ippVal[k] );
 
                   // just to make it handy for useage
                double tecval = val[0];
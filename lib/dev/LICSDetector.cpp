@@ -323,19 +323,22 @@ namespace gpstk
       double tempLLI1(0.0);
       double tempLLI2(0.0);
 
+         // Filter data of this satellite
+      filterData& data( LIData[sat] );
+
 
          // Get the difference between current epoch and former epoch,
          // in seconds
-      currentDeltaT = ( epoch - LIData[sat].formerEpoch );
+      currentDeltaT = ( epoch - data.formerEpoch );
 
          // Store current epoch as former epoch
-      LIData[sat].formerEpoch = epoch;
+      data.formerEpoch = epoch;
 
          // Current value of LI difference
-      currentBias = li - LIData[sat].formerLI;
+      currentBias = li - data.formerLI;
 
          // Increment window size
-      ++LIData[sat].windowSize;
+      ++data.windowSize;
 
          // Check if receiver already declared cycle slip or too much time
          // has elapsed
@@ -372,24 +375,24 @@ namespace gpstk
       {
 
             // We reset the filter with this
-         LIData[sat].windowSize = 0;
+         data.windowSize = 0;
 
          reportCS = true;
       }
 
-      if (LIData[sat].windowSize > 1)
+      if (data.windowSize > 1)
       {
          deltaLimit = minThreshold + std::abs(LIDrift*currentDeltaT);
 
             // Compute a linear interpolation and compute
             // LI_predicted - LI_current
-         delta = std::abs( currentBias - (LIData[sat].formerBias *
-                           currentDeltaT / LIData[sat].formerDeltaT) );
+         delta = std::abs( currentBias - (data.formerBias *
+                           currentDeltaT / data.formerDeltaT) );
 
          if (delta > deltaLimit)
          {
                // We reset the filter with this
-            LIData[sat].windowSize = 0;
+            data.windowSize = 0;
 
             reportCS = true;
          }
@@ -397,9 +400,9 @@ namespace gpstk
       }
 
          // Let's prepare for the next time
-      LIData[sat].formerLI = li;
-      LIData[sat].formerBias = currentBias;
-      LIData[sat].formerDeltaT = currentDeltaT;
+      data.formerLI = li;
+      data.formerBias = currentBias;
+      data.formerDeltaT = currentDeltaT;
 
       if (reportCS)
       {
@@ -33,6 +33,7 @@
 
 
 #include "ProcessingClass.hpp"
+#include "SatStateTable.hpp"
 
 
 
@@ -196,6 +197,15 @@ namespace gpstk
       { useLLI = use; return (*this); };
 
 
+         /** Method to keep the filter data in a table shared with the
+          *  other objects processing the same data stream.
+          *
+          * @param table   SatStateTable of the data stream.
+          */
+      virtual LICSDetector& setStateTable(SatStateTable& table)
+      { LIData.setTable(table); return (*this); };
+
+
          /** Returns a gnnsSatTypeValue object, adding the new data generated
           *  when calling this object.
           *
@@ -281,8 +291,8 @@ namespace gpstk
       };
 
 
-         /// Map holding the information regarding every satellite
-      std::map<SatID, filterData> LIData;
+         /// Column holding the information regarding every satellite
+      SatStateColumn<filterData> LIData;
 
 
          /** Method that implements the LI cycle slip detection algorithm
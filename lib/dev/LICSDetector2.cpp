@@ -348,15 +348,18 @@ namespace gpstk
       double tempLLI1(0.0);
       double tempLLI2(0.0);
 
+         // Filter data of this satellite
+      filterData& data( LIData[sat] );
+
 
          // Get current buffer size
-      size_t s( LIData[sat].LIEpoch.size() );
+      size_t s( data.LIEpoch.size() );
   
          // Get the difference between current epoch and LAST epoch,
          // in seconds, but first test if we have epoch data inside LIData
       if(s > 0)
       {
-         currentDeltaT = ( epoch - LIData[sat].LIEpoch.back() );
+         currentDeltaT = ( epoch - data.LIEpoch.back() );
       }
       else
       {
@@ -391,11 +394,11 @@ namespace gpstk
       {
 
             // We reset buffer with the following lines
-         LIData[sat].LIEpoch.clear();
-         LIData[sat].LIBuffer.clear();
+         data.LIEpoch.clear();
+         data.LIBuffer.clear();
 
             // current buffer size should be updated
-         s = LIData[sat].LIEpoch.size();
+         s = data.LIEpoch.size();
 
             // Report cycle slip
          reportCS = true;
@@ -412,20 +415,20 @@ namespace gpstk
             // We store here the OLDEST (or FIRST) epoch in buffer for future
             // reference. This is important because adjustment will be made
             // with respect to that first epoch
-         CommonTime firstEpoch(LIData[sat].LIEpoch.front());
+         CommonTime firstEpoch(data.LIEpoch.front());
 
             // Feed 'y' with data
          for(size_t i=0; i<s; i++)
          {
                // The newest goes first in 'y' vector
-            y(i) = LIData[sat].LIBuffer[s-1-i];
+            y(i) = data.LIBuffer[s-1-i];
          }
 
             // Feed 'M' with data
          for(size_t i=0; i<s; i++)
          {
                // Compute epoch difference with respect to FIRST epoch
-            double dT( LIData[sat].LIEpoch[s-1-i] - firstEpoch );
+            double dT( data.LIEpoch[s-1-i] - firstEpoch );
 
             M(i,0) = 1.0;
             M(i,1) = dT;
@@ -446,8 +449,8 @@ namespace gpstk
          {
                // If covMatrix can't be inverted we have a serious problem
                // with data, so reset buffer and declare cycle slip
-            LIData[sat].LIEpoch.clear();
-            LIData[sat].LIBuffer.clear();
+            data.LIEpoch.clear();
+            data.LIBuffer.clear();
 
             reportCS = true;
          }
@@ -464,13 +467,13 @@ namespace gpstk
          for(size_t i=0; i<s; i++)
          {
                // Compute epoch difference with respect to FIRST epoch
-            double dT( LIData[sat].LIEpoch[s-1-i] - firstEpoch );
+            double dT( data.LIEpoch[s-1-i] - firstEpoch );
 
                // Compute adjusted LI value
             double LIa( a(0) + a(1)*dT + a(2)*dT*dT );
 
                // Find maximum deviation in current data buffer
-            double deltaLI( std::abs(LIa - LIData[sat].LIBuffer[s-1-i]) );
+            double deltaLI( std::abs(LIa - data.LIBuffer[s-1-i]) );
             if( deltaLI > maxDeltaLI )
             {
                 maxDeltaLI = deltaLI;
@@ -499,8 +502,8 @@ namespace gpstk
             if( currentBias > deltaLimit )
             {
                   // Reset buffer and declare cycle slip
-               LIData[sat].LIEpoch.clear();
-               LIData[sat].LIBuffer.clear();
+               data.LIEpoch.clear();
+               data.LIBuffer.clear();
 
                reportCS = true;
 
@@ -518,20 +521,20 @@ namespace gpstk
          // Let's prepare for the next epoch
 
          // Store current epoch at the end of deque
-      LIData[sat].LIEpoch.push_back(epoch);
+      data.LIEpoch.push_back(epoch);
 
          // Store current value of LI at the end of deque
-      LIData[sat].LIBuffer.push_back(li);
+      data.LIBuffer.push_back(li);
 
          // Update current buffer size
-      s = LIData[sat].LIEpoch.size();
+      s = data.LIEpoch.size();
 
          // Check if we have exceeded maximum window size
       if(s > size_t(maxBufferSize))
       {
             // Get rid of oldest data, which is at the beginning of deque
-         LIData[sat].LIEpoch.pop_front();
-         LIData[sat].LIBuffer.pop_front();
+         data.LIEpoch.pop_front();
+         data.LIBuffer.pop_front();
 
       }
 
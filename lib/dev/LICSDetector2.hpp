@@ -35,6 +35,7 @@
 
 #include <deque>
 #include "ProcessingClass.hpp"
+#include "SatStateTable.hpp"
 
 
 
@@ -242,6 +243,15 @@ namespace gpstk
       virtual LICSDetector2& setMaxBufferSize(const int& maxBufSize);
 
 
+         /** Method to keep the filter data in a table shared with the
+          *  other objects processing the same data stream.
+          *
+          * @param table   SatStateTable of the data stream.
+          */
+      virtual LICSDetector2& setStateTable(SatStateTable& table)
+      { LIData.setTable(table); return (*this); };
+
+
          /** Returns a gnnsSatTypeValue object, adding the new data generated
           *  when calling this object.
           *
@@ -330,8 +340,8 @@ namespace gpstk
       };
 
 
-         /// Map holding the information regarding every satellite
-      std::map<SatID, filterData> LIData;
+         /// Column holding the information regarding every satellite
+      SatStateColumn<filterData> LIData;
 
 
          /** Method that implements the LI cycle slip detection algorithm
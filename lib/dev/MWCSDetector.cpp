@@ -307,19 +307,22 @@ namespace gpstk
       double tempLLI1(0.0);
       double tempLLI2(0.0);
 
+         // Filter data of this satellite
+      filterData& data( MWData[sat] );
+
 
          // Get the difference between current epoch and former epoch,
          // in seconds
-      currentDeltaT = ( epoch - MWData[sat].formerEpoch );
+      currentDeltaT = ( epoch - data.formerEpoch );
 
          // Store current epoch as former epoch
-      MWData[sat].formerEpoch = epoch;
+      data.formerEpoch = epoch;
 
          // Difference between current value of MW and average value
-      currentBias = std::abs(mw - MWData[sat].meanMW);
+      currentBias = std::abs(mw - data.meanMW);
 
          // Increment window size
-      ++MWData[sat].windowSize;
+      ++data.windowSize;
 
          // Check if receiver already declared cycle slip or if too much time
          // has elapsed
@@ -357,13 +360,13 @@ namespace gpstk
       {
 
             // We reset the filter with this
-         MWData[sat].windowSize = 1;
+         data.windowSize = 1;
 
          reportCS = true;                // Report cycle slip
       }
 
 
-      if (MWData[sat].windowSize > 1)
+      if (data.windowSize > 1)
       {
 
             // Test for current bias bigger than lambda limit and for
@@ -372,7 +375,7 @@ namespace gpstk
          {
 
                // We reset the filter with this
-            MWData[sat].windowSize = 1;
+            data.windowSize = 1;
 
             reportCS = true;                // Report cycle slip
 
@@ -381,23 +384,23 @@ namespace gpstk
 
          // Let's prepare for the next time
          // If a cycle-slip happened or just starting up
-      if (MWData[sat].windowSize < 2)
+      if (data.windowSize < 2)
       {
-         MWData[sat].meanMW = mw;
-         MWData[sat].varMW = 0.25*0.25;
+         data.meanMW = mw;
+         data.varMW = 0.25*0.25;
       }
       else
       {
             // MW bias from the mean value
-         double mwBias(mw - MWData[sat].meanMW);
-         double size( static_cast<double>(MWData[sat].windowSize) );
+         double mwBias(mw - data.meanMW);
+         double size( static_cast<double>(data.windowSize) );
 
             // Compute average
-         MWData[sat].meanMW += mwBias / size;
+         data.meanMW += mwBias / size;
 
             // Compute variance 
             // Var(i) = Var(i-1) + [ ( mw(i) - meanMW)^2 - Var(i-1) ]/(i);
-         MWData[sat].varMW  += ( mwBias*mwBias - MWData[sat].varMW ) / size;
+         data.varMW  += ( mwBias*mwBias - data.varMW ) / size;
 
       }
 
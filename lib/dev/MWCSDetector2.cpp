@@ -293,19 +293,22 @@ namespace gpstk
             double tempLLI1(0.0);
             double tempLLI2(0.0);
             
+            // Filter data of this satellite
+            filterData& data( MWData[sat] );
+            
             
             // Get the difference between current epoch and former epoch,
             // in seconds
-            currentDeltaT = ( epoch - MWData[sat].formerEpoch );
+            currentDeltaT = ( epoch - data.formerEpoch );
            
             // Store current epoch as former epoch
-            MWData[sat].formerEpoch = epoch;
+            data.formerEpoch = epoch;
             
             // Difference between current value of MW and average value
-            currentBias = std::abs(mw - MWData[sat].meanMW);
+            currentBias = std::abs(mw - data.meanMW);
 
             // Increment window size
-            ++MWData[sat].windowSize;
+            ++data.windowSize;
             
             
             
@@ -347,25 +350,25 @@ namespace gpstk
             {
                   
                   // We reset the filter with this
-                  MWData[sat].windowSize = 1;
+                  data.windowSize = 1;
                   
                   reportCS = true;                // Report cycle slip
             }
             
-            if (MWData[sat].windowSize > 1)
+            if (data.windowSize > 1)
             {
                   
                   // Test for current bias bigger than lambda limit and for
                   // current bias squared bigger than sigma squared limit
-                  // currentBias<4*sqrt(MWData[sat].varMW);
+                  // currentBias<4*sqrt(data.varMW);
                   
-                  lambdaLimit=4*std::sqrt(MWData[sat].varMW);
+                  lambdaLimit=4*std::sqrt(data.varMW);
 
                   if ( currentBias > lambdaLimit )
                   {
                         
                         // We reset the filter with this
-                        MWData[sat].windowSize = 1;
+                        data.windowSize = 1;
                         
                         reportCS = true;                // Report cycle slip
                         
@@ -375,26 +378,26 @@ namespace gpstk
             
             // Let's prepare for the next time
             // If a cycle-slip happened or just starting up
-            if (MWData[sat].windowSize < 2)
+            if (data.windowSize < 2)
             {
-                  MWData[sat].meanMW = mw;
+                  data.meanMW = mw;
                   //give varMW=1.0 as init
-                  MWData[sat].varMW = 0.25*0.25;
+                  data.varMW = 0.25*0.25;
             }
             else
             {
                   // MW bias from the mean value
-                  double mwBias(mw - MWData[sat].meanMW);
-                  double size( static_cast<double>(MWData[sat].windowSize) );
+                  double mwBias(mw - data.meanMW);
+                  double size( static_cast<double>(data.windowSize) );
                   
                   // Compute average
-                  MWData[sat].meanMW += mwBias / size;
+                  data.meanMW += mwBias / size;
                   
                   // Compute variance 
                   // Var(i) = Var(i-1) + [ ( mw(i) - meanMW)^2/(i)- 1*Var(i-1) ]/(i);
                   // acoording to Equations3.2,zhang ,2009. change 1/i to 1/(i^2)*( mw(i) - meanMW)^2
                   // not used yet
-                  MWData[sat].varMW  += ( mwBias*mwBias -MWData[sat].varMW ) / size;
+                  data.varMW  += ( mwBias*mwBias -data.varMW ) / size;
                   
             }
             
@@ -34,6 +34,7 @@
 
 
 #include "ProcessingClass.hpp"
+#include "SatStateTable.hpp"
 #include <list>
 
 
@@ -205,6 +206,15 @@ namespace gpstk
             { return useLLI; };
             
             
+            /** Method to keep the filter data in a table shared with the
+             *  other objects processing the same data stream.
+             *
+             * @param table   SatStateTable of the data stream.
+             */
+            virtual MWCSDetector2& setStateTable(SatStateTable& table)
+            { MWData.setTable(table); return (*this); };
+            
+            
             /** Returns a gnnsSatTypeValue object, adding the new data generated
              *  when calling this object.
              *
@@ -285,8 +295,8 @@ namespace gpstk
             };
             
             
-            /// Map holding the information regarding every satellite
-            std::map<SatID, filterData> MWData;
+            /// Column holding the information regarding every satellite
+            SatStateColumn<filterData> MWData;
             
             
             /** Method that implements the Melbourne-Wubbena cycle slip
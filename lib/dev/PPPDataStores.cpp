@@ -0,0 +1,265 @@
+#pragma ident "$Id$"
+
+/**
+ * @file PPPDataStores.cpp
+ * Data stores used by the PPP programs, loaded from the files given at the
+ * command line and in the configuration file.
+ */
+
+//============================================================================
+//
+//  This file is part of GPSTk, the GPS Toolkit.
+//
+//  The GPSTk is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU Lesser General Public License as published
+//  by the Free Software Foundation; either version 2.1 of the License, or
+//  any later version.
+//
+//  The GPSTk is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU Lesser General Public License for more details.
+//
+//  You should have received a copy of the GNU Lesser General Public
+//  License along with GPSTk; if not, write to the Free Software Foundation,
+//  Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110, USA
+//
+//============================================================================
+
+
+#include <iostream>
+#include <fstream>
+
+#include "PPPDataStores.hpp"
+
+using namespace std;
+
+namespace gpstk
+{
+
+      // Common constructor
+   PPPDataStores::PPPDataStores()
+   {
+
+         // Reject satellites with bad or absent positional values or clocks
+      SP3EphList.rejectBadPositions(true);
+      SP3EphList.rejectBadClocks(true);
+
+   }  // End of constructor 'PPPDataStores::PPPDataStores()'
+
+
+
+      // Loads the SP3 files of the given list.
+   void PPPDataStores::loadSP3FileList(const std::string& listName)
+      throw(FileMissingException)
+   {
+
+      ifstream listStream( listName.c_str(), ios::in );
+      if( !listStream )
+      {
+         FileMissingException e( "SP3 file list '" + listName
+                                 + "' doesn't exist or you don't "
+                                 + "have permission to read it." );
+         GPSTK_THROW(e);
+      }
+
+      string sp3File;
+      while( listStream >> sp3File )
+      {
+         try
+         {
+            SP3EphList.loadFile( sp3File );
+         }
+         catch(FileMissingException& e)
+         {
+               // If file doesn't exist, issue a warning
+            cerr << "SP3 file '" << sp3File << "' doesn't exist or you don't "
+                 << "have permission to read it. Skipping it." << endl;
+         }
+      }
+
+   }  // End of method 'PPPDataStores::loadSP3FileList()'
+
+
+
+      // Loads the RINEX clock files of the given list.
+   void PPPDataStores::loadClockFileList(const std::string& listName)
+      throw(FileMissingException)
+   {
+
+      ifstream listStream( listName.c_str(), ios::in );
+      if( !listStream )
+      {
+         FileMissingException e( "clock file list '" + listName
+                                 + "' doesn't exist or you don't "
+                                 + "have permission to read it." );
+         GPSTK_THROW(e);
+      }
+
+      string clkFile;
+      while( listStream >> clkFile )
+      {
+         try
+         {
+            SP3EphList.loadRinexClockFile( clkFile );
+         }
+         catch(FileMissingException& e)
+         {
+               // If file doesn't exist, issue a warning
+            cerr << "rinex CLK file '" << clkFile << "' doesn't exist or "
+                 << "you don't have permission to read it. Skipping it."
+                 << endl;
+         }
+      }
+
+   }  // End of method 'PPPDataStores::loadClockFileList()'
+
+
+
+      // Loads the IGS earth rotation parameter files of the given list.
+   void PPPDataStores::loadEOPFileList(const std::string& listName)
+      throw(FileMissingException)
+   {
+
+      ifstream listStream( listName.c_str(), ios::in );
+      if( !listStream )
+      {
+         FileMissingException e( "eop file list '" + listName
+                                 + "' doesn't exist or you don't "
+                                 + "have permission to read it." );
+         GPSTK_THROW(e);
+      }
+
+      string eopFile;
+      while( listStream >> eopFile )
+      {
+         try
+         {
+            eopStore.loadIGSFile( eopFile );
+         }
+         catch(FileMissingException& e)
+         {
+               // If file doesn't exist, issue a warning
+            cerr << "EOP file '" << eopFile << "' doesn't exist or you don't "
+                 << "have permission to read it. Skipping it." << endl;
+         }
+      }
+
+   }  // End of method 'PPPDataStores::loadEOPFileList()'
+
+
+
+      // Loads the P1-C1 DCB files of the given list.
+   void PPPDataStores::loadDCBFileList(const std::string& listName)
+      throw(FileMissingException)
+   {
+
+      ifstream listStream( listName.c_str(), ios::in );
+      if( !listStream )
+      {
+         FileMissingException e( "dcb file list '" + listName
+                                 + "' doesn't exist or you don't "
+                                 + "have permission to read it." );
+         GPSTK_THROW(e);
+      }
+
+      string dcbFile;
+      while( listStream >> dcbFile )
+      {
+         try
+         {
+            dcbStore.open( dcbFile );
+         }
+         catch(FileMissingException& e)
+         {
+            e.addText( "The DCB file '" + dcbFile + "' does not exist!" );
+            GPSTK_RETHROW(e);
+         }
+      }
+
+   }  // End of method 'PPPDataStores::loadDCBFileList()'
+
+
+
+      // Loads the ocean loading data of the given BLQ file.
+   void PPPDataStores::loadBLQFile(const std::string& fileName)
+      throw(FileMissingException)
+   {
+
+      try
+      {
+         blqStore.open( fileName );
+      }
+      catch(FileMissingException& e)
+      {
+         e.addText( "BLQ file '" + fileName + "' doesn't exist or you "
+                    + "don't have permission to read it." );
+         GPSTK_RETHROW(e);
+      }
+
+   }  // End of method 'PPPDataStores::loadBLQFile()'
+
+
+
+      // Loads the monitor station coordinates of the given MSC file.
+   void PPPDataStores::loadMSCFile(const std::string& fileName)
+      throw(FileMissingException, FFStreamError)
+   {
+
+      try
+      {
+         mscStore.loadFile( fileName );
+      }
+      catch(FFStreamError& e)
+      {
+         e.addText( "MSC file '" + fileName + "' format is not supported." );
+         GPSTK_RETHROW(e);
+      }
+      catch(FileMissingException& e)
+      {
+         e.addText( "MSC file '" + fileName + "' doesn't exist or you "
+                    + "don't have permission to read it." );
+         GPSTK_RETHROW(e);
+      }
+
+   }  // End of method 'PPPDataStores::loadMSCFile()'
+
+
+
+      // Returns the coordinates of a station at the given epoch.
+   Position PPPDataStores::getNominalPosition( const std::string& station,
+                                               const CommonTime& time ) const
+      throw(InvalidRequest)
+   {
+
+         // The MSC store keeps its epochs without time system
+      CommonTime mscTime( time );
+      mscTime.setTimeSystem(TimeSystem::Unknown);
+
+      try
+      {
+         return Position( mscStore.findMSC( station, mscTime ).coordinates );
+      }
+      catch(InvalidRequest& e)
+      {
+         e.addText( "The station " + station
+                    + " isn't included in MSC file." );
+         GPSTK_RETHROW(e);
+      }
+
+   }  // End of method 'PPPDataStores::getNominalPosition()'
+
+
+
+      // Clears the SP3, EOP and MSC stores.
+   void PPPDataStores::clear()
+   {
+
+      SP3EphList.clear();
+      eopStore.clear();
+      mscStore.clear();
+
+   }  // End of method 'PPPDataStores::clear()'
+
+
+}  // End of namespace gpstk
@@ -0,0 +1,179 @@
+#pragma ident "$Id$"
+
+/**
+ * @file PPPDataStores.hpp
+ * Data stores used by the PPP programs, loaded from the files given at the
+ * command line and in the configuration file.
+ */
+
+#ifndef GPSTK_PPPDATASTORES_HPP
+#define GPSTK_PPPDATASTORES_HPP
+
+//============================================================================
+//
+//  This file is part of GPSTk, the GPS Toolkit.
+//
+//  The GPSTk is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU Lesser General Public License as published
+//  by the Free Software Foundation; either version 2.1 of the License, or
+//  any later version.
+//
+//  The GPSTk is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU Lesser General Public License for more details.
+//
+//  You should have received a copy of the GNU Lesser General Public
+//  License along with GPSTk; if not, write to the Free Software Foundation,
+//  Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110, USA
+//
+//============================================================================
+
+
+#include <string>
+
+#include "Exception.hpp"
+#include "FFStream.hpp"
+#include "CommonTime.hpp"
+#include "Position.hpp"
+#include "SP3EphemerisStore.hpp"
+#include "BLQDataReader.hpp"
+#include "EOPDataStore.hpp"
+#include "DCBDataReader.hpp"
+#include "MSCStore.hpp"
+
+
+
+namespace gpstk
+{
+
+      /** @addtogroup GPSsolutions */
+      //@{
+
+
+      /** This class holds the data stores needed by the PPP processing:
+       *  precise orbits and clocks, ocean loading, earth orientation, P1-C1
+       *  DCB and monitor station coordinates.
+       *
+       * The SP3, clock, EOP and DCB files are given as lists, i.e., files
+       * holding one file name after another. A file of a list that can not
+       * be found is reported on the standard error and skipped, except for
+       * the DCB files, which are all needed; a list, a BLQ file or a MSC
+       * file that can not be found makes the methods throw.
+       *
+       * A typical way to use this class follows:
+       *
+       * @code
+       *   PPPDataStores stores;
+       *
+       *   stores.loadSP3FileList("sp3.list");
+       *   stores.loadEOPFileList("eop.list");
+       *   stores.loadBLQFile( confReader.getValue("oceanLoadingFile") );
+       *   stores.loadMSCFile("stations.msc");
+       *
+       *   Position nominalPos( stores.getNominalPosition(station, time) );
+       * @endcode
+       *
+       * @sa PPPProcessing, which builds the processing on these stores.
+       */
+   class PPPDataStores
+   {
+   public:
+
+         /** Common constructor. Satellites with bad or absent positions
+          *  or clocks are rejected by the SP3 store.
+          */
+      PPPDataStores();
+
+
+         /** Loads the SP3 files of the given list.
+          *
+          * @param listName   File holding the names of the SP3 files.
+          */
+      virtual void loadSP3FileList(const std::string& listName)
+         throw(FileMissingException);
+
+
+         /** Loads the RINEX clock files of the given list. Their clocks
+          *  replace those of the SP3 files.
+          *
+          * @param listName   File holding the names of the clock files.
+          */
+      virtual void loadClockFileList(const std::string& listName)
+         throw(FileMissingException);
+
+
+         /** Loads the IGS earth rotation parameter files of the given list.
+          *
+          * @param listName   File holding the names of the EOP files.
+          */
+      virtual void loadEOPFileList(const std::string& listName)
+         throw(FileMissingException);
+
+
+         /** Loads the P1-C1 DCB files of the given list.
+          *
+          * @param listName   File holding the names of the DCB files.
+          */
+      virtual void loadDCBFileList(const std::string& listName)
+         throw(FileMissingException);
+
+
+         /** Loads the ocean loading data of the given BLQ file.
+          *
+          * @param fileName   Name of the BLQ file.
+          */
+      virtual void loadBLQFile(const std::string& fileName)
+         throw(FileMissingException);
+
+
+         /** Loads the monitor station coordinates of the given MSC file.
+          *
+          * @param fileName   Name of the MSC file.
+          */
+      virtual void loadMSCFile(const std::string& fileName)
+         throw(FileMissingException, FFStreamError);
+
+
+         /** Returns the coordinates of a station at the given epoch, as
+          *  found in the MSC file.
+          *
+          * @param station    Name of the station.
+          * @param time       Epoch, in any time system.
+          */
+      virtual Position getNominalPosition( const std::string& station,
+                                           const CommonTime& time ) const
+         throw(InvalidRequest);
+
+
+         /// Clears the SP3, EOP and MSC stores.
+      virtual void clear();
+
+
+         /// Destructor
+      virtual ~PPPDataStores() {};
+
+
+         /// Precise orbits and clocks
+      SP3EphemerisStore SP3EphList;
+
+         /// Ocean loading data
+      BLQDataReader blqStore;
+
+         /// Earth rotation parameters
+      EOPDataStore eopStore;
+
+         /// P1-C1 DCB data
+      DCBDataReader dcbStore;
+
+         /// Monitor station coordinates
+      MSCStore mscStore;
+
+
+   }; // End of class 'PPPDataStores'
+
+      //@}
+
+}  // End of namespace gpstk
+
+#endif   // GPSTK_PPPDATASTORES_HPP
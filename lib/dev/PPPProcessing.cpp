@@ -0,0 +1,321 @@
+#pragma ident "$Id$"
+
+/**
+ * @file PPPProcessing.cpp
+ * Processing of the PPP programs, from the raw observations of a station to
+ * the prefit residuals the PPP solvers take.
+ */
+
+//============================================================================
+//
+//  This file is part of GPSTk, the GPS Toolkit.
+//
+//  The GPSTk is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU Lesser General Public License as published
+//  by the Free Software Foundation; either version 2.1 of the License, or
+//  any later version.
+//
+//  The GPSTk is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU Lesser General Public License for more details.
+//
+//  You should have received a copy of the GNU Lesser General Public
+//  License along with GPSTk; if not, write to the Free Software Foundation,
+//  Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110, USA
+//
+//============================================================================
+
+
+#include "PPPProcessing.hpp"
+#include "Antenna.hpp"
+
+using namespace std;
+
+namespace gpstk
+{
+
+      // Returns a string identifying this object.
+   std::string PPPProcessing::getClassName() const
+   { return "PPPProcessing"; }
+
+
+
+      // Common constructor
+   PPPProcessing::PPPProcessing( ConfDataReader& confReader,
+                                 PPPDataStores& stores,
+                                 const std::string& sta,
+                                 const Position& staPos,
+                                 const CommonTime& initialTime,
+                                 const std::string& recType,
+                                 const std::string& antType,
+                                 const Triple& offsetARP )
+      : station(sta),
+        nominalPos(staPos),
+        neillTM(staPos, initialTime),
+        cc2noncc(stores.dcbStore),
+        decimateData( confReader.getValueAsDouble("decimationInterval"),
+                      confReader.getValueAsDouble("decimationTolerance"),
+                      initialTime ),
+        basic(staPos, stores.SP3EphList),
+        grDelay(staPos),
+        svPcenter(staPos),
+        corr(stores.SP3EphList),
+        windup(stores.SP3EphList, staPos),
+        computeTropo(neillTM),
+        linear4(comb.pcPrefit),
+        baseChange(staPos),
+        ocean(stores.blqStore),
+        pole(stores.eopStore)
+   {
+
+         // We will need this value later for printing
+      dryTropo = neillTM.dry_zenith_delay();
+
+
+         // Read the receiver type file
+      cc2noncc.loadRecTypeFile( confReader.getValue("recTypeFile") );
+      cc2noncc.setRecType(recType);
+      cc2noncc.setCopyC1ToP1(true);
+      pList.push_back(cc2noncc);
+
+
+         // Check that all required observables are present
+      requireObs.addRequiredType(TypeID::P1);
+      requireObs.addRequiredType(TypeID::P2);
+      requireObs.addRequiredType(TypeID::L1);
+      requireObs.addRequiredType(TypeID::L2);
+      pList.push_back(requireObs);
+
+
+         // Check that code observations are within reasonable limits
+      pObsFilter.addFilteredType(TypeID::P1);
+      pObsFilter.setFilteredType(TypeID::P2);
+
+         // IMPORTANT NOTE:
+         // It turns out that some receivers don't correct their clocks
+         // from drift.
+         // When this happens, their code observations may drift well beyond
+         // what it is usually expected from a pseudorange. In turn, this
+         // effect causes that "SimpleFilter" objects start to reject a lot of
+         // satellites.
+         // Thence, the "filterCode" option allows you to deactivate the
+         // "SimpleFilter" object that filters out C1, P1 and P2, in case you
+         // need to.
+      if( confReader.getValueAsBoolean("filterCode") )
+      {
+         pList.push_back(pObsFilter);
+      }
+
+
+         // Linear combinations for cycle slip detection
+      linear1.addLinear(comb.pdeltaCombination);
+      linear1.addLinear(comb.mwubbenaCombination);
+      linear1.addLinear(comb.ldeltaCombination);
+      linear1.addLinear(comb.liCombination);
+      pList.push_back(linear1);
+
+
+         // Mark cycle slips, with LI and Melbourne-Wubbena
+      markCSLI.setStateTable(satStates);
+      pList.push_back(markCSLI);
+      markCSMW.setStateTable(satStates);
+      pList.push_back(markCSMW);
+
+
+         // Keep track of satellite arcs
+         // Notes: delete unstable satellite may cause discontinuity
+         //        in the network processing!
+      markArc.setDeleteUnstableSats(false);
+      markArc.setUnstablePeriod(151.0);
+      markArc.setStateTable(satStates);
+      pList.push_back(markArc);
+
+
+      pList.push_back(decimateData);
+
+
+         // Basic modeler, using P1 instead of C1
+      basic.setMinElev( confReader.getValueAsDouble("cutOffElevation") );
+      basic.setDefaultObservable(TypeID::P1);
+      pList.push_back(basic);
+
+
+      pList.push_back(elevWeights);
+      pList.push_back(eclipsedSV);
+      pList.push_back(grDelay);
+
+
+         // Check if we want to use Antex information
+      bool useantex( confReader.getValueAsBoolean("useAntex") );
+      Antenna receiverAntenna;
+      if( useantex )
+      {
+            // Feed Antex reader object with Antex file
+         antexReader.open( confReader.getValue("antexFile") );
+
+            // Get receiver antenna parameters
+            // Warning: If no corrections are not found for one specific
+            //          radome, then the antenna with radome NONE are used.
+         string antennaModel( antType );
+         try
+         {
+            receiverAntenna = antexReader.getAntenna( antennaModel );
+         }
+         catch(ObjectNotFound& notFound)
+         {
+            antennaModel.resize(20, ' ');
+            antennaModel.replace(16, 4, "NONE");
+            receiverAntenna = antexReader.getAntenna( antennaModel );
+         }
+
+         svPcenter.setAntexReader( antexReader );
+      }
+      pList.push_back(svPcenter);
+
+
+         // Correct observables to monument
+      corr.setNominalPosition(nominalPos);
+      corr.setMonument( offsetARP );
+
+         // Check if we want to use Antex patterns
+      if( useantex && confReader.getValueAsBoolean("usePCPatterns") )
+      {
+         corr.setAntenna( receiverAntenna );
+
+            // Should we use elevation/azimuth patterns or just elevation?
+         corr.setUseAzimuth( confReader.getValueAsBoolean("useAzim") );
+      }
+      else
+      {
+         Triple offsetL1( 0.0, 0.0, 0.0 ), offsetL2( 0.0, 0.0, 0.0 );
+
+            // Vector from antenna ARP to L1 phase center [UEN], in meters
+         offsetL1[0] = confReader.fetchListValueAsDouble("offsetL1");
+         offsetL1[1] = confReader.fetchListValueAsDouble("offsetL1");
+         offsetL1[2] = confReader.fetchListValueAsDouble("offsetL1");
+
+            // Vector from antenna ARP to L2 phase center [UEN], in meters
+         offsetL2[0] = confReader.fetchListValueAsDouble("offsetL2");
+         offsetL2[1] = confReader.fetchListValueAsDouble("offsetL2");
+         offsetL2[2] = confReader.fetchListValueAsDouble("offsetL2");
+
+         corr.setL1pc( offsetL1 );
+         corr.setL2pc( offsetL2 );
+      }
+      pList.push_back(corr);
+
+
+         // Wind-up effect
+      if( useantex )
+      {
+         windup.setAntexReader( antexReader );
+      }
+      pList.push_back(windup);
+
+
+      pList.push_back(computeTropo);
+
+
+         // Code combinations with minus ionospheric delays, for L1/L2
+         // calibration, and alignment of phases with them
+      linear2.addLinear(comb.q1Combination);
+      linear2.addLinear(comb.q2Combination);
+      pList.push_back(linear2);
+
+      phaseAlignL1.setCodeType(TypeID::Q1);
+      phaseAlignL1.setPhaseType(TypeID::L1);
+      phaseAlignL1.setPhaseWavelength( 0.190293672798 );
+      phaseAlignL1.setStateTable(satStates);
+      pList.push_back(phaseAlignL1);
+
+      phaseAlignL2.setCodeType(TypeID::Q2);
+      phaseAlignL2.setPhaseType(TypeID::L2);
+      phaseAlignL2.setPhaseWavelength( 0.244210213425 );
+      phaseAlignL2.setStateTable(satStates);
+      pList.push_back(phaseAlignL2);
+
+
+         // Ionosphere-free combinations, the observables of the PPP
+      linear3.addLinear(comb.pcCombination);
+      linear3.addLinear(comb.lcCombination);
+      pList.push_back(linear3);
+
+
+         // Like in the "filterCode" case, the "filterPC" option allows you
+         // to deactivate the "SimpleFilter" object that filters out PC
+      pcFilter.setFilteredType(TypeID::PC);
+      if( confReader.getValueAsBoolean("filterPC") )
+      {
+         pList.push_back(pcFilter);
+      }
+
+
+      linear5.addLinear(comb.mwubbenaCombination);
+      pList.push_back(linear5);
+
+
+         // Prefit residuals
+      linear4.addLinear(comb.lcPrefit);
+      pList.push_back(linear4);
+
+
+         // We always need both ECEF and NEU data for 'ComputeDOP'
+      pList.push_back(baseChange);
+      pList.push_back(cDOP);
+
+   }  // End of constructor 'PPPProcessing::PPPProcessing()'
+
+
+
+      /* Returns a gnnsSatTypeValue object, adding the new data generated
+       * when calling this object.
+       *
+       * @param gData     Data object holding the data.
+       */
+   gnssSatTypeValue& PPPProcessing::Process(gnssSatTypeValue& gData)
+   {
+
+      gData.header.source.nominalPos = nominalPos;
+
+      setTides(gData.header.epoch);
+
+      return pList.Process(gData);
+
+   }  // End of method 'PPPProcessing::Process()'
+
+
+
+      /* Returns a gnnsRinex object, adding the new data generated when
+       * calling this object.
+       *
+       * @param gData     Data object holding the data.
+       */
+   gnssRinex& PPPProcessing::Process(gnssRinex& gData)
+   {
+
+      gData.header.source.nominalPos = nominalPos;
+
+      setTides(gData.header.epoch);
+
+      return pList.Process(gData);
+
+   }  // End of method 'PPPProcessing::Process()'
+
+
+
+      // Computes the tides at the station and hands them over to 'corr'
+   void PPPProcessing::setTides(const CommonTime& time)
+   {
+
+         // Compute solid, oceanic and pole tides effects at this epoch
+      Triple tides( solid.getSolidTide( time, nominalPos )  +
+                    ocean.getOceanLoading( station, time )  +
+                    pole.getPoleTide( time, nominalPos )    );
+
+      corr.setExtraBiases(tides);
+
+   }  // End of method 'PPPProcessing::setTides()'
+
+
+}  // End of namespace gpstk
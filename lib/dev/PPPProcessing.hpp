@@ -0,0 +1,236 @@
+#pragma ident "$Id$"
+
+/**
+ * @file PPPProcessing.hpp
+ * Processing of the PPP programs, from the raw observations of a station to
+ * the prefit residuals the PPP solvers take.
+ */
+
+#ifndef GPSTK_PPPPROCESSING_HPP
+#define GPSTK_PPPPROCESSING_HPP
+
+//============================================================================
+//
+//  This file is part of GPSTk, the GPS Toolkit.
+//
+//  The GPSTk is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU Lesser General Public License as published
+//  by the Free Software Foundation; either version 2.1 of the License, or
+//  any later version.
+//
+//  The GPSTk is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU Lesser General Public License for more details.
+//
+//  You should have received a copy of the GNU Lesser General Public
+//  License along with GPSTk; if not, write to the Free Software Foundation,
+//  Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110, USA
+//
+//============================================================================
+
+
+#include <string>
+
+#include "ProcessingClass.hpp"
+#include "ProcessingList.hpp"
+#include "ConfDataReader.hpp"
+#include "PPPDataStores.hpp"
+#include "CC2NONCC.hpp"
+#include "RequireObservables.hpp"
+#include "SimpleFilter.hpp"
+#include "LinearCombinations.hpp"
+#include "ComputeLinear.hpp"
+#include "SatStateTable.hpp"
+#include "LICSDetector.hpp"
+#include "MWCSDetector2.hpp"
+#include "SatArcMarker2.hpp"
+#include "Decimate.hpp"
+#include "BasicModel.hpp"
+#include "ComputeElevWeights.hpp"
+#include "EclipsedSatFilter.hpp"
+#include "GravitationalDelay.hpp"
+#include "AntexReader.hpp"
+#include "ComputeSatPCenter.hpp"
+#include "CorrectObservables.hpp"
+#include "ComputeWindUp.hpp"
+#include "TropModel.hpp"
+#include "ComputeTropModel.hpp"
+#include "PhaseCodeAlignment.hpp"
+#include "XYZ2NEU.hpp"
+#include "ComputeDOP.hpp"
+#include "SolidTides.hpp"
+#include "OceanLoading.hpp"
+#include "PoleTides.hpp"
+
+
+
+namespace gpstk
+{
+
+      /** @addtogroup GPSsolutions */
+      //@{
+
+
+      /** This class processes the observations of one station the way the
+       *  PPP programs do, up to the prefit residuals of PC and LC, so that
+       *  they only need to add a PPP solver.
+       *
+       * The processing objects are set up from the configuration file, as
+       * described in the default 'ppp.conf', and from the data stores. Each
+       * epoch, the solid, ocean and pole tides at the station are computed
+       * and handed to the object correcting the observables.
+       *
+       * A typical way to use this class follows:
+       *
+       * @code
+       *   PPPProcessing pppModel( confReader, stores, station, nominalPos,
+       *                           roh.firstObs, roh.recType, roh.antType,
+       *                           roh.antennaOffset );
+       *   SolverPPP pppSolver;
+       *
+       *   while(rin >> gRin)
+       *   {
+       *      gRin >> pppModel >> pppSolver;
+       *   }
+       * @endcode
+       *
+       * The processing objects keep pointers to one another and to the
+       * data stores, so objects of this class can not be copied, and the
+       * stores must outlive them.
+       */
+   class PPPProcessing : public ProcessingClass
+   {
+   public:
+
+         /** Common constructor.
+          *
+          * @param confReader    Configuration file reader.
+          * @param stores        Data stores to use.
+          * @param station       Name of the station, as in the BLQ file.
+          * @param nominalPos    Nominal position of the station.
+          * @param initialTime   First epoch, where decimation starts.
+          * @param recType       Receiver type, as in the RINEX header.
+          * @param antType       Antenna type, as in the RINEX header.
+          * @param offsetARP     Vector from monument to antenna ARP [UEN],
+          *                      in meters.
+          */
+      PPPProcessing( ConfDataReader& confReader,
+                     PPPDataStores& stores,
+                     const std::string& station,
+                     const Position& nominalPos,
+                     const CommonTime& initialTime,
+                     const std::string& recType,
+                     const std::string& antType,
+                     const Triple& offsetARP );
+
+
+         /** Returns a gnnsSatTypeValue object, adding the new data
+          *  generated when calling this object.
+          *
+          * The exceptions of the processing objects, such as
+          * DecimateEpoch, are thrown unaltered.
+          *
+          * @param gData     Data object holding the data.
+          */
+      virtual gnssSatTypeValue& Process(gnssSatTypeValue& gData);
+
+
+         /** Returns a gnnsRinex object, adding the new data generated when
+          *  calling this object.
+          *
+          * @param gData     Data object holding the data.
+          */
+      virtual gnssRinex& Process(gnssRinex& gData);
+
+
+         /// Returns the object computing the DOP values.
+      virtual const ComputeDOP& getDOP() const
+      { return cDOP; };
+
+
+         /// Returns the dry zenith tropospheric delay, in meters.
+      virtual double getDryTropo() const
+      { return dryTropo; };
+
+
+         /// Returns a string identifying this object.
+      virtual std::string getClassName(void) const;
+
+
+         /// Destructor
+      virtual ~PPPProcessing() {};
+
+
+   private:
+
+
+         /// Computes the tides at the station and hands them over to 'corr'
+      void setTides(const CommonTime& time);
+
+
+         /// Name and nominal position of the station
+      std::string station;
+      Position nominalPos;
+
+         /// Predefined linear combinations
+      LinearCombinations comb;
+
+         /// State of the satellites, shared by the objects below
+      SatStateTable satStates;
+
+         /// Antenna parameters
+      AntexReader antexReader;
+
+         /// Neill tropospheric model, and its dry zenith delay
+      NeillTropModel neillTM;
+      double dryTropo;
+
+         /// Processing objects, in the order they are applied
+      CC2NONCC cc2noncc;
+      RequireObservables requireObs;
+      SimpleFilter pObsFilter;
+      ComputeLinear linear1;
+      LICSDetector markCSLI;
+      MWCSDetector2 markCSMW;
+      SatArcMarker2 markArc;
+      Decimate decimateData;
+      BasicModel basic;
+      ComputeElevWeights elevWeights;
+      EclipsedSatFilter eclipsedSV;
+      GravitationalDelay grDelay;
+      ComputeSatPCenter svPcenter;
+      CorrectObservables corr;
+      ComputeWindUp windup;
+      ComputeTropModel computeTropo;
+      ComputeLinear linear2;
+      PhaseCodeAlignment phaseAlignL1;
+      PhaseCodeAlignment phaseAlignL2;
+      ComputeLinear linear3;
+      SimpleFilter pcFilter;
+      ComputeLinear linear5;
+      ComputeLinear linear4;
+      XYZ2NEU baseChange;
+      ComputeDOP cDOP;
+
+         /// List of the processing objects
+      ProcessingList pList;
+
+         /// Tide models
+      SolidTides solid;
+      OceanLoading ocean;
+      PoleTides pole;
+
+
+         /// Objects of this class can not be copied
+      PPPProcessing(const PPPProcessing&);
+      PPPProcessing& operator=(const PPPProcessing&);
+
+
+   }; // End of class 'PPPProcessing'
+
+      //@}
+
+}  // End of namespace gpstk
+
+#endif   // GPSTK_PPPPROCESSING_HPP
@@ -102,8 +102,9 @@ namespace gpstk
             // Get polar motion from files (shjzhang)
          if(pEOPStore != NULL)
          {
-            xdisp = (*pEOPStore).getXPole(UTC);
-            ydisp = (*pEOPStore).getYPole(UTC);
+            EOPDataStore::EOPData eop( (*pEOPStore).getEOPData(UTC) );
+            xdisp = eop.xp;
+            ydisp = eop.yp;
          }
 
             // Now, compute m1 and m2 parameters
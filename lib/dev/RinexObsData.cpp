@@ -52,9 +52,6 @@ using namespace std;
 namespace gpstk
 {
 
-      // Definition of static variable to be used across RinexObsData objects
-   CommonTime gpstk::RinexObsData::previousTime;
-
    void RinexObsData::reallyPutRecord(FFStream& ffs) const
       throw(std::exception, FFStreamError, StringException)
    {
@@ -261,12 +258,12 @@ namespace gpstk
       }
       else if (noEpochTime)
       {
-         time = previousTime;
+         time = strm.previousTime;
       }
       else
       {
          time = parseTime(line, hdr);
-         previousTime = time;
+         strm.previousTime = time;
       }
 
       numSvs = asInt(line.substr(29,3));
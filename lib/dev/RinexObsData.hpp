@@ -154,10 +154,6 @@ namespace gpstk
                gpstk::StringUtils::StringException);
 
    private:
-         ///<Time corresponding to previous set of oberservations
-         /// Used in cases where epoch time of a epoch flag==0
-      static gpstk::CommonTime previousTime;
-
          /// Writes the CommonTime object into RINEX format. If it's a bad time,
          /// it will return blanks.
       std::string writeTime(const CommonTime& dt) const
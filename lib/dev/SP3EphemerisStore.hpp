@@ -180,6 +180,12 @@ namespace gpstk
       virtual bool hasVelocity() const throw()
          {  return posStore.hasVelocity(); }
 
+      /// Queries only read the data tables, so there is nothing to prepare
+      /// before sharing the store between threads; see XvtStore::freeze().
+      /// Neither the data nor the settings may be changed meanwhile.
+      virtual bool isFrozen(void) const throw()
+         { return true; }
+
    // end of XvtStore interface
 
       /// Dump information about the position store to an ostream.
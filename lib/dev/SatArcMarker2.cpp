@@ -117,10 +117,10 @@ namespace gpstk
        */
    CommonTime SatArcMarker2::getArcChangedEpoch(const SatID& sat)
    {
-      std::map<SatID, CommonTime>::iterator it = satArcChangeMap.find(sat);
-      if(it!=satArcChangeMap.end())
+      const arcData* pData( satArcData.find(sat) );
+      if(pData != NULL)
       {
-         return it->second;
+         return pData->arcChangeEpoch;
       }
       else
       {
@@ -176,24 +176,17 @@ namespace gpstk
                continue;
             }
 
-               // Check if satellite currently has entries
-            std::map<SatID, double>::const_iterator itArc(
-                                                satArcMap.find( (*it).first ) );
-            if( itArc == satArcMap.end() )
-            {
-                  // If it doesn't have an entry, insert one
-               satArcMap[ (*it).first ] = 0.0;
-               satArcChangeMap[ (*it).first ] = CommonTime::BEGINNING_OF_TIME;
-            }
+               // Arc data of this satellite, inserted if it has none
+            arcData& data( satArcData[ (*it).first ] );
 
                // Check if there was a cycle slip
             if ( flag > 0.0 )
             {
                   // Increment the value of "TypeID::satArc"
-               satArcMap[ (*it).first ] = satArcMap[ (*it).first ] + 1.0;
+               data.arcNumber = data.arcNumber + 1.0;
 
                   // Update arc change epoch
-               satArcChangeMap[ (*it).first ] = epoch;
+               data.arcChangeEpoch = epoch;
 
                   // If we want to delete unstable satellites, we must do it
                   // also when arc changes, whether or not this SV is new
@@ -205,7 +198,7 @@ namespace gpstk
 
 
                // Check if we are inside unstable period
-            bool insideUnstable(std::abs(epoch-satArcChangeMap[(*it).first]) <=
+            bool insideUnstable( std::abs(epoch-data.arcChangeEpoch) <=
                                                                unstablePeriod );
 
                // Test if we want to delete unstable satellites. Only do if this
@@ -219,7 +212,7 @@ namespace gpstk
             }
 
                // We will insert satellite arc number
-            (*it).second[TypeID::satArc] = satArcMap[ (*it).first ];
+            (*it).second[TypeID::satArc] = data.arcNumber;
                // set default watchCSFlag
             watchCSFlag = TypeID::CSL1;
          }
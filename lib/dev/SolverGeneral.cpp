@@ -42,6 +42,11 @@
 
 #include "SolverGeneral.hpp"
 #include "SystemTime.hpp"
+#include <vector>
+#include <map>
+#include <set>
+#include <algorithm>
+#include <cmath>
 
 namespace gpstk
 {
@@ -50,6 +55,23 @@ namespace gpstk
    int SolverGeneral::classIndex = 9600000;
 
 
+      // Returns true if all the elements out of the diagonal are zero.
+   static bool isDiagonal(const Matrix<double>& m)
+   {
+      if( !m.isSquare() ) return false;
+
+      for(size_t i=0; i<m.rows(); i++)
+      {
+         for(size_t j=0; j<m.cols(); j++)
+         {
+            if( i!=j && m(i,j)!=0.0 ) return false;
+         }
+      }
+
+      return true;
+   }
+
+
       // Returns an index identifying this object.
    int SolverGeneral::getIndex() const
    { return index; }
@@ -66,7 +88,8 @@ namespace gpstk
        *                      to be solved.
        */
    SolverGeneral::SolverGeneral( const std::list<Equation>& equationList )
-      : firstTime(true)
+      : firstTime(true), networkMode(false),
+        batchWindow(0), batchEpoch(0), batchNextSlot(0)
    {
 
          // Visit each "Equation" in 'equationList' and add them to 'equSystem'
@@ -248,8 +271,23 @@ namespace gpstk
             // Get the set with unknowns being processed
          VariableSet unkSet( equSystem.getVarUnknowns() );
 
-            // Feed the filter with the correct state and covariance matrix
-         if(firstTime)
+            // Feed the filter with the correct state and covariance matrix,
+            // unless the batch window holds it
+         if( batchWindow > 0 )
+         {
+            if(firstTime)
+            {
+               batchRows.clear();
+               batchSlotEpoch.clear();
+               batchSlots.clear();
+               batchPriorSlots.clear();
+               batchPriorInfo.resize(0, 0);
+               batchPriorVec.resize(0);
+
+               firstTime = false;
+            }
+         }
+         else if(firstTime)
          {
 
             Vector<double> initialState(numUnknowns, 0.0);
@@ -385,6 +423,14 @@ namespace gpstk
       throw(InvalidSolver)
    {
 
+         // In batch mode, the window is solved instead
+      if( batchWindow > 0 )
+      {
+         BatchUpdate( measVector, hMatrix, rMatrix );
+
+         return gdsMap;
+      }
+
       clock_t start,finish;
       double totaltime;
       start=clock();
@@ -400,7 +446,14 @@ namespace gpstk
 
          // Call the MeasUpdate() of the kalman filter, which will update the 
          // state vector and their covariance using new measurements.
-      MeasUpdate( measVector, hMatrix, rMatrix );
+      if( networkMode )
+      {
+         MeasUpdateNetwork( measVector, hMatrix, rMatrix );
+      }
+      else
+      {
+         MeasUpdate( measVector, hMatrix, rMatrix );
+      }
 
       finish=clock();
       totaltime=(double)(finish-start)/CLOCKS_PER_SEC;
@@ -466,13 +519,34 @@ of qMatrix");
 
       try
       {
-            // Compute the a priori state vector
-         xhatminus = phiMatrix*xhat;
+         if( networkMode &&
+             isDiagonal(phiMatrix) &&
+             isDiagonal(processNoiseCovariance) )
+         {
+               // Same products, element by element
+            xhatminus.resize(numUnknowns);
+            Pminus.resize(numUnknowns, numUnknowns);
+            for(int i=0; i<numUnknowns; i++)
+            {
+               const double phii( phiMatrix(i,i) );
+               xhatminus(i) = phii*xhat(i);
+               for(int j=0; j<numUnknowns; j++)
+               {
+                  Pminus(i,j) = (phii*P(i,j))*phiMatrix(j,j);
+               }
+               Pminus(i,i) += processNoiseCovariance(i,i);
+            }
+         }
+         else
+         {
+               // Compute the a priori state vector
+            xhatminus = phiMatrix*xhat;
 
-         Matrix<double> phiT(transpose(phiMatrix));
+            Matrix<double> phiT(transpose(phiMatrix));
 
-            // Compute the a priori estimate error covariance matrix
-         Pminus = phiMatrix*P*phiT + processNoiseCovariance;
+               // Compute the a priori estimate error covariance matrix
+            Pminus = phiMatrix*P*phiT + processNoiseCovariance;
+         }
 
       }
       catch(...)
@@ -613,6 +687,897 @@ matrix and a priori state estimation vector do not match.");
 
 
 
+      // Correct the state vector and covariance matrix in network mode.
+      //
+      // The information matrix N = inverse(Pminus) + H'*W*H and vector
+      // b = inverse(Pminus)*xhatminus + H'*W*z are built from the nonzero
+      // elements of H. With the station blocks S_k and the common block C:
+      //
+      //    N = | B_k  E_k |    X_k = inverse(B_k)*E_k
+      //        | E_k' G   |    Sc  = G - sum(E_k'*X_k)
+      //
+      // and then P_CC = inverse(Sc), P_kC = -X_k*P_CC,
+      // P_kl = delta_kl*inverse(B_k) + X_k*P_CC*X_l'.
+      //
+   int SolverGeneral::MeasUpdateNetwork( const Vector<double>& prefitResiduals,
+                                         const Matrix<double>& designMatrix,
+                                         const Matrix<double>& weightMatrix )
+      throw(InvalidSolver)
+   {
+
+         // The observations must be independent
+      if( !isDiagonal(weightMatrix) )
+      {
+         return MeasUpdate( prefitResiduals, designMatrix, weightMatrix );
+      }
+
+         // By default, results are invalid
+      valid = false;
+
+      const int n = static_cast<int>(xhatminus.size());
+      const int m = static_cast<int>(prefitResiduals.size());
+
+      if( static_cast<int>(weightMatrix.rows()) != m      ||
+          static_cast<int>(designMatrix.rows()) != m      ||
+          static_cast<int>(designMatrix.cols()) != n      ||
+          static_cast<int>(Pminus.rows()) != n            ||
+          static_cast<int>(Pminus.cols()) != n )
+      {
+         InvalidSolver e("MeasUpdateNetwork(): Sizes of the measurement \
+update do not match.");
+         GPSTK_THROW(e);
+      }
+
+
+         // A priori information. Unknowns without a priori correlation,
+         // like the white noise ones, get the inverse of their variance,
+         // and the others the inverse of their covariance matrix.
+      Matrix<double> N(n, n, 0.0);
+      Vector<double> b(n, 0.0);
+
+      std::vector<int> corr;
+      for(int i=0; i<n; i++)
+      {
+         bool correlated(false);
+         for(int j=0; j<n && !correlated; j++)
+         {
+            correlated = ( j!=i && Pminus(i,j)!=0.0 );
+         }
+
+         if( correlated )
+         {
+            corr.push_back(i);
+         }
+         else
+         {
+            if( !(Pminus(i,i) > 0.0) )
+            {
+               InvalidSolver e("MeasUpdateNetwork(): Unable to compute \
+invPMinus matrix.");
+               GPSTK_THROW(e);
+            }
+            N(i,i) = 1.0/Pminus(i,i);
+            b(i) = N(i,i)*xhatminus(i);
+         }
+      }
+
+      if( !corr.empty() )
+      {
+         const int nc( corr.size() );
+
+         Matrix<double> Pc(nc, nc);
+         for(int i=0; i<nc; i++)
+         {
+            for(int j=0; j<nc; j++) Pc(i,j) = Pminus(corr[i],corr[j]);
+         }
+
+         Matrix<double> invPc;
+         try
+         {
+            invPc = inverseChol(Pc);
+         }
+         catch(...)
+         {
+            InvalidSolver e("MeasUpdateNetwork(): Unable to compute \
+invPMinus matrix.");
+            GPSTK_THROW(e);
+            return -1;
+         }
+
+         for(int i=0; i<nc; i++)
+         {
+            double sum(0.0);
+            for(int j=0; j<nc; j++)
+            {
+               N(corr[i],corr[j]) = invPc(i,j);
+               sum += invPc(i,j)*xhatminus(corr[j]);
+            }
+            b(corr[i]) = sum;
+         }
+      }
+
+
+         // Information of the observations, from the nonzero partials
+      std::vector<int> cols;
+      for(int r=0; r<m; r++)
+      {
+         cols.clear();
+         for(int j=0; j<n; j++)
+         {
+            if( designMatrix(r,j) != 0.0 ) cols.push_back(j);
+         }
+
+         const double w( weightMatrix(r,r) );
+         for(size_t k=0; k<cols.size(); k++)
+         {
+            const int i( cols[k] );
+            const double hw( designMatrix(r,i)*w );
+            b(i) += hw*prefitResiduals(r);
+            for(size_t l=0; l<cols.size(); l++)
+            {
+               N(i,cols[l]) += hw*designMatrix(r,cols[l]);
+            }
+         }
+      }
+
+
+         // Station blocks: the unknowns indexed by source, grouped by
+         // source. The others are common.
+      VariableSet unkSet( equSystem.getVarUnknowns() );
+
+      std::vector<int> block(n, -1);
+      std::map<SourceID, int> blockIndex;
+      int i(0);
+      for( VariableSet::const_iterator itVar = unkSet.begin();
+           itVar != unkSet.end() && i < n;
+           ++itVar, ++i )
+      {
+         if( (*itVar).getSourceIndexed() )
+         {
+            std::map<SourceID, int>::iterator it(
+                                    blockIndex.find( (*itVar).getSource() ) );
+            if( it == blockIndex.end() )
+            {
+               int k( blockIndex.size() );
+               blockIndex[ (*itVar).getSource() ] = k;
+               block[i] = k;
+            }
+            else
+            {
+               block[i] = it->second;
+            }
+         }
+      }
+
+         // Unknowns related to another station's ones become common
+      std::vector<bool> common(n, false);
+      for(int i=0; i<n; i++)
+      {
+         if( block[i] < 0 ) common[i] = true;
+         for(int j=i+1; j<n; j++)
+         {
+            if( block[i] >= 0 && block[j] >= 0 && block[i] != block[j] &&
+                N(i,j) != 0.0 )
+            {
+               common[i] = common[j] = true;
+            }
+         }
+      }
+
+      const int numBlocks( blockIndex.size() );
+      std::vector< std::vector<int> > local(numBlocks);
+      std::vector<int> comm;
+      for(int i=0; i<n; i++)
+      {
+         if( common[i] ) comm.push_back(i);
+         else local[ block[i] ].push_back(i);
+      }
+      const int nc( comm.size() );
+
+
+         // Reduce each station block
+      std::vector< Matrix<double> > invB(numBlocks), X(numBlocks);
+      std::vector< Vector<double> > y(numBlocks);
+      bool failed(false);
+
+      #pragma omp parallel for schedule(dynamic)
+      for(int k=0; k<numBlocks; k++)
+      {
+         const std::vector<int>& lk( local[k] );
+         const int nk( lk.size() );
+         if( nk == 0 ) continue;
+
+         Matrix<double> B(nk, nk), E(nk, nc);
+         Vector<double> bk(nk);
+         for(int i=0; i<nk; i++)
+         {
+            for(int j=0; j<nk; j++) B(i,j) = N(lk[i],lk[j]);
+            for(int j=0; j<nc; j++) E(i,j) = N(lk[i],comm[j]);
+            bk(i) = b(lk[i]);
+         }
+
+         try
+         {
+            invB[k] = inverseChol(B);
+         }
+         catch(...)
+         {
+            #pragma omp critical
+            failed = true;
+            continue;
+         }
+
+         X[k] = invB[k]*E;
+         y[k] = invB[k]*bk;
+      }
+
+      if( failed )
+      {
+         InvalidSolver e("MeasUpdateNetwork(): Unable to compute P matrix.");
+         GPSTK_THROW(e);
+         return -1;
+      }
+
+
+         // Solve the common block, from the Schur complements
+      Matrix<double> Pcc;
+      Vector<double> xc(nc, 0.0);
+      if( nc > 0 )
+      {
+         Matrix<double> Sc(nc, nc);
+         Vector<double> rc(nc);
+         for(int i=0; i<nc; i++)
+         {
+            for(int j=0; j<nc; j++) Sc(i,j) = N(comm[i],comm[j]);
+            rc(i) = b(comm[i]);
+         }
+
+         for(int k=0; k<numBlocks; k++)
+         {
+            const std::vector<int>& lk( local[k] );
+            const int nk( lk.size() );
+            for(int l=0; l<nk; l++)
+            {
+               for(int i=0; i<nc; i++)
+               {
+                  const double e( N(lk[l],comm[i]) );
+                  if( e == 0.0 ) continue;
+                  rc(i) -= e*y[k](l);
+                  for(int j=0; j<nc; j++) Sc(i,j) -= e*X[k](l,j);
+               }
+            }
+         }
+
+         try
+         {
+            Pcc = inverseChol(Sc);
+         }
+         catch(...)
+         {
+            InvalidSolver e("MeasUpdateNetwork(): Unable to compute P matrix.");
+            GPSTK_THROW(e);
+            return -1;
+         }
+
+         xc = Pcc*rc;
+      }
+
+
+         // Back substitution, and a posteriori covariance
+      xhat.resize(n);
+      P.resize(n, n);
+      for(int i=0; i<nc; i++)
+      {
+         xhat(comm[i]) = xc(i);
+         for(int j=0; j<nc; j++) P(comm[i],comm[j]) = Pcc(i,j);
+      }
+
+      std::vector< Matrix<double> > PkC(numBlocks);
+      for(int k=0; k<numBlocks; k++)
+      {
+         if( local[k].empty() ) continue;
+         if( nc > 0 )
+         {
+            PkC[k] = -(X[k]*Pcc);
+         }
+         else
+         {
+            PkC[k].resize(local[k].size(), 0, 0.0);
+         }
+      }
+
+      #pragma omp parallel for schedule(dynamic)
+      for(int k=0; k<numBlocks; k++)
+      {
+         const std::vector<int>& lk( local[k] );
+         const int nk( lk.size() );
+
+         for(int i=0; i<nk; i++)
+         {
+            double sum( y[k](i) );
+            for(int j=0; j<nc; j++)
+            {
+               sum -= X[k](i,j)*xc(j);
+               P(lk[i],comm[j]) = P(comm[j],lk[i]) = PkC[k](i,j);
+            }
+            xhat(lk[i]) = sum;
+         }
+
+            // P_kl = delta_kl*inverse(B_k) - P_kC*X_l'
+         for(int l=0; l<numBlocks; l++)
+         {
+            const std::vector<int>& ll( local[l] );
+            const int nl( ll.size() );
+            for(int i=0; i<nk; i++)
+            {
+               for(int j=0; j<nl; j++)
+               {
+                  double sum( (k==l) ? invB[k](i,j) : 0.0 );
+                  for(int c=0; c<nc; c++) sum -= PkC[k](i,c)*X[l](j,c);
+                  P(lk[i],ll[j]) = sum;
+               }
+            }
+         }
+      }
+
+      xhatminus = xhat;
+      Pminus = P;
+
+      solution = xhat;
+      covMatrix = P;
+
+         // Compute the postfit residuals Vector
+      postfitResiduals = prefitResiduals - (designMatrix * solution);
+
+         // If everything is fine so far, then the results should be valid
+      valid = true;
+
+      return 0;
+
+   }  // End of method 'SolverGeneral::MeasUpdateNetwork()'
+
+
+
+      // Add the equations of the current epoch to the batch window, and
+      // solve it.
+      //
+      // The unknowns of the window are numbered in order of creation. The
+      // normal matrix N = L*L' is stored by rows from the first nonzero
+      // element of each one, which is where the fill-in of L stays. With the
+      // unknowns of the past epochs first, epoch by epoch, and the current
+      // ones last, the rows of the past epochs are short, and the last block
+      // L22 of L gives the covariance of the current unknowns, the inverse
+      // of their Schur complement L22*L22'.
+      //
+   int SolverGeneral::BatchUpdate( const Vector<double>& prefitResiduals,
+                                   const Matrix<double>& designMatrix,
+                                   const Matrix<double>& weightMatrix )
+      throw(InvalidSolver)
+   {
+
+         // By default, results are invalid
+      valid = false;
+
+      const int n = static_cast<int>(designMatrix.cols());
+      const int m = static_cast<int>(prefitResiduals.size());
+
+      if( n == 0                                          ||
+          static_cast<int>(weightMatrix.rows()) != m      ||
+          static_cast<int>(designMatrix.rows()) != m      ||
+          static_cast<int>(phiMatrix.rows()) != n         ||
+          static_cast<int>(qMatrix.rows()) != n )
+      {
+         InvalidSolver e("BatchUpdate(): Sizes of the equations do not \
+match.");
+         GPSTK_THROW(e);
+      }
+
+      if( !isDiagonal(weightMatrix) ||
+          !isDiagonal(phiMatrix)    ||
+          !isDiagonal(qMatrix) )
+      {
+         InvalidSolver e("BatchUpdate(): The weights, state transition and \
+process noise matrices must be diagonal.");
+         GPSTK_THROW(e);
+      }
+
+      ++batchEpoch;
+
+      std::vector<BatchRow> rows;
+      std::map<Variable, int> currSlots;
+      std::vector<int> order(n);
+
+
+         // Unknowns of this epoch, and the equations of their stochastic
+         // models
+      VariableSet unkSet( equSystem.getVarUnknowns() );
+
+      int i(0);
+      for( VariableSet::const_iterator itVar = unkSet.begin();
+           itVar != unkSet.end() && i < n;
+           ++itVar, ++i )
+      {
+         const double phi( phiMatrix(i,i) );
+         const double q( qMatrix(i,i) );
+
+         std::map<Variable, int>::const_iterator itPrev(
+                                               batchSlots.find( (*itVar) ) );
+
+         int slot;
+         if( itPrev != batchSlots.end() && phi == 1.0 && q == 0.0 )
+         {
+               // Constant unknown
+            slot = itPrev->second;
+         }
+         else
+         {
+            slot = batchNextSlot++;
+
+               // x = phi*xprev, with variance q, or the a priori value with
+               // its variance if there is no previous one
+            BatchRow row;
+            row.slots.push_back(slot);
+            row.coefs.push_back(1.0);
+
+            double var(q);
+            if( itPrev != batchSlots.end() )
+            {
+               if( phi != 0.0 )
+               {
+                  row.slots.push_back(itPrev->second);
+                  row.coefs.push_back(-phi);
+               }
+            }
+            else
+            {
+               var = phi*phi*(*itVar).getInitialVariance() + q;
+            }
+
+            if( !(var > 0.0) )
+            {
+               InvalidSolver e("BatchUpdate(): Unable to set the a priori \
+information of an unknown.");
+               GPSTK_THROW(e);
+            }
+
+            row.prefit = 0.0;
+            row.weight = 1.0/var;
+            rows.push_back(row);
+         }
+
+         batchSlotEpoch[slot] = batchEpoch;
+         currSlots.insert( currSlots.end(), std::make_pair( (*itVar), slot ) );
+         order[i] = slot;
+      }
+
+
+         // Observations, from the nonzero partials
+      for(int r=0; r<m; r++)
+      {
+         BatchRow row;
+         for(int j=0; j<n; j++)
+         {
+            if( designMatrix(r,j) != 0.0 )
+            {
+               row.slots.push_back( order[j] );
+               row.coefs.push_back( designMatrix(r,j) );
+            }
+         }
+         row.prefit = prefitResiduals(r);
+         row.weight = weightMatrix(r,r);
+         rows.push_back(row);
+      }
+
+      batchRows.push_back( std::vector<BatchRow>() );
+      batchRows.back().swap(rows);
+      batchSlots.swap(currSlots);
+
+
+         // Slide the window
+      while( static_cast<int>(batchRows.size()) > batchWindow )
+      {
+         BatchMarginalize();
+      }
+
+
+         // Order of the unknowns: the past ones by epoch, then the current
+         // ones as in the filter
+      const int base( batchSlotEpoch.begin()->first );
+      const int ns( batchSlotEpoch.size() );
+      const int no( ns - n );
+
+      std::vector<int> position( batchNextSlot - base, -1 );
+      for(int i=0; i<n; i++)
+      {
+         position[ order[i] - base ] = no + i;
+      }
+
+      std::vector< std::pair<int,int> > past;
+      for( std::map<int, int>::const_iterator it = batchSlotEpoch.begin();
+           it != batchSlotEpoch.end();
+           ++it )
+      {
+         if( position[ it->first - base ] < 0 )
+         {
+            past.push_back( std::make_pair( it->second, it->first ) );
+         }
+      }
+      std::sort( past.begin(), past.end() );
+      for(size_t k=0; k<past.size(); k++)
+      {
+         position[ past[k].second - base ] = k;
+      }
+
+
+         // Envelope of the normal matrix
+      std::vector<int>& first( batchFirst );
+      std::vector<int>& start( batchStart );
+      std::vector<double>& L( batchFactor );
+
+      first.resize(ns);
+      for(int i=0; i<ns; i++) first[i] = i;
+
+      const int np( batchPriorSlots.size() );
+      std::vector<int> priorPos(np);
+      int minPos(ns);
+      for(int i=0; i<np; i++)
+      {
+         priorPos[i] = position[ batchPriorSlots[i] - base ];
+         minPos = std::min( minPos, priorPos[i] );
+      }
+      for(int i=0; i<np; i++)
+      {
+         first[ priorPos[i] ] = std::min( first[ priorPos[i] ], minPos );
+      }
+
+      for( std::deque< std::vector<BatchRow> >::const_iterator itEpoch =
+                                                         batchRows.begin();
+           itEpoch != batchRows.end();
+           ++itEpoch )
+      {
+         for( std::vector<BatchRow>::const_iterator itRow = itEpoch->begin();
+              itRow != itEpoch->end();
+              ++itRow )
+         {
+            const std::vector<int>& slots( itRow->slots );
+            int minRow(ns);
+            for(size_t a=0; a<slots.size(); a++)
+            {
+               minRow = std::min( minRow, position[ slots[a] - base ] );
+            }
+            for(size_t a=0; a<slots.size(); a++)
+            {
+               int& fa( first[ position[ slots[a] - base ] ] );
+               fa = std::min( fa, minRow );
+            }
+         }
+      }
+
+      start.resize(ns+1);
+      start[0] = 0;
+      for(int i=0; i<ns; i++)
+      {
+         start[i+1] = start[i] + (i - first[i] + 1);
+      }
+
+
+         // Normal matrix and vector
+      L.assign( start[ns], 0.0 );
+      std::vector<double> x(ns, 0.0);
+
+      for(int i=0; i<np; i++)
+      {
+         const int pi( priorPos[i] );
+         x[pi] += batchPriorVec(i);
+         for(int j=0; j<np; j++)
+         {
+            const int pj( priorPos[j] );
+            if( pj <= pi )
+            {
+               L[ start[pi] + pj - first[pi] ] += batchPriorInfo(i,j);
+            }
+         }
+      }
+
+      for( std::deque< std::vector<BatchRow> >::const_iterator itEpoch =
+                                                         batchRows.begin();
+           itEpoch != batchRows.end();
+           ++itEpoch )
+      {
+         for( std::vector<BatchRow>::const_iterator itRow = itEpoch->begin();
+              itRow != itEpoch->end();
+              ++itRow )
+         {
+            const std::vector<int>& slots( itRow->slots );
+            const std::vector<double>& coefs( itRow->coefs );
+            for(size_t a=0; a<slots.size(); a++)
+            {
+               const int pa( position[ slots[a] - base ] );
+               const double cw( coefs[a]*itRow->weight );
+               x[pa] += cw*itRow->prefit;
+               for(size_t b=0; b<slots.size(); b++)
+               {
+                  const int pb( position[ slots[b] - base ] );
+                  if( pb <= pa )
+                  {
+                     L[ start[pa] + pb - first[pa] ] += cw*coefs[b];
+                  }
+               }
+            }
+         }
+      }
+
+
+         // Cholesky factorization, within the envelope
+      for(int i=0; i<ns; i++)
+      {
+         const int oi( start[i] - first[i] );
+         for(int j=first[i]; j<i; j++)
+         {
+            const int oj( start[j] - first[j] );
+            double sum( L[oi+j] );
+            for(int k=std::max( first[i], first[j] ); k<j; k++)
+            {
+               sum -= L[oi+k]*L[oj+k];
+            }
+            L[oi+j] = sum/L[oj+j];
+         }
+
+         double sum( L[oi+i] );
+         for(int k=first[i]; k<i; k++)
+         {
+            sum -= L[oi+k]*L[oi+k];
+         }
+
+         if( !(sum > 0.0) )
+         {
+            InvalidSolver e("BatchUpdate(): Unable to factor the normal \
+matrix.");
+            GPSTK_THROW(e);
+         }
+
+         L[oi+i] = std::sqrt(sum);
+      }
+
+
+         // Forward and back substitution
+      for(int i=0; i<ns; i++)
+      {
+         const int oi( start[i] - first[i] );
+         double sum( x[i] );
+         for(int k=first[i]; k<i; k++) sum -= L[oi+k]*x[k];
+         x[i] = sum/L[oi+i];
+      }
+
+      for(int i=ns-1; i>=0; i--)
+      {
+         const int oi( start[i] - first[i] );
+         x[i] /= L[oi+i];
+         for(int k=first[i]; k<i; k++) x[k] -= L[oi+k]*x[i];
+      }
+
+      solution.resize(n);
+      for(int i=0; i<n; i++) solution(i) = x[no+i];
+
+
+         // Covariance of the current unknowns, from T = inverse(L22)
+      Matrix<double> T(n, n, 0.0);
+      for(int j=0; j<n; j++)
+      {
+         const int gj( no+j );
+         T(j,j) = 1.0/L[ start[gj] + gj - first[gj] ];
+         for(int i=j+1; i<n; i++)
+         {
+            const int gi( no+i );
+            const int oi( start[gi] - first[gi] );
+            double sum(0.0);
+            for(int k=std::max( j, first[gi]-no ); k<i; k++)
+            {
+               sum -= L[oi+no+k]*T(k,j);
+            }
+            T(i,j) = sum/L[oi+gi];
+         }
+      }
+
+      covMatrix.resize(n, n);
+      for(int a=0; a<n; a++)
+      {
+         for(int b=0; b<=a; b++)
+         {
+            double sum(0.0);
+            for(int k=a; k<n; k++) sum += T(k,a)*T(k,b);
+            covMatrix(a,b) = covMatrix(b,a) = sum;
+         }
+      }
+
+      xhat = solution;
+      P = covMatrix;
+
+         // Compute the postfit residuals Vector
+      postfitResiduals = prefitResiduals - (designMatrix * solution);
+
+         // If everything is fine so far, then the results should be valid
+      valid = true;
+
+      return 0;
+
+   }  // End of method 'SolverGeneral::BatchUpdate()'
+
+
+
+      // Eliminate the unknowns of the oldest epoch of the batch window.
+      //
+      // The equations of that epoch, the ones of the next epoch relating to
+      // its unknowns and the prior information give a normal matrix
+      //
+      //    N = | Nmm  Nmr |    b = | bm |
+      //        | Nrm  Nrr |        | br |
+      //
+      // where m are the unknowns that leave the window, and the new prior
+      // information is Nrr - Nrm*inverse(Nmm)*Nmr, br - Nrm*inverse(Nmm)*bm.
+      //
+   void SolverGeneral::BatchMarginalize()
+      throw(InvalidSolver)
+   {
+
+      const int oldest( batchEpoch - static_cast<int>(batchRows.size()) + 1 );
+
+         // Unknowns that leave the window
+      std::set<int> elim;
+      for( std::map<int, int>::const_iterator it = batchSlotEpoch.begin();
+           it != batchSlotEpoch.end();
+           ++it )
+      {
+         if( it->second <= oldest ) elim.insert( it->first );
+      }
+
+         // Equations to be absorbed
+      std::vector<BatchRow> absorbed;
+      absorbed.swap( batchRows.front() );
+      batchRows.pop_front();
+
+      if( !batchRows.empty() )
+      {
+         std::vector<BatchRow>& next( batchRows.front() );
+         size_t kept(0);
+         for(size_t r=0; r<next.size(); r++)
+         {
+            bool related(false);
+            for(size_t a=0; a<next[r].slots.size() && !related; a++)
+            {
+               related = ( elim.find( next[r].slots[a] ) != elim.end() );
+            }
+
+            if( related )
+            {
+               absorbed.push_back( next[r] );
+            }
+            else
+            {
+               if( kept != r ) next[kept] = next[r];
+               ++kept;
+            }
+         }
+         next.resize(kept);
+      }
+
+
+         // Unknowns involved: the eliminated ones first
+      std::vector<int> slots( elim.begin(), elim.end() );
+      std::map<int, int> index;
+      for(size_t k=0; k<slots.size(); k++) index[ slots[k] ] = k;
+
+      const int m( slots.size() );
+
+      for(size_t k=0; k<batchPriorSlots.size(); k++)
+      {
+         if( index.find( batchPriorSlots[k] ) == index.end() )
+         {
+            index[ batchPriorSlots[k] ] = slots.size();
+            slots.push_back( batchPriorSlots[k] );
+         }
+      }
+      for(size_t r=0; r<absorbed.size(); r++)
+      {
+         for(size_t a=0; a<absorbed[r].slots.size(); a++)
+         {
+            if( index.find( absorbed[r].slots[a] ) == index.end() )
+            {
+               index[ absorbed[r].slots[a] ] = slots.size();
+               slots.push_back( absorbed[r].slots[a] );
+            }
+         }
+      }
+
+      const int t( slots.size() );
+      const int nr( t - m );
+
+
+         // Normal matrix of the absorbed information
+      Matrix<double> N(t, t, 0.0);
+      Vector<double> b(t, 0.0);
+
+      for(size_t i=0; i<batchPriorSlots.size(); i++)
+      {
+         const int pi( index[ batchPriorSlots[i] ] );
+         b(pi) += batchPriorVec(i);
+         for(size_t j=0; j<batchPriorSlots.size(); j++)
+         {
+            N(pi, index[ batchPriorSlots[j] ]) += batchPriorInfo(i,j);
+         }
+      }
+
+      for(size_t r=0; r<absorbed.size(); r++)
+      {
+         const BatchRow& row( absorbed[r] );
+         for(size_t a=0; a<row.slots.size(); a++)
+         {
+            const int pa( index[ row.slots[a] ] );
+            const double cw( row.coefs[a]*row.weight );
+            b(pa) += cw*row.prefit;
+            for(size_t c=0; c<row.slots.size(); c++)
+            {
+               N(pa, index[ row.slots[c] ]) += cw*row.coefs[c];
+            }
+         }
+      }
+
+
+         // Schur complement
+      Matrix<double> Nrr(nr, nr);
+      Vector<double> br(nr);
+      for(int i=0; i<nr; i++)
+      {
+         for(int j=0; j<nr; j++) Nrr(i,j) = N(m+i, m+j);
+         br(i) = b(m+i);
+      }
+
+      if( m > 0 && nr > 0 )
+      {
+         Matrix<double> Nmm(m, m), Nrm(nr, m);
+         Vector<double> bm(m);
+         for(int i=0; i<m; i++)
+         {
+            for(int j=0; j<m; j++) Nmm(i,j) = N(i,j);
+            bm(i) = b(i);
+         }
+         for(int i=0; i<nr; i++)
+         {
+            for(int j=0; j<m; j++) Nrm(i,j) = N(m+i, j);
+         }
+
+         Matrix<double> invNmm;
+         try
+         {
+            invNmm = inverseChol(Nmm);
+         }
+         catch(...)
+         {
+            InvalidSolver e("BatchMarginalize(): Unable to eliminate the \
+unknowns of the oldest epoch.");
+            GPSTK_THROW(e);
+         }
+
+         Matrix<double> X( Nrm*invNmm );
+         Nrr = Nrr - X*transpose(Nrm);
+         br = br - X*bm;
+      }
+
+      batchPriorSlots.assign( slots.begin()+m, slots.end() );
+      batchPriorInfo = Nrr;
+      batchPriorVec = br;
+
+      for( std::set<int>::const_iterator it = elim.begin();
+           it != elim.end();
+           ++it )
+      {
+         batchSlotEpoch.erase( (*it) );
+      }
+
+   }  // End of method 'SolverGeneral::BatchMarginalize()'
+
+
+
       /* Code to be executed after 'Compute()' method.
        *
        * @param gData    Data object holding the data.
@@ -40,6 +40,10 @@
 //============================================================================
 
 
+#include <deque>
+#include <vector>
+#include <map>
+
 #include "SolverBase.hpp"
 #include "TypeID.hpp"
 #include "ProcessingClass.hpp"
@@ -176,7 +180,9 @@ namespace gpstk
           *
           * @param equation      Object describing the equations to be solved.
           */
-      SolverGeneral( const Equation& equation ) : firstTime(true)
+      SolverGeneral( const Equation& equation )
+         : firstTime(true), networkMode(false),
+           batchWindow(0), batchEpoch(0), batchNextSlot(0)
       { equSystem.addEquation(equation); };
 
 
@@ -193,7 +199,9 @@ namespace gpstk
           * @param equationSys         Object describing an equation system to
           *                            be solved.
           */
-      SolverGeneral( const EquationSystem& equationSys ) : firstTime(true)
+      SolverGeneral( const EquationSystem& equationSys )
+         : firstTime(true), networkMode(false),
+           batchWindow(0), batchEpoch(0), batchNextSlot(0)
       { equSystem = equationSys; };
 
 
@@ -243,6 +251,77 @@ namespace gpstk
       { equSystem.clearEquations(); return (*this); };
 
 
+         /** Sets the network mode, in which the measurement update takes
+          *  advantage of the structure of multi-station problems.
+          *
+          * The unknowns indexed by a SourceID form one block per station,
+          * and the others (satellite clocks, biases, ...) a common block.
+          * The observations of a station only relate its own block to the
+          * common one, so that the normal matrix has an arrow shape: each
+          * station block is reduced on its own, in parallel if OpenMP is
+          * available, and the common block, made of the Schur complements,
+          * is solved once. Unknowns of a station that are correlated with
+          * another station's ones by the a priori covariance are moved to
+          * the common block, so that the result is the same as the one of
+          * the dense filter, up to rounding errors. The state transition and
+          * process noise matrices, which are diagonal, are also applied
+          * element by element.
+          *
+          * Only the first epoch gets the full benefit of the blocks: once
+          * the common unknowns have linked the stations, nearly every
+          * unknown is moved to the common block.
+          *
+          * @param network    Whether to use the network mode.
+          */
+      virtual SolverGeneral& setNetworkMode(bool network)
+      { networkMode = network; return (*this); };
+
+
+         /// Returns true if the network mode is used.
+      virtual bool getNetworkMode() const
+      { return networkMode; };
+
+
+         /** Sets the batch mode, in which the solution is a least-squares
+          *  adjustment of the last epochs instead of a Kalman filter update.
+          *
+          * The observation equations of the last 'epochs' epochs are kept in
+          * a compact form, as their nonzero coefficients, together with the
+          * equations given by the stochastic models: an unknown with a
+          * state transition of 1 and no process noise, such as an ambiguity
+          * or static coordinates, is the same unknown at every epoch, and
+          * the other ones are new unknowns at each epoch, related to their
+          * previous value by a pseudo-observation of weight 1/q. When an
+          * epoch leaves the window, its unknowns are eliminated and the
+          * information of its equations is kept as a prior on the remaining
+          * ones, so that the solution of the current epoch is the same as
+          * the one of the filter, up to rounding errors.
+          *
+          * The window is solved by a Cholesky factorization of its normal
+          * matrix in envelope (skyline) storage, with the unknowns of the
+          * past epochs first, epoch by epoch, and the current ones last.
+          * The rows of the past unknowns are short, so the cost grows
+          * slowly and linearly with the length of the window, and the
+          * covariance of the current unknowns comes from the last block of
+          * the factor. Unlike the filter, the a priori covariance matrix is
+          * neither built from the maps of the previous epoch nor inverted.
+          *
+          * The weights of the observations, the state transition and the
+          * process noise matrices must be diagonal. Changing the window
+          * resets the solver.
+          *
+          * @param epochs     Number of epochs of the window, or zero for
+          *                   the Kalman filter, which is the default.
+          */
+      virtual SolverGeneral& setBatchWindow(int epochs)
+      { batchWindow = epochs; firstTime = true; return (*this); };
+
+
+         /// Returns the number of epochs of the batch window, or zero.
+      virtual int getBatchWindow() const
+      { return batchWindow; };
+
+
          /// This method resets the filter, setting all variance values in
          /// covariance matrix to a very high level.
       virtual SolverGeneral& reset(void)
@@ -480,6 +559,56 @@ namespace gpstk
       bool firstTime;
 
 
+         /// Whether the network mode is used
+      bool networkMode;
+
+
+         /// Number of epochs of the batch window, or zero
+      int batchWindow;
+
+
+         /// Equation of the batch window: its nonzero coefficients and the
+         /// unknowns they apply to, which are numbered in order of creation
+      struct BatchRow
+      {
+         std::vector<int> slots;
+         std::vector<double> coefs;
+         double prefit;
+         double weight;
+      };
+
+
+         /// Equations of each epoch of the window, the oldest first
+      std::deque< std::vector<BatchRow> > batchRows;
+
+
+         /// Number of the current epoch, and of the next unknown
+      int batchEpoch;
+      int batchNextSlot;
+
+
+         /// Unknowns of the window, with the last epoch they belong to
+      std::map<int, int> batchSlotEpoch;
+
+
+         /// Unknowns of the current epoch, by Variable
+      std::map<Variable, int> batchSlots;
+
+
+         /// Information of the epochs out of the window: the unknowns it
+         /// applies to, its matrix and vector
+      std::vector<int> batchPriorSlots;
+      Matrix<double> batchPriorInfo;
+      Vector<double> batchPriorVec;
+
+
+         /// Envelope of the factor: first column and start of each row,
+         /// and its values
+      std::vector<int> batchFirst;
+      std::vector<int> batchStart;
+      std::vector<double> batchFactor;
+
+
          // Predicted state
       Vector<double> xhatminus;
 
@@ -539,6 +668,36 @@ namespace gpstk
          throw(InvalidSolver);
 
 
+         /** Measurement Update of the kalman filter in network mode, by
+          *  elimination of the station blocks. Falls back to MeasUpdate()
+          *  if the weight matrix isn't diagonal.
+          *
+          * @sa setNetworkMode().
+          */
+      virtual int MeasUpdateNetwork( const Vector<double>& prefitResiduals,
+                                     const Matrix<double>& designMatrix,
+                                     const Matrix<double>& weightMatrix  )
+         throw(InvalidSolver);
+
+
+         /** Adds the equations of the current epoch to the batch window,
+          *  moves the epochs out of it to the prior information, and
+          *  solves the window.
+          *
+          * @sa setBatchWindow().
+          */
+      virtual int BatchUpdate( const Vector<double>& prefitResiduals,
+                               const Matrix<double>& designMatrix,
+                               const Matrix<double>& weightMatrix  )
+         throw(InvalidSolver);
+
+
+         /// Eliminates the unknowns of the oldest epoch of the batch window,
+         /// and adds its equations to the prior information.
+      virtual void BatchMarginalize()
+         throw(InvalidSolver);
+
+
          /** Set the solution associated to a given Variable.
           *
           * @param variable    Variable object solution we are looking for.
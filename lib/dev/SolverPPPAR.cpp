@@ -66,6 +66,7 @@
 #include "SolverPPPAR.hpp"
 #include "MatrixFunctors.hpp"
 #include "ARMLambda.hpp"
+#include <algorithm>
 #include "TimeString.hpp"
 #include "Epoch.hpp"
 
@@ -1567,132 +1568,99 @@ of qMatrix");
                // Single ambiguity fixing method
             ARRound ambRes(0.0, 0.3, 0.4);
 
-               // min decisioin
-            double lastMinDec(9.0E+10);
+               // Float ambiguities of the valid satellites
+            int numSV = validSatSet.size();
 
-               // If the satellite number to be fixed is greater than 4.
-            int iter(0);
-            while( validSatSet.size()>1 )
+            Vector<double> tempAmb(numSV, 0.0);
+            Matrix<double> tempCov(numSV, numSV, 0.0);
+
+               // Now, fill the 'tempAmb', and the fixing decisions
+            std::vector< std::pair<double,int> > dropKey;
+            c1 = 0;
+            for( SatIDSet::iterator itSat=validSatSet.begin();
+                 itSat !=validSatSet.end();
+                 ++itSat )
             {
-                   // Number of valid satellite
-                int numSV = validSatSet.size();
+                tempAmb(c1) = ambWLMap[(*itSat)] ;
 
-                Vector<double> tempAmb(numSV, 0.0);
-                Matrix<double> tempCov(numSV, numSV, 0.0);
+                   // Sigma
+                double sig = std::sqrt( covAmbWLMap[(*itSat)][(*itSat)] );
 
-                   // Now, fill the 'tempAmb'
-                int c1(0);
-                for( SatIDSet::iterator itSat=validSatSet.begin();
-                     itSat !=validSatSet.end();
-                     ++itSat )
-                {
-                    tempAmb(c1) = ambWLMap[(*itSat)] ;
-                    c1++;
-                }
+                   // Get the fixing decision
+                double decision = ambRes.getDecision(tempAmb(c1), sig);
+                dropKey.push_back( std::make_pair(decision, c1) );
 
-                   // Now, fill the covariance 
-                SatIDSet tempSatSet(validSatSet);
+                c1++;
+            }
 
-                c1=0;
-                for( SatIDSet::iterator itSat=validSatSet.begin();
-                     itSat !=validSatSet.end();
-                     ++itSat )
-                {
-                        // The diagonal element
-                    tempCov(c1,c1) = covAmbWLMap[(*itSat)][(*itSat)] ;
-
-                    int c2(c1+1);
-
-                       // Erase current satellite
-                    tempSatSet.erase(*itSat);
-                    for( SatIDSet::iterator itSat2=tempSatSet.begin();
-                         itSat2 !=tempSatSet.end();
-                         ++itSat2 )
-                    {
-                        tempCov(c1,c2) =
-                            tempCov(c2,c1) =
-                                covAmbWLMap[(*itSat)][(*itSat2)];
-                        c2++;
-                    }
-                    c1++;
-                }
-                
-                   // Fill 'mlambda' with 'tempAmb/tempCov'
-                mlambda.resolve(tempAmb, tempCov);
-                ratioWL = mlambda.getRatio();
+               // Now, fill the covariance 
+            tempSatSet = validSatSet;
 
-                   // Get fixed ambiguity vector
-                Vector<double> ambFixedVec = mlambda.getFixedAmbVec();
+            c1=0;
+            for( SatIDSet::iterator itSat=validSatSet.begin();
+                 itSat !=validSatSet.end();
+                 ++itSat )
+            {
+                    // The diagonal element
+                tempCov(c1,c1) = covAmbWLMap[(*itSat)][(*itSat)] ;
 
-                if( debugLevel )
-                {
-//                 cout << "tempAmb" << endl;
-//                 cout <<  tempAmb  << endl;
-//                 cout << "tempCov" << endl;
-//                 cout <<  tempCov  << endl;
-//                 cout << "ratioWL" << endl;
-//                 cout <<  ratioWL << endl;
-//                 cout << "ambFixedVec" << endl;
-//                 cout <<  ambFixedVec  << endl;
-                }
+                int c2(c1+1);
 
-                   // Fixing ratio
-                if( (ratioWL>3.0) && (lastMinDec > 0.0))
+                   // Erase current satellite
+                tempSatSet.erase(*itSat);
+                for( SatIDSet::iterator itSat2=tempSatSet.begin();
+                     itSat2 !=tempSatSet.end();
+                     ++itSat2 )
                 {
-                       // Store the fixed ambiguities into 'ambWLFixedMap'
-                    int c1(0);
-                    for( SatIDSet::iterator itSat=validSatSet.begin();
-                         itSat !=validSatSet.end();
-                         ++itSat )
-                    {
-                        ambWLFixedMap[(*itSat)] = ambFixedVec(c1);
-                        c1++;
-                    }
-
-                    break;
+                    tempCov(c1,c2) =
+                        tempCov(c2,c1) =
+                            covAmbWLMap[(*itSat)][(*itSat2)];
+                    c2++;
                 }
-                else
-                {
-                       // Satellite with minimum fixing decision
-                    SatID tempSat;
-
-                       // Minimum decision for this iteration
-                    double tempMinDec(9.0E+10);
-
-                       // Temporary satellite
-                    int c1(0);
-                    for( SatIDSet::iterator itSat=validSatSet.begin();
-                         itSat !=validSatSet.end();
-                         ++itSat )
-                    {
-                           // Value
-                        double bw = ambWLMap[(*itSat)];
-
-                           // Sigma
-                        double sig = std::sqrt( covAmbWLMap[(*itSat)][(*itSat)] );
+                c1++;
+            }
 
-                           // Get the fixing decision
-                        double decision = ambRes.getDecision(bw, sig);
+               // All the satellites are tried first, then they are dropped
+               // by increasing fixing decision while two are left. The
+               // ratio test is only trusted once the satellites of null
+               // decision are dropped.
+            std::sort( dropKey.begin(), dropKey.end() );
 
-                           // Get the minimum decision
-                        if( decision < tempMinDec )
-                        {
-                            tempMinDec = decision;
-                            tempSat = (*itSat);
-                        }
-                    }
-
-                    lastMinDec = tempMinDec;
+            std::vector<int> dropOrder;
+            int minDropped(1);
+            for(size_t i=0; i<dropKey.size(); i++)
+            {
+                dropOrder.push_back( dropKey[i].second );
+                if( dropKey[i].first <= 0.0 ) minDropped = i+2;
+            }
 
-                       // remove this satellite from validSatSet 
-                    validSatSet.erase(tempSat);
+               // Fill 'mlambda' with 'tempAmb/tempCov'
+            mlambda.resolvePartial(tempAmb, tempCov, dropOrder, 3.0, 2, minDropped);
+               // Ratio of the subset fixed or, if none passed, of the last
+               // one tried; it is not above 3 then
+            ratioWL = mlambda.getRatio();
+
+               // Get fixed ambiguity vector
+            Vector<double> ambFixedVec = mlambda.getFixedAmbVec();
+            Vector<bool> fixedFlags = mlambda.getFixedFlags();
+
+               // Store the fixed ambiguities, and keep their satellites only
+            SatIDSet fixedSatSet;
+            c1 = 0;
+            for( SatIDSet::iterator itSat=validSatSet.begin();
+                 itSat !=validSatSet.end();
+                 ++itSat )
+            {
+                if( fixedFlags(c1) )
+                {
+                    ambWLFixedMap[(*itSat)] = ambFixedVec(c1);
 
+                    fixedSatSet.insert(*itSat);
                 }
+                c1++;
+            }
 
-                  // Iter increment
-                iter++;
-
-            };  // End of 'while(validSatSet.size() >1)'
+            validSatSet = fixedSatSet;
 
                // LC ambiguity estimate
             c1 = 0;     
@@ -1817,141 +1785,106 @@ of qMatrix");
                }  // End of 'for( SatIDSet::iterator itSat=validSatSet.begin(); )'
 
 
-                  // min decisioin
-               double lastMinDec(9.0E+10);
                double ratioL1(0.0);
 
-               int iter(0);
-               while( validSatSet.size()>1 )
-               {
-                      // Number of valid satellite
-                   int numSV = validSatSet.size();
+                  // Float ambiguities of the valid satellites
+               int numSV = validSatSet.size();
 
-                   Vector<double> tempAmb(numSV, 0.0);
-                   Matrix<double> tempCov(numSV, numSV, 0.0);
+               Vector<double> tempAmb(numSV, 0.0);
+               Matrix<double> tempCov(numSV, numSV, 0.0);
 
-                      // Now, fill the 'tempAmb'
-                   int c1(0);
-                   for( SatIDSet::iterator itSat=validSatSet.begin();
-                        itSat !=validSatSet.end();
-                        ++itSat )
-                   {
-                       tempAmb(c1) = ambL1Map[(*itSat)] ;
+                  // Now, fill the 'tempAmb', and the fixing decisions
+               std::vector< std::pair<double,int> > dropKey;
+               c1 = 0;
+               for( SatIDSet::iterator itSat=validSatSet.begin();
+                    itSat !=validSatSet.end();
+                    ++itSat )
+               {
+                   tempAmb(c1) = ambL1Map[(*itSat)] ;
 
-                       c1++;
-                   }
+                      // Sigma
+                   double sig = std::sqrt( covAmbL1Map[(*itSat)][(*itSat)] );
 
-                      // Now, fill the covariance 
-                   SatIDSet tempSatSet(validSatSet);
+                      // Get the fixing decision
+                   double decision = ambRes.getDecision(tempAmb(c1), sig);
+                   dropKey.push_back( std::make_pair(decision, c1) );
 
-                   c1=0;
-                   for( SatIDSet::iterator itSat=validSatSet.begin();
-                        itSat !=validSatSet.end();
-                        ++itSat )
-                   {
-                           // The diagonal element
-                       tempCov(c1,c1) = covAmbL1Map[(*itSat)][(*itSat)] ;
+                   c1++;
+               }
 
-                       int c2(c1+1);
+                  // Now, fill the covariance 
+               tempSatSet = validSatSet;
 
-                          // Erase current satellite
-                       tempSatSet.erase(*itSat);
-                       for( SatIDSet::iterator itSat2=tempSatSet.begin();
-                            itSat2 !=tempSatSet.end();
-                            ++itSat2 )
-                       {
-                           tempCov(c1,c2) =
-                               tempCov(c2,c1) =
-                                   covAmbL1Map[(*itSat)][(*itSat2)];
+               c1=0;
+               for( SatIDSet::iterator itSat=validSatSet.begin();
+                    itSat !=validSatSet.end();
+                    ++itSat )
+               {
+                       // The diagonal element
+                   tempCov(c1,c1) = covAmbL1Map[(*itSat)][(*itSat)] ;
 
-                           c2++;
-                       }
+                   int c2(c1+1);
 
-                       c1++;
+                      // Erase current satellite
+                   tempSatSet.erase(*itSat);
+                   for( SatIDSet::iterator itSat2=tempSatSet.begin();
+                        itSat2 !=tempSatSet.end();
+                        ++itSat2 )
+                   {
+                       tempCov(c1,c2) =
+                           tempCov(c2,c1) =
+                               covAmbL1Map[(*itSat)][(*itSat2)];
+                       c2++;
                    }
-                   
-                      // Fill 'mlambda' with 'tempAmb/tempCov'
-                   mlambda.resolve(tempAmb, tempCov);
-                   ratioL1 = mlambda.getRatio();
+                   c1++;
+               }
 
-                      // Get fixed ambiguity vector
-                   Vector<double> ambL1Fixed = mlambda.getFixedAmbVec();
+                  // All the satellites are tried first, then they are dropped
+                  // by increasing fixing decision while two are left. The
+                  // ratio test is only trusted once the satellites of null
+                  // decision are dropped.
+               std::sort( dropKey.begin(), dropKey.end() );
 
+               std::vector<int> dropOrder;
+               int minDropped(1);
+               for(size_t i=0; i<dropKey.size(); i++)
+               {
+                   dropOrder.push_back( dropKey[i].second );
+                   if( dropKey[i].first <= 0.0 ) minDropped = i+2;
+               }
 
-                   if( debugLevel )
-                   {
-//                    cout << "tempAmb" << endl;
-//                    cout <<  tempAmb  << endl;
-//                    cout << "tempCov" << endl;
-//                    cout <<  tempCov  << endl;
-//                    cout << "ratioL1" << endl;
-//                    cout <<  ratioL1 << endl;
-//                    cout << "ambL1Fixed " << endl;
-//                    cout <<  ambL1Fixed   << endl;
-                   }
+                  // Fill 'mlambda' with 'tempAmb/tempCov'
+               mlambda.resolvePartial(tempAmb, tempCov, dropOrder, 3.0, 2, minDropped);
+                  // Ratio of the subset fixed or, if none passed, of the last
+                  // one tried; it is not above 3 then
+               ratioL1 = mlambda.getRatio();
 
-                      // Fixing ratio
-                   if( (ratioL1>3.0) && (lastMinDec > 0.0))
-                   {
-                          // Store the fixed ambiguities into 'ambWLFixedMap'
-                       int c1(0);
-                       for( SatIDSet::iterator itSat=validSatSet.begin();
-                            itSat !=validSatSet.end();
-                            ++itSat )
-                       {
-                              // Fixed L1 ambiguities
-                           ambL1FixedMap[(*itSat)] = ambL1Fixed(c1);
-
-                              // Fixed LC ambiguities
-                           ambLCFixedMap[(*itSat)]
-                               = ambL1FixedMap[(*itSat)] + cw*ambWLFixedMap[(*itSat)];
-
-                           c1++;
-                       }
-
-                       break;
-                   }
-                   else
+                  // Get fixed ambiguity vector
+               Vector<double> ambFixedVec = mlambda.getFixedAmbVec();
+               Vector<bool> fixedFlags = mlambda.getFixedFlags();
+
+                  // Store the fixed ambiguities, and keep their satellites only
+               SatIDSet fixedSatSet;
+               c1 = 0;
+               for( SatIDSet::iterator itSat=validSatSet.begin();
+                    itSat !=validSatSet.end();
+                    ++itSat )
+               {
+                   if( fixedFlags(c1) )
                    {
-                          // Satellite with minimum fixing decision
-                       SatID tempSat;
-
-                          // Minimum decision for this iteration
-                       double tempMinDec(9.0E+10);
-
-                          // Temporary satellite
-                       int c1(0);
-                       for( SatIDSet::iterator itSat=validSatSet.begin();
-                            itSat !=validSatSet.end();
-                            ++itSat )
-                       {
-                              // Value
-                           double b1 = ambL1Map[(*itSat)];
-
-                              // Sigma
-                           double sig = std::sqrt( covAmbL1Map[(*itSat)][(*itSat)] );
-
-                              // Get the fixing decision
-                           double decision = ambRes.getDecision(b1, sig);
-
-                              // Get the minimum decision
-                           if( decision < tempMinDec )
-                           {
-                               tempMinDec = decision;
-                               tempSat = (*itSat);
-                           }
-                       }
-
-                       lastMinDec = tempMinDec;
-
-                          // remove this satellite from validSatSet 
-                       validSatSet.erase(tempSat);
+                          // Fixed L1 ambiguities
+                       ambL1FixedMap[(*itSat)] = ambFixedVec(c1);
+                       
+                          // Fixed LC ambiguities
+                       ambLCFixedMap[(*itSat)]
+                           = ambL1FixedMap[(*itSat)] + cw*ambWLFixedMap[(*itSat)];
+
+                       fixedSatSet.insert(*itSat);
                    }
+                   c1++;
+               }
 
-                     // Iter increment
-                   iter++;
-
-               };
+               validSatSet = fixedSatSet;
 
                    // Update the solution/state with fixed LC ambiguities
                if(ratioL1>3.0)
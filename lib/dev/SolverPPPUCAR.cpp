@@ -61,6 +61,7 @@
 #include "SolverPPPUCAR.hpp"
 #include "MatrixFunctors.hpp"
 #include "ARMLambda.hpp"
+#include <algorithm>
 #include "PowerSum.hpp"
 
 using namespace std;
@@ -1696,112 +1697,92 @@ of qMatrix");
 
          double ratioWL(0.0);
 
-            // If the satellite number to be fixed is greater than 4.
-         int iter(0);
-         while( validSatSet.size()>1 )
+            // Float ambiguities of the valid satellites
+         int numSV = validSatSet.size();
+
+         Vector<double> ambWLVec(numSV, 0.0);
+         Matrix<double> covWLMat(numSV, numSV, 0.0);
+
+            // Now, fill the 'ambWLVec', and the variances
+         std::vector< std::pair<double,int> > dropKey;
+         c1 = 0;
+         for( SatIDSet::iterator itSat=validSatSet.begin();
+              itSat !=validSatSet.end();
+              ++itSat )
          {
-                // Number of valid satellite
-             int numSV = validSatSet.size();
+             ambWLVec(c1) = ambWLMap[(*itSat)] ;
+             dropKey.push_back(
+                std::make_pair(-covAmbWLMap[(*itSat)][(*itSat)], c1) );
+             c1++;
+         }
 
-             Vector<double> tempAmb(numSV, 0.0);
-             Matrix<double> tempCov(numSV, numSV, 0.0);
+            // Now, fill the covariance 
+         tempSatSet = validSatSet;
 
-                // Now, fill the 'tempAmb'
-             int c1(0);
-             for( SatIDSet::iterator itSat=validSatSet.begin();
-                  itSat !=validSatSet.end();
-                  ++itSat )
-             {
-                 tempAmb(c1) = ambWLMap[(*itSat)] ;
-                 c1++;
-             }
+         c1=0;
+         for( SatIDSet::iterator itSat=validSatSet.begin();
+              itSat !=validSatSet.end();
+              ++itSat )
+         {
+                 // The diagonal element
+             covWLMat(c1,c1) = covAmbWLMap[(*itSat)][(*itSat)] ;
 
-                // Now, fill the covariance 
-             SatIDSet tempSatSet(validSatSet);
+             int c2(c1+1);
 
-             c1=0;
-             for( SatIDSet::iterator itSat=validSatSet.begin();
-                  itSat !=validSatSet.end();
-                  ++itSat )
+                // Erase current satellite
+             tempSatSet.erase(*itSat);
+             for( SatIDSet::iterator itSat2=tempSatSet.begin();
+                  itSat2 !=tempSatSet.end();
+                  ++itSat2 )
              {
-                     // The diagonal element
-                 tempCov(c1,c1) = covAmbWLMap[(*itSat)][(*itSat)] ;
-
-                    // Erase current satellite
-                 int c2(c1+1);
-                 tempSatSet.erase(*itSat);
-                 for( SatIDSet::iterator itSat2=tempSatSet.begin();
-                      itSat2 !=tempSatSet.end();
-                      ++itSat2 )
-                 {
-                     tempCov(c1,c2) =
-                         tempCov(c2,c1) =
-                             covAmbWLMap[(*itSat)][(*itSat2)];
-                     c2++;
-                 }
-                 c1++;
+                 covWLMat(c1,c2) =
+                     covWLMat(c2,c1) =
+                         covAmbWLMap[(*itSat)][(*itSat2)];
+                 c2++;
              }
-             
-             cout << "tempAmb:" << tempAmb << endl;
-             cout << "tempCov:" << tempCov << endl;
-
-                // Fill 'mlambda' with 'tempAmb/tempCov'
-             mlambda.resolve(tempAmb, tempCov);
-             ratioWL = mlambda.getRatio();
-
-                // Get fixed ambiguity vector
-             Vector<double> ambFixedVec = mlambda.getFixedAmbVec();
+             c1++;
+         }
 
-             cout << "iter:" << iter << endl;
-             cout << "numSV:" << numSV << endl;
-             cout << "ratioWL:" << ratioWL << endl;
+            // All the satellites are tried first, then they are dropped
+            // by decreasing variance while two are left.
+         std::sort( dropKey.begin(), dropKey.end() );
 
-                // Fixing ratio
-             if( (ratioWL>3.0) )
-             {
-                    // Store the fixed ambiguities into 'ambWLFixedMap'
-                 int c1(0);
-                 for( SatIDSet::iterator itSat=validSatSet.begin();
-                      itSat !=validSatSet.end();
-                      ++itSat )
-                 {
-                     ambWLFixedMap[(*itSat)] = ambFixedVec(c1);
-                     c1++;
-                 }
+         std::vector<int> dropOrder;
+         for(size_t i=0; i<dropKey.size(); i++)
+         {
+             dropOrder.push_back( dropKey[i].second );
+         }
 
-                 break;
-             }
-             else
-             {
-                    // Satellite with minimum fixing decision
-                 SatID tempSat;
+            // Fill 'mlambda' with 'ambWLVec/covWLMat'
+         mlambda.resolvePartial(ambWLVec, covWLMat, dropOrder, 3.0);
+            // Ratio of the subset fixed or, if none passed, of the last
+            // one tried; it is not above 3 then
+         ratioWL = mlambda.getRatio();
 
-                    // Minimum decision for this iteration
-                 double tempMaxVar(0.0);
+            // Get fixed ambiguity vector
+         Vector<double> ambFixedVec = mlambda.getFixedAmbVec();
+         Vector<bool> fixedFlags = mlambda.getFixedFlags();
 
-                    // Temporary satellite
-                 int c1(0);
-                 for( SatIDSet::iterator itSat=validSatSet.begin();
-                      itSat !=validSatSet.end();
-                      ++itSat )
-                 {
-                     double var = covAmbWLMap[(*itSat)][(*itSat)];
-                     if( var > tempMaxVar )
-                     {
-                         tempMaxVar = var;
-                         tempSat = (*itSat);
-                     }
-                 }
+         cout << "numSV:" << numSV << endl;
+         cout << "ratioWL:" << ratioWL << endl;
 
-                    // remove this satellite from validSatSet 
-                 validSatSet.erase(tempSat);
+            // Store the fixed ambiguities, and keep their satellites only
+         SatIDSet fixedSatSet;
+         c1 = 0;
+         for( SatIDSet::iterator itSat=validSatSet.begin();
+              itSat !=validSatSet.end();
+              ++itSat )
+         {
+             if( fixedFlags(c1) )
+             {
+                 ambWLFixedMap[(*itSat)] = ambFixedVec(c1);
 
+                 fixedSatSet.insert(*itSat);
              }
+             c1++;
+         }
 
-               // Iter increment
-             iter++;
-
-         };  // End of 'while(validSatSet.size() >1)'
+         validSatSet = fixedSatSet;
 
 
             // Update the solution/state with fixed widelane ambiguities
@@ -1892,123 +1873,101 @@ of qMatrix");
             // Now, if the widelane ambiguities can be fixed 
          if( ratioWL>3.0 )
          {
-               // min decisioin
             double ratioL1(0.0);
 
-            int iter(0);
-            while( validSatSet.size()>1 )
+               // Float ambiguities of the valid satellites
+            int numSV = validSatSet.size();
+
+            Vector<double> tempAmb(numSV, 0.0);
+            Matrix<double> tempCov(numSV, numSV, 0.0);
+
+               // Now, fill the 'tempAmb', and the variances
+            std::vector< std::pair<double,int> > dropKey;
+            int c1(0);
+            for( SatIDSet::iterator itSat=validSatSet.begin();
+                 itSat !=validSatSet.end();
+                 ++itSat )
             {
-                   // Number of valid satellite
-                int numSV = validSatSet.size();
+                tempAmb(c1) = ambL1Map[(*itSat)] ;
+                dropKey.push_back(
+                   std::make_pair(-covAmbL1Map[(*itSat)][(*itSat)], c1) );
+                c1++;
+            }
 
-                Vector<double> tempAmb(numSV, 0.0);
-                Matrix<double> tempCov(numSV, numSV, 0.0);
+               // Now, fill the covariance 
+            SatIDSet tempSatSet(validSatSet);
 
-                   // Now, fill the 'tempAmb'
-                int c1(0);
-                for( SatIDSet::iterator itSat=validSatSet.begin();
-                     itSat !=validSatSet.end();
-                     ++itSat )
-                {
-                    tempAmb(c1) = ambL1Map[(*itSat)] ;
-                    c1++;
-                }
+            c1=0;
+            for( SatIDSet::iterator itSat=validSatSet.begin();
+                 itSat !=validSatSet.end();
+                 ++itSat )
+            {
+                    // The diagonal element
+                tempCov(c1,c1) = covAmbL1Map[(*itSat)][(*itSat)] ;
 
-                   // Now, fill the covariance 
-                SatIDSet tempSatSet(validSatSet);
+                int c2(c1+1);
 
-                c1=0;
-                for( SatIDSet::iterator itSat=validSatSet.begin();
-                     itSat !=validSatSet.end();
-                     ++itSat )
+                   // Erase current satellite
+                tempSatSet.erase(*itSat);
+                for( SatIDSet::iterator itSat2=tempSatSet.begin();
+                     itSat2 !=tempSatSet.end();
+                     ++itSat2 )
                 {
-                        // The diagonal element
-                    tempCov(c1,c1) = covAmbL1Map[(*itSat)][(*itSat)] ;
-
-                    int c2(c1+1);
-                    tempSatSet.erase(*itSat);
-                    for( SatIDSet::iterator itSat2=tempSatSet.begin();
-                         itSat2 !=tempSatSet.end();
-                         ++itSat2 )
-                    {
-                        tempCov(c1,c2) =
-                            tempCov(c2,c1) =
-                                covAmbL1Map[(*itSat)][(*itSat2)];
-                        c2++;
-                    }
-                    c1++;
+                    tempCov(c1,c2) =
+                        tempCov(c2,c1) =
+                            covAmbL1Map[(*itSat)][(*itSat2)];
+                    c2++;
                 }
-                
-                cout << "tempAmb:" << tempAmb << endl;
-                cout << "tempCov:" << tempCov << endl;
+                c1++;
+            }
 
-                   // Fill 'mlambda' with 'tempAmb/tempCov'
-                mlambda.resolve(tempAmb, tempCov);
-                ratioL1 = mlambda.getRatio();
+               // All the satellites are tried first, then they are dropped
+               // by decreasing variance while two are left.
+            std::sort( dropKey.begin(), dropKey.end() );
 
-                   // Get fixed ambiguity vector
-                Vector<double> ambL1Fixed = mlambda.getFixedAmbVec();
+            std::vector<int> dropOrder;
+            for(size_t i=0; i<dropKey.size(); i++)
+            {
+                dropOrder.push_back( dropKey[i].second );
+            }
 
+               // Fill 'mlambda' with 'tempAmb/tempCov'
+            mlambda.resolvePartial(tempAmb, tempCov, dropOrder, 3.0);
+               // Ratio of the subset fixed or, if none passed, of the last
+               // one tried; it is not above 3 then
+            ratioL1 = mlambda.getRatio();
 
-                cout << "iter:" << iter << endl;
-                cout << "numSV:" << numSV << endl;
-                cout << "ratioL1:" << ratioL1 << endl;
-                cout << "ambL1Fixed:" << ambL1Fixed << endl;
+               // Get fixed ambiguity vector
+            Vector<double> ambFixedVec = mlambda.getFixedAmbVec();
+            Vector<bool> fixedFlags = mlambda.getFixedFlags();
 
-                   // Fixing ratio
-                   // Two different control parameter!
-                if( (ratioL1>3.0) )
-                {
-                       // Store the fixed ambiguities into 'ambL1FixedMap'
-                    int c1(0);
-                    for( SatIDSet::iterator itSat=validSatSet.begin();
-                         itSat !=validSatSet.end();
-                         ++itSat )
-                    {
-                           // Fixed L1 ambiguities
-                        ambL1FixedMap[(*itSat)] = ambL1Fixed(c1);
-
-                        cout << "(*itSat)"  << (*itSat)
-                             << "L1:" << ambL1FixedMap[(*itSat)] 
-                             << "WL:" << ambWLFixedMap[(*itSat)]
-                             << endl;
-                        c1++;
-                    }
-
-                    break;
-                }
-                else
+            cout << "numSV:" << numSV << endl;
+            cout << "ratioL1:" << ratioL1 << endl;
+            cout << "ambL1Fixed:" << ambFixedVec << endl;
+
+               // Store the fixed ambiguities, and keep their satellites only
+            SatIDSet fixedSatSet;
+            c1 = 0;
+            for( SatIDSet::iterator itSat=validSatSet.begin();
+                 itSat !=validSatSet.end();
+                 ++itSat )
+            {
+                if( fixedFlags(c1) )
                 {
-                       // Satellite with minimum fixing decision
-                    SatID tempSat;
-
-                       // Minimum decision for this iteration
-                    double tempMaxVar(0.0);
-
-                       // Temporary satellite
-                    int c1(0);
-                    for( SatIDSet::iterator itSat=validSatSet.begin();
-                         itSat !=validSatSet.end();
-                         ++itSat )
-                    {
-                        double var = covAmbL1Map[(*itSat)][(*itSat)] ;
-                        if( var > tempMaxVar )
-                        {
-                            tempMaxVar = var;
-                            tempSat = (*itSat);
-                        }
-                    }
-
-                    cout << "sat to be removed:" << tempSat << endl;
-
-                       // remove this satellite from validSatSet 
-                    validSatSet.erase(tempSat);
+                       // Fixed L1 ambiguities
+                    ambL1FixedMap[(*itSat)] = ambFixedVec(c1);
+                    
+                    cout << "(*itSat)"  << (*itSat)
+                         << "L1:" << ambL1FixedMap[(*itSat)] 
+                         << "WL:" << ambWLFixedMap[(*itSat)]
+                         << endl;
+
+                    fixedSatSet.insert(*itSat);
                 }
+                c1++;
+            }
 
-                  // Iter increment
-                iter++;
-
-            };
+            validSatSet = fixedSatSet;
 
             
                 // Update the solution/state with fixed LC ambiguities
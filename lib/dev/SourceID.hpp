@@ -84,14 +84,14 @@ namespace gpstk
 
          /// empty constructor, creates an unknown source data object
       SourceID()
-         : type(Unknown), sourceName("")
+         : type(Unknown), sourceName(""), staticFlag(true)
       {};
 
 
          /// Explicit constructor
       SourceID( SourceType st,
                 std::string name )
-         : type(st), sourceName(name)
+         : type(st), sourceName(name), staticFlag(true)
       {};
 
 
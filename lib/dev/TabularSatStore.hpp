@@ -33,6 +33,9 @@ namespace gpstk
    /// returns the result as a DataRecord object.
    /// NB this is an abstract class b/c getValue() and others are pure virtual.
    /// NB this class (dump()) requires that operator<<(DataRecord) be defined.
+   /// NB the queries (getValue() and the like) only read the tables, so once
+   /// loaded a store may be queried from several threads at once without
+   /// locks, as long as neither the data nor the settings are changed.
    template <class DataRecord>
    class TabularSatStore
    {